@@ -153,6 +153,7 @@ target_link_libraries(asio::asio INTERFACE Threads::Threads)
 include(CheckCXXSymbolExists)
 check_cxx_symbol_exists(sendmsg sys/socket.h HAVE_SENDMSG)
 check_cxx_symbol_exists(sendmmsg sys/socket.h HAVE_SENDMMSG)
+check_cxx_symbol_exists(recvmmsg sys/socket.h HAVE_RECVMMSG)
 
 if (HAVE_SENDMSG)
     set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DHAVE_SENDMSG=1")
@@ -166,6 +167,12 @@ if (HAVE_SENDMMSG)
     set(CMAKE_C_FLAGS_RELEASE "${CMAKE_C_FLAGS_RELEASE} -DHAVE_SENDMMSG=1")
     set(CMAKE_CXX_FLAGS_RELEASE "${CMAKE_CXX_FLAGS_RELEASE} -DHAVE_SENDMMSG=1")
 endif (HAVE_SENDMMSG)
+if (HAVE_RECVMMSG)
+    set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DHAVE_RECVMMSG=1")
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DHAVE_RECVMMSG=1")
+    set(CMAKE_C_FLAGS_RELEASE "${CMAKE_C_FLAGS_RELEASE} -DHAVE_RECVMMSG=1")
+    set(CMAKE_CXX_FLAGS_RELEASE "${CMAKE_CXX_FLAGS_RELEASE} -DHAVE_RECVMMSG=1")
+endif (HAVE_RECVMMSG)
 
 # are we enabling SSL support?
 if (NOT COMPILE_WIN32)
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Macros
+// ---------------------------------------------------------------------------
+
+#define IS(s) (::strcmp(argv[i], s) == 0)
+
+// ---------------------------------------------------------------------------
+//  Global Variables
+// ---------------------------------------------------------------------------
+
+static std::string g_progExe = std::string(__EXE_NAME__);
+static std::string g_filter = std::string();
+static std::string g_jsonFile = std::string();
+static bool g_jsonStdout = false;
+static bool g_list = false;
+static uint32_t g_minTime = 500U;
+static uint32_t g_repetitions = 5U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to pring usage the command line arguments. (And optionally an error.) */
+
+void usage(const char* message, const char* arg)
+{
+    ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+    ::fprintf(stdout, "Copyright (c) 2017-2025 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\n");
+    ::fprintf(stdout, "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\n\n");
+    if (message != nullptr) {
+        ::fprintf(stderr, "%s: ", g_progExe.c_str());
+        ::fprintf(stderr, message, arg);
+        ::fprintf(stderr, "\n\n");
+    }
+
+    ::fprintf(stdout,
+        "usage: %s [-vhl]"
+        "[-f <filter>]"
+        "[-t <ms>]"
+        "[-r <repetitions>]"
+        "[-o <json file>]"
+        "[--json]"
+        "\n\n"
+        "  -v                          show version information\n"
+        "  -h                          show this screen\n"
+        "  -l                          list the benchmarks\n"
+        "\n"
+        "  -f                          only run benchmarks whose group/name contains the filter\n"
+        "  -t                          minimum measured time per benchmark in ms (default 500)\n"
+        "  -r                          measured repetitions per benchmark (default 5)\n"
+        "\n"
+        "  -o                          write the results as JSON to the given file\n"
+        "  --json                      write the results as JSON to stdout (instead of the table)\n"
+        "\n"
+        "  --                          stop handling options\n",
+        g_progExe.c_str());
+    exit(EXIT_FAILURE);
+}
+
+/* Helper to validate the command line arguments. */
+
+int checkArgs(int argc, char* argv[])
+{
+    int i, p = 0;
+
+    // iterate through arguments
+    for (i = 1; i <= argc; i++)
+    {
+        if (argv[i] == nullptr) {
+            break;
+        }
+
+        if (*argv[i] != '-') {
+            continue;
+        }
+        else if (IS("--")) {
+            ++p;
+            break;
+        }
+        else if (IS("-f")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the benchmark filter");
+            g_filter = std::string(argv[++i]);
+
+            p += 2;
+        }
+        else if (IS("-t")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the minimum time");
+            g_minTime = (uint32_t)::atoi(argv[++i]);
+
+            if (g_minTime == 0U)
+                usage("error: %s", "minimum time cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-r")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the number of repetitions");
+            g_repetitions = (uint32_t)::atoi(argv[++i]);
+
+            if (g_repetitions == 0U)
+                usage("error: %s", "number of repetitions cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-o")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the JSON output file");
+            g_jsonFile = std::string(argv[++i]);
+
+            if (g_jsonFile.empty())
+                usage("error: %s", "JSON output file cannot be blank!");
+
+            p += 2;
+        }
+        else if (IS("--json")) {
+            ++p;
+            g_jsonStdout = true;
+        }
+        else if (IS("-l")) {
+            ++p;
+            g_list = true;
+        }
+        else if (IS("-v")) {
+            ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+            ::fprintf(stdout, "Copyright (c) 2017-2025 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\n");
+            ::fprintf(stdout, "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\n\n");
+            if (argc == 2)
+                exit(EXIT_SUCCESS);
+        }
+        else if (IS("-h")) {
+            usage(nullptr, nullptr);
+            if (argc == 2)
+                exit(EXIT_SUCCESS);
+        }
+        else {
+            usage("unrecognized option `%s'", argv[i]);
+        }
+    }
+
+    if (p < 0 || p > argc) {
+        p = 0;
+    }
+
+    return ++p;
+}
+
+// ---------------------------------------------------------------------------
+//  Program Entry Point
+// ---------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    if (argv[0] != nullptr && *argv[0] != 0)
+        g_progExe = std::string(argv[0]);
+
+    if (argc > 1) {
+        // check arguments
+        int i = checkArgs(argc, argv);
+        if (i < argc) {
+            argc -= i;
+            argv += i;
+        }
+        else {
+            argc--;
+            argv++;
+        }
+    }
+
+    // the kernels under test log at debug level; keep them quiet
+    if (!::LogInitialise("", __EXE_NAME__, 0U, 6U, true)) {
+        ::fprintf(stderr, "%s: unable to initialize logging\n", g_progExe.c_str());
+        return EXIT_FAILURE;
+    }
+
+    BenchmarkSuite suite(g_minTime, g_repetitions);
+    addEDACBenchmarks(suite);
+    addP25Benchmarks(suite);
+    addCryptoBenchmarks(suite);
+    addVocoderBenchmarks(suite);
+
+    if (g_list) {
+        suite.list(g_filter);
+        ::LogFinalise();
+        return EXIT_SUCCESS;
+    }
+
+    uint32_t count = suite.run(g_filter, g_jsonStdout);
+    if (count == 0U) {
+        ::fprintf(stderr, "%s: no benchmarks match `%s'\n", g_progExe.c_str(), g_filter.c_str());
+        ::LogFinalise();
+        return EXIT_FAILURE;
+    }
+
+    std::string json = suite.toJson();
+    if (g_jsonStdout) {
+        ::fprintf(stdout, "%s\n", json.c_str());
+    }
+
+    if (!g_jsonFile.empty()) {
+        FILE* fp = ::fopen(g_jsonFile.c_str(), "w");
+        if (fp == nullptr) {
+            ::fprintf(stderr, "%s: unable to open %s for writing\n", g_progExe.c_str(), g_jsonFile.c_str());
+            ::LogFinalise();
+            return EXIT_FAILURE;
+        }
+
+        ::fprintf(fp, "%s\n", json.c_str());
+        ::fclose(fp);
+    }
+
+    ::LogFinalise();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/network/json/json.h"
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define MAX_ITERATIONS (1ULL << 40)
+
+// ---------------------------------------------------------------------------
+//  Global Variables
+// ---------------------------------------------------------------------------
+
+volatile uint32_t g_benchSink = 0U;
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the BenchmarkSuite class. */
+
+BenchmarkSuite::BenchmarkSuite(uint32_t minTime, uint32_t repetitions) :
+    m_minTime(minTime),
+    m_repetitions(repetitions),
+    m_benchmarks(),
+    m_results()
+{
+    if (m_minTime == 0U)
+        m_minTime = 1U;
+    if (m_repetitions == 0U)
+        m_repetitions = 1U;
+}
+
+/* Registers a benchmark. */
+
+void BenchmarkSuite::add(const std::string& group, const std::string& name, BenchmarkFunc func, uint32_t frames, double successRate)
+{
+    Benchmark bench;
+    bench.group = group;
+    bench.name = name;
+    bench.frames = (frames > 0U) ? frames : 1U;
+    bench.successRate = successRate;
+    bench.func = func;
+
+    m_benchmarks.push_back(bench);
+}
+
+/* Prints the names of the registered benchmarks. */
+
+void BenchmarkSuite::list(const std::string& filter) const
+{
+    for (const Benchmark& bench : m_benchmarks) {
+        if (!matches(bench, filter))
+            continue;
+
+        ::fprintf(stdout, "%s/%s\n", bench.group.c_str(), bench.name.c_str());
+    }
+}
+
+/* Runs the registered benchmarks, printing each result as it completes. */
+
+uint32_t BenchmarkSuite::run(const std::string& filter, bool quiet)
+{
+    m_results.clear();
+
+    if (!quiet)
+        ::fprintf(stdout, "%-44s %14s %12s %12s %16s %10s\n", "Benchmark", "Iterations", "ns/op", "min ns/op", "frames/s", "success %");
+    for (const Benchmark& bench : m_benchmarks) {
+        if (!matches(bench, filter))
+            continue;
+
+        BenchmarkResult result = measure(bench);
+        m_results.push_back(result);
+
+        if (quiet)
+            continue;
+
+        std::string name = bench.group + "/" + bench.name;
+        ::fprintf(stdout, "%-44s %14llu %12.1f %12.1f %16.0f", name.c_str(), (unsigned long long)result.iterations,
+            result.nsPerOp, result.nsPerOpMin, result.framesPerSec);
+        if (result.successRate >= 0.0)
+            ::fprintf(stdout, " %10.2f\n", result.successRate);
+        else
+            ::fprintf(stdout, " %10s\n", "-");
+        ::fflush(stdout);
+    }
+
+    return (uint32_t)m_results.size();
+}
+
+/* Serializes the measured results to JSON. */
+
+std::string BenchmarkSuite::toJson() const
+{
+    json::object doc = json::object();
+
+    std::string program = std::string(__EXE_NAME__);
+    doc["program"].set<std::string>(program);
+    std::string version = std::string(__VER__);
+    doc["version"].set<std::string>(version);
+    std::string gitHash = std::string(__GIT_VER_HASH__);
+    doc["gitHash"].set<std::string>(gitHash);
+
+    char timestamp[32U];
+    std::time_t now = std::time(nullptr);
+    ::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    std::string time = std::string(timestamp);
+    doc["timestamp"].set<std::string>(time);
+
+    uint32_t cpus = std::thread::hardware_concurrency();
+    doc["cpus"].set<uint32_t>(cpus);
+    doc["minTime"].set<uint32_t>(m_minTime);
+    doc["repetitions"].set<uint32_t>(m_repetitions);
+
+    json::array benchmarks = json::array();
+    for (const BenchmarkResult& result : m_results) {
+        json::object bench = json::object();
+
+        std::string group = result.group;
+        bench["group"].set<std::string>(group);
+        std::string name = result.name;
+        bench["name"].set<std::string>(name);
+        uint32_t frames = result.frames;
+        bench["frames"].set<uint32_t>(frames);
+        uint64_t iterations = result.iterations;
+        bench["iterations"].set<uint64_t>(iterations);
+        float nsPerOp = (float)result.nsPerOp;
+        bench["nsPerOp"].set<float>(nsPerOp);
+        float nsPerOpMin = (float)result.nsPerOpMin;
+        bench["nsPerOpMin"].set<float>(nsPerOpMin);
+        double framesPerSec = std::round(result.framesPerSec);
+        bench["framesPerSec"].set<double>(framesPerSec);
+        if (result.successRate >= 0.0) {
+            float successRate = (float)result.successRate;
+            bench["successRate"].set<float>(successRate);
+        }
+
+        benchmarks.push_back(json::value(bench));
+    }
+
+    doc["benchmarks"].set<json::array>(benchmarks);
+
+    json::value v = json::value(doc);
+    return v.serialize(true);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to determine if a benchmark matches the filter. */
+
+bool BenchmarkSuite::matches(const Benchmark& bench, const std::string& filter)
+{
+    if (filter.empty())
+        return true;
+
+    std::string name = bench.group + "/" + bench.name;
+    return name.find(filter) != std::string::npos;
+}
+
+/* Helper to time a batch of operations. */
+
+uint64_t BenchmarkSuite::time(const Benchmark& bench, uint64_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    bench.func(iterations);
+    auto end = std::chrono::steady_clock::now();
+
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+/* Calibrates and measures a single benchmark. */
+
+BenchmarkResult BenchmarkSuite::measure(const Benchmark& bench) const
+{
+    // each repetition should run for its share of the minimum time
+    uint64_t target = ((uint64_t)m_minTime * 1000000ULL) / m_repetitions;
+    if (target == 0U)
+        target = 1U;
+
+    // grow the batch until it is long enough to extrapolate from (this also warms the caches)
+    uint64_t iterations = 1U;
+    while (iterations < MAX_ITERATIONS) {
+        uint64_t elapsed = time(bench, iterations);
+        if (elapsed >= target / 10U) {
+            double scale = (double)target / (double)((elapsed > 0U) ? elapsed : 1U);
+            iterations = (uint64_t)std::ceil(iterations * scale);
+            break;
+        }
+
+        iterations *= (elapsed < target / 100U) ? 10U : 2U;
+    }
+
+    if (iterations == 0U)
+        iterations = 1U;
+    if (iterations > MAX_ITERATIONS)
+        iterations = MAX_ITERATIONS;
+
+    std::vector<double> samples;
+    for (uint32_t i = 0U; i < m_repetitions; i++) {
+        uint64_t elapsed = time(bench, iterations);
+        samples.push_back((double)elapsed / (double)iterations);
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    BenchmarkResult result;
+    result.group = bench.group;
+    result.name = bench.name;
+    result.frames = bench.frames;
+    result.iterations = iterations;
+    result.nsPerOp = samples[samples.size() / 2U];
+    result.nsPerOpMin = samples[0U];
+    result.framesPerSec = (result.nsPerOp > 0.0) ? (bench.frames * 1e9) / result.nsPerOp : 0.0;
+    result.successRate = bench.successRate;
+
+    return result;
+}
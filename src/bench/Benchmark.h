@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file Benchmark.h
+ * @ingroup bench
+ * @file Benchmark.cpp
+ * @ingroup bench
+ */
+#if !defined(__BENCHMARK_H__)
+#define __BENCHMARK_H__
+
+#include "Defines.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Externs
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief (Global) Sink for kernel results. Benchmark bodies fold their results into this, so the
+ *  compiler cannot discard the work being measured.
+ */
+extern volatile uint32_t g_benchSink;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Benchmark body; runs the kernel under test the given number of times.
+ * @ingroup bench
+ */
+typedef std::function<void(uint64_t iterations)> BenchmarkFunc;
+
+/**
+ * @brief Represents the measured result of a single benchmark.
+ * @ingroup bench
+ */
+struct BenchmarkResult {
+    std::string group;                                      //! Benchmark group.
+    std::string name;                                       //! Benchmark name.
+    uint32_t frames;                                        //! Frames processed by a single operation.
+
+    uint64_t iterations;                                    //! Operations measured per repetition.
+    double nsPerOp;                                         //! Median time per operation (ns).
+    double nsPerOpMin;                                      //! Fastest time per operation (ns).
+    double framesPerSec;                                    //! Frames processed per second (at the median).
+    double successRate;                                     //! Percentage of operations producing the expected result (negative if not measured).
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief This class implements the benchmark registry and runner.
+ *  Each benchmark is calibrated until a batch of operations runs long enough to time reliably, then
+ *  measured over a number of repetitions; the median and fastest time per operation are reported.
+ * @ingroup bench
+ */
+class HOST_SW_API BenchmarkSuite {
+public:
+    /**
+     * @brief Initializes a new instance of the BenchmarkSuite class.
+     * @param minTime Minimum measured time for each benchmark (ms).
+     * @param repetitions Number of measured repetitions for each benchmark.
+     */
+    BenchmarkSuite(uint32_t minTime, uint32_t repetitions);
+
+    /**
+     * @brief Registers a benchmark.
+     * @param group Benchmark group.
+     * @param name Benchmark name.
+     * @param func Benchmark body.
+     * @param frames Frames processed by a single operation.
+     * @param successRate Percentage of operations producing the expected result, measured by the caller
+     *  (negative if not measured).
+     */
+    void add(const std::string& group, const std::string& name, BenchmarkFunc func, uint32_t frames = 1U, double successRate = -1.0);
+
+    /**
+     * @brief Prints the names of the registered benchmarks.
+     * @param filter Only list benchmarks whose "group/name" contains this string.
+     */
+    void list(const std::string& filter) const;
+    /**
+     * @brief Runs the registered benchmarks, printing each result as it completes.
+     * @param filter Only run benchmarks whose "group/name" contains this string.
+     * @param quiet Flag indicating the results should not be printed.
+     * @returns uint32_t Number of benchmarks run.
+     */
+    uint32_t run(const std::string& filter, bool quiet = false);
+
+    /**
+     * @brief Gets the measured results.
+     * @returns std::vector<BenchmarkResult> Measured results.
+     */
+    const std::vector<BenchmarkResult>& results() const { return m_results; }
+    /**
+     * @brief Serializes the measured results to JSON.
+     * @returns std::string JSON document.
+     */
+    std::string toJson() const;
+
+private:
+    uint32_t m_minTime;
+    uint32_t m_repetitions;
+
+    /**
+     * @brief Represents a registered benchmark.
+     */
+    struct Benchmark {
+        std::string group;
+        std::string name;
+        uint32_t frames;
+        double successRate;
+        BenchmarkFunc func;
+    };
+    std::vector<Benchmark> m_benchmarks;
+    std::vector<BenchmarkResult> m_results;
+
+    /**
+     * @brief Helper to determine if a benchmark matches the filter.
+     * @param bench Benchmark.
+     * @param filter Filter string.
+     * @returns bool True, if the benchmark matches, otherwise false.
+     */
+    static bool matches(const Benchmark& bench, const std::string& filter);
+    /**
+     * @brief Helper to time a batch of operations.
+     * @param bench Benchmark.
+     * @param iterations Number of operations.
+     * @returns uint64_t Elapsed time (ns).
+     */
+    static uint64_t time(const Benchmark& bench, uint64_t iterations);
+    /**
+     * @brief Calibrates and measures a single benchmark.
+     * @param bench Benchmark.
+     * @returns BenchmarkResult Measured result.
+     */
+    BenchmarkResult measure(const Benchmark& bench) const;
+};
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Registers the FEC and CRC benchmarks.
+ * @param suite Benchmark suite.
+ */
+extern void addEDACBenchmarks(BenchmarkSuite& suite);
+/**
+ * @brief Registers the AES and RC4 benchmarks.
+ * @param suite Benchmark suite.
+ */
+extern void addCryptoBenchmarks(BenchmarkSuite& suite);
+/**
+ * @brief Registers the P25 air interface benchmarks.
+ * @param suite Benchmark suite.
+ */
+extern void addP25Benchmarks(BenchmarkSuite& suite);
+/**
+ * @brief Registers the vocoder benchmarks.
+ * @param suite Benchmark suite.
+ */
+extern void addVocoderBenchmarks(BenchmarkSuite& suite);
+
+#endif // __BENCHMARK_H__
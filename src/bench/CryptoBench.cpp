@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/AESCrypto.h"
+#include "common/RC4Crypto.h"
+#include "Benchmark.h"
+
+using namespace crypto;
+
+#include <cctype>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define RANDOM_SEED 0x414553U
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Registers the AES and RC4 benchmarks. */
+
+void addCryptoBenchmarks(BenchmarkSuite& suite)
+{
+    std::mt19937 random(RANDOM_SEED);
+
+    std::vector<uint8_t> key(AES::MAX_KEY_LEN, 0x00U);
+    for (uint32_t i = 0U; i < key.size(); i++)
+        key[i] = (uint8_t)random();
+
+    std::vector<uint8_t> buffer(1024U, 0x00U);
+    for (uint32_t i = 0U; i < buffer.size(); i++)
+        buffer[i] = (uint8_t)random();
+
+    /*
+    ** AES-256; every block cipher engine this CPU supports
+    */
+    const AESEngine engines[] = { AESEngine::PORTABLE, AESEngine::AES_NI, AESEngine::ARMV8_CE };
+    for (AESEngine engine : engines) {
+        if (!AES::isEngineSupported(engine))
+            continue;
+
+        std::string name = AES::engineName(engine);
+        for (char& c : name)
+            c = (c == ' ') ? '-' : (char)::tolower(c);
+
+        suite.add("crypto", "aes256-setKey-" + name, [=](uint64_t iterations) {
+            AES aes(AESKeyLength::AES_256);
+            aes.setEngine(engine);
+
+            std::vector<uint8_t> k = key;
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                k[0U] = (uint8_t)i;
+                aes.setKey(k.data());
+                sink += aes.hasKey() ? 1U : 0U;
+            }
+            g_benchSink += sink;
+        });
+
+        // one block (a P25 keystream step), a wrapped P25 LDU datagram (a little over 200 bytes, padded
+        // to the block length) and a full network packet (the AES wrapped transport)
+        const uint32_t lengths[] = { 16U, 224U, 1024U };
+        for (uint32_t length : lengths) {
+            suite.add("crypto", "aes256-ecb-" + std::to_string(length) + "B-" + name, [=](uint64_t iterations) {
+                AES aes(AESKeyLength::AES_256);
+                aes.setEngine(engine);
+                aes.setKey(key.data());
+
+                std::vector<uint8_t> data(buffer.begin(), buffer.begin() + length);
+                uint32_t sink = 0U;
+                for (uint64_t i = 0U; i < iterations; i++) {
+                    aes.encryptECBInPlace(data.data(), length);
+                    sink += data[0U];
+                }
+                g_benchSink += sink;
+            });
+        }
+
+        // the allocating buffer API, which expands the key schedule on every call
+        suite.add("crypto", "aes256-ecb-alloc-224B-" + name, [=](uint64_t iterations) {
+            AES aes(AESKeyLength::AES_256);
+            aes.setEngine(engine);
+
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint8_t* crypted = aes.encryptECB(buffer.data(), 224U, key.data());
+                sink += crypted[223U];
+                delete[] crypted;
+            }
+            g_benchSink += sink;
+        });
+
+        // the P25 AES-256 OFB voice keystream, built the way P25Crypto::generateKeystream() does
+        suite.add("crypto", "aes256-ofb-keystream-240B-" + name, [=](uint64_t iterations) {
+            AES aes(AESKeyLength::AES_256);
+            aes.setEngine(engine);
+
+            uint8_t keystream[240U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint8_t input[16U];
+                ::memcpy(input, buffer.data(), 16U);
+                input[0U] = (uint8_t)i;
+
+                for (uint32_t n = 0U; n < (240U / 16U); n++) {
+                    uint8_t* output = aes.encryptECB(input, 16U, key.data());
+                    ::memcpy(keystream + (n * 16U), output, 16U);
+                    ::memcpy(input, output, 16U);
+                    delete[] output;
+                }
+
+                sink += keystream[239U];
+            }
+            g_benchSink += sink;
+        });
+    }
+
+    /*
+    ** RC4 (ADP)
+    */
+    std::vector<uint8_t> adpKey(key.begin(), key.begin() + 13U);
+
+    // the P25 ADP voice keystream, built the way P25Crypto::generateKeystream() does
+    suite.add("crypto", "rc4-keystream-469B", [=](uint64_t iterations) {
+        RC4 rc4;
+        std::vector<uint8_t> k = adpKey;
+        uint32_t sink = 0U;
+        for (uint64_t i = 0U; i < iterations; i++) {
+            k[5U] = (uint8_t)i;
+            uint8_t* keystream = rc4.keystream(469U, k.data(), 13U);
+            sink += keystream[468U];
+            delete[] keystream;
+        }
+        g_benchSink += sink;
+    });
+    suite.add("crypto", "rc4-crypt-1024B", [=](uint64_t iterations) {
+        RC4 rc4;
+        uint32_t sink = 0U;
+        for (uint64_t i = 0U; i < iterations; i++) {
+            uint8_t* out = rc4.crypt(buffer.data(), 1024U, adpKey.data(), 13U);
+            sink += out[1023U];
+            delete[] out;
+        }
+        g_benchSink += sink;
+    });
+}
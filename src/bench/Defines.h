@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @defgroup bench Benchmark Suite (dvmbench)
+ * @brief Digital Voice Modem - Benchmark Suite
+ * @details Microbenchmarks for the FEC, CRC, crypto and vocoder kernels.
+ * @ingroup bench
+ * 
+ * @file Defines.h
+ * @ingroup bench
+ */
+#if !defined(__DEFINES_H__)
+#define __DEFINES_H__
+
+#include "common/Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#undef __PROG_NAME__
+#define __PROG_NAME__ "Digital Voice Modem (DVM) Benchmark Suite"
+#undef __EXE_NAME__ 
+#define __EXE_NAME__ "dvmbench"
+
+#endif // __DEFINES_H__
@@ -0,0 +1,853 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/edac/AMBEFEC.h"
+#include "common/edac/BPTC19696.h"
+#include "common/edac/CRC.h"
+#include "common/edac/Golay2087.h"
+#include "common/edac/Golay24128.h"
+#include "common/edac/Hamming.h"
+#include "common/edac/QR1676.h"
+#include "common/edac/RS634717.h"
+#include "common/edac/Trellis.h"
+#include "common/nxdn/NXDNDefines.h"
+#include "common/nxdn/edac/Convolution.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/Audio.h"
+#include "common/p25/P25Utils.h"
+#include "common/Utils.h"
+#include "Benchmark.h"
+
+using namespace edac;
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/* Number of distinct inputs each benchmark cycles through; keeps the branch predictor honest. */
+#define POOL_SIZE 64U
+#define POOL_MASK (POOL_SIZE - 1U)
+
+#define RANDOM_SEED 0x44564DU
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to report a kernel that did not produce the expected result during setup. */
+
+static void setupFailed(const char* name)
+{
+    ::fprintf(stderr, "%s: %s did not decode its own encoded test vector, results are suspect\n", __EXE_NAME__, name);
+}
+
+/* Helper to flip the given symbol of a packed 6-bit (hexbit) RS codeword. */
+
+static void corruptHexbit(uint8_t* data, uint32_t symbol)
+{
+    uint32_t offset = symbol * 6U;
+    for (uint32_t i = 0U; i < 6U; i++, offset++) {
+        bool b = READ_BIT(data, offset) != 0U;
+        WRITE_BIT(data, offset, !b);
+    }
+}
+
+/* Helper to register the RS decode benchmarks for one RS code at the given error counts. */
+
+static void addRSDecode(BenchmarkSuite& suite, const std::string& name, uint32_t lengthBytes, uint32_t dataSymbols,
+    uint32_t codeSymbols, bool (RS634717::*decode)(uint8_t*), void (RS634717::*encode)(uint8_t*), const std::vector<uint32_t>& errors)
+{
+    std::mt19937 random(RANDOM_SEED);
+
+    RS634717 rs;
+    std::vector<uint8_t> clean(POOL_SIZE * lengthBytes, 0x00U);
+    for (uint32_t n = 0U; n < POOL_SIZE; n++) {
+        uint8_t* codeword = clean.data() + (n * lengthBytes);
+        for (uint32_t i = 0U; i < (dataSymbols * 6U) / 8U; i++)
+            codeword[i] = (uint8_t)random();
+
+        (rs.*encode)(codeword);
+    }
+
+    suite.add("edac", name + "-encode", [=](uint64_t iterations) {
+        RS634717 rs;
+        uint8_t buffer[64U];
+        uint32_t sink = 0U;
+        for (uint64_t i = 0U; i < iterations; i++) {
+            ::memcpy(buffer, clean.data() + ((i & POOL_MASK) * lengthBytes), lengthBytes);
+            (rs.*encode)(buffer);
+            sink += buffer[lengthBytes - 1U];
+        }
+        g_benchSink += sink;
+    });
+
+    for (uint32_t errs : errors) {
+        // spread the symbol errors over the codeword, moving them for each pool entry
+        std::vector<uint8_t> corrupt = clean;
+        for (uint32_t n = 0U; n < POOL_SIZE; n++) {
+            uint8_t* codeword = corrupt.data() + (n * lengthBytes);
+            for (uint32_t e = 0U; e < errs; e++)
+                corruptHexbit(codeword, (n + (e * (codeSymbols / errs))) % codeSymbols);
+
+            uint8_t check[64U];
+            ::memcpy(check, codeword, lengthBytes);
+            if (!(rs.*decode)(check) || ::memcmp(check, clean.data() + (n * lengthBytes), (dataSymbols * 6U) / 8U) != 0) {
+                setupFailed(name.c_str());
+                break;
+            }
+        }
+
+        // the decoders correct in place, so each operation includes restoring the corrupted codeword
+        suite.add("edac", name + "-decode-" + std::to_string(errs) + "err", [=](uint64_t iterations) {
+            RS634717 rs;
+            uint8_t buffer[64U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(buffer, corrupt.data() + ((i & POOL_MASK) * lengthBytes), lengthBytes);
+                sink += (rs.*decode)(buffer) ? buffer[0U] : 1U;
+            }
+            g_benchSink += sink;
+        });
+    }
+}
+
+/* Helper to find a single bit error the given decoder corrects, for the error path benchmarks. */
+
+template <typename DecodeFunc>
+static uint32_t findCorrectableBit(const uint8_t* data, uint32_t lengthBytes, uint32_t payloadBytes, DecodeFunc decode)
+{
+    uint8_t expected[64U], payload[64U], corrupt[64U];
+    ::memset(expected, 0x00U, sizeof(expected));
+    decode(data, expected);
+
+    for (uint32_t bit = 0U; bit < lengthBytes * 8U; bit++) {
+        ::memcpy(corrupt, data, lengthBytes);
+        bool b = READ_BIT(corrupt, bit) != 0U;
+        WRITE_BIT(corrupt, bit, !b);
+
+        ::memset(payload, 0x00U, sizeof(payload));
+        if (decode(corrupt, payload) && ::memcmp(payload, expected, payloadBytes) == 0) {
+            return bit;
+        }
+    }
+
+    return 0U;
+}
+
+/* Helper to register the Trellis decode benchmarks at the given injected bit error rates (in tenths of a percent). */
+
+static void addTrellisBER(BenchmarkSuite& suite, std::shared_ptr<Trellis> trellis, bool rate34, const std::vector<uint32_t>& rates)
+{
+    const uint32_t payloadBytes = rate34 ? 18U : 12U;
+    const uint32_t trials = 4096U;
+
+    std::mt19937 random(RANDOM_SEED);
+
+    for (uint32_t rate : rates) {
+        std::vector<uint8_t> corrupt(POOL_SIZE * dmr::defines::DMR_FRAME_LENGTH_BYTES, 0x00U);
+
+        // measure the success rate over more frames than the timed pool holds
+        uint32_t success = 0U;
+        for (uint32_t n = 0U; n < trials; n++) {
+            uint8_t payload[18U], data[dmr::defines::DMR_FRAME_LENGTH_BYTES];
+            ::memset(data, 0x00U, dmr::defines::DMR_FRAME_LENGTH_BYTES);
+            for (uint32_t i = 0U; i < payloadBytes; i++)
+                payload[i] = (uint8_t)random();
+
+            if (rate34)
+                trellis->encode34(payload, data);
+            else
+                trellis->encode12(payload, data);
+
+            for (uint32_t bit = 0U; bit < 196U; bit++) {
+                if ((random() % 1000U) < rate) {
+                    bool b = READ_BIT(data, bit) != 0U;
+                    WRITE_BIT(data, bit, !b);
+                }
+            }
+
+            uint8_t out[18U];
+            bool ret = rate34 ? trellis->decode34(data, out) : trellis->decode12(data, out);
+            if (ret && ::memcmp(out, payload, payloadBytes) == 0)
+                success++;
+
+            if (n < POOL_SIZE)
+                ::memcpy(corrupt.data() + (n * dmr::defines::DMR_FRAME_LENGTH_BYTES), data, dmr::defines::DMR_FRAME_LENGTH_BYTES);
+        }
+
+        std::string name = std::string(rate34 ? "trellis-decode34" : "trellis-decode12") + "-ber" +
+            std::to_string(rate / 10U) + "." + std::to_string(rate % 10U);
+        suite.add("edac", name, [=](uint64_t iterations) {
+            uint8_t out[18U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                const uint8_t* data = corrupt.data() + ((i & POOL_MASK) * dmr::defines::DMR_FRAME_LENGTH_BYTES);
+                bool ret = rate34 ? trellis->decode34(data, out) : trellis->decode12(data, out);
+                sink += ret ? out[0U] : 1U;
+            }
+            g_benchSink += sink;
+        }, 1U, (success * 100.0) / trials);
+    }
+}
+
+/* Registers the FEC and CRC benchmarks. */
+
+void addEDACBenchmarks(BenchmarkSuite& suite)
+{
+    std::mt19937 random(RANDOM_SEED);
+
+    /*
+    ** Golay
+    */
+    {
+        std::vector<uint32_t> codes(POOL_SIZE), corrupt(POOL_SIZE);
+        for (uint32_t n = 0U; n < POOL_SIZE; n++) {
+            codes[n] = Golay24128::encode24128(random() & 0xFFFU);
+            // three bit errors, the most Golay (24,12,8) corrects
+            corrupt[n] = codes[n] ^ (1U << (n % 8U)) ^ (1U << (8U + (n % 8U))) ^ (1U << (16U + (n % 8U)));
+        }
+
+        suite.add("edac", "golay24128-encode", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += Golay24128::encode24128((uint32_t)i & 0xFFFU);
+            g_benchSink += sink;
+        });
+        suite.add("edac", "golay24128-decode", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint32_t out = 0U;
+                Golay24128::decode24128(codes[i & POOL_MASK], out);
+                sink += out;
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "golay24128-decode-3err", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint32_t out = 0U;
+                Golay24128::decode24128(corrupt[i & POOL_MASK], out);
+                sink += out;
+            }
+            g_benchSink += sink;
+        });
+
+        std::vector<uint8_t> golay2087(POOL_SIZE * 3U, 0x00U);
+        for (uint32_t n = 0U; n < POOL_SIZE; n++) {
+            golay2087[n * 3U] = (uint8_t)random();
+            Golay2087::encode(golay2087.data() + (n * 3U));
+        }
+
+        suite.add("edac", "golay2087-encode", [=](uint64_t iterations) {
+            uint8_t data[3U] = { 0x00U, 0x00U, 0x00U };
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                data[0U] = (uint8_t)i;
+                Golay2087::encode(data);
+                sink += data[2U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "golay2087-decode", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += Golay2087::decode(golay2087.data() + ((i & POOL_MASK) * 3U));
+            g_benchSink += sink;
+        });
+    }
+
+    /*
+    ** QR (16,7,6)
+    */
+    {
+        std::vector<uint8_t> qr(POOL_SIZE * 2U, 0x00U);
+        for (uint32_t n = 0U; n < POOL_SIZE; n++) {
+            qr[n * 2U] = (uint8_t)random();
+            QR1676::encode(qr.data() + (n * 2U));
+        }
+
+        suite.add("edac", "qr1676-encode", [=](uint64_t iterations) {
+            uint8_t data[2U] = { 0x00U, 0x00U };
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                data[0U] = (uint8_t)(i << 1);
+                QR1676::encode(data);
+                sink += data[1U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "qr1676-decode", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += QR1676::decode(qr.data() + ((i & POOL_MASK) * 2U));
+            g_benchSink += sink;
+        });
+    }
+
+    /*
+    ** Hamming; packed codewords and the boolean bit array adapters, with a single bit error
+    */
+    {
+        // separate generator, so the pools of the other benchmarks stay as they were
+        std::mt19937 random(RANDOM_SEED);
+
+        std::vector<uint16_t> h15113(POOL_SIZE), h16114(POOL_SIZE);
+        std::vector<uint32_t> h17123(POOL_SIZE);
+        for (uint32_t n = 0U; n < POOL_SIZE; n++) {
+            uint16_t code = (uint16_t)(random() << 4);
+            Hamming::encode15113_2(code);
+            h15113[n] = code ^ (1U << (n % 15U));
+
+            code = (uint16_t)(random() << 5);
+            Hamming::encode16114(code);
+            h16114[n] = code ^ (1U << (n % 16U));
+
+            uint32_t code17 = (uint32_t)(random() << 5) & 0x1FFFFU;
+            Hamming::encode17123(code17);
+            h17123[n] = code17 ^ (1U << (n % 17U));
+        }
+
+        auto toBits = [](uint32_t code, uint32_t n, bool* d) {
+            for (uint32_t i = 0U; i < n; i++)
+                d[i] = ((code >> (n - 1U - i)) & 1U) != 0U;
+        };
+
+        suite.add("edac", "hamming15113-encode", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint16_t code = (uint16_t)(i << 4);
+                Hamming::encode15113_2(code);
+                sink += code;
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "hamming15113-encode-bool", [=](uint64_t iterations) {
+            bool d[15U];
+            toBits(0U, 15U, d);
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                d[i % 11U] = !d[i % 11U];
+                Hamming::encode15113_2(d);
+                sink += d[14U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "hamming15113-decode", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint16_t code = h15113[i & POOL_MASK];
+                sink += Hamming::decode15113_2(code) ? code : 1U;
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "hamming15113-decode-bool", [=](uint64_t iterations) {
+            bool pool[POOL_SIZE][15U], d[15U];
+            for (uint32_t n = 0U; n < POOL_SIZE; n++)
+                toBits(h15113[n], 15U, pool[n]);
+
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(d, pool[i & POOL_MASK], sizeof(d));
+                sink += Hamming::decode15113_2(d) ? d[0U] : 1U;
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "hamming16114-decode", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint16_t code = h16114[i & POOL_MASK];
+                sink += Hamming::decode16114(code) ? code : 1U;
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "hamming16114-decode-bool", [=](uint64_t iterations) {
+            bool pool[POOL_SIZE][16U], d[16U];
+            for (uint32_t n = 0U; n < POOL_SIZE; n++)
+                toBits(h16114[n], 16U, pool[n]);
+
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(d, pool[i & POOL_MASK], sizeof(d));
+                sink += Hamming::decode16114(d) ? d[0U] : 1U;
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "hamming17123-decode", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint32_t code = h17123[i & POOL_MASK];
+                sink += Hamming::decode17123(code) ? code : 1U;
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "hamming17123-decode-bool", [=](uint64_t iterations) {
+            bool pool[POOL_SIZE][17U], d[17U];
+            for (uint32_t n = 0U; n < POOL_SIZE; n++)
+                toBits(h17123[n], 17U, pool[n]);
+
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(d, pool[i & POOL_MASK], sizeof(d));
+                sink += Hamming::decode17123(d) ? d[0U] : 1U;
+            }
+            g_benchSink += sink;
+        });
+    }
+
+    /*
+    ** Reed-Solomon; 0, 1 and the most errors the decoders accept
+    */
+    addRSDecode(suite, "rs241213", 18U, 12U, 24U, &RS634717::decode241213, &RS634717::encode241213, { 0U, 1U, 5U });
+    addRSDecode(suite, "rs24169", 18U, 16U, 24U, &RS634717::decode24169, &RS634717::encode24169, { 0U, 1U, 3U });
+    addRSDecode(suite, "rs362017", 27U, 20U, 36U, &RS634717::decode362017, &RS634717::encode362017, { 0U, 1U, 7U });
+
+    /*
+    ** Trellis
+    */
+    {
+        std::shared_ptr<Trellis> trellis = std::make_shared<Trellis>();
+
+        uint8_t payload[18U];
+        for (uint32_t i = 0U; i < 18U; i++)
+            payload[i] = (uint8_t)random();
+
+        std::vector<uint8_t> data34(dmr::defines::DMR_FRAME_LENGTH_BYTES, 0x00U);
+        trellis->encode34(payload, data34.data(), true);
+
+        std::vector<uint8_t> data12(dmr::defines::DMR_FRAME_LENGTH_BYTES, 0x00U);
+        trellis->encode12(payload, data12.data());
+
+        std::vector<uint8_t> corrupt34 = data34;
+        uint32_t bit = findCorrectableBit(data34.data(), dmr::defines::DMR_FRAME_LENGTH_BYTES, 18U,
+            [&](const uint8_t* in, uint8_t* out) { return trellis->decode34(in, out, true); });
+        WRITE_BIT(corrupt34.data(), bit, READ_BIT(corrupt34.data(), bit) == 0U);
+
+        std::vector<uint8_t> corrupt12 = data12;
+        bit = findCorrectableBit(data12.data(), dmr::defines::DMR_FRAME_LENGTH_BYTES, 12U,
+            [&](const uint8_t* in, uint8_t* out) { return trellis->decode12(in, out); });
+        WRITE_BIT(corrupt12.data(), bit, READ_BIT(corrupt12.data(), bit) == 0U);
+
+        suite.add("edac", "trellis-encode34", [=](uint64_t iterations) {
+            uint8_t data[dmr::defines::DMR_FRAME_LENGTH_BYTES];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                trellis->encode34(payload, data, true);
+                sink += data[0U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "trellis-decode34", [=](uint64_t iterations) {
+            uint8_t out[18U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += trellis->decode34(data34.data(), out, true) ? out[0U] : 1U;
+            g_benchSink += sink;
+        });
+        suite.add("edac", "trellis-decode34-1err", [=](uint64_t iterations) {
+            uint8_t out[18U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += trellis->decode34(corrupt34.data(), out, true) ? out[0U] : 1U;
+            g_benchSink += sink;
+        });
+        suite.add("edac", "trellis-encode12", [=](uint64_t iterations) {
+            uint8_t data[dmr::defines::DMR_FRAME_LENGTH_BYTES];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                trellis->encode12(payload, data);
+                sink += data[0U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "trellis-decode12", [=](uint64_t iterations) {
+            uint8_t out[12U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += trellis->decode12(data12.data(), out) ? out[0U] : 1U;
+            g_benchSink += sink;
+        });
+        suite.add("edac", "trellis-decode12-1err", [=](uint64_t iterations) {
+            uint8_t out[12U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += trellis->decode12(corrupt12.data(), out) ? out[0U] : 1U;
+            g_benchSink += sink;
+        });
+
+        // decode success rate against injected bit error rate
+        addTrellisBER(suite, trellis, true, { 5U, 10U, 20U, 50U });
+        addTrellisBER(suite, trellis, false, { 5U, 10U, 20U, 50U });
+    }
+
+    /*
+    ** BPTC (196,96)
+    */
+    {
+        std::shared_ptr<BPTC19696> bptc = std::make_shared<BPTC19696>();
+
+        std::vector<uint8_t> data(POOL_SIZE * dmr::defines::DMR_FRAME_LENGTH_BYTES, 0x00U);
+        std::vector<uint8_t> corrupt(POOL_SIZE * dmr::defines::DMR_FRAME_LENGTH_BYTES, 0x00U);
+        for (uint32_t n = 0U; n < POOL_SIZE; n++) {
+            uint8_t payload[12U];
+            for (uint32_t i = 0U; i < 12U; i++)
+                payload[i] = (uint8_t)random();
+
+            uint8_t* burst = data.data() + (n * dmr::defines::DMR_FRAME_LENGTH_BYTES);
+            bptc->encode(payload, burst);
+
+            // one bit error in the first half of the burst, which the Hamming rows correct
+            uint8_t* bad = corrupt.data() + (n * dmr::defines::DMR_FRAME_LENGTH_BYTES);
+            ::memcpy(bad, burst, dmr::defines::DMR_FRAME_LENGTH_BYTES);
+            uint32_t bit = 10U + n;
+            WRITE_BIT(bad, bit, READ_BIT(bad, bit) == 0U);
+
+            uint8_t check[12U];
+            bptc->decode(bad, check);
+            if (::memcmp(check, payload, 12U) != 0)
+                setupFailed("bptc19696");
+        }
+
+        suite.add("edac", "bptc19696-encode", [=](uint64_t iterations) {
+            uint8_t payload[12U], out[dmr::defines::DMR_FRAME_LENGTH_BYTES];
+            ::memset(payload, 0x5AU, 12U);
+            ::memset(out, 0x00U, dmr::defines::DMR_FRAME_LENGTH_BYTES);
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                payload[0U] = (uint8_t)i;
+                bptc->encode(payload, out);
+                sink += out[0U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "bptc19696-decode", [=](uint64_t iterations) {
+            uint8_t out[12U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                bptc->decode(data.data() + ((i & POOL_MASK) * dmr::defines::DMR_FRAME_LENGTH_BYTES), out);
+                sink += out[0U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "bptc19696-decode-1err", [=](uint64_t iterations) {
+            uint8_t out[12U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                bptc->decode(corrupt.data() + ((i & POOL_MASK) * dmr::defines::DMR_FRAME_LENGTH_BYTES), out);
+                sink += out[0U];
+            }
+            g_benchSink += sink;
+        });
+    }
+
+    /*
+    ** NXDN convolution (Viterbi); a CAC sized block, with and without bit errors
+    */
+    {
+        const uint32_t bits = nxdn::defines::NXDN_CAC_CRC_LENGTH_BITS;
+
+        std::vector<uint8_t> symbols((bits + 4U) * 2U, 0x00U);
+        {
+            uint8_t in[(bits / 8U) + 1U], out[((bits + 4U) * 2U / 8U) + 1U];
+            for (uint32_t i = 0U; i < sizeof(in); i++)
+                in[i] = (uint8_t)random();
+            ::memset(out, 0x00U, sizeof(out));
+
+            nxdn::edac::Convolution conv;
+            conv.encode(in, out, bits + 4U);
+            for (uint32_t i = 0U; i < symbols.size(); i++)
+                symbols[i] = READ_BIT(out, i) ? 2U : 0U;
+        }
+
+        std::vector<uint8_t> corrupt = symbols;
+        for (uint32_t i = 7U; i < corrupt.size(); i += 41U)
+            corrupt[i] = 2U - corrupt[i];
+
+        suite.add("edac", "nxdn-conv-decode-cac", [=](uint64_t iterations) {
+            uint8_t out[(bits / 8U) + 1U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                nxdn::edac::Convolution conv;
+                conv.start();
+                conv.decodeBlock(symbols.data(), bits + 4U);
+                sink += conv.chainback(out, bits) + out[0U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "nxdn-conv-decode-cac-errors", [=](uint64_t iterations) {
+            uint8_t out[(bits / 8U) + 1U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                nxdn::edac::Convolution conv;
+                conv.start();
+                conv.decodeBlock(corrupt.data(), bits + 4U);
+                sink += conv.chainback(out, bits) + out[0U];
+            }
+            g_benchSink += sink;
+        });
+    }
+
+    /*
+    ** AMBE/IMBE FEC regeneration
+    */
+    {
+        std::shared_ptr<AMBEFEC> fec = std::make_shared<AMBEFEC>();
+
+        // DMR voice burst; three AMBE frames around the sync
+        std::vector<uint8_t> dmrBurst(dmr::defines::DMR_FRAME_LENGTH_BYTES, 0x00U);
+        {
+            uint8_t ambe[27U];
+            for (uint32_t i = 0U; i < 3U; i++)
+                ::memcpy(ambe + (i * 9U), dmr::defines::NULL_AMBE, dmr::defines::RAW_AMBE_LENGTH_BYTES);
+
+            ::memcpy(dmrBurst.data(), ambe, 13U);
+            dmrBurst[13U] = (uint8_t)(ambe[13U] & 0xF0U);
+            dmrBurst[19U] = (uint8_t)(ambe[13U] & 0x0FU);
+            ::memcpy(dmrBurst.data() + 20U, ambe + 14U, 13U);
+        }
+
+        std::vector<uint8_t> dmrCorrupt = dmrBurst;
+        dmrCorrupt[0U] ^= 0x81U;
+        dmrCorrupt[24U] ^= 0x10U;
+
+        // P25 IMBE frame, taken from an LDU the same way Audio::process() does
+        std::vector<uint8_t> imbe(18U, 0x00U);
+        {
+            p25::Audio audio;
+            uint8_t ldu[p25::defines::P25_LDU_FRAME_LENGTH_BYTES];
+            ::memset(ldu, 0x00U, p25::defines::P25_LDU_FRAME_LENGTH_BYTES);
+
+            uint8_t raw[p25::defines::RAW_IMBE_LENGTH_BYTES];
+            for (uint32_t i = 0U; i < p25::defines::RAW_IMBE_LENGTH_BYTES; i++)
+                raw[i] = (uint8_t)random();
+            audio.encode(ldu, raw, 0U);
+
+            p25::P25Utils::decode(ldu, imbe.data(), 114U, 262U);
+        }
+
+        std::vector<uint8_t> imbeCorrupt = imbe;
+        imbeCorrupt[0U] ^= 0x80U;
+        imbeCorrupt[9U] ^= 0x04U;
+
+        // the FEC is regenerated in place, so each operation includes restoring the input
+        suite.add("edac", "ambefec-regenerateDMR", [=](uint64_t iterations) {
+            uint8_t data[dmr::defines::DMR_FRAME_LENGTH_BYTES];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(data, dmrBurst.data(), dmr::defines::DMR_FRAME_LENGTH_BYTES);
+                sink += fec->regenerateDMR(data);
+            }
+            g_benchSink += sink;
+        }, 3U);
+        suite.add("edac", "ambefec-regenerateDMR-errors", [=](uint64_t iterations) {
+            uint8_t data[dmr::defines::DMR_FRAME_LENGTH_BYTES];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(data, dmrCorrupt.data(), dmr::defines::DMR_FRAME_LENGTH_BYTES);
+                sink += fec->regenerateDMR(data);
+            }
+            g_benchSink += sink;
+        }, 3U);
+        suite.add("edac", "ambefec-regenerateIMBE", [=](uint64_t iterations) {
+            uint8_t data[18U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(data, imbe.data(), 18U);
+                sink += fec->regenerateIMBE(data);
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "ambefec-regenerateIMBE-errors", [=](uint64_t iterations) {
+            uint8_t data[18U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(data, imbeCorrupt.data(), 18U);
+                sink += fec->regenerateIMBE(data);
+            }
+            g_benchSink += sink;
+        });
+        suite.add("edac", "ambefec-regenerateIMBE-ldu", [=](uint64_t iterations) {
+            uint8_t data[9U * IMBE_FEC_LENGTH_BYTES];
+            for (uint32_t n = 0U; n < 9U; n++)
+                ::memcpy(data + (n * IMBE_FEC_LENGTH_BYTES), imbeCorrupt.data(), IMBE_FEC_LENGTH_BYTES);
+
+            uint8_t work[9U * IMBE_FEC_LENGTH_BYTES];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(work, data, 9U * IMBE_FEC_LENGTH_BYTES);
+                sink += fec->regenerateIMBE(work, 9U);
+            }
+            g_benchSink += sink;
+        }, 9U);
+        suite.add("edac", "ambefec-regenerateNXDN-errors", [=](uint64_t iterations) {
+            uint8_t data[9U];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                ::memcpy(data, dmrCorrupt.data(), 9U);
+                sink += fec->regenerateNXDN(data);
+            }
+            g_benchSink += sink;
+        });
+    }
+
+    /*
+    ** CRC
+    */
+    {
+        std::vector<uint8_t> buffer(1024U, 0x00U);
+        for (uint32_t i = 0U; i < buffer.size(); i++)
+            buffer[i] = (uint8_t)random();
+
+        bool fiveBit[72U];
+        for (uint32_t i = 0U; i < 72U; i++)
+            fiveBit[i] = (random() & 1U) != 0U;
+        uint32_t fiveBitCRC = 0U;
+        CRC::encodeFiveBit(fiveBit, fiveBitCRC);
+
+        std::vector<bool> fiveBitVec(fiveBit, fiveBit + 72U);
+
+        suite.add("crc", "encodeFiveBit", [=](uint64_t iterations) {
+            bool in[72U];
+            for (uint32_t i = 0U; i < 72U; i++)
+                in[i] = fiveBitVec[i];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                uint32_t crc = 0U;
+                in[0U] = (i & 1U) != 0U;
+                CRC::encodeFiveBit(in, crc);
+                sink += crc;
+            }
+            g_benchSink += sink;
+        });
+        suite.add("crc", "checkFiveBit", [=](uint64_t iterations) {
+            bool in[72U];
+            for (uint32_t i = 0U; i < 72U; i++)
+                in[i] = fiveBitVec[i];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += CRC::checkFiveBit(in, fiveBitCRC) ? 1U : 0U;
+            g_benchSink += sink;
+        });
+
+        // byte oriented CRCs; lengths match their typical use (CSBK/TSBK, LC, PDU and network frames)
+        struct ByteCRC {
+            const char* name;
+            uint32_t length;
+            void (*add)(uint8_t*, uint32_t);
+            bool (*check)(const uint8_t*, uint32_t);
+        };
+        const ByteCRC byteCRCs[] = {
+            { "ccitt162-12B", 12U, &CRC::addCCITT162, &CRC::checkCCITT162 },
+            { "ccitt161-12B", 12U, &CRC::addCCITT161, &CRC::checkCCITT161 },
+            { "crc32-64B", 64U, &CRC::addCRC32, &CRC::checkCRC32 },
+            { "crc32-512B", 512U, &CRC::addCRC32, &CRC::checkCRC32 },
+        };
+
+        for (const ByteCRC& crc : byteCRCs) {
+            std::vector<uint8_t> data(buffer.begin(), buffer.begin() + crc.length);
+            crc.add(data.data(), crc.length);
+
+            uint32_t length = crc.length;
+            auto add = crc.add;
+            auto check = crc.check;
+            suite.add("crc", std::string("add-") + crc.name, [=](uint64_t iterations) {
+                std::vector<uint8_t> work = data;
+                uint32_t sink = 0U;
+                for (uint64_t i = 0U; i < iterations; i++) {
+                    work[0U] = (uint8_t)i;
+                    add(work.data(), length);
+                    sink += work[length - 1U];
+                }
+                g_benchSink += sink;
+            });
+            suite.add("crc", std::string("check-") + crc.name, [=](uint64_t iterations) {
+                uint32_t sink = 0U;
+                for (uint64_t i = 0U; i < iterations; i++)
+                    sink += check(data.data(), length) ? 1U : 0U;
+                g_benchSink += sink;
+            });
+        }
+
+        suite.add("crc", "crc8-4B", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += CRC::crc8(buffer.data() + (i & POOL_MASK), 4U);
+            g_benchSink += sink;
+        });
+
+        // bit oriented CRCs; lengths match the NXDN channels and P25/DMR data blocks that use them
+        struct BitCRC {
+            const char* name;
+            uint32_t bitLength;
+            uint32_t (*add)(uint8_t*, uint32_t);
+            bool (*check)(const uint8_t*, uint32_t);
+        };
+        const BitCRC bitCRCs[] = {
+            { "crc6-sacch", nxdn::defines::NXDN_SACCH_LENGTH_BITS,
+                [](uint8_t* in, uint32_t len) -> uint32_t { return CRC::addCRC6(in, len); }, &CRC::checkCRC6 },
+            { "crc12-facch1", nxdn::defines::NXDN_FACCH1_LENGTH_BITS,
+                [](uint8_t* in, uint32_t len) -> uint32_t { return CRC::addCRC12(in, len); }, &CRC::checkCRC12 },
+            { "crc15-udch", nxdn::defines::NXDN_UDCH_LENGTH_BITS,
+                [](uint8_t* in, uint32_t len) -> uint32_t { return CRC::addCRC15(in, len); }, &CRC::checkCRC15 },
+            { "crc16-cac", nxdn::defines::NXDN_CAC_LENGTH_BITS,
+                [](uint8_t* in, uint32_t len) -> uint32_t { return CRC::addCRC16(in, len); }, &CRC::checkCRC16 },
+        };
+
+        for (const BitCRC& crc : bitCRCs) {
+            std::vector<uint8_t> data(buffer.begin(), buffer.begin() + 64U);
+            crc.add(data.data(), crc.bitLength);
+
+            uint32_t bitLength = crc.bitLength;
+            auto add = crc.add;
+            auto check = crc.check;
+            suite.add("crc", std::string("add-") + crc.name, [=](uint64_t iterations) {
+                std::vector<uint8_t> work = data;
+                uint32_t sink = 0U;
+                for (uint64_t i = 0U; i < iterations; i++) {
+                    work[0U] = (uint8_t)i;
+                    sink += add(work.data(), bitLength);
+                }
+                g_benchSink += sink;
+            });
+            suite.add("crc", std::string("check-") + crc.name, [=](uint64_t iterations) {
+                uint32_t sink = 0U;
+                for (uint64_t i = 0U; i < iterations; i++)
+                    sink += check(data.data(), bitLength) ? 1U : 0U;
+                g_benchSink += sink;
+            });
+        }
+
+        suite.add("crc", "createCRC9-135b", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += CRC::createCRC9(buffer.data() + (i & POOL_MASK), 135U);
+            g_benchSink += sink;
+        });
+        suite.add("crc", "createCRC16-64B", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += CRC::createCRC16(buffer.data() + (i & POOL_MASK), 64U * 8U);
+            g_benchSink += sink;
+        });
+        suite.add("crc", "createCRC16-512B", [=](uint64_t iterations) {
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++)
+                sink += CRC::createCRC16(buffer.data() + (i & POOL_MASK), 512U * 8U);
+            g_benchSink += sink;
+        });
+    }
+}
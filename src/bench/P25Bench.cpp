@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/Audio.h"
+#include "common/p25/P25Utils.h"
+#include "Benchmark.h"
+
+using namespace p25;
+using namespace p25::defines;
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define RANDOM_SEED 0x503235U
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Registers the P25 air interface benchmarks. */
+
+void addP25Benchmarks(BenchmarkSuite& suite)
+{
+    std::mt19937 random(RANDOM_SEED);
+
+    std::vector<uint8_t> ldu(P25_LDU_FRAME_LENGTH_BYTES, 0x00U);
+    {
+        Audio audio;
+        for (uint32_t n = 0U; n < 9U; n++) {
+            uint8_t imbe[RAW_IMBE_LENGTH_BYTES];
+            for (uint32_t i = 0U; i < RAW_IMBE_LENGTH_BYTES; i++)
+                imbe[i] = (uint8_t)random();
+            audio.encode(ldu.data(), imbe, n);
+        }
+
+        P25Utils::addStatusBits(ldu.data(), P25_LDU_FRAME_LENGTH_BITS, false, false);
+    }
+
+    // status symbol stripping/insertion over one IMBE frame, one TSBK and a whole LDU
+    struct Span {
+        const char* name;
+        uint32_t start;
+        uint32_t stop;
+    };
+    const Span spans[] = {
+        { "imbe", 114U, 262U },
+        { "tsdu", 114U, 318U },
+        { "ldu", 114U, 1726U },
+    };
+
+    for (const Span& span : spans) {
+        uint32_t start = span.start, stop = span.stop;
+
+        suite.add("p25", std::string("P25Utils-decode-") + span.name, [=](uint64_t iterations) {
+            uint8_t out[P25_LDU_FRAME_LENGTH_BYTES];
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                P25Utils::decode(ldu.data(), out, start, stop);
+                sink += out[0U];
+            }
+            g_benchSink += sink;
+        });
+        suite.add("p25", std::string("P25Utils-encode-") + span.name, [=](uint64_t iterations) {
+            uint8_t raw[P25_LDU_FRAME_LENGTH_BYTES];
+            P25Utils::decode(ldu.data(), raw, start, stop);
+
+            std::vector<uint8_t> data = ldu;
+            uint32_t sink = 0U;
+            for (uint64_t i = 0U; i < iterations; i++) {
+                raw[0U] = (uint8_t)i;
+                P25Utils::encode(raw, data.data(), start, stop);
+                sink += data[start / 8U];
+            }
+            g_benchSink += sink;
+        });
+    }
+
+    suite.add("p25", "P25Utils-addStatusBits-ldu", [=](uint64_t iterations) {
+        std::vector<uint8_t> data = ldu;
+        uint32_t sink = 0U;
+        for (uint64_t i = 0U; i < iterations; i++) {
+            P25Utils::addStatusBits(data.data(), P25_LDU_FRAME_LENGTH_BITS, (i & 1U) != 0U, false);
+            sink += data[8U];
+        }
+        g_benchSink += sink;
+    });
+
+    // full LDU audio FEC regeneration, as done for every received LDU (nine IMBE frames)
+    suite.add("p25", "Audio-process-ldu", [=](uint64_t iterations) {
+        Audio audio;
+        std::vector<uint8_t> data = ldu;
+        uint32_t sink = 0U;
+        for (uint64_t i = 0U; i < iterations; i++) {
+            ::memcpy(data.data(), ldu.data(), P25_LDU_FRAME_LENGTH_BYTES);
+            sink += audio.process(data.data());
+        }
+        g_benchSink += sink;
+    }, 9U);
+}
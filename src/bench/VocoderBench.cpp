@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Benchmark Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "vocoder/MBEDecoder.h"
+#include "vocoder/MBEEncoder.h"
+#include "Benchmark.h"
+
+using namespace vocoder;
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define SAMPLES_PER_FRAME 160U
+#define SAMPLE_RATE 8000.0
+/* One second of audio; the vocoders are stateful, so they are fed a continuous signal. */
+#define AUDIO_FRAMES 50U
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to generate a voiced, speech-like test signal (a harmonic series with a moving pitch and envelope). */
+
+static std::vector<int16_t> generateAudio()
+{
+    std::vector<int16_t> audio(AUDIO_FRAMES * SAMPLES_PER_FRAME, 0);
+
+    double phase = 0.0;
+    for (uint32_t n = 0U; n < audio.size(); n++) {
+        double t = n / SAMPLE_RATE;
+        double pitch = 140.0 + 30.0 * std::sin(2.0 * M_PI * 1.5 * t);
+        double envelope = 0.55 + 0.45 * std::sin(2.0 * M_PI * 3.0 * t);
+
+        phase += 2.0 * M_PI * pitch / SAMPLE_RATE;
+
+        double sample = 0.0;
+        for (uint32_t h = 1U; h <= 12U; h++)
+            sample += std::sin(phase * h) / h;
+
+        audio[n] = (int16_t)(sample * envelope * 6000.0);
+    }
+
+    return audio;
+}
+
+/* Helper to register the encode and decode benchmarks for one vocoder mode. */
+
+static void addVocoder(BenchmarkSuite& suite, const std::string& name, MBE_ENCODER_MODE encMode, MBE_DECODER_MODE decMode,
+    uint32_t codewordLength, const std::vector<int16_t>& audio)
+{
+    // pre-encode the test signal for the decoder benchmark
+    std::vector<uint8_t> codewords(AUDIO_FRAMES * codewordLength, 0x00U);
+    {
+        MBEEncoder encoder(encMode);
+        int16_t samples[SAMPLES_PER_FRAME];
+        for (uint32_t n = 0U; n < AUDIO_FRAMES; n++) {
+            ::memcpy(samples, audio.data() + (n * SAMPLES_PER_FRAME), sizeof(samples));
+            encoder.encode(samples, codewords.data() + (n * codewordLength));
+        }
+    }
+
+    suite.add("vocoder", "MBEEncoder-encode-" + name, [=](uint64_t iterations) {
+        std::unique_ptr<MBEEncoder> encoder = std::make_unique<MBEEncoder>(encMode);
+
+        int16_t samples[SAMPLES_PER_FRAME];
+        uint8_t codeword[16U];
+        ::memset(codeword, 0x00U, sizeof(codeword));
+
+        uint32_t sink = 0U;
+        for (uint64_t i = 0U; i < iterations; i++) {
+            ::memcpy(samples, audio.data() + ((i % AUDIO_FRAMES) * SAMPLES_PER_FRAME), sizeof(samples));
+            encoder->encode(samples, codeword);
+            sink += codeword[0U];
+        }
+        g_benchSink += sink;
+    });
+
+    suite.add("vocoder", "MBEDecoder-decode-" + name, [=](uint64_t iterations) {
+        std::unique_ptr<MBEDecoder> decoder = std::make_unique<MBEDecoder>(decMode);
+
+        std::vector<uint8_t> input = codewords;
+        int16_t samples[SAMPLES_PER_FRAME];
+
+        uint32_t sink = 0U;
+        for (uint64_t i = 0U; i < iterations; i++) {
+            decoder->decode(input.data() + ((i % AUDIO_FRAMES) * codewordLength), samples);
+            sink += (uint16_t)samples[SAMPLES_PER_FRAME / 2U];
+        }
+        g_benchSink += sink;
+    });
+}
+
+/* Registers the vocoder benchmarks. */
+
+void addVocoderBenchmarks(BenchmarkSuite& suite)
+{
+    std::vector<int16_t> audio = generateAudio();
+
+    addVocoder(suite, "imbe", ENCODE_88BIT_IMBE, DECODE_88BIT_IMBE, 11U, audio);
+    addVocoder(suite, "ambe", ENCODE_DMR_AMBE, DECODE_DMR_AMBE, 9U, audio);
+}
@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2019 SergeyBel
- *  Copyright (C) 2023 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2023,2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
@@ -15,9 +15,38 @@
 
 using namespace crypto;
 
+#include <cassert>
 #include <cstring>
+#include <mutex>
 #include <string>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define AES_ENGINE_AES_NI
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define AES_TARGET_AES_NI
+#else
+#include <cpuid.h>
+#define AES_TARGET_AES_NI __attribute__((target("aes,sse2")))
+#endif
+#endif // defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#if defined(__aarch64__) && defined(__GNUC__) && (defined(__linux__) || defined(__APPLE__))
+#define AES_ENGINE_ARMV8_CE
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#if defined(__clang__)
+#define AES_TARGET_ARMV8_CE __attribute__((target("aes")))
+#else
+#define AES_TARGET_ARMV8_CE __attribute__((target("+crypto")))
+#endif
+#endif // defined(__aarch64__) && defined(__GNUC__) && (defined(__linux__) || defined(__APPLE__))
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
@@ -232,19 +261,301 @@ static const uint8_t GF_MUL_TABLE[15][256] = {
     }
 };
 
-// Circulant MDS matrix
-static const uint8_t CMDS[4][4] = { {2, 3, 1, 1}, {1, 2, 3, 1}, {1, 1, 2, 3}, {3, 1, 1, 2} };
-
 // Inverse circulant MDS matrix
 static const uint8_t INV_CMDS[4][4] = { {14, 11, 13, 9}, {9, 14, 11, 13}, {13, 9, 14, 11}, {11, 13, 9, 14} };
 
+// ---------------------------------------------------------------------------
+//  Block Cipher Engines
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Combined SubBytes/ShiftRows/MixColumns round tables used by the portable engine.
+ */
+struct AESTables {
+    uint32_t Te[4][256];
+    uint32_t Td[4][256];
+    uint8_t S[256];
+    uint8_t Si[256];
+};
+
+static AESTables s_tables;
+static std::once_flag s_tablesOnce;
+
+/* Helper to build the portable engine round tables. */
+
+static void initTables()
+{
+    for (uint32_t x = 0U; x < 256U; x++) {
+        uint8_t s = SBOX[x >> 4][x & 0x0FU];
+        uint8_t si = INV_SBOX[x >> 4][x & 0x0FU];
+        s_tables.S[x] = s;
+        s_tables.Si[x] = si;
+
+        // column contributions for MixColumns (2, 1, 1, 3) and InvMixColumns (14, 9, 13, 11)
+        uint32_t te = ((uint32_t)GF_MUL_TABLE[2][s] << 24) | ((uint32_t)s << 16) | ((uint32_t)s << 8) | GF_MUL_TABLE[3][s];
+        uint32_t td = ((uint32_t)GF_MUL_TABLE[14][si] << 24) | ((uint32_t)GF_MUL_TABLE[9][si] << 16) |
+            ((uint32_t)GF_MUL_TABLE[13][si] << 8) | GF_MUL_TABLE[11][si];
+        for (uint32_t i = 0U; i < 4U; i++) {
+            s_tables.Te[i][x] = (i == 0U) ? te : ((te >> (8U * i)) | (te << (32U - 8U * i)));
+            s_tables.Td[i][x] = (i == 0U) ? td : ((td >> (8U * i)) | (td << (32U - 8U * i)));
+        }
+    }
+}
+
+/* */
+
+static inline uint32_t load32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/* */
+
+static inline void store32(uint8_t* p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/* Portable engine block encryption. */
+
+static void portableEncrypt(const uint8_t* roundKeys, uint32_t nr, const uint8_t* in, uint8_t* out, uint32_t blocks)
+{
+    const uint32_t (*Te)[256] = s_tables.Te;
+    const uint8_t* S = s_tables.S;
+
+    for (uint32_t b = 0U; b < blocks; b++, in += AES::BLOCK_BYTES_LEN, out += AES::BLOCK_BYTES_LEN) {
+        const uint8_t* rk = roundKeys;
+        uint32_t s0 = load32(in) ^ load32(rk);
+        uint32_t s1 = load32(in + 4U) ^ load32(rk + 4U);
+        uint32_t s2 = load32(in + 8U) ^ load32(rk + 8U);
+        uint32_t s3 = load32(in + 12U) ^ load32(rk + 12U);
+
+        uint32_t t0, t1, t2, t3;
+        for (uint32_t round = 1U; round < nr; round++) {
+            rk += AES::BLOCK_BYTES_LEN;
+            t0 = Te[0][s0 >> 24] ^ Te[1][(s1 >> 16) & 0xFFU] ^ Te[2][(s2 >> 8) & 0xFFU] ^ Te[3][s3 & 0xFFU] ^ load32(rk);
+            t1 = Te[0][s1 >> 24] ^ Te[1][(s2 >> 16) & 0xFFU] ^ Te[2][(s3 >> 8) & 0xFFU] ^ Te[3][s0 & 0xFFU] ^ load32(rk + 4U);
+            t2 = Te[0][s2 >> 24] ^ Te[1][(s3 >> 16) & 0xFFU] ^ Te[2][(s0 >> 8) & 0xFFU] ^ Te[3][s1 & 0xFFU] ^ load32(rk + 8U);
+            t3 = Te[0][s3 >> 24] ^ Te[1][(s0 >> 16) & 0xFFU] ^ Te[2][(s1 >> 8) & 0xFFU] ^ Te[3][s2 & 0xFFU] ^ load32(rk + 12U);
+            s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+        }
+
+        // final round (no MixColumns)
+        rk += AES::BLOCK_BYTES_LEN;
+        t0 = ((uint32_t)S[s0 >> 24] << 24) | ((uint32_t)S[(s1 >> 16) & 0xFFU] << 16) | ((uint32_t)S[(s2 >> 8) & 0xFFU] << 8) | S[s3 & 0xFFU];
+        t1 = ((uint32_t)S[s1 >> 24] << 24) | ((uint32_t)S[(s2 >> 16) & 0xFFU] << 16) | ((uint32_t)S[(s3 >> 8) & 0xFFU] << 8) | S[s0 & 0xFFU];
+        t2 = ((uint32_t)S[s2 >> 24] << 24) | ((uint32_t)S[(s3 >> 16) & 0xFFU] << 16) | ((uint32_t)S[(s0 >> 8) & 0xFFU] << 8) | S[s1 & 0xFFU];
+        t3 = ((uint32_t)S[s3 >> 24] << 24) | ((uint32_t)S[(s0 >> 16) & 0xFFU] << 16) | ((uint32_t)S[(s1 >> 8) & 0xFFU] << 8) | S[s2 & 0xFFU];
+
+        store32(out, t0 ^ load32(rk));
+        store32(out + 4U, t1 ^ load32(rk + 4U));
+        store32(out + 8U, t2 ^ load32(rk + 8U));
+        store32(out + 12U, t3 ^ load32(rk + 12U));
+    }
+}
+
+/* Portable engine block decryption. */
+
+static void portableDecrypt(const uint8_t* roundKeys, uint32_t nr, const uint8_t* in, uint8_t* out, uint32_t blocks)
+{
+    const uint32_t (*Td)[256] = s_tables.Td;
+    const uint8_t* Si = s_tables.Si;
+
+    for (uint32_t b = 0U; b < blocks; b++, in += AES::BLOCK_BYTES_LEN, out += AES::BLOCK_BYTES_LEN) {
+        const uint8_t* rk = roundKeys;
+        uint32_t s0 = load32(in) ^ load32(rk);
+        uint32_t s1 = load32(in + 4U) ^ load32(rk + 4U);
+        uint32_t s2 = load32(in + 8U) ^ load32(rk + 8U);
+        uint32_t s3 = load32(in + 12U) ^ load32(rk + 12U);
+
+        uint32_t t0, t1, t2, t3;
+        for (uint32_t round = 1U; round < nr; round++) {
+            rk += AES::BLOCK_BYTES_LEN;
+            t0 = Td[0][s0 >> 24] ^ Td[1][(s3 >> 16) & 0xFFU] ^ Td[2][(s2 >> 8) & 0xFFU] ^ Td[3][s1 & 0xFFU] ^ load32(rk);
+            t1 = Td[0][s1 >> 24] ^ Td[1][(s0 >> 16) & 0xFFU] ^ Td[2][(s3 >> 8) & 0xFFU] ^ Td[3][s2 & 0xFFU] ^ load32(rk + 4U);
+            t2 = Td[0][s2 >> 24] ^ Td[1][(s1 >> 16) & 0xFFU] ^ Td[2][(s0 >> 8) & 0xFFU] ^ Td[3][s3 & 0xFFU] ^ load32(rk + 8U);
+            t3 = Td[0][s3 >> 24] ^ Td[1][(s2 >> 16) & 0xFFU] ^ Td[2][(s1 >> 8) & 0xFFU] ^ Td[3][s0 & 0xFFU] ^ load32(rk + 12U);
+            s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+        }
+
+        // final round (no InvMixColumns)
+        rk += AES::BLOCK_BYTES_LEN;
+        t0 = ((uint32_t)Si[s0 >> 24] << 24) | ((uint32_t)Si[(s3 >> 16) & 0xFFU] << 16) | ((uint32_t)Si[(s2 >> 8) & 0xFFU] << 8) | Si[s1 & 0xFFU];
+        t1 = ((uint32_t)Si[s1 >> 24] << 24) | ((uint32_t)Si[(s0 >> 16) & 0xFFU] << 16) | ((uint32_t)Si[(s3 >> 8) & 0xFFU] << 8) | Si[s2 & 0xFFU];
+        t2 = ((uint32_t)Si[s2 >> 24] << 24) | ((uint32_t)Si[(s1 >> 16) & 0xFFU] << 16) | ((uint32_t)Si[(s0 >> 8) & 0xFFU] << 8) | Si[s3 & 0xFFU];
+        t3 = ((uint32_t)Si[s3 >> 24] << 24) | ((uint32_t)Si[(s2 >> 16) & 0xFFU] << 16) | ((uint32_t)Si[(s1 >> 8) & 0xFFU] << 8) | Si[s0 & 0xFFU];
+
+        store32(out, t0 ^ load32(rk));
+        store32(out + 4U, t1 ^ load32(rk + 4U));
+        store32(out + 8U, t2 ^ load32(rk + 8U));
+        store32(out + 12U, t3 ^ load32(rk + 12U));
+    }
+}
+
+#if defined(AES_ENGINE_AES_NI)
+/* AES-NI engine block encryption. */
+
+AES_TARGET_AES_NI static void aesniEncrypt(const uint8_t* roundKeys, uint32_t nr, const uint8_t* in, uint8_t* out, uint32_t blocks)
+{
+    __m128i rk[AES_MAX_NR + 1];
+    for (uint32_t i = 0U; i <= nr; i++)
+        rk[i] = _mm_loadu_si128((const __m128i*)(roundKeys + i * AES::BLOCK_BYTES_LEN));
+
+    // interleave four blocks at a time to hide the latency of the AES instructions
+    uint32_t b = 0U;
+    for (; b + 4U <= blocks; b += 4U, in += 4U * AES::BLOCK_BYTES_LEN, out += 4U * AES::BLOCK_BYTES_LEN) {
+        __m128i s0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in)), rk[0]);
+        __m128i s1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + 16U)), rk[0]);
+        __m128i s2 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + 32U)), rk[0]);
+        __m128i s3 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + 48U)), rk[0]);
+        for (uint32_t round = 1U; round < nr; round++) {
+            s0 = _mm_aesenc_si128(s0, rk[round]);
+            s1 = _mm_aesenc_si128(s1, rk[round]);
+            s2 = _mm_aesenc_si128(s2, rk[round]);
+            s3 = _mm_aesenc_si128(s3, rk[round]);
+        }
+        _mm_storeu_si128((__m128i*)(out), _mm_aesenclast_si128(s0, rk[nr]));
+        _mm_storeu_si128((__m128i*)(out + 16U), _mm_aesenclast_si128(s1, rk[nr]));
+        _mm_storeu_si128((__m128i*)(out + 32U), _mm_aesenclast_si128(s2, rk[nr]));
+        _mm_storeu_si128((__m128i*)(out + 48U), _mm_aesenclast_si128(s3, rk[nr]));
+    }
+
+    for (; b < blocks; b++, in += AES::BLOCK_BYTES_LEN, out += AES::BLOCK_BYTES_LEN) {
+        __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), rk[0]);
+        for (uint32_t round = 1U; round < nr; round++)
+            s = _mm_aesenc_si128(s, rk[round]);
+        _mm_storeu_si128((__m128i*)out, _mm_aesenclast_si128(s, rk[nr]));
+    }
+}
+
+/* AES-NI engine block decryption. */
+
+AES_TARGET_AES_NI static void aesniDecrypt(const uint8_t* roundKeys, uint32_t nr, const uint8_t* in, uint8_t* out, uint32_t blocks)
+{
+    __m128i rk[AES_MAX_NR + 1];
+    for (uint32_t i = 0U; i <= nr; i++)
+        rk[i] = _mm_loadu_si128((const __m128i*)(roundKeys + i * AES::BLOCK_BYTES_LEN));
+
+    // interleave four blocks at a time to hide the latency of the AES instructions
+    uint32_t b = 0U;
+    for (; b + 4U <= blocks; b += 4U, in += 4U * AES::BLOCK_BYTES_LEN, out += 4U * AES::BLOCK_BYTES_LEN) {
+        __m128i s0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in)), rk[0]);
+        __m128i s1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + 16U)), rk[0]);
+        __m128i s2 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + 32U)), rk[0]);
+        __m128i s3 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(in + 48U)), rk[0]);
+        for (uint32_t round = 1U; round < nr; round++) {
+            s0 = _mm_aesdec_si128(s0, rk[round]);
+            s1 = _mm_aesdec_si128(s1, rk[round]);
+            s2 = _mm_aesdec_si128(s2, rk[round]);
+            s3 = _mm_aesdec_si128(s3, rk[round]);
+        }
+        _mm_storeu_si128((__m128i*)(out), _mm_aesdeclast_si128(s0, rk[nr]));
+        _mm_storeu_si128((__m128i*)(out + 16U), _mm_aesdeclast_si128(s1, rk[nr]));
+        _mm_storeu_si128((__m128i*)(out + 32U), _mm_aesdeclast_si128(s2, rk[nr]));
+        _mm_storeu_si128((__m128i*)(out + 48U), _mm_aesdeclast_si128(s3, rk[nr]));
+    }
+
+    for (; b < blocks; b++, in += AES::BLOCK_BYTES_LEN, out += AES::BLOCK_BYTES_LEN) {
+        __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i*)in), rk[0]);
+        for (uint32_t round = 1U; round < nr; round++)
+            s = _mm_aesdec_si128(s, rk[round]);
+        _mm_storeu_si128((__m128i*)out, _mm_aesdeclast_si128(s, rk[nr]));
+    }
+}
+#endif // defined(AES_ENGINE_AES_NI)
+
+#if defined(AES_ENGINE_ARMV8_CE)
+/* ARMv8 cryptography extensions engine block encryption. */
+
+AES_TARGET_ARMV8_CE static void armv8Encrypt(const uint8_t* roundKeys, uint32_t nr, const uint8_t* in, uint8_t* out, uint32_t blocks)
+{
+    uint8x16_t rk[AES_MAX_NR + 1];
+    for (uint32_t i = 0U; i <= nr; i++)
+        rk[i] = vld1q_u8(roundKeys + i * AES::BLOCK_BYTES_LEN);
+
+    for (uint32_t b = 0U; b < blocks; b++, in += AES::BLOCK_BYTES_LEN, out += AES::BLOCK_BYTES_LEN) {
+        // AESE performs AddRoundKey, SubBytes and ShiftRows; AESMC performs MixColumns
+        uint8x16_t s = vld1q_u8(in);
+        for (uint32_t round = 0U; round < nr - 1U; round++)
+            s = vaesmcq_u8(vaeseq_u8(s, rk[round]));
+        s = vaeseq_u8(s, rk[nr - 1U]);
+        vst1q_u8(out, veorq_u8(s, rk[nr]));
+    }
+}
+
+/* ARMv8 cryptography extensions engine block decryption. */
+
+AES_TARGET_ARMV8_CE static void armv8Decrypt(const uint8_t* roundKeys, uint32_t nr, const uint8_t* in, uint8_t* out, uint32_t blocks)
+{
+    uint8x16_t rk[AES_MAX_NR + 1];
+    for (uint32_t i = 0U; i <= nr; i++)
+        rk[i] = vld1q_u8(roundKeys + i * AES::BLOCK_BYTES_LEN);
+
+    for (uint32_t b = 0U; b < blocks; b++, in += AES::BLOCK_BYTES_LEN, out += AES::BLOCK_BYTES_LEN) {
+        // AESD performs AddRoundKey, InvShiftRows and InvSubBytes; AESIMC performs InvMixColumns
+        uint8x16_t s = vld1q_u8(in);
+        for (uint32_t round = 0U; round < nr - 1U; round++)
+            s = vaesimcq_u8(vaesdq_u8(s, rk[round]));
+        s = vaesdq_u8(s, rk[nr - 1U]);
+        vst1q_u8(out, veorq_u8(s, rk[nr]));
+    }
+}
+#endif // defined(AES_ENGINE_ARMV8_CE)
+
+/* Helper to detect the block cipher engines supported on this CPU. */
+
+static bool detectEngine(AESEngine engine)
+{
+    switch (engine) {
+    case AESEngine::PORTABLE:
+        return true;
+#if defined(AES_ENGINE_AES_NI)
+    case AESEngine::AES_NI:
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 25)) != 0;
+#else
+        uint32_t eax = 0U, ebx = 0U, ecx = 0U, edx = 0U;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+            return false;
+        return (ecx & bit_AES) != 0U && (edx & bit_SSE2) != 0U;
+#endif
+    }
+#endif // defined(AES_ENGINE_AES_NI)
+#if defined(AES_ENGINE_ARMV8_CE)
+    case AESEngine::ARMV8_CE:
+#if defined(__APPLE__)
+        return true;
+#else
+        return (getauxval(AT_HWCAP) & HWCAP_AES) != 0U;
+#endif
+#endif // defined(AES_ENGINE_ARMV8_CE)
+    default:
+        return false;
+    }
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
 
 /* Initializes a new instance of the AES class. */
 
-AES::AES(const AESKeyLength keyLength) {
+AES::AES(const AESKeyLength keyLength) :
+    m_Nk(8U),
+    m_Nr(14U),
+    m_engine(AESEngine::PORTABLE),
+    m_encryptBlocks(portableEncrypt),
+    m_decryptBlocks(portableDecrypt),
+    m_schedule(),
+    m_key(),
+    m_hasKey(false)
+{
     switch (keyLength) {
     case AESKeyLength::AES_128:
         this->m_Nk = 4;
@@ -259,6 +570,56 @@ AES::AES(const AESKeyLength keyLength) {
         this->m_Nr = 14;
         break;
     }
+
+    std::call_once(s_tablesOnce, initTables);
+    setEngine(bestEngine());
+}
+
+/* Sets the cached encryption key. */
+
+void AES::setKey(const uint8_t key[])
+{
+    assert(key != nullptr);
+
+    expandKey(key, &m_schedule);
+    ::memset(m_key, 0x00U, MAX_KEY_LEN);
+    ::memcpy(m_key, key, 4 * m_Nk);
+    m_hasKey = true;
+}
+
+/* Clears the cached encryption key. */
+
+void AES::clearKey()
+{
+    ::memset(&m_schedule, 0x00U, sizeof(KeySchedule));
+    ::memset(m_key, 0x00U, MAX_KEY_LEN);
+    m_hasKey = false;
+}
+
+/* Encrypt buffer in place with the cached key in AES-ECB. */
+
+bool AES::encryptECBInPlace(uint8_t* buffer, uint32_t len) const
+{
+    if (!m_hasKey || len % BLOCK_BYTES_LEN != 0) {
+        LogDebugEx(LOG_HOST, "AES::encryptECBInPlace()", "no key set or length not divisible by %u, len = %u", BLOCK_BYTES_LEN, len);
+        return false;
+    }
+
+    m_encryptBlocks(m_schedule.enc, m_Nr, buffer, buffer, len / BLOCK_BYTES_LEN);
+    return true;
+}
+
+/* Decrypt buffer in place with the cached key in AES-ECB. */
+
+bool AES::decryptECBInPlace(uint8_t* buffer, uint32_t len) const
+{
+    if (!m_hasKey || len % BLOCK_BYTES_LEN != 0) {
+        LogDebugEx(LOG_HOST, "AES::decryptECBInPlace()", "no key set or length not divisible by %u, len = %u", BLOCK_BYTES_LEN, len);
+        return false;
+    }
+
+    m_decryptBlocks(m_schedule.dec, m_Nr, buffer, buffer, len / BLOCK_BYTES_LEN);
+    return true;
 }
 
 /* Encrypt input buffer with given key in AES-ECB. */
@@ -270,269 +631,240 @@ uint8_t* AES::encryptECB(const uint8_t in[], uint32_t inLen, const uint8_t key[]
         return nullptr;
     }
 
-    uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
+    KeySchedule local;
+    const KeySchedule* ks = schedule(key, &local);
 
-    keyExpansion(key, roundKeys);
-    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        encryptBlock(in + i, out + i, roundKeys);
-    }
-
-    delete[] roundKeys;
+    uint8_t* out = new uint8_t[inLen];
+    m_encryptBlocks(ks->enc, m_Nr, in, out, inLen / BLOCK_BYTES_LEN);
     return out;
 }
 
 /* Decrypt input buffer with given key in AES-ECB. */
 
-uint8_t* AES::decryptECB(const uint8_t in[], uint32_t inLen, const uint8_t key[]) 
+uint8_t* AES::decryptECB(const uint8_t in[], uint32_t inLen, const uint8_t key[])
 {
     if (inLen % BLOCK_BYTES_LEN != 0) {
         LogDebugEx(LOG_HOST, "AES::decryptECB()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
         return nullptr;
     }
 
-    uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
-
-    keyExpansion(key, roundKeys);
-    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        decryptBlock(in + i, out + i, roundKeys);
-    }
+    KeySchedule local;
+    const KeySchedule* ks = schedule(key, &local);
 
-    delete[] roundKeys;
+    uint8_t* out = new uint8_t[inLen];
+    m_decryptBlocks(ks->dec, m_Nr, in, out, inLen / BLOCK_BYTES_LEN);
     return out;
 }
 
 /* Encrypt input buffer with given key and IV in AES-CBC. */
 
-uint8_t* AES::encryptCBC(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t* iv) 
+uint8_t* AES::encryptCBC(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t* iv)
 {
     if (inLen % BLOCK_BYTES_LEN != 0) {
         LogDebugEx(LOG_HOST, "AES::encryptCBC()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
         return nullptr;
     }
 
+    KeySchedule local;
+    const KeySchedule* ks = schedule(key, &local);
+
     uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
     uint8_t block[BLOCK_BYTES_LEN];
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
-
-    keyExpansion(key, roundKeys);
     ::memcpy(block, iv, BLOCK_BYTES_LEN);
     for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
         xorBlocks(block, in + i, block, BLOCK_BYTES_LEN);
-        encryptBlock(block, out + i, roundKeys);
+        m_encryptBlocks(ks->enc, m_Nr, block, out + i, 1U);
         ::memcpy(block, out + i, BLOCK_BYTES_LEN);
     }
 
-    delete[] roundKeys;
     return out;
 }
 
 /* Decrypt input buffer with given key and IV in AES-CBC. */
 
-uint8_t* AES::decryptCBC(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t *iv) 
+uint8_t* AES::decryptCBC(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t *iv)
 {
     if (inLen % BLOCK_BYTES_LEN != 0) {
         LogDebugEx(LOG_HOST, "AES::decryptCBC()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
         return nullptr;
     }
 
-    uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
-    uint8_t block[BLOCK_BYTES_LEN];
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
+    KeySchedule local;
+    const KeySchedule* ks = schedule(key, &local);
 
-    keyExpansion(key, roundKeys);
-    ::memcpy(block, iv, BLOCK_BYTES_LEN);
-    for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        decryptBlock(in + i, out + i, roundKeys);
-        xorBlocks(block, out + i, out + i, BLOCK_BYTES_LEN);
-        ::memcpy(block, in + i, BLOCK_BYTES_LEN);
+    // CBC decryption is parallel across blocks; decrypt all blocks at once then chain
+    uint8_t* out = new uint8_t[inLen];
+    m_decryptBlocks(ks->dec, m_Nr, in, out, inLen / BLOCK_BYTES_LEN);
+    if (inLen > 0U) {
+        xorBlocks(iv, out, out, BLOCK_BYTES_LEN);
+        xorBlocks(in, out + BLOCK_BYTES_LEN, out + BLOCK_BYTES_LEN, inLen - BLOCK_BYTES_LEN);
     }
 
-    delete[] roundKeys;
     return out;
 }
 
 /* Encrypt input buffer with given key and IV in AES-CFB. */
 
-uint8_t* AES::encryptCFB(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t *iv) 
+uint8_t* AES::encryptCFB(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t *iv)
 {
     if (inLen % BLOCK_BYTES_LEN != 0) {
         LogDebugEx(LOG_HOST, "AES::encryptCFB()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
         return nullptr;
     }
 
+    KeySchedule local;
+    const KeySchedule* ks = schedule(key, &local);
+
     uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
     uint8_t block[BLOCK_BYTES_LEN];
     uint8_t encryptedBlock[BLOCK_BYTES_LEN];
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
-
-    keyExpansion(key, roundKeys);
     ::memcpy(block, iv, BLOCK_BYTES_LEN);
     for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        encryptBlock(block, encryptedBlock, roundKeys);
+        m_encryptBlocks(ks->enc, m_Nr, block, encryptedBlock, 1U);
         xorBlocks(in + i, encryptedBlock, out + i, BLOCK_BYTES_LEN);
         ::memcpy(block, out + i, BLOCK_BYTES_LEN);
     }
 
-    delete[] roundKeys;
     return out;
 }
 
 /* Decrypt input buffer with given key and IV in AES-CFB. */
 
-uint8_t* AES::decryptCFB(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t *iv) 
+uint8_t* AES::decryptCFB(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t *iv)
 {
     if (inLen % BLOCK_BYTES_LEN != 0) {
         LogDebugEx(LOG_HOST, "AES::decryptCFB()", "plaintext length must be divisible by %u, inLen = %u", BLOCK_BYTES_LEN, inLen);
         return nullptr;
     }
 
+    KeySchedule local;
+    const KeySchedule* ks = schedule(key, &local);
+
     uint8_t* out = new uint8_t[inLen];
-    ::memset(out, 0x00U, inLen);
     uint8_t block[BLOCK_BYTES_LEN];
     uint8_t encryptedBlock[BLOCK_BYTES_LEN];
-    uint8_t* roundKeys = new uint8_t[4 * AES_NB * (m_Nr + 1)];
-    ::memset(roundKeys, 0x00U, 4 * AES_NB * (m_Nr + 1));
-
-    keyExpansion(key, roundKeys);
     ::memcpy(block, iv, BLOCK_BYTES_LEN);
     for (uint32_t i = 0; i < inLen; i += BLOCK_BYTES_LEN) {
-        encryptBlock(block, encryptedBlock, roundKeys);
+        m_encryptBlocks(ks->enc, m_Nr, block, encryptedBlock, 1U);
         xorBlocks(in + i, encryptedBlock, out + i, BLOCK_BYTES_LEN);
         ::memcpy(block, in + i, BLOCK_BYTES_LEN);
     }
 
-    delete[] roundKeys;
     return out;
 }
 
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
-/* */
+/* Sets the block cipher engine used by this instance. */
 
-void AES::subBytes(uint8_t state[4][AES_NB]) 
+bool AES::setEngine(AESEngine engine)
 {
-    for (uint32_t i = 0; i < 4; i++) {
-        for (uint32_t j = 0; j < AES_NB; j++) {
-            uint8_t t = state[i][j];
-            state[i][j] = SBOX[t / 16][t % 16];
-        }
+    if (!isEngineSupported(engine))
+        return false;
+
+    switch (engine) {
+#if defined(AES_ENGINE_AES_NI)
+    case AESEngine::AES_NI:
+        m_encryptBlocks = aesniEncrypt;
+        m_decryptBlocks = aesniDecrypt;
+        break;
+#endif // defined(AES_ENGINE_AES_NI)
+#if defined(AES_ENGINE_ARMV8_CE)
+    case AESEngine::ARMV8_CE:
+        m_encryptBlocks = armv8Encrypt;
+        m_decryptBlocks = armv8Decrypt;
+        break;
+#endif // defined(AES_ENGINE_ARMV8_CE)
+    default:
+        m_encryptBlocks = portableEncrypt;
+        m_decryptBlocks = portableDecrypt;
+        break;
     }
-}
 
-/* */
-
-void AES::invSubBytes(uint8_t state[4][AES_NB]) 
-{
-    for (uint32_t i = 0; i < 4; i++) {
-        for (uint32_t j = 0; j < AES_NB; j++) {
-            uint8_t t = state[i][j];
-            state[i][j] = INV_SBOX[t / 16][t % 16];
-        }
-    }
+    m_engine = engine;
+    return true;
 }
 
-/* Shift row i on n positions. */
+/* Gets the fastest block cipher engine supported on this CPU. */
 
-void AES::shiftRow(uint8_t state[4][AES_NB], uint32_t i, uint32_t n)
+AESEngine AES::bestEngine()
 {
-    uint8_t tmp[AES_NB];
-    for (uint32_t j = 0; j < AES_NB; j++) {
-        tmp[j] = state[i][(j + n) % AES_NB];
-    }
-    memcpy(state[i], tmp, AES_NB * sizeof(uint8_t));
+    static const AESEngine best = isEngineSupported(AESEngine::AES_NI) ? AESEngine::AES_NI :
+        (isEngineSupported(AESEngine::ARMV8_CE) ? AESEngine::ARMV8_CE : AESEngine::PORTABLE);
+    return best;
 }
 
-/* */
+/* Helper to determine if the given block cipher engine is supported on this CPU. */
 
-void AES::shiftRows(uint8_t state[4][AES_NB]) 
+bool AES::isEngineSupported(AESEngine engine)
 {
-    shiftRow(state, 1, 1);
-    shiftRow(state, 2, 2);
-    shiftRow(state, 3, 3);
+    static const bool aesni = detectEngine(AESEngine::AES_NI);
+    static const bool armv8 = detectEngine(AESEngine::ARMV8_CE);
+
+    switch (engine) {
+    case AESEngine::PORTABLE:
+        return true;
+    case AESEngine::AES_NI:
+        return aesni;
+    case AESEngine::ARMV8_CE:
+        return armv8;
+    default:
+        return false;
+    }
 }
 
-/* */
+/* Gets the textual name of the given block cipher engine. */
 
-void AES::invShiftRows(uint8_t state[4][AES_NB]) 
+const char* AES::engineName(AESEngine engine)
 {
-    shiftRow(state, 1, AES_NB - 1);
-    shiftRow(state, 2, AES_NB - 2);
-    shiftRow(state, 3, AES_NB - 3);
-}
-
-/* */
-
-void AES::mixColumns(uint8_t state[4][AES_NB]) {
-    uint8_t tempState[4][AES_NB];
-    for (size_t i = 0; i < 4; ++i) {
-        memset(tempState[i], 0, 4);
-    }
-
-    for (size_t i = 0; i < 4; ++i) {
-        for (size_t k = 0; k < 4; ++k) {
-            for (size_t j = 0; j < 4; ++j) {
-            if (CMDS[i][k] == 1)
-                tempState[i][j] ^= state[k][j];
-            else
-                tempState[i][j] ^= GF_MUL_TABLE[CMDS[i][k]][state[k][j]];
-            }
-        }
-    }
-
-    for (size_t i = 0; i < 4; ++i) {
-        memcpy(state[i], tempState[i], 4);
+    switch (engine) {
+    case AESEngine::AES_NI:
+        return "AES-NI";
+    case AESEngine::ARMV8_CE:
+        return "ARMv8 CE";
+    default:
+        return "portable";
     }
 }
 
-/* */
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
 
-void AES::invMixColumns(uint8_t state[4][AES_NB]) {
-    uint8_t tempState[4][AES_NB];
-    for (size_t i = 0; i < 4; ++i) {
-        memset(tempState[i], 0, 4);
-    }
+/* Helper to get the key schedule for the given key. */
 
-    for (size_t i = 0; i < 4; ++i) {
-        for (size_t k = 0; k < 4; ++k) {
-            for (size_t j = 0; j < 4; ++j) {
-                tempState[i][j] ^= GF_MUL_TABLE[INV_CMDS[i][k]][state[k][j]];
-            }
-        }
-    }
+const AES::KeySchedule* AES::schedule(const uint8_t key[], KeySchedule* local) const
+{
+    if (m_hasKey && ::memcmp(m_key, key, 4 * m_Nk) == 0)
+        return &m_schedule;
 
-    for (size_t i = 0; i < 4; ++i) {
-        memcpy(state[i], tempState[i], 4);
-    }
+    expandKey(key, local);
+    return local;
 }
 
-/* */
+/* Helper to expand the given key into the given key schedule. */
 
-void AES::addRoundKey(uint8_t state[4][AES_NB], uint8_t* key) 
+void AES::expandKey(const uint8_t key[], KeySchedule* ks) const
 {
-    for (uint32_t i = 0; i < 4; i++) {
-        for (uint32_t j = 0; j < AES_NB; j++) {
-            state[i][j] = state[i][j] ^ key[i + 4 * j];
+    keyExpansion(key, ks->enc);
+
+    // the equivalent inverse cipher uses the round keys in reverse order, with InvMixColumns
+    // applied to all but the first and last round keys
+    ::memcpy(ks->dec, ks->enc + m_Nr * BLOCK_BYTES_LEN, BLOCK_BYTES_LEN);
+    for (uint32_t round = 1U; round < m_Nr; round++) {
+        const uint8_t* rk = ks->enc + (m_Nr - round) * BLOCK_BYTES_LEN;
+        uint8_t* dk = ks->dec + round * BLOCK_BYTES_LEN;
+        for (uint32_t col = 0U; col < AES_NB; col++) {
+            for (uint32_t i = 0U; i < 4U; i++) {
+                dk[4U * col + i] = GF_MUL_TABLE[INV_CMDS[i][0]][rk[4U * col]] ^ GF_MUL_TABLE[INV_CMDS[i][1]][rk[4U * col + 1U]] ^
+                    GF_MUL_TABLE[INV_CMDS[i][2]][rk[4U * col + 2U]] ^ GF_MUL_TABLE[INV_CMDS[i][3]][rk[4U * col + 3U]];
+            }
         }
     }
+    ::memcpy(ks->dec + m_Nr * BLOCK_BYTES_LEN, ks->enc, BLOCK_BYTES_LEN);
 }
 
 /* */
 
-void AES::subWord(uint8_t* a) 
+void AES::subWord(uint8_t* a) const
 {
     for (uint32_t i = 0; i < 4; i++) {
         a[i] = SBOX[a[i] / 16][a[i] % 16];
@@ -541,7 +873,7 @@ void AES::subWord(uint8_t* a)
 
 /* */
 
-void AES::rotWord(uint8_t* a) 
+void AES::rotWord(uint8_t* a) const
 {
     uint8_t c = a[0];
     a[0] = a[1];
@@ -552,7 +884,7 @@ void AES::rotWord(uint8_t* a)
 
 /* */
 
-void AES::xorWords(uint8_t* a, uint8_t* b, uint8_t* c) 
+void AES::xorWords(uint8_t* a, uint8_t* b, uint8_t* c) const
 {
     for (uint32_t i = 0; i < 4; i++) {
         c[i] = a[i] ^ b[i];
@@ -561,7 +893,7 @@ void AES::xorWords(uint8_t* a, uint8_t* b, uint8_t* c)
 
 /* */
 
-void AES::rCon(uint8_t *a, uint32_t n) 
+void AES::rCon(uint8_t *a, uint32_t n) const
 {
     uint8_t c = 1;
     for (uint32_t i = 0; i < n - 1; i++) {
@@ -574,7 +906,8 @@ void AES::rCon(uint8_t *a, uint32_t n)
 
 /* */
 
-void AES::keyExpansion(const uint8_t key[], uint8_t w[]) {
+void AES::keyExpansion(const uint8_t key[], uint8_t w[]) const
+{
     uint8_t temp[4], rcon[4];
 
     uint32_t i = 0;
@@ -609,69 +942,7 @@ void AES::keyExpansion(const uint8_t key[], uint8_t w[]) {
 
 /* */
 
-void AES::encryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys) 
-{
-    uint8_t state[4][AES_NB];
-    for (uint32_t i = 0; i < 4; i++) {
-        for (uint32_t j = 0; j < AES_NB; j++) {
-            state[i][j] = in[i + 4 * j];
-        }
-    }
-
-    addRoundKey(state, roundKeys);
-
-    for (uint32_t round = 1; round <= m_Nr - 1; round++) {
-        subBytes(state);
-        shiftRows(state);
-        mixColumns(state);
-        addRoundKey(state, roundKeys + round * 4 * AES_NB);
-    }
-
-    subBytes(state);
-    shiftRows(state);
-    addRoundKey(state, roundKeys + m_Nr * 4 * AES_NB);
-
-    for (uint32_t i = 0; i < 4; i++) {
-        for (uint32_t j = 0; j < AES_NB; j++) {
-            out[i + 4 * j] = state[i][j];
-        }
-    }
-}
-
-/* */
-
-void AES::decryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys) 
-{
-    uint8_t state[4][AES_NB];
-    for (uint32_t i = 0; i < 4; i++) {
-        for (uint32_t j = 0; j < AES_NB; j++) {
-            state[i][j] = in[i + 4 * j];
-        }
-    }
-
-    addRoundKey(state, roundKeys + m_Nr * 4 * AES_NB);
-
-    for (uint32_t round = m_Nr - 1; round >= 1; round--) {
-        invSubBytes(state);
-        invShiftRows(state);
-        addRoundKey(state, roundKeys + round * 4 * AES_NB);
-        invMixColumns(state);
-    }
-
-    invSubBytes(state);
-    invShiftRows(state);
-    addRoundKey(state, roundKeys);
-
-    for (uint32_t i = 0; i < 4; i++) {
-        for (uint32_t j = 0; j < AES_NB; j++) {
-            out[i + 4 * j] = state[i][j];
-        }
-    }
-}
-
-/* */
-
-void AES::xorBlocks(const uint8_t *a, const uint8_t *b, uint8_t *c, uint32_t len) 
+void AES::xorBlocks(const uint8_t *a, const uint8_t *b, uint8_t *c, uint32_t len) const
 {
     for (uint32_t i = 0; i < len; i++) {
         c[i] = a[i] ^ b[i];
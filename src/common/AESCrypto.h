@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2019 SergeyBel
- *  Copyright (C) 2023 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2023,2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -30,6 +30,7 @@ namespace crypto
     // ---------------------------------------------------------------------------
 
     const uint8_t AES_NB = 4;
+    const uint8_t AES_MAX_NR = 14;
 
     /**
      * @brief Enumeration of AES key lengths.
@@ -37,12 +38,26 @@ namespace crypto
      */
     enum class AESKeyLength { AES_128, AES_192, AES_256 };
 
+    /**
+     * @brief Enumeration of AES block cipher engines.
+     * @ingroup crypto
+     */
+    enum class AESEngine {
+        PORTABLE,                                       //! Portable (T-table) Implementation
+        AES_NI,                                         //! x86 AES-NI Instructions
+        ARMV8_CE                                        //! ARMv8 Cryptography Extensions
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
 
     /**
      * @brief Advanced Encryption Standard Algorithm.
+     *  The block cipher is dispatched at runtime to the fastest engine the CPU supports (AES-NI on x86,
+     *  the cryptography extensions on ARMv8, or a portable table-driven implementation). A key set
+     *  with setKey() is expanded once, and may then be used by the in-place routines without any
+     *  allocation or re-expansion.
      * @ingroup crypto
      */
     class HOST_SW_API AES {
@@ -53,6 +68,38 @@ namespace crypto
          */
         explicit AES(const AESKeyLength keyLength = AESKeyLength::AES_256);
 
+        /**
+         * @brief Sets the cached encryption key.
+         *  The key schedule is expanded once here; the in-place routines use the cached key schedule,
+         *  as do the buffer routines when they are called with the same key.
+         * @param key Encryption key.
+         */
+        void setKey(const uint8_t key[]);
+        /**
+         * @brief Clears the cached encryption key.
+         */
+        void clearKey();
+        /**
+         * @brief Helper to determine if an encryption key is cached.
+         * @returns bool True, if an encryption key is cached, otherwise false.
+         */
+        bool hasKey() const { return m_hasKey; }
+
+        /**
+         * @brief Encrypt buffer in place with the cached key in AES-ECB.
+         * @param buffer Buffer.
+         * @param len Buffer length (must be a multiple of the block length).
+         * @returns bool True, if the buffer was encrypted, otherwise false.
+         */
+        bool encryptECBInPlace(uint8_t* buffer, uint32_t len) const;
+        /**
+         * @brief Decrypt buffer in place with the cached key in AES-ECB.
+         * @param buffer Buffer.
+         * @param len Buffer length (must be a multiple of the block length).
+         * @returns bool True, if the buffer was decrypted, otherwise false.
+         */
+        bool decryptECBInPlace(uint8_t* buffer, uint32_t len) const;
+
         /**
          * @brief Encrypt input buffer with given key in AES-ECB.
          * @param in Input buffer.
@@ -108,36 +155,91 @@ namespace crypto
          */
         uint8_t* decryptCFB(const uint8_t in[], uint32_t inLen, const uint8_t key[], const uint8_t* iv);
 
+        /**
+         * @brief Gets the block cipher engine used by this instance.
+         * @returns AESEngine Block cipher engine.
+         */
+        AESEngine engine() const { return m_engine; }
+        /**
+         * @brief Sets the block cipher engine used by this instance.
+         * @param engine Block cipher engine.
+         * @returns bool True, if the engine was set, false if the engine is not supported on this CPU.
+         */
+        bool setEngine(AESEngine engine);
+
+        /**
+         * @brief Gets the fastest block cipher engine supported on this CPU.
+         * @returns AESEngine Block cipher engine.
+         */
+        static AESEngine bestEngine();
+        /**
+         * @brief Helper to determine if the given block cipher engine is supported on this CPU.
+         * @param engine Block cipher engine.
+         * @returns bool True, if the engine is supported, otherwise false.
+         */
+        static bool isEngineSupported(AESEngine engine);
+        /**
+         * @brief Gets the textual name of the given block cipher engine.
+         * @param engine Block cipher engine.
+         * @returns const char* Name of the block cipher engine.
+         */
+        static const char* engineName(AESEngine engine);
+
         static constexpr uint32_t BLOCK_BYTES_LEN = 4 * AES_NB * sizeof(uint8_t);
+        static constexpr uint32_t MAX_KEY_LEN = 32U;
+
+        /**
+         * @brief Block cipher routine; processes the given number of consecutive blocks with the
+         *  given round keys. (The input and output buffers may be the same buffer.)
+         */
+        typedef void (*BlockFunc)(const uint8_t* roundKeys, uint32_t nr, const uint8_t* in, uint8_t* out, uint32_t blocks);
 
     private:
         uint32_t m_Nk;
         uint32_t m_Nr;
 
-        void subBytes(uint8_t state[4][AES_NB]);
-        void invSubBytes(uint8_t state[4][AES_NB]);
-        void shiftRow(uint8_t state[4][AES_NB], uint32_t i, uint32_t n);  // shift row i on n positions
-        void shiftRows(uint8_t state[4][AES_NB]);
-        void invShiftRows(uint8_t state[4][AES_NB]);
-    
-        uint8_t xtime(uint8_t b) { return (b << 1) ^ (((b >> 7) & 1) * 0x1BU); }
+        AESEngine m_engine;
+        BlockFunc m_encryptBlocks;
+        BlockFunc m_decryptBlocks;
 
-        void mixColumns(uint8_t state[4][AES_NB]);
-        void invMixColumns(uint8_t state[4][AES_NB]);
-        void addRoundKey(uint8_t state[4][AES_NB], uint8_t* key);
+        /**
+         * @brief Represents an expanded AES key schedule.
+         *  The decryption round keys are in the order used by the equivalent inverse cipher.
+         */
+        struct KeySchedule {
+            uint8_t enc[BLOCK_BYTES_LEN * (AES_MAX_NR + 1)];
+            uint8_t dec[BLOCK_BYTES_LEN * (AES_MAX_NR + 1)];
+        };
 
-        void subWord(uint8_t* a);
-        void rotWord(uint8_t* a);
-        void xorWords(uint8_t* a, uint8_t* b, uint8_t* c);
+        KeySchedule m_schedule;
+        uint8_t m_key[MAX_KEY_LEN];
+        bool m_hasKey;
+
+        /**
+         * @brief Helper to get the key schedule for the given key; the cached key schedule is returned if the
+         *  given key is the cached key, otherwise the key is expanded into the given key schedule.
+         * @param key Encryption key.
+         * @param local Key schedule to expand an uncached key into.
+         * @returns KeySchedule* Key schedule for the given key.
+         */
+        const KeySchedule* schedule(const uint8_t key[], KeySchedule* local) const;
+        /**
+         * @brief Helper to expand the given key into the given key schedule.
+         * @param key Encryption key.
+         * @param ks Key schedule.
+         */
+        void expandKey(const uint8_t key[], KeySchedule* ks) const;
 
-        void rCon(uint8_t* a, uint32_t n);
+        void subWord(uint8_t* a) const;
+        void rotWord(uint8_t* a) const;
+        void xorWords(uint8_t* a, uint8_t* b, uint8_t* c) const;
 
-        void keyExpansion(const uint8_t key[], uint8_t w[]);
+        uint8_t xtime(uint8_t b) const { return (b << 1) ^ (((b >> 7) & 1) * 0x1BU); }
+        void rCon(uint8_t* a, uint32_t n) const;
 
-        void encryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys);
-        void decryptBlock(const uint8_t in[], uint8_t out[], uint8_t* roundKeys);
+        void keyExpansion(const uint8_t key[], uint8_t w[]) const;
 
-        void xorBlocks(const uint8_t* a, const uint8_t* b, uint8_t* c, uint32_t len);
+        void xorBlocks(const uint8_t* a, const uint8_t* b, uint8_t* c, uint32_t len) const;
     };
 } // namespace crypto
 
@@ -16,6 +16,7 @@
 #else
 #include <sys/time.h>
 #include <syslog.h>
+#include <pthread.h>
 #endif // defined(_WIN32)
 
 #if defined(CATCH2_TEST_COMPILATION)
@@ -28,7 +29,12 @@
 #include <ctime>
 #include <cassert>
 #include <cstring>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -38,6 +44,48 @@
 
 const uint32_t LOG_BUFFER_LEN = 4096U;
 
+const uint32_t LOG_QUEUE_DEPTH = 1024U;                 // must be a power of 2
+const uint32_t LOG_RECORD_MODULE_LEN = 24U;
+const uint32_t LOG_RECORD_FUNC_LEN = 96U;
+const uint32_t LOG_RECORD_MESSAGE_LEN = 512U;           // longer entries are written directly, not queued
+const uint32_t LOG_WRITER_IDLE_MS = 100U;
+
+const uint32_t LOG_RATE_LIMIT_SLOTS = 256U;             // must be a power of 2
+const uint32_t LOG_RATE_LIMIT_BURST = 10U;              // entries per call site, per window
+const uint32_t LOG_RATE_LIMIT_WINDOW_MS = 1000U;
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a single queued log entry.
+ *  The message is formatted by the caller; the entry prefix is formatted by the writer, with the
+ *  time stamp state captured when the entry was logged.
+ */
+struct LogRecord {
+    std::atomic<uint64_t> seq;
+    uint32_t level;
+    const char* file;
+    int lineNo;
+    struct timeval time;
+    bool disableTime;
+    uint32_t suppressed;
+    char module[LOG_RECORD_MODULE_LEN];
+    char func[LOG_RECORD_FUNC_LEN];
+    char message[LOG_RECORD_MESSAGE_LEN];
+};
+
+/**
+ * @brief Represents the rate limiting state for a single log call site.
+ */
+struct LogRateSlot {
+    std::atomic<const char*> site;
+    std::atomic<uint64_t> windowStart;
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> suppressed;
+};
+
 // ---------------------------------------------------------------------------
 //  Global Variables
 // ---------------------------------------------------------------------------
@@ -61,6 +109,30 @@ static std::ostream m_outStream { std::cerr.rdbuf() };
 
 static char LEVELS[] = " DMIWEF";
 
+static LogRecord* m_ring = nullptr;     // allocated when the writer is first started
+static bool m_ringInitialised = false;
+static std::atomic<uint64_t> m_enqueuePos { 0U };
+static uint64_t m_dequeuePos = 0U;
+
+static std::atomic<bool> m_async { false };
+static std::thread* m_writer = nullptr;
+static bool m_writerRunning = false;
+static std::atomic<bool> m_writerSleeping { false };
+static bool m_writerForked = false;
+static std::mutex m_writerLock;         // serializes starting and stopping the writer
+static std::mutex m_drainLock;          // serializes the consumers of the queue, and the log outputs
+static std::mutex m_wakeLock;
+static std::condition_variable m_wakeCond;
+
+static LogRateSlot m_rateSlots[LOG_RATE_LIMIT_SLOTS];
+
+static std::atomic<uint64_t> m_written { 0U };
+static std::atomic<uint64_t> m_dropped { 0U };
+static std::atomic<uint64_t> m_suppressed { 0U };
+static uint64_t m_droppedReported = 0U;
+
+static thread_local bool t_inNetworkWrite = false;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -139,84 +211,20 @@ static bool LogOpen()
     }
 }
 
-/* Internal helper to set an output stream to direct logging to. */
-
-void __InternalOutputStream(std::ostream& stream)
-{
-    m_outStream.rdbuf(stream.rdbuf());
-}
-
-/* Gets the instance of the Network class to transfer the activity log with. */
-
-void* LogGetNetwork()
-{
-    // NO GOOD, VERY BAD, TERRIBLE HACK
-    return (void*)m_network;
-}
-
-/* Sets the instance of the Network class to transfer the activity log with. */
-
-void LogSetNetwork(void* network)
-{
-#if defined(CATCH2_TEST_COMPILATION)
-    return;
-#endif
-    // note: The Network class is passed here as a void so we can avoid including the Network.h
-    // header in Log.h. This is dirty and probably terrible...
-    m_network = (network::BaseNetwork*)network;
-}
-
-/* Initializes the diagnostics log. */
-
-bool LogInitialise(const std::string& filePath, const std::string& fileRoot, uint32_t fileLevel, uint32_t displayLevel, bool disableTimeDisplay, bool useSyslog)
-{
-    m_filePath = filePath;
-    m_fileRoot = fileRoot;
-    m_fileLevel = fileLevel;
-    g_logDisplayLevel = displayLevel;
-    g_disableTimeDisplay = disableTimeDisplay;
-#if defined(_WIN32)
-    g_useSyslog = false;
-#else
-    if (!g_useSyslog)
-        g_useSyslog = useSyslog;
-#endif // defined(_WIN32)
-    return ::LogOpen();
-}
-
-/* Finalizes the diagnostics log. */
-
-void LogFinalise()
-{
-#if defined(CATCH2_TEST_COMPILATION)
-    return;
-#endif
-    if (m_fpLog != nullptr) {
-        ::fclose(m_fpLog);
-        m_fpLog = nullptr;
-    }
-#if !defined(_WIN32)
-    if (g_useSyslog)
-        closelog();
-#endif // !defined(_WIN32)
-}
-
-/* Writes a new entry to the diagnostics log. */
+/* Helper to format the prefix (level, time stamp, module and source location) of a log entry. */
 
-void Log(uint32_t level, const char *module, const char* file, const int lineNo, const char* func, const char* fmt, ...)
+static void LogFormatPrefix(char* buffer, const LogRecord& rec)
 {
-    assert(fmt != nullptr);
-#if defined(CATCH2_TEST_COMPILATION)
-    g_disableTimeDisplay = true;
-#endif
-    char buffer[LOG_BUFFER_LEN];
-    if (!g_disableTimeDisplay && !g_useSyslog) {
-        time_t now;
-        ::time(&now);
+    uint32_t level = rec.level;
+    const char* module = (rec.module[0U] != '\0') ? rec.module : nullptr;
+    const char* file = rec.file;
+    int lineNo = rec.lineNo;
+    const char* func = (rec.func[0U] != '\0') ? rec.func : nullptr;
+
+    if (!rec.disableTime && !g_useSyslog) {
+        time_t now = rec.time.tv_sec;
         struct tm* tm = ::localtime(&now);
-
-        struct timeval nowMillis;
-        ::gettimeofday(&nowMillis, NULL);
+        unsigned long millis = (unsigned long)rec.time.tv_usec / 1000U;
 
         if (module != nullptr) {
             // level 1 is DEBUG
@@ -225,16 +233,16 @@ void Log(uint32_t level, const char *module, const char* file, const int lineNo,
                 if (file != nullptr && lineNo > 0) {
                     // if we have a function name add that to the log entry
                     if (func != nullptr) {
-                        ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s)[%s:%u][%s] ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, nowMillis.tv_usec / 1000U, module, file, lineNo, func);
+                        ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s)[%s:%u][%s] ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, millis, module, file, lineNo, func);
                     }
                     else {
-                        ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s)[%s:%u] ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, nowMillis.tv_usec / 1000U, module, file, lineNo);
+                        ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s)[%s:%u] ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, millis, module, file, lineNo);
                     }
                 } else {
-                    ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s) ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, nowMillis.tv_usec / 1000U, module);
+                    ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s) ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, millis, module);
                 }
             } else {
-                ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s) ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, nowMillis.tv_usec / 1000U, module);
+                ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu (%s) ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, millis, module);
             }
         }
         else {
@@ -244,16 +252,16 @@ void Log(uint32_t level, const char *module, const char* file, const int lineNo,
                 if (file != nullptr && lineNo > 0) {
                     // if we have a function name add that to the log entry
                     if (func != nullptr) {
-                        ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu [%s:%u][%s] ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, nowMillis.tv_usec / 1000U, file, lineNo, func);
+                        ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu [%s:%u][%s] ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, millis, file, lineNo, func);
                     }
                     else {
-                        ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu [%s:%u] ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, nowMillis.tv_usec / 1000U, file, lineNo);
+                        ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu [%s:%u] ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, millis, file, lineNo);
                     }
                 } else {
-                    ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, nowMillis.tv_usec / 1000U);
+                    ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, millis);
                 }
             } else {
-                ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, nowMillis.tv_usec / 1000U);
+                ::sprintf(buffer, "%c: %04d-%02d-%02d %02d:%02d:%02d.%03lu ", LEVELS[level], tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday, tm->tm_hour, tm->tm_min, tm->tm_sec, millis);
             }
         }
     }
@@ -299,25 +307,40 @@ void Log(uint32_t level, const char *module, const char* file, const int lineNo,
             }
         }
     }
+}
 
-    va_list vl, vl_len;
-    va_start(vl, fmt);
-    va_copy(vl_len, vl);
+/* Helper to format and write a log entry to the log outputs. (The caller must hold the drain lock.) */
+
+static void LogWrite(const LogRecord& rec, const char* message)
+{
+    uint32_t level = rec.level;
+
+    char buffer[LOG_BUFFER_LEN];
+    LogFormatPrefix(buffer, rec);
 
-    size_t len = ::vsnprintf(nullptr, 0U, fmt, vl_len);
-    ::vsnprintf(buffer + ::strlen(buffer), len + 1U, fmt, vl);
+    // an entry longer than the buffer is truncated
+    size_t len = ::strlen(buffer);
+    int ret = 0;
+    if (rec.suppressed > 0U)
+        ret = ::snprintf(buffer + len, LOG_BUFFER_LEN - len, "%s (%u similar entries suppressed)", message, rec.suppressed);
+    else
+        ret = ::snprintf(buffer + len, LOG_BUFFER_LEN - len, "%s", message);
+    if (ret < 0)
+        buffer[len] = '\0';
 
-    va_end(vl_len);
-    va_end(vl);
+    m_written.fetch_add(1U, std::memory_order_relaxed);
 
     if (m_outStream && g_logDisplayLevel == 0U) {
-        m_outStream << buffer << std::endl;
+        m_outStream << buffer << '\n';
     }
 
-    if (m_network != nullptr) {
+    // entries logged by the network while transferring an entry are not transferred themselves
+    if (m_network != nullptr && !t_inNetworkWrite) {
         // don't transfer debug data...
         if (level > 1U) {
+            t_inNetworkWrite = true;
             m_network->writeDiagLog(buffer);
+            t_inNetworkWrite = false;
         }
     }
 
@@ -334,7 +357,6 @@ void Log(uint32_t level, const char *module, const char* file, const int lineNo,
 
             if (m_fpLog != nullptr) {
                 ::fprintf(m_fpLog, "%s\n", buffer);
-                ::fflush(m_fpLog);
             }
         } else {
 #if !defined(_WIN32)
@@ -369,17 +391,426 @@ void Log(uint32_t level, const char *module, const char* file, const int lineNo,
 
     if (!g_useSyslog && level >= g_logDisplayLevel && g_logDisplayLevel != 0U) {
         ::fprintf(stdout, "%s" EOL, buffer);
-        ::fflush(stdout);
     }
+}
+
+/* Helper to flush the buffered log outputs. (The caller must hold the drain lock.) */
+
+static void LogFlushOutputs()
+{
+    if (g_logDisplayLevel == 0U)
+        m_outStream.flush();
+    if (m_fpLog != nullptr)
+        ::fflush(m_fpLog);
+    ::fflush(stdout);
+}
+
+/* Helper to fill the fixed fields of a log entry. */
+
+static void LogFillRecord(LogRecord& rec, uint32_t level, const char* module, const char* file, int lineNo, const char* func,
+    const struct timeval& time, uint32_t suppressed)
+{
+    rec.level = level;
+    rec.file = file;
+    rec.lineNo = lineNo;
+    rec.time = time;
+    rec.disableTime = g_disableTimeDisplay;     // callers may toggle this around a single entry
+    rec.suppressed = suppressed;
+
+    rec.module[0U] = '\0';
+    if (module != nullptr) {
+        ::strncpy(rec.module, module, LOG_RECORD_MODULE_LEN - 1U);
+        rec.module[LOG_RECORD_MODULE_LEN - 1U] = '\0';
+    }
+
+    rec.func[0U] = '\0';
+    if (func != nullptr) {
+        ::strncpy(rec.func, func, LOG_RECORD_FUNC_LEN - 1U);
+        rec.func[LOG_RECORD_FUNC_LEN - 1U] = '\0';
+    }
+}
+
+/* Helper to write all queued log entries to the log outputs. (The caller must hold the drain lock.) */
+
+static bool LogDrain()
+{
+    bool wrote = false;
+    while (true) {
+        LogRecord& rec = m_ring[m_dequeuePos & (LOG_QUEUE_DEPTH - 1U)];
+        if ((int64_t)rec.seq.load(std::memory_order_acquire) - (int64_t)(m_dequeuePos + 1U) < 0)
+            break;
+
+        LogWrite(rec, rec.message);
+
+        // release the slot to the producer one lap ahead
+        rec.seq.store(m_dequeuePos + LOG_QUEUE_DEPTH, std::memory_order_release);
+        m_dequeuePos++;
+        wrote = true;
+    }
+
+    // report any entries lost to a full queue, once the queue has room again
+    uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+    if (dropped != m_droppedReported) {
+        LogRecord rec;
+        struct timeval now;
+        ::gettimeofday(&now, NULL);
+        LogFillRecord(rec, 4U, "LOG", nullptr, 0, nullptr, now, 0U);
+        ::snprintf(rec.message, LOG_RECORD_MESSAGE_LEN, "log queue full, %llu entries dropped", (unsigned long long)(dropped - m_droppedReported));
+        LogWrite(rec, rec.message);
+
+        m_droppedReported = dropped;
+        wrote = true;
+    }
+
+    if (wrote)
+        LogFlushOutputs();
+    return wrote;
+}
+
+/* Helper to determine whether any log entries are queued. */
+
+static bool LogPending()
+{
+    const LogRecord& rec = m_ring[m_dequeuePos & (LOG_QUEUE_DEPTH - 1U)];
+    return (int64_t)rec.seq.load(std::memory_order_acquire) - (int64_t)(m_dequeuePos + 1U) >= 0;
+}
+
+/* Entry point for the log writer thread. */
+
+static void LogWriterEntry()
+{
+    while (true) {
+        bool running = true;
+        {
+            std::lock_guard<std::mutex> lock(m_drainLock);
+            LogDrain();
+            running = m_writerRunning;
+        }
+
+        if (!running)
+            break;
+
+        // a producer only takes the wake lock to wake the writer when the writer is (about to be) asleep
+        std::unique_lock<std::mutex> lock(m_wakeLock);
+        m_writerSleeping.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!LogPending() && m_writerRunning)
+            m_wakeCond.wait_for(lock, std::chrono::milliseconds(LOG_WRITER_IDLE_MS));
+        m_writerSleeping.store(false, std::memory_order_relaxed);
+    }
+}
+
+/* Helper to stop the log writer thread, and write any queued log entries. */
+
+static void LogStopWriter()
+{
+    std::lock_guard<std::mutex> writerLock(m_writerLock);
+    if (m_writer == nullptr)
+        return;
+
+    // new entries are written directly from here on
+    m_async.store(false, std::memory_order_seq_cst);
+    {
+        std::lock_guard<std::mutex> lock(m_wakeLock);
+        m_writerRunning = false;
+    }
+
+    m_wakeCond.notify_all();
+    m_writer->join();
+    delete m_writer;
+    m_writer = nullptr;
+
+    std::lock_guard<std::mutex> lock(m_drainLock);
+    LogDrain();
+}
 
-    // fatal error (specially allow any log levels above 9999)
-    if (level >= 6U && level < 9999U) {
-        if (m_fpLog != nullptr)
-            ::fclose(m_fpLog);
 #if !defined(_WIN32)
-        if (g_useSyslog)
-            ::closelog();
+static void LogForkPrepare();
+static void LogForkResume();
+#endif // !defined(_WIN32)
+
+/* Helper to start the log writer thread. */
+
+static void LogStartWriter()
+{
+    std::lock_guard<std::mutex> writerLock(m_writerLock);
+    if (m_writer != nullptr)
+        return;
+
+    if (!m_ringInitialised) {
+        // the ring is allocated here rather than statically, so applications that never start the
+        // writer don't carry it
+        m_ring = new LogRecord[LOG_QUEUE_DEPTH];
+        for (uint64_t i = 0U; i < LOG_QUEUE_DEPTH; i++)
+            m_ring[i].seq.store(i, std::memory_order_relaxed);
+        m_ringInitialised = true;
+
+        // queued entries must be written when the process exits without finalizing the log
+        ::atexit(LogStopWriter);
+#if !defined(_WIN32)
+        // the writer doesn't survive a fork (i.e. when daemonizing), stop it beforehand and restart it in
+        // both processes afterwards
+        ::pthread_atfork(LogForkPrepare, LogForkResume, LogForkResume);
 #endif // !defined(_WIN32)
-        exit(1);
     }
+
+    m_writerRunning = true;
+    m_writer = new std::thread(LogWriterEntry);
+    m_async.store(true, std::memory_order_release);
+}
+
+#if !defined(_WIN32)
+/* Helper to stop the log writer thread before the process forks. */
+
+static void LogForkPrepare()
+{
+    {
+        std::lock_guard<std::mutex> writerLock(m_writerLock);
+        m_writerForked = (m_writer != nullptr);
+    }
+
+    LogStopWriter();
+}
+
+/* Helper to restart the log writer thread after the process forks. */
+
+static void LogForkResume()
+{
+    if (m_writerForked)
+        LogStartWriter();
+}
+#endif // !defined(_WIN32)
+
+/* Helper to apply per call site rate limiting to a log entry. */
+
+static bool LogRateLimit(const char* site, uint64_t nowMs, uint32_t& suppressed)
+{
+    // call sites are identified by their format string
+    uintptr_t hash = (uintptr_t)site * (uintptr_t)0x9E3779B97F4A7C15ULL;
+    LogRateSlot& slot = m_rateSlots[(hash >> 16) & (LOG_RATE_LIMIT_SLOTS - 1U)];
+
+    // a new (or colliding) call site takes the slot over
+    if (slot.site.load(std::memory_order_relaxed) != site) {
+        slot.site.store(site, std::memory_order_relaxed);
+        slot.windowStart.store(nowMs, std::memory_order_relaxed);
+        slot.count.store(0U, std::memory_order_relaxed);
+        slot.suppressed.store(0U, std::memory_order_relaxed);
+    }
+
+    uint64_t windowStart = slot.windowStart.load(std::memory_order_relaxed);
+    if (nowMs - windowStart >= LOG_RATE_LIMIT_WINDOW_MS) {
+        if (slot.windowStart.compare_exchange_strong(windowStart, nowMs, std::memory_order_relaxed))
+            slot.count.store(0U, std::memory_order_relaxed);
+    }
+
+    if (slot.count.fetch_add(1U, std::memory_order_relaxed) >= LOG_RATE_LIMIT_BURST) {
+        slot.suppressed.fetch_add(1U, std::memory_order_relaxed);
+        m_suppressed.fetch_add(1U, std::memory_order_relaxed);
+        return false;
+    }
+
+    suppressed = slot.suppressed.exchange(0U, std::memory_order_relaxed);
+    return true;
+}
+
+/* Internal helper to set an output stream to direct logging to. */
+
+void __InternalOutputStream(std::ostream& stream)
+{
+    // the output stream is owned by the caller's thread, so entries must be written from the
+    // thread that logs them
+    LogStopWriter();
+
+    std::lock_guard<std::mutex> lock(m_drainLock);
+    m_outStream.rdbuf(stream.rdbuf());
+}
+
+/* Gets the instance of the Network class to transfer the activity log with. */
+
+void* LogGetNetwork()
+{
+    // NO GOOD, VERY BAD, TERRIBLE HACK
+    return (void*)m_network;
+}
+
+/* Sets the instance of the Network class to transfer the activity log with. */
+
+void LogSetNetwork(void* network)
+{
+#if defined(CATCH2_TEST_COMPILATION)
+    return;
+#endif
+    // entries queued for the previous network are transferred before it is replaced
+    std::lock_guard<std::mutex> lock(m_drainLock);
+    LogDrain();
+
+    // note: The Network class is passed here as a void so we can avoid including the Network.h
+    // header in Log.h. This is dirty and probably terrible...
+    m_network = (network::BaseNetwork*)network;
+}
+
+/* Initializes the diagnostics log. */
+
+bool LogInitialise(const std::string& filePath, const std::string& fileRoot, uint32_t fileLevel, uint32_t displayLevel, bool disableTimeDisplay, bool useSyslog)
+{
+    bool ret = false;
+    {
+        std::lock_guard<std::mutex> lock(m_drainLock);
+        m_filePath = filePath;
+        m_fileRoot = fileRoot;
+        m_fileLevel = fileLevel;
+        g_logDisplayLevel = displayLevel;
+        g_disableTimeDisplay = disableTimeDisplay;
+#if defined(_WIN32)
+        g_useSyslog = false;
+#else
+        if (!g_useSyslog)
+            g_useSyslog = useSyslog;
+#endif // defined(_WIN32)
+        ret = ::LogOpen();
+    }
+
+    if (ret)
+        LogStartWriter();
+    return ret;
+}
+
+/* Finalizes the diagnostics log. */
+
+void LogFinalise()
+{
+    LogStopWriter();
+
+    std::lock_guard<std::mutex> lock(m_drainLock);
+    if (m_fpLog != nullptr) {
+        ::fclose(m_fpLog);
+        m_fpLog = nullptr;
+    }
+#if !defined(_WIN32)
+    if (g_useSyslog)
+        closelog();
+#endif // !defined(_WIN32)
+}
+
+/* Helper to get the log entry counters. */
+
+void LogGetCounters(uint64_t& written, uint64_t& dropped, uint64_t& suppressed)
+{
+    written = m_written.load();
+    dropped = m_dropped.load();
+    suppressed = m_suppressed.load();
+}
+
+/* Writes a new entry to the diagnostics log. */
+
+void Log(uint32_t level, const char *module, const char* file, const int lineNo, const char* func, const char* fmt, ...)
+{
+    assert(fmt != nullptr);
+#if defined(CATCH2_TEST_COMPILATION)
+    g_disableTimeDisplay = true;
+#endif
+    struct timeval now;
+    ::gettimeofday(&now, NULL);
+
+    // warnings and errors are rate limited per call site, so a burst of identical entries (i.e. during
+    // a call collision) doesn't flood the log outputs
+    uint32_t suppressed = 0U;
+    if (level == 4U || level == 5U) {
+        uint64_t nowMs = (uint64_t)now.tv_sec * 1000U + (uint64_t)now.tv_usec / 1000U;
+        if (!LogRateLimit(fmt, nowMs, suppressed))
+            return;
+    }
+
+    bool fatal = (level >= 6U && level < 9999U);
+
+    char message[LOG_BUFFER_LEN];
+
+    va_list vl;
+    va_start(vl, fmt);
+    int len = ::vsnprintf(message, LOG_BUFFER_LEN, fmt, vl);
+    va_end(vl);
+
+    if (len < 0) {
+        message[0U] = '\0';
+        len = 0;
+    }
+    else if (len >= (int)LOG_BUFFER_LEN) {
+        ::memcpy(message + LOG_BUFFER_LEN - 4U, "...", 4U);
+        len = LOG_BUFFER_LEN - 1U;
+    }
+
+    // claim a queue slot; a slot is free when its sequence matches the position claiming it, and the
+    // queue is full when the slot still holds an entry from the previous lap
+    LogRecord* rec = nullptr;
+    uint64_t pos = 0U;
+    if (!fatal && !t_inNetworkWrite && len < (int)LOG_RECORD_MESSAGE_LEN && m_async.load(std::memory_order_acquire)) {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+        while (true) {
+            LogRecord* slot = &m_ring[pos & (LOG_QUEUE_DEPTH - 1U)];
+            int64_t diff = (int64_t)slot->seq.load(std::memory_order_acquire) - (int64_t)pos;
+            if (diff == 0) {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+                    rec = slot;
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                m_dropped.fetch_add(1U, std::memory_order_relaxed);
+                return;
+            }
+            else {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    LogRecord local;
+    LogRecord& entry = (rec != nullptr) ? *rec : local;
+    LogFillRecord(entry, level, module, file, lineNo, func, now, suppressed);
+
+    if (rec != nullptr) {
+        ::memcpy(rec->message, message, len + 1U);
+        rec->seq.store(pos + 1U, std::memory_order_release);
+
+        // wake the writer if it is asleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_writerSleeping.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(m_wakeLock);
+            m_wakeCond.notify_one();
+        }
+        return;
+    }
+
+    // entries logged by the network while transferring an entry are written directly, the drain
+    // lock is already held by this thread
+    if (t_inNetworkWrite) {
+        LogWrite(entry, message);
+        return;
+    }
+
+    // the writer isn't running (or this is a fatal or oversized entry); write directly, after anything
+    // still queued
+    {
+        std::lock_guard<std::mutex> lock(m_drainLock);
+        if (m_ringInitialised)
+            LogDrain();
+
+        LogWrite(entry, message);
+        LogFlushOutputs();
+
+        // fatal error (specially allow any log levels above 9999)
+        if (fatal) {
+            if (m_fpLog != nullptr) {
+                ::fclose(m_fpLog);
+                m_fpLog = nullptr;
+            }
+#if !defined(_WIN32)
+            if (g_useSyslog)
+                ::closelog();
+#endif // !defined(_WIN32)
+        }
+    }
+
+    if (fatal)
+        exit(1);
 }
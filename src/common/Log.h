@@ -190,8 +190,16 @@ extern HOST_SW_API void LogSetNetwork(void* network);
 extern HOST_SW_API bool LogInitialise(const std::string& filePath, const std::string& fileRoot, uint32_t fileLevel, uint32_t displayLevel, bool disableTimeDisplay = false, bool useSyslog = false);
 /**
  * @brief Finalizes the diagnostics log.
+ *  Any log entries still queued are written before the log is closed.
  */
 extern HOST_SW_API void LogFinalise();
+/**
+ * @brief Helper to get the log entry counters.
+ * @param[out] written Number of log entries written.
+ * @param[out] dropped Number of log entries dropped because the log queue was full.
+ * @param[out] suppressed Number of log entries suppressed by per call site rate limiting.
+ */
+extern HOST_SW_API void LogGetCounters(uint64_t& written, uint64_t& dropped, uint64_t& suppressed);
 /**
  * @brief Writes a new entry to the diagnostics log.
  * @param level Log level for entry.
@@ -65,15 +65,15 @@ bool AccessControl::validateTGId(uint32_t slotNo, uint32_t id)
     }
 
     // lookup TID and perform test for validity
-    TalkgroupRuleGroupVoice tid = m_tidLookup->find(id);
-    if (tid.isInvalid())
+    TalkgroupRuleGroupVoiceHandle tid = m_tidLookup->find(id);
+    if (tid->isInvalid())
         return false;
 
-    if (!tid.config().active())
+    if (!tid->config().active())
         return false;
 
     if (slotNo != 0) {
-        if (tid.source().tgSlot() != slotNo)
+        if (tid->source().tgSlot() != slotNo)
             return false;
 
         return true;
@@ -96,8 +96,8 @@ bool AccessControl::tgidNonPreferred(uint32_t slotNo, uint32_t id)
     }
 
     // lookup TID and perform test for validity
-    TalkgroupRuleGroupVoice tid = m_tidLookup->find(id);
-    if (tid.config().nonPreferred())
+    TalkgroupRuleGroupVoiceHandle tid = m_tidLookup->find(id);
+    if (tid->config().nonPreferred())
         return true;
 
     return false;
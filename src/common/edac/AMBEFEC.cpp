@@ -6,7 +6,7 @@
  *
  *  Copyright (C) 2010,2014,2016,2021 Jonathan Naylor, G4KLX
  *  Copyright (C) 2016 Mathias Weyland, HB9FRV
- *  Copyright (C) 2018-2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2018-2022,2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
@@ -20,203 +20,218 @@ using namespace edac;
 
 #include <cstdio>
 #include <cassert>
+#include <cstring>
 
 // ---------------------------------------------------------------------------
-//  Public Class Members
+//  Constants
 // ---------------------------------------------------------------------------
 
-/* Initializes a new instance of the AMBEFEC class. */
-
-AMBEFEC::AMBEFEC() = default;
-
-/* Finalizes a instance of the AMBEFEC class. */
+/**
+ * @brief Byte level interleave tables, generated at compile time.
+ *  The 72 bits of an AMBE frame are read in four phases (every 4th bit); each byte carries two
+ *  bits of each phase. For IMBE, the 144 bits of a frame are 24 chunks of 6 bits and bit k of
+ *  every chunk belongs to row k of the deinterleaved frame, so deinterleaving is a transpose.
+ */
+struct AMBEInterleaveTables {
+    uint8_t unzip[256U];                        // byte -> the bit pairs of phase 0, 1, 2 and 3
+    uint8_t zip[256U];                          // bit pairs of phase 0, 1, 2 and 3 -> byte
+    uint64_t spread[64U];                       // 6 bit chunk -> bit k of the chunk in bit 0 of byte lane k
+
+    /**
+     * @brief Initializes a new instance of the AMBEInterleaveTables struct.
+     */
+    constexpr AMBEInterleaveTables() : unzip(), zip(), spread()
+    {
+        for (uint32_t b = 0U; b < 256U; b++) {
+            uint32_t u = 0U;
+            for (uint32_t s = 0U; s < 4U; s++) {
+                uint32_t pair = (((b >> (7U - s)) & 1U) << 1) | ((b >> (3U - s)) & 1U);
+                u |= pair << (6U - (2U * s));
+            }
+
+            unzip[b] = (uint8_t)u;
+            zip[u] = (uint8_t)b;
+        }
+
+        for (uint32_t c = 0U; c < 64U; c++) {
+            uint64_t v = 0U;
+            for (uint32_t k = 0U; k < 6U; k++)
+                v |= (uint64_t)((c >> (5U - k)) & 1U) << (8U * k);
+            spread[c] = v;
+        }
+    }
+};
+
+constexpr AMBEInterleaveTables AMBE_INTERLEAVE = AMBEInterleaveTables();
 
-AMBEFEC::~AMBEFEC() = default;
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
 
-/* Regenerates the DMR AMBE FEC for the input bytes. */
+/* Helper to deinterleave the A, B and C codewords of an AMBE frame. */
 
-uint32_t AMBEFEC::regenerateDMR(uint8_t* bytes) const
+static void deinterleaveAMBE(const uint8_t* bytes, uint32_t& a, uint32_t& b, uint32_t& c)
 {
-    assert(bytes != nullptr);
+    uint32_t p0 = 0U, p1 = 0U, p2 = 0U, p3 = 0U;
+    for (uint32_t i = 0U; i < 9U; i++) {
+        uint32_t u = AMBE_INTERLEAVE.unzip[bytes[i]];
+        p0 = (p0 << 2) | (u >> 6);
+        p1 = (p1 << 2) | ((u >> 4) & 0x03U);
+        p2 = (p2 << 2) | ((u >> 2) & 0x03U);
+        p3 = (p3 << 2) | (u & 0x03U);
+    }
+
+    // see AMBE_A_TABLE, AMBE_B_TABLE and AMBE_C_TABLE
+    a = (p0 << 6) | (p1 >> 12);
+    b = ((p1 & 0xFFFU) << 11) | (p2 >> 7);
+    c = ((p2 & 0x7FU) << 18) | p3;
+}
 
-    uint32_t a1 = 0U, a2 = 0U, a3 = 0U;
-    uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
-    uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
+/* Helper to interleave the A, B and C codewords of an AMBE frame. */
 
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        if (READ_BIT(bytes, a1Pos))
-            a1 |= MASK;
-        if (READ_BIT(bytes, a2Pos))
-            a2 |= MASK;
-        if (READ_BIT(bytes, a3Pos))
-            a3 |= MASK;
-    }
+static void interleaveAMBE(uint32_t a, uint32_t b, uint32_t c, uint8_t* bytes)
+{
+    uint32_t p0 = a >> 6;
+    uint32_t p1 = ((a & 0x3FU) << 12) | (b >> 11);
+    uint32_t p2 = ((b & 0x7FFU) << 7) | (c >> 18);
+    uint32_t p3 = c & 0x3FFFFU;
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        if (READ_BIT(bytes, b1Pos))
-            b1 |= MASK;
-        if (READ_BIT(bytes, b2Pos))
-            b2 |= MASK;
-        if (READ_BIT(bytes, b3Pos))
-            b3 |= MASK;
+    for (uint32_t i = 0U; i < 9U; i++) {
+        uint32_t shift = 16U - (2U * i);
+        uint32_t u = (((p0 >> shift) & 0x03U) << 6) | (((p1 >> shift) & 0x03U) << 4) |
+            (((p2 >> shift) & 0x03U) << 2) | ((p3 >> shift) & 0x03U);
+        bytes[i] = AMBE_INTERLEAVE.zip[u];
     }
+}
 
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t c1Pos = AMBE_C_TABLE[i];
-        uint32_t c2Pos = c1Pos + 72U;
-        if (c2Pos >= 108U)
-            c2Pos += 48U;
-        uint32_t c3Pos = c1Pos + 192U;
-
-        if (READ_BIT(bytes, c1Pos))
-            c1 |= MASK;
-        if (READ_BIT(bytes, c2Pos))
-            c2 |= MASK;
-        if (READ_BIT(bytes, c3Pos))
-            c3 |= MASK;
-    }
+/* Helper to gather the second AMBE frame of a DMR voice burst, which straddles the sync. */
 
-    uint32_t errors = regenerate(a1, b1, c1);
-    errors += regenerate(a2, b2, c2);
-    errors += regenerate(a3, b3, c3);
+static void gatherDMR(const uint8_t* bytes, uint8_t* frame)
+{
+    ::memcpy(frame, bytes + 9U, 4U);
+    frame[4U] = (bytes[13U] & 0xF0U) | (bytes[19U] & 0x0FU);
+    ::memcpy(frame + 5U, bytes + 20U, 4U);
+}
 
-    MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        WRITE_BIT(bytes, a1Pos, a1 & MASK);
-        WRITE_BIT(bytes, a2Pos, a2 & MASK);
-        WRITE_BIT(bytes, a3Pos, a3 & MASK);
-    }
+/* Helper to scatter the second AMBE frame of a DMR voice burst, which straddles the sync. */
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        WRITE_BIT(bytes, b1Pos, b1 & MASK);
-        WRITE_BIT(bytes, b2Pos, b2 & MASK);
-        WRITE_BIT(bytes, b3Pos, b3 & MASK);
-    }
+static void scatterDMR(const uint8_t* frame, uint8_t* bytes)
+{
+    ::memcpy(bytes + 9U, frame, 4U);
+    bytes[13U] = (bytes[13U] & 0x0FU) | (frame[4U] & 0xF0U);
+    bytes[19U] = (bytes[19U] & 0xF0U) | (frame[4U] & 0x0FU);
+    ::memcpy(bytes + 20U, frame + 5U, 4U);
+}
 
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t c1Pos = AMBE_C_TABLE[i];
-        uint32_t c2Pos = c1Pos + 72U;
-        if (c2Pos >= 108U)
-            c2Pos += 48U;
-        uint32_t c3Pos = c1Pos + 192U;
-
-        WRITE_BIT(bytes, c1Pos, c1 & MASK);
-        WRITE_BIT(bytes, c2Pos, c2 & MASK);
-        WRITE_BIT(bytes, c3Pos, c3 & MASK);
-    }
+/* Helper to swap the bits of each pair of rows in a 6 bit IMBE chunk. */
 
-    return errors;
+static inline uint32_t swapChunk(uint32_t chunk)
+{
+    return ((chunk & 0x2AU) >> 1) | ((chunk & 0x15U) << 1);
 }
 
-/* Returns the number of errors on the DMR BER input bytes. */
+/* Helper to deinterleave an IMBE frame into a 144 bit vector (MSB first). */
 
-uint32_t AMBEFEC::measureDMRBER(const uint8_t* bytes) const
+static void deinterleaveIMBE(const uint8_t* bytes, uint64_t* bits)
 {
-    assert(bytes != nullptr);
+    // transpose the 24 chunks into 6 rows of 24 bits; each accumulator holds 8 bits of every row
+    uint64_t acc[3U] = { 0U, 0U, 0U };
+    for (uint32_t i = 0U; i < 6U; i++) {
+        uint32_t w = (bytes[3U * i] << 16) | (bytes[(3U * i) + 1U] << 8) | bytes[(3U * i) + 2U];
+        for (uint32_t j = 0U; j < 4U; j++) {
+            uint32_t n = (4U * i) + j;
+            uint32_t chunk = (w >> (18U - (6U * j))) & 0x3FU;
+            if ((n & 1U) == 1U)
+                chunk = swapChunk(chunk);
 
-    uint32_t a1 = 0U, a2 = 0U, a3 = 0U;
-    uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
-    uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
-
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t a1Pos = AMBE_A_TABLE[i];
-        uint32_t a2Pos = a1Pos + 72U;
-        if (a2Pos >= 108U)
-            a2Pos += 48U;
-        uint32_t a3Pos = a1Pos + 192U;
-
-        if (READ_BIT(bytes, a1Pos))
-            a1 |= MASK;
-        if (READ_BIT(bytes, a2Pos))
-            a2 |= MASK;
-        if (READ_BIT(bytes, a3Pos))
-            a3 |= MASK;
+            acc[n >> 3] = (acc[n >> 3] << 1) | AMBE_INTERLEAVE.spread[chunk];
+        }
     }
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t b1Pos = AMBE_B_TABLE[i];
-        uint32_t b2Pos = b1Pos + 72U;
-        if (b2Pos >= 108U)
-            b2Pos += 48U;
-        uint32_t b3Pos = b1Pos + 192U;
-
-        if (READ_BIT(bytes, b1Pos))
-            b1 |= MASK;
-        if (READ_BIT(bytes, b2Pos))
-            b2 |= MASK;
-        if (READ_BIT(bytes, b3Pos))
-            b3 |= MASK;
+    uint64_t rows[6U];
+    for (uint32_t k = 0U; k < 6U; k++) {
+        uint32_t shift = 8U * k;
+        rows[k] = (((acc[0U] >> shift) & 0xFFU) << 16) | (((acc[1U] >> shift) & 0xFFU) << 8) | ((acc[2U] >> shift) & 0xFFU);
     }
 
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t c1Pos = AMBE_C_TABLE[i];
-        uint32_t c2Pos = c1Pos + 72U;
-        if (c2Pos >= 108U)
-            c2Pos += 48U;
-        uint32_t c3Pos = c1Pos + 192U;
-
-        if (READ_BIT(bytes, c1Pos))
-            c1 |= MASK;
-        if (READ_BIT(bytes, c2Pos))
-            c2 |= MASK;
-        if (READ_BIT(bytes, c3Pos))
-            c3 |= MASK;
-    }
+    bits[0U] = (rows[0U] << 40) | (rows[1U] << 16) | (rows[2U] >> 8);
+    bits[1U] = (rows[2U] << 56) | (rows[3U] << 32) | (rows[4U] << 8) | (rows[5U] >> 16);
+    bits[2U] = rows[5U] << 48;
+}
 
-    uint32_t errors = regenerate(a1, b1, c1);
-    errors += regenerate(a2, b2, c2);
-    errors += regenerate(a3, b3, c3);
+/* Helper to interleave a 144 bit vector (MSB first) into an IMBE frame. */
 
-    return errors;
+static void interleaveIMBE(const uint64_t* bits, uint8_t* bytes)
+{
+    uint64_t rows[6U];
+    rows[0U] = bits[0U] >> 40;
+    rows[1U] = (bits[0U] >> 16) & 0xFFFFFFU;
+    rows[2U] = ((bits[0U] & 0xFFFFU) << 8) | (bits[1U] >> 56);
+    rows[3U] = (bits[1U] >> 32) & 0xFFFFFFU;
+    rows[4U] = (bits[1U] >> 8) & 0xFFFFFFU;
+    rows[5U] = ((bits[1U] & 0xFFU) << 16) | (bits[2U] >> 48);
+
+    uint64_t acc[3U] = { 0U, 0U, 0U };
+    for (uint32_t k = 0U; k < 6U; k++) {
+        uint32_t shift = 8U * k;
+        acc[0U] |= ((rows[k] >> 16) & 0xFFU) << shift;
+        acc[1U] |= ((rows[k] >> 8) & 0xFFU) << shift;
+        acc[2U] |= (rows[k] & 0xFFU) << shift;
+    }
+
+    // gather bit 0 of each byte lane back into a 6 bit chunk
+    for (uint32_t i = 0U; i < 6U; i++) {
+        uint32_t w = 0U;
+        for (uint32_t j = 0U; j < 4U; j++) {
+            uint32_t n = (4U * i) + j;
+            uint64_t lanes = (acc[n >> 3] >> (7U - (n & 7U))) & 0x0000010101010101ULL;
+            uint32_t chunk = (uint32_t)((lanes * 0x8040201008040201ULL) >> 58);
+            if ((n & 1U) == 1U)
+                chunk = swapChunk(chunk);
+
+            w = (w << 6) | chunk;
+        }
+
+        bytes[3U * i] = (uint8_t)(w >> 16);
+        bytes[(3U * i) + 1U] = (uint8_t)(w >> 8);
+        bytes[(3U * i) + 2U] = (uint8_t)w;
+    }
 }
 
-/* Regenerates the P25 IMBE FEC for the input bytes. */
+/* Helper to read the given range of bits (up to 32) from a bit vector. */
 
-uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
+static inline uint32_t getBits(const uint64_t* bits, uint32_t start, uint32_t length)
 {
-    assert(bytes != nullptr);
+    uint32_t offset = start & 63U;
+    uint64_t v = bits[start >> 6] << offset;
+    if (offset + length > 64U)
+        v |= bits[(start >> 6) + 1U] >> (64U - offset);
+
+    return (uint32_t)(v >> (64U - length));
+}
 
-    bool orig[144U];
-    bool temp[144U];
+/* Helper to write the given range of bits (up to 32) into a bit vector. */
 
-    // De-interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        orig[i] = temp[i] = READ_BIT(bytes, n);
+static inline void setBits(uint64_t* bits, uint32_t start, uint32_t length, uint32_t value)
+{
+    uint32_t offset = start & 63U;
+    uint64_t* w = bits + (start >> 6);
+    uint64_t mask = (1ULL << length) - 1U;
+    if (offset + length <= 64U) {
+        uint32_t shift = 64U - offset - length;
+        w[0U] = (w[0U] & ~(mask << shift)) | ((uint64_t)value << shift);
+    }
+    else {
+        uint32_t low = offset + length - 64U;
+        w[0U] = (w[0U] & ~(mask >> low)) | ((uint64_t)value >> low);
+        w[1U] = (w[1U] & (~0ULL >> low)) | ((uint64_t)value << (64U - low));
     }
+}
 
+/* Helper to check and fix the FEC of a deinterleaved IMBE frame. */
+
+static uint32_t decodeIMBE(uint64_t* bits)
+{
     // now ..
 
     // 12 voice bits     0
@@ -242,282 +257,171 @@ uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
     //
     //  7 voice bits     137
 
-    // Process the c0 section first to allow the de-whitening to be accurate
-
-    // Check/Fix FEC
-    bool* bit = temp;
+    uint64_t orig[3U] = { bits[0U], bits[1U], bits[2U] };
 
-    // c0
-    uint32_t g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c0data = Golay24128::decode23127(g1);
-    uint32_t g2 = Golay24128::encode23127(c0data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    bool prn[114U];
+    // Process the c0 section first to allow the de-whitening to be accurate; the regenerated
+    // Golay words are written back 24 bits wide, clearing the first bit of the next codeword
+    // exactly as the original bit array implementation did
+    uint32_t c0data = Golay24128::decode23127(getBits(bits, 0U, 23U));
+    setBits(bits, 0U, 24U, Golay24128::encode23127(c0data));
 
-    // Create the whitening vector and save it for future use
+    // Create the whitening vector
+    uint64_t prn[3U] = { 0U, 0U, 0U };
     uint32_t p = 16U * c0data;
     for (uint32_t i = 0U; i < 114U; i++) {
         p = (173U * p + 13849U) % 65536U;
-        prn[i] = p >= 32768U;
+
+        uint32_t n = i + 23U;
+        prn[n >> 6] |= (uint64_t)(p >> 15) << (63U - (n & 63U));
     }
 
     // De-whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    // c1
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c1data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c1data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+    for (uint32_t i = 0U; i < 3U; i++)
+        bits[i] ^= prn[i];
+
+    // c1, c2, c3
+    for (uint32_t start = 23U; start < 92U; start += 23U) {
+        uint32_t data = Golay24128::decode23127(getBits(bits, start, 23U));
+        setBits(bits, start, 24U, Golay24128::encode23127(data));
     }
-    bit += 23U;
-
-    // c2
-    g1 = 0;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c2data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c2data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+
+    // c4, c5, c6
+    for (uint32_t start = 92U; start < 137U; start += 15U) {
+        uint16_t code = (uint16_t)getBits(bits, start, 15U);
+        Hamming::decode15113_1(code);
+        setBits(bits, start, 15U, code);
     }
-    bit += 23U;
-
-    // c3
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c3data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c3data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
+
+    // Whiten some bits
+    uint32_t errors = 0U;
+    for (uint32_t i = 0U; i < 3U; i++) {
+        bits[i] ^= prn[i];
+        errors += Utils::countBits64(bits[i] ^ orig[i]);
     }
-    bit += 23U;
 
-    // c4
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+    return errors;
+}
 
-    // c5
-    Hamming::decode15113_1(bit);
-    bit += 15U;
 
-    // c6
-    Hamming::decode15113_1(bit);
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
 
-    // Whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
+/* Initializes a new instance of the AMBEFEC class. */
 
-    uint32_t errors = 0U;
-    for (uint32_t i = 0U; i < 144U; i++) {
-        if (orig[i] != temp[i])
-            errors++;
-    }
+AMBEFEC::AMBEFEC() = default;
 
-    // Interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        WRITE_BIT(bytes, n, temp[i]);
-    }
+/* Finalizes a instance of the AMBEFEC class. */
 
-    return errors;
-}
+AMBEFEC::~AMBEFEC() = default;
 
-/* Returns the number of errors on the P25 BER input bytes. */
+/* Regenerates the DMR AMBE FEC for the input bytes. */
 
-uint32_t AMBEFEC::measureP25BER(const uint8_t* bytes) const
+uint32_t AMBEFEC::regenerateDMR(uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    bool orig[144U];
-    bool temp[144U];
+    uint8_t frame[9U];
+    gatherDMR(bytes, frame);
 
-    // De-interleave
-    for (uint32_t i = 0U; i < 144U; i++) {
-        uint32_t n = IMBE_INTERLEAVE[i];
-        orig[i] = temp[i] = READ_BIT(bytes, n);
-    }
+    uint32_t a1 = 0U, a2 = 0U, a3 = 0U;
+    uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
+    uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
+    deinterleaveAMBE(bytes, a1, b1, c1);
+    deinterleaveAMBE(frame, a2, b2, c2);
+    deinterleaveAMBE(bytes + 24U, a3, b3, c3);
 
-    // now ..
+    uint32_t errors = regenerate(a1, b1, c1);
+    errors += regenerate(a2, b2, c2);
+    errors += regenerate(a3, b3, c3);
 
-    // 12 voice bits     0
-    // 11 golay bits     12
-    //
-    // 12 voice bits     23
-    // 11 golay bits     35
-    //
-    // 12 voice bits     46
-    // 11 golay bits     58
-    //
-    // 12 voice bits     69
-    // 11 golay bits     81
-    //
-    // 11 voice bits     92
-    //  4 hamming bits   103
-    //
-    // 11 voice bits     107
-    //  4 hamming bits   118
-    //
-    // 11 voice bits     122
-    //  4 hamming bits   133
-    //
-    //  7 voice bits     137
+    interleaveAMBE(a1, b1, c1, bytes);
+    interleaveAMBE(a2, b2, c2, frame);
+    interleaveAMBE(a3, b3, c3, bytes + 24U);
+    scatterDMR(frame, bytes);
 
-    // Process the c0 section first to allow the de-whitening to be accurate
+    return errors;
+}
 
-    // Check/Fix FEC
-    bool* bit = temp;
+/* Returns the number of errors on the DMR BER input bytes. */
 
-    // c0
-    uint32_t g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c0data = Golay24128::decode23127(g1);
-    uint32_t g2 = Golay24128::encode23127(c0data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
+uint32_t AMBEFEC::measureDMRBER(const uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
 
-    bool prn[114U];
+    uint8_t frame[9U];
+    gatherDMR(bytes, frame);
 
-    // Create the whitening vector and save it for future use
-    uint32_t p = 16U * c0data;
-    for (uint32_t i = 0U; i < 114U; i++) {
-        p = (173U * p + 13849U) % 65536U;
-        prn[i] = p >= 32768U;
-    }
+    uint32_t a1 = 0U, a2 = 0U, a3 = 0U;
+    uint32_t b1 = 0U, b2 = 0U, b3 = 0U;
+    uint32_t c1 = 0U, c2 = 0U, c3 = 0U;
+    deinterleaveAMBE(bytes, a1, b1, c1);
+    deinterleaveAMBE(frame, a2, b2, c2);
+    deinterleaveAMBE(bytes + 24U, a3, b3, c3);
 
-    // De-whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
-
-    // c1
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c1data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c1data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c2
-    g1 = 0;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c2data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c2data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
-
-    // c3
-    g1 = 0U;
-    for (uint32_t i = 0U; i < 23U; i++)
-        g1 = (g1 << 1) | (bit[i] ? 0x01U : 0x00U);
-    uint32_t c3data = Golay24128::decode23127(g1);
-    g2 = Golay24128::encode23127(c3data);
-    for (int i = 23; i >= 0; i--) {
-        bit[i] = (g2 & 0x01U) == 0x01U;
-        g2 >>= 1;
-    }
-    bit += 23U;
+    uint32_t errors = regenerate(a1, b1, c1);
+    errors += regenerate(a2, b2, c2);
+    errors += regenerate(a3, b3, c3);
 
-    // c4
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+    return errors;
+}
 
-    // c5
-    Hamming::decode15113_1(bit);
-    bit += 15U;
+/* Regenerates the P25 IMBE FEC for the input bytes. */
 
-    // c6
-    Hamming::decode15113_1(bit);
+uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
 
-    // Whiten some bits
-    for (uint32_t i = 0U; i < 114U; i++)
-        temp[i + 23U] ^= prn[i];
+    uint64_t bits[3U];
+    deinterleaveIMBE(bytes, bits);
 
-    uint32_t errors = 0U;
-    for (uint32_t i = 0U; i < 144U; i++) {
-        if (orig[i] != temp[i])
-            errors++;
-    }
+    uint32_t errors = decodeIMBE(bits);
 
+    interleaveIMBE(bits, bytes);
     return errors;
 }
 
-/* Regenerates the NXDN AMBE FEC for the input bytes. */
+/* Regenerates the P25 IMBE FEC for a number of consecutive IMBE frames. */
 
-uint32_t AMBEFEC::regenerateNXDN(uint8_t* bytes) const
+uint32_t AMBEFEC::regenerateIMBE(uint8_t* bytes, uint32_t count) const
 {
     assert(bytes != nullptr);
 
-    uint32_t a = 0U;
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        if (READ_BIT(bytes, aPos))
-            a |= MASK;
+    uint64_t bits[3U];
+    uint32_t errors = 0U;
+    for (uint32_t i = 0U; i < count; i++, bytes += IMBE_FEC_LENGTH_BYTES) {
+        deinterleaveIMBE(bytes, bits);
+        errors += decodeIMBE(bits);
+        interleaveIMBE(bits, bytes);
     }
 
-    uint32_t b = 0U;
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        if (READ_BIT(bytes, bPos))
-            b |= MASK;
-    }
+    return errors;
+}
 
-    uint32_t c = 0U;
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        if (READ_BIT(bytes, cPos))
-            c |= MASK;
-    }
+/* Returns the number of errors on the P25 BER input bytes. */
 
-    uint32_t errors = regenerate(a, b, c);
+uint32_t AMBEFEC::measureP25BER(const uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
 
-    MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        WRITE_BIT(bytes, aPos, a & MASK);
-    }
+    uint64_t bits[3U];
+    deinterleaveIMBE(bytes, bits);
 
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        WRITE_BIT(bytes, bPos, b & MASK);
-    }
+    return decodeIMBE(bits);
+}
 
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        WRITE_BIT(bytes, cPos, c & MASK);
-    }
+/* Regenerates the NXDN AMBE FEC for the input bytes. */
 
+uint32_t AMBEFEC::regenerateNXDN(uint8_t* bytes) const
+{
+    assert(bytes != nullptr);
+
+    uint32_t a = 0U, b = 0U, c = 0U;
+    deinterleaveAMBE(bytes, a, b, c);
+
+    uint32_t errors = regenerate(a, b, c);
+
+    interleaveAMBE(a, b, c, bytes);
     return errors;
 }
 
@@ -527,29 +431,8 @@ uint32_t AMBEFEC::measureNXDNBER(uint8_t* bytes) const
 {
     assert(bytes != nullptr);
 
-    uint32_t a = 0U;
-    uint32_t MASK = 0x800000U;
-    for (uint32_t i = 0U; i < 24U; i++, MASK >>= 1) {
-        uint32_t aPos = AMBE_A_TABLE[i];
-        if (READ_BIT(bytes, aPos))
-            a |= MASK;
-    }
-
-    uint32_t b = 0U;
-    MASK = 0x400000U;
-    for (uint32_t i = 0U; i < 23U; i++, MASK >>= 1) {
-        uint32_t bPos = AMBE_B_TABLE[i];
-        if (READ_BIT(bytes, bPos))
-            b |= MASK;
-    }
-
-    uint32_t c = 0U;
-    MASK = 0x1000000U;
-    for (uint32_t i = 0U; i < 25U; i++, MASK >>= 1) {
-        uint32_t cPos = AMBE_C_TABLE[i];
-        if (READ_BIT(bytes, cPos))
-            c |= MASK;
-    }
+    uint32_t a = 0U, b = 0U, c = 0U;
+    deinterleaveAMBE(bytes, a, b, c);
 
     uint32_t errors = regenerate(a, b, c);
     return errors;
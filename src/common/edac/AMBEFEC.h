@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2010,2014,2016,2021 Jonathan Naylor, G4KLX
- *  Copyright (C) 2018-2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2018-2022,2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -455,6 +455,8 @@ namespace edac
         4, 11, 16, 23, 28, 35, 40, 47, 52, 59, 64, 71, 76, 83, 88, 95, 100, 107, 112, 119, 124, 131, 136, 143,
         5, 10, 17, 22, 29, 34, 41, 46, 53, 58, 65, 70, 77, 82, 89, 94, 101, 106, 113, 118, 125, 130, 137, 142 };
 
+    const uint32_t IMBE_FEC_LENGTH_BYTES = 18U;
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
@@ -494,6 +496,14 @@ namespace edac
          * @returns Count of errors.
          */
         uint32_t regenerateIMBE(uint8_t* bytes) const;
+        /**
+         * @brief Regenerates the P25 IMBE FEC for a number of consecutive IMBE frames (e.g. all 9
+         *  frames of a LDU).
+         * @param bytes IMBE bytes (count * IMBE_FEC_LENGTH_BYTES).
+         * @param count Number of IMBE frames.
+         * @returns uint32_t Count of errors.
+         */
+        uint32_t regenerateIMBE(uint8_t* bytes, uint32_t count) const;
         /**
          * @brief Returns the number of errors on the P25 BER input bytes.
          * @param[in] bytes AMBE bytes.
@@ -6,6 +6,7 @@
  *
  *  Copyright (C) 2012 Ian Wraith
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
@@ -16,6 +17,48 @@
 using namespace edac;
 
 #include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Interleave permutation for BPTC (196,96), generated at compile time.
+ *  Maps each bit of the deinterleaved code matrix to the byte and bit shift of its position in
+ *  the DMR burst (which skips the 68 bits of slot type and sync in the middle of the burst).
+ */
+struct BPTCInterleave {
+    uint8_t byte[196U];
+    uint8_t shift[196U];
+
+    /**
+     * @brief Initializes a new instance of the BPTCInterleave struct.
+     */
+    constexpr BPTCInterleave() : byte(), shift()
+    {
+        for (uint32_t a = 0U; a < 196U; a++) {
+            uint32_t raw = (a * 181U) % 196U;
+            uint32_t bit = (raw < 98U) ? raw : (raw + 68U);
+            byte[a] = (uint8_t)(bit >> 3);
+            shift[a] = (uint8_t)(7U - (bit & 7U));
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+constexpr BPTCInterleave BPTC_INTERLEAVE;
+
+/*
+** Hamming (13,9,3) column code; each entry is the column syndrome (c0 in the LSB) of a
+** single bit error in that row.
+*/
+const uint8_t COLUMN_ERROR_SYNDROME[13U] = { 0x0FU, 0x07U, 0x0EU, 0x05U, 0x0AU, 0x0DU, 0x03U, 0x06U, 0x0CU, 0x01U, 0x02U, 0x04U, 0x08U };
+
+#define ROW_MASK 0x7FFFU
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -24,20 +67,14 @@ using namespace edac;
 /* Initializes a new instance of the BPTC19696 class. */
 
 BPTC19696::BPTC19696() :
-    m_rawData(nullptr),
-    m_deInterData(nullptr)
+    m_rows()
 {
-    m_rawData = new bool[196];
-    m_deInterData = new bool[196];
+    /* stub */
 }
 
 /* Finalizes a instance of the BPTC19696 class. */
 
-BPTC19696::~BPTC19696()
-{
-    delete[] m_rawData;
-    delete[] m_deInterData;
-}
+BPTC19696::~BPTC19696() = default;
 
 /* Decode BPTC (196,96) FEC. */
 
@@ -46,11 +83,8 @@ void BPTC19696::decode(const uint8_t* in, uint8_t* out)
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // get the raw binary
-    decodeExtractBinary(in);
-
     // deinterleave
-    decodeDeInterleave();
+    decodeDeInterleave(in);
 
     // error check
     decodeErrorCheck();
@@ -73,105 +107,66 @@ void BPTC19696::encode(const uint8_t* in, uint8_t* out)
     encodeErrorCheck();
 
     // interleave
-    encodeInterleave();
-
-    // get the raw binary
-    encodeExtractBinary(out);
+    encodeInterleave(out);
 }
 
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* */
+/* Helper to deinterleave the raw burst bits into the 13 packed rows of the code matrix. */
 
-void BPTC19696::decodeExtractBinary(const uint8_t* in)
+void BPTC19696::decodeDeInterleave(const uint8_t* in)
 {
-    // first block
-    Utils::byteToBitsBE(in[0U], m_rawData + 0U);
-    Utils::byteToBitsBE(in[1U], m_rawData + 8U);
-    Utils::byteToBitsBE(in[2U], m_rawData + 16U);
-    Utils::byteToBitsBE(in[3U], m_rawData + 24U);
-    Utils::byteToBitsBE(in[4U], m_rawData + 32U);
-    Utils::byteToBitsBE(in[5U], m_rawData + 40U);
-    Utils::byteToBitsBE(in[6U], m_rawData + 48U);
-    Utils::byteToBitsBE(in[7U], m_rawData + 56U);
-    Utils::byteToBitsBE(in[8U], m_rawData + 64U);
-    Utils::byteToBitsBE(in[9U], m_rawData + 72U);
-    Utils::byteToBitsBE(in[10U], m_rawData + 80U);
-    Utils::byteToBitsBE(in[11U], m_rawData + 88U);
-    Utils::byteToBitsBE(in[12U], m_rawData + 96U);
-
-    // handle the two bits
-    bool bits[8U];
-    Utils::byteToBitsBE(in[20U], bits);
-    m_rawData[98U] = bits[6U];
-    m_rawData[99U] = bits[7U];
-
-    // second block
-    Utils::byteToBitsBE(in[21U], m_rawData + 100U);
-    Utils::byteToBitsBE(in[22U], m_rawData + 108U);
-    Utils::byteToBitsBE(in[23U], m_rawData + 116U);
-    Utils::byteToBitsBE(in[24U], m_rawData + 124U);
-    Utils::byteToBitsBE(in[25U], m_rawData + 132U);
-    Utils::byteToBitsBE(in[26U], m_rawData + 140U);
-    Utils::byteToBitsBE(in[27U], m_rawData + 148U);
-    Utils::byteToBitsBE(in[28U], m_rawData + 156U);
-    Utils::byteToBitsBE(in[29U], m_rawData + 164U);
-    Utils::byteToBitsBE(in[30U], m_rawData + 172U);
-    Utils::byteToBitsBE(in[31U], m_rawData + 180U);
-    Utils::byteToBitsBE(in[32U], m_rawData + 188U);
-}
-
-/* */
+    // the first bit is R(3) which is not used so can be ignored
+    for (uint32_t r = 0U; r < 13U; r++) {
+        const uint8_t* byte = BPTC_INTERLEAVE.byte + (r * 15U) + 1U;
+        const uint8_t* shift = BPTC_INTERLEAVE.shift + (r * 15U) + 1U;
 
-void BPTC19696::decodeDeInterleave()
-{
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
+        uint32_t row = 0U;
+        for (uint32_t c = 0U; c < 15U; c++)
+            row = (row << 1) | ((in[byte[c]] >> shift[c]) & 1U);
 
-    // the first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // shuffle the data
-        m_deInterData[a] = m_rawData[interleaveSequence];
+        m_rows[r] = (uint16_t)row;
     }
 }
 
-/* */
+/* Helper to correct the code matrix using the column and row Hamming codes. */
 
 void BPTC19696::decodeErrorCheck()
 {
+    uint16_t* r = m_rows;
+
     bool fixing;
     uint32_t count = 0U;
     do {
         fixing = false;
 
-        // run through each of the 15 columns
-        bool col[13U];
-        for (uint32_t c = 0U; c < 15U; c++) {
-            uint32_t pos = c + 1U;
-            for (uint32_t a = 0U; a < 13U; a++) {
-                col[a] = m_deInterData[pos];
-                pos = pos + 15U;
-            }
+        // run the Hamming (13,9,3) code on all 15 columns at once; bit n of each syndrome word
+        // is the syndrome bit of the column held in bit n of the rows
+        uint32_t syndrome[4U];
+        syndrome[0U] = r[0U] ^ r[1U] ^ r[3U] ^ r[5U] ^ r[6U] ^ r[9U];
+        syndrome[1U] = r[0U] ^ r[1U] ^ r[2U] ^ r[4U] ^ r[6U] ^ r[7U] ^ r[10U];
+        syndrome[2U] = r[0U] ^ r[1U] ^ r[2U] ^ r[3U] ^ r[5U] ^ r[7U] ^ r[8U] ^ r[11U];
+        syndrome[3U] = r[0U] ^ r[2U] ^ r[4U] ^ r[5U] ^ r[8U] ^ r[12U];
 
-            if (Hamming::decode1393(col)) {
-                uint32_t pos = c + 1U;
-                for (uint32_t a = 0U; a < 13U; a++) {
-                    m_deInterData[pos] = col[a];
-                    pos = pos + 15U;
+        if ((syndrome[0U] | syndrome[1U] | syndrome[2U] | syndrome[3U]) != 0U) {
+            for (uint32_t a = 0U; a < 13U; a++) {
+                // select the columns whose syndrome points at this row
+                uint32_t errors = ROW_MASK;
+                for (uint32_t j = 0U; j < 4U; j++)
+                    errors &= ((COLUMN_ERROR_SYNDROME[a] >> j) & 1U) ? syndrome[j] : ~syndrome[j];
+
+                if (errors != 0U) {
+                    r[a] ^= (uint16_t)errors;
+                    fixing = true;
                 }
-
-                fixing = true;
             }
         }
 
         // run through each of the 9 rows containing data
-        for (uint32_t r = 0U; r < 9U; r++) {
-            uint32_t pos = (r * 15U) + 1U;
-            if (Hamming::decode15113_2(m_deInterData + pos))
+        for (uint32_t a = 0U; a < 9U; a++) {
+            if (Hamming::decode15113_2(r[a]))
                 fixing = true;
         }
 
@@ -179,183 +174,77 @@ void BPTC19696::decodeErrorCheck()
     } while (fixing && count < 5U);
 }
 
-/* */
+/* Helper to extract the 96 data bits from the code matrix. */
 
 void BPTC19696::decodeExtractData(uint8_t* data) const
 {
-    bool bData[96U];
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        bData[pos] = m_deInterData[a];
-
-    Utils::bitsToByteBE(bData + 0U, data[0U]);
-    Utils::bitsToByteBE(bData + 8U, data[1U]);
-    Utils::bitsToByteBE(bData + 16U, data[2U]);
-    Utils::bitsToByteBE(bData + 24U, data[3U]);
-    Utils::bitsToByteBE(bData + 32U, data[4U]);
-    Utils::bitsToByteBE(bData + 40U, data[5U]);
-    Utils::bitsToByteBE(bData + 48U, data[6U]);
-    Utils::bitsToByteBE(bData + 56U, data[7U]);
-    Utils::bitsToByteBE(bData + 64U, data[8U]);
-    Utils::bitsToByteBE(bData + 72U, data[9U]);
-    Utils::bitsToByteBE(bData + 80U, data[10U]);
-    Utils::bitsToByteBE(bData + 88U, data[11U]);
-}
-
-/* */
+    // the first row carries 8 data bits (after R(2) - R(0)), the other 8 rows 11 data bits each
+    uint32_t acc = 0U, bits = 0U, n = 0U;
+    for (uint32_t r = 0U; r < 9U; r++) {
+        uint32_t width = (r == 0U) ? 8U : 11U;
+        acc = (acc << width) | ((m_rows[r] >> 4) & ((1U << width) - 1U));
+        bits += width;
 
-void BPTC19696::encodeExtractData(const uint8_t* in) const
-{
-    bool bData[96U];
-    Utils::byteToBitsBE(in[0U], bData + 0U);
-    Utils::byteToBitsBE(in[1U], bData + 8U);
-    Utils::byteToBitsBE(in[2U], bData + 16U);
-    Utils::byteToBitsBE(in[3U], bData + 24U);
-    Utils::byteToBitsBE(in[4U], bData + 32U);
-    Utils::byteToBitsBE(in[5U], bData + 40U);
-    Utils::byteToBitsBE(in[6U], bData + 48U);
-    Utils::byteToBitsBE(in[7U], bData + 56U);
-    Utils::byteToBitsBE(in[8U], bData + 64U);
-    Utils::byteToBitsBE(in[9U], bData + 72U);
-    Utils::byteToBitsBE(in[10U], bData + 80U);
-    Utils::byteToBitsBE(in[11U], bData + 88U);
-
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_deInterData[i] = false;
-
-    uint32_t pos = 0U;
-    for (uint32_t a = 4U; a <= 11U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 16U; a <= 26U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 31U; a <= 41U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 46U; a <= 56U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 61U; a <= 71U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 76U; a <= 86U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 91U; a <= 101U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 106U; a <= 116U; a++, pos++)
-        m_deInterData[a] = bData[pos];
-
-    for (uint32_t a = 121U; a <= 131U; a++, pos++)
-        m_deInterData[a] = bData[pos];
+        while (bits >= 8U) {
+            bits -= 8U;
+            data[n++] = (uint8_t)(acc >> bits);
+        }
+    }
 }
 
-/* */
+/* Helper to place the 96 data bits into the code matrix. */
 
-void BPTC19696::encodeErrorCheck()
+void BPTC19696::encodeExtractData(const uint8_t* in)
 {
-    // run through each of the 9 rows containing data
-    for (uint32_t r = 0U; r < 9U; r++) {
-        uint32_t pos = (r * 15U) + 1U;
-        Hamming::encode15113_2(m_deInterData + pos);
-    }
+    ::memset(m_rows, 0x00U, sizeof(m_rows));
 
-    // run through each of the 15 columns
-    bool col[13U];
-    for (uint32_t c = 0U; c < 15U; c++) {
-        uint32_t pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            col[a] = m_deInterData[pos];
-            pos = pos + 15U;
+    uint32_t acc = 0U, bits = 0U, n = 0U;
+    for (uint32_t r = 0U; r < 9U; r++) {
+        uint32_t width = (r == 0U) ? 8U : 11U;
+        while (bits < width) {
+            acc = (acc << 8) | in[n++];
+            bits += 8U;
         }
 
-        Hamming::encode1393(col);
-
-        pos = c + 1U;
-        for (uint32_t a = 0U; a < 13U; a++) {
-            m_deInterData[pos] = col[a];
-            pos = pos + 15U;
-        }
+        bits -= width;
+        m_rows[r] = (uint16_t)(((acc >> bits) & ((1U << width) - 1U)) << 4);
     }
 }
 
-/* */
+/* Helper to calculate the row and column Hamming parity of the code matrix. */
 
-void BPTC19696::encodeInterleave()
+void BPTC19696::encodeErrorCheck()
 {
-    for (uint32_t i = 0U; i < 196U; i++)
-        m_rawData[i] = false;
+    uint16_t* r = m_rows;
 
-    // the first bit is R(3) which is not used so can be ignored
-    for (uint32_t a = 0U; a < 196U; a++) {
-        // calculate the interleave sequence
-        uint32_t interleaveSequence = (a * 181U) % 196U;
-        // unshuffle the data
-        m_rawData[interleaveSequence] = m_deInterData[a];
-    }
+    // run through each of the 9 rows containing data
+    for (uint32_t a = 0U; a < 9U; a++)
+        Hamming::encode15113_2(r[a]);
+
+    // calculate the Hamming (13,9,3) parity of all 15 columns at once
+    r[9U] = r[0U] ^ r[1U] ^ r[3U] ^ r[5U] ^ r[6U];
+    r[10U] = r[0U] ^ r[1U] ^ r[2U] ^ r[4U] ^ r[6U] ^ r[7U];
+    r[11U] = r[0U] ^ r[1U] ^ r[2U] ^ r[3U] ^ r[5U] ^ r[7U] ^ r[8U];
+    r[12U] = r[0U] ^ r[2U] ^ r[4U] ^ r[5U] ^ r[8U];
 }
 
-/* */
+/* Helper to interleave the code matrix into the raw burst bits. */
 
-void BPTC19696::encodeExtractBinary(uint8_t* data)
+void BPTC19696::encodeInterleave(uint8_t* data) const
 {
-    // first block
-    Utils::bitsToByteBE(m_rawData + 0U, data[0U]);
-    Utils::bitsToByteBE(m_rawData + 8U, data[1U]);
-    Utils::bitsToByteBE(m_rawData + 16U, data[2U]);
-    Utils::bitsToByteBE(m_rawData + 24U, data[3U]);
-    Utils::bitsToByteBE(m_rawData + 32U, data[4U]);
-    Utils::bitsToByteBE(m_rawData + 40U, data[5U]);
-    Utils::bitsToByteBE(m_rawData + 48U, data[6U]);
-    Utils::bitsToByteBE(m_rawData + 56U, data[7U]);
-    Utils::bitsToByteBE(m_rawData + 64U, data[8U]);
-    Utils::bitsToByteBE(m_rawData + 72U, data[9U]);
-    Utils::bitsToByteBE(m_rawData + 80U, data[10U]);
-    Utils::bitsToByteBE(m_rawData + 88U, data[11U]);
-
-    // handle the two bits
-    uint8_t byte;
-    Utils::bitsToByteBE(m_rawData + 96U, byte);
-    data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-    data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
-
-    // second block
-    Utils::bitsToByteBE(m_rawData + 100U, data[21U]);
-    Utils::bitsToByteBE(m_rawData + 108U, data[22U]);
-    Utils::bitsToByteBE(m_rawData + 116U, data[23U]);
-    Utils::bitsToByteBE(m_rawData + 124U, data[24U]);
-    Utils::bitsToByteBE(m_rawData + 132U, data[25U]);
-    Utils::bitsToByteBE(m_rawData + 140U, data[26U]);
-    Utils::bitsToByteBE(m_rawData + 148U, data[27U]);
-    Utils::bitsToByteBE(m_rawData + 156U, data[28U]);
-    Utils::bitsToByteBE(m_rawData + 164U, data[29U]);
-    Utils::bitsToByteBE(m_rawData + 172U, data[30U]);
-    Utils::bitsToByteBE(m_rawData + 180U, data[31U]);
-    Utils::bitsToByteBE(m_rawData + 188U, data[32U]);
+    // clear the payload bits of the burst, leaving the slot type and sync in between untouched
+    ::memset(data + 0U, 0x00U, 12U);
+    data[12U] &= 0x3FU;
+    data[20U] &= 0xFCU;
+    ::memset(data + 21U, 0x00U, 12U);
+
+    // the first bit is R(3) which is always transmitted as zero
+    for (uint32_t r = 0U; r < 13U; r++) {
+        const uint8_t* byte = BPTC_INTERLEAVE.byte + (r * 15U) + 1U;
+        const uint8_t* shift = BPTC_INTERLEAVE.shift + (r * 15U) + 1U;
+
+        uint32_t row = m_rows[r];
+        for (uint32_t c = 0U; c < 15U; c++)
+            data[byte[c]] |= (uint8_t)(((row >> (14U - c)) & 1U) << shift[c]);
+    }
 }
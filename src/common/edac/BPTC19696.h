@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -53,45 +54,38 @@ namespace edac
         void encode(const uint8_t* in, uint8_t* out);
 
     private:
-        bool* m_rawData;
-        bool* m_deInterData;
+        uint16_t m_rows[13U];
 
         /**
-         * @brief 
-         * @param in
+         * @brief Helper to deinterleave the raw burst bits into the 13 packed rows of the code matrix.
+         *  Bit 14 of each row is column 0; the R(3) bit that precedes the matrix is discarded.
+         * @param in Input burst.
          */
-        void decodeExtractBinary(const uint8_t* in);
+        void decodeDeInterleave(const uint8_t* in);
         /**
-         * @brief 
+         * @brief Helper to correct the code matrix using the column and row Hamming codes.
          */
         void decodeErrorCheck();
         /**
-         * @brief 
-         */
-        void decodeDeInterleave();
-        /**
-         * @brief 
-         * @param data 
+         * @brief Helper to extract the 96 data bits from the code matrix.
+         * @param data Decoded data.
          */
         void decodeExtractData(uint8_t* data) const;
 
         /**
-         * @brief 
-         */
-        void encodeExtractData(const uint8_t* in) const;
-        /**
-         * @brief 
+         * @brief Helper to place the 96 data bits into the code matrix.
+         * @param in Input data.
          */
-        void encodeInterleave();
+        void encodeExtractData(const uint8_t* in);
         /**
-         * @brief 
+         * @brief Helper to calculate the row and column Hamming parity of the code matrix.
          */
         void encodeErrorCheck();
         /**
-         * @brief 
-         * @param data 
+         * @brief Helper to interleave the code matrix into the raw burst bits.
+         * @param data Output burst.
          */
-        void encodeExtractBinary(uint8_t* data);
+        void encodeInterleave(uint8_t* data) const;
     };
 } // namespace edac
 
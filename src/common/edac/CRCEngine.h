@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file CRCEngine.h
+ * @ingroup edac
+ */
+#if !defined(__CRC_ENGINE_H__)
+#define __CRC_ENGINE_H__
+
+#include "common/Defines.h"
+
+namespace edac
+{
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Slicing-by-8 lookup tables for a CRC, generated at compile time.
+     *  Non-reflected CRCs are held left-aligned in a 32-bit register (so that any width up to
+     *  32 bits shares the same byte step); reflected CRCs are held right-aligned.
+     * @ingroup edac
+     * @tparam Width CRC width (bits).
+     * @tparam Poly Generator polynomial (normal form for non-reflected, reversed form for reflected).
+     * @tparam Reflect Flag indicating the CRC is processed LSB first.
+     */
+    template <uint32_t Width, uint32_t Poly, bool Reflect>
+    struct CRCTables {
+        uint32_t t[8U][256U];
+
+        /**
+         * @brief Initializes a new instance of the CRCTables struct.
+         */
+        constexpr CRCTables() : t()
+        {
+            for (uint32_t b = 0U; b < 256U; b++) {
+                uint32_t crc = 0U;
+                if (Reflect) {
+                    crc = b;
+                    for (uint32_t i = 0U; i < 8U; i++)
+                        crc = (crc & 1U) ? ((crc >> 1) ^ Poly) : (crc >> 1);
+                }
+                else {
+                    const uint32_t poly = Poly << (32U - Width);
+                    crc = b << 24;
+                    for (uint32_t i = 0U; i < 8U; i++)
+                        crc = (crc & 0x80000000U) ? ((crc << 1) ^ poly) : (crc << 1);
+                }
+
+                t[0U][b] = crc;
+            }
+
+            // each further table advances the previous one by a zero byte
+            for (uint32_t k = 1U; k < 8U; k++) {
+                for (uint32_t b = 0U; b < 256U; b++) {
+                    uint32_t prev = t[k - 1U][b];
+                    t[k][b] = Reflect ? ((prev >> 8) ^ t[0U][prev & 0xFFU]) : ((prev << 8) ^ t[0U][prev >> 24]);
+                }
+            }
+        }
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a generic table driven CRC, parameterized on width, polynomial, reflection,
+     *  initial value and final XOR value.
+     *  Byte aligned data is processed 8 bytes at a time (slicing-by-8); only the trailing bits of a
+     *  field that is not a whole number of bytes long are processed bit by bit.
+     * @ingroup edac
+     * @tparam Width CRC width (bits, 1 - 32).
+     * @tparam Poly Generator polynomial (normal form for non-reflected, reversed form for reflected).
+     * @tparam Init Initial CRC register value.
+     * @tparam XorOut Value XORed with the CRC register to produce the final CRC.
+     * @tparam Reflect Flag indicating the CRC is processed LSB first.
+     */
+    template <uint32_t Width, uint32_t Poly, uint32_t Init, uint32_t XorOut, bool Reflect = false>
+    class CRCEngine {
+        static_assert(Width > 0U && Width <= 32U, "CRC width must be between 1 and 32 bits");
+
+    public:
+        /**
+         * @brief Mask of the valid CRC bits.
+         */
+        static constexpr uint32_t MASK = 0xFFFFFFFFU >> (32U - Width);
+
+        /**
+         * @brief Calculates the CRC over the given bytes.
+         * @param in Input buffer.
+         * @param length Length of the input buffer (bytes).
+         * @returns uint32_t Calculated CRC.
+         */
+        static uint32_t calc(const uint8_t* in, uint32_t length)
+        {
+            return finalize(update(initial(), in, length));
+        }
+
+        /**
+         * @brief Calculates the CRC over the given number of bits, MSB first.
+         * @param in Input buffer.
+         * @param bitLength Length of the input (bits).
+         * @returns uint32_t Calculated CRC.
+         */
+        static uint32_t calcBits(const uint8_t* in, uint32_t bitLength)
+        {
+            static_assert(!Reflect, "bit-wise input is only supported for non-reflected CRCs");
+
+            uint32_t length = bitLength >> 3;
+            uint32_t reg = update(initial(), in, length);
+
+            // process any trailing bits that do not make up a whole byte
+            const uint32_t poly = Poly << (32U - Width);
+            uint32_t remain = bitLength & 7U;
+            if (remain > 0U) {
+                uint32_t data = uint32_t(in[length]) << 24;
+                for (uint32_t i = 0U; i < remain; i++) {
+                    bool bit = ((reg ^ data) & 0x80000000U) != 0U;
+                    reg <<= 1;
+                    data <<= 1;
+                    if (bit)
+                        reg ^= poly;
+                }
+            }
+
+            return finalize(reg);
+        }
+
+    private:
+        static constexpr CRCTables<Width, Poly, Reflect> TABLES = CRCTables<Width, Poly, Reflect>();
+
+        /**
+         * @brief Helper to get the initial CRC register value.
+         * @returns uint32_t Initial CRC register value.
+         */
+        static constexpr uint32_t initial()
+        {
+            return Reflect ? Init : (Init << (32U - Width));
+        }
+
+        /**
+         * @brief Helper to convert the CRC register into the final CRC.
+         * @param reg CRC register.
+         * @returns uint32_t Final CRC.
+         */
+        static uint32_t finalize(uint32_t reg)
+        {
+            uint32_t crc = Reflect ? reg : (reg >> (32U - Width));
+            return (crc ^ XorOut) & MASK;
+        }
+
+        /**
+         * @brief Helper to run the given bytes through the CRC register.
+         * @param reg CRC register.
+         * @param in Input buffer.
+         * @param length Length of the input buffer (bytes).
+         * @returns uint32_t Updated CRC register.
+         */
+        static uint32_t update(uint32_t reg, const uint8_t* in, uint32_t length)
+        {
+            const uint32_t (&t)[8U][256U] = TABLES.t;
+
+            while (length >= 8U) {
+                if (Reflect) {
+                    uint32_t r = reg ^ (uint32_t(in[0U]) | (uint32_t(in[1U]) << 8) | (uint32_t(in[2U]) << 16) | (uint32_t(in[3U]) << 24));
+                    reg = t[7U][r & 0xFFU] ^ t[6U][(r >> 8) & 0xFFU] ^ t[5U][(r >> 16) & 0xFFU] ^ t[4U][r >> 24] ^
+                        t[3U][in[4U]] ^ t[2U][in[5U]] ^ t[1U][in[6U]] ^ t[0U][in[7U]];
+                }
+                else {
+                    uint32_t r = reg ^ ((uint32_t(in[0U]) << 24) | (uint32_t(in[1U]) << 16) | (uint32_t(in[2U]) << 8) | uint32_t(in[3U]));
+                    reg = t[7U][r >> 24] ^ t[6U][(r >> 16) & 0xFFU] ^ t[5U][(r >> 8) & 0xFFU] ^ t[4U][r & 0xFFU] ^
+                        t[3U][in[4U]] ^ t[2U][in[5U]] ^ t[1U][in[6U]] ^ t[0U][in[7U]];
+                }
+
+                in += 8U;
+                length -= 8U;
+            }
+
+            while (length-- > 0U) {
+                if (Reflect)
+                    reg = (reg >> 8) ^ t[0U][(reg ^ *in++) & 0xFFU];
+                else
+                    reg = (reg << 8) ^ t[0U][(reg >> 24) ^ *in++];
+            }
+
+            return reg;
+        }
+    };
+
+    template <uint32_t Width, uint32_t Poly, uint32_t Init, uint32_t XorOut, bool Reflect>
+    constexpr CRCTables<Width, Poly, Reflect> CRCEngine<Width, Poly, Init, XorOut, Reflect>::TABLES;
+} // namespace edac
+
+#endif // __CRC_ENGINE_H__
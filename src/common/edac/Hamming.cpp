@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015,2016 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "edac/Hamming.h"
@@ -13,6 +14,116 @@ using namespace edac;
 
 #include <cassert>
 
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Parity and syndrome lookup tables for a Hamming code, generated at compile time.
+ *  The tables are built from the data bits covered by each parity bit; the first mask
+ *  is parity bit d[K] (the MSB of the parity bits).
+ * @tparam K Number of data bits.
+ * @tparam P Number of parity bits.
+ */
+template <uint32_t K, uint32_t P>
+struct HammingTables {
+    uint8_t parity[1U << K];        //! parity bits for each data word
+    uint32_t error[1U << P];        //! error pattern for each syndrome, or 0 if not correctable
+
+    /**
+     * @brief Initializes a new instance of the HammingTables struct.
+     * @param masks Data bits (d[0] is the MSB) covered by each parity bit.
+     */
+    constexpr HammingTables(const uint32_t (&masks)[P]) : parity(), error()
+    {
+        for (uint32_t data = 0U; data < (1U << K); data++) {
+            uint8_t p = 0U;
+            for (uint32_t j = 0U; j < P; j++) {
+                uint32_t x = data & masks[j];
+                uint32_t odd = 0U;
+                for (; x != 0U; x &= x - 1U)
+                    odd ^= 1U;
+                p = (p << 1) | odd;
+            }
+
+            parity[data] = p;
+        }
+
+        // a single bit error in the codeword produces the syndrome of its own column
+        for (uint32_t bit = 0U; bit < (K + P); bit++) {
+            uint32_t syndrome = (bit < P) ? (1U << bit) : parity[1U << (bit - P)];
+            error[syndrome] = 1U << bit;
+        }
+    }
+
+    /**
+     * @brief Calculates the syndrome of a packed codeword.
+     * @param code Packed codeword.
+     * @returns uint32_t Syndrome.
+     */
+    constexpr uint32_t syndrome(uint32_t code) const
+    {
+        return parity[(code >> P) & ((1U << K) - 1U)] ^ (code & ((1U << P) - 1U));
+    }
+
+    /**
+     * @brief Replaces the parity bits of a packed codeword.
+     * @param code Packed codeword.
+     * @returns uint32_t Encoded codeword.
+     */
+    constexpr uint32_t encode(uint32_t code) const
+    {
+        return (code & ~((1U << P) - 1U)) | parity[(code >> P) & ((1U << K) - 1U)];
+    }
+};
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+/*
+** Data bits covered by each parity bit (written d[0] ... d[K - 1], left to right).
+*/
+
+constexpr uint32_t HAMMING_15113_1_MASKS[] = { 0b11111110000U, 0b11110001110U, 0b11001101101U, 0b10101011011U };
+constexpr uint32_t HAMMING_15113_2_MASKS[] = { 0b11110101100U, 0b01111010110U, 0b00111101011U, 0b11101011001U };
+constexpr uint32_t HAMMING_1393_MASKS[] = { 0b110101100U, 0b111010110U, 0b111101011U, 0b101011001U };
+constexpr uint32_t HAMMING_1063_MASKS[] = { 0b111001U, 0b110101U, 0b101110U, 0b011110U };
+constexpr uint32_t HAMMING_16114_MASKS[] = { 0b11110101100U, 0b01111010110U, 0b00111101011U, 0b11101011001U, 0b10100110111U };
+constexpr uint32_t HAMMING_17123_MASKS[] = { 0b111100110100U, 0b111110011010U, 0b011111001101U, 0b110011010010U, 0b111001101001U };
+
+constexpr HammingTables<11U, 4U> HAMMING_15113_1(HAMMING_15113_1_MASKS);
+constexpr HammingTables<11U, 4U> HAMMING_15113_2(HAMMING_15113_2_MASKS);
+constexpr HammingTables<9U, 4U> HAMMING_1393(HAMMING_1393_MASKS);
+constexpr HammingTables<6U, 4U> HAMMING_1063(HAMMING_1063_MASKS);
+constexpr HammingTables<11U, 5U> HAMMING_16114(HAMMING_16114_MASKS);
+constexpr HammingTables<12U, 5U> HAMMING_17123(HAMMING_17123_MASKS);
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to pack a boolean bit array into a codeword, d[0] in the MSB. */
+
+template <uint32_t N>
+static uint32_t packBits(const bool* d)
+{
+    uint32_t code = 0U;
+    for (uint32_t i = 0U; i < N; i++)
+        code = (code << 1) | (d[i] ? 1U : 0U);
+
+    return code;
+}
+
+/* Helper to unpack the given range of bits of a codeword into a boolean bit array. */
+
+template <uint32_t N>
+static void unpackBits(uint32_t code, bool* d, uint32_t start = 0U)
+{
+    for (uint32_t i = start; i < N; i++)
+        d[i] = ((code >> (N - 1U - i)) & 1U) != 0U;
+}
+
 // ---------------------------------------------------------------------------
 //  Static Class Members
 // ---------------------------------------------------------------------------
@@ -23,41 +134,12 @@ bool Hamming::decode15113_1(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the parity it should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[6];
-    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9];
-    bool c2 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[8] ^ d[10];
-    bool c3 = d[0] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[9] ^ d[10];
-
-    unsigned char n = 0U;
-    n |= (c0 != d[11]) ? 0x01U : 0x00U;
-    n |= (c1 != d[12]) ? 0x02U : 0x00U;
-    n |= (c2 != d[13]) ? 0x04U : 0x00U;
-    n |= (c3 != d[14]) ? 0x08U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[11] = !d[11]; return true;
-        case 0x02U: d[12] = !d[12]; return true;
-        case 0x04U: d[13] = !d[13]; return true;
-        case 0x08U: d[14] = !d[14]; return true;
-
-        // Data bit errors
-        case 0x0FU: d[0] = !d[0];  return true;
-        case 0x07U: d[1] = !d[1];  return true;
-        case 0x0BU: d[2] = !d[2];  return true;
-        case 0x03U: d[3] = !d[3];  return true;
-        case 0x0DU: d[4] = !d[4];  return true;
-        case 0x05U: d[5] = !d[5];  return true;
-        case 0x09U: d[6] = !d[6];  return true;
-        case 0x0EU: d[7] = !d[7];  return true;
-        case 0x06U: d[8] = !d[8];  return true;
-        case 0x0AU: d[9] = !d[9];  return true;
-        case 0x0CU: d[10] = !d[10]; return true;
-
-        // No bit errors
-        default: return false;
-    }
+    uint16_t code = packBits<15U>(d);
+    if (!decode15113_1(code))
+        return false;
+
+    unpackBits<15U>(code, d);
+    return true;
 }
 
 /* Encode Hamming (15,11,3). */
@@ -66,11 +148,25 @@ void Hamming::encode15113_1(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this row should have
-    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[6];
-    d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[7] ^ d[8] ^ d[9];
-    d[13] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[8] ^ d[10];
-    d[14] = d[0] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[9] ^ d[10];
+    uint16_t code = packBits<15U>(d);
+    encode15113_1(code);
+    unpackBits<15U>(code, d, 11U);
+}
+
+/* Decode Hamming (15,11,3) packed codeword. */
+
+bool Hamming::decode15113_1(uint16_t& code)
+{
+    uint32_t error = HAMMING_15113_1.error[HAMMING_15113_1.syndrome(code)];
+    code ^= error;
+    return error != 0U;
+}
+
+/* Encode Hamming (15,11,3) packed codeword. */
+
+void Hamming::encode15113_1(uint16_t& code)
+{
+    code = HAMMING_15113_1.encode(code);
 }
 
 /* Decode Hamming (15,11,3). */
@@ -79,41 +175,12 @@ bool Hamming::decode15113_2(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this row should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-    bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-    bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-
-    unsigned char n = 0x00U;
-    n |= (c0 != d[11]) ? 0x01U : 0x00U;
-    n |= (c1 != d[12]) ? 0x02U : 0x00U;
-    n |= (c2 != d[13]) ? 0x04U : 0x00U;
-    n |= (c3 != d[14]) ? 0x08U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[11] = !d[11]; return true;
-        case 0x02U: d[12] = !d[12]; return true;
-        case 0x04U: d[13] = !d[13]; return true;
-        case 0x08U: d[14] = !d[14]; return true;
-
-        // Data bit errors
-        case 0x09U: d[0] = !d[0];  return true;
-        case 0x0BU: d[1] = !d[1];  return true;
-        case 0x0FU: d[2] = !d[2];  return true;
-        case 0x07U: d[3] = !d[3];  return true;
-        case 0x0EU: d[4] = !d[4];  return true;
-        case 0x05U: d[5] = !d[5];  return true;
-        case 0x0AU: d[6] = !d[6];  return true;
-        case 0x0DU: d[7] = !d[7];  return true;
-        case 0x03U: d[8] = !d[8];  return true;
-        case 0x06U: d[9] = !d[9];  return true;
-        case 0x0CU: d[10] = !d[10]; return true;
-
-        // No bit errors
-        default: return false;
-    }
+    uint16_t code = packBits<15U>(d);
+    if (!decode15113_2(code))
+        return false;
+
+    unpackBits<15U>(code, d);
+    return true;
 }
 
 /* Encode Hamming (15,11,3). */
@@ -122,11 +189,25 @@ void Hamming::encode15113_2(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this row should have
-    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-    d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-    d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
+    uint16_t code = packBits<15U>(d);
+    encode15113_2(code);
+    unpackBits<15U>(code, d, 11U);
+}
+
+/* Decode Hamming (15,11,3) packed codeword. */
+
+bool Hamming::decode15113_2(uint16_t& code)
+{
+    uint32_t error = HAMMING_15113_2.error[HAMMING_15113_2.syndrome(code)];
+    code ^= error;
+    return error != 0U;
+}
+
+/* Encode Hamming (15,11,3) packed codeword. */
+
+void Hamming::encode15113_2(uint16_t& code)
+{
+    code = HAMMING_15113_2.encode(code);
 }
 
 /* Decode Hamming (13,9,3). */
@@ -135,39 +216,12 @@ bool Hamming::decode1393(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    bool c0 = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
-    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
-    bool c2 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    bool c3 = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
-
-    unsigned char n = 0x00U;
-    n |= (c0 != d[9]) ? 0x01U : 0x00U;
-    n |= (c1 != d[10]) ? 0x02U : 0x00U;
-    n |= (c2 != d[11]) ? 0x04U : 0x00U;
-    n |= (c3 != d[12]) ? 0x08U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[9] = !d[9];  return true;
-        case 0x02U: d[10] = !d[10]; return true;
-        case 0x04U: d[11] = !d[11]; return true;
-        case 0x08U: d[12] = !d[12]; return true;
-
-        // Data bit erros
-        case 0x0FU: d[0] = !d[0]; return true;
-        case 0x07U: d[1] = !d[1]; return true;
-        case 0x0EU: d[2] = !d[2]; return true;
-        case 0x05U: d[3] = !d[3]; return true;
-        case 0x0AU: d[4] = !d[4]; return true;
-        case 0x0DU: d[5] = !d[5]; return true;
-        case 0x03U: d[6] = !d[6]; return true;
-        case 0x06U: d[7] = !d[7]; return true;
-        case 0x0CU: d[8] = !d[8]; return true;
-
-        // No bit errors
-        default: return false;
-    }
+    uint16_t code = packBits<13U>(d);
+    if (!decode1393(code))
+        return false;
+
+    unpackBits<13U>(code, d);
+    return true;
 }
 
 /* Encode Hamming (13,9,3). */
@@ -176,11 +230,25 @@ void Hamming::encode1393(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    d[9] = d[0] ^ d[1] ^ d[3] ^ d[5] ^ d[6];
-    d[10] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7];
-    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    d[12] = d[0] ^ d[2] ^ d[4] ^ d[5] ^ d[8];
+    uint16_t code = packBits<13U>(d);
+    encode1393(code);
+    unpackBits<13U>(code, d, 9U);
+}
+
+/* Decode Hamming (13,9,3) packed codeword. */
+
+bool Hamming::decode1393(uint16_t& code)
+{
+    uint32_t error = HAMMING_1393.error[HAMMING_1393.syndrome(code)];
+    code ^= error;
+    return error != 0U;
+}
+
+/* Encode Hamming (13,9,3) packed codeword. */
+
+void Hamming::encode1393(uint16_t& code)
+{
+    code = HAMMING_1393.encode(code);
 }
 
 /* Decode Hamming (10,6,3). */
@@ -189,36 +257,12 @@ bool Hamming::decode1063(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[5];
-    bool c1 = d[0] ^ d[1] ^ d[3] ^ d[5];
-    bool c2 = d[0] ^ d[2] ^ d[3] ^ d[4];
-    bool c3 = d[1] ^ d[2] ^ d[3] ^ d[4];
-
-    unsigned char n = 0x00U;
-    n |= (c0 != d[6]) ? 0x01U : 0x00U;
-    n |= (c1 != d[7]) ? 0x02U : 0x00U;
-    n |= (c2 != d[8]) ? 0x04U : 0x00U;
-    n |= (c3 != d[9]) ? 0x08U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[6] = !d[6]; return true;
-        case 0x02U: d[7] = !d[7]; return true;
-        case 0x04U: d[8] = !d[8]; return true;
-        case 0x08U: d[9] = !d[9]; return true;
-
-        // Data bit erros
-        case 0x07U: d[0] = !d[0]; return true;
-        case 0x0BU: d[1] = !d[1]; return true;
-        case 0x0DU: d[2] = !d[2]; return true;
-        case 0x0EU: d[3] = !d[3]; return true;
-        case 0x0CU: d[4] = !d[4]; return true;
-        case 0x03U: d[5] = !d[5]; return true;
-
-        // No bit errors
-        default: return false;
-    }
+    uint16_t code = packBits<10U>(d);
+    if (!decode1063(code))
+        return false;
+
+    unpackBits<10U>(code, d);
+    return true;
 }
 
 /* Encode Hamming (10,6,3). */
@@ -227,11 +271,25 @@ void Hamming::encode1063(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    d[6] = d[0] ^ d[1] ^ d[2] ^ d[5];
-    d[7] = d[0] ^ d[1] ^ d[3] ^ d[5];
-    d[8] = d[0] ^ d[2] ^ d[3] ^ d[4];
-    d[9] = d[1] ^ d[2] ^ d[3] ^ d[4];
+    uint16_t code = packBits<10U>(d);
+    encode1063(code);
+    unpackBits<10U>(code, d, 6U);
+}
+
+/* Decode Hamming (10,6,3) packed codeword. */
+
+bool Hamming::decode1063(uint16_t& code)
+{
+    uint32_t error = HAMMING_1063.error[HAMMING_1063.syndrome(code)];
+    code ^= error;
+    return error != 0U;
+}
+
+/* Encode Hamming (10,6,3) packed codeword. */
+
+void Hamming::encode1063(uint16_t& code)
+{
+    code = HAMMING_1063.encode(code);
 }
 
 /* Decode Hamming (16,11,4). */
@@ -240,61 +298,44 @@ bool Hamming::decode16114(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    bool c1 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-    bool c2 = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-    bool c3 = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-    bool c4 = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
-
-    // Compare these with the actual bits
-    unsigned char n = 0x00U;
-    n |= (c0 != d[11]) ? 0x01U : 0x00U;
-    n |= (c1 != d[12]) ? 0x02U : 0x00U;
-    n |= (c2 != d[13]) ? 0x04U : 0x00U;
-    n |= (c3 != d[14]) ? 0x08U : 0x00U;
-    n |= (c4 != d[15]) ? 0x10U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[11] = !d[11]; return true;
-        case 0x02U: d[12] = !d[12]; return true;
-        case 0x04U: d[13] = !d[13]; return true;
-        case 0x08U: d[14] = !d[14]; return true;
-        case 0x10U: d[15] = !d[15]; return true;
-
-        // Data bit errors
-        case 0x19U: d[0] = !d[0];  return true;
-        case 0x0BU: d[1] = !d[1];  return true;
-        case 0x1FU: d[2] = !d[2];  return true;
-        case 0x07U: d[3] = !d[3];  return true;
-        case 0x0EU: d[4] = !d[4];  return true;
-        case 0x15U: d[5] = !d[5];  return true;
-        case 0x1AU: d[6] = !d[6];  return true;
-        case 0x0DU: d[7] = !d[7];  return true;
-        case 0x13U: d[8] = !d[8];  return true;
-        case 0x16U: d[9] = !d[9];  return true;
-        case 0x1CU: d[10] = !d[10]; return true;
-
-        // No bit errors
-        case 0x00U: return true;
-
-        // Unrecoverable errors
-        default: return false;
-    }
+    uint16_t code = packBits<16U>(d);
+    uint16_t orig = code;
+    bool valid = decode16114(code);
+    if (code != orig)
+        unpackBits<16U>(code, d);
+
+    return valid;
 }
 
-/* Encode Hamming (10,6,3). */
+/* Encode Hamming (16,11,4). */
 
 void Hamming::encode16114(bool* d)
 {
     assert(d != nullptr);
 
-    d[11] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[5] ^ d[7] ^ d[8];
-    d[12] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[6] ^ d[8] ^ d[9];
-    d[13] = d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[7] ^ d[9] ^ d[10];
-    d[14] = d[0] ^ d[1] ^ d[2] ^ d[4] ^ d[6] ^ d[7] ^ d[10];
-    d[15] = d[0] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[9] ^ d[10];
+    uint16_t code = packBits<16U>(d);
+    encode16114(code);
+    unpackBits<16U>(code, d, 11U);
+}
+
+/* Decode Hamming (16,11,4) packed codeword. */
+
+bool Hamming::decode16114(uint16_t& code)
+{
+    uint32_t syndrome = HAMMING_16114.syndrome(code);
+    if (syndrome == 0U)
+        return true;
+
+    uint32_t error = HAMMING_16114.error[syndrome];
+    code ^= error;
+    return error != 0U;
+}
+
+/* Encode Hamming (16,11,4) packed codeword. */
+
+void Hamming::encode16114(uint16_t& code)
+{
+    code = HAMMING_16114.encode(code);
 }
 
 /* Decode Hamming (17,12,3). */
@@ -303,49 +344,13 @@ bool Hamming::decode17123(bool* d)
 {
     assert(d != nullptr);
 
-    // Calculate the checksum this column should have
-    bool c0 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
-    bool c1 = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
-    bool c2 = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
-    bool c3 = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
-    bool c4 = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
-
-    // Compare these with the actual bits
-    unsigned char n = 0x00U;
-    n |= (c0 != d[12]) ? 0x01U : 0x00U;
-    n |= (c1 != d[13]) ? 0x02U : 0x00U;
-    n |= (c2 != d[14]) ? 0x04U : 0x00U;
-    n |= (c3 != d[15]) ? 0x08U : 0x00U;
-    n |= (c4 != d[16]) ? 0x10U : 0x00U;
-
-    switch (n) {
-        // Parity bit errors
-        case 0x01U: d[12] = !d[12]; return true;
-        case 0x02U: d[13] = !d[13]; return true;
-        case 0x04U: d[14] = !d[14]; return true;
-        case 0x08U: d[15] = !d[15]; return true;
-        case 0x10U: d[16] = !d[16]; return true;
-
-        // Data bit errors
-        case 0x1BU: d[0] = !d[0];  return true;
-        case 0x1FU: d[1] = !d[1];  return true;
-        case 0x17U: d[2] = !d[2];  return true;
-        case 0x07U: d[3] = !d[3];  return true;
-        case 0x0EU: d[4] = !d[4];  return true;
-        case 0x1CU: d[5] = !d[5];  return true;
-        case 0x11U: d[6] = !d[6];  return true;
-        case 0x0BU: d[7] = !d[7];  return true;
-        case 0x16U: d[8] = !d[8];  return true;
-        case 0x05U: d[9] = !d[9];  return true;
-        case 0x0AU: d[10] = !d[10]; return true;
-        case 0x14U: d[11] = !d[11]; return true;
-
-        // No bit errors
-        case 0x00U: return true;
-
-        // Unrecoverable errors
-        default: return false;
-    }
+    uint32_t code = packBits<17U>(d);
+    uint32_t orig = code;
+    bool valid = decode17123(code);
+    if (code != orig)
+        unpackBits<17U>(code, d);
+
+    return valid;
 }
 
 /* Encode Hamming (17,12,3). */
@@ -354,9 +359,27 @@ void Hamming::encode17123(bool* d)
 {
     assert(d != nullptr);
 
-    d[12] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[6] ^ d[7] ^ d[9];
-    d[13] = d[0] ^ d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[7] ^ d[8] ^ d[10];
-    d[14] = d[1] ^ d[2] ^ d[3] ^ d[4] ^ d[5] ^ d[8] ^ d[9] ^ d[11];
-    d[15] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
-    d[16] = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
+    uint32_t code = packBits<17U>(d);
+    encode17123(code);
+    unpackBits<17U>(code, d, 12U);
+}
+
+/* Decode Hamming (17,12,3) packed codeword. */
+
+bool Hamming::decode17123(uint32_t& code)
+{
+    uint32_t syndrome = HAMMING_17123.syndrome(code);
+    if (syndrome == 0U)
+        return true;
+
+    uint32_t error = HAMMING_17123.error[syndrome];
+    code ^= error;
+    return error != 0U;
+}
+
+/* Encode Hamming (17,12,3) packed codeword. */
+
+void Hamming::encode17123(uint32_t& code)
+{
+    code = HAMMING_17123.encode(code);
 }
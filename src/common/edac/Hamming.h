@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015,2016 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -27,6 +28,8 @@ namespace edac
     /**
      * @brief Implements Hamming (15,11,3), (13,9,3), (10,6,3), (16,11,4) and
      *  (17, 12, 3) forward error correction.
+     *  Each code is implemented on packed codewords using parity and syndrome lookup tables;
+     *  the boolean bit array variants are adapters over the packed implementation.
      * @ingroup edac
      */
     class HOST_SW_API Hamming {
@@ -42,6 +45,17 @@ namespace edac
          * @param d Boolean bit array.
          */
         static void encode15113_1(bool* d);
+        /**
+         * @brief Decode Hamming (15,11,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 14 and the 4 parity bits are the low bits.
+         * @returns bool True, if bit errors are detected, otherwise false.
+         */
+        static bool decode15113_1(uint16_t& code);
+        /**
+         * @brief Encode Hamming (15,11,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 14 and the 4 parity bits are the low bits.
+         */
+        static void encode15113_1(uint16_t& code);
 
         /**
          * @brief Decode Hamming (15,11,3).
@@ -54,6 +68,17 @@ namespace edac
          * @param d Boolean bit array.
          */
         static void encode15113_2(bool* d);
+        /**
+         * @brief Decode Hamming (15,11,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 14 and the 4 parity bits are the low bits.
+         * @returns bool True, if bit errors are detected, otherwise false.
+         */
+        static bool decode15113_2(uint16_t& code);
+        /**
+         * @brief Encode Hamming (15,11,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 14 and the 4 parity bits are the low bits.
+         */
+        static void encode15113_2(uint16_t& code);
 
         /**
          * @brief Decode Hamming (13,9,3).
@@ -66,6 +91,17 @@ namespace edac
          * @param d Boolean bit array.
          */
         static void encode1393(bool* d);
+        /**
+         * @brief Decode Hamming (13,9,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 12 and the 4 parity bits are the low bits.
+         * @returns bool True, if bit errors are detected, otherwise false.
+         */
+        static bool decode1393(uint16_t& code);
+        /**
+         * @brief Encode Hamming (13,9,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 12 and the 4 parity bits are the low bits.
+         */
+        static void encode1393(uint16_t& code);
 
         /**
          * @brief Decode Hamming (10,6,3).
@@ -78,6 +114,17 @@ namespace edac
          * @param d Boolean bit array.
          */
         static void encode1063(bool* d);
+        /**
+         * @brief Decode Hamming (10,6,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 9 and the 4 parity bits are the low bits.
+         * @returns bool True, if bit errors are detected, otherwise false.
+         */
+        static bool decode1063(uint16_t& code);
+        /**
+         * @brief Encode Hamming (10,6,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 9 and the 4 parity bits are the low bits.
+         */
+        static void encode1063(uint16_t& code);
 
         /**
          * @brief Decode Hamming (16,11,4).
@@ -90,6 +137,17 @@ namespace edac
          * @param d Boolean bit array.
          */
         static void encode16114(bool* d);
+        /**
+         * @brief Decode Hamming (16,11,4) packed codeword.
+         * @param code Packed codeword; d[0] is bit 15 and the 5 parity bits are the low bits.
+         * @returns bool True, if bit errors are detected, otherwise false.
+         */
+        static bool decode16114(uint16_t& code);
+        /**
+         * @brief Encode Hamming (16,11,4) packed codeword.
+         * @param code Packed codeword; d[0] is bit 15 and the 5 parity bits are the low bits.
+         */
+        static void encode16114(uint16_t& code);
 
         /**
          * @brief Decode Hamming (17,12,3).
@@ -102,6 +160,17 @@ namespace edac
          * @param d Boolean bit array.
          */
         static void encode17123(bool* d);
+        /**
+         * @brief Decode Hamming (17,12,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 16 and the 5 parity bits are the low bits.
+         * @returns bool True, if bit errors are detected, otherwise false.
+         */
+        static bool decode17123(uint32_t& code);
+        /**
+         * @brief Encode Hamming (17,12,3) packed codeword.
+         * @param code Packed codeword; d[0] is bit 16 and the 5 parity bits are the low bits.
+         */
+        static void encode17123(uint32_t& code);
     };
 } // namespace edac
 
@@ -5,19 +5,17 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016 Jonathan Naylor, G4KLX
- *  Copyright (C) 2017,2023 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2017,2023,2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
 #include "edac/RS634717.h"
-#include "edac/rs/RS.h"
 #include "Log.h"
 #include "Utils.h"
 
 using namespace edac;
 
 #include <cassert>
-#include <vector>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -77,57 +75,280 @@ const uint8_t ENCODE_MATRIX_362017[20U][36U] = {
     { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 002, 001, 053, 074, 002, 014, 052, 074, 012, 057, 024, 063, 015, 042, 052, 033 },
     { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 034, 035, 002, 023, 021, 027, 022, 033, 064, 042, 005, 073, 051, 046, 073, 060 } };
 
-/**
- * @brief Define a reed-solomon codec.
- * @param TYPE Data type primitive
- * @param SYMBOLS Total number of symbols; must be a power of 2 minus 1, eg 2^8-1 == 255
- * @param PAYLOAD The maximum number of non-parity symbols, eg 253 ==> 2 parity symbols
- * @param POLY A primitive polynomial appropriate to the SYMBOLS size
- * @param FCR The first consecutive root of the Reed-Solomon generator polynomial
- * @param PRIM The primitive root of the generator polynomial
- */
-#define __RS(TYPE, SYMBOLS, PAYLOAD, POLY, FCR, PRIM)                           \
-            edac::rs::reed_solomon<TYPE,                                        \
-            edac::rs::log_<(SYMBOLS) + 1>::value,                               \
-            (SYMBOLS) - (PAYLOAD), FCR, PRIM,                                   \
-            edac::rs::gfpoly<edac::rs::log_<(SYMBOLS) + 1>::value, POLY>>
-
-/**
- * @brief Define a 63-symbol reed-solomon codec.
- * @param PAYLOAD The maximum number of non-parity symbols, eg 253 ==> 2 parity symbols
- */
-#define __RS_63(PAYLOAD) __RS(uint8_t, 63, PAYLOAD, 0x43, 1, 1)
+/* Number of symbols in the full (unshortened) GF(2^6) Reed-Solomon code. */
+#define RS63_NN 63U
+/* Log of zero (index form). */
+#define RS63_A0 63U
 
 // ---------------------------------------------------------------------------
-//  Global Variables
+//  Structure Declaration
 // ---------------------------------------------------------------------------
 
 /**
- * @brief Implements Reed-Solomon (63,47,17)
+ * @brief GF(2 ^ 6) lookup tables (primitive polynomial : x ^ 6 + x + 1), generated at compile time.
  */
-class RS6347 : public __RS_63(47) {
-public:
-    RS6347() : __RS_63(47)() { /* stub */ }
-};
-RS6347 rs634717;    // 16 bit / 8 bit corrections max / 5 bytes total
+struct GF64Tables {
+    uint8_t alpha[64U];                                     //! Antilog (index form to polynomial form); alpha[A0] = 0.
+    uint8_t index[64U];                                     //! Log (polynomial form to index form); index[0] = A0.
+    uint8_t mult[64U][64U];                                 //! Product of two field elements.
+
+    /**
+     * @brief Initializes a new instance of the GF64Tables struct.
+     */
+    constexpr GF64Tables() : alpha(), index(), mult()
+    {
+        uint32_t sr = 1U;
+        for (uint32_t i = 0U; i < RS63_NN; i++) {
+            alpha[i] = (uint8_t)sr;
+            index[sr] = (uint8_t)i;
+
+            sr <<= 1;
+            if ((sr & 0x40U) == 0x40U)
+                sr ^= 0x43U;
+        }
 
-/**
- * @brief Implements Reed-Solomon (24,12,13)
- */
-class RS6351 : public __RS_63(51) {
-public:
-    RS6351() : __RS_63(51)() { /* stub */ }
+        alpha[RS63_A0] = 0U;
+        index[0U] = RS63_A0;
+
+        for (uint32_t a = 1U; a < 64U; a++) {
+            for (uint32_t b = 1U; b < 64U; b++)
+                mult[a][b] = alpha[(index[a] + index[b]) % RS63_NN];
+        }
+    }
 };
-RS6351 rs241213;    // 12 bit / 6 bit corrections max / 3 bytes total
+
+constexpr GF64Tables GF64 = GF64Tables();
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
 
 /**
- * @brief Implements Reed-Solomon (24,16,9)
+ * @brief Implements a decoder for a Reed-Solomon code shortened from the GF(2 ^ 6) (63,*) code
+ *  (first consecutive root 1, primitive element 1). The code is fixed at compile time, the
+ *  working state lives on the stack, and the syndromes only cover the symbols of the shortened
+ *  codeword.
+ * @tparam N Number of symbols in the shortened codeword.
+ * @tparam K Number of data symbols.
  */
-class RS6355 : public __RS_63(55) {
+template <uint32_t N, uint32_t K>
+class RS63Decoder {
 public:
-    RS6355() : __RS_63(55)() { /* stub */ }
+    static constexpr uint32_t NROOTS = N - K;
+    static constexpr uint32_t PAD = RS63_NN - N;
+
+    /**
+     * @brief Decodes (corrects in place) a shortened codeword.
+     * @param codeword Codeword symbols (N symbols, data first).
+     * @returns int Number of corrected symbols, or -1 if the codeword is uncorrectable (in which
+     *  case the codeword is left untouched).
+     */
+    static int decode(uint8_t* codeword)
+    {
+        // form the syndromes; i.e., evaluate codeword(x) at roots of g(x)
+        uint8_t syn[NROOTS];
+        for (uint32_t i = 0U; i < NROOTS; i++)
+            syn[i] = codeword[0U];
+
+        for (uint32_t j = 1U; j < N; j++) {
+            for (uint32_t i = 0U; i < NROOTS; i++)
+                syn[i] = codeword[j] ^ GF64.mult[syn[i]][GF64.alpha[i + 1U]];
+        }
+
+        // convert syndromes to index form, checking for nonzero condition
+        uint8_t synError = 0U;
+        for (uint32_t i = 0U; i < NROOTS; i++) {
+            synError |= syn[i];
+            syn[i] = GF64.index[syn[i]];
+        }
+
+        // if syndrome is zero, the codeword is valid and there are no errors to correct
+        if (synError == 0U)
+            return 0;
+
+        // Berlekamp-Massey algorithm to determine the error locator polynomial
+        uint8_t lambda[NROOTS + 1U], b[NROOTS + 1U], t[NROOTS + 1U];
+        ::memset(lambda, 0x00U, sizeof(lambda));
+        lambda[0U] = 1U;
+
+        for (uint32_t i = 0U; i < NROOTS + 1U; i++)
+            b[i] = GF64.index[lambda[i]];
+
+        uint32_t el = 0U;
+        for (uint32_t r = 1U; r <= NROOTS; r++) {
+            // compute discrepancy at the r-th step in poly-form
+            uint8_t discr = 0U;
+            for (uint32_t i = 0U; i < r; i++) {
+                if ((lambda[i] != 0U) && (syn[r - i - 1U] != RS63_A0))
+                    discr ^= GF64.alpha[(GF64.index[lambda[i]] + syn[r - i - 1U]) % RS63_NN];
+            }
+
+            discr = GF64.index[discr];
+            if (discr == RS63_A0) {
+                // B(x) <-- x*B(x)
+                ::memmove(b + 1U, b, NROOTS);
+                b[0U] = RS63_A0;
+                continue;
+            }
+
+            // T(x) <-- lambda(x)-discr*x*b(x)
+            t[0U] = lambda[0U];
+            for (uint32_t i = 0U; i < NROOTS; i++) {
+                if (b[i] != RS63_A0)
+                    t[i + 1U] = lambda[i + 1U] ^ GF64.alpha[(discr + b[i]) % RS63_NN];
+                else
+                    t[i + 1U] = lambda[i + 1U];
+            }
+
+            if (2U * el <= r - 1U) {
+                el = r - el;
+
+                // B(x) <-- inv(discr) * lambda(x)
+                for (uint32_t i = 0U; i <= NROOTS; i++)
+                    b[i] = (lambda[i] == 0U) ? RS63_A0 : (uint8_t)((GF64.index[lambda[i]] - discr + RS63_NN) % RS63_NN);
+            }
+            else {
+                // B(x) <-- x*B(x)
+                ::memmove(b + 1U, b, NROOTS);
+                b[0U] = RS63_A0;
+            }
+
+            ::memcpy(lambda, t, sizeof(lambda));
+        }
+
+        // convert lambda to index form and compute deg(lambda(x))
+        uint32_t degLambda = 0U;
+        for (uint32_t i = 0U; i < NROOTS + 1U; i++) {
+            lambda[i] = GF64.index[lambda[i]];
+            if (lambda[i] != RS63_A0)
+                degLambda = i;
+        }
+
+        // find roots of the error locator polynomial by Chien search; only the symbol positions of
+        // the shortened codeword are searched, an error located in the padding is uncorrectable
+        uint8_t reg[NROOTS + 1U];
+        for (uint32_t j = 1U; j <= degLambda; j++)
+            reg[j] = (lambda[j] == RS63_A0) ? RS63_A0 : (uint8_t)((lambda[j] + j * PAD) % RS63_NN);
+
+        uint32_t root[NROOTS], loc[NROOTS];
+        uint32_t count = 0U;
+        for (uint32_t i = PAD + 1U; i <= RS63_NN; i++) {
+            uint8_t q = 1U; // lambda[0] is always 0
+            for (uint32_t j = degLambda; j > 0U; j--) {
+                if (reg[j] != RS63_A0) {
+                    reg[j] = (uint8_t)((reg[j] + j) % RS63_NN);
+                    q ^= GF64.alpha[reg[j]];
+                }
+            }
+
+            if (q != 0U)
+                continue; // not a root
+
+            root[count] = i;
+            loc[count] = i - 1U - PAD;
+
+            // if we've already found max possible roots, abort the search to save time
+            if (++count == degLambda)
+                break;
+        }
+
+        // deg(lambda) unequal to number of roots => uncorrectable error detected
+        if (degLambda != count)
+            return -1;
+
+        // compute error evaluator poly omega(x) = s(x)*lambda(x) (modulo x**NROOTS), in index form
+        // (deg(omega) is deg(lambda) - 1)
+        uint8_t omega[NROOTS + 1U];
+        for (uint32_t i = 0U; i < degLambda; i++) {
+            uint8_t tmp = 0U;
+            for (uint32_t j = 0U; j <= i; j++) {
+                if ((syn[i - j] != RS63_A0) && (lambda[j] != RS63_A0))
+                    tmp ^= GF64.alpha[(syn[i - j] + lambda[j]) % RS63_NN];
+            }
+
+            omega[i] = GF64.index[tmp];
+        }
+
+        // compute error values in poly-form (Forney); num1 = omega(inv(X(l))), num2 = inv(X(l))**(fcr-1)
+        // and den = lambda_pr(inv(X(l)))
+        for (uint32_t j = 0U; j < count; j++) {
+            uint8_t num1 = 0U;
+            for (uint32_t i = degLambda; i > 0U; i--) {
+                if (omega[i - 1U] != RS63_A0)
+                    num1 ^= GF64.alpha[(omega[i - 1U] + (i - 1U) * root[j]) % RS63_NN];
+            }
+
+            if (num1 == 0U)
+                continue;
+
+            uint8_t den = 0U;
+
+            // lambda[i+1] for i even is the formal derivative lambda_pr of lambda[i]
+            uint32_t start = ((degLambda < NROOTS - 1U) ? degLambda : NROOTS - 1U) & ~1U;
+            for (uint32_t i = start + 2U; i > 0U; i -= 2U) {
+                if (lambda[i - 1U] != RS63_A0)
+                    den ^= GF64.alpha[(lambda[i - 1U] + (i - 2U) * root[j]) % RS63_NN];
+            }
+
+            // num2 is always 1, as the first consecutive root is 1
+            codeword[loc[j]] ^= GF64.alpha[(GF64.index[num1] + RS63_NN - GF64.index[den]) % RS63_NN];
+        }
+
+        return (int)count;
+    }
 };
-RS6355 rs24169;     // 8 bit / 4 bit corrections max / 2 bytes total
+
+typedef RS63Decoder<24U, 12U> RS241213;                    // 12 bit / 6 bit corrections max / 3 bytes total
+typedef RS63Decoder<24U, 16U> RS24169;                     // 8 bit / 4 bit corrections max / 2 bytes total
+typedef RS63Decoder<36U, 20U> RS362017;                    // 16 bit / 8 bit corrections max / 5 bytes total
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to unpack hexbits (6-bit symbols, MSB first) from a byte buffer; 4 symbols at a time. */
+
+static inline void unpackHexbits(const uint8_t* in, uint8_t* symbols, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i += 4U, in += 3U) {
+        uint32_t word = (uint32_t(in[0U]) << 16) | (uint32_t(in[1U]) << 8) | uint32_t(in[2U]);
+        symbols[i + 0U] = (word >> 18) & 0x3FU;
+        symbols[i + 1U] = (word >> 12) & 0x3FU;
+        symbols[i + 2U] = (word >> 6) & 0x3FU;
+        symbols[i + 3U] = word & 0x3FU;
+    }
+}
+
+/* Helper to pack hexbits (6-bit symbols, MSB first) into a byte buffer; 4 symbols at a time. */
+
+static inline void packHexbits(const uint8_t* symbols, uint8_t* out, uint32_t count)
+{
+    for (uint32_t i = 0U; i < count; i += 4U, out += 3U) {
+        uint32_t word = (uint32_t(symbols[i + 0U]) << 18) | (uint32_t(symbols[i + 1U]) << 12) |
+            (uint32_t(symbols[i + 2U]) << 6) | uint32_t(symbols[i + 3U]);
+        out[0U] = (uint8_t)(word >> 16);
+        out[1U] = (uint8_t)(word >> 8);
+        out[2U] = (uint8_t)word;
+    }
+}
+
+/* Helper to encode a Reed-Solomon codeword with the given generator matrix. */
+
+template <uint32_t N, uint32_t K>
+static void encodeMatrix(uint8_t* data, const uint8_t (&matrix)[K][N])
+{
+    uint8_t hexbits[K];
+    unpackHexbits(data, hexbits, K);
+
+    uint8_t codeword[N];
+    for (uint32_t i = 0U; i < N; i++) {
+        codeword[i] = 0x00U;
+        for (uint32_t j = 0U; j < K; j++)
+            codeword[i] ^= GF64.mult[hexbits[j]][matrix[j][i]];
+    }
+
+    packHexbits(codeword, data, N);
+}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -147,19 +368,15 @@ bool RS634717::decode241213(uint8_t* data)
 {
     assert(data != nullptr);
 
-    std::vector<uint8_t> codeword(63, 0);
-
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 24U; i++, offset += 6)
-        codeword[39 + i] = Utils::bin2Hex(data, offset);
+    uint8_t codeword[24U];
+    unpackHexbits(data, codeword, 24U);
 
-    int ec = rs241213.decode(codeword);
+    int ec = RS241213::decode(codeword);
 #if DEBUG_RS
     LogDebugEx(LOG_HOST, "RS634717::decode241213()", "errors = %d", ec);
 #endif
-    offset = 0U;
-    for (uint32_t i = 0U; i < 12U; i++, offset += 6)
-        Utils::hex2Bin(codeword[39 + i], data, offset);
+    if (ec > 0)
+        packHexbits(codeword, data, 12U);
 
     if ((ec == -1) || (ec >= 6)) {
         return false;
@@ -173,22 +390,7 @@ bool RS634717::decode241213(uint8_t* data)
 void RS634717::encode241213(uint8_t* data)
 {
     assert(data != nullptr);
-
-    uint8_t codeword[24U];
-
-    for (uint32_t i = 0U; i < 24U; i++) {
-        codeword[i] = 0x00U;
-
-        uint32_t offset = 0U;
-        for (uint32_t j = 0U; j < 12U; j++, offset += 6U) {
-            uint8_t hexbit = Utils::bin2Hex(data, offset);
-            codeword[i] ^= gf6Mult(hexbit, ENCODE_MATRIX[j][i]);
-        }
-    }
-
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 24U; i++, offset += 6U)
-        Utils::hex2Bin(codeword[i], data, offset);
+    encodeMatrix<24U, 12U>(data, ENCODE_MATRIX);
 }
 
 /* Decode RS (24,16,9) FEC. */
@@ -197,19 +399,15 @@ bool RS634717::decode24169(uint8_t* data)
 {
     assert(data != nullptr);
 
-    std::vector<uint8_t> codeword(63, 0);
-
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 24U; i++, offset += 6)
-        codeword[39 + i] = Utils::bin2Hex(data, offset);
+    uint8_t codeword[24U];
+    unpackHexbits(data, codeword, 24U);
 
-    int ec = rs24169.decode(codeword);
+    int ec = RS24169::decode(codeword);
 #if DEBUG_RS
     LogDebugEx(LOG_HOST, "RS634717::decode24169()", "errors = %d\n", ec);
 #endif
-    offset = 0U;
-    for (uint32_t i = 0U; i < 16U; i++, offset += 6)
-        Utils::hex2Bin(codeword[39 + i], data, offset);
+    if (ec > 0)
+        packHexbits(codeword, data, 16U);
 
     if ((ec == -1) || (ec >= 4)) {
         return false;
@@ -223,22 +421,7 @@ bool RS634717::decode24169(uint8_t* data)
 void RS634717::encode24169(uint8_t* data)
 {
     assert(data != nullptr);
-
-    uint8_t codeword[24U];
-
-    for (uint32_t i = 0U; i < 24U; i++) {
-        codeword[i] = 0x00U;
-
-        uint32_t offset = 0U;
-        for (uint32_t j = 0U; j < 16U; j++, offset += 6U) {
-            uint8_t hexbit = Utils::bin2Hex(data, offset);
-            codeword[i] ^= gf6Mult(hexbit, ENCODE_MATRIX_24169[j][i]);
-        }
-    }
-
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 24U; i++, offset += 6U)
-        Utils::hex2Bin(codeword[i], data, offset);
+    encodeMatrix<24U, 16U>(data, ENCODE_MATRIX_24169);
 }
 
 /* Decode RS (36,20,17) FEC. */
@@ -247,19 +430,15 @@ bool RS634717::decode362017(uint8_t* data)
 {
     assert(data != nullptr);
 
-    std::vector<uint8_t> codeword(63, 0);
-
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 36U; i++, offset += 6)
-        codeword[27 + i] = Utils::bin2Hex(data, offset);
+    uint8_t codeword[36U];
+    unpackHexbits(data, codeword, 36U);
 
-    int ec = rs634717.decode(codeword);
+    int ec = RS362017::decode(codeword);
 #if DEBUG_RS
     LogDebugEx(LOG_HOST, "RS634717::decode362017()", "errors = %d\n", ec);
 #endif
-    offset = 0U;
-    for (uint32_t i = 0U; i < 20U; i++, offset += 6)
-        Utils::hex2Bin(codeword[27 + i], data, offset);
+    if (ec > 0)
+        packHexbits(codeword, data, 20U);
 
     if ((ec == -1) || (ec >= 8)) {
         return false;
@@ -273,45 +452,5 @@ bool RS634717::decode362017(uint8_t* data)
 void RS634717::encode362017(uint8_t* data)
 {
     assert(data != nullptr);
-
-    uint8_t codeword[36U];
-
-    for (uint32_t i = 0U; i < 36U; i++) {
-        codeword[i] = 0x00U;
-
-        uint32_t offset = 0U;
-        for (uint32_t j = 0U; j < 20U; j++, offset += 6U) {
-            uint8_t hexbit = Utils::bin2Hex(data, offset);
-            codeword[i] ^= gf6Mult(hexbit, ENCODE_MATRIX_362017[j][i]);
-        }
-    }
-
-    uint32_t offset = 0U;
-    for (uint32_t i = 0U; i < 36U; i++, offset += 6U)
-        Utils::hex2Bin(codeword[i], data, offset);
-}
-
-// ---------------------------------------------------------------------------
-//  Private Class Members
-// ---------------------------------------------------------------------------
-
-/* GF(2 ^ 6) multiply (for Reed-Solomon encoder). */
-
-uint8_t RS634717::gf6Mult(uint8_t a, uint8_t b) const
-{
-    uint8_t p = 0x00U;
-
-    for (uint32_t i = 0U; i < 6U; i++) {
-        if ((b & 0x01U) == 0x01U)
-            p ^= a;
-
-        a <<= 1;
-
-        if ((a & 0x40U) == 0x40U)
-            a ^= 0x43U;            // primitive polynomial : x ^ 6 + x + 1
-
-        b >>= 1;
-    }
-
-    return p;
+    encodeMatrix<36U, 20U>(data, ENCODE_MATRIX_362017);
 }
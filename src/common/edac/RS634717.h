@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016 Jonathan Naylor, G4KLX
- *  Copyright (C) 2017,2023 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2017,2023,2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -29,6 +29,8 @@ namespace edac
      * @brief Implements Reed-Solomon (63,47,17). Which is also used to implement
      *  Reed-Solomon (24,12,13), (24,16,9) and (36,20,17) forward
      *  error correction.
+     *  Each code is decoded by a decoder specialized at compile time for its shortened
+     *  length; decoding does not allocate.
      * @ingroup edac
      */
     class HOST_SW_API RS634717 {
@@ -77,15 +79,6 @@ namespace edac
          * @param data Raw data to encode with Reed-Solomon FEC.
          */
         void encode362017(uint8_t* data);
-
-    private:
-        /**
-         * @brief GF(2 ^ 6) multiply (for Reed-Solomon encoder).
-         * @param a 
-         * @param b 
-         * @returns uint8_t 
-         */
-        uint8_t gf6Mult(uint8_t a, uint8_t b) const;
     };
 } // namespace edac
 
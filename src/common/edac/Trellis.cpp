@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016,2018 Jonathan Naylor, G4KLX
- *  Copyright (C) 2023-2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2023-2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
@@ -16,6 +16,15 @@
 using namespace edac;
 
 #include <cassert>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRELLIS_ACS_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define TRELLIS_ACS_NEON
+#include <arm_neon.h>
+#endif
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -27,7 +36,7 @@ const uint32_t INTERLEAVE_TABLE[] = {
     4U, 5U, 12U, 13U, 20U, 21U, 28U, 29U, 36U, 37U, 44U, 45U, 52U, 53U, 60U, 61U, 68U, 69U, 76U, 77U, 84U, 85U, 92U, 93U,
     6U, 7U, 14U, 15U, 22U, 23U, 30U, 31U, 38U, 39U, 46U, 47U, 54U, 55U, 62U, 63U, 70U, 71U, 78U, 79U, 86U, 87U, 94U, 95U };
 
-const uint8_t ENCODE_TABLE_34[] = {
+constexpr uint8_t ENCODE_TABLE_34[] = {
     0U,  8U, 4U, 12U, 2U, 10U, 6U, 14U,
     4U, 12U, 2U, 10U, 6U, 14U, 0U,  8U,
     1U,  9U, 5U, 13U, 3U, 11U, 7U, 15U,
@@ -37,12 +46,145 @@ const uint8_t ENCODE_TABLE_34[] = {
     2U, 10U, 6U, 14U, 0U,  8U, 4U, 12U,
     6U, 14U, 0U,  8U, 4U, 12U, 2U, 10U };
 
-const uint8_t ENCODE_TABLE_12[] = {
+constexpr uint8_t ENCODE_TABLE_12[] = {
     0U,  15U, 12U,  3U,
     4U,  11U,  8U,  7U,
     13U,  2U,  1U, 14U,
     9U,   6U,  5U, 10U };
 
+/* 4-bit hard decision (first dibit in the upper bits) of each constellation point. */
+constexpr uint8_t POINT_BITS[16U] = {
+    0x2U, 0xAU, 0x7U, 0xFU, 0xEU, 0x6U, 0xBU, 0x3U, 0xDU, 0x5U, 0x8U, 0x0U, 0x1U, 0x9U, 0x4U, 0xCU };
+
+/* Constellation point of each 4-bit hard decision (the inverse of POINT_BITS). */
+const uint8_t BITS_POINT[16U] = {
+    11U, 12U, 0U, 7U, 14U, 9U, 5U, 2U, 10U, 13U, 1U, 6U, 15U, 8U, 4U, 3U };
+
+/* Branch metric of a transition that does not exist (1/2 rate only uses 4 of the 8 lanes). */
+#define NO_BRANCH 0x3FFF
+/* Initial path metric of the states the encoder cannot start in. */
+#define NO_PATH 0x1000
+
+/* Most bit errors (of full confidence) along the decoded path before the block is treated as undecodable. */
+#define MAX_ERRORS_34 7U
+#define MAX_ERRORS_12 18U
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Hard decision branch metrics, generated at compile time. For each received 4-bit hard
+ *  decision, this holds the Hamming distance to the constellation point of every transition, laid
+ *  out as 8 lanes (next state) per current state.
+ */
+struct TrellisMetrics {
+    int16_t m34[16U][64U];
+    int16_t m12[16U][32U];
+
+    /**
+     * @brief Initializes a new instance of the TrellisMetrics struct.
+     */
+    constexpr TrellisMetrics() : m34(), m12()
+    {
+        for (uint32_t bits = 0U; bits < 16U; bits++) {
+            for (uint32_t i = 0U; i < 64U; i++)
+                m34[bits][i] = distance(bits, POINT_BITS[ENCODE_TABLE_34[i]]);
+
+            for (uint32_t state = 0U; state < 4U; state++) {
+                for (uint32_t next = 0U; next < 8U; next++)
+                    m12[bits][state * 8U + next] = (next < 4U) ? distance(bits, POINT_BITS[ENCODE_TABLE_12[state * 4U + next]]) : NO_BRANCH;
+            }
+        }
+    }
+
+    /**
+     * @brief Helper to count the differing bits of two 4-bit hard decisions.
+     * @param a Hard decision.
+     * @param b Hard decision.
+     * @returns int16_t Hamming distance.
+     */
+    static constexpr int16_t distance(uint32_t a, uint32_t b)
+    {
+        return (int16_t)(((a ^ b) & 1U) + (((a ^ b) >> 1) & 1U) + (((a ^ b) >> 2) & 1U) + (((a ^ b) >> 3) & 1U));
+    }
+};
+
+constexpr TrellisMetrics TRELLIS_METRICS = TrellisMetrics();
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to run the add-compare-select of a single Trellis step over all 8 lanes. */
+
+static inline void addCompareSelect(int16_t* pathMetrics, const int16_t* metrics, uint32_t states, uint8_t* survivors)
+{
+#if defined(TRELLIS_ACS_SSE2)
+    __m128i best = _mm_set1_epi16(INT16_MAX);
+    __m128i from = _mm_setzero_si128();
+    for (uint32_t state = 0U; state < states; state++) {
+        __m128i cand = _mm_adds_epi16(_mm_set1_epi16(pathMetrics[state]), _mm_loadu_si128((const __m128i*)(metrics + state * 8U)));
+        __m128i lower = _mm_cmplt_epi16(cand, best);
+        best = _mm_min_epi16(best, cand);
+        from = _mm_or_si128(_mm_and_si128(lower, _mm_set1_epi16((int16_t)state)), _mm_andnot_si128(lower, from));
+    }
+
+    // renormalize against the best path, so the metrics never saturate
+    __m128i min = _mm_min_epi16(best, _mm_shuffle_epi32(best, 0x4E));
+    min = _mm_min_epi16(min, _mm_shuffle_epi32(min, 0xB1));
+    min = _mm_min_epi16(min, _mm_shufflelo_epi16(min, 0xB1));
+    min = _mm_shuffle_epi32(_mm_shufflelo_epi16(min, 0x00), 0x00);
+
+    _mm_storeu_si128((__m128i*)pathMetrics, _mm_sub_epi16(best, min));
+    _mm_storel_epi64((__m128i*)survivors, _mm_packus_epi16(from, from));
+#elif defined(TRELLIS_ACS_NEON)
+    int16x8_t best = vdupq_n_s16(INT16_MAX);
+    uint16x8_t from = vdupq_n_u16(0U);
+    for (uint32_t state = 0U; state < states; state++) {
+        int16x8_t cand = vqaddq_s16(vdupq_n_s16(pathMetrics[state]), vld1q_s16(metrics + state * 8U));
+        uint16x8_t lower = vcltq_s16(cand, best);
+        best = vminq_s16(best, cand);
+        from = vbslq_u16(lower, vdupq_n_u16((uint16_t)state), from);
+    }
+
+    // renormalize against the best path, so the metrics never saturate
+    best = vsubq_s16(best, vdupq_n_s16(vminvq_s16(best)));
+
+    vst1q_s16(pathMetrics, best);
+    vst1_u8(survivors, vmovn_u16(from));
+#else
+    int16_t best[8U];
+    for (uint32_t next = 0U; next < 8U; next++) {
+        best[next] = INT16_MAX;
+        survivors[next] = 0U;
+    }
+
+    for (uint32_t state = 0U; state < states; state++) {
+        for (uint32_t next = 0U; next < 8U; next++) {
+            int32_t cand = pathMetrics[state] + metrics[state * 8U + next];
+            if (cand > INT16_MAX)
+                cand = INT16_MAX;
+
+            if (cand < best[next]) {
+                best[next] = (int16_t)cand;
+                survivors[next] = (uint8_t)state;
+            }
+        }
+    }
+
+    // renormalize against the best path, so the metrics never saturate
+    int16_t min = best[0U];
+    for (uint32_t next = 1U; next < 8U; next++) {
+        if (best[next] < min)
+            min = best[next];
+    }
+
+    for (uint32_t next = 0U; next < 8U; next++)
+        pathMetrics[next] = best[next] - min;
+#endif
+}
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -58,15 +200,23 @@ Trellis::~Trellis() = default;
 /* Decodes 3/4 rate Trellis. */
 
 bool Trellis::decode34(const uint8_t* data, uint8_t* payload, bool skipSymbols)
+{
+    return decode34(data, nullptr, payload, skipSymbols);
+}
+
+/* Decodes 3/4 rate Trellis, using soft decisions. */
+
+bool Trellis::decode34(const uint8_t* data, const uint8_t* confidence, uint8_t* payload, bool skipSymbols)
 {
     assert(data != nullptr);
     assert(payload != nullptr);
 
-    int8_t dibits[98U];
-    deinterleave(data, dibits, skipSymbols);
+    uint8_t bits[49U];
+    deinterleave(data, bits, skipSymbols);
 
     uint8_t points[49U];
-    dibitsToPoints(dibits, points);
+    for (uint32_t i = 0U; i < 49U; i++)
+        points[i] = BITS_POINT[bits[i]];
 
     // Check the original code
     uint8_t tribits[49U];
@@ -76,19 +226,42 @@ bool Trellis::decode34(const uint8_t* data, uint8_t* payload, bool skipSymbols)
         return true;
     }
 
-    uint8_t savePoints[49U];
-    for (uint32_t i = 0U; i < 49U; i++)
-        savePoints[i] = points[i];
+    const int16_t* metrics[49U];
+    int16_t soft[49U * 64U];
+    if (confidence != nullptr) {
+        uint8_t conf[196U];
+        deinterleaveConfidence(confidence, conf);
+        softMetrics(bits, conf, ENCODE_TABLE_34, 8U, soft);
 
-    bool ret = fixCode34(points, failPos, payload);
-    if (ret)
-        return true;
+        for (uint32_t i = 0U; i < 49U; i++)
+            metrics[i] = soft + i * 64U;
+    }
+    else {
+        for (uint32_t i = 0U; i < 49U; i++)
+            metrics[i] = TRELLIS_METRICS.m34[bits[i]];
+    }
+
+    viterbi(metrics, 8U, tribits);
+
+    // count the bit errors along the decoded path (weighted by confidence, for soft decisions)
+    uint32_t errors = 0U;
+    uint8_t state = 0U;
+    for (uint32_t i = 0U; i < 49U; i++) {
+        errors += metrics[i][state * 8U + tribits[i]];
+        state = tribits[i];
+    }
 
-    if (failPos == 0U)
+    if (confidence != nullptr)
+        errors /= 255U;
+
+#if DEBUG_TRELLIS
+    ::LogDebugEx(LOG_HOST, "Trellis::decode34()", "failPos = %u, errors = %u", failPos, errors);
+#endif
+    if (errors > MAX_ERRORS_34)
         return false;
 
-    // Backtrack one place for a last go
-    return fixCode34(savePoints, failPos - 1U, payload);
+    tribitsToBits(tribits, payload);
+    return true;
 }
 
 /* Encodes 3/4 rate Trellis. */
@@ -121,37 +294,68 @@ void Trellis::encode34(const uint8_t* payload, uint8_t* data, bool skipSymbols)
 /* Decodes 1/2 rate Trellis. */
 
 bool Trellis::decode12(const uint8_t* data, uint8_t* payload)
+{
+    return decode12(data, nullptr, payload);
+}
+
+/* Decodes 1/2 rate Trellis, using soft decisions. */
+
+bool Trellis::decode12(const uint8_t* data, const uint8_t* confidence, uint8_t* payload)
 {
     assert(data != nullptr);
     assert(payload != nullptr);
 
-    int8_t dibits[98U];
-    deinterleave(data, dibits);
+    uint8_t bits[49U];
+    deinterleave(data, bits);
 
     uint8_t points[49U];
-    dibitsToPoints(dibits, points);
+    for (uint32_t i = 0U; i < 49U; i++)
+        points[i] = BITS_POINT[bits[i]];
 
     // Check the original code
-    uint8_t bits[49U];
-    uint32_t failPos = checkCode12(points, bits);
+    uint8_t dibits[49U];
+    uint32_t failPos = checkCode12(points, dibits);
     if (failPos == 999U) {
-        dibitsToBits(bits, payload);
+        dibitsToBits(dibits, payload);
         return true;
     }
 
-    uint8_t savePoints[49U];
-    for (uint32_t i = 0U; i < 49U; i++)
-        savePoints[i] = points[i];
+    const int16_t* metrics[49U];
+    int16_t soft[49U * 32U];
+    if (confidence != nullptr) {
+        uint8_t conf[196U];
+        deinterleaveConfidence(confidence, conf);
+        softMetrics(bits, conf, ENCODE_TABLE_12, 4U, soft);
 
-    bool ret = fixCode12(points, failPos, payload);
-    if (ret)
-        return true;
+        for (uint32_t i = 0U; i < 49U; i++)
+            metrics[i] = soft + i * 32U;
+    }
+    else {
+        for (uint32_t i = 0U; i < 49U; i++)
+            metrics[i] = TRELLIS_METRICS.m12[bits[i]];
+    }
+
+    viterbi(metrics, 4U, dibits);
+
+    // count the bit errors along the decoded path (weighted by confidence, for soft decisions)
+    uint32_t errors = 0U;
+    uint8_t state = 0U;
+    for (uint32_t i = 0U; i < 49U; i++) {
+        errors += metrics[i][state * 8U + dibits[i]];
+        state = dibits[i];
+    }
 
-    if (failPos == 0U)
+    if (confidence != nullptr)
+        errors /= 255U;
+
+#if DEBUG_TRELLIS
+    ::LogDebugEx(LOG_HOST, "Trellis::decode12()", "failPos = %u, errors = %u", failPos, errors);
+#endif
+    if (errors > MAX_ERRORS_12)
         return false;
 
-    // Backtrack one place for a last go
-    return fixCode12(savePoints, failPos - 1U, payload);
+    dibitsToBits(dibits, payload);
+    return true;
 }
 
 /* Encodes 1/2 rate Trellis. */
@@ -185,31 +389,35 @@ void Trellis::encode12(const uint8_t* payload, uint8_t* data)
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* Helper to deinterleave the input symbols into dibits. */
+/* Helper to deinterleave the input symbols into the hard decision of each constellation point. */
 
-void Trellis::deinterleave(const uint8_t* data, int8_t* dibits, bool skipSymbols) const
+void Trellis::deinterleave(const uint8_t* data, uint8_t* bits, bool skipSymbols) const
 {
+    ::memset(bits, 0x00U, 49U);
+
     for (uint32_t i = 0U; i < 98U; i++) {
         uint32_t n = i * 2U + 0U;
         if (skipSymbols && n >= 98U) n += 68U;
-        bool b1 = READ_BIT(data, n) != 0x00U;
+        uint8_t b1 = READ_BIT(data, n) != 0x00U ? 1U : 0U;
 
         n = i * 2U + 1U;
         if (skipSymbols && n >= 98U) n += 68U;
-        bool b2 = READ_BIT(data, n) != 0x00U;
-
-        int8_t dibit;
-        if (!b1 && b2)
-            dibit = +3;
-        else if (!b1 && !b2)
-            dibit = +1;
-        else if (b1 && !b2)
-            dibit = -1;
-        else
-            dibit = -3;
+        uint8_t b2 = READ_BIT(data, n) != 0x00U ? 1U : 0U;
 
+        // the first dibit of each point lands in the upper bits
         n = INTERLEAVE_TABLE[i];
-        dibits[n] = dibit;
+        bits[n >> 1] |= ((b1 << 1) | b2) << ((n & 1U) ? 0U : 2U);
+    }
+}
+
+/* Helper to deinterleave the per-bit confidences into constellation point order. */
+
+void Trellis::deinterleaveConfidence(const uint8_t* confidence, uint8_t* out) const
+{
+    for (uint32_t i = 0U; i < 98U; i++) {
+        uint32_t n = INTERLEAVE_TABLE[i];
+        out[n * 2U + 0U] = confidence[i * 2U + 0U];
+        out[n * 2U + 1U] = confidence[i * 2U + 1U];
     }
 }
 
@@ -250,46 +458,6 @@ void Trellis::interleave(const int8_t* dibits, uint8_t* data, bool skipSymbols)
     }
 }
 
-/* Helper to map dibits to 4FSK constellation points. */
-
-void Trellis::dibitsToPoints(const int8_t* dibits, uint8_t* points) const
-{
-    for (uint32_t i = 0U; i < 49U; i++) {
-        if (dibits[i * 2U + 0U] == +1 && dibits[i * 2U + 1U] == -1)
-            points[i] = 0U;
-        else if (dibits[i * 2U + 0U] == -1 && dibits[i * 2U + 1U] == -1)
-            points[i] = 1U;
-        else if (dibits[i * 2U + 0U] == +3 && dibits[i * 2U + 1U] == -3)
-            points[i] = 2U;
-        else if (dibits[i * 2U + 0U] == -3 && dibits[i * 2U + 1U] == -3)
-            points[i] = 3U;
-        else if (dibits[i * 2U + 0U] == -3 && dibits[i * 2U + 1U] == -1)
-            points[i] = 4U;
-        else if (dibits[i * 2U + 0U] == +3 && dibits[i * 2U + 1U] == -1)
-            points[i] = 5U;
-        else if (dibits[i * 2U + 0U] == -1 && dibits[i * 2U + 1U] == -3)
-            points[i] = 6U;
-        else if (dibits[i * 2U + 0U] == +1 && dibits[i * 2U + 1U] == -3)
-            points[i] = 7U;
-        else if (dibits[i * 2U + 0U] == -3 && dibits[i * 2U + 1U] == +3)
-            points[i] = 8U;
-        else if (dibits[i * 2U + 0U] == +3 && dibits[i * 2U + 1U] == +3)
-            points[i] = 9U;
-        else if (dibits[i * 2U + 0U] == -1 && dibits[i * 2U + 1U] == +1)
-            points[i] = 10U;
-        else if (dibits[i * 2U + 0U] == +1 && dibits[i * 2U + 1U] == +1)
-            points[i] = 11U;
-        else if (dibits[i * 2U + 0U] == +1 && dibits[i * 2U + 1U] == +3)
-            points[i] = 12U;
-        else if (dibits[i * 2U + 0U] == -1 && dibits[i * 2U + 1U] == +3)
-            points[i] = 13U;
-        else if (dibits[i * 2U + 0U] == +3 && dibits[i * 2U + 1U] == +1)
-            points[i] = 14U;
-        else if (dibits[i * 2U + 0U] == -3 && dibits[i * 2U + 1U] == +1)
-            points[i] = 15U;
-    }
-}
-
 /* Helper to map 4FSK constellation points to dibits. */
 
 void Trellis::pointsToDibits(const uint8_t* points, int8_t* dibits) const
@@ -448,43 +616,6 @@ void Trellis::dibitsToBits(const uint8_t* dibits, uint8_t* payload) const
     }
 }
 
-/* Helper to fix errors in Trellis coding. */
-
-bool Trellis::fixCode34(uint8_t* points, uint32_t failPos, uint8_t* payload) const
-{
-#if DEBUG_TRELLIS
-    ::LogDebugEx(LOG_HOST, "Trellis::fixCode34()", "failPos = %u, val = %01X", failPos, points[failPos]);
-#endif
-    for (unsigned j = 0U; j < 20U; j++) {
-        uint32_t bestPos = 0U;
-        uint32_t bestVal = 0U;
-
-        for (uint32_t i = 0U; i < 16U; i++) {
-            points[failPos] = i;
-
-            uint8_t tribits[49U];
-            uint32_t pos = checkCode34(points, tribits);
-            if (pos == 999U) {
-#if DEBUG_TRELLIS
-                ::LogDebugEx(LOG_HOST, "Trellis::fixCode34()", "fixed, failPos = %u, pos = %u, val = %01X", failPos, bestPos, bestVal);
-#endif
-                tribitsToBits(tribits, payload);
-                return true;
-            }
-
-            if (pos > bestPos) {
-                bestPos = pos;
-                bestVal = i;
-            }
-        }
-
-        points[failPos] = bestVal;
-        failPos = bestPos;
-    }
-
-    return false;
-}
-
 /* Helper to detect errors in Trellis coding. */
 
 uint32_t Trellis::checkCode34(const uint8_t* points, uint8_t* tribits) const
@@ -514,43 +645,6 @@ uint32_t Trellis::checkCode34(const uint8_t* points, uint8_t* tribits) const
 }
 
 
-/* Helper to fix errors in Trellis coding. */
-
-bool Trellis::fixCode12(uint8_t* points, uint32_t failPos, uint8_t* payload) const
-{
-#if DEBUG_TRELLIS
-    ::LogDebugEx(LOG_HOST, "Trellis::fixCode12()", "failPos = %u, val = %01X", failPos, points[failPos]);
-#endif
-    for (unsigned j = 0U; j < 20U; j++) {
-        uint32_t bestPos = 0U;
-        uint32_t bestVal = 0U;
-
-        for (uint32_t i = 0U; i < 16U; i++) {
-            points[failPos] = i;
-
-            uint8_t dibits[49U];
-            uint32_t pos = checkCode12(points, dibits);
-            if (pos == 999U) {
-#if DEBUG_TRELLIS
-                ::LogDebugEx(LOG_HOST, "Trellis::fixCode12()", "fixed, failPos = %u, pos = %u, val = %01X", failPos, bestPos, bestVal);
-#endif
-                dibitsToBits(dibits, payload);
-                return true;
-            }
-
-            if (pos > bestPos) {
-                bestPos = pos;
-                bestVal = i;
-            }
-        }
-
-        points[failPos] = bestVal;
-        failPos = bestPos;
-    }
-
-    return false;
-}
-
 /* Helper to detect errors in Trellis coding. */
 
 uint32_t Trellis::checkCode12(const uint8_t* points, uint8_t* dibits) const
@@ -578,3 +672,48 @@ uint32_t Trellis::checkCode12(const uint8_t* points, uint8_t* dibits) const
 
     return 999U;
 }
+
+/* Helper to calculate the soft decision branch metrics of each Trellis step. */
+
+void Trellis::softMetrics(const uint8_t* bits, const uint8_t* confidence, const uint8_t* encodeTable, uint32_t states,
+    int16_t* metrics) const
+{
+    for (uint32_t i = 0U; i < 49U; i++) {
+        const uint8_t* conf = confidence + i * 4U;
+
+        // cost of every pattern of differing bits, from the confidence of each bit
+        int16_t cost[16U];
+        cost[0U] = 0;
+        for (uint32_t diff = 1U; diff < 16U; diff++) {
+            uint32_t low = (diff & 1U) ? 0U : ((diff & 2U) ? 1U : ((diff & 4U) ? 2U : 3U));
+            cost[diff] = cost[diff & (diff - 1U)] + conf[3U - low];
+        }
+
+        int16_t* out = metrics + i * states * 8U;
+        for (uint32_t state = 0U; state < states; state++) {
+            for (uint32_t next = 0U; next < 8U; next++) {
+                out[state * 8U + next] = (next < states) ? cost[bits[i] ^ POINT_BITS[encodeTable[state * states + next]]] : NO_BRANCH;
+            }
+        }
+    }
+}
+
+/* Helper to find the maximum likelihood path through the Trellis. */
+
+void Trellis::viterbi(const int16_t* const* metrics, uint32_t states, uint8_t* symbols) const
+{
+    // the encoder always starts in state 0
+    int16_t pathMetrics[8U] = { 0, NO_PATH, NO_PATH, NO_PATH, NO_PATH, NO_PATH, NO_PATH, NO_PATH };
+    uint8_t survivors[49U][8U];
+
+    for (uint32_t i = 0U; i < 49U; i++)
+        addCompareSelect(pathMetrics, metrics[i], states, survivors[i]);
+
+    // the last symbol is always 0, which also leaves the encoder in state 0; the state after each
+    // step is the symbol that was encoded
+    uint8_t state = 0U;
+    for (uint32_t i = 49U; i > 0U; i--) {
+        symbols[i - 1U] = state;
+        state = survivors[i - 1U][state];
+    }
+}
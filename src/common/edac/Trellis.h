@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016,2018 Jonathan Naylor, G4KLX
- *  Copyright (C) 2023-2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2023-2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -27,6 +27,9 @@ namespace edac
 
     /**
      * @brief Implements 1/2 rate and 3/4 rate Trellis for DMR/P25.
+     *  Decoding is maximum likelihood (Viterbi) over the 4-state (1/2 rate) or 8-state (3/4 rate)
+     *  trellis; branch metrics are the Hamming distance between the received dibits and each
+     *  constellation point, optionally weighted by per-bit confidences from the demodulator.
      * @ingroup edac
      */
     class HOST_SW_API Trellis {
@@ -48,6 +51,16 @@ namespace edac
          * @returns bool True, if Trellis decoded, otherwise false.
          */
         bool decode34(const uint8_t* data, uint8_t* payload, bool skipSymbols = false);
+        /**
+         * @brief Decodes 3/4 rate Trellis, using soft decisions.
+         * @param[in] data Trellis symbol bytes.
+         * @param[in] confidence Confidence (0 - 255) of each of the 196 Trellis bits, in the order they appear
+         *  in the symbol bytes (excluding any skipped symbols). If null, all bits are treated with equal confidence.
+         * @param[out] payload Output bytes.
+         * @param skipSymbols Flag indicating symbols should be skipped (this is used for DMR).
+         * @returns bool True, if Trellis decoded, otherwise false.
+         */
+        bool decode34(const uint8_t* data, const uint8_t* confidence, uint8_t* payload, bool skipSymbols = false);
         /**
          * @brief Encodes 3/4 rate Trellis.
          * @param[in] payload Input bytes.
@@ -63,6 +76,15 @@ namespace edac
          * @returns bool True, if Trellis decoded, otherwise false.
          */
         bool decode12(const uint8_t* data, uint8_t* payload);
+        /**
+         * @brief Decodes 1/2 rate Trellis, using soft decisions.
+         * @param[in] data Trellis symbol bytes.
+         * @param[in] confidence Confidence (0 - 255) of each of the 196 Trellis bits, in the order they appear
+         *  in the symbol bytes. If null, all bits are treated with equal confidence.
+         * @param[out] payload Output bytes.
+         * @returns bool True, if Trellis decoded, otherwise false.
+         */
+        bool decode12(const uint8_t* data, const uint8_t* confidence, uint8_t* payload);
         /**
          * @brief Encodes 1/2 rate Trellis.
          * @param[in] payload Input bytes.
@@ -72,12 +94,18 @@ namespace edac
 
     private:
         /**
-         * @brief Helper to deinterleave the input symbols into dibits.
+         * @brief Helper to deinterleave the input symbols into the hard decision of each constellation point.
          * @param[in] data Trellis symbol bytes.
-         * @param[out] dibits Dibits.
+         * @param[out] bits 4-bit hard decision (both dibits, first dibit in the upper bits) of each constellation point.
          * @param skipSymbols Flag indicating symbols should be skipped (this is used for DMR).
          */
-        void deinterleave(const uint8_t* in, int8_t* dibits, bool skipSymbols = false) const;
+        void deinterleave(const uint8_t* in, uint8_t* bits, bool skipSymbols = false) const;
+        /**
+         * @brief Helper to deinterleave the per-bit confidences into constellation point order.
+         * @param[in] confidence Confidence of each Trellis bit, in symbol order.
+         * @param[out] out Confidence of each Trellis bit, in constellation point order.
+         */
+        void deinterleaveConfidence(const uint8_t* confidence, uint8_t* out) const;
         /**
          * @brief Helper to interleave the input dibits into symbols.
          * @param[in] dibits Dibits.
@@ -85,12 +113,6 @@ namespace edac
          * @param skipSymbols Flag indicating symbols should be skipped (this is used for DMR).
          */
         void interleave(const int8_t* dibits, uint8_t* out, bool skipSymbols = false) const;
-        /**
-         * @brief Helper to map dibits to trellis constellation points.
-         * @param[in] dibits Dibits.
-         * @param[out] points Trellis constellation points.
-         */
-        void dibitsToPoints(const int8_t* dibits, uint8_t* points) const;
         /**
          * @brief Helper to map trellis constellation points to dibits.
          * @param[in] points Trellis Constellation points.
@@ -122,14 +144,6 @@ namespace edac
          */
         void dibitsToBits(const uint8_t* dibits, uint8_t* payload) const;
 
-        /**
-         * @brief Helper to fix errors in Trellis coding.
-         * @param points Trellis constellation points.
-         * @param failPos Failure position.
-         * @param payload Byte payload.
-         * @returns bool True, if error corrected, otherwise false.
-         */
-        bool fixCode34(uint8_t* points, uint32_t failPos, uint8_t* payload) const;
         /**
          * @brief Helper to detect errors in Trellis coding.
          * @param points Trellis constellation points.
@@ -138,14 +152,6 @@ namespace edac
          */
         uint32_t checkCode34(const uint8_t* points, uint8_t* tribits) const;
 
-        /**
-         * @brief Helper to fix errors in Trellis coding.
-         * @param points Trelli constellation points.
-         * @param failPos Failure position.
-         * @param payload Byte payload.
-         * @returns bool True, if error corrected, otherwise false.
-         */
-        bool fixCode12(uint8_t* points, uint32_t failPos, uint8_t* payload) const;
         /**
          * @brief Helper to detect errors in Trellis coding.
          * @param points Trelli constellation points.
@@ -153,6 +159,24 @@ namespace edac
          * @returns uint32_t Position.
          */
         uint32_t checkCode12(const uint8_t* points, uint8_t* dibits) const;
+
+        /**
+         * @brief Helper to calculate the soft decision branch metrics of each Trellis step.
+         * @param[in] bits 4-bit hard decision of each constellation point.
+         * @param[in] confidence Confidence of each Trellis bit, in constellation point order.
+         * @param[in] encodeTable Trellis encoder table.
+         * @param states Number of Trellis states.
+         * @param[out] metrics Branch metrics (8 entries per state, per step).
+         */
+        void softMetrics(const uint8_t* bits, const uint8_t* confidence, const uint8_t* encodeTable, uint32_t states,
+            int16_t* metrics) const;
+        /**
+         * @brief Helper to find the maximum likelihood path through the Trellis.
+         * @param[in] metrics Branch metrics of each Trellis step (8 entries per state).
+         * @param states Number of Trellis states.
+         * @param[out] symbols Decoded tribits/dibits.
+         */
+        void viterbi(const int16_t* const* metrics, uint32_t states, uint8_t* symbols) const;
     };
 } // namespace edac
 
@@ -43,6 +43,8 @@ AffiliationLookup::AffiliationLookup(const std::string name, ChannelLookup* chan
     m_netGrantedTable(),
     m_grantTimers(),
     m_releaseGrant(nullptr),
+    m_unitDereg(nullptr),
+    m_groupAffChange(nullptr),
     m_name(),
     m_chLookup(channelLookup),
     m_disableUnitRegTimeout(false),
@@ -196,6 +198,10 @@ void AffiliationLookup::groupAff(uint32_t srcId, uint32_t dstId)
             LogMessage(LOG_HOST, "%s, group affiliation, srcId = %u, dstId = %u",
                 m_name.c_str(), srcId, dstId);
         }
+
+        if (m_groupAffChange != nullptr) {
+            m_groupAffChange();
+        }
     }
 }
 
@@ -219,6 +225,11 @@ bool AffiliationLookup::groupUnaff(uint32_t srcId)
         uint32_t entry = m_grpAffTable.at(srcId); // this value will get discarded
         (void)entry;                              // but some variants of C++ mark the unordered_map<>::at as nodiscard
         m_grpAffTable.erase(srcId);
+
+        if (m_groupAffChange != nullptr) {
+            m_groupAffChange();
+        }
+
         return true;
     }
     catch (...) {
@@ -288,6 +299,10 @@ std::vector<uint32_t> AffiliationLookup::clearGroupAff(uint32_t dstId, bool rele
         m_grpAffTable.erase(srcId);
     }
 
+    if (!srcToRel.empty() && m_groupAffChange != nullptr) {
+        m_groupAffChange();
+    }
+
     return srcToRel;
 }
 
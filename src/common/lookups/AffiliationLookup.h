@@ -275,6 +275,12 @@ namespace lookups
          * @param callback Unit deregistration function callback.
          */
         void setUnitDeregCallback(std::function<void(uint32_t, bool)>&& callback) { m_unitDereg = callback; }
+        /**
+         * @brief Helper to set the group affiliation change callback.
+         *  (This is called whenever a group affiliation is added or removed.)
+         * @param callback Group affiliation change function callback.
+         */
+        void setGroupAffChangeCallback(std::function<void()>&& callback) { m_groupAffChange = callback; }
 
     protected:
         uint8_t m_rfGrantChCnt;
@@ -293,6 +299,7 @@ namespace lookups
         std::function<void(uint32_t, uint32_t, uint8_t)> m_releaseGrant;
         //                 srcId     auto
         std::function<void(uint32_t, bool)> m_unitDereg;
+        std::function<void()> m_groupAffChange;
 
         std::string m_name;
         ChannelLookup* m_chLookup;
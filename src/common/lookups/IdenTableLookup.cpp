@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2018-2022,2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2018-2022,2024,2025 Bryan Biedenkapp, N2PLL
  *  Copyright (c) 2024 Patrick McDonnell, W3AXL
  *
  */
@@ -13,17 +13,12 @@
 
 using namespace lookups;
 
+#include <cinttypes>
 #include <cstdlib>
 #include <string>
 #include <vector>
 #include <fstream>
 
-// ---------------------------------------------------------------------------
-//  Static Class Members
-// ---------------------------------------------------------------------------
-
-std::mutex IdenTableLookup::m_mutex;
-
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -35,25 +30,16 @@ IdenTableLookup::IdenTableLookup(const std::string& filename, uint32_t reloadTim
     /* stub */
 }
 
-/* Clears all entries from the lookup table. */
-
-void IdenTableLookup::clear()
-{
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_table.clear();
-}
-
 /* Finds a table entry in this lookup table. */
 
 IdenTable IdenTableLookup::find(uint32_t id)
 {
     IdenTable entry;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    try {
-        entry = m_table.at(id);
-    } catch (...) {
-        /* stub */
+    TableSnapshot table = snapshot();
+    auto it = table->find(id);
+    if (it != table->end()) {
+        entry = it->second;
     }
 
     float chBandwidthKhz = entry.chBandwidthKhz();
@@ -73,8 +59,10 @@ IdenTable IdenTableLookup::find(uint32_t id)
 std::vector<IdenTable> IdenTableLookup::list()
 {
     std::vector<IdenTable> list = std::vector<IdenTable>();
-    if (m_table.size() > 0) {
-        for (auto entry : m_table) {
+
+    TableSnapshot table = snapshot();
+    if (table->size() > 0) {
+        for (auto entry : *table) {
             list.push_back(entry.second);
         }
     }
@@ -100,10 +88,10 @@ bool IdenTableLookup::load()
         return false;
     }
 
-    // clear table
-    clear();
+    system_clock::hrc::hrc_t start = system_clock::hrc::now();
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    // parse into a new table, the current table remains in service until the new table is published
+    std::shared_ptr<Table> table = std::make_shared<Table>();
 
     // read lines from file
     std::string line;
@@ -149,17 +137,18 @@ bool IdenTableLookup::load()
             LogMessage(LOG_HOST, "Channel Id %u: BaseFrequency = %uHz, TXOffsetMhz = %fMHz, BandwidthKhz = %fKHz, SpaceKhz = %fKHz",
                 entry.channelId(), entry.baseFrequency(), entry.txOffsetMhz(), entry.chBandwidthKhz(), entry.chSpaceKhz());
 
-            m_table[channelId] = entry;
+            (*table)[channelId] = entry;
         }
     }
 
     file.close();
 
-    size_t size = m_table.size();
+    size_t size = table->size();
+    uint64_t loadTime = loaded(table, start);
     if (size == 0U)
         return false;
 
-    LogInfoEx(LOG_HOST, "Loaded %u entries into lookup table", size);
+    LogInfoEx(LOG_HOST, "Loaded %u entries into lookup table, took %" PRIu64 "ms", size, loadTime);
 
     return true;
 }
@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2018-2022,2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2018-2022,2024,2025 Bryan Biedenkapp, N2PLL
  *  Copyright (c) 2024 Patrick McDonnell, W3AXL
  *
  */
@@ -128,11 +128,6 @@ namespace lookups
          */
         IdenTableLookup(const std::string& filename, uint32_t reloadTime);
 
-        /**
-         * @brief Clears all entries from the lookup table.
-         */
-        void clear() override;
-
         /**
          * @brief Finds a table entry in this lookup table.
          * @param id Unique identifier for table entry.
@@ -157,9 +152,6 @@ namespace lookups
          * @returns bool True, if lookup table was saved, otherwise false.
          */
         bool save() override;
-
-    private:
-        static std::mutex m_mutex;
     };
 } // namespace lookups
 
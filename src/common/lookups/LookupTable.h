@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2018-2022,2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2018-2022,2024,2025 Bryan Biedenkapp, N2PLL
  *  Copyright (c) 2024 Patrick McDonnell, W3AXL
  *
  */
@@ -20,13 +20,16 @@
 #define __LOOKUP_TABLE_H__
 
 #include "common/Defines.h"
+#include "common/Clock.h"
 #include "common/Thread.h"
 #include "common/Timer.h"
 
+#include <atomic>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 
@@ -39,12 +42,18 @@ namespace lookups
     /**
      * @brief Implements a abstract threading class that contains base logic for
      *  building tables of data.
+     *  The table is published as an immutable snapshot; a (re)load parses into a fresh table off to
+     *  the side and publishes it with a single atomic pointer swap, and modifications copy the table,
+     *  modify the copy and publish it. Readers never block, and never observe a partially loaded table.
      * @tparam T Atomic type this lookup table is for.
      * @ingroup lookups
      */
     template <class T>
     class HOST_SW_API LookupTable : public Thread {
     public:
+        typedef std::unordered_map<uint32_t, T> Table;
+        typedef std::shared_ptr<const Table> TableSnapshot;
+
         /**
          * @brief Initializes a new instance of the LookupTable class.
          * @param filename Full-path to the lookup table file.
@@ -54,8 +63,11 @@ namespace lookups
             Thread(),
             m_filename(filename),
             m_reloadTime(reloadTime),
-            m_table(),
-            m_stop(false)
+            m_tableMutex(),
+            m_lastLoadTime(0U),
+            m_stop(false),
+            m_table(std::make_shared<const Table>()),
+            m_version(nextVersion())
         {
             /* stub */
         }
@@ -131,9 +143,8 @@ namespace lookups
          */
         virtual void clear()
         {
-            // bryanb: this is not thread-safe and thread saftey should be implemented
-            // on the derived class
-            m_table.clear();
+            std::lock_guard<std::mutex> lock(m_tableMutex);
+            publish(std::make_shared<Table>());
         }
 
         /**
@@ -143,16 +154,8 @@ namespace lookups
          */
         virtual bool hasEntry(uint32_t id)
         {
-            try {
-                T entry = m_table.at(id); // this value will get discarded
-                (void)entry;              // but some variants of C++ mark the unordered_map<>::at as nodiscard
-                return true;
-            }
-            catch (...) {
-                return false;
-            }
-
-            return false;
+            TableSnapshot table = snapshot();
+            return table->find(id) != table->end();
         }
 
         /**
@@ -163,10 +166,44 @@ namespace lookups
         virtual T find(uint32_t id) = 0;
 
         /**
-         * @brief Helper to return the lookup table.
+         * @brief Helper to return a copy of the lookup table.
          * @returns std::unordered_map<uint32_t, T> Table.
          */
-        virtual std::unordered_map<uint32_t, T> table() { return m_table; }
+        virtual std::unordered_map<uint32_t, T> table() { return *snapshot(); }
+
+        /**
+         * @brief Gets the current snapshot of the lookup table.
+         *  (The snapshot is immutable and remains valid for as long as it is held; each thread caches
+         *   the snapshot it last took, and only reloads it when a new table has been published.)
+         * @returns TableSnapshot Current lookup table snapshot.
+         */
+        TableSnapshot snapshot() const
+        {
+            struct SnapshotCache {
+                uint64_t version;
+                TableSnapshot table;
+            };
+            static thread_local SnapshotCache cache = { 0U, nullptr };
+
+            uint64_t version = m_version.load(std::memory_order_acquire);
+            if (cache.version != version || cache.table == nullptr) {
+                cache.table = std::atomic_load_explicit(&m_table, std::memory_order_acquire);
+                cache.version = version;
+            }
+
+            return cache.table;
+        }
+
+        /**
+         * @brief Gets the count of entries in the lookup table.
+         * @returns size_t Number of entries.
+         */
+        size_t size() const { return snapshot()->size(); }
+        /**
+         * @brief Gets the amount of time the last (re)load of the lookup table took.
+         * @returns uint64_t Time in milliseconds.
+         */
+        uint64_t lastLoadTime() const { return m_lastLoadTime.load(); }
 
         /**
          * @brief Returns the filename used to load this lookup table.
@@ -188,9 +225,59 @@ namespace lookups
     protected:
         std::string m_filename;
         uint32_t m_reloadTime;
-        std::unordered_map<uint32_t, T> m_table;
+
+        std::mutex m_tableMutex;    //! Mutex used to serialize table writers.
+        std::atomic<uint64_t> m_lastLoadTime;
+
         bool m_stop;
 
+        /**
+         * @brief Helper to publish a new table, replacing the current table.
+         *  (This must be called with the table mutex held.)
+         * @param table New table.
+         */
+        void publish(std::shared_ptr<Table> table)
+        {
+            uint64_t version = nextVersion();
+            std::atomic_store_explicit(&m_table, TableSnapshot(table), std::memory_order_release);
+            m_version.store(version, std::memory_order_release);
+        }
+
+        /**
+         * @brief Helper to modify the lookup table; the table is copied, the modification is applied
+         *  to the copy, and the copy is published.
+         *  (Bulk modifications should be made in a single call, as every call copies the table.)
+         * @tparam Fn Modification function, with the signature void(Table&).
+         * @param fn Modification function.
+         */
+        template <typename Fn>
+        void modify(Fn fn)
+        {
+            std::lock_guard<std::mutex> lock(m_tableMutex);
+
+            std::shared_ptr<Table> table = std::make_shared<Table>(*std::atomic_load_explicit(&m_table, std::memory_order_acquire));
+            fn(*table);
+            publish(table);
+        }
+
+        /**
+         * @brief Helper to publish a freshly loaded table and record how long the load took.
+         * @param table New table.
+         * @param start Time the load was started.
+         * @returns uint64_t Time in milliseconds the load took.
+         */
+        uint64_t loaded(std::shared_ptr<Table> table, system_clock::hrc::hrc_t start)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_tableMutex);
+                publish(table);
+            }
+
+            uint64_t loadTime = system_clock::hrc::diffNow(start);
+            m_lastLoadTime.store(loadTime);
+            return loadTime;
+        }
+
         /**
          * @brief Loads the table from the passed lookup table file.
          * @returns bool True, if lookup table was loaded, otherwise false.
@@ -202,6 +289,22 @@ namespace lookups
          * @returns bool True, if lookup table was saved, otherwise false.
          */
         virtual bool save() = 0;
+
+    private:
+        TableSnapshot m_table;
+        std::atomic<uint64_t> m_version;
+
+        /**
+         * @brief Helper to get the next table version.
+         *  (Versions are unique across all tables of the same type, this allows a thread's cached
+         *   snapshot to be validated by version alone.)
+         * @returns uint64_t Table version.
+         */
+        static uint64_t nextVersion()
+        {
+            static std::atomic<uint64_t> version(0U);
+            return version.fetch_add(1U, std::memory_order_relaxed) + 1U;
+        }
     };
 } // namespace lookups
 
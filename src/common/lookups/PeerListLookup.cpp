@@ -15,35 +15,10 @@
 
 using namespace lookups;
 
+#include <cinttypes>
 #include <fstream>
 #include <algorithm>
 
-// ---------------------------------------------------------------------------
-//  Static Class Members
-// ---------------------------------------------------------------------------
-
-std::mutex PeerListLookup::m_mutex;
-bool PeerListLookup::m_locked = false;
-
-// ---------------------------------------------------------------------------
-//  Macros
-// ---------------------------------------------------------------------------
-
-// Lock the table.
-#define __LOCK_TABLE()                          \
-    std::lock_guard<std::mutex> lock(m_mutex);  \
-    m_locked = true;
-
-// Unlock the table.
-#define __UNLOCK_TABLE() m_locked = false;
-
-// Spinlock wait for table to be released.
-#define __SPINLOCK()                            \
-    if (m_locked) {                             \
-        while (m_locked)                        \
-            Thread::sleep(2U);                  \
-    }
-
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -56,71 +31,41 @@ PeerListLookup::PeerListLookup(const std::string& filename, Mode mode, uint32_t
     /* stub */
 }
 
-/* Clears all entries from the list. */
-
-void PeerListLookup::clear()
-{
-    __LOCK_TABLE();
-
-    m_table.clear();
-
-    __UNLOCK_TABLE();
-}
-
 /* Adds a new entry to the list. */
 
 void PeerListLookup::addEntry(uint32_t id, const std::string& alias, const std::string& password, bool peerLink, bool canRequestKeys)
 {
     PeerId entry = PeerId(id, alias, password, peerLink, canRequestKeys, false);
 
-    __LOCK_TABLE();
-
-    try {
-        PeerId _entry = m_table.at(id);
-        // if either the alias or the enabled flag doesn't match, update the entry
-        if (_entry.peerId() == id) {
-            _entry = PeerId(id, alias, password, peerLink, canRequestKeys, false);
-            m_table[id] = _entry;
-        }
-    } catch (...) {
-        m_table[id] = entry;
-    }
-
-    __UNLOCK_TABLE();
+    modify([&](Table& table) {
+        table[id] = entry;
+    });
 }
 
 /* Removes an existing entry from the list. */
 
 void PeerListLookup::eraseEntry(uint32_t id)
 {
-    __LOCK_TABLE();
-
-    try {
-        PeerId entry = m_table.at(id);  // this value will get discarded
-        (void)entry;                    // but some variants of C++ mark the unordered_map<>::at as nodiscard
-        m_table.erase(id);
-    } catch (...) {
-        /* stub */
+    if (!hasEntry(id)) {
+        return;
     }
 
-    __UNLOCK_TABLE();
+    modify([&](Table& table) {
+        table.erase(id);
+    });
 }
 
 /* Finds a table entry in this lookup table. */
 
 PeerId PeerListLookup::find(uint32_t id)
 {
-    PeerId entry;
-
-    __SPINLOCK();
-
-    try {
-        entry = m_table.at(id);
-    } catch (...) {
-        entry = PeerId(0U, "", "", false, false, true);
+    TableSnapshot table = snapshot();
+    auto it = table->find(id);
+    if (it != table->end()) {
+        return it->second;
     }
 
-    return entry;
+    return PeerId(0U, "", "", false, false, true);
 }
 
 /* Commit the table. */
@@ -141,9 +86,8 @@ bool PeerListLookup::getACL() const
 
 bool PeerListLookup::isPeerInList(uint32_t id) const
 {
-    __SPINLOCK();
-
-    if (m_table.find(id) != m_table.end()) {
+    TableSnapshot table = snapshot();
+    if (table->find(id) != table->end()) {
         return true;
     }
 
@@ -172,18 +116,14 @@ bool PeerListLookup::isPeerAllowed(uint32_t id) const
 
 void PeerListLookup::setMode(Mode mode)
 {
-    __LOCK_TABLE();
-
     m_mode = mode;
-
-    __UNLOCK_TABLE();
 }
 
 /* Gets the current mode. */
 
 PeerListLookup::Mode PeerListLookup::getMode() const 
 {
-    return m_mode;
+    return m_mode.load();
 }
 
 /* Gets the entire peer ID table. */
@@ -192,13 +132,12 @@ std::vector<PeerId> PeerListLookup::tableAsList() const
 {
     std::vector<PeerId> ret = std::vector<PeerId>();
 
-    __LOCK_TABLE();
-
-    for (auto entry : m_table) {
+    TableSnapshot table = snapshot();
+    ret.reserve(table->size());
+    for (auto& entry : *table) {
         ret.push_back(entry.second);
     }
 
-    __UNLOCK_TABLE();
     return ret;
 }
 
@@ -220,9 +159,11 @@ bool PeerListLookup::load()
         return false;
     }
 
-    clear();
+    system_clock::hrc::hrc_t start = system_clock::hrc::now();
+    size_t prevSize = size();
 
-    __LOCK_TABLE();
+    // parse into a new table, the current table remains in service until the new table is published
+    std::shared_ptr<Table> table = std::make_shared<Table>();
 
     // read lines from file
     std::string line;
@@ -274,7 +215,7 @@ bool PeerListLookup::load()
                 password = parsed[1].c_str();
 
             // Load into table
-            m_table[id] = PeerId(id, alias, password, peerLink, canRequestKeys, false);
+            (*table)[id] = PeerId(id, alias, password, peerLink, canRequestKeys, false);
 
             // Log depending on what was loaded
             LogMessage(LOG_HOST, "Loaded peer ID %u%s into peer ID lookup table, %s%s%s", id,
@@ -286,13 +227,13 @@ bool PeerListLookup::load()
     }
 
     file.close();
-    __UNLOCK_TABLE();
 
-    size_t size = m_table.size();
+    size_t size = table->size();
+    uint64_t loadTime = loaded(table, start);
     if (size == 0U)
         return false;
 
-    LogInfoEx(LOG_HOST, "Loaded %lu entries into peer list lookup table", size);
+    LogInfoEx(LOG_HOST, "Loaded %lu entries into peer list lookup table (previously %lu entries), took %" PRIu64 "ms", size, prevSize, loadTime);
     return true;
 }
 
@@ -315,12 +256,13 @@ bool PeerListLookup::save()
     // Counter for lines written
     unsigned int lines = 0;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::mutex> lock(m_tableMutex);
+    TableSnapshot table = snapshot();
 
     // String for writing
     std::string line;
     // iterate over each entry in the RID lookup and write it to the open file
-    for (auto& entry: m_table) {
+    for (auto& entry: *table) {
         // Get the parameters
         uint32_t peerId = entry.first;
         std::string alias = entry.second.peerAlias();
@@ -363,7 +305,7 @@ bool PeerListLookup::save()
 
     file.close();
 
-    if (lines != m_table.size())
+    if (lines != table->size())
         return false;
 
     LogInfoEx(LOG_HOST, "Saved %u entries to lookup table file %s", lines, m_filename.c_str());
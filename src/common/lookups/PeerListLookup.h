@@ -168,11 +168,6 @@ namespace lookups
          */
         PeerListLookup(const std::string& filename, Mode mode, uint32_t reloadTime, bool peerAcl);
 
-        /**
-         * @brief Clears all entries from the list.
-         */
-        void clear() override;
-
         /**
          * @brief Adds a new entry to the list.
          * @param peerId Unique peer ID to add.
@@ -221,7 +216,7 @@ namespace lookups
          * @brief Checks if the peer list is empty.
          * @returns bool True, if list is empty, otherwise false.
          */
-        bool isPeerListEmpty() const { return m_table.size() == 0U; }
+        bool isPeerListEmpty() const { return size() == 0U; }
 
         /**
          * @brief Sets the mode to either WHITELIST or BLACKLIST.
@@ -238,7 +233,7 @@ namespace lookups
          * @brief Gets the entire peer ID table.
          * @returns std::unordered_map<uint32_t, PeerId> 
          */
-        std::unordered_map<uint32_t, PeerId> table() const { return m_table; }
+        std::unordered_map<uint32_t, PeerId> table() const { return *snapshot(); }
         /**
          * @brief Gets the entire peer ID table.
          * @returns std::vector<PeerId> 
@@ -261,10 +256,7 @@ namespace lookups
         bool save() override;
 
     private:
-        Mode m_mode;
-
-        static std::mutex m_mutex;  //! Mutex used for hard locking.
-        static bool m_locked;       //! Flag used for soft locking (prevents find lookups), should be used when atomic operations (add/erase/etc) are being used.
+        std::atomic<Mode> m_mode;
     };
 } // namespace lookups
 
@@ -15,37 +15,12 @@
 
 using namespace lookups;
 
+#include <cinttypes>
 #include <cstdlib>
 #include <string>
 #include <vector>
 #include <fstream>
 
-// ---------------------------------------------------------------------------
-//  Static Class Members
-// ---------------------------------------------------------------------------
-
-std::mutex RadioIdLookup::m_mutex;
-bool RadioIdLookup::m_locked = false;
-
-// ---------------------------------------------------------------------------
-//  Macros
-// ---------------------------------------------------------------------------
-
-// Lock the table.
-#define __LOCK_TABLE()                          \
-    std::lock_guard<std::mutex> lock(m_mutex);  \
-    m_locked = true;
-
-// Unlock the table.
-#define __UNLOCK_TABLE() m_locked = false;
-
-// Spinlock wait for table to be released.
-#define __SPINLOCK()                            \
-    if (m_locked) {                             \
-        while (m_locked)                        \
-            Thread::sleep(2U);                  \
-    }
-
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -58,23 +33,29 @@ RadioIdLookup::RadioIdLookup(const std::string& filename, uint32_t reloadTime, b
     /* stub */
 }
 
-/* Clears all entries from the lookup table. */
+/* Toggles the specified radio ID enabled or disabled. */
 
-void RadioIdLookup::clear()
+void RadioIdLookup::toggleEntry(uint32_t id, bool enabled)
 {
-    __LOCK_TABLE();
-
-    m_table.clear();
-
-    __UNLOCK_TABLE();
+    std::vector<uint32_t> ids = { id };
+    toggleEntries(ids, enabled);
 }
 
-/* Toggles the specified radio ID enabled or disabled. */
+/* Toggles the specified radio IDs enabled or disabled. */
 
-void RadioIdLookup::toggleEntry(uint32_t id, bool enabled)
+void RadioIdLookup::toggleEntries(const std::vector<uint32_t>& ids, bool enabled)
 {
-    RadioId rid = find(id);
-    addEntry(id, enabled, rid.radioAlias());
+    if (ids.empty()) {
+        return;
+    }
+
+    modify([&](Table& table) {
+        for (uint32_t id : ids) {
+            auto it = table.find(id);
+            std::string alias = (it != table.end()) ? it->second.radioAlias() : "";
+            addEntry(table, id, enabled, alias, "");
+        }
+    });
 }
 
 /* Adds a new entry to the lookup table by the specified unique ID. */
@@ -85,65 +66,39 @@ void RadioIdLookup::addEntry(uint32_t id, bool enabled, const std::string& alias
         return;
     }
 
-    RadioId entry = RadioId(enabled, false, alias, ipAddress);
-
-    __LOCK_TABLE();
-
-    try {
-        RadioId _entry = m_table.at(id);
-        // if either the alias or the enabled flag doesn't match, update the entry
-        if (_entry.radioEnabled() != enabled || _entry.radioAlias() != alias) {
-            //LogDebug(LOG_HOST, "Updating existing RID %d (%s) in ACL", id, alias.c_str());
-            _entry = RadioId(enabled, false, alias, ipAddress);
-            m_table[id] = _entry;
-        } else {
-            //LogDebug(LOG_HOST, "No changes made to RID %d (%s) in ACL", id, alias.c_str());
-        }
-    } catch (...) {
-        //LogDebug(LOG_HOST, "Adding new RID %d (%s) to ACL", id, alias.c_str());
-        m_table[id] = entry;
-    }
-
-    __UNLOCK_TABLE();
+    modify([&](Table& table) {
+        addEntry(table, id, enabled, alias, ipAddress);
+    });
 }
 
 /* Erases an existing entry from the lookup table by the specified unique ID. */
 
 void RadioIdLookup::eraseEntry(uint32_t id)
 {
-    __LOCK_TABLE();
-
-    try {
-        RadioId entry = m_table.at(id); // this value will get discarded
-        (void)entry;                    // but some variants of C++ mark the unordered_map<>::at as nodiscard
-        m_table.erase(id);
-    }
-    catch (...) {
-        /* stub */
+    if (!hasEntry(id)) {
+        return;
     }
 
-    __UNLOCK_TABLE();
+    modify([&](Table& table) {
+        table.erase(id);
+    });
 }
 
 /* Finds a table entry in this lookup table. */
 
 RadioId RadioIdLookup::find(uint32_t id)
 {
-    RadioId entry;
-
     if ((id == p25::defines::WUID_ALL) || (id == p25::defines::WUID_FNE)) {
         return RadioId(true, false);
     }
 
-    __SPINLOCK();
-
-    try {
-        entry = m_table.at(id);
-    } catch (...) {
-        entry = RadioId(false, true);
+    TableSnapshot table = snapshot();
+    auto it = table->find(id);
+    if (it != table->end()) {
+        return it->second;
     }
 
-    return entry;
+    return RadioId(false, true);
 }
 
 /* Saves loaded talkgroup rules. */
@@ -164,6 +119,29 @@ bool RadioIdLookup::getACL()
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+/* Helper to add (or update) an entry in the given table. */
+
+void RadioIdLookup::addEntry(Table& table, uint32_t id, bool enabled, const std::string& alias, const std::string& ipAddress)
+{
+    if ((id == p25::defines::WUID_ALL) || (id == p25::defines::WUID_FNE)) {
+        return;
+    }
+
+    auto it = table.find(id);
+    if (it != table.end()) {
+        // if either the alias or the enabled flag doesn't match, update the entry
+        if (it->second.radioEnabled() != enabled || it->second.radioAlias() != alias) {
+            //LogDebug(LOG_HOST, "Updating existing RID %d (%s) in ACL", id, alias.c_str());
+            it->second = RadioId(enabled, false, alias, ipAddress);
+        } else {
+            //LogDebug(LOG_HOST, "No changes made to RID %d (%s) in ACL", id, alias.c_str());
+        }
+    } else {
+        //LogDebug(LOG_HOST, "Adding new RID %d (%s) to ACL", id, alias.c_str());
+        table[id] = RadioId(enabled, false, alias, ipAddress);
+    }
+}
+
 /* Loads the table from the passed lookup table file. */
 
 bool RadioIdLookup::load()
@@ -178,10 +156,11 @@ bool RadioIdLookup::load()
         return false;
     }
 
-    // clear table
-    clear();
+    system_clock::hrc::hrc_t start = system_clock::hrc::now();
+    size_t prevSize = size();
 
-    __LOCK_TABLE();
+    // parse into a new table, the current table remains in service until the new table is published
+    std::shared_ptr<Table> table = std::make_shared<Table>();
 
     // read lines from file
     std::string line;
@@ -225,18 +204,18 @@ bool RadioIdLookup::load()
                 ipAddress = parsed[3];
             }
 
-            m_table[id] = RadioId(radioEnabled, false, alias, ipAddress);
+            (*table)[id] = RadioId(radioEnabled, false, alias, ipAddress);
         }
     }
 
     file.close();
-    __UNLOCK_TABLE();
 
-    size_t size = m_table.size();
+    size_t size = table->size();
+    uint64_t loadTime = loaded(table, start);
     if (size == 0U)
         return false;
 
-    LogInfoEx(LOG_HOST, "Loaded %lu entries into radio ID lookup table", size);
+    LogInfoEx(LOG_HOST, "Loaded %lu entries into radio ID lookup table (previously %lu entries), took %" PRIu64 "ms", size, prevSize, loadTime);
 
     return true;
 }
@@ -260,13 +239,14 @@ bool RadioIdLookup::save()
     // Counter for lines written
     unsigned int lines = 0;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::mutex> lock(m_tableMutex);
+    TableSnapshot table = snapshot();
 
     // String for writing
     std::string line;
 
     // iterate over each entry in the RID lookup and write it to the open file
-    for (auto& entry: m_table) {
+    for (auto& entry: *table) {
         // Get the parameters
         uint32_t rid = entry.first;
         bool enabled = entry.second.radioEnabled();
@@ -300,7 +280,7 @@ bool RadioIdLookup::save()
 
     file.close();
 
-    if (lines != m_table.size())
+    if (lines != table->size())
         return false;
 
     LogInfoEx(LOG_HOST, "Saved %u entries to lookup table file %s", lines, m_filename.c_str());
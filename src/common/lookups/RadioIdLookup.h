@@ -27,6 +27,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace lookups
 {
@@ -150,17 +151,19 @@ namespace lookups
          */
         RadioIdLookup(const std::string& filename, uint32_t reloadTime, bool ridAcl);
 
-        /**
-         * @brief Clears all entries from the lookup table.
-         */
-        void clear() override;
-
         /**
          * @brief Toggles the specified radio ID enabled or disabled.
          * @param id Unique ID to toggle.
          * @param enabled Flag indicating if radio ID is enabled or not.
          */
         void toggleEntry(uint32_t id, bool enabled);
+        /**
+         * @brief Toggles the specified radio IDs enabled or disabled.
+         *  (All radio IDs are toggled in a single update of the lookup table.)
+         * @param ids List of unique IDs to toggle.
+         * @param enabled Flag indicating if radio IDs are enabled or not.
+         */
+        void toggleEntries(const std::vector<uint32_t>& ids, bool enabled);
 
         /**
          * @brief Adds a new entry to the lookup table by the specified unique ID, with an alias.
@@ -208,8 +211,15 @@ namespace lookups
         bool save() override;
 
     private:
-        static std::mutex m_mutex;  //! Mutex used for hard locking.
-        static bool m_locked;       //! Flag used for soft locking (prevents find lookups), should be used when atomic operations (add/erase/etc) are being used.
+        /**
+         * @brief Helper to add (or update) an entry in the given table.
+         * @param table Table to modify.
+         * @param id Unique ID to add.
+         * @param enabled Flag indicating if radio ID is enabled or not.
+         * @param alias Alias for the radio ID
+         * @param ipAddress IP Address for Radio
+         */
+        static void addEntry(Table& table, uint32_t id, bool enabled, const std::string& alias, const std::string& ipAddress);
     };
 } // namespace lookups
 
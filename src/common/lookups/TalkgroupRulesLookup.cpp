@@ -9,12 +9,14 @@
  *
  */
 #include "lookups/TalkgroupRulesLookup.h"
+#include "Clock.h"
 #include "Log.h"
 #include "Timer.h"
 #include "Utils.h"
 
 using namespace lookups;
 
+#include <cinttypes>
 #include <string>
 #include <vector>
 
@@ -22,27 +24,76 @@ using namespace lookups;
 //  Static Class Members
 // ---------------------------------------------------------------------------
 
-std::mutex TalkgroupRulesLookup::m_mutex;
-bool TalkgroupRulesLookup::m_locked = false;
+// versions are unique across all rules tables, this allows a thread's cached snapshot to be
+// validated by version alone
+static std::atomic<uint64_t> s_nextVersion(0U);
+
+// handle returned when no rule matches a lookup
+static const TalkgroupRuleGroupVoiceHandle s_invalidGroupVoice = std::make_shared<const TalkgroupRuleGroupVoice>();
 
 // ---------------------------------------------------------------------------
-//  Macros
+//  TalkgroupRulesTable Public Class Members
 // ---------------------------------------------------------------------------
 
-// Lock the table.
-#define __LOCK_TABLE()                          \
-    std::lock_guard<std::mutex> lock(m_mutex);  \
-    m_locked = true;
+/* Initializes a new instance of the TalkgroupRulesTable class. */
+
+TalkgroupRulesTable::TalkgroupRulesTable() :
+    m_groupVoice(),
+    m_sourceIndex(),
+    m_rewriteIndex()
+{
+    /* stub */
+}
 
-// Unlock the table.
-#define __UNLOCK_TABLE() m_locked = false;
+/* Initializes a new instance of the TalkgroupRulesTable class. */
 
-// Spinlock wait for table to be released.
-#define __SPINLOCK()                            \
-    if (m_locked) {                             \
-        while (m_locked)                        \
-            Thread::sleep(2U);                  \
+TalkgroupRulesTable::TalkgroupRulesTable(std::vector<TalkgroupRuleGroupVoice> groupVoice) :
+    m_groupVoice(std::move(groupVoice)),
+    m_sourceIndex(),
+    m_rewriteIndex()
+{
+    m_sourceIndex.reserve(m_groupVoice.size() * 2U);
+
+    // the index is built in table order and never overwrites an existing key, so that the first
+    // matching rule in the table wins (as it would for a linear search of the table)
+    for (size_t i = 0U; i < m_groupVoice.size(); i++) {
+        const TalkgroupRuleGroupVoice& entry = m_groupVoice[i];
+        uint32_t tgId = entry.source().tgId();
+        uint8_t tgSlot = entry.source().tgSlot();
+
+        m_sourceIndex.emplace(sourceKey(tgId, 0U), i);
+        if (tgSlot != 0U)
+            m_sourceIndex.emplace(sourceKey(tgId, tgSlot), i);
+
+        for (const TalkgroupRuleRewrite& rewrite : entry.config().rewrite()) {
+            m_rewriteIndex.emplace(RewriteKey { rewrite.peerId(), rewrite.tgId(), 0U }, i);
+            if (rewrite.tgSlot() != 0U)
+                m_rewriteIndex.emplace(RewriteKey { rewrite.peerId(), rewrite.tgId(), rewrite.tgSlot() }, i);
+        }
     }
+}
+
+/* Finds a group voice rule by source talkgroup. */
+
+const TalkgroupRuleGroupVoice* TalkgroupRulesTable::find(uint32_t id, uint8_t slot) const
+{
+    auto it = m_sourceIndex.find(sourceKey(id, slot));
+    if (it != m_sourceIndex.end())
+        return &m_groupVoice[it->second];
+
+    return nullptr;
+}
+
+/* Finds a group voice rule by rewrite. */
+
+const TalkgroupRuleGroupVoice* TalkgroupRulesTable::findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot) const
+{
+    auto it = m_rewriteIndex.find(RewriteKey { peerId, id, slot });
+    if (it != m_rewriteIndex.end())
+        return &m_groupVoice[it->second];
+
+    return nullptr;
+}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -53,12 +104,15 @@ bool TalkgroupRulesLookup::m_locked = false;
 TalkgroupRulesLookup::TalkgroupRulesLookup(const std::string& filename, uint32_t reloadTime, bool acl) : Thread(),
     m_rulesFile(filename),
     m_reloadTime(reloadTime),
-    m_rules(),
     m_acl(acl),
     m_stop(false),
+    m_generation(0U),
+    m_lastLoadTime(0U),
+    m_mutex(),
+    m_table(std::make_shared<const TalkgroupRulesTable>()),
+    m_version(s_nextVersion.fetch_add(1U, std::memory_order_relaxed) + 1U),
     m_groupHangTime(5U),
-    m_sendTalkgroups(false),
-    m_groupVoice()
+    m_sendTalkgroups(false)
 {
     /* stub */
 }
@@ -121,11 +175,8 @@ bool TalkgroupRulesLookup::read()
 
 void TalkgroupRulesLookup::clear()
 {
-    __LOCK_TABLE();
-
-    m_groupVoice.clear();
-
-    __UNLOCK_TABLE();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    publish(GroupVoiceList());
 }
 
 /* Adds a new entry to the lookup table by the specified unique ID. */
@@ -140,42 +191,40 @@ void TalkgroupRulesLookup::addEntry(uint32_t id, uint8_t slot, bool enabled, boo
     config.affiliated(affiliated);
     config.nonPreferred(nonPreferred);
 
-    __LOCK_TABLE();
-
-    auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(),
-        [&](TalkgroupRuleGroupVoice x)
-        {
-            if (slot != 0U) {
-                return x.source().tgId() == id && x.source().tgSlot() == slot;
-            }
-
-            return x.source().tgId() == id;
-        });
-    if (it != m_groupVoice.end()) {
-        source = it->source();
-        source.tgId(id);
-        source.tgSlot(slot);
-        
-        config = it->config();
-        config.active(enabled);
-        config.affiliated(affiliated);
-        config.nonPreferred(nonPreferred);
-
-        TalkgroupRuleGroupVoice entry = *it;
-        entry.config(config);
-        entry.source(source);
-
-        m_groupVoice[it - m_groupVoice.begin()] = entry;
-    }
-    else {
-        TalkgroupRuleGroupVoice entry;
-        entry.config(config);
-        entry.source(source);
-
-        m_groupVoice.push_back(entry);
-    }
+    modify([&](GroupVoiceList& groupVoice) {
+        auto it = std::find_if(groupVoice.begin(), groupVoice.end(),
+            [&](const TalkgroupRuleGroupVoice& x)
+            {
+                if (slot != 0U) {
+                    return x.source().tgId() == id && x.source().tgSlot() == slot;
+                }
+
+                return x.source().tgId() == id;
+            });
+        if (it != groupVoice.end()) {
+            source = it->source();
+            source.tgId(id);
+            source.tgSlot(slot);
+
+            config = it->config();
+            config.active(enabled);
+            config.affiliated(affiliated);
+            config.nonPreferred(nonPreferred);
+
+            TalkgroupRuleGroupVoice entry = *it;
+            entry.config(config);
+            entry.source(source);
+
+            groupVoice[it - groupVoice.begin()] = entry;
+        }
+        else {
+            TalkgroupRuleGroupVoice entry;
+            entry.config(config);
+            entry.source(source);
 
-    __UNLOCK_TABLE();
+            groupVoice.push_back(entry);
+        }
+    });
 }
 
 /* Adds a new entry to the lookup table by the specified unique ID. */
@@ -189,103 +238,139 @@ void TalkgroupRulesLookup::addEntry(TalkgroupRuleGroupVoice groupVoice)
     uint32_t id = entry.source().tgId();
     uint8_t slot = entry.source().tgSlot();
 
-    __LOCK_TABLE();
-
-    auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(),
-        [&](TalkgroupRuleGroupVoice x)
-        {
-            if (slot != 0U) {
-                return x.source().tgId() == id && x.source().tgSlot() == slot;
-            }
-
-            return x.source().tgId() == id;
-        });
-    if (it != m_groupVoice.end()) {
-        m_groupVoice[it - m_groupVoice.begin()] = entry;
-    }
-    else {
-        m_groupVoice.push_back(entry);
-    }
-
-    __UNLOCK_TABLE();
+    modify([&](GroupVoiceList& groupVoice) {
+        auto it = std::find_if(groupVoice.begin(), groupVoice.end(),
+            [&](const TalkgroupRuleGroupVoice& x)
+            {
+                if (slot != 0U) {
+                    return x.source().tgId() == id && x.source().tgSlot() == slot;
+                }
+
+                return x.source().tgId() == id;
+            });
+        if (it != groupVoice.end()) {
+            groupVoice[it - groupVoice.begin()] = entry;
+        }
+        else {
+            groupVoice.push_back(entry);
+        }
+    });
 }
 
 /* Erases an existing entry from the lookup table by the specified unique ID. */
 
 void TalkgroupRulesLookup::eraseEntry(uint32_t id, uint8_t slot)
 {
-    __LOCK_TABLE();
+    modify([&](GroupVoiceList& groupVoice) {
+        auto it = std::find_if(groupVoice.begin(), groupVoice.end(), [&](const TalkgroupRuleGroupVoice& x) { return x.source().tgId() == id && x.source().tgSlot() == slot; });
+        if (it != groupVoice.end()) {
+            groupVoice.erase(it);
+        }
+    });
+}
 
-    auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(), [&](TalkgroupRuleGroupVoice x) { return x.source().tgId() == id && x.source().tgSlot() == slot; });
-    if (it != m_groupVoice.end()) {
-        m_groupVoice.erase(it);
-    }
+/* Adds new entries to the lookup table. */
 
-    __UNLOCK_TABLE();
+void TalkgroupRulesLookup::addEntries(const GroupVoiceList& entries)
+{
+    if (entries.empty())
+        return;
+
+    modify([&](GroupVoiceList& groupVoice) {
+        // index the list once (the first matching rule wins, as it does for addEntry()), rather than
+        // searching the list for every entry
+        auto key = [](uint32_t id, uint8_t slot) { return ((uint64_t)id << 8) | slot; };
+        std::unordered_map<uint64_t, size_t> index;
+        index.reserve((groupVoice.size() + entries.size()) * 2U);
+        auto indexEntry = [&](size_t i) {
+            uint32_t id = groupVoice[i].source().tgId();
+            uint8_t slot = groupVoice[i].source().tgSlot();
+            index.emplace(key(id, 0U), i);
+            if (slot != 0U)
+                index.emplace(key(id, slot), i);
+        };
+
+        for (size_t i = 0U; i < groupVoice.size(); i++)
+            indexEntry(i);
+
+        for (const TalkgroupRuleGroupVoice& entry : entries) {
+            if (entry.isInvalid())
+                continue;
+
+            uint32_t id = entry.source().tgId();
+            uint8_t slot = entry.source().tgSlot();
+
+            auto it = index.find(key(id, slot));
+            if (it != index.end()) {
+                size_t i = it->second;
+                uint8_t oldSlot = groupVoice[i].source().tgSlot();
+                if (oldSlot != 0U && oldSlot != slot)
+                    index.erase(key(id, oldSlot));
+
+                groupVoice[i] = entry;
+                indexEntry(i);
+            }
+            else {
+                groupVoice.push_back(entry);
+                indexEntry(groupVoice.size() - 1U);
+            }
+        }
+    });
 }
 
-/* Finds a table entry in this lookup table. */
+/* Erases existing entries from the lookup table by the specified unique IDs. */
 
-TalkgroupRuleGroupVoice TalkgroupRulesLookup::find(uint32_t id, uint8_t slot)
+void TalkgroupRulesLookup::eraseEntries(const std::vector<std::pair<uint32_t, uint8_t>>& ids)
 {
-    TalkgroupRuleGroupVoice entry;
-
-    __SPINLOCK();
+    if (ids.empty())
+        return;
 
-    auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(),
-        [&](TalkgroupRuleGroupVoice x)
-        {
-            if (slot != 0U) {
-                return x.source().tgId() == id && x.source().tgSlot() == slot;
+    modify([&](GroupVoiceList& groupVoice) {
+        // each ID erases the first entry that matches it, as it does for eraseEntry()
+        std::unordered_multiset<uint64_t> keys;
+        for (const auto& id : ids)
+            keys.insert(((uint64_t)id.first << 8) | id.second);
+
+        GroupVoiceList kept;
+        kept.reserve(groupVoice.size());
+        for (TalkgroupRuleGroupVoice& entry : groupVoice) {
+            auto it = keys.find(((uint64_t)entry.source().tgId() << 8) | entry.source().tgSlot());
+            if (it != keys.end()) {
+                keys.erase(it);
+                continue;
             }
 
-            return x.source().tgId() == id;
-        });
-    if (it != m_groupVoice.end()) {
-        entry = *it;
-    } else {
-        entry = TalkgroupRuleGroupVoice();
-    }
+            kept.push_back(std::move(entry));
+        }
 
-    return entry;
+        groupVoice.swap(kept);
+    });
 }
 
 /* Finds a table entry in this lookup table. */
 
-TalkgroupRuleGroupVoice TalkgroupRulesLookup::findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot)
+TalkgroupRuleGroupVoiceHandle TalkgroupRulesLookup::find(uint32_t id, uint8_t slot) const
 {
-    TalkgroupRuleGroupVoice entry;
-
-    __SPINLOCK();
-
-    auto it = std::find_if(m_groupVoice.begin(), m_groupVoice.end(),
-        [&](TalkgroupRuleGroupVoice x)
-        {
-            if (x.config().rewrite().size() == 0)
-                return false;
+    TableSnapshot table = snapshot();
+    const TalkgroupRuleGroupVoice* entry = table->find(id, slot);
+    if (entry == nullptr)
+        return s_invalidGroupVoice;
 
-            std::vector<TalkgroupRuleRewrite> rewrite = x.config().rewrite();
-            auto innerIt = std::find_if(rewrite.begin(), rewrite.end(),
-                [&](TalkgroupRuleRewrite y)
-                {
-                    if (slot != 0U) {
-                        return y.peerId() == peerId && y.tgId() == id && y.tgSlot() == slot;
-                    }
+    // the handle shares ownership of the table the entry belongs to
+    return TalkgroupRuleGroupVoiceHandle(table, entry);
+}
 
-                    return y.peerId() == peerId && y.tgId() == id;
-                });
+/* Finds a table entry in this lookup table by rewrite. */
 
-            if (innerIt != rewrite.end())
-                return true;
-            return false;
-        });
-    if (it != m_groupVoice.end()) {
-        entry = *it;
-    } else {
-        entry = TalkgroupRuleGroupVoice();
-    }
+TalkgroupRuleGroupVoiceHandle TalkgroupRulesLookup::findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot) const
+{
+    TableSnapshot table = snapshot();
+    const TalkgroupRuleGroupVoice* entry = table->findByRewrite(peerId, id, slot);
+    if (entry == nullptr)
+        return s_invalidGroupVoice;
 
-    return entry;
+    // the handle shares ownership of the table the entry belongs to
+    return TalkgroupRuleGroupVoiceHandle(table, entry);
 }
 
 /* Saves loaded talkgroup rules. */
@@ -302,10 +387,53 @@ bool TalkgroupRulesLookup::getACL()
     return m_acl;
 }
 
+/* Gets the current snapshot of the group voice rules. */
+
+TalkgroupRulesLookup::TableSnapshot TalkgroupRulesLookup::snapshot() const
+{
+    // the atomic shared_ptr load is internally locked, so each thread caches the snapshot it last
+    // took and only reloads it after a new version has been published
+    struct SnapshotCache {
+        uint64_t version;
+        TableSnapshot table;
+    };
+    static thread_local SnapshotCache cache = { 0U, nullptr };
+
+    uint64_t version = m_version.load(std::memory_order_acquire);
+    if (cache.version != version || cache.table == nullptr) {
+        cache.table = std::atomic_load_explicit(&m_table, std::memory_order_acquire);
+        cache.version = version;
+    }
+
+    return cache.table;
+}
+
+/* Sets the list of group voice rules. */
+
+void TalkgroupRulesLookup::groupVoice(std::vector<TalkgroupRuleGroupVoice> groupVoice)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    publish(std::move(groupVoice));
+}
+
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+/* Helper to index and publish a new list of group voice rules, replacing the current table. */
+
+void TalkgroupRulesLookup::publish(GroupVoiceList groupVoice)
+{
+    TableSnapshot table = std::make_shared<const TalkgroupRulesTable>(std::move(groupVoice));
+
+    uint64_t version = s_nextVersion.fetch_add(1U, std::memory_order_relaxed) + 1U;
+    std::atomic_store_explicit(&m_table, table, std::memory_order_release);
+    m_version.store(version, std::memory_order_release);
+
+    // mark the table as modified
+    m_generation++;
+}
+
 /* Loads the table from the passed lookup table file. */
 
 bool TalkgroupRulesLookup::load()
@@ -314,8 +442,11 @@ bool TalkgroupRulesLookup::load()
         return false;
     }
 
+    system_clock::hrc::hrc_t start = system_clock::hrc::now();
+
+    yaml::Node rules;
     try {
-        bool ret = yaml::Parse(m_rules, m_rulesFile.c_str());
+        bool ret = yaml::Parse(rules, m_rulesFile.c_str());
         if (!ret) {
             LogError(LOG_HOST, "Cannot open the talkgroup rules lookup file - %s - error parsing YML", m_rulesFile.c_str());
             return false;
@@ -326,22 +457,22 @@ bool TalkgroupRulesLookup::load()
         return false;
     }
 
-    // clear table
-    clear();
-
-    __LOCK_TABLE();
-
-    yaml::Node& groupVoiceList = m_rules["groupVoice"];
+    yaml::Node& groupVoiceList = rules["groupVoice"];
 
     if (groupVoiceList.size() == 0U) {
         ::LogError(LOG_HOST, "No group voice rules list defined!");
-        m_locked = false;
         return false;
     }
 
+    size_t prevSize = snapshot()->size();
+
+    // parse into a new list, the current table remains in service until the new table is published
+    GroupVoiceList newGroupVoice;
+    newGroupVoice.reserve(groupVoiceList.size());
+
     for (size_t i = 0; i < groupVoiceList.size(); i++) {
         TalkgroupRuleGroupVoice groupVoice = TalkgroupRuleGroupVoice(groupVoiceList[i]);
-        m_groupVoice.push_back(groupVoice);
+        newGroupVoice.push_back(groupVoice);
 
         std::string groupName = groupVoice.name();
         uint32_t tgId = groupVoice.source().tgId();
@@ -368,14 +499,20 @@ bool TalkgroupRulesLookup::load()
         ::LogInfoEx(LOG_HOST, "Talkgroup NAME: %s SRC_TGID: %u SRC_TS: %u ACTIVE: %u PARROT: %u AFFILIATED: %u INCLUSIONS: %u EXCLUSIONS: %u REWRITES: %u ALWAYS: %u PREFERRED: %u PERMITTED RIDS: %u", groupName.c_str(), tgId, tgSlot, active, parrot, affil, incCount, excCount, rewrCount, alwyCount, prefCount, permRIDCount);
     }
 
-    __UNLOCK_TABLE();
+    size_t size = newGroupVoice.size();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        publish(std::move(newGroupVoice));
+    }
+
+    uint64_t loadTime = system_clock::hrc::diffNow(start);
+    m_lastLoadTime.store(loadTime);
 
-    size_t size = m_groupVoice.size();
     if (size == 0U) {
         return false;
     }
 
-    LogInfoEx(LOG_HOST, "Loaded %lu entries into talkgroup rules table", size);
+    LogInfoEx(LOG_HOST, "Loaded %lu entries into talkgroup rules table (previously %lu entries), took %" PRIu64 "ms", size, prevSize, loadTime);
 
     return true;
 }
@@ -390,12 +527,13 @@ bool TalkgroupRulesLookup::save()
     }
 
     std::lock_guard<std::mutex> lock(m_mutex);
-    
+    TableSnapshot table = snapshot();
+
     // New list for our new group voice rules
     yaml::Node groupVoiceList;
     yaml::Node newRules;
 
-    for (auto entry : m_groupVoice) {
+    for (auto entry : table->groupVoice()) {
         yaml::Node& gv = groupVoiceList.push_back();
         entry.getYaml(gv);
         //LogDebugEx(LOG_HOST, "TalkgroupRulesLookup::save()", "Added TGID %s to yaml TG list", gv["name"].as<std::string>().c_str());
@@ -407,8 +545,8 @@ bool TalkgroupRulesLookup::save()
     newRules["groupVoice"] = groupVoiceList;
 
     // Make sure we actually did stuff right
-    if (newRules["groupVoice"].size() != m_groupVoice.size()) {
-        LogError(LOG_HOST, "Generated YAML node for group lists did not match loaded group size! (%u != %u)", newRules["groupVoice"].size(), m_groupVoice.size());
+    if (newRules["groupVoice"].size() != table->size()) {
+        LogError(LOG_HOST, "Generated YAML node for group lists did not match loaded group size! (%u != %u)", newRules["groupVoice"].size(), table->size());
         return false;
     }
 
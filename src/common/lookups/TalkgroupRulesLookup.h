@@ -26,11 +26,33 @@
 #include "common/yaml/Yaml.h"
 #include "common/Utils.h"
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+// ---------------------------------------------------------------------------
+//  Macros
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Creates a get and set property for a list of IDs, does not use "get"/"set". The list is
+ *  also held as a hashed set, for constant time membership checks.
+ * @param variableName Variable name for property.
+ */
+#define __ID_LIST_PROPERTY(variableName)                                                \
+        private: std::vector<uint32_t> m_##variableName;                                \
+                 std::unordered_set<uint32_t> m_##variableName##Set;                    \
+        public: __forceinline const std::vector<uint32_t>& variableName(void) const { return m_##variableName; } \
+                __forceinline void variableName(std::vector<uint32_t> val)              \
+                {                                                                       \
+                    m_##variableName = val;                                             \
+                    m_##variableName##Set = std::unordered_set<uint32_t>(val.begin(), val.end()); \
+                }
+
 namespace lookups
 {
     // ---------------------------------------------------------------------------
@@ -256,6 +278,12 @@ namespace lookups
                     m_permittedRIDs.push_back(radioId);
                 }
             }
+
+            m_inclusionSet = std::unordered_set<uint32_t>(m_inclusion.begin(), m_inclusion.end());
+            m_exclusionSet = std::unordered_set<uint32_t>(m_exclusion.begin(), m_exclusion.end());
+            m_alwaysSendSet = std::unordered_set<uint32_t>(m_alwaysSend.begin(), m_alwaysSend.end());
+            m_preferredSet = std::unordered_set<uint32_t>(m_preferred.begin(), m_preferred.end());
+            m_permittedRIDsSet = std::unordered_set<uint32_t>(m_permittedRIDs.begin(), m_permittedRIDs.end());
         }
 
         /**
@@ -269,11 +297,16 @@ namespace lookups
                 m_affiliated = data.m_affiliated;
                 m_parrot = data.m_parrot;
                 m_inclusion = data.m_inclusion;
+                m_inclusionSet = data.m_inclusionSet;
                 m_exclusion = data.m_exclusion;
+                m_exclusionSet = data.m_exclusionSet;
                 m_rewrite = data.m_rewrite;
                 m_alwaysSend = data.m_alwaysSend;
+                m_alwaysSendSet = data.m_alwaysSendSet;
                 m_preferred = data.m_preferred;
+                m_preferredSet = data.m_preferredSet;
                 m_permittedRIDs = data.m_permittedRIDs;
+                m_permittedRIDsSet = data.m_permittedRIDsSet;
                 m_nonPreferred = data.m_nonPreferred;
             }
 
@@ -311,6 +344,37 @@ namespace lookups
          */
         uint8_t permittedRIDsSize() const { return m_permittedRIDs.size(); }
 
+        /**
+         * @brief Helper to determine if the given peer ID is on the inclusion list.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer ID is included by this rule, otherwise false.
+         */
+        bool isIncluded(uint32_t peerId) const { return m_inclusionSet.find(peerId) != m_inclusionSet.end(); }
+        /**
+         * @brief Helper to determine if the given peer ID is on the exclusion list.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer ID is excluded by this rule, otherwise false.
+         */
+        bool isExcluded(uint32_t peerId) const { return m_exclusionSet.find(peerId) != m_exclusionSet.end(); }
+        /**
+         * @brief Helper to determine if the given peer ID is on the always send list.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer ID always receives traffic for this rule, otherwise false.
+         */
+        bool isAlwaysSend(uint32_t peerId) const { return m_alwaysSendSet.find(peerId) != m_alwaysSendSet.end(); }
+        /**
+         * @brief Helper to determine if the given peer ID is on the preferred list.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer ID is preferred by this rule, otherwise false.
+         */
+        bool isPreferred(uint32_t peerId) const { return m_preferredSet.find(peerId) != m_preferredSet.end(); }
+        /**
+         * @brief Helper to determine if the given radio ID is on the permitted RIDs list.
+         * @param radioId Radio ID.
+         * @returns bool True, if the radio ID is permitted to transmit on the talkgroup, otherwise false.
+         */
+        bool isRIDPermitted(uint32_t radioId) const { return m_permittedRIDsSet.find(radioId) != m_permittedRIDsSet.end(); }
+
         /**
          * @brief Return the YAML structure for this TalkgroupRuleConfig.
          * @param[out] node YAML node.
@@ -394,28 +458,30 @@ namespace lookups
         /**
          * @brief List of peer IDs included by this rule.
          */
-        __PROPERTY_PLAIN(std::vector<uint32_t>, inclusion);
+        __ID_LIST_PROPERTY(inclusion);
         /**
          * @brief List of peer IDs excluded by this rule.
          */
-        __PROPERTY_PLAIN(std::vector<uint32_t>, exclusion);
+        __ID_LIST_PROPERTY(exclusion);
         /**
          * @brief List of rewrites performed by this rule.
          */
-        __PROPERTY_PLAIN(std::vector<TalkgroupRuleRewrite>, rewrite);
+        private: std::vector<TalkgroupRuleRewrite> m_rewrite;
+        public: const std::vector<TalkgroupRuleRewrite>& rewrite() const { return m_rewrite; }
+                void rewrite(std::vector<TalkgroupRuleRewrite> val) { m_rewrite = val; }
         /**
          * @brief List of always send performed by this rule.
          */
-        __PROPERTY_PLAIN(std::vector<uint32_t>, alwaysSend);
+        __ID_LIST_PROPERTY(alwaysSend);
         /**
          * @brief List of peer IDs preferred by this rule.
          */
-        __PROPERTY_PLAIN(std::vector<uint32_t>, preferred);
+        __ID_LIST_PROPERTY(preferred);
 
         /**
          * @brief List of radios IDs permitted to transmit on the talkgroup.
          */
-        __PROPERTY_PLAIN(std::vector<uint32_t>, permittedRIDs);
+        __ID_LIST_PROPERTY(permittedRIDs);
 
         /**
          * @brief Flag indicating whether or not the talkgroup is a non-preferred.
@@ -514,11 +580,108 @@ namespace lookups
         /**
          * @brief Configuration for the routing rule.
          */
-        __PROPERTY_PLAIN(TalkgroupRuleConfig, config);
+        private: TalkgroupRuleConfig m_config;
+        public: const TalkgroupRuleConfig& config() const { return m_config; }
+                void config(TalkgroupRuleConfig val) { m_config = val; }
         /**
          * @brief Source talkgroup information for the routing rule.
          */
-        __PROPERTY_PLAIN(TalkgroupRuleGroupVoiceSource, source);
+        private: TalkgroupRuleGroupVoiceSource m_source;
+        public: const TalkgroupRuleGroupVoiceSource& source() const { return m_source; }
+                void source(TalkgroupRuleGroupVoiceSource val) { m_source = val; }
+    };
+
+    /**
+     * @brief Shared immutable handle to a group voice routing rule.
+     *  (The handle keeps the rules table the rule belongs to alive, and remains valid across reloads of
+     *   the rules.)
+     * @ingroup lookups_tgid
+     */
+    typedef std::shared_ptr<const TalkgroupRuleGroupVoice> TalkgroupRuleGroupVoiceHandle;
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents an immutable, indexed version of the talkgroup rules table.
+     *  Rules are indexed by source (TGID, slot) and by rewrite (peer ID, rewritten TGID, slot), where
+     *  a slot of 0 matches any slot; when several rules match, the first rule in the table wins.
+     * @ingroup lookups_tgid
+     */
+    class HOST_SW_API TalkgroupRulesTable {
+    public:
+        /**
+         * @brief Initializes a new instance of the TalkgroupRulesTable class.
+         */
+        TalkgroupRulesTable();
+        /**
+         * @brief Initializes a new instance of the TalkgroupRulesTable class.
+         * @param groupVoice List of group voice rules.
+         */
+        explicit TalkgroupRulesTable(std::vector<TalkgroupRuleGroupVoice> groupVoice);
+
+        /**
+         * @brief Gets the list of group voice rules.
+         * @returns std::vector<TalkgroupRuleGroupVoice> List of group voice rules.
+         */
+        const std::vector<TalkgroupRuleGroupVoice>& groupVoice() const { return m_groupVoice; }
+        /**
+         * @brief Gets the count of group voice rules.
+         * @returns size_t Number of group voice rules.
+         */
+        size_t size() const { return m_groupVoice.size(); }
+
+        /**
+         * @brief Finds a group voice rule by source talkgroup.
+         * @param id Talkgroup ID.
+         * @param slot DMR slot this talkgroup is valid on (0 matches any slot).
+         * @returns TalkgroupRuleGroupVoice* Group voice rule, or nullptr if no rule matches.
+         */
+        const TalkgroupRuleGroupVoice* find(uint32_t id, uint8_t slot = 0U) const;
+        /**
+         * @brief Finds a group voice rule by rewrite.
+         * @param peerId Peer ID the rewrite applies to.
+         * @param id Rewritten talkgroup ID.
+         * @param slot DMR slot this talkgroup is valid on (0 matches any slot).
+         * @returns TalkgroupRuleGroupVoice* Group voice rule, or nullptr if no rule matches.
+         */
+        const TalkgroupRuleGroupVoice* findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot = 0U) const;
+
+    private:
+        std::vector<TalkgroupRuleGroupVoice> m_groupVoice;
+
+        /**
+         * @brief Represents the key of the rewrite index.
+         */
+        struct RewriteKey {
+            uint32_t peerId;
+            uint32_t tgId;
+            uint8_t slot;
+
+            bool operator==(const RewriteKey& key) const { return peerId == key.peerId && tgId == key.tgId && slot == key.slot; }
+        };
+        /**
+         * @brief Hash function for the rewrite index.
+         */
+        struct RewriteKeyHash {
+            size_t operator()(const RewriteKey& key) const
+            {
+                uint64_t k = ((uint64_t)key.peerId << 32) | ((uint64_t)key.tgId ^ ((uint64_t)key.slot << 24));
+                return std::hash<uint64_t>()(k);
+            }
+        };
+
+        std::unordered_map<uint64_t, size_t> m_sourceIndex;
+        std::unordered_map<RewriteKey, size_t, RewriteKeyHash> m_rewriteIndex;
+
+        /**
+         * @brief Helper to generate the key of the source index.
+         * @param id Talkgroup ID.
+         * @param slot DMR slot.
+         * @returns uint64_t Source index key.
+         */
+        static uint64_t sourceKey(uint32_t id, uint8_t slot) { return ((uint64_t)id << 8) | slot; }
     };
 
     // ---------------------------------------------------------------------------
@@ -528,10 +691,17 @@ namespace lookups
     /**
      * @brief Implements a threading lookup table class that contains routing
      *  rules information.
+     *  The rules are published as an immutable, indexed snapshot; a (re)load parses into a fresh table
+     *  off to the side and publishes it with a single atomic pointer swap, and modifications copy the
+     *  list of rules, modify the copy and publish a newly indexed table. Readers never block, and never
+     *  observe a partially loaded table.
      * @ingroup lookups_tgid
      */
     class HOST_SW_API TalkgroupRulesLookup : public Thread {
     public:
+        typedef std::vector<TalkgroupRuleGroupVoice> GroupVoiceList;
+        typedef std::shared_ptr<const TalkgroupRulesTable> TableSnapshot;
+
         /**
          * @brief Initializes a new instance of the TalkgroupRulesLookup class.
          * @param filename Full-path to the routing rules file.
@@ -591,21 +761,33 @@ namespace lookups
          * @param slot DMR slot this talkgroup is valid on.
          */
         void eraseEntry(uint32_t id, uint8_t slot);
+        /**
+         * @brief Adds new entries to the lookup table, replacing any existing entry for the same talkgroup.
+         *  (All entries are added in a single update of the lookup table.)
+         * @param entries List of Group Voice Configuration Blocks.
+         */
+        void addEntries(const GroupVoiceList& entries);
+        /**
+         * @brief Erases existing entries from the lookup table by the specified unique IDs.
+         *  (All entries are erased in a single update of the lookup table.)
+         * @param ids List of unique IDs and the DMR slots they are valid on.
+         */
+        void eraseEntries(const std::vector<std::pair<uint32_t, uint8_t>>& ids);
         /**
          * @brief Finds a table entry in this lookup table.
          * @param id Unique identifier for table entry.
          * @param slot DMR slot this talkgroup is valid on.
-         * @returns TalkgroupRuleGroupVoice Table entry.
+         * @returns TalkgroupRuleGroupVoiceHandle Table entry (an invalid entry, if no entry matches).
          */
-        virtual TalkgroupRuleGroupVoice find(uint32_t id, uint8_t slot = 0U);
+        TalkgroupRuleGroupVoiceHandle find(uint32_t id, uint8_t slot = 0U) const;
         /**
          * @brief Finds a table entry in this lookup table by rewrite.
          * @param peerId Unique identifier for table entry.
          * @param id Unique identifier for table entry.
          * @param slot DMR slot this talkgroup is valid on.
-         * @return TalkgroupRuleGroupVoice Table entry.
+         * @return TalkgroupRuleGroupVoiceHandle Table entry (an invalid entry, if no entry matches).
          */
-        virtual TalkgroupRuleGroupVoice findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot = 0U);
+        TalkgroupRuleGroupVoiceHandle findByRewrite(uint32_t peerId, uint32_t id, uint8_t slot = 0U) const;
 
         /**
          * @brief Saves loaded talkgroup rules.
@@ -635,16 +817,62 @@ namespace lookups
          */
         void setReloadTime(uint32_t reloadTime) { m_reloadTime = reloadTime; }
 
+        /**
+         * @brief Gets the generation counter of this lookup table.
+         *  (The generation is incremented every time the table is modified, and can be used to
+         *   detect when data derived from the rules must be recalculated.)
+         * @returns uint32_t Table generation.
+         */
+        uint32_t generation() const { return m_generation.load(); }
+
+        /**
+         * @brief Gets the current snapshot of the group voice rules.
+         *  (The snapshot is immutable and remains valid for as long as it is held; each thread caches
+         *   the snapshot it last took, and only reloads it when a new table has been published.)
+         * @returns TableSnapshot Current group voice rules snapshot.
+         */
+        TableSnapshot snapshot() const;
+        /**
+         * @brief Gets the amount of time the last (re)load of the lookup table took.
+         * @returns uint64_t Time in milliseconds.
+         */
+        uint64_t lastLoadTime() const { return m_lastLoadTime.load(); }
+
     private:
         std::string m_rulesFile;
         uint32_t m_reloadTime;
-        yaml::Node m_rules;
 
         bool m_acl;
         bool m_stop;
 
-        static std::mutex m_mutex;  //! Mutex used for hard locking.
-        static bool m_locked;       //! Flag used for soft locking (prevents find lookups), should be used when atomic operations (add/erase/etc) are being used.
+        std::atomic<uint32_t> m_generation;
+        std::atomic<uint64_t> m_lastLoadTime;
+
+        std::mutex m_mutex;         //! Mutex used to serialize table writers.
+        TableSnapshot m_table;
+        std::atomic<uint64_t> m_version;
+
+        /**
+         * @brief Helper to index and publish a new list of group voice rules, replacing the current table.
+         *  (This must be called with the table mutex held.)
+         * @param groupVoice New list of group voice rules.
+         */
+        void publish(GroupVoiceList groupVoice);
+        /**
+         * @brief Helper to modify the group voice rules; the list is copied, the modification is
+         *  applied to the copy, and the copy is published.
+         * @tparam Fn Modification function, with the signature void(GroupVoiceList&).
+         * @param fn Modification function.
+         */
+        template <typename Fn>
+        void modify(Fn fn)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            GroupVoiceList groupVoice = std::atomic_load_explicit(&m_table, std::memory_order_acquire)->groupVoice();
+            fn(groupVoice);
+            publish(std::move(groupVoice));
+        }
 
         /**
          * @brief Loads the table from the passed lookup table file.
@@ -666,10 +894,17 @@ namespace lookups
          * @brief Flag indicating whether or not the network layer should send the talkgroups to peers.
          */
         __PROPERTY_PLAIN(bool, sendTalkgroups);
+
+        /**
+         * @brief Gets a copy of the list of group voice rules.
+         * @returns std::vector<TalkgroupRuleGroupVoice> List of group voice rules.
+         */
+        std::vector<TalkgroupRuleGroupVoice> groupVoice() const { return snapshot()->groupVoice(); }
         /**
-         * @brief List of group voice rules.
+         * @brief Sets the list of group voice rules.
+         * @param groupVoice List of group voice rules.
          */
-        __PROPERTY_PLAIN(std::vector<TalkgroupRuleGroupVoice>, groupVoice);
+        void groupVoice(std::vector<TalkgroupRuleGroupVoice> groupVoice);
     };
 } // namespace lookups
 
@@ -23,6 +23,7 @@ using namespace network;
 using namespace network::frame;
 
 #include <cassert>
+#include <chrono>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -44,6 +45,7 @@ BaseNetwork::BaseNetwork(uint32_t peerId, bool duplex, bool debug, bool slot1, b
     m_slot1(slot1),
     m_slot2(slot2),
     m_duplex(duplex),
+    m_batchLogTransfer(false),
     m_useAlternatePortForDiagnostics(false),
     m_allowActivityTransfer(allowActivityTransfer),
     m_allowDiagnosticTransfer(allowDiagnosticTransfer),
@@ -58,7 +60,10 @@ BaseNetwork::BaseNetwork(uint32_t peerId, bool duplex, bool debug, bool slot1, b
     m_p25StreamId(0U),
     m_nxdnStreamId(0U),
     m_pktSeq(0U),
-    m_audio()
+    m_audio(),
+    m_logBatchLock(),
+    m_actLogBatch(),
+    m_diagLogBatch()
 {
     assert(peerId < 999999999U);
 
@@ -156,6 +161,21 @@ bool BaseNetwork::writeActLog(const char* message)
 
     assert(message != nullptr);
 
+    if (m_batchLogTransfer) {
+        uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+        // the batch is written outside of the lock; writing to the network may itself log
+        TransferBatch batch;
+        {
+            std::lock_guard<std::mutex> lock(m_logBatchLock);
+            if (!m_actLogBatch.add(message, now))
+                return true;
+            std::swap(batch, m_actLogBatch);
+        }
+
+        return writeLogBatch(NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY_BATCH, batch);
+    }
+
     char buffer[DATA_PACKET_LENGTH];
     uint32_t len = ::strlen(message);
 
@@ -177,6 +197,21 @@ bool BaseNetwork::writeDiagLog(const char* message)
 
     assert(message != nullptr);
 
+    if (m_batchLogTransfer) {
+        uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+        // the batch is written outside of the lock; writing to the network may itself log
+        TransferBatch batch;
+        {
+            std::lock_guard<std::mutex> lock(m_logBatchLock);
+            if (!m_diagLogBatch.add(message, now))
+                return true;
+            std::swap(batch, m_diagLogBatch);
+        }
+
+        return writeLogBatch(NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG_BATCH, batch);
+    }
+
     char buffer[DATA_PACKET_LENGTH];
     uint32_t len = ::strlen(message);
 
@@ -1187,3 +1222,63 @@ UInt8Array BaseNetwork::createNXDN_Message(uint32_t& length, const nxdn::lc::RTC
     length = (count + PACKET_PAD);
     return UInt8Array(buffer);
 }
+
+/* Writes the pending activity and diagnostic log batches to the network. */
+
+void BaseNetwork::writeLogBatches(bool all)
+{
+    uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    // the batches are written outside of the lock; writing to the network may itself log
+    TransferBatch actLogBatch, diagLogBatch;
+    {
+        std::lock_guard<std::mutex> lock(m_logBatchLock);
+        if (!m_actLogBatch.empty() && (all || m_actLogBatch.expired(now)))
+            std::swap(actLogBatch, m_actLogBatch);
+        if (!m_diagLogBatch.empty() && (all || m_diagLogBatch.expired(now)))
+            std::swap(diagLogBatch, m_diagLogBatch);
+    }
+
+    if (!actLogBatch.empty())
+        writeLogBatch(NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY_BATCH, actLogBatch);
+    if (!diagLogBatch.empty())
+        writeLogBatch(NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG_BATCH, diagLogBatch);
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to write a log batch to the network. */
+
+bool BaseNetwork::writeLogBatch(NET_SUBFUNC::ENUM subFunc, const TransferBatch& batch)
+{
+    if (m_status != NET_STAT_RUNNING && m_status != NET_STAT_MST_RUNNING)
+        return false;
+
+    if (m_batchLogTransfer) {
+        uint32_t length = 0U;
+        UInt8Array buffer = batch.encode(length);
+        if (buffer != nullptr) {
+            return writeMaster({ NET_FUNC::TRANSFER, subFunc }, buffer.get(), length, RTP_END_OF_CALL_SEQ, 0U, false, m_useAlternatePortForDiagnostics);
+        }
+    }
+
+    // the batch didn't compress into a single message (or the master doesn't accept batches), write the
+    // lines individually
+    NET_SUBFUNC::ENUM lineSubFunc = (subFunc == NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG_BATCH) ? NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG :
+        NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY;
+
+    bool ret = true;
+    uint8_t lineBuffer[DATA_PACKET_LENGTH];
+    for (const std::string& line : batch.lines()) {
+        uint32_t len = (uint32_t)line.size();
+        if (len > DATA_PACKET_LENGTH - 11U)
+            len = DATA_PACKET_LENGTH - 11U;
+
+        ::memcpy(lineBuffer + 11U, line.data(), len);
+        ret &= writeMaster({ NET_FUNC::TRANSFER, lineSubFunc }, lineBuffer, len + 11U, RTP_END_OF_CALL_SEQ, 0U, false, m_useAlternatePortForDiagnostics);
+    }
+
+    return ret;
+}
@@ -34,11 +34,13 @@
 #include "common/network/FrameQueue.h"
 #include "common/network/json/json.h"
 #include "common/network/udp/Socket.h"
+#include "common/network/TransferBatch.h"
 #include "common/RingBuffer.h"
 #include "common/Utils.h"
 
 #include <string>
 #include <cstdint>
+#include <mutex>
 #include <random>
 #include <unordered_map>
 
@@ -183,6 +185,8 @@ namespace network
 
         /**
          * @brief Writes the local activity log to the network.
+         *  If the master accepts batched log transfers, the message is added to the pending activity log
+         *  batch instead, and is sent when the batch is full or has been held long enough.
          * @param message Textual string to send as activity log information.
          * @returns bool True, if message was sent, otherwise false. 
          */
@@ -190,6 +194,8 @@ namespace network
 
         /**
          * @brief Writes the local diagnostic logs to the network.
+         *  If the master accepts batched log transfers, the message is added to the pending diagnostic log
+         *  batch instead, and is sent when the batch is full or has been held long enough.
          * @param message Textual string to send as diagnostic log information.
          * @returns bool True, if message was sent, otherwise false. 
          */
@@ -473,6 +479,11 @@ namespace network
          */
         __PROTECTED_READONLY_PROPERTY(bool, duplex, Duplex);
 
+        /**
+         * @brief Flag indicating whether the master accepts batched activity and diagnostic log transfers.
+         */
+        __PROTECTED_READONLY_PROPERTY_PLAIN(bool, batchLogTransfer);
+
     protected:
         bool m_useAlternatePortForDiagnostics;
 
@@ -731,10 +742,30 @@ namespace network
          */
         UInt8Array createNXDN_Message(uint32_t& length, const nxdn::lc::RTCH& lc, const uint8_t* data, const uint32_t len);
     
+        /**
+         * @brief Writes the pending activity and diagnostic log batches to the network.
+         * @param all Flag indicating all pending batches should be written, not just those held long enough.
+         */
+        void writeLogBatches(bool all);
+
     private:
         uint16_t m_pktSeq;
 
         p25::Audio m_audio;
+
+        std::mutex m_logBatchLock;
+        TransferBatch m_actLogBatch;
+        TransferBatch m_diagLogBatch;
+
+        /**
+         * @brief Helper to write a log batch to the network.
+         *  If the batch cannot be compressed into a single message, or the master doesn't accept batches,
+         *  the lines are written individually.
+         * @param subFunc Transfer sub-function of the batch.
+         * @param batch Log batch.
+         * @returns bool True, if the batch was sent, otherwise false.
+         */
+        bool writeLogBatch(NET_SUBFUNC::ENUM subFunc, const TransferBatch& batch);
     };
 } // namespace network
 
@@ -11,6 +11,7 @@
 #include "edac/CRC.h"
 #include "network/BaseNetwork.h"
 #include "network/FrameQueue.h"
+#include "network/PacketBuffer.h"
 #include "network/RTPHeader.h"
 #include "network/RTPExtensionHeader.h"
 #include "network/RTPFNEHeader.h"
@@ -29,10 +30,53 @@ using namespace network::frame;
 
 std::mutex FrameQueue::m_fqTimestampLock;
 
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define FANOUT_PAYLOAD_OFFSET (RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES)
+#define FANOUT_CRC_OFFSET (RTP_HEADER_LENGTH_BYTES + 4U)
+#define FANOUT_PEER_ID_OFFSET (RTP_HEADER_LENGTH_BYTES + 12U)
+#define FANOUT_DST_ID_OFFSET 8U
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
 
+/* Initializes a new instance of the FanoutFrame class. */
+
+FanoutFrame::FanoutFrame() :
+    m_buffer(nullptr),
+    m_bufferLen(0U),
+    m_messageLength(0U),
+    m_streamId(0U),
+    m_rewriteDstId(0U),
+    m_rewriteCRC(0U)
+{
+    /* stub */
+}
+
+/* Finalizes a instance of the FanoutFrame class. */
+
+FanoutFrame::~FanoutFrame()
+{
+    reset();
+}
+
+/* Helper to release the encoded message. */
+
+void FanoutFrame::reset()
+{
+    if (m_buffer != nullptr)
+        PacketBufferPool::release(m_buffer);
+    m_buffer = nullptr;
+    m_bufferLen = 0U;
+    m_messageLength = 0U;
+    m_streamId = 0U;
+    m_rewriteDstId = 0U;
+    m_rewriteCRC = 0U;
+}
+
 /* Initializes a new instance of the FrameQueue class. */
 
 FrameQueue::FrameQueue(udp::Socket* socket, uint32_t peerId, bool debug) : RawFrameQueue(socket, debug),
@@ -47,9 +91,6 @@ FrameQueue::FrameQueue(udp::Socket* socket, uint32_t peerId, bool debug) : RawFr
 UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
     RTPHeader* rtpHeader, RTPFNEHeader* fneHeader)
 {
-    RTPHeader _rtpHeader = RTPHeader();
-    RTPFNEHeader _fneHeader = RTPFNEHeader();
-
     messageLength = -1;
 
     // read message from socket
@@ -57,13 +98,7 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
     ::memset(buffer, 0x00U, DATA_PACKET_LENGTH);
     int length = m_socket->read(buffer, DATA_PACKET_LENGTH, address, addrLen);
     if (length < 0) {
-        if (m_failedReadCnt <= MAX_FAILED_READ_CNT_LOGGING)
-            LogError(LOG_NET, "Failed reading data from the network, failedCnt = %u", m_failedReadCnt);
-        else {
-            if (m_failedReadCnt == MAX_FAILED_READ_CNT_LOGGING + 1U)
-                LogError(LOG_NET, "Failed reading data from the network -- exceeded 5 read errors, probable connection issue, silencing further errors");
-        }
-        m_failedReadCnt++;
+        readFailed();
         return nullptr;
     }
 
@@ -73,62 +108,52 @@ UInt8Array FrameQueue::read(int& messageLength, sockaddr_storage& address, uint3
 
         m_failedReadCnt = 0U;
 
-        if (length < RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES) {
-            LogError(LOG_NET, "FrameQueue::read(), message received from network is malformed! %u bytes != %u bytes", 
-                RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES, length);
-            return nullptr;
-        }
+        return decodeMessage(buffer, (uint32_t)length, messageLength, rtpHeader, fneHeader);
+    }
 
-        // decode RTP header
-        if (!_rtpHeader.decode(buffer)) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid RTP packet received from network");
-            return nullptr;
-        }
+    return nullptr;
+}
 
-        // ensure the RTP header has extension header (otherwise abort)
-        if (!_rtpHeader.getExtension()) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid RTP header received from network");
-            return nullptr;
-        }
+/* Read message from a UDP packet received by readBatch(). */
 
-        // ensure payload type is correct
-        if ((_rtpHeader.getPayloadType() != DVM_RTP_PAYLOAD_TYPE) &&
-            (_rtpHeader.getPayloadType() != (DVM_RTP_PAYLOAD_TYPE + 1U))) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid RTP payload type received from network");
-            return nullptr;
-        }
+UInt8Array FrameQueue::readBatchMessage(uint32_t n, int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
+    RTPHeader* rtpHeader, RTPFNEHeader* fneHeader)
+{
+    messageLength = -1;
+    if (n >= m_rxBatchCnt)
+        return nullptr;
 
-        if (rtpHeader != nullptr) {
-            *rtpHeader = _rtpHeader;
-        }
+    udp::UDPDatagram& dgram = m_rxBatch[n];
+    address = dgram.address;
+    addrLen = dgram.addrLen;
 
-        // decode FNE RTP header
-        if (!_fneHeader.decode(buffer + RTP_HEADER_LENGTH_BYTES)) {
-            LogError(LOG_NET, "FrameQueue::read(), invalid RTP packet received from network");
-            return nullptr;
-        }
+    if (m_debug)
+        Utils::dump(1U, "Network Packet", dgram.buffer, dgram.length);
 
-        if (fneHeader != nullptr) {
-            *fneHeader = _fneHeader;
-        }
+    return decodeMessage(dgram.buffer, (uint32_t)dgram.length, messageLength, rtpHeader, fneHeader);
+}
 
-        // copy message
-        messageLength = _fneHeader.getMessageLength();
-        UInt8Array message = std::unique_ptr<uint8_t[]>(new uint8_t[messageLength]);
-        ::memcpy(message.get(), buffer + (RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES), messageLength);
+/* Read message from a UDP packet received by readBatch(), without copying it. */
 
-        uint16_t calc = edac::CRC::createCRC16(message.get(), messageLength * 8U);
-        if (calc != _fneHeader.getCRC()) {
-            LogError(LOG_NET, "FrameQueue::read(), failed CRC CCITT-162 check");
-            messageLength = -1;
-            return nullptr;
-        }
+PacketBuffer FrameQueue::readBatchPacket(uint32_t n, sockaddr_storage& address, uint32_t& addrLen,
+    RTPHeader* rtpHeader, RTPFNEHeader* fneHeader)
+{
+    if (n >= m_rxBatchCnt)
+        return PacketBuffer();
 
-        // LogDebug(LOG_NET, "message buffer, addr %p len %u", message.get(), messageLength);
-        return message;
-    }
+    udp::UDPDatagram& dgram = m_rxBatch[n];
+    address = dgram.address;
+    addrLen = dgram.addrLen;
 
-    return nullptr;
+    if (m_debug)
+        Utils::dump(1U, "Network Packet", dgram.buffer, dgram.length);
+
+    uint32_t payloadOffset = 0U, messageLength = 0U;
+    if (!validateMessage(dgram.buffer, (uint32_t)dgram.length, payloadOffset, messageLength, rtpHeader, fneHeader))
+        return PacketBuffer();
+
+    // the view holds a reference to the receive buffer, which is replaced by the next readBatch()
+    return PacketBuffer::share(dgram.buffer, payloadOffset, messageLength);
 }
 
 /* Write message to the UDP socket. */
@@ -148,7 +173,7 @@ bool FrameQueue::write(const uint8_t* message, uint32_t length, uint32_t streamI
         ret = false;
     }
 
-    delete[] buffer;
+    PacketBufferPool::release(buffer);
     return ret;
 }
 
@@ -170,14 +195,62 @@ void FrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, uint32_
 
     uint32_t bufferLen = 0U;
     uint8_t* buffer = generateMessage(message, length, streamId, peerId, ssrc, opcode, rtpSeq, &bufferLen);
+    enqueueDatagram(allocDatagram(buffer, bufferLen, addr, addrLen), peerId);
+}
 
-    udp::UDPDatagram *dgram = new udp::UDPDatagram;
-    dgram->buffer = buffer;
-    dgram->length = bufferLen;
-    dgram->address = addr;
-    dgram->addrLen = addrLen;
+/* Prepare a message for fan-out to many peers. */
 
-    m_buffers.push_back(dgram);
+void FrameQueue::prepareFanout(FanoutFrame& frame, const uint8_t* message, uint32_t length, uint32_t streamId,
+    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq)
+{
+    assert(message != nullptr);
+    assert(length > 0U);
+
+    frame.reset();
+
+    // the peer ID is patched per destination when the frame is enqueued
+    frame.m_buffer = generateMessage(message, length, streamId, 0U, ssrc, opcode, rtpSeq, &frame.m_bufferLen);
+    frame.m_messageLength = length;
+    frame.m_streamId = streamId;
+}
+
+/* Cache a prepared fan-out message to frame queue for a single peer. */
+
+void FrameQueue::enqueueFanout(FanoutFrame& frame, uint32_t peerId, uint32_t ssrc, uint16_t rtpSeq,
+    sockaddr_storage& addr, uint32_t addrLen, uint32_t rewriteDstId)
+{
+    assert(frame.isPrepared());
+
+    uint8_t* buffer = PacketBufferPool::alloc(frame.m_bufferLen);
+    ::memcpy(buffer, frame.m_buffer, frame.m_bufferLen);
+
+    // patch the RTP header
+    buffer[2U] = (rtpSeq >> 8) & 0xFFU;                                         // Sequence MSB
+    buffer[3U] = (rtpSeq >> 0) & 0xFFU;                                         // Sequence LSB
+    __SET_UINT32(ssrc, buffer, 8U);                                             // Synchronization Source Identifier
+
+    // patch the FNE header
+    __SET_UINT32(peerId, buffer, FANOUT_PEER_ID_OFFSET);                        // Peer ID
+
+    // patch the rewritten destination ID into the payload, and update the payload CRC (the
+    // CRC for the last rewritten destination ID is kept, peers commonly share a rewrite)
+    if (rewriteDstId != 0U && frame.m_messageLength >= FANOUT_DST_ID_OFFSET + 3U) {
+        uint8_t* payload = buffer + FANOUT_PAYLOAD_OFFSET;
+        __SET_UINT16(rewriteDstId, payload, FANOUT_DST_ID_OFFSET);
+
+        if (frame.m_rewriteDstId != rewriteDstId) {
+            frame.m_rewriteCRC = edac::CRC::createCRC16(payload, frame.m_messageLength * 8U);
+            frame.m_rewriteDstId = rewriteDstId;
+        }
+
+        buffer[FANOUT_CRC_OFFSET] = (frame.m_rewriteCRC >> 8) & 0xFFU;         // CRC-16 MSB
+        buffer[FANOUT_CRC_OFFSET + 1U] = (frame.m_rewriteCRC >> 0) & 0xFFU;    // CRC-16 LSB
+    }
+
+    if (m_debug)
+        Utils::dump(1U, "FrameQueue::enqueueFanout() Buffered Message", buffer, frame.m_bufferLen);
+
+    enqueueDatagram(allocDatagram(buffer, frame.m_bufferLen, addr, addrLen), peerId);
 }
 
 /* Helper method to clear any tracked stream timestamps. */
@@ -192,14 +265,10 @@ void FrameQueue::clearTimestamps()
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* Generate RTP message for the frame queue. */
+/* Helper to encode the RTP header, advancing the tracked timestamp for the given stream. */
 
-uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
-    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, uint32_t* outBufferLen)
+void FrameQueue::encodeRTPHeader(uint8_t* buffer, uint32_t streamId, uint32_t ssrc, uint16_t rtpSeq)
 {
-    assert(message != nullptr);
-    assert(length > 0U);
-
     uint32_t timestamp = INVALID_TS;
     if (streamId != 0U) {
         std::lock_guard<std::mutex> lock(m_fqTimestampLock);
@@ -211,15 +280,11 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
         if (timestamp != INVALID_TS) {
             timestamp += (RTP_GENERIC_CLOCK_RATE / 133);
             if (m_debug)
-                LogDebugEx(LOG_NET, "FrameQueue::generateMessage()", "RTP streamId = %u, previous TS = %u, TS = %u, rtpSeq = %u", streamId, m_streamTimestamps[streamId], timestamp, rtpSeq);
+                LogDebugEx(LOG_NET, "FrameQueue::encodeRTPHeader()", "RTP streamId = %u, previous TS = %u, TS = %u, rtpSeq = %u", streamId, m_streamTimestamps[streamId], timestamp, rtpSeq);
             m_streamTimestamps[streamId] = timestamp;
         }
     }
 
-    uint32_t bufferLen = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES + length;
-    uint8_t* buffer = new uint8_t[bufferLen];
-    ::memset(buffer, 0x00U, bufferLen);
-
     RTPHeader header = RTPHeader();
     header.setExtension(true);
 
@@ -232,7 +297,8 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
 
     if (streamId != 0U && timestamp == INVALID_TS && rtpSeq != RTP_END_OF_CALL_SEQ) {
         if (m_debug)
-            LogDebugEx(LOG_NET, "FrameQueue::generateMessage()", "RTP streamId = %u, initial TS = %u, rtpSeq = %u", streamId, header.getTimestamp(), rtpSeq);
+            LogDebugEx(LOG_NET, "FrameQueue::encodeRTPHeader()", "RTP streamId = %u, initial TS = %u, rtpSeq = %u", streamId, header.getTimestamp(), rtpSeq);
+        std::lock_guard<std::mutex> lock(m_fqTimestampLock);
         m_streamTimestamps[streamId] = header.getTimestamp();
     }
 
@@ -241,10 +307,111 @@ uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, ui
         auto entry = m_streamTimestamps.find(streamId);
         if (entry != m_streamTimestamps.end()) {
             if (m_debug)
-                LogDebugEx(LOG_NET, "FrameQueue::generateMessage()", "RTP streamId = %u, rtpSeq = %u", streamId, rtpSeq);
+                LogDebugEx(LOG_NET, "FrameQueue::encodeRTPHeader()", "RTP streamId = %u, rtpSeq = %u", streamId, rtpSeq);
             m_streamTimestamps.erase(streamId);
         }
     }
+}
+
+/* Validate a RTP message from a received UDP packet. */
+
+bool FrameQueue::validateMessage(const uint8_t* buffer, uint32_t length, uint32_t& payloadOffset, uint32_t& messageLength,
+    RTPHeader* rtpHeader, RTPFNEHeader* fneHeader)
+{
+    RTPHeader _rtpHeader = RTPHeader();
+    RTPFNEHeader _fneHeader = RTPFNEHeader();
+
+    if (length < RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES) {
+        LogError(LOG_NET, "FrameQueue::read(), message received from network is malformed! %u bytes != %u bytes", 
+            RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES, length);
+        return false;
+    }
+
+    // decode RTP header
+    if (!_rtpHeader.decode(buffer)) {
+        LogError(LOG_NET, "FrameQueue::read(), invalid RTP packet received from network");
+        return false;
+    }
+
+    // ensure the RTP header has extension header (otherwise abort)
+    if (!_rtpHeader.getExtension()) {
+        LogError(LOG_NET, "FrameQueue::read(), invalid RTP header received from network");
+        return false;
+    }
+
+    // ensure payload type is correct
+    if ((_rtpHeader.getPayloadType() != DVM_RTP_PAYLOAD_TYPE) &&
+        (_rtpHeader.getPayloadType() != (DVM_RTP_PAYLOAD_TYPE + 1U))) {
+        LogError(LOG_NET, "FrameQueue::read(), invalid RTP payload type received from network");
+        return false;
+    }
+
+    if (rtpHeader != nullptr) {
+        *rtpHeader = _rtpHeader;
+    }
+
+    // decode FNE RTP header
+    if (!_fneHeader.decode(buffer + RTP_HEADER_LENGTH_BYTES)) {
+        LogError(LOG_NET, "FrameQueue::read(), invalid RTP packet received from network");
+        return false;
+    }
+
+    if (fneHeader != nullptr) {
+        *fneHeader = _fneHeader;
+    }
+
+    // ensure the message fits within the received packet
+    payloadOffset = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
+    if (_fneHeader.getMessageLength() > length || payloadOffset > length - _fneHeader.getMessageLength()) {
+        LogError(LOG_NET, "FrameQueue::read(), message received from network is truncated! %u bytes > %u bytes",
+            payloadOffset + _fneHeader.getMessageLength(), length);
+        return false;
+    }
+
+    messageLength = _fneHeader.getMessageLength();
+
+    uint16_t calc = edac::CRC::createCRC16(buffer + payloadOffset, messageLength * 8U);
+    if (calc != _fneHeader.getCRC()) {
+        LogError(LOG_NET, "FrameQueue::read(), failed CRC CCITT-162 check");
+        return false;
+    }
+
+    return true;
+}
+
+/* Decode and validate a RTP message from a received UDP packet. */
+
+UInt8Array FrameQueue::decodeMessage(const uint8_t* buffer, uint32_t length, int& messageLength,
+    RTPHeader* rtpHeader, RTPFNEHeader* fneHeader)
+{
+    messageLength = -1;
+
+    uint32_t payloadOffset = 0U, payloadLength = 0U;
+    if (!validateMessage(buffer, length, payloadOffset, payloadLength, rtpHeader, fneHeader))
+        return nullptr;
+
+    // copy message
+    messageLength = (int)payloadLength;
+    UInt8Array message = std::unique_ptr<uint8_t[]>(new uint8_t[payloadLength]);
+    ::memcpy(message.get(), buffer + payloadOffset, payloadLength);
+
+    // LogDebug(LOG_NET, "message buffer, addr %p len %u", message.get(), messageLength);
+    return message;
+}
+
+/* Generate RTP message for the frame queue. */
+
+uint8_t* FrameQueue::generateMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
+    uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, uint32_t* outBufferLen)
+{
+    assert(message != nullptr);
+    assert(length > 0U);
+
+    uint32_t bufferLen = RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES + length;
+    uint8_t* buffer = PacketBufferPool::alloc(bufferLen);
+    ::memset(buffer, 0x00U, bufferLen);
+
+    encodeRTPHeader(buffer, streamId, ssrc, rtpSeq);
 
     RTPFNEHeader fneHeader = RTPFNEHeader();
     fneHeader.setCRC(edac::CRC::createCRC16(message, length * 8U));
@@ -19,6 +19,7 @@
 #include "common/Defines.h"
 #include "common/network/RTPHeader.h"
 #include "common/network/RTPFNEHeader.h"
+#include "common/network/PacketBuffer.h"
 #include "common/network/RawFrameQueue.h"
 
 #include <mutex>
@@ -36,6 +37,60 @@ namespace network
     //  Class Declaration
     // ---------------------------------------------------------------------------
 
+    /**
+     * @brief Represents a RTP message that has been encoded once, for repeating to many peers.
+     *  The RTP header, FNE header, payload and payload CRC are generated once by FrameQueue::prepareFanout();
+     *  FrameQueue::enqueueFanout() then only copies the encoded message and patches the fields that differ
+     *  per destination peer.
+     * @ingroup network_core
+     */
+    class HOST_SW_API FanoutFrame {
+    public:
+        auto operator=(FanoutFrame&) -> FanoutFrame& = delete;
+        auto operator=(FanoutFrame&&) -> FanoutFrame& = delete;
+        FanoutFrame(FanoutFrame&) = delete;
+
+        /**
+         * @brief Initializes a new instance of the FanoutFrame class.
+         */
+        FanoutFrame();
+        /**
+         * @brief Finalizes a instance of the FanoutFrame class.
+         */
+        ~FanoutFrame();
+
+        /**
+         * @brief Helper to determine if the frame has been prepared.
+         * @returns bool True, if the frame has been prepared, otherwise false.
+         */
+        bool isPrepared() const { return m_buffer != nullptr; }
+
+        /**
+         * @brief Gets the stream ID of the prepared frame.
+         * @returns uint32_t Stream ID.
+         */
+        uint32_t streamId() const { return m_streamId; }
+
+    private:
+        friend class FrameQueue;
+        uint8_t* m_buffer;
+        uint32_t m_bufferLen;
+        uint32_t m_messageLength;
+        uint32_t m_streamId;
+
+        uint32_t m_rewriteDstId;
+        uint16_t m_rewriteCRC;
+
+        /**
+         * @brief Helper to release the encoded message.
+         */
+        void reset();
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
     /**
      * @brief Implements the network RTP frame queuing logic.
      * @ingroup network_core
@@ -58,13 +113,38 @@ namespace network
          * @brief Read message from the received UDP packet.
          * @param[out] messageLength Actual length of message read from packet.
          * @param[out] address IP address data read from.
-         * @param[out] addrLen 
+         * @param[out] addrLen Length of address structure read.
          * @param[out] rtpHeader RTP Header.
          * @param[out] fneHeader FNE Header.
          * @returns UInt8Array Buffer containing message read.
          */
         UInt8Array read(int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
                 frame::RTPHeader* rtpHeader = nullptr, frame::RTPFNEHeader* fneHeader = nullptr);
+        /**
+         * @brief Read message from a UDP packet received by readBatch().
+         * @param n Index of the packet in the received batch.
+         * @param[out] messageLength Actual length of message read from packet.
+         * @param[out] address IP address data read from.
+         * @param[out] addrLen Length of address structure read.
+         * @param[out] rtpHeader RTP Header.
+         * @param[out] fneHeader FNE Header.
+         * @returns UInt8Array Buffer containing message read.
+         */
+        UInt8Array readBatchMessage(uint32_t n, int& messageLength, sockaddr_storage& address, uint32_t& addrLen,
+                frame::RTPHeader* rtpHeader = nullptr, frame::RTPFNEHeader* fneHeader = nullptr);
+        /**
+         * @brief Read message from a UDP packet received by readBatch(), without copying it.
+         *  The returned view references the pooled receive buffer directly, and remains valid after
+         *  the next call to readBatch().
+         * @param n Index of the packet in the received batch.
+         * @param[out] address IP address data read from.
+         * @param[out] addrLen Length of address structure read.
+         * @param[out] rtpHeader RTP Header.
+         * @param[out] fneHeader FNE Header.
+         * @returns PacketBuffer View of the message read, or an empty view if the packet is invalid.
+         */
+        PacketBuffer readBatchPacket(uint32_t n, sockaddr_storage& address, uint32_t& addrLen,
+                frame::RTPHeader* rtpHeader = nullptr, frame::RTPFNEHeader* fneHeader = nullptr);
         /**
          * @brief Write message to the UDP socket.
          * @param[in] message Message buffer to frame and queue.
@@ -75,7 +155,7 @@ namespace network
          * @param opcode Opcode.
          * @param rtpSeq RTP Sequence.
          * @param addr IP address to write data to.
-         * @param addrLen 
+         * @param addrLen Length of address structure.
          * @returns bool True, if message was written, otherwise false.
          */
         bool write(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
@@ -90,7 +170,7 @@ namespace network
          * @param opcode Opcode.
          * @param rtpSeq RTP Sequence.
          * @param addr IP address to write data to.
-         * @param addrLen 
+         * @param addrLen Length of address structure.
          */
         void enqueueMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
             OpcodePair opcode, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen);
@@ -104,11 +184,38 @@ namespace network
          * @param opcode Opcode.
          * @param rtpSeq RTP Sequence.
          * @param addr IP address to write data to.
-         * @param addrLen 
+         * @param addrLen Length of address structure.
          */
         void enqueueMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
             uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, sockaddr_storage& addr, uint32_t addrLen);
 
+        /**
+         * @brief Prepare a message for fan-out to many peers.
+         *  This generates the RTP header, FNE header and payload CRC once; the resulting frame is then
+         *  enqueued per peer with enqueueFanout().
+         * @param[out] frame Fan-out frame to prepare.
+         * @param[in] message Message buffer to frame.
+         * @param length Length of message.
+         * @param streamId Message stream ID.
+         * @param ssrc RTP SSRC ID.
+         * @param opcode Opcode.
+         * @param rtpSeq RTP Sequence.
+         */
+        void prepareFanout(FanoutFrame& frame, const uint8_t* message, uint32_t length, uint32_t streamId,
+            uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq);
+        /**
+         * @brief Cache a prepared fan-out message to frame queue for a single peer.
+         * @param frame Prepared fan-out frame.
+         * @param peerId Peer ID.
+         * @param ssrc RTP SSRC ID.
+         * @param rtpSeq RTP Sequence.
+         * @param addr IP address to write data to.
+         * @param addrLen Length of address structure.
+         * @param rewriteDstId Rewritten destination ID to patch into the message payload (0 for no rewrite).
+         */
+        void enqueueFanout(FanoutFrame& frame, uint32_t peerId, uint32_t ssrc, uint16_t rtpSeq,
+            sockaddr_storage& addr, uint32_t addrLen, uint32_t rewriteDstId = 0U);
+
         /**
          * @brief Helper method to clear any tracked stream timestamps.
          */
@@ -119,6 +226,39 @@ namespace network
         std::unordered_map<uint32_t, uint32_t> m_streamTimestamps;
         static std::mutex m_fqTimestampLock;
 
+        /**
+         * @brief Helper to encode the RTP header, advancing the tracked timestamp for the given stream.
+         * @param[out] buffer Buffer to encode the RTP header into.
+         * @param streamId Message stream ID.
+         * @param ssrc RTP SSRC ID.
+         * @param rtpSeq RTP Sequence.
+         */
+        void encodeRTPHeader(uint8_t* buffer, uint32_t streamId, uint32_t ssrc, uint16_t rtpSeq);
+
+        /**
+         * @brief Validate a RTP message from a received UDP packet.
+         * @param[in] buffer Buffer containing the received packet.
+         * @param length Length of the received packet.
+         * @param[out] payloadOffset Offset of the message in the packet.
+         * @param[out] messageLength Length of the message.
+         * @param[out] rtpHeader RTP Header.
+         * @param[out] fneHeader FNE Header.
+         * @returns bool True, if the message is valid, otherwise false.
+         */
+        bool validateMessage(const uint8_t* buffer, uint32_t length, uint32_t& payloadOffset, uint32_t& messageLength,
+            frame::RTPHeader* rtpHeader, frame::RTPFNEHeader* fneHeader);
+        /**
+         * @brief Decode and validate a RTP message from a received UDP packet.
+         * @param[in] buffer Buffer containing the received packet.
+         * @param length Length of the received packet.
+         * @param[out] messageLength Actual length of message read from packet.
+         * @param[out] rtpHeader RTP Header.
+         * @param[out] fneHeader FNE Header.
+         * @returns UInt8Array Buffer containing message read.
+         */
+        UInt8Array decodeMessage(const uint8_t* buffer, uint32_t length, int& messageLength,
+            frame::RTPHeader* rtpHeader, frame::RTPFNEHeader* fneHeader);
+
         /**
          * @brief Generate RTP message for the frame queue.
          * @param[in] message Message buffer to frame and queue.
@@ -129,7 +269,7 @@ namespace network
          * @param opcode Opcode.
          * @param rtpSeq RTP Sequence.
          * @param[out] outBufferLen Length of buffer generated.
-         * @returns uint8_t* Buffer containing RTP message.
+         * @returns uint8_t* Pooled buffer containing RTP message.
          */
         uint8_t* generateMessage(const uint8_t* message, uint32_t length, uint32_t streamId, uint32_t peerId,
             uint32_t ssrc, OpcodePair opcode, uint16_t rtpSeq, uint32_t* outBufferLen);
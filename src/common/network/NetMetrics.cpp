@@ -0,0 +1,494 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/NetMetrics.h"
+
+using namespace network;
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // defined(_MSC_VER)
+
+#if !defined(NO_NET_METRICS)
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define OPCODE_PROBE_LIMIT 8U
+#define PEER_PROBE_LIMIT 16U
+
+/** @brief Names of the processing stages, as exposed in the stage label. */
+static const char* STAGE_NAMES[NetStage::MAX] = { "rx_dispatch", "dispatch_process", "egress_send" };
+
+/** @brief Fixed Prometheus histogram bucket bounds, in microseconds. */
+static const uint64_t EXPOSED_BUCKETS[] = { 10U, 25U, 50U, 100U, 250U, 500U, 1000U, 2500U, 5000U, 10000U,
+    25000U, 50000U, 100000U, 250000U, 500000U, 1000000U, 2500000U };
+static const uint32_t EXPOSED_BUCKET_COUNT = sizeof(EXPOSED_BUCKETS) / sizeof(uint64_t);
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents a keyed counter slot.
+ */
+struct CounterSlot {
+    std::atomic<uint64_t> key;          // 0 marks an empty slot
+    std::atomic<uint64_t> packets;
+    std::atomic<uint64_t> bytes;
+};
+
+/**
+ * @brief Represents the metrics accumulated by a single thread.
+ *  Only the owning thread writes a block, so counters are updated with a relaxed load and store
+ *  rather than an atomic read-modify-write; readers only ever see whole values.
+ */
+struct MetricsBlock {
+    std::atomic<uint64_t> hist[NetStage::MAX][NET_METRICS_BUCKETS];
+    std::atomic<uint64_t> sum[NetStage::MAX];
+    CounterSlot opcodes[NET_METRICS_OPCODE_SLOTS];
+    CounterSlot peers[NET_METRICS_PEER_SLOTS];
+    std::atomic<uint64_t> opcodeOverflow;
+    std::atomic<uint64_t> peerOverflow;
+    bool inUse;
+};
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to increment a counter owned by the calling thread. */
+
+static inline void bump(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/* Helper to get the registry lock. */
+
+static std::mutex& registryLock()
+{
+    // blocks are referenced by threads that may outlive static destruction, the registry is never freed
+    static std::mutex* lock = new std::mutex();
+    return *lock;
+}
+
+/* Helper to get the registry of metrics blocks. */
+
+static std::vector<MetricsBlock*>& registry()
+{
+    static std::vector<MetricsBlock*>* blocks = new std::vector<MetricsBlock*>();
+    return *blocks;
+}
+
+/**
+ * @brief Helper to release a thread's metrics block (for reuse by another thread) on thread exit.
+ */
+struct BlockHolder {
+    MetricsBlock* block = nullptr;
+
+    ~BlockHolder()
+    {
+        if (block != nullptr) {
+            std::lock_guard<std::mutex> lock(registryLock());
+            block->inUse = false;
+        }
+    }
+};
+
+static thread_local BlockHolder t_block;
+
+/* Helper to get the calling thread's metrics block. */
+
+static MetricsBlock* threadBlock()
+{
+    MetricsBlock* block = t_block.block;
+    if (block != nullptr)
+        return block;
+
+    std::lock_guard<std::mutex> lock(registryLock());
+
+    // counters are cumulative, a block released by an exited thread is reused as is
+    for (MetricsBlock* b : registry()) {
+        if (!b->inUse) {
+            block = b;
+            break;
+        }
+    }
+
+    if (block == nullptr) {
+        block = new MetricsBlock();
+        for (uint32_t s = 0U; s < NetStage::MAX; s++) {
+            for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++)
+                block->hist[s][i].store(0U, std::memory_order_relaxed);
+            block->sum[s].store(0U, std::memory_order_relaxed);
+        }
+        for (CounterSlot& slot : block->opcodes) {
+            slot.key.store(0U, std::memory_order_relaxed);
+            slot.packets.store(0U, std::memory_order_relaxed);
+            slot.bytes.store(0U, std::memory_order_relaxed);
+        }
+        for (CounterSlot& slot : block->peers) {
+            slot.key.store(0U, std::memory_order_relaxed);
+            slot.packets.store(0U, std::memory_order_relaxed);
+            slot.bytes.store(0U, std::memory_order_relaxed);
+        }
+        block->opcodeOverflow.store(0U, std::memory_order_relaxed);
+        block->peerOverflow.store(0U, std::memory_order_relaxed);
+        registry().push_back(block);
+    }
+
+    block->inUse = true;
+    t_block.block = block;
+    return block;
+}
+
+/* Helper to find (or claim) the counter slot for the given key in a block owned by the calling thread. */
+
+static CounterSlot* counterSlot(CounterSlot* slots, uint32_t size, uint32_t probeLimit, uint64_t key)
+{
+    uint32_t hash = (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32);
+    for (uint32_t i = 0U; i < probeLimit; i++) {
+        CounterSlot* slot = slots + ((hash + i) & (size - 1U));
+        uint64_t slotKey = slot->key.load(std::memory_order_relaxed);
+        if (slotKey == key)
+            return slot;
+        if (slotKey == 0U) {
+            slot->key.store(key, std::memory_order_release);
+            return slot;
+        }
+    }
+
+    return nullptr;
+}
+
+/* Helper to sum the histogram of a stage across all metrics blocks. */
+
+static void sumHistogram(NetStage::E stage, uint64_t* hist, uint64_t& sum)
+{
+    for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++)
+        hist[i] = 0U;
+    sum = 0U;
+
+    std::lock_guard<std::mutex> lock(registryLock());
+    for (MetricsBlock* block : registry()) {
+        for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++)
+            hist[i] += block->hist[stage][i].load(std::memory_order_relaxed);
+        sum += block->sum[stage].load(std::memory_order_relaxed);
+    }
+}
+
+/* Helper to find a quantile in a histogram. */
+
+static uint64_t histQuantile(const uint64_t* hist, uint64_t total, double q)
+{
+    if (total == 0U)
+        return 0U;
+
+    if (q < 0.0)
+        q = 0.0;
+    if (q > 1.0)
+        q = 1.0;
+
+    uint64_t rank = (uint64_t)(q * (double)total + 0.5);
+    if (rank == 0U)
+        rank = 1U;
+
+    uint64_t seen = 0U;
+    for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++) {
+        seen += hist[i];
+        if (seen >= rank)
+            return NetMetrics::bucketUpperBound(i);
+    }
+
+    return NetMetrics::bucketUpperBound(NET_METRICS_BUCKETS - 1U);
+}
+
+/* Helper to append a formatted line to a string. */
+
+static void appendf(std::string& out, const char* fmt, ...)
+{
+    char buffer[256U];
+
+    va_list vl;
+    va_start(vl, fmt);
+    int len = ::vsnprintf(buffer, sizeof(buffer), fmt, vl);
+    va_end(vl);
+
+    if (len > 0)
+        out.append(buffer, ((uint32_t)len < sizeof(buffer)) ? (uint32_t)len : sizeof(buffer) - 1U);
+}
+#endif // !defined(NO_NET_METRICS)
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+#if !defined(NO_NET_METRICS)
+/* Gets the current time for latency measurement. */
+
+uint64_t NetMetrics::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Records the latency of a stage, from the given start time until now. */
+
+void NetMetrics::latency(NetStage::E stage, uint64_t start)
+{
+    latency(stage, start, now());
+}
+
+/* Records the latency of a stage. */
+
+void NetMetrics::latency(NetStage::E stage, uint64_t start, uint64_t end)
+{
+    if (stage >= NetStage::MAX || start == 0U)
+        return;
+
+    uint64_t us = (end > start) ? end - start : 0U;
+
+    MetricsBlock* block = threadBlock();
+    bump(block->hist[stage][bucketIndex(us)], 1U);
+    bump(block->sum[stage], us);
+}
+
+/* Records a received packet. */
+
+void NetMetrics::packet(uint8_t function, uint8_t subFunction, uint32_t peerId, uint32_t length)
+{
+    MetricsBlock* block = threadBlock();
+
+    CounterSlot* slot = counterSlot(block->opcodes, NET_METRICS_OPCODE_SLOTS, OPCODE_PROBE_LIMIT,
+        (((uint64_t)function << 8) | subFunction) + 1U);
+    if (slot != nullptr) {
+        bump(slot->packets, 1U);
+        bump(slot->bytes, length);
+    } else {
+        bump(block->opcodeOverflow, 1U);
+    }
+
+    slot = counterSlot(block->peers, NET_METRICS_PEER_SLOTS, PEER_PROBE_LIMIT, (uint64_t)peerId + 1U);
+    if (slot != nullptr) {
+        bump(slot->packets, 1U);
+        bump(slot->bytes, length);
+    } else {
+        bump(block->peerOverflow, 1U);
+    }
+}
+#endif // !defined(NO_NET_METRICS)
+
+/* Gets the number of latency samples recorded for a stage. */
+
+uint64_t NetMetrics::count(NetStage::E stage)
+{
+#if !defined(NO_NET_METRICS)
+    if (stage >= NetStage::MAX)
+        return 0U;
+
+    uint64_t hist[NET_METRICS_BUCKETS], sum;
+    sumHistogram(stage, hist, sum);
+
+    uint64_t total = 0U;
+    for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++)
+        total += hist[i];
+    return total;
+#else
+    return 0U;
+#endif // !defined(NO_NET_METRICS)
+}
+
+/* Gets a latency quantile for a stage. */
+
+uint64_t NetMetrics::quantile(NetStage::E stage, double q)
+{
+#if !defined(NO_NET_METRICS)
+    if (stage >= NetStage::MAX)
+        return 0U;
+
+    uint64_t hist[NET_METRICS_BUCKETS], sum;
+    sumHistogram(stage, hist, sum);
+
+    uint64_t total = 0U;
+    for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++)
+        total += hist[i];
+    return histQuantile(hist, total, q);
+#else
+    return 0U;
+#endif // !defined(NO_NET_METRICS)
+}
+
+/* Helper to create a Prometheus text exposition of the metrics. */
+
+std::string NetMetrics::prometheus()
+{
+    std::string out;
+#if !defined(NO_NET_METRICS)
+    out.reserve(16384U);
+
+    const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    uint64_t totals[NetStage::MAX];
+    uint64_t sums[NetStage::MAX];
+    uint64_t hists[NetStage::MAX][NET_METRICS_BUCKETS];
+    for (uint32_t s = 0U; s < NetStage::MAX; s++) {
+        sumHistogram((NetStage::E)s, hists[s], sums[s]);
+
+        totals[s] = 0U;
+        for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++)
+            totals[s] += hists[s][i];
+    }
+
+    // stage latency histograms; an internal bucket is exposed under the first bound that holds its
+    // largest value
+    out.append("# HELP dvm_fne_stage_latency_seconds Network packet processing latency by stage.\n");
+    out.append("# TYPE dvm_fne_stage_latency_seconds histogram\n");
+    for (uint32_t s = 0U; s < NetStage::MAX; s++) {
+        uint32_t idx = 0U;
+        uint64_t cumulative = 0U;
+        for (uint32_t b = 0U; b < EXPOSED_BUCKET_COUNT; b++) {
+            while (idx < NET_METRICS_BUCKETS && bucketUpperBound(idx) - 1U <= EXPOSED_BUCKETS[b]) {
+                cumulative += hists[s][idx];
+                idx++;
+            }
+
+            appendf(out, "dvm_fne_stage_latency_seconds_bucket{stage=\"%s\",le=\"%g\"} %llu\n",
+                STAGE_NAMES[s], (double)EXPOSED_BUCKETS[b] / 1000000.0, (unsigned long long)cumulative);
+        }
+
+        appendf(out, "dvm_fne_stage_latency_seconds_bucket{stage=\"%s\",le=\"+Inf\"} %llu\n",
+            STAGE_NAMES[s], (unsigned long long)totals[s]);
+        appendf(out, "dvm_fne_stage_latency_seconds_sum{stage=\"%s\"} %.6f\n",
+            STAGE_NAMES[s], (double)sums[s] / 1000000.0);
+        appendf(out, "dvm_fne_stage_latency_seconds_count{stage=\"%s\"} %llu\n",
+            STAGE_NAMES[s], (unsigned long long)totals[s]);
+    }
+
+    // stage latency quantiles, from the full resolution histograms
+    out.append("# HELP dvm_fne_stage_latency_quantile_seconds Network packet processing latency quantiles by stage.\n");
+    out.append("# TYPE dvm_fne_stage_latency_quantile_seconds gauge\n");
+    for (uint32_t s = 0U; s < NetStage::MAX; s++) {
+        for (double q : quantiles) {
+            appendf(out, "dvm_fne_stage_latency_quantile_seconds{stage=\"%s\",quantile=\"%g\"} %.6f\n",
+                STAGE_NAMES[s], q, (double)histQuantile(hists[s], totals[s], q) / 1000000.0);
+        }
+    }
+
+    // packet counters
+    std::map<uint64_t, std::pair<uint64_t, uint64_t>> opcodes, peers;
+    uint64_t opcodeOverflow = 0U, peerOverflow = 0U;
+    {
+        std::lock_guard<std::mutex> lock(registryLock());
+        for (MetricsBlock* block : registry()) {
+            for (const CounterSlot& slot : block->opcodes) {
+                uint64_t key = slot.key.load(std::memory_order_acquire);
+                if (key == 0U)
+                    continue;
+                std::pair<uint64_t, uint64_t>& entry = opcodes[key - 1U];
+                entry.first += slot.packets.load(std::memory_order_relaxed);
+                entry.second += slot.bytes.load(std::memory_order_relaxed);
+            }
+
+            for (const CounterSlot& slot : block->peers) {
+                uint64_t key = slot.key.load(std::memory_order_acquire);
+                if (key == 0U)
+                    continue;
+                std::pair<uint64_t, uint64_t>& entry = peers[key - 1U];
+                entry.first += slot.packets.load(std::memory_order_relaxed);
+                entry.second += slot.bytes.load(std::memory_order_relaxed);
+            }
+
+            opcodeOverflow += block->opcodeOverflow.load(std::memory_order_relaxed);
+            peerOverflow += block->peerOverflow.load(std::memory_order_relaxed);
+        }
+    }
+
+    out.append("# HELP dvm_fne_packets_total Network packets received by function and sub-function.\n");
+    out.append("# TYPE dvm_fne_packets_total counter\n");
+    for (auto& entry : opcodes) {
+        appendf(out, "dvm_fne_packets_total{function=\"0x%02X\",subfunction=\"0x%02X\"} %llu\n",
+            (uint32_t)((entry.first >> 8) & 0xFFU), (uint32_t)(entry.first & 0xFFU), (unsigned long long)entry.second.first);
+    }
+
+    out.append("# HELP dvm_fne_packet_bytes_total Network bytes received by function and sub-function.\n");
+    out.append("# TYPE dvm_fne_packet_bytes_total counter\n");
+    for (auto& entry : opcodes) {
+        appendf(out, "dvm_fne_packet_bytes_total{function=\"0x%02X\",subfunction=\"0x%02X\"} %llu\n",
+            (uint32_t)((entry.first >> 8) & 0xFFU), (uint32_t)(entry.first & 0xFFU), (unsigned long long)entry.second.second);
+    }
+
+    out.append("# HELP dvm_fne_peer_packets_total Network packets received by peer.\n");
+    out.append("# TYPE dvm_fne_peer_packets_total counter\n");
+    for (auto& entry : peers) {
+        appendf(out, "dvm_fne_peer_packets_total{peer=\"%u\"} %llu\n", (uint32_t)entry.first,
+            (unsigned long long)entry.second.first);
+    }
+
+    out.append("# HELP dvm_fne_peer_bytes_total Network bytes received by peer.\n");
+    out.append("# TYPE dvm_fne_peer_bytes_total counter\n");
+    for (auto& entry : peers) {
+        appendf(out, "dvm_fne_peer_bytes_total{peer=\"%u\"} %llu\n", (uint32_t)entry.first,
+            (unsigned long long)entry.second.second);
+    }
+
+    // packets that could not be attributed, because a thread's counter table was full
+    out.append("# HELP dvm_fne_untracked_packets_total Network packets not attributed to an opcode or peer counter.\n");
+    out.append("# TYPE dvm_fne_untracked_packets_total counter\n");
+    appendf(out, "dvm_fne_untracked_packets_total{counter=\"opcode\"} %llu\n", (unsigned long long)opcodeOverflow);
+    appendf(out, "dvm_fne_untracked_packets_total{counter=\"peer\"} %llu\n", (unsigned long long)peerOverflow);
+#else
+    out.append("# network metrics are disabled\n");
+#endif // !defined(NO_NET_METRICS)
+    return out;
+}
+
+/* Helper to get the histogram bucket for a latency. */
+
+uint32_t NetMetrics::bucketIndex(uint64_t us)
+{
+    if (us < NET_METRICS_SUB_BUCKETS)
+        return (uint32_t)us;
+
+    // index of the most significant bit, at least 4 here
+#if defined(_MSC_VER)
+    unsigned long msb = 0U;
+    _BitScanReverse64(&msb, us);
+#else
+    uint32_t msb = 63U - (uint32_t)__builtin_clzll(us);
+#endif // defined(_MSC_VER)
+
+    uint32_t index = ((uint32_t)msb - 3U) * NET_METRICS_SUB_BUCKETS + (uint32_t)((us >> (msb - 4U)) & (NET_METRICS_SUB_BUCKETS - 1U));
+    if (index >= NET_METRICS_BUCKETS)
+        return NET_METRICS_BUCKETS - 1U;
+
+    return index;
+}
+
+/* Helper to get the (exclusive) upper bound of a histogram bucket. */
+
+uint64_t NetMetrics::bucketUpperBound(uint32_t index)
+{
+    if (index >= NET_METRICS_BUCKETS)
+        index = NET_METRICS_BUCKETS - 1U;
+    if (index < NET_METRICS_SUB_BUCKETS)
+        return index + 1U;
+
+    uint32_t msb = index / NET_METRICS_SUB_BUCKETS + 3U;
+    uint32_t sub = index % NET_METRICS_SUB_BUCKETS;
+    return (uint64_t)(NET_METRICS_SUB_BUCKETS + 1U + sub) << (msb - 4U);
+}
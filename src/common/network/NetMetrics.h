@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file NetMetrics.h
+ * @ingroup network_core
+ * @file NetMetrics.cpp
+ * @ingroup network_core
+ */
+#if !defined(__NET_METRICS_H__)
+#define __NET_METRICS_H__
+
+#include "common/Defines.h"
+
+#include <string>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t NET_METRICS_SUB_BUCKETS = 16U;           // linear sub-buckets per power of 2 (~6% precision)
+    const uint32_t NET_METRICS_MAX_EXPONENT = 25U;          // largest tracked latency is 2^26us (~67s)
+    const uint32_t NET_METRICS_BUCKETS = (NET_METRICS_MAX_EXPONENT - 2U) * NET_METRICS_SUB_BUCKETS;
+    const uint32_t NET_METRICS_OPCODE_SLOTS = 512U;         // must be a power of 2
+    const uint32_t NET_METRICS_PEER_SLOTS = 2048U;          // must be a power of 2
+
+    /**
+     * @brief Network Packet Processing Stages
+     * @ingroup network_core
+     */
+    namespace NetStage {
+        /** @brief Network Packet Processing Stages */
+        enum E : uint8_t {
+            RX_DISPATCH,                //! Socket receive to packet handler dispatch
+            DISPATCH_PROCESS,           //! Packet handler dispatch to protocol frame processing completion
+            EGRESS_SEND,                //! Egress enqueue to socket write
+
+            MAX
+        };
+    }
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements process wide network packet metrics; per stage latency histograms, and packet
+     *  counters per function/sub-function opcode and per peer.
+     *  Metrics are accumulated into a block owned by the recording thread, so recording never takes a
+     *  lock or contends with another thread; blocks are only summed when the metrics are read. Latency
+     *  histograms are log-linear (HDR style), with 16 sub-buckets per power of 2 microseconds.
+     *
+     *  Metrics can be compiled out entirely by defining NO_NET_METRICS, in which case the recording
+     *  functions are inline no-ops.
+     * @ingroup network_core
+     */
+    class HOST_SW_API NetMetrics {
+    public:
+#if !defined(NO_NET_METRICS)
+        /**
+         * @brief Gets the current time for latency measurement.
+         * @returns uint64_t Current monotonic time, in microseconds.
+         */
+        static uint64_t now();
+
+        /**
+         * @brief Records the latency of a stage, from the given start time until now.
+         * @param stage Processing stage.
+         * @param start Start time (from now()).
+         */
+        static void latency(NetStage::E stage, uint64_t start);
+        /**
+         * @brief Records the latency of a stage.
+         * @param stage Processing stage.
+         * @param start Start time (from now()).
+         * @param end End time (from now()).
+         */
+        static void latency(NetStage::E stage, uint64_t start, uint64_t end);
+        /**
+         * @brief Records a received packet.
+         * @param function Function opcode.
+         * @param subFunction Sub-function opcode.
+         * @param peerId Peer ID.
+         * @param length Length of the packet.
+         */
+        static void packet(uint8_t function, uint8_t subFunction, uint32_t peerId, uint32_t length);
+#else
+        static uint64_t now() { return 0U; }
+        static void latency(NetStage::E, uint64_t) { /* stub */ }
+        static void latency(NetStage::E, uint64_t, uint64_t) { /* stub */ }
+        static void packet(uint8_t, uint8_t, uint32_t, uint32_t) { /* stub */ }
+#endif // !defined(NO_NET_METRICS)
+
+        /**
+         * @brief Gets the number of latency samples recorded for a stage.
+         * @param stage Processing stage.
+         * @returns uint64_t Number of samples.
+         */
+        static uint64_t count(NetStage::E stage);
+        /**
+         * @brief Gets a latency quantile for a stage.
+         * @param stage Processing stage.
+         * @param q Quantile (0.0 - 1.0).
+         * @returns uint64_t Upper bound of the histogram bucket holding the quantile, in microseconds.
+         */
+        static uint64_t quantile(NetStage::E stage, double q);
+
+        /**
+         * @brief Helper to create a Prometheus text exposition of the metrics.
+         * @returns std::string Prometheus text exposition.
+         */
+        static std::string prometheus();
+
+        /**
+         * @brief Helper to get the histogram bucket for a latency.
+         * @param us Latency, in microseconds.
+         * @returns uint32_t Histogram bucket index.
+         */
+        static uint32_t bucketIndex(uint64_t us);
+        /**
+         * @brief Helper to get the (exclusive) upper bound of a histogram bucket.
+         * @param index Histogram bucket index.
+         * @returns uint64_t Upper bound of the bucket, in microseconds.
+         */
+        static uint64_t bucketUpperBound(uint32_t index);
+    };
+} // namespace network
+
+#endif // __NET_METRICS_H__
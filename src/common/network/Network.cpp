@@ -199,6 +199,14 @@ void Network::clock(uint32_t ms)
         return;
     }
 
+    // flush any egress queues holding datagrams past the flush interval
+    m_frameQueue->flushExpired();
+
+    // write any log batches held past the batch interval
+    if (m_status == NET_STAT_RUNNING && m_batchLogTransfer) {
+        writeLogBatches(false);
+    }
+
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
     // roll the RTP timestamp if no call is in progress
@@ -208,19 +216,24 @@ void Network::clock(uint32_t ms)
         frame::RTPHeader::resetStartTime();
     }
 
-    sockaddr_storage address;
-    uint32_t addrLen;
+    // read and process all pending messages
+    int count = m_frameQueue->readBatch(0);
+    for (int i = 0; i < count; i++) {
+        sockaddr_storage address;
+        uint32_t addrLen;
 
-    frame::RTPHeader rtpHeader;
-    frame::RTPFNEHeader fneHeader;
-    int length = 0U;
+        frame::RTPHeader rtpHeader;
+        frame::RTPFNEHeader fneHeader;
+        int length = 0U;
+
+        // read message
+        UInt8Array buffer = m_frameQueue->readBatchMessage(i, length, address, addrLen, &rtpHeader, &fneHeader);
+        if (length <= 0)
+            continue;
 
-    // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
-    if (length > 0) {
         if (!udp::Socket::match(m_addr, address)) {
             LogError(LOG_NET, "Packet received from an invalid source");
-            return;
+            continue;
         }
 
         if (m_debug) {
@@ -238,7 +251,7 @@ void Network::clock(uint32_t ms)
         uint32_t peerId = fneHeader.getPeerId();
         if ((m_peerId != peerId) && !m_promiscuousPeer) {
             LogError(LOG_NET, "Packet received was not destined for us? peerId = %u", peerId);
-            return;
+            continue;
         }
 
         // peer connections should never encounter no stream ID
@@ -446,12 +459,17 @@ void Network::clock(uint32_t ms)
                                 // update RID lists
                                 uint32_t len = __GET_UINT32(buffer, 6U);
                                 uint32_t offs = 11U;
+                                std::vector<uint32_t> ids;
+                                ids.reserve(len);
                                 for (uint32_t i = 0; i < len; i++) {
                                     uint32_t id = __GET_UINT16(buffer, offs);
-                                    m_ridLookup->toggleEntry(id, true);
+                                    ids.push_back(id);
                                     offs += 4U;
                                 }
 
+                                // toggle all announced RIDs in a single update of the lookup table
+                                m_ridLookup->toggleEntries(ids, true);
+
                                 LogMessage(LOG_NET, "Network Announced %u whitelisted RIDs", len);
 
                                 // save to file if enabled and we got RIDs
@@ -472,12 +490,17 @@ void Network::clock(uint32_t ms)
                                 // update RID lists
                                 uint32_t len = __GET_UINT32(buffer, 6U);
                                 uint32_t offs = 11U;
+                                std::vector<uint32_t> ids;
+                                ids.reserve(len);
                                 for (uint32_t i = 0; i < len; i++) {
                                     uint32_t id = __GET_UINT16(buffer, offs);
-                                    m_ridLookup->toggleEntry(id, false);
+                                    ids.push_back(id);
                                     offs += 4U;
                                 }
 
+                                // toggle all announced RIDs in a single update of the lookup table
+                                m_ridLookup->toggleEntries(ids, false);
+
                                 LogMessage(LOG_NET, "Network Announced %u blacklisted RIDs", len);
 
                                 // save to file if enabled and we got RIDs
@@ -496,7 +519,10 @@ void Network::clock(uint32_t ms)
                                 Utils::dump(1U, "Network Received, ACTIVE TGS", buffer.get(), length);
 
                             if (m_tidLookup != nullptr) {
-                                // update TGID lists
+                                // update TGID lists; the whole list is applied to the table in a single update
+                                lookups::TalkgroupRulesLookup::TableSnapshot table = m_tidLookup->snapshot();
+                                lookups::TalkgroupRulesLookup::GroupVoiceList entries;
+
                                 uint32_t len = __GET_UINT32(buffer, 6U);
                                 uint32_t offs = 11U;
                                 for (uint32_t i = 0; i < len; i++) {
@@ -505,31 +531,32 @@ void Network::clock(uint32_t ms)
                                     bool affiliated = (buffer[offs + 3U] & 0x40U) == 0x40U;
                                     bool nonPreferred = (buffer[offs + 3U] & 0x80U) == 0x80U;
 
-                                    lookups::TalkgroupRuleGroupVoice tid = m_tidLookup->find(id, slot);
-
                                     // if the TG is marked as non-preferred, and the TGID exists in the local entries
-                                    // erase the local and overwrite with the FNE data
-                                    if (nonPreferred) {
-                                        if (!tid.isInvalid()) {
-                                            m_tidLookup->eraseEntry(id, slot);
-                                            tid = m_tidLookup->find(id, slot);
-                                        }
-                                    }
-
-                                    if (tid.isInvalid()) {
-                                        if (!tid.config().active()) {
-                                            m_tidLookup->eraseEntry(id, slot);
-                                        }
-
+                                    // overwrite the local with the FNE data
+                                    if (nonPreferred || table->find(id, slot) == nullptr) {
                                         LogMessage(LOG_NET, "Activated%s%s TG %u TS %u in TGID table", 
                                             (nonPreferred) ? " non-preferred" : "", (affiliated) ? " affiliated" : "", id, slot);
-                                        m_tidLookup->addEntry(id, slot, true, affiliated, nonPreferred);
+
+                                        lookups::TalkgroupRuleGroupVoiceSource source;
+                                        lookups::TalkgroupRuleConfig config;
+                                        source.tgId(id);
+                                        source.tgSlot(slot);
+                                        config.active(true);
+                                        config.affiliated(affiliated);
+                                        config.nonPreferred(nonPreferred);
+
+                                        lookups::TalkgroupRuleGroupVoice entry;
+                                        entry.config(config);
+                                        entry.source(source);
+                                        entries.push_back(entry);
                                     }
 
                                     offs += 5U;
                                 }
 
-                                LogMessage(LOG_NET, "Activated %u TGs; loaded %u entries into talkgroup rules table", len, m_tidLookup->groupVoice().size());
+                                m_tidLookup->addEntries(entries);
+
+                                LogMessage(LOG_NET, "Activated %u TGs; loaded %u entries into talkgroup rules table", len, m_tidLookup->snapshot()->size());
 
                                 // save if saving from network is enabled
                                 if (m_saveLookup && len > 0) {
@@ -546,23 +573,27 @@ void Network::clock(uint32_t ms)
                                 Utils::dump(1U, "Network Received, DEACTIVE TGS", buffer.get(), length);
 
                             if (m_tidLookup != nullptr) {
-                                // update TGID lists
+                                // update TGID lists; the whole list is applied to the table in a single update
+                                lookups::TalkgroupRulesLookup::TableSnapshot table = m_tidLookup->snapshot();
+                                std::vector<std::pair<uint32_t, uint8_t>> ids;
+
                                 uint32_t len = __GET_UINT32(buffer, 6U);
                                 uint32_t offs = 11U;
                                 for (uint32_t i = 0; i < len; i++) {
                                     uint32_t id = __GET_UINT16(buffer, offs);
                                     uint8_t slot = (buffer[offs + 3U]);
 
-                                    lookups::TalkgroupRuleGroupVoice tid = m_tidLookup->find(id, slot);
-                                    if (!tid.isInvalid()) {
+                                    if (table->find(id, slot) != nullptr) {
                                         LogMessage(LOG_NET, "Deactivated TG %u TS %u in TGID table", id, slot);
-                                        m_tidLookup->eraseEntry(id, slot);
+                                        ids.push_back(std::make_pair(id, slot));
                                     }
 
                                     offs += 5U;
                                 }
 
-                                LogMessage(LOG_NET, "Deactivated %u TGs; loaded %u entries into talkgroup rules table", len, m_tidLookup->groupVoice().size());
+                                m_tidLookup->eraseEntries(ids);
+
+                                LogMessage(LOG_NET, "Deactivated %u TGs; loaded %u entries into talkgroup rules table", len, m_tidLookup->snapshot()->size());
 
                                 // save if saving from network is enabled
                                 if (m_saveLookup && len > 0) {
@@ -774,6 +805,17 @@ void Network::clock(uint32_t ms)
                             if (m_useAlternatePortForDiagnostics) {
                                 LogMessage(LOG_NET, "PEER %u RPTC ACK, master commanded alternate port for diagnostics and activity logging, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
                             }
+
+                            m_batchLogTransfer = (buffer[6U] & 0x40U) == 0x40U;
+                            if (m_batchLogTransfer && (m_allowActivityTransfer || m_allowDiagnosticTransfer)) {
+                                LogMessage(LOG_NET, "PEER %u RPTC ACK, master accepts batched diagnostics and activity logging, remotePeerId = %u", m_peerId, rtpHeader.getSSRC());
+                            }
+                        }
+
+                        // log lines batched for a previous connection are written line by line, if this master
+                        // doesn't accept batches
+                        if (!m_batchLogTransfer) {
+                            writeLogBatches(true);
                         }
                         break;
                     default:
@@ -892,6 +934,9 @@ void Network::close()
         LogMessage(LOG_NET, "PEER %u closing Network", m_peerId);
 
     if (m_status == NET_STAT_RUNNING) {
+        // write any pending log batches before closing
+        writeLogBatches(true);
+
         uint8_t buffer[1U];
         ::memset(buffer, 0x00U, 1U);
 
@@ -904,6 +949,7 @@ void Network::close()
     m_timeoutTimer.stop();
 
     m_status = NET_STAT_WAITING_CONNECT;
+    m_batchLogTransfer = false;
 }
 
 /* Sets flag enabling network communication. */
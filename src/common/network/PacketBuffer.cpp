@@ -0,0 +1,506 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/PacketBuffer.h"
+
+using namespace network;
+
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents the header preceding every pooled block.
+ *  The header is 16 bytes, so the block data keeps the alignment of the heap allocation.
+ */
+struct BlockHeader {
+    BlockHeader* next;                  //! Next free block (only valid while the block is free).
+    std::atomic<uint32_t> refs;         //! Number of references to the block.
+    uint32_t capacity;                  //! Usable size of the block.
+};
+
+static_assert(sizeof(BlockHeader) == 16U || sizeof(void*) != 8U, "BlockHeader must be 16 bytes");
+
+/**
+ * @brief Represents the shared free list and counters for a size class.
+ */
+struct SizeClass {
+    std::mutex lock;
+    BlockHeader* head = nullptr;
+    uint32_t count = 0U;
+
+    std::atomic<uint64_t> allocs{0U};
+    std::atomic<uint64_t> heapAllocs{0U};
+    std::atomic<uint32_t> inUse{0U};
+    std::atomic<uint32_t> highWater{0U};
+
+    uint64_t lastAllocs = 0U;
+    uint64_t lastHeapAllocs = 0U;
+};
+
+/**
+ * @brief Represents the shared state of the pool.
+ */
+struct PoolState {
+    SizeClass classes[PACKET_POOL_SIZE_CLASSES + 1U];   // the last size class counts oversized heap blocks
+
+    std::mutex sampleLock;
+    std::chrono::steady_clock::time_point lastSample = std::chrono::steady_clock::now();
+};
+
+/**
+ * @brief Represents the per-thread block cache.
+ */
+struct ThreadCache {
+    BlockHeader* head[PACKET_POOL_SIZE_CLASSES];
+    uint32_t count[PACKET_POOL_SIZE_CLASSES];
+
+    ThreadCache();
+    ~ThreadCache();
+};
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the pool state. (This is intentionally leaked, threads may release blocks during shutdown.) */
+
+static PoolState* poolState()
+{
+    static PoolState* state = new PoolState();
+    return state;
+}
+
+static thread_local ThreadCache t_cache;
+static thread_local bool t_cacheDestroyed = false;
+
+/* Helper to get the block header for the given block data. */
+
+static inline BlockHeader* header(const uint8_t* block)
+{
+    return (BlockHeader*)(block - sizeof(BlockHeader));
+}
+
+/* Helper to get the size class index for the given size. */
+
+static inline uint32_t sizeClassOf(uint32_t size)
+{
+    uint32_t sizeClass = 0U;
+    uint32_t blockSize = PACKET_POOL_MIN_BLOCK_SIZE;
+    while (blockSize < size && sizeClass < PACKET_POOL_SIZE_CLASSES) {
+        blockSize <<= 1;
+        sizeClass++;
+    }
+
+    return sizeClass;
+}
+
+/* Helper to allocate a new block from the heap. */
+
+static BlockHeader* heapBlock(uint32_t capacity)
+{
+    void* mem = ::malloc(sizeof(BlockHeader) + capacity);
+    if (mem == nullptr)
+        throw std::bad_alloc();
+
+    BlockHeader* hdr = new (mem) BlockHeader();
+    hdr->next = nullptr;
+    hdr->capacity = capacity;
+    return hdr;
+}
+
+/* Helper to return a list of blocks to the shared free list of a size class. */
+
+static void spill(uint32_t sizeClass, BlockHeader* first, BlockHeader* last, uint32_t count)
+{
+    SizeClass& sc = poolState()->classes[sizeClass];
+    std::lock_guard<std::mutex> lock(sc.lock);
+    last->next = sc.head;
+    sc.head = first;
+    sc.count += count;
+}
+
+/* Initializes a new instance of the ThreadCache structure. */
+
+ThreadCache::ThreadCache()
+{
+    for (uint32_t i = 0U; i < PACKET_POOL_SIZE_CLASSES; i++) {
+        head[i] = nullptr;
+        count[i] = 0U;
+    }
+}
+
+/* Finalizes a instance of the ThreadCache structure. */
+
+ThreadCache::~ThreadCache()
+{
+    t_cacheDestroyed = true;
+
+    // return all cached blocks to the shared pool
+    for (uint32_t i = 0U; i < PACKET_POOL_SIZE_CLASSES; i++) {
+        if (head[i] == nullptr)
+            continue;
+
+        BlockHeader* last = head[i];
+        while (last->next != nullptr)
+            last = last->next;
+
+        spill(i, head[i], last, count[i]);
+        head[i] = nullptr;
+        count[i] = 0U;
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Allocates a block of at least the given size, with a reference count of 1. */
+
+uint8_t* PacketBufferPool::alloc(uint32_t size)
+{
+    PoolState* state = poolState();
+
+    uint32_t sizeClass = sizeClassOf(size);
+    SizeClass& sc = state->classes[sizeClass];
+
+    BlockHeader* hdr = nullptr;
+    if (sizeClass < PACKET_POOL_SIZE_CLASSES) {
+        if (!t_cacheDestroyed) {
+            // refill the thread cache from the shared pool in a batch
+            if (t_cache.head[sizeClass] == nullptr) {
+                std::lock_guard<std::mutex> lock(sc.lock);
+                uint32_t n = 0U;
+                while (sc.head != nullptr && n < PACKET_POOL_TRANSFER_BATCH) {
+                    BlockHeader* block = sc.head;
+                    sc.head = block->next;
+                    block->next = t_cache.head[sizeClass];
+                    t_cache.head[sizeClass] = block;
+                    n++;
+                }
+
+                sc.count -= n;
+                t_cache.count[sizeClass] += n;
+            }
+
+            hdr = t_cache.head[sizeClass];
+            if (hdr != nullptr) {
+                t_cache.head[sizeClass] = hdr->next;
+                t_cache.count[sizeClass]--;
+            }
+        }
+        else {
+            std::lock_guard<std::mutex> lock(sc.lock);
+            hdr = sc.head;
+            if (hdr != nullptr) {
+                sc.head = hdr->next;
+                sc.count--;
+            }
+        }
+
+        if (hdr == nullptr) {
+            hdr = heapBlock(PACKET_POOL_MIN_BLOCK_SIZE << sizeClass);
+            sc.heapAllocs.fetch_add(1U, std::memory_order_relaxed);
+        }
+    }
+    else {
+        hdr = heapBlock(size);
+        sc.heapAllocs.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    hdr->next = nullptr;
+    hdr->refs.store(1U, std::memory_order_relaxed);
+
+    sc.allocs.fetch_add(1U, std::memory_order_relaxed);
+    uint32_t inUse = sc.inUse.fetch_add(1U, std::memory_order_relaxed) + 1U;
+    uint32_t highWater = sc.highWater.load(std::memory_order_relaxed);
+    while (inUse > highWater && !sc.highWater.compare_exchange_weak(highWater, inUse, std::memory_order_relaxed))
+        ;
+
+    return (uint8_t*)(hdr + 1);
+}
+
+/* Adds a reference to the given block. */
+
+void PacketBufferPool::retain(uint8_t* block)
+{
+    assert(block != nullptr);
+    header(block)->refs.fetch_add(1U, std::memory_order_relaxed);
+}
+
+/* Releases a reference to the given block. */
+
+void PacketBufferPool::release(uint8_t* block)
+{
+    if (block == nullptr)
+        return;
+
+    BlockHeader* hdr = header(block);
+    if (hdr->refs.fetch_sub(1U, std::memory_order_acq_rel) != 1U)
+        return;
+
+    uint32_t sizeClass = sizeClassOf(hdr->capacity);
+    SizeClass& sc = poolState()->classes[sizeClass];
+    sc.inUse.fetch_sub(1U, std::memory_order_relaxed);
+
+    if (sizeClass >= PACKET_POOL_SIZE_CLASSES || hdr->capacity != (PACKET_POOL_MIN_BLOCK_SIZE << sizeClass)) {
+        hdr->~BlockHeader();
+        ::free(hdr);
+        return;
+    }
+
+    if (t_cacheDestroyed) {
+        spill(sizeClass, hdr, hdr, 1U);
+        return;
+    }
+
+    hdr->next = t_cache.head[sizeClass];
+    t_cache.head[sizeClass] = hdr;
+    t_cache.count[sizeClass]++;
+
+    // spill a batch back to the shared pool when the thread cache is full; blocks are commonly
+    // allocated on the network receive thread, and released on the packet worker threads
+    if (t_cache.count[sizeClass] > PACKET_POOL_THREAD_CACHE_DEPTH) {
+        BlockHeader* first = t_cache.head[sizeClass];
+        BlockHeader* last = first;
+        for (uint32_t i = 1U; i < PACKET_POOL_TRANSFER_BATCH; i++)
+            last = last->next;
+
+        t_cache.head[sizeClass] = last->next;
+        t_cache.count[sizeClass] -= PACKET_POOL_TRANSFER_BATCH;
+        spill(sizeClass, first, last, PACKET_POOL_TRANSFER_BATCH);
+    }
+}
+
+/* Gets the usable size of the given block. */
+
+uint32_t PacketBufferPool::capacity(const uint8_t* block)
+{
+    assert(block != nullptr);
+    return header(block)->capacity;
+}
+
+/* Gets the number of references to the given block. */
+
+uint32_t PacketBufferPool::refCount(const uint8_t* block)
+{
+    assert(block != nullptr);
+    return header(block)->refs.load(std::memory_order_acquire);
+}
+
+/* Gets the counters for a size class. */
+
+PacketPoolStats PacketBufferPool::stats(uint32_t sizeClass)
+{
+    assert(sizeClass <= PACKET_POOL_SIZE_CLASSES);
+    SizeClass& sc = poolState()->classes[sizeClass];
+
+    PacketPoolStats stats;
+    stats.blockSize = (sizeClass < PACKET_POOL_SIZE_CLASSES) ? (PACKET_POOL_MIN_BLOCK_SIZE << sizeClass) : 0U;
+    stats.allocs = sc.allocs.load(std::memory_order_relaxed);
+    stats.heapAllocs = sc.heapAllocs.load(std::memory_order_relaxed);
+    stats.inUse = sc.inUse.load(std::memory_order_relaxed);
+    stats.highWater = sc.highWater.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/* Helper to create a JSON representation of the pool counters. */
+
+json::object PacketBufferPool::statsObject()
+{
+    PoolState* state = poolState();
+    std::lock_guard<std::mutex> lock(state->sampleLock);
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - state->lastSample).count();
+    state->lastSample = now;
+
+    json::array classes = json::array();
+    uint64_t totalAllocs = 0U, totalHeapAllocs = 0U;
+    double allocRate = 0.0, heapAllocRate = 0.0;
+    for (uint32_t i = 0U; i <= PACKET_POOL_SIZE_CLASSES; i++) {
+        SizeClass& sc = state->classes[i];
+        PacketPoolStats stats = PacketBufferPool::stats(i);
+
+        uint32_t pooled = 0U;
+        if (i < PACKET_POOL_SIZE_CLASSES) {
+            std::lock_guard<std::mutex> classLock(sc.lock);
+            pooled = sc.count;
+        }
+
+        double classAllocRate = (elapsed > 0.0) ? (double)(stats.allocs - sc.lastAllocs) / elapsed : 0.0;
+        double classHeapAllocRate = (elapsed > 0.0) ? (double)(stats.heapAllocs - sc.lastHeapAllocs) / elapsed : 0.0;
+        sc.lastAllocs = stats.allocs;
+        sc.lastHeapAllocs = stats.heapAllocs;
+
+        json::object object = json::object();
+        object["blockSize"].set<uint32_t>(stats.blockSize);
+        object["allocs"].set<uint64_t>(stats.allocs);
+        object["heapAllocs"].set<uint64_t>(stats.heapAllocs);
+        object["allocsPerSec"].set<double>(classAllocRate);
+        object["heapAllocsPerSec"].set<double>(classHeapAllocRate);
+        object["inUse"].set<uint32_t>(stats.inUse);
+        object["highWater"].set<uint32_t>(stats.highWater);
+        object["pooled"].set<uint32_t>(pooled);
+        classes.push_back(json::value(object));
+
+        totalAllocs += stats.allocs;
+        totalHeapAllocs += stats.heapAllocs;
+        allocRate += classAllocRate;
+        heapAllocRate += classHeapAllocRate;
+    }
+
+    json::object response = json::object();
+    response["allocs"].set<uint64_t>(totalAllocs);
+    response["heapAllocs"].set<uint64_t>(totalHeapAllocs);
+    response["allocsPerSec"].set<double>(allocRate);
+    response["heapAllocsPerSec"].set<double>(heapAllocRate);
+    response["classes"].set<json::array>(classes);
+    return response;
+}
+
+/* Initializes a copy of the PacketBuffer class, sharing the underlying block. */
+
+PacketBuffer::PacketBuffer(const PacketBuffer& other) :
+    m_block(other.m_block),
+    m_data(other.m_data),
+    m_length(other.m_length)
+{
+    if (m_block != nullptr)
+        PacketBufferPool::retain(m_block);
+}
+
+/* Initializes a new instance of the PacketBuffer class, taking the view of another. */
+
+PacketBuffer::PacketBuffer(PacketBuffer&& other) noexcept :
+    m_block(other.m_block),
+    m_data(other.m_data),
+    m_length(other.m_length)
+{
+    other.m_block = nullptr;
+    other.m_data = nullptr;
+    other.m_length = 0U;
+}
+
+/* Assignment operator; shares the underlying block. */
+
+PacketBuffer& PacketBuffer::operator=(const PacketBuffer& other)
+{
+    if (this != &other) {
+        if (other.m_block != nullptr)
+            PacketBufferPool::retain(other.m_block);
+        reset();
+
+        m_block = other.m_block;
+        m_data = other.m_data;
+        m_length = other.m_length;
+    }
+
+    return *this;
+}
+
+/* Move assignment operator. */
+
+PacketBuffer& PacketBuffer::operator=(PacketBuffer&& other) noexcept
+{
+    if (this != &other) {
+        reset();
+
+        m_block = other.m_block;
+        m_data = other.m_data;
+        m_length = other.m_length;
+
+        other.m_block = nullptr;
+        other.m_data = nullptr;
+        other.m_length = 0U;
+    }
+
+    return *this;
+}
+
+/* Allocates a new zeroed packet buffer. */
+
+PacketBuffer PacketBuffer::alloc(uint32_t length)
+{
+    PacketBuffer buffer;
+    buffer.m_block = PacketBufferPool::alloc(length);
+    buffer.m_data = buffer.m_block;
+    buffer.m_length = length;
+    ::memset(buffer.m_data, 0x00U, length);
+    return buffer;
+}
+
+/* Allocates a new packet buffer containing a copy of the given data. */
+
+PacketBuffer PacketBuffer::copyOf(const uint8_t* data, uint32_t length)
+{
+    assert(data != nullptr);
+
+    PacketBuffer buffer;
+    buffer.m_block = PacketBufferPool::alloc(length);
+    buffer.m_data = buffer.m_block;
+    buffer.m_length = length;
+    ::memcpy(buffer.m_data, data, length);
+    return buffer;
+}
+
+/* Creates a view of a region of a pooled block, adding a reference to the block. */
+
+PacketBuffer PacketBuffer::share(uint8_t* block, uint32_t offset, uint32_t length)
+{
+    assert(block != nullptr);
+    assert(offset + length <= PacketBufferPool::capacity(block));
+
+    PacketBufferPool::retain(block);
+
+    PacketBuffer buffer;
+    buffer.m_block = block;
+    buffer.m_data = block + offset;
+    buffer.m_length = length;
+    return buffer;
+}
+
+/* Creates a view of a region of this view, sharing the underlying block. */
+
+PacketBuffer PacketBuffer::view(uint32_t offset, uint32_t length) const
+{
+    assert(m_block != nullptr);
+    assert(offset + length <= m_length);
+
+    return share(m_block, (uint32_t)(m_data - m_block) + offset, length);
+}
+
+/* Releases this view. */
+
+void PacketBuffer::reset()
+{
+    if (m_block != nullptr)
+        PacketBufferPool::release(m_block);
+
+    m_block = nullptr;
+    m_data = nullptr;
+    m_length = 0U;
+}
+
+/* Gets the number of views sharing the underlying block. */
+
+uint32_t PacketBuffer::refCount() const
+{
+    if (m_block == nullptr)
+        return 0U;
+    return PacketBufferPool::refCount(m_block);
+}
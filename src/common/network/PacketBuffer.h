@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PacketBuffer.h
+ * @ingroup network_core
+ * @file PacketBuffer.cpp
+ * @ingroup network_core
+ */
+#if !defined(__PACKET_BUFFER_H__)
+#define __PACKET_BUFFER_H__
+
+#include "common/Defines.h"
+#include "common/network/json/json.h"
+
+#include <atomic>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t PACKET_POOL_SIZE_CLASSES = 6U;           // 256, 512, 1024, 2048, 4096 and 8192 bytes
+    const uint32_t PACKET_POOL_MIN_BLOCK_SIZE = 256U;
+    const uint32_t PACKET_POOL_MAX_BLOCK_SIZE = PACKET_POOL_MIN_BLOCK_SIZE << (PACKET_POOL_SIZE_CLASSES - 1U);
+    const uint32_t PACKET_POOL_THREAD_CACHE_DEPTH = 64U;    // blocks cached per size class, per thread
+    const uint32_t PACKET_POOL_TRANSFER_BATCH = 32U;        // blocks moved between a thread cache and the shared pool
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the counters for a single packet pool size class.
+     * @ingroup network_core
+     */
+    struct PacketPoolStats {
+        uint32_t blockSize;         //! Size of blocks in this size class (0 for oversized heap blocks).
+        uint64_t allocs;            //! Total number of blocks handed out.
+        uint64_t heapAllocs;        //! Total number of blocks allocated from the heap.
+        uint32_t inUse;             //! Number of blocks currently handed out.
+        uint32_t highWater;         //! Largest number of blocks handed out at once.
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a process wide, size-classed pool of network packet buffers.
+     *  Blocks are reference counted, and are cached per thread; a thread cache is refilled from (and
+     *  spilled to) the shared pool in batches, so in steady state neither allocating nor releasing a
+     *  block touches the heap or a lock. Blocks larger than the largest size class are allocated from
+     *  the heap, and are counted separately.
+     * @ingroup network_core
+     */
+    class HOST_SW_API PacketBufferPool {
+    public:
+        /**
+         * @brief Allocates a block of at least the given size, with a reference count of 1.
+         *  The returned pointer has the same alignment as a heap allocation.
+         * @param size Minimum size of the block.
+         * @returns uint8_t* Block data.
+         */
+        static uint8_t* alloc(uint32_t size);
+        /**
+         * @brief Adds a reference to the given block.
+         * @param block Block data.
+         */
+        static void retain(uint8_t* block);
+        /**
+         * @brief Releases a reference to the given block; the block is returned to the pool when the last
+         *  reference is released.
+         * @param block Block data. (nullptr is ignored.)
+         */
+        static void release(uint8_t* block);
+
+        /**
+         * @brief Gets the usable size of the given block.
+         * @param block Block data.
+         * @returns uint32_t Usable size of the block.
+         */
+        static uint32_t capacity(const uint8_t* block);
+        /**
+         * @brief Gets the number of references to the given block.
+         * @param block Block data.
+         * @returns uint32_t Number of references.
+         */
+        static uint32_t refCount(const uint8_t* block);
+
+        /**
+         * @brief Gets the counters for a size class.
+         * @param sizeClass Size class index (PACKET_POOL_SIZE_CLASSES for oversized heap blocks).
+         * @returns PacketPoolStats Size class counters.
+         */
+        static PacketPoolStats stats(uint32_t sizeClass);
+        /**
+         * @brief Helper to create a JSON representation of the pool counters.
+         *  Allocation rates are computed over the time since the previous call.
+         * @returns json::object
+         */
+        static json::object statsObject();
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a reference counted view of a pooled packet buffer.
+     *  Copying a view shares the underlying block; the block is returned to the pool when the last view
+     *  of it is destroyed.
+     * @ingroup network_core
+     */
+    class HOST_SW_API PacketBuffer {
+    public:
+        /**
+         * @brief Initializes a new, empty instance of the PacketBuffer class.
+         */
+        PacketBuffer() : m_block(nullptr), m_data(nullptr), m_length(0U) { /* stub */ }
+        /**
+         * @brief Initializes a copy of the PacketBuffer class, sharing the underlying block.
+         * @param other Packet buffer to copy.
+         */
+        PacketBuffer(const PacketBuffer& other);
+        /**
+         * @brief Initializes a new instance of the PacketBuffer class, taking the view of another.
+         * @param other Packet buffer to move.
+         */
+        PacketBuffer(PacketBuffer&& other) noexcept;
+        /**
+         * @brief Finalizes a instance of the PacketBuffer class.
+         */
+        ~PacketBuffer() { reset(); }
+
+        /**
+         * @brief Assignment operator; shares the underlying block.
+         * @param other Packet buffer to copy.
+         */
+        PacketBuffer& operator=(const PacketBuffer& other);
+        /**
+         * @brief Move assignment operator.
+         * @param other Packet buffer to move.
+         */
+        PacketBuffer& operator=(PacketBuffer&& other) noexcept;
+
+        /**
+         * @brief Allocates a new zeroed packet buffer.
+         * @param length Length of the buffer.
+         * @returns PacketBuffer Packet buffer.
+         */
+        static PacketBuffer alloc(uint32_t length);
+        /**
+         * @brief Allocates a new packet buffer containing a copy of the given data.
+         * @param[in] data Data to copy.
+         * @param length Length of the data.
+         * @returns PacketBuffer Packet buffer.
+         */
+        static PacketBuffer copyOf(const uint8_t* data, uint32_t length);
+        /**
+         * @brief Creates a view of a region of a pooled block, adding a reference to the block.
+         * @param block Block data (allocated with PacketBufferPool::alloc()).
+         * @param offset Offset of the region in the block.
+         * @param length Length of the region.
+         * @returns PacketBuffer Packet buffer.
+         */
+        static PacketBuffer share(uint8_t* block, uint32_t offset, uint32_t length);
+
+        /**
+         * @brief Creates a view of a region of this view, sharing the underlying block.
+         * @param offset Offset of the region in this view.
+         * @param length Length of the region.
+         * @returns PacketBuffer Packet buffer.
+         */
+        PacketBuffer view(uint32_t offset, uint32_t length) const;
+
+        /**
+         * @brief Releases this view.
+         */
+        void reset();
+
+        /**
+         * @brief Gets the data of this view.
+         * @returns uint8_t* Data.
+         */
+        uint8_t* data() const { return m_data; }
+        /**
+         * @brief Gets the length of this view.
+         * @returns uint32_t Length.
+         */
+        uint32_t length() const { return m_length; }
+        /**
+         * @brief Helper to determine if this view is empty.
+         * @returns bool True, if this view is empty, otherwise false.
+         */
+        bool empty() const { return m_data == nullptr; }
+
+        /**
+         * @brief Gets the number of views sharing the underlying block.
+         * @returns uint32_t Number of references.
+         */
+        uint32_t refCount() const;
+
+    private:
+        uint8_t* m_block;
+        uint8_t* m_data;
+        uint32_t m_length;
+    };
+} // namespace network
+
+#endif // __PACKET_BUFFER_H__
@@ -4,37 +4,104 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2024,2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
 #include "network/RawFrameQueue.h"
+#include "network/NetMetrics.h"
+#include "network/PacketBuffer.h"
 #include "network/udp/Socket.h"
 #include "Log.h"
-#include "Thread.h"
 #include "Utils.h"
 
 using namespace network;
 
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <new>
 
 // ---------------------------------------------------------------------------
-//  Static Class Members
+//  Global Functions
 // ---------------------------------------------------------------------------
 
-std::mutex RawFrameQueue::m_queueMutex;
-bool RawFrameQueue::m_queueFlushing = false;
+/* Helper to get the current monotonic time in milliseconds. */
+
+static inline uint64_t egressNow()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Helper to get the egress queue key for a destination address. */
+
+static uint64_t egressKey(const sockaddr_storage& addr)
+{
+    if (addr.ss_family == AF_INET) {
+        const sockaddr_in* in = (const sockaddr_in*)&addr;
+        return ((uint64_t)AF_INET << 48) | ((uint64_t)in->sin_addr.s_addr << 16) | in->sin_port;
+    }
+
+    // IPv6 (and anything else) is hashed (FNV-1a); destinations that collide share a queue, which is
+    // harmless as every datagram carries its own destination address
+    const uint8_t* bytes = (const uint8_t*)&addr;
+    uint32_t len = sizeof(sockaddr_storage);
+    if (addr.ss_family == AF_INET6) {
+        const sockaddr_in6* in6 = (const sockaddr_in6*)&addr;
+        bytes = (const uint8_t*)&in6->sin6_addr;
+        len = sizeof(in6->sin6_addr);
+    }
+
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (uint32_t i = 0U; i < len; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+
+    if (addr.ss_family == AF_INET6)
+        hash ^= ((const sockaddr_in6*)&addr)->sin6_port;
+    return hash | (1ULL << 63);
+}
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
 
+/* Initializes a new instance of the EgressQueue structure. */
+
+EgressQueue::EgressQueue(const sockaddr_storage& address, uint32_t addrLen) :
+    address(address),
+    addrLen(addrLen),
+    peerId(0U),
+    lock(),
+    buffers(),
+    closed(false),
+    flushLock(),
+    flushing(),
+    pending(0U),
+    firstQueued(0U),
+    lastQueued(0U),
+    highWater(0U),
+    enqueued(0U),
+    sent(0U),
+    dropped(0U),
+    writeErrors(0U)
+{
+    buffers.reserve(EGRESS_FLUSH_COUNT);
+    flushing.reserve(EGRESS_FLUSH_COUNT);
+}
+
 /* Initializes a new instance of the RawFrameQueue class. */
 
 RawFrameQueue::RawFrameQueue(udp::Socket* socket, bool debug) :
     m_socket(socket),
-    m_buffers(),
+    m_egress(std::make_shared<const EgressMap>()),
+    m_egressLock(),
+    m_lastIdleCheck(0U),
+    m_egressFlushCount(EGRESS_FLUSH_COUNT),
+    m_egressFlushIntervalMs(EGRESS_FLUSH_INTERVAL_MS),
+    m_rxBatch(nullptr),
+    m_rxBatchCnt(0U),
     m_failedReadCnt(0U),
     m_debug(debug)
 {
@@ -46,6 +113,12 @@ RawFrameQueue::RawFrameQueue(udp::Socket* socket, bool debug) :
 RawFrameQueue::~RawFrameQueue()
 {
     deleteBuffers();
+
+    if (m_rxBatch != nullptr) {
+        for (uint32_t i = 0U; i < DATA_PACKET_BATCH_COUNT; i++)
+            PacketBufferPool::release(m_rxBatch[i].buffer);
+        delete[] m_rxBatch;
+    }
 }
 
 /* Read message from the received UDP packet. */
@@ -59,13 +132,7 @@ UInt8Array RawFrameQueue::read(int& messageLength, sockaddr_storage& address, ui
     ::memset(buffer, 0x00U, DATA_PACKET_LENGTH);
     int length = m_socket->read(buffer, DATA_PACKET_LENGTH, address, addrLen);
     if (length < 0) {
-        if (m_failedReadCnt <= MAX_FAILED_READ_CNT_LOGGING)
-            LogError(LOG_NET, "Failed reading data from the network, failedCnt = %u", m_failedReadCnt);
-        else {
-            if (m_failedReadCnt == MAX_FAILED_READ_CNT_LOGGING + 1U)
-                LogError(LOG_NET, "Failed reading data from the network -- exceeded 5 read errors, probable connection issue, silencing further errors");
-        }
-        m_failedReadCnt++;
+        readFailed();
         return nullptr;
     }
 
@@ -86,6 +153,67 @@ UInt8Array RawFrameQueue::read(int& messageLength, sockaddr_storage& address, ui
     return nullptr;
 }
 
+/* Read a batch of UDP packets, waiting up to the timeout for the socket to become readable. */
+
+int RawFrameQueue::readBatch(int timeout)
+{
+    // allocate the receive batch on first use
+    if (m_rxBatch == nullptr) {
+        m_rxBatch = new udp::UDPDatagram[DATA_PACKET_BATCH_COUNT];
+        for (uint32_t i = 0U; i < DATA_PACKET_BATCH_COUNT; i++) {
+            ::memset(&m_rxBatch[i], 0x00U, sizeof(udp::UDPDatagram));
+            m_rxBatch[i].buffer = PacketBufferPool::alloc(DATA_PACKET_LENGTH);
+        }
+    }
+    else {
+        // packets from the previous batch may still be referenced by views handed out by
+        // readBatchPacket(); those buffers are left to their views, and replaced from the pool
+        for (uint32_t i = 0U; i < m_rxBatchCnt; i++) {
+            if (PacketBufferPool::refCount(m_rxBatch[i].buffer) > 1U) {
+                PacketBufferPool::release(m_rxBatch[i].buffer);
+                m_rxBatch[i].buffer = PacketBufferPool::alloc(DATA_PACKET_LENGTH);
+            }
+        }
+    }
+
+    m_rxBatchCnt = 0U;
+
+    int count = m_socket->readBatch(m_rxBatch, DATA_PACKET_BATCH_COUNT, DATA_PACKET_LENGTH, timeout);
+    if (count < 0) {
+        readFailed();
+        return -1;
+    }
+
+    if (count > 0)
+        m_failedReadCnt = 0U;
+
+    m_rxBatchCnt = (uint32_t)count;
+    return count;
+}
+
+/* Read message from a UDP packet received by readBatch(). */
+
+UInt8Array RawFrameQueue::readBatchMessage(uint32_t n, int& messageLength, sockaddr_storage& address, uint32_t& addrLen)
+{
+    messageLength = -1;
+    if (n >= m_rxBatchCnt)
+        return nullptr;
+
+    udp::UDPDatagram& dgram = m_rxBatch[n];
+    address = dgram.address;
+    addrLen = dgram.addrLen;
+
+    if (m_debug)
+        Utils::dump(1U, "Network Packet", dgram.buffer, dgram.length);
+
+    // copy message
+    messageLength = (int)dgram.length;
+    UInt8Array message = std::unique_ptr<uint8_t[]>(new uint8_t[dgram.length]);
+    ::memcpy(message.get(), dgram.buffer, dgram.length);
+
+    return message;
+}
+
 /* Write message to the UDP socket. */
 
 bool RawFrameQueue::write(const uint8_t* message, uint32_t length, sockaddr_storage& addr, uint32_t addrLen, ssize_t* lenWritten)
@@ -93,15 +221,11 @@ bool RawFrameQueue::write(const uint8_t* message, uint32_t length, sockaddr_stor
     assert(message != nullptr);
     assert(length > 0U);
 
-    uint8_t* buffer = new uint8_t[length];
-    ::memset(buffer, 0x00U, length);
-    ::memcpy(buffer, message, length);
-
     if (m_debug)
-        Utils::dump(1U, "RawFrameQueue::write() Message", buffer, length);
+        Utils::dump(1U, "RawFrameQueue::write() Message", message, length);
 
     bool ret = true;
-    if (!m_socket->write(buffer, length, addr, addrLen, lenWritten)) {
+    if (!m_socket->write(message, length, addr, addrLen, lenWritten)) {
         // LogError(LOG_NET, "Failed writing data to the network");
         ret = false;
     }
@@ -116,80 +240,319 @@ void RawFrameQueue::enqueueMessage(const uint8_t* message, uint32_t length, sock
     assert(message != nullptr);
     assert(length > 0U);
 
-    // if the queue is flushing -- don't attempt to enqueue any messages
-    if (m_queueFlushing) {
-        LogWarning(LOG_NET, "RawFrameQueue::enqueueMessage() -- queue is flushing, waiting to enqueue message");
-        while (m_queueFlushing)
-            Thread::sleep(2U);
-    }
-
-    uint8_t* buffer = new uint8_t[length];
-    ::memset(buffer, 0x00U, length);
+    uint8_t* buffer = PacketBufferPool::alloc(length);
     ::memcpy(buffer, message, length);
 
     if (m_debug)
         Utils::dump(1U, "RawFrameQueue::enqueueMessage() Buffered Message", buffer, length);
 
-    udp::UDPDatagram* dgram = new udp::UDPDatagram;
+    enqueueDatagram(allocDatagram(buffer, length, addr, addrLen));
+}
+
+/* Flush the message queues of all destinations. */
+
+bool RawFrameQueue::flushQueue()
+{
+    std::shared_ptr<const EgressMap> egress = std::atomic_load_explicit(&m_egress, std::memory_order_acquire);
+
+    bool flushed = false;
+    bool ret = true;
+    for (auto& entry : *egress) {
+        EgressQueue* queue = entry.second.get();
+        if (queue->pending.load(std::memory_order_relaxed) == 0U)
+            continue;
+
+        flushed = true;
+        if (!flushEgress(queue))
+            ret = false;
+    }
+
+    return flushed && ret;
+}
+
+/* Flush the message queues whose oldest pending message has aged out, and release the queues of idle destinations. */
+
+void RawFrameQueue::flushExpired()
+{
+    std::shared_ptr<const EgressMap> egress = std::atomic_load_explicit(&m_egress, std::memory_order_acquire);
+    uint64_t now = egressNow();
+
+    bool idle = false;
+    for (auto& entry : *egress) {
+        EgressQueue* queue = entry.second.get();
+        if (queue->pending.load(std::memory_order_relaxed) == 0U) {
+            if (now - queue->lastQueued.load(std::memory_order_relaxed) >= EGRESS_IDLE_TIMEOUT_MS)
+                idle = true;
+            continue;
+        }
+
+        if (m_egressFlushIntervalMs > 0U && now - queue->firstQueued.load(std::memory_order_relaxed) >= m_egressFlushIntervalMs)
+            flushEgress(queue);
+    }
+
+    // release the queues of destinations that have gone idle (checked at most once a second)
+    uint64_t lastIdleCheck = m_lastIdleCheck.load(std::memory_order_relaxed);
+    if (!idle || now - lastIdleCheck < 1000U || !m_lastIdleCheck.compare_exchange_strong(lastIdleCheck, now))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_egressLock);
+    egress = std::atomic_load_explicit(&m_egress, std::memory_order_acquire);
+
+    std::shared_ptr<EgressMap> table = std::make_shared<EgressMap>();
+    for (auto& entry : *egress) {
+        EgressQueue* queue = entry.second.get();
+
+        {
+            std::lock_guard<std::mutex> queueLock(queue->lock);
+            if (queue->buffers.empty() && now - queue->lastQueued.load(std::memory_order_relaxed) >= EGRESS_IDLE_TIMEOUT_MS) {
+                // a thread still holding the queue will see it is closed, and look up a new queue
+                queue->closed = true;
+                continue;
+            }
+        }
+
+        table->insert(entry);
+    }
+
+    std::atomic_store_explicit(&m_egress, std::shared_ptr<const EgressMap>(table), std::memory_order_release);
+}
+
+/* Sets the thresholds at which a destination queue is flushed. */
+
+void RawFrameQueue::setEgressFlush(uint32_t flushCount, uint32_t flushIntervalMs)
+{
+    m_egressFlushCount = (flushCount > 0U) ? flushCount : 1U;
+    m_egressFlushIntervalMs = flushIntervalMs;
+}
+
+/* Helper to create a JSON representation of the egress queue counters. */
+
+json::array RawFrameQueue::egressStatsArray() const
+{
+    std::shared_ptr<const EgressMap> egress = std::atomic_load_explicit(&m_egress, std::memory_order_acquire);
+
+    json::array queues = json::array();
+    for (auto& entry : *egress) {
+        EgressQueue* queue = entry.second.get();
+
+        json::object stats = json::object();
+        std::string address = udp::Socket::address(queue->address);
+        stats["address"].set<std::string>(address);
+        uint16_t port = udp::Socket::port(queue->address);
+        stats["port"].set<uint16_t>(port);
+        uint32_t peerId = queue->peerId.load();
+        stats["peerId"].set<uint32_t>(peerId);
+        uint32_t pending = queue->pending.load();
+        stats["pending"].set<uint32_t>(pending);
+        uint32_t highWater = queue->highWater.load();
+        stats["highWater"].set<uint32_t>(highWater);
+        uint64_t enqueued = queue->enqueued.load();
+        stats["enqueued"].set<uint64_t>(enqueued);
+        uint64_t sent = queue->sent.load();
+        stats["sent"].set<uint64_t>(sent);
+        uint64_t dropped = queue->dropped.load();
+        stats["dropped"].set<uint64_t>(dropped);
+        uint64_t writeErrors = queue->writeErrors.load();
+        stats["writeErrors"].set<uint64_t>(writeErrors);
+        queues.push_back(json::value(stats));
+    }
+
+    return queues;
+}
+
+// ---------------------------------------------------------------------------
+//  Protected Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to allocate a queued datagram from the packet pool. */
+
+udp::UDPDatagram* RawFrameQueue::allocDatagram(uint8_t* buffer, uint32_t length, sockaddr_storage& addr, uint32_t addrLen)
+{
+    udp::UDPDatagram* dgram = new (PacketBufferPool::alloc(sizeof(udp::UDPDatagram))) udp::UDPDatagram;
     dgram->buffer = buffer;
     dgram->length = length;
     dgram->address = addr;
     dgram->addrLen = addrLen;
+    dgram->queued = 0U;
+    return dgram;
+}
 
-    m_buffers.push_back(dgram);
+/* Helper to release a queued datagram. */
+
+void RawFrameQueue::freeDatagram(udp::UDPDatagram* dgram)
+{
+    if (dgram == nullptr)
+        return;
+
+    PacketBufferPool::release(dgram->buffer);
+    dgram->buffer = nullptr;
+    dgram->length = 0U;
+    PacketBufferPool::release((uint8_t*)dgram);
 }
 
-/* Flush the message queue. */
+/* Helper to queue a datagram on the egress queue of its destination. */
 
-bool RawFrameQueue::flushQueue()
+void RawFrameQueue::enqueueDatagram(udp::UDPDatagram* dgram, uint32_t peerId)
 {
-    bool ret = true;
-    std::lock_guard<std::mutex> lock(m_queueMutex);
-    m_queueFlushing = true;
+    assert(dgram != nullptr);
 
-    if (m_buffers.empty()) {
-        return false;
-    }
+    uint64_t now = egressNow();
+    bool flush = false;
 
-    // bryanb: this is the same as above -- but for some assinine reason prevents
-    // weirdness
-    if (m_buffers.size() == 0U) {
-        return false;
-    }
+    dgram->queued = NetMetrics::now();
 
-    // LogDebug(LOG_NET, "m_buffers len = %u", m_buffers.size());
+    std::shared_ptr<EgressQueue> queue;
+    while (true) {
+        queue = egressQueue(dgram->address, dgram->addrLen);
 
-    ret = true;
-    if (!m_socket->write(m_buffers)) {
-        // LogError(LOG_NET, "Failed writing data to the network");
-        ret = false;
+        std::lock_guard<std::mutex> lock(queue->lock);
+        if (queue->closed)
+            continue;
+
+        // apply backpressure; a destination that cannot keep up has its newest datagrams dropped,
+        // rather than holding up the destinations behind it
+        uint32_t pending = (uint32_t)queue->buffers.size();
+        if (pending >= EGRESS_QUEUE_DEPTH) {
+            uint64_t dropped = queue->dropped.fetch_add(1U, std::memory_order_relaxed);
+            if ((dropped % 1000U) == 0U) {
+                LogWarning(LOG_NET, "PEER %u (%s:%u) egress queue full, dropping datagrams, dropped = %llu", queue->peerId.load(),
+                    udp::Socket::address(queue->address).c_str(), udp::Socket::port(queue->address), (unsigned long long)dropped + 1U);
+            }
+
+            freeDatagram(dgram);
+            return;
+        }
+
+        if (pending == 0U)
+            queue->firstQueued.store(now, std::memory_order_relaxed);
+        queue->lastQueued.store(now, std::memory_order_relaxed);
+        if (peerId != 0U)
+            queue->peerId.store(peerId, std::memory_order_relaxed);
+
+        queue->buffers.push_back(dgram);
+        pending++;
+        queue->pending.store(pending, std::memory_order_relaxed);
+        queue->enqueued.fetch_add(1U, std::memory_order_relaxed);
+        if (pending > queue->highWater.load(std::memory_order_relaxed))
+            queue->highWater.store(pending, std::memory_order_relaxed);
+
+        flush = (pending >= m_egressFlushCount) ||
+            (m_egressFlushIntervalMs > 0U && now - queue->firstQueued.load(std::memory_order_relaxed) >= m_egressFlushIntervalMs);
+        break;
     }
 
-    deleteBuffers();
-    m_queueFlushing = false;
-    return ret;
+    if (flush)
+        flushEgress(queue.get());
+}
+
+/* Helper to get (or create) the egress queue for a destination. */
+
+std::shared_ptr<EgressQueue> RawFrameQueue::egressQueue(const sockaddr_storage& addr, uint32_t addrLen)
+{
+    uint64_t key = egressKey(addr);
+
+    std::shared_ptr<const EgressMap> egress = std::atomic_load_explicit(&m_egress, std::memory_order_acquire);
+    auto it = egress->find(key);
+    if (it != egress->end())
+        return it->second;
+
+    // publish a new table with a queue for the destination
+    std::lock_guard<std::mutex> lock(m_egressLock);
+    egress = std::atomic_load_explicit(&m_egress, std::memory_order_acquire);
+    it = egress->find(key);
+    if (it != egress->end())
+        return it->second;
+
+    std::shared_ptr<EgressMap> table = std::make_shared<EgressMap>(*egress);
+    std::shared_ptr<EgressQueue> queue = std::make_shared<EgressQueue>(addr, addrLen);
+    queue->lastQueued.store(egressNow());
+    (*table)[key] = queue;
+
+    std::atomic_store_explicit(&m_egress, std::shared_ptr<const EgressMap>(table), std::memory_order_release);
+    return queue;
+}
+
+/* Helper to count and log a failed network read. */
+
+void RawFrameQueue::readFailed()
+{
+    if (m_failedReadCnt <= MAX_FAILED_READ_CNT_LOGGING)
+        LogError(LOG_NET, "Failed reading data from the network, failedCnt = %u", m_failedReadCnt);
+    else {
+        if (m_failedReadCnt == MAX_FAILED_READ_CNT_LOGGING + 1U)
+            LogError(LOG_NET, "Failed reading data from the network -- exceeded 5 read errors, probable connection issue, silencing further errors");
+    }
+    m_failedReadCnt++;
 }
 
 // ---------------------------------------------------------------------------
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
-/* Helper to ensure buffers are deleted. */
+/* Helper to write the pending datagrams of an egress queue. */
 
-void RawFrameQueue::deleteBuffers()
+bool RawFrameQueue::flushEgress(EgressQueue* queue)
 {
-    for (auto& buffer : m_buffers) {
-        if (buffer != nullptr) {
-            // LogDebug(LOG_NET, "deleting buffer, addr %p len %u", buffer->buffer, buffer->length);
-            if (buffer->buffer != nullptr) {
-                delete[] buffer->buffer;
-                buffer->length = 0;
-                buffer->buffer = nullptr;
+    assert(queue != nullptr);
+
+    // writes of a single destination are serialized to preserve ordering; if another thread is already
+    // writing this destination, it will also write anything pending once it is done
+    bool ret = true;
+    while (true) {
+        std::unique_lock<std::mutex> flushLock(queue->flushLock, std::try_to_lock);
+        if (!flushLock.owns_lock())
+            return ret;
+
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(queue->lock);
+                if (queue->buffers.empty())
+                    break;
+
+                // the vectors are swapped (rather than moved), so neither gives up its allocation
+                queue->flushing.swap(queue->buffers);
+                queue->pending.store(0U, std::memory_order_relaxed);
             }
 
-            delete buffer;
-            buffer = nullptr;
+            uint32_t count = (uint32_t)queue->flushing.size();
+            if (!m_socket->write(queue->flushing)) {
+                // LogError(LOG_NET, "Failed writing data to the network");
+                queue->writeErrors.fetch_add(1U, std::memory_order_relaxed);
+                ret = false;
+            }
+            queue->sent.fetch_add(count, std::memory_order_relaxed);
+
+            uint64_t sent = NetMetrics::now();
+            for (udp::UDPDatagram* dgram : queue->flushing) {
+                NetMetrics::latency(NetStage::EGRESS_SEND, dgram->queued, sent);
+                freeDatagram(dgram);
+            }
+            queue->flushing.clear();
         }
+
+        flushLock.unlock();
+
+        // a datagram queued after the last check, but before the flush lock was released, was left
+        // to this thread by its producer; check again now the lock is released, and write it
+        std::lock_guard<std::mutex> lock(queue->lock);
+        if (queue->buffers.empty())
+            return ret;
+    }
+}
+
+/* Helper to ensure buffers are deleted. */
+
+void RawFrameQueue::deleteBuffers()
+{
+    std::shared_ptr<const EgressMap> egress = std::atomic_load_explicit(&m_egress, std::memory_order_acquire);
+    for (auto& entry : *egress) {
+        EgressQueue* queue = entry.second.get();
+
+        std::lock_guard<std::mutex> flushLock(queue->flushLock);
+        std::lock_guard<std::mutex> lock(queue->lock);
+        for (udp::UDPDatagram* dgram : queue->buffers)
+            freeDatagram(dgram);
+        queue->buffers.clear();
+        queue->pending.store(0U);
     }
-    m_buffers.clear();
 }
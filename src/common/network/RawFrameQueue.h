@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2024,2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -17,10 +17,14 @@
 #define __RAW_FRAME_QUEUE_H__
 
 #include "common/Defines.h"
+#include "common/network/json/json.h"
 #include "common/network/udp/Socket.h"
 #include "common/Utils.h"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 
 namespace network
 {
@@ -29,14 +33,62 @@ namespace network
     // ---------------------------------------------------------------------------
 
     const uint32_t DATA_PACKET_LENGTH = 8192U;
+    const uint32_t DATA_PACKET_BATCH_COUNT = 32U;
     const uint8_t MAX_FAILED_READ_CNT_LOGGING = 5U;
 
+    const uint32_t EGRESS_QUEUE_DEPTH = 512U;               // datagrams pending per destination before dropping
+    const uint32_t EGRESS_FLUSH_COUNT = 32U;                // datagrams pending per destination that trigger a flush
+    const uint32_t EGRESS_FLUSH_INTERVAL_MS = 5U;           // age of the oldest pending datagram that triggers a flush
+    const uint32_t EGRESS_IDLE_TIMEOUT_MS = 60000U;         // idle time after which an empty destination queue is released
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the egress queue for a single destination.
+     *  Datagrams for a destination are always written in the order they were queued; flushes of a
+     *  queue are serialized, and never block enqueuing or flushing the queues of other destinations.
+     * @ingroup network_core
+     */
+    struct EgressQueue {
+        sockaddr_storage address;                   //! Destination Address and Port
+        uint32_t addrLen;                           //! Length of address structure
+        std::atomic<uint32_t> peerId;               //! Peer ID of the destination (if known)
+
+        std::mutex lock;                            //! Guards the pending datagrams.
+        udp::BufferVector buffers;                  //! Pending datagrams.
+        bool closed;                                //! Flag indicating the queue was released.
+
+        std::mutex flushLock;                       //! Serializes writes of the queue.
+        udp::BufferVector flushing;                 //! Datagrams being written (guarded by the flush lock).
+
+        std::atomic<uint32_t> pending;              //! Number of pending datagrams.
+        std::atomic<uint64_t> firstQueued;          //! Time the oldest pending datagram was queued (ms).
+        std::atomic<uint64_t> lastQueued;           //! Time the newest datagram was queued (ms).
+
+        std::atomic<uint32_t> highWater;            //! Largest number of pending datagrams.
+        std::atomic<uint64_t> enqueued;             //! Total number of datagrams queued.
+        std::atomic<uint64_t> sent;                 //! Total number of datagrams written.
+        std::atomic<uint64_t> dropped;              //! Total number of datagrams dropped because the queue was full.
+        std::atomic<uint64_t> writeErrors;          //! Total number of flushes that failed to write.
+
+        /**
+         * @brief Initializes a new instance of the EgressQueue structure.
+         * @param address Destination address.
+         * @param addrLen Length of address structure.
+         */
+        EgressQueue(const sockaddr_storage& address, uint32_t addrLen);
+    };
+
     // ---------------------------------------------------------------------------
     //  Class Declaration
     // ---------------------------------------------------------------------------
 
     /**
      * @brief Implements the network frame queuing logic.
+     *  Queued messages are held in a separate egress queue per destination, which is flushed when enough
+     *  datagrams are pending or the oldest pending datagram ages out, or when explicitly flushed.
      * @ingroup network_core
      */
     class HOST_SW_API RawFrameQueue {
@@ -60,16 +112,33 @@ namespace network
          * @brief Read message from the received UDP packet.
          * @param[out] messageLength Actual length of message read from packet.
          * @param[out] address IP address data read from.
-         * @param[out] addrLen 
+         * @param[out] addrLen Length of address structure read.
          * @return UInt8Array Buffer containing message read.
          */
         UInt8Array read(int& messageLength, sockaddr_storage& address, uint32_t& addrLen);
+        /**
+         * @brief Read a batch of UDP packets, waiting up to the timeout for the socket to become readable.
+         *  The packets read are held by the queue until the next call to readBatch(), and messages are
+         *  retrieved from them with readBatchMessage().
+         * @param timeout Time in milliseconds to wait for data (0 returns immediately, -1 waits indefinitely).
+         * @returns int Number of packets read, or -1 on error.
+         */
+        int readBatch(int timeout);
+        /**
+         * @brief Read message from a UDP packet received by readBatch().
+         * @param n Index of the packet in the received batch.
+         * @param[out] messageLength Actual length of message read from packet.
+         * @param[out] address IP address data read from.
+         * @param[out] addrLen Length of address structure read.
+         * @return UInt8Array Buffer containing message read.
+         */
+        UInt8Array readBatchMessage(uint32_t n, int& messageLength, sockaddr_storage& address, uint32_t& addrLen);
         /**
          * @brief Write message to the UDP socket.
          * @param[in] message Message buffer to frame and queue.
          * @param length Length of message.
          * @param address IP address to write data to.
-         * @param addrLen 
+         * @param addrLen Length of address structure.
          * @param[out] lenWritten Total number of bytes written.
          * @returns bool True, if message was sent, otherwise false.
          */
@@ -80,29 +149,102 @@ namespace network
          * @param[in] message Message buffer to frame and queue.
          * @param length Length of message.
          * @param addr IP address to write data to.
-         * @param addrLen 
+         * @param addrLen Length of address structure.
          */
         void enqueueMessage(const uint8_t* message, uint32_t length, sockaddr_storage& addr, uint32_t addrLen);
 
         /**
-         * @brief Flush the message queue.
+         * @brief Flush the message queues of all destinations.
+         *  A destination queue that is being flushed by another thread is skipped; that thread writes any
+         *  datagrams pending for it.
+         * @returns bool True, if the pending messages were written, false if no messages were pending or
+         *  a write failed.
          */
         bool flushQueue();
+        /**
+         * @brief Flush the message queues whose oldest pending message has aged out, and release the
+         *  queues of idle destinations.
+         */
+        void flushExpired();
+
+        /**
+         * @brief Sets the thresholds at which a destination queue is flushed.
+         * @param flushCount Number of pending datagrams that trigger a flush.
+         * @param flushIntervalMs Age in milliseconds of the oldest pending datagram that triggers a flush (0 to
+         *  only flush on the number of pending datagrams, or explicitly).
+         */
+        void setEgressFlush(uint32_t flushCount, uint32_t flushIntervalMs);
+
+        /**
+         * @brief Helper to create a JSON representation of the egress queue counters.
+         * @returns json::array
+         */
+        json::array egressStatsArray() const;
 
     protected:
         sockaddr_storage m_addr;
         uint32_t m_addrLen;
         udp::Socket* m_socket;
 
-        static std::mutex m_queueMutex;
-        static bool m_queueFlushing;
-        udp::BufferVector m_buffers;
+        typedef std::unordered_map<uint64_t, std::shared_ptr<EgressQueue>> EgressMap;
+        std::shared_ptr<const EgressMap> m_egress;
+        std::mutex m_egressLock;
+        std::atomic<uint64_t> m_lastIdleCheck;
+        uint32_t m_egressFlushCount;
+        uint32_t m_egressFlushIntervalMs;
+
+        udp::UDPDatagram* m_rxBatch;
+        uint32_t m_rxBatchCnt;
 
         uint32_t m_failedReadCnt;
 
         bool m_debug;
 
+        /**
+         * @brief Helper to allocate a queued datagram from the packet pool.
+         * @param buffer Pooled message buffer; ownership passes to the datagram.
+         * @param length Length of message.
+         * @param addr IP address to write data to.
+         * @param addrLen Length of address structure.
+         * @returns udp::UDPDatagram* Queued datagram.
+         */
+        static udp::UDPDatagram* allocDatagram(uint8_t* buffer, uint32_t length, sockaddr_storage& addr, uint32_t addrLen);
+        /**
+         * @brief Helper to release a queued datagram.
+         * @param dgram Queued datagram.
+         */
+        static void freeDatagram(udp::UDPDatagram* dgram);
+
+        /**
+         * @brief Helper to queue a datagram on the egress queue of its destination.
+         *  If the destination queue is full, the datagram is dropped.
+         * @param dgram Queued datagram; ownership passes to the queue.
+         * @param peerId Peer ID of the destination (0 if unknown).
+         */
+        void enqueueDatagram(udp::UDPDatagram* dgram, uint32_t peerId = 0U);
+        /**
+         * @brief Helper to get (or create) the egress queue for a destination.
+         * @param addr IP address of the destination.
+         * @param addrLen Length of address structure.
+         * @returns std::shared_ptr<EgressQueue> Egress queue.
+         */
+        std::shared_ptr<EgressQueue> egressQueue(const sockaddr_storage& addr, uint32_t addrLen);
+
+        /**
+         * @brief Helper to count and log a failed network read.
+         */
+        void readFailed();
+
     private:
+        /**
+         * @brief Helper to write the pending datagrams of an egress queue.
+         *  If the queue is already being flushed by another thread, this returns immediately; that thread
+         *  writes anything queued before it releases the queue.
+         * @param queue Egress queue.
+         * @returns bool True, if the pending datagrams were written, otherwise false.
+         */
+        bool flushEgress(EgressQueue* queue);
+
         /**
          * @brief Helper to ensure buffers are deleted.
          */
@@ -0,0 +1,318 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/RTPFNEHeader.h"
+#include "network/StreamSeqTable.h"
+
+using namespace network;
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint64_t SLOT_EMPTY = 0ULL;
+const uint64_t SLOT_TOMBSTONE = 0xFFFFFFFFFFFFFFFFULL;
+const uint64_t SLOT_BUSY = 0xFFFFFFFFFFFFFFFEULL;
+
+const uint32_t SLOT_MASK = STREAM_SEQ_TABLE_CAPACITY - 1U;
+
+const uint32_t RTP_SEQ_SPACE = RTP_END_OF_CALL_SEQ;     // valid sequences are 0 - 65534
+
+// ---------------------------------------------------------------------------
+//  Macros
+// ---------------------------------------------------------------------------
+
+// Helper to determine the home slot for a stream ID (Fibonacci hashing).
+#define __SLOT_INDEX(streamId) ((uint32_t)(((streamId) * 0x9E3779B97F4A7C15ULL) >> 32) & SLOT_MASK)
+
+// Helper to determine if the stream ID can be stored in the table.
+#define __VALID_KEY(streamId) ((streamId) != SLOT_EMPTY && (streamId) != SLOT_TOMBSTONE && (streamId) != SLOT_BUSY)
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the StreamSeqTable class. */
+
+StreamSeqTable::StreamSeqTable() :
+    m_count(0U),
+    m_tick(0U),
+    m_outOfSequence(0U),
+    m_duplicate(0U),
+    m_gap(0U),
+    m_evicted(0U)
+{
+    clear();
+}
+
+/* Helper to determine if the stream ID is tracked. */
+
+bool StreamSeqTable::has(uint64_t streamId) const
+{
+    return find(streamId) != nullptr;
+}
+
+/* Gets the next expected RTP sequence for the given stream ID. */
+
+uint16_t StreamSeqTable::get(uint64_t streamId) const
+{
+    Slot* slot = find(streamId);
+    if (slot == nullptr)
+        return RTP_END_OF_CALL_SEQ;
+
+    return (uint16_t)slot->seq.load(std::memory_order_acquire);
+}
+
+/* Increments the stored RTP sequence for the given stream ID. */
+
+uint16_t StreamSeqTable::increment(uint64_t streamId, uint16_t initialSeq)
+{
+    Slot* slot = find(streamId);
+    if (slot == nullptr) {
+        claim(streamId, initialSeq);
+        return 0U;
+    }
+
+    slot->lastUsed.store(m_tick.fetch_add(1U, std::memory_order_relaxed), std::memory_order_relaxed);
+
+    uint32_t curr = slot->seq.load(std::memory_order_acquire);
+    uint32_t next = nextSeq((uint16_t)curr);
+    while (!slot->seq.compare_exchange_weak(curr, next, std::memory_order_acq_rel))
+        next = nextSeq((uint16_t)curr);
+
+    return (uint16_t)next;
+}
+
+/* Checks the RTP sequence of a received packet against the expected sequence, and advances the expected sequence. */
+
+StreamSeqResult::E StreamSeqTable::checkAndAdvance(uint64_t streamId, uint16_t pktSeq, uint16_t* expected)
+{
+    if (!__VALID_KEY(streamId) || pktSeq == RTP_END_OF_CALL_SEQ)
+        return StreamSeqResult::UNTRACKED;
+
+    Slot* slot = find(streamId);
+    if (slot == nullptr) {
+        if (expected != nullptr)
+            *expected = pktSeq;
+        if (claim(streamId, nextSeq(pktSeq)) == nullptr)
+            return StreamSeqResult::UNTRACKED;
+        return StreamSeqResult::NEW_STREAM;
+    }
+
+    slot->lastUsed.store(m_tick.fetch_add(1U, std::memory_order_relaxed), std::memory_order_relaxed);
+
+    uint16_t exp = (uint16_t)slot->seq.load(std::memory_order_acquire);
+    if (expected != nullptr)
+        *expected = exp;
+
+    // a sequence of 0 is a peer restarting its sequence, resynchronize without counting
+    if (pktSeq == exp || pktSeq == 0U) {
+        slot->seq.store(nextSeq(pktSeq), std::memory_order_release);
+        return StreamSeqResult::IN_SEQUENCE;
+    }
+
+    // determine the distance (modulo the RTP sequence space) between the packet and the expected sequence
+    uint32_t dist = ((uint32_t)pktSeq + RTP_SEQ_SPACE - (uint32_t)exp) % RTP_SEQ_SPACE;
+    if (dist < (RTP_SEQ_SPACE / 2U)) {
+        // packet is ahead of the expected sequence, packets were lost
+        slot->gap.fetch_add(1U, std::memory_order_relaxed);
+        m_gap.fetch_add(1U, std::memory_order_relaxed);
+
+        slot->seq.store(nextSeq(pktSeq), std::memory_order_release);
+        return StreamSeqResult::GAP;
+    }
+
+    if (dist == RTP_SEQ_SPACE - 1U) {
+        // packet is the previous packet repeated
+        slot->duplicate.fetch_add(1U, std::memory_order_relaxed);
+        m_duplicate.fetch_add(1U, std::memory_order_relaxed);
+        return StreamSeqResult::DUPLICATE;
+    }
+
+    // packet is older then the previous packet; don't move the expected sequence backwards
+    slot->outOfSequence.fetch_add(1U, std::memory_order_relaxed);
+    m_outOfSequence.fetch_add(1U, std::memory_order_relaxed);
+    return StreamSeqResult::OUT_OF_SEQUENCE;
+}
+
+/* Erases the given stream ID. */
+
+bool StreamSeqTable::erase(uint64_t streamId, StreamSeqStats* stats)
+{
+    Slot* slot = find(streamId);
+    if (slot == nullptr)
+        return false;
+
+    if (stats != nullptr) {
+        stats->outOfSequence = slot->outOfSequence.load(std::memory_order_relaxed);
+        stats->duplicate = slot->duplicate.load(std::memory_order_relaxed);
+        stats->gap = slot->gap.load(std::memory_order_relaxed);
+    }
+
+    // if the next slot is empty, no probe sequence passes through this slot and it can be emptied,
+    // otherwise it must be left as a tombstone
+    uint32_t idx = (uint32_t)(slot - m_slots);
+    uint64_t marker = (m_slots[(idx + 1U) & SLOT_MASK].streamId.load(std::memory_order_acquire) == SLOT_EMPTY) ? SLOT_EMPTY : SLOT_TOMBSTONE;
+
+    uint64_t curr = streamId;
+    if (!slot->streamId.compare_exchange_strong(curr, marker, std::memory_order_acq_rel))
+        return false;
+
+    m_count.fetch_sub(1U, std::memory_order_relaxed);
+    return true;
+}
+
+/* Clears all tracked streams. */
+
+void StreamSeqTable::clear()
+{
+    for (uint32_t i = 0U; i < STREAM_SEQ_TABLE_CAPACITY; i++) {
+        m_slots[i].streamId.store(SLOT_EMPTY, std::memory_order_relaxed);
+        m_slots[i].seq.store(0U, std::memory_order_relaxed);
+        m_slots[i].lastUsed.store(0U, std::memory_order_relaxed);
+        m_slots[i].outOfSequence.store(0U, std::memory_order_relaxed);
+        m_slots[i].duplicate.store(0U, std::memory_order_relaxed);
+        m_slots[i].gap.store(0U, std::memory_order_relaxed);
+    }
+
+    m_count.store(0U, std::memory_order_release);
+}
+
+/* Gets the sequence counters for the given stream ID. */
+
+bool StreamSeqTable::stats(uint64_t streamId, StreamSeqStats& stats) const
+{
+    Slot* slot = find(streamId);
+    if (slot == nullptr)
+        return false;
+
+    stats.outOfSequence = slot->outOfSequence.load(std::memory_order_relaxed);
+    stats.duplicate = slot->duplicate.load(std::memory_order_relaxed);
+    stats.gap = slot->gap.load(std::memory_order_relaxed);
+    return true;
+}
+
+/* Gets the sequence counters totalled over all streams seen by this table. */
+
+StreamSeqStats StreamSeqTable::totals() const
+{
+    StreamSeqStats stats;
+    stats.outOfSequence = (uint32_t)m_outOfSequence.load(std::memory_order_relaxed);
+    stats.duplicate = (uint32_t)m_duplicate.load(std::memory_order_relaxed);
+    stats.gap = (uint32_t)m_gap.load(std::memory_order_relaxed);
+    return stats;
+}
+
+/* Helper to calculate the RTP sequence following the given sequence. */
+
+uint16_t StreamSeqTable::nextSeq(uint16_t seq)
+{
+    uint32_t next = (uint32_t)seq + 1U;
+    if (next > (RTP_END_OF_CALL_SEQ - 1U))
+        next = 0U;
+
+    return (uint16_t)next;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to find the slot for the given stream ID. */
+
+StreamSeqTable::Slot* StreamSeqTable::find(uint64_t streamId) const
+{
+    if (!__VALID_KEY(streamId))
+        return nullptr;
+
+    Slot* slots = const_cast<Slot*>(m_slots);
+    uint32_t idx = __SLOT_INDEX(streamId);
+    for (uint32_t n = 0U; n < STREAM_SEQ_TABLE_CAPACITY; n++) {
+        uint64_t key = slots[idx].streamId.load(std::memory_order_acquire);
+        if (key == streamId)
+            return &slots[idx];
+        if (key == SLOT_EMPTY)
+            return nullptr;
+
+        idx = (idx + 1U) & SLOT_MASK;
+    }
+
+    return nullptr;
+}
+
+/* Helper to claim a slot for the given stream ID. */
+
+StreamSeqTable::Slot* StreamSeqTable::claim(uint64_t streamId, uint16_t seq)
+{
+    if (!__VALID_KEY(streamId))
+        return nullptr;
+
+    Slot* slot = nullptr;
+    while (slot == nullptr) {
+        // another thread may have claimed the stream
+        Slot* existing = find(streamId);
+        if (existing != nullptr)
+            return existing;
+
+        // find the first free slot along the probe sequence
+        uint32_t idx = __SLOT_INDEX(streamId);
+        uint32_t n = 0U;
+        for (; n < STREAM_SEQ_TABLE_CAPACITY; n++) {
+            uint64_t key = m_slots[idx].streamId.load(std::memory_order_acquire);
+            if (key == SLOT_EMPTY || key == SLOT_TOMBSTONE) {
+                if (m_slots[idx].streamId.compare_exchange_strong(key, SLOT_BUSY, std::memory_order_acq_rel)) {
+                    slot = &m_slots[idx];
+                    m_count.fetch_add(1U, std::memory_order_relaxed);
+                }
+                break;
+            }
+
+            idx = (idx + 1U) & SLOT_MASK;
+        }
+
+        if (slot != nullptr || n < STREAM_SEQ_TABLE_CAPACITY)
+            continue; // either claimed, or lost a race for the free slot and must retry
+
+        // the table is full, evict the least recently used stream
+        uint32_t now = m_tick.load(std::memory_order_relaxed);
+        uint32_t oldestAge = 0U;
+        Slot* victim = nullptr;
+        for (uint32_t i = 0U; i < STREAM_SEQ_TABLE_CAPACITY; i++) {
+            uint64_t key = m_slots[i].streamId.load(std::memory_order_acquire);
+            if (!__VALID_KEY(key))
+                continue;
+
+            uint32_t age = now - m_slots[i].lastUsed.load(std::memory_order_relaxed);
+            if (victim == nullptr || age > oldestAge) {
+                victim = &m_slots[i];
+                oldestAge = age;
+            }
+        }
+
+        if (victim == nullptr)
+            return nullptr;
+
+        uint64_t key = victim->streamId.load(std::memory_order_acquire);
+        if (__VALID_KEY(key) && victim->streamId.compare_exchange_strong(key, SLOT_BUSY, std::memory_order_acq_rel)) {
+            slot = victim;
+            m_evicted.fetch_add(1U, std::memory_order_relaxed);
+        }
+    }
+
+    slot->seq.store(seq, std::memory_order_relaxed);
+    slot->lastUsed.store(m_tick.fetch_add(1U, std::memory_order_relaxed), std::memory_order_relaxed);
+    slot->outOfSequence.store(0U, std::memory_order_relaxed);
+    slot->duplicate.store(0U, std::memory_order_relaxed);
+    slot->gap.store(0U, std::memory_order_relaxed);
+
+    // publish the slot
+    slot->streamId.store(streamId, std::memory_order_release);
+    return slot;
+}
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file StreamSeqTable.h
+ * @ingroup network_core
+ * @file StreamSeqTable.cpp
+ * @ingroup network_core
+ */
+#if !defined(__STREAM_SEQ_TABLE_H__)
+#define __STREAM_SEQ_TABLE_H__
+
+#include "common/Defines.h"
+
+#include <atomic>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t STREAM_SEQ_TABLE_CAPACITY = 128U;    // streams tracked before the least recently used is evicted; must be a power of 2
+
+    /**
+     * @brief Stream Sequence Check Results
+     * @ingroup network_core
+     */
+    namespace StreamSeqResult {
+        /** @brief Stream Sequence Check Results */
+        enum E : uint8_t {
+            NEW_STREAM,                 //! Stream was not being tracked, and is now tracked
+            IN_SEQUENCE,                //! Packet was the expected next packet
+            GAP,                        //! Packet is ahead of the expected packet (packets were lost)
+            DUPLICATE,                  //! Packet is a repeat of the previous packet
+            OUT_OF_SEQUENCE,            //! Packet is older then the previous packet (packets were reordered)
+            UNTRACKED                   //! Stream cannot be tracked
+        };
+    }
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents the sequence counters for a single RTP stream.
+     * @ingroup network_core
+     */
+    struct StreamSeqStats {
+        uint32_t outOfSequence;         //! Number of reordered packets.
+        uint32_t duplicate;             //! Number of duplicated packets.
+        uint32_t gap;                   //! Number of sequence gaps (lost packets).
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a fixed capacity, open-addressed, lock-free table of RTP stream sequence numbers.
+     *  The table is intended to be owned per peer connection; lookups never lock, and a stream's packets
+     *  are expected to be checked in order by a single thread at a time (which the FNE guarantees by
+     *  sharding streams onto worker threads).
+     *
+     *  The table never grows. When a new stream arrives while all STREAM_SEQ_TABLE_CAPACITY slots are in
+     *  use, the least recently used stream is evicted to make room, and counted by evicted(). The evicted
+     *  stream's own counters are discarded (they remain included in totals()); if that stream sends again,
+     *  its next packet is reported as NEW_STREAM and sequence checking resynchronizes from it.
+     * @ingroup network_core
+     */
+    class HOST_SW_API StreamSeqTable {
+    public:
+        auto operator=(StreamSeqTable&) -> StreamSeqTable& = delete;
+        auto operator=(StreamSeqTable&&) -> StreamSeqTable& = delete;
+        StreamSeqTable(StreamSeqTable&) = delete;
+
+        /**
+         * @brief Initializes a new instance of the StreamSeqTable class.
+         */
+        StreamSeqTable();
+
+        /**
+         * @brief Gets the count of tracked streams.
+         * @returns uint32_t Number of tracked streams.
+         */
+        uint32_t count() const { return m_count.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Helper to determine if the stream ID is tracked.
+         * @param streamId Stream ID.
+         * @returns bool True, if the stream is tracked, otherwise false.
+         */
+        bool has(uint64_t streamId) const;
+        /**
+         * @brief Gets the next expected RTP sequence for the given stream ID.
+         * @param streamId Stream ID.
+         * @returns uint16_t Next expected RTP sequence, or RTP_END_OF_CALL_SEQ if the stream is not tracked.
+         */
+        uint16_t get(uint64_t streamId) const;
+        /**
+         * @brief Increments the stored RTP sequence for the given stream ID.
+         *  (If the stream is not tracked, it will begin being tracked at the initial sequence.)
+         * @param streamId Stream ID.
+         * @param initialSeq Initial sequence number to set.
+         * @returns uint16_t Incremented RTP sequence (or 0 if the stream was not tracked).
+         */
+        uint16_t increment(uint64_t streamId, uint16_t initialSeq);
+        /**
+         * @brief Checks the RTP sequence of a received packet against the expected sequence, and advances
+         *  the expected sequence in a single operation.
+         * @param streamId Stream ID.
+         * @param pktSeq Received RTP sequence.
+         * @param[out] expected Expected RTP sequence (before this packet).
+         * @returns StreamSeqResult::E Result of the sequence check.
+         */
+        StreamSeqResult::E checkAndAdvance(uint64_t streamId, uint16_t pktSeq, uint16_t* expected = nullptr);
+        /**
+         * @brief Erases the given stream ID.
+         * @param streamId Stream ID.
+         * @param[out] stats Sequence counters for the erased stream.
+         * @returns bool True, if the stream was erased, otherwise false.
+         */
+        bool erase(uint64_t streamId, StreamSeqStats* stats = nullptr);
+        /**
+         * @brief Clears all tracked streams.
+         */
+        void clear();
+
+        /**
+         * @brief Gets the sequence counters for the given stream ID.
+         * @param streamId Stream ID.
+         * @param[out] stats Sequence counters.
+         * @returns bool True, if the stream is tracked, otherwise false.
+         */
+        bool stats(uint64_t streamId, StreamSeqStats& stats) const;
+        /**
+         * @brief Gets the sequence counters totalled over all streams seen by this table.
+         * @returns StreamSeqStats Sequence counters.
+         */
+        StreamSeqStats totals() const;
+        /**
+         * @brief Gets the count of streams evicted from a full table.
+         * @returns uint64_t Number of evicted streams.
+         */
+        uint64_t evicted() const { return m_evicted.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Helper to calculate the RTP sequence following the given sequence.
+         *  (RTP_END_OF_CALL_SEQ is reserved, and is never a valid stream sequence.)
+         * @param seq RTP sequence.
+         * @returns uint16_t Next RTP sequence.
+         */
+        static uint16_t nextSeq(uint16_t seq);
+
+    private:
+        /**
+         * @brief Represents a single table slot. (Slots are padded to 32 bytes, so two slots share a
+         *  single cache line; the slot is deliberately not over-aligned, as the table is embedded in
+         *  heap allocated objects.)
+         */
+        struct Slot {
+            std::atomic<uint64_t> streamId;
+            std::atomic<uint32_t> seq;
+            std::atomic<uint32_t> lastUsed;
+
+            std::atomic<uint32_t> outOfSequence;
+            std::atomic<uint32_t> duplicate;
+            std::atomic<uint32_t> gap;
+            uint32_t pad;
+        };
+
+        Slot m_slots[STREAM_SEQ_TABLE_CAPACITY];
+        std::atomic<uint32_t> m_count;
+        std::atomic<uint32_t> m_tick;
+
+        std::atomic<uint64_t> m_outOfSequence;
+        std::atomic<uint64_t> m_duplicate;
+        std::atomic<uint64_t> m_gap;
+        std::atomic<uint64_t> m_evicted;
+
+        /**
+         * @brief Helper to find the slot for the given stream ID.
+         * @param streamId Stream ID.
+         * @returns Slot* Table slot, or nullptr if the stream is not tracked.
+         */
+        Slot* find(uint64_t streamId) const;
+        /**
+         * @brief Helper to claim a slot for the given stream ID.
+         *  If the table is full, the least recently used stream is evicted and its slot reused.
+         * @param streamId Stream ID.
+         * @param seq Initial expected RTP sequence.
+         * @returns Slot* Table slot, or nullptr if the stream cannot be tracked.
+         */
+        Slot* claim(uint64_t streamId, uint16_t seq);
+    };
+} // namespace network
+
+#endif // __STREAM_SEQ_TABLE_H__
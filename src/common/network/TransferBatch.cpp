@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/zlib/zlib.h"
+#include "network/TransferBatch.h"
+#include "Utils.h"
+
+using namespace network;
+
+#include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the TransferBatch class. */
+
+TransferBatch::TransferBatch() :
+    m_data(),
+    m_count(0U),
+    m_startedAt(0U)
+{
+    m_data.reserve(TRANSFER_BATCH_MAX_BYTES + TRANSFER_BATCH_MAX_LINE_LEN + 2U);
+}
+
+/* Adds a log line to the batch. */
+
+bool TransferBatch::add(const char* line, uint64_t now)
+{
+    assert(line != nullptr);
+
+    uint32_t len = (uint32_t)::strlen(line);
+    if (len > TRANSFER_BATCH_MAX_LINE_LEN)
+        len = TRANSFER_BATCH_MAX_LINE_LEN;
+
+    if (m_count == 0U)
+        m_startedAt = now;
+
+    m_data.push_back((char)((len >> 8) & 0xFFU));
+    m_data.push_back((char)(len & 0xFFU));
+    m_data.append(line, len);
+    m_count++;
+
+    return m_data.size() >= TRANSFER_BATCH_MAX_BYTES || m_count >= TRANSFER_BATCH_MAX_LINES;
+}
+
+/* Helper to determine if the oldest line in the batch has been held long enough. */
+
+bool TransferBatch::expired(uint64_t now) const
+{
+    if (m_count == 0U)
+        return false;
+
+    return now - m_startedAt >= TRANSFER_BATCH_INTERVAL_MS;
+}
+
+/* Clears the batch. */
+
+void TransferBatch::clear()
+{
+    m_data.clear();
+    m_count = 0U;
+    m_startedAt = 0U;
+}
+
+/* Encodes the batch into a transfer message. */
+
+UInt8Array TransferBatch::encode(uint32_t& length) const
+{
+    length = 0U;
+    if (m_count == 0U)
+        return nullptr;
+
+    // compression structures
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    // initialize compression
+    if (deflateInit(&strm, Z_DEFAULT_COMPRESSION) != Z_OK)
+        return nullptr;
+
+    UInt8Array buffer = std::make_unique<uint8_t[]>(TRANSFER_BATCH_HDR_LEN + TRANSFER_BATCH_MAX_PAYLOAD);
+    ::memset(buffer.get(), 0x00U, TRANSFER_BATCH_HDR_LEN);
+
+    // compress data directly into the message; the batch must fit in a single message
+    strm.avail_in = (uInt)m_data.size();
+    strm.next_in = (Bytef*)m_data.data();
+    strm.avail_out = TRANSFER_BATCH_MAX_PAYLOAD;
+    strm.next_out = buffer.get() + TRANSFER_BATCH_HDR_LEN;
+
+    int ret = deflate(&strm, Z_FINISH);
+    uint32_t compressedLen = (uint32_t)strm.total_out;
+    deflateEnd(&strm);
+
+    if (ret != Z_STREAM_END)
+        return nullptr;
+
+    uint32_t rawLen = (uint32_t)m_data.size();
+    __SET_UINT32(rawLen, buffer, 11U);
+    __SET_UINT16B(m_count, buffer, 15U);
+
+    length = TRANSFER_BATCH_HDR_LEN + compressedLen;
+    return buffer;
+}
+
+/* Gets the lines of the batch. */
+
+std::vector<std::string> TransferBatch::lines() const
+{
+    std::vector<std::string> lines;
+    lines.reserve(m_count);
+
+    const uint8_t* data = (const uint8_t*)m_data.data();
+    uint32_t offs = 0U;
+    while (offs + 2U <= m_data.size()) {
+        uint32_t len = (data[offs] << 8) | data[offs + 1U];
+        lines.emplace_back((const char*)data + offs + 2U, len);
+        offs += 2U + len;
+    }
+
+    return lines;
+}
+
+/* Decodes the lines of a transfer message. */
+
+bool TransferBatch::decode(const uint8_t* data, uint32_t length, std::vector<std::string>& lines)
+{
+    assert(data != nullptr);
+
+    lines.clear();
+    if (length <= TRANSFER_BATCH_HDR_LEN)
+        return false;
+
+    uint32_t rawLen = __GET_UINT32(data, 11U);
+    uint32_t count = __GET_UINT16B(data, 15U);
+    if (rawLen == 0U || rawLen > TRANSFER_BATCH_MAX_BYTES + TRANSFER_BATCH_MAX_LINE_LEN + 2U || count == 0U)
+        return false;
+
+    // compression structures
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    // set input data
+    strm.avail_in = length - TRANSFER_BATCH_HDR_LEN;
+    strm.next_in = (Bytef*)(data + TRANSFER_BATCH_HDR_LEN);
+
+    // initialize decompression
+    if (inflateInit(&strm) != Z_OK)
+        return false;
+
+    // decompress data, the uncompressed length is known up front
+    std::unique_ptr<uint8_t[]> raw = std::make_unique<uint8_t[]>(rawLen);
+    strm.avail_out = rawLen;
+    strm.next_out = raw.get();
+
+    int ret = inflate(&strm, Z_FINISH);
+    uint32_t decompressedLen = (uint32_t)strm.total_out;
+    inflateEnd(&strm);
+
+    if (ret != Z_STREAM_END || decompressedLen != rawLen)
+        return false;
+
+    // split the lines
+    lines.reserve(count);
+    uint32_t offs = 0U;
+    while (offs + 2U <= rawLen) {
+        uint32_t len = (raw[offs] << 8) | raw[offs + 1U];
+        if (offs + 2U + len > rawLen)
+            return false;
+
+        lines.emplace_back((const char*)raw.get() + offs + 2U, len);
+        offs += 2U + len;
+    }
+
+    return lines.size() == count;
+}
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Common Library
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file TransferBatch.h
+ * @ingroup network_core
+ * @file TransferBatch.cpp
+ * @ingroup network_core
+ */
+#if !defined(__TRANSFER_BATCH_H__)
+#define __TRANSFER_BATCH_H__
+
+#include "common/Defines.h"
+#include "common/Utils.h"
+
+#include <string>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t TRANSFER_BATCH_HDR_LEN = 17U;            // 11 byte transfer header + 4 byte length + 2 byte line count
+    const uint32_t TRANSFER_BATCH_MAX_BYTES = 8192U;        // pending log bytes that trigger a batch write
+    const uint32_t TRANSFER_BATCH_MAX_LINES = 256U;         // pending log lines that trigger a batch write
+    const uint32_t TRANSFER_BATCH_MAX_PAYLOAD = 4096U;      // maximum size of a compressed batch
+    const uint32_t TRANSFER_BATCH_MAX_LINE_LEN = 4096U;
+    const uint32_t TRANSFER_BATCH_INTERVAL_MS = 1000U;      // maximum time a log line is held before it is written
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a batch of log lines, for transfer to the FNE in a single compressed message.
+     *  A batch message consists of the usual 11 byte transfer header, followed by the length of the
+     *  uncompressed batch and the number of lines in the batch, followed by the zlib compressed lines;
+     *  each line is prefixed with its 2 byte length.
+     * @ingroup network_core
+     */
+    class HOST_SW_API TransferBatch {
+    public:
+        /**
+         * @brief Initializes a new instance of the TransferBatch class.
+         */
+        TransferBatch();
+
+        /**
+         * @brief Adds a log line to the batch.
+         * @param line Log line.
+         * @param now Current time, in milliseconds.
+         * @returns bool True, if the batch is full and should be written, otherwise false.
+         */
+        bool add(const char* line, uint64_t now);
+        /**
+         * @brief Helper to determine if the oldest line in the batch has been held long enough.
+         * @param now Current time, in milliseconds.
+         * @returns bool True, if the batch should be written, otherwise false.
+         */
+        bool expired(uint64_t now) const;
+
+        /**
+         * @brief Gets the number of lines in the batch.
+         * @returns uint32_t Number of lines in the batch.
+         */
+        uint32_t count() const { return m_count; }
+        /**
+         * @brief Helper to determine if the batch is empty.
+         * @returns bool True, if the batch is empty, otherwise false.
+         */
+        bool empty() const { return m_count == 0U; }
+        /**
+         * @brief Clears the batch.
+         */
+        void clear();
+
+        /**
+         * @brief Encodes the batch into a transfer message.
+         * @param[out] length Length of the transfer message.
+         * @returns UInt8Array Transfer message, or nullptr if the batch could not be compressed into a
+         *  single message.
+         */
+        UInt8Array encode(uint32_t& length) const;
+        /**
+         * @brief Gets the lines of the batch.
+         * @returns std::vector<std::string> Lines of the batch.
+         */
+        std::vector<std::string> lines() const;
+
+        /**
+         * @brief Decodes the lines of a transfer message.
+         * @param data Transfer message.
+         * @param length Length of the transfer message.
+         * @param[out] lines Lines of the batch.
+         * @returns bool True, if the transfer message was decoded, otherwise false.
+         */
+        static bool decode(const uint8_t* data, uint32_t length, std::vector<std::string>& lines);
+
+    private:
+        std::string m_data;
+        uint32_t m_count;
+        uint64_t m_startedAt;
+    };
+} // namespace network
+
+#endif // __TRANSFER_BATCH_H__
@@ -5,11 +5,12 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2006-2016,2020 Jonathan Naylor, G4KLX
- *  Copyright (C) 2017-2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2017-2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
 #include "network/udp/Socket.h"
+#include "network/PacketBuffer.h"
 #include "Log.h"
 #include "Utils.h"
 
@@ -19,6 +20,7 @@ using namespace network::udp;
 #include <cassert>
 #include <cerrno>
 #include <cstring>
+#include <utility>
 
 #if !defined(_WIN32)
 #include <ifaddrs.h>
@@ -28,7 +30,8 @@ using namespace network::udp;
 //  Constants
 // ---------------------------------------------------------------------------
 
-#define MAX_BUFFER_COUNT 16384
+#define MAX_READ_BATCH_COUNT 64U
+#define MAX_WRITE_BATCH_COUNT 256U
 
 // ---------------------------------------------------------------------------
 //  Public Class Members
@@ -157,6 +160,36 @@ bool Socket::open(const uint32_t af, const std::string& address, const uint16_t
     return true;
 }
 
+/* Opens UDP socket connection, bound to an ephemeral port on the local address. */
+
+bool Socket::openEphemeral(uint32_t af) noexcept
+{
+    if (!open(af, m_localAddress, 0U))
+        return false;
+
+    if (!bind(m_localAddress, 0U)) {
+        close();
+        return false;
+    }
+
+    // record the port assigned, so a re-open binds the same port
+    sockaddr_storage bound;
+    ::memset(&bound, 0x00U, sizeof(sockaddr_storage));
+    socklen_t length = sizeof(sockaddr_storage);
+    if (::getsockname(m_fd, reinterpret_cast<sockaddr*>(&bound), &length) < 0) {
+#if defined(_WIN32)
+        LogError(LOG_NET, "Cannot get the bound UDP address, err: %lu", ::GetLastError());
+#else
+        LogError(LOG_NET, "Cannot get the bound UDP address, err: %d", errno);
+#endif // defined(_WIN32)
+        close();
+        return false;
+    }
+
+    m_localPort = port(bound);
+    return true;
+}
+
 /* Closes the UDP socket connection. */
 
 void Socket::close()
@@ -233,55 +266,173 @@ ssize_t Socket::read(uint8_t* buffer, uint32_t length, sockaddr_storage& address
 
     // are we crypto wrapped?
     if (m_isCryptoWrapped) {
-        if (m_presharedKey == nullptr) {
-            LogError(LOG_NET, "tried to read datagram encrypted with no key? this shouldn't happen BUGBUG");
+        len = cryptoUnwrap(buffer, len);
+        if (len <= 0)
+            return len;
+    }
+
+    m_counter++;
+    addrLen = size;
+    return len;
+}
+
+/* Read a batch of datagrams from the UDP socket. */
+
+int Socket::readBatch(UDPDatagram* datagrams, uint32_t count, uint32_t bufferLen, int timeout) noexcept
+{
+    assert(datagrams != nullptr);
+    assert(count > 0U);
+    assert(bufferLen > 0U);
+
+#if defined(_WIN32)
+    if (m_fd == INVALID_SOCKET)
+        return -1;
+#else
+    if (m_fd < 0)
+        return -1;
+#endif // defined(_WIN32)
+
+    if (count > MAX_READ_BATCH_COUNT)
+        count = MAX_READ_BATCH_COUNT;
+
+    // wait for the socket to become readable
+    struct pollfd pfd;
+    pfd.fd = m_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+#if defined(_WIN32)
+    int ret = WSAPoll(&pfd, 1, timeout);
+#else
+    int ret = ::poll(&pfd, 1, timeout);
+#endif // defined(_WIN32)
+    if (ret < 0) {
+#if defined(_WIN32)
+        LogError(LOG_NET, "Error returned from UDP poll, err: %lu", ::GetLastError());
+#else
+        if (errno == EINTR)
+            return 0;
+        LogError(LOG_NET, "Error returned from UDP poll, err: %d", errno);
+#endif // defined(_WIN32)
+        return -1;
+    }
+
+    if ((pfd.revents & POLLIN) == 0) {
+        // an invalid or errored socket is a failed read, not an idle one; returning 0 here would
+        // have the caller poll again immediately and spin
+        if ((pfd.revents & POLLNVAL) != 0) {
+            LogError(LOG_NET, "UDP poll returned an invalid socket on port %u", m_localPort);
             return -1;
         }
 
-        // does the network packet contain the appropriate magic leader?
-        uint16_t magic = __GET_UINT16B(buffer, 0U);
-        if (magic == AES_WRAPPED_PCKT_MAGIC) {
-            uint32_t cryptedLen = (len - 2U) * sizeof(uint8_t);
-            uint8_t* cryptoBuffer = buffer + 2U;
-
-            // do we need to pad the original buffer to be block aligned?
-            if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
-                uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
-                cryptedLen += alignment;
-
-                // reallocate buffer and copy
-                cryptoBuffer = new uint8_t[cryptedLen];
-                ::memset(cryptoBuffer, 0x00U, cryptedLen);
-                ::memcpy(cryptoBuffer, buffer + 2U, len - 2U);
-            }
+        if ((pfd.revents & POLLERR) != 0) {
+            // fetch (and clear) the pending socket error, so the next poll does not return it again
+            int err = 0;
+            socklen_t errLen = sizeof(err);
+            ::getsockopt(m_fd, SOL_SOCKET, SO_ERROR, (char*)&err, &errLen);
+            LogError(LOG_NET, "Error returned from UDP poll on port %u, err: %d", m_localPort, err);
+            return -1;
+        }
 
-            // Utils::dump(1U, "Socket::read() crypted", cryptoBuffer, cryptedLen);
+        return 0;
+    }
 
-            // decrypt
-            uint8_t* decrypted = m_aes->decryptECB(cryptoBuffer, cryptedLen, m_presharedKey);
+    uint32_t received = 0U;
+#if defined(HAVE_RECVMMSG)
+    struct mmsghdr headers[MAX_READ_BATCH_COUNT];
+    struct iovec chunks[MAX_READ_BATCH_COUNT];
+    ::memset(headers, 0x00U, sizeof(struct mmsghdr) * count);
+
+    for (uint32_t i = 0U; i < count; i++) {
+        assert(datagrams[i].buffer != nullptr);
+        chunks[i].iov_base = datagrams[i].buffer;
+        chunks[i].iov_len = bufferLen;
+
+        headers[i].msg_hdr.msg_name = (void*)&datagrams[i].address;
+        headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        headers[i].msg_hdr.msg_iov = &chunks[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+    }
 
-            // Utils::dump(1U, "Socket::read() decrypted", decrypted, cryptedLen);
+    // drain everything pending (up to count) in a single call
+    int n = ::recvmmsg(m_fd, headers, count, MSG_DONTWAIT, nullptr);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
 
-            // finalize, cleanup buffers and replace with new
-            if (decrypted != nullptr) {
-                ::memset(buffer, 0x00U, len);
-                ::memcpy(buffer, decrypted, len - 2U);
+        LogError(LOG_NET, "Error returned from recvmmsg, err: %d", errno);
+        if (errno == ENOTSOCK) {
+            LogMessage(LOG_NET, "Re-opening UDP port on %u", m_localPort);
+            close();
+            open();
+        }
 
-                delete[] decrypted;
-                len -= 2U;
-            } else {
-                delete[] decrypted;
-                return 0;
-            }
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        datagrams[i].length = headers[i].msg_len;
+        datagrams[i].addrLen = headers[i].msg_hdr.msg_namelen;
+    }
+    received = (uint32_t)n;
+#else
+    // no recvmmsg() on this platform -- drain one datagram at a time until the socket would block
+    while (received < count) {
+        if (received > 0U) {
+            pfd.revents = 0;
+#if defined(_WIN32)
+            ret = WSAPoll(&pfd, 1, 0);
+#else
+            ret = ::poll(&pfd, 1, 0);
+#endif // defined(_WIN32)
+            if (ret <= 0 || (pfd.revents & POLLIN) == 0)
+                break;
         }
-        else {
-            return 0; // this will effectively discard packets without the packet magic
+
+        assert(datagrams[received].buffer != nullptr);
+        socklen_t size = sizeof(sockaddr_storage);
+        ssize_t len = ::recvfrom(pfd.fd, (char*)datagrams[received].buffer, bufferLen, 0, (sockaddr*)&datagrams[received].address, &size);
+        if (len < 0) {
+            if (received > 0U)
+                break;
+
+#if defined(_WIN32)
+            LogError(LOG_NET, "Error returned from recvfrom, err: %lu", ::GetLastError());
+#else
+            LogError(LOG_NET, "Error returned from recvfrom, err: %d", errno);
+            if (errno == ENOTSOCK) {
+                LogMessage(LOG_NET, "Re-opening UDP port on %u", m_localPort);
+                close();
+                open();
+            }
+#endif // defined(_WIN32)
+            return -1;
         }
+
+        datagrams[received].length = (size_t)len;
+        datagrams[received].addrLen = size;
+        received++;
     }
+#endif // defined(HAVE_RECVMMSG)
+
+    // unwrap the batch, discarding (and compacting over) any datagrams that fail
+    uint32_t valid = 0U;
+    for (uint32_t i = 0U; i < received; i++) {
+        ssize_t len = (ssize_t)datagrams[i].length;
+        if (len > 0 && m_isCryptoWrapped)
+            len = cryptoUnwrap(datagrams[i].buffer, len);
+        if (len <= 0)
+            continue;
 
-    m_counter++;
-    addrLen = size;
-    return len;
+        if (valid != i)
+            std::swap(datagrams[valid], datagrams[i]);
+        datagrams[valid].length = (size_t)len;
+
+        valid++;
+        m_counter++;
+    }
+
+    return (int)valid;
 }
 
 /* Write data to the UDP socket. */
@@ -312,7 +463,7 @@ bool Socket::write(const uint8_t* buffer, uint32_t length, const sockaddr_storag
 #endif // defined(_WIN32)
 
     bool result = false;
-    UInt8Array out = nullptr;
+    uint8_t* out = nullptr;
 
     // are we crypto wrapped?
     if (m_isCryptoWrapped) {
@@ -321,49 +472,22 @@ bool Socket::write(const uint8_t* buffer, uint32_t length, const sockaddr_storag
             return false;
         }
 
-        uint32_t cryptedLen = length * sizeof(uint8_t);
-        uint8_t* cryptoBuffer = new uint8_t[length];
-        ::memcpy(cryptoBuffer, buffer, length);
-
-        // do we need to pad the original buffer to be block aligned?
-        if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
-            uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
-            cryptedLen += alignment;
-
-            // reallocate buffer and copy
-            delete[] cryptoBuffer;
-            cryptoBuffer = new uint8_t[cryptedLen];
-            ::memset(cryptoBuffer, 0x00U, cryptedLen);
-            ::memcpy(cryptoBuffer, buffer, length);
-        }
-
-        // encrypt
-        uint8_t* crypted = m_aes->encryptECB(cryptoBuffer, cryptedLen, m_presharedKey);
-
-        // Utils::dump(1U, "Socket::write() crypted", crypted, cryptedLen);
-
-        // finalize, cleanup buffers and replace with new
-        out = std::unique_ptr<uint8_t[]>(new uint8_t[cryptedLen + 2U]);
-        delete[] cryptoBuffer;
-        if (crypted != nullptr) {
-            ::memcpy(out.get() + 2U, crypted, cryptedLen);
-            __SET_UINT16B(AES_WRAPPED_PCKT_MAGIC, out.get(), 0U);
-            delete[] crypted;
-            length = cryptedLen + 2U;
-        } else {
+        uint32_t cryptedLen = 0U;
+        uint8_t* crypted = cryptoWrap(buffer, length, cryptedLen);
+        if (crypted == nullptr) {
             if (lenWritten != nullptr) {
                 *lenWritten = -1;
             }
 
-            delete[] crypted;
             return false;
         }
-    } else {
-        out = std::unique_ptr<uint8_t[]>(new uint8_t[length]);
-        ::memcpy(out.get(), buffer, length);
+
+        out = crypted;
+        buffer = out;
+        length = cryptedLen;
     }
 
-    ssize_t sent = ::sendto(m_fd, (char*)out.get(), length, 0, (sockaddr*)& address, addrLen);
+    ssize_t sent = ::sendto(m_fd, (char*)buffer, length, 0, (sockaddr*)& address, addrLen);
     if (sent < 0) {
 #if defined(_WIN32)
         LogError(LOG_NET, "Error returned from sendto, err: %lu", ::GetLastError());
@@ -384,6 +508,7 @@ bool Socket::write(const uint8_t* buffer, uint32_t length, const sockaddr_storag
         }
     }
 
+    PacketBufferPool::release(out);
     return result;
 }
 
@@ -391,7 +516,6 @@ bool Socket::write(const uint8_t* buffer, uint32_t length, const sockaddr_storag
 
 bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
 {
-    bool result = false;
     if (m_fd < 0) {
         if (lenWritten != nullptr) {
             *lenWritten = -1;
@@ -446,131 +570,75 @@ bool Socket::write(BufferVector& buffers, ssize_t* lenWritten) noexcept
         }
     }
 
-    int sent = 0;
-    struct mmsghdr headers[MAX_BUFFER_COUNT];
-    struct iovec chunks[MAX_BUFFER_COUNT];
+    ssize_t sent = 0;
+    bool result = true;
+    uint32_t count = 0U;
+    struct mmsghdr headers[MAX_WRITE_BATCH_COUNT];
+    struct iovec chunks[MAX_WRITE_BATCH_COUNT];
+
+    // create mmsghdrs from input buffers and send them in batches
+    for (UDPDatagram* dgram : buffers) {
+        if (dgram == nullptr) {
+            LogError(LOG_NET, "Socket::write() missing network buffer data? this isn't normal, skipping");
+            result = false;
+            continue;
+        }
 
-    // create mmsghdrs from input buffers and send them at once
-    int size = buffers.size();
-    for (size_t i = 0; i < buffers.size(); ++i) {
-        if (buffers[i] == nullptr) {
-            --size;
+        if (dgram->buffer == nullptr) {
+            LogError(LOG_NET, "discarding buffered message with len = %u, but deleted buffer?", dgram->length);
+            result = false;
             continue;
         }
 
-        uint32_t length = buffers[i]->length;
-        if (buffers[i]->buffer == nullptr) {
-            LogError(LOG_NET, "discarding buffered message with len = %u, but deleted buffer?", length);
-            --size;
+        if (m_af != dgram->address.ss_family) {
+            LogError(LOG_NET, "Socket::write() mismatched network address family? this isn't normal, skipping");
+            result = false;
             continue;
         }
 
-        try {
-            // are we crypto wrapped?
-            if (m_isCryptoWrapped && m_presharedKey != nullptr) {
-                uint32_t cryptedLen = length * sizeof(uint8_t);
-                uint8_t* cryptoBuffer = buffers[i]->buffer;
-
-                // do we need to pad the original buffer to be block aligned?
-                if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
-                    uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
-                    cryptedLen += alignment;
-
-                    // reallocate buffer and copy
-                    cryptoBuffer = new uint8_t[cryptedLen];
-                    ::memset(cryptoBuffer, 0x00U, cryptedLen);
-                    ::memcpy(cryptoBuffer, buffers.at(i)->buffer, length);
-                }
-
-                // encrypt
-                uint8_t* crypted = m_aes->encryptECB(cryptoBuffer, cryptedLen, m_presharedKey);
-                delete[] cryptoBuffer;
-
-                if (crypted == nullptr) {
-                    --size;
-                    continue;
-                }
-
-                // Utils::dump(1U, "Socket::write() crypted", crypted, cryptedLen);
-
-                // finalize
-                UInt8Array __outBuf = std::make_unique<uint8_t[]>(cryptedLen + 2U);
-                uint8_t* out = __outBuf.get();
-                ::memcpy(out + 2U, crypted, cryptedLen);
-                __SET_UINT16B(AES_WRAPPED_PCKT_MAGIC, out, 0U);
-
-                // cleanup buffers and replace with new
-                delete[] crypted;
-                //delete buffers[i]->buffer;
-
-                // this should never happen...
-                if (buffers[i] == nullptr) {
-                    --size;
-                    continue;
-                }
-
-                buffers[i]->buffer = new uint8_t[cryptedLen + 2U];
-                ::memcpy(buffers[i]->buffer, out, cryptedLen + 2U);
-                buffers[i]->length = cryptedLen + 2U;
+        // are we crypto wrapped?
+        if (m_isCryptoWrapped) {
+            uint32_t cryptedLen = 0U;
+            uint8_t* crypted = cryptoWrap(dgram->buffer, dgram->length, cryptedLen);
+            if (crypted == nullptr) {
+                result = false;
+                continue;
             }
 
-            chunks[i].iov_len = buffers.at(i)->length;
-            chunks[i].iov_base = buffers.at(i)->buffer;
-            sent += buffers.at(i)->length;
+            // Utils::dump(1U, "Socket::write() crypted", crypted, cryptedLen);
 
-            headers[i].msg_hdr.msg_name = (void*)&buffers.at(i)->address;
-            headers[i].msg_hdr.msg_namelen = buffers.at(i)->addrLen;
-            headers[i].msg_hdr.msg_iov = &chunks[i];
-            headers[i].msg_hdr.msg_iovlen = 1;
-            headers[i].msg_hdr.msg_control = 0;
-            headers[i].msg_hdr.msg_controllen = 0;
+            // replace the buffer with the wrapped buffer
+            PacketBufferPool::release(dgram->buffer);
+            dgram->buffer = crypted;
+            dgram->length = cryptedLen;
         }
-        catch (...) {
-            --size;
-        }
-    }
 
-    bool skip = false;
-    for (auto& buffer : buffers) {
-        if (buffer == nullptr) {
-            LogError(LOG_NET, "Socket::write() missing network buffer data? this isn't normal, aborting");
-            skip = true;
-            break;
-        }
-
-        if (m_af != buffer->address.ss_family) {
-            LogError(LOG_NET, "Socket::write() mismatched network address family? this isn't normal, aborting");
-            skip = true;
-            break;
+        chunks[count].iov_len = dgram->length;
+        chunks[count].iov_base = dgram->buffer;
+
+        ::memset(&headers[count], 0x00U, sizeof(struct mmsghdr));
+        headers[count].msg_hdr.msg_name = (void*)&dgram->address;
+        headers[count].msg_hdr.msg_namelen = dgram->addrLen;
+        headers[count].msg_hdr.msg_iov = &chunks[count];
+        headers[count].msg_hdr.msg_iovlen = 1;
+        headers[count].msg_hdr.msg_control = 0;
+        headers[count].msg_hdr.msg_controllen = 0;
+        count++;
+
+        if (count == MAX_WRITE_BATCH_COUNT) {
+            if (!sendBatch(headers, count, sent))
+                result = false;
+            count = 0U;
         }
     }
 
-    if (skip) {
-        if (lenWritten != nullptr) {
-            *lenWritten = -1;
-        }
-
-        return false;
+    if (count > 0U) {
+        if (!sendBatch(headers, count, sent))
+            result = false;
     }
 
-    if (sendmmsg(m_fd, headers, size, 0) < 0) {
-        LogError(LOG_NET, "Error returned from sendmmsg, err: %d", errno);
-        if (lenWritten != nullptr) {
-            *lenWritten = -1;
-        }
-    }
-
-    if (sent < 0) {
-        LogError(LOG_NET, "Error returned from sendmmsg, err: %d", errno);
-        if (lenWritten != nullptr) {
-            *lenWritten = -1;
-        }
-    }
-    else {
-        result = true;
-        if (lenWritten != nullptr) {
-            *lenWritten = sent;
-        }
+    if (lenWritten != nullptr) {
+        *lenWritten = (sent > 0) ? sent : -1;
     }
 
     return result;
@@ -583,9 +651,11 @@ void Socket::setPresharedKey(const uint8_t* presharedKey)
     if (presharedKey != nullptr) {
         ::memset(m_presharedKey, 0x00U, AES_WRAPPED_PCKT_KEY_LEN);
         ::memcpy(m_presharedKey, presharedKey, AES_WRAPPED_PCKT_KEY_LEN);
+        m_aes->setKey(m_presharedKey);
         m_isCryptoWrapped = true;
     } else {
         ::memset(m_presharedKey, 0x00U, AES_WRAPPED_PCKT_KEY_LEN);
+        m_aes->clearKey();
         m_isCryptoWrapped = false;
     }
 }
@@ -834,6 +904,122 @@ bool Socket::bind(const std::string& ipAddr, const uint16_t port) noexcept(false
     return retval;
 }
 
+/* Internal helper to unwrap (decrypt) a crypto wrapped datagram in place. */
+
+ssize_t Socket::cryptoUnwrap(uint8_t* buffer, ssize_t len)
+{
+    if (m_presharedKey == nullptr) {
+        LogError(LOG_NET, "tried to read datagram encrypted with no key? this shouldn't happen BUGBUG");
+        return -1;
+    }
+
+    if (len < 2) {
+        return 0;
+    }
+
+    // does the network packet contain the appropriate magic leader?
+    uint16_t magic = __GET_UINT16B(buffer, 0U);
+    if (magic != AES_WRAPPED_PCKT_MAGIC) {
+        return 0; // this will effectively discard packets without the packet magic
+    }
+
+    uint32_t cryptedLen = (len - 2U) * sizeof(uint8_t);
+
+    // do we need to pad the original buffer to be block aligned?
+    if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
+        uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
+        cryptedLen += alignment;
+
+        // reallocate buffer and copy
+        uint8_t* cryptoBuffer = PacketBufferPool::alloc(cryptedLen);
+        ::memset(cryptoBuffer, 0x00U, cryptedLen);
+        ::memcpy(cryptoBuffer, buffer + 2U, len - 2U);
+
+        // decrypt
+        bool ret = m_aes->decryptECBInPlace(cryptoBuffer, cryptedLen);
+        if (ret)
+            ::memcpy(buffer, cryptoBuffer, len - 2U);
+        PacketBufferPool::release(cryptoBuffer);
+
+        if (!ret)
+            return 0;
+    }
+    else {
+        // Utils::dump(1U, "Socket::cryptoUnwrap() crypted", buffer + 2U, cryptedLen);
+
+        // decrypt in place, and shift the payload over the packet magic
+        if (!m_aes->decryptECBInPlace(buffer + 2U, cryptedLen))
+            return 0;
+
+        ::memmove(buffer, buffer + 2U, len - 2U);
+    }
+
+    // Utils::dump(1U, "Socket::cryptoUnwrap() decrypted", buffer, len - 2U);
+
+    buffer[len - 2U] = 0x00U;
+    buffer[len - 1U] = 0x00U;
+
+    return len - 2U;
+}
+
+/* Internal helper to wrap (encrypt) a datagram. */
+
+uint8_t* Socket::cryptoWrap(const uint8_t* buffer, uint32_t length, uint32_t& outLength)
+{
+    outLength = 0U;
+    if (m_presharedKey == nullptr) {
+        LogError(LOG_NET, "tried to write datagram encrypted with no key? this shouldn't happen BUGBUG");
+        return nullptr;
+    }
+
+    // pad the original buffer to be block aligned
+    uint32_t cryptedLen = length * sizeof(uint8_t);
+    if (cryptedLen % crypto::AES::BLOCK_BYTES_LEN != 0) {
+        uint32_t alignment = crypto::AES::BLOCK_BYTES_LEN - (cryptedLen % crypto::AES::BLOCK_BYTES_LEN);
+        cryptedLen += alignment;
+    }
+
+    // encrypt the zero padded datagram in place behind the packet magic
+    uint8_t* out = PacketBufferPool::alloc(cryptedLen + 2U);
+    __SET_UINT16B(AES_WRAPPED_PCKT_MAGIC, out, 0U);
+    ::memcpy(out + 2U, buffer, length);
+    ::memset(out + 2U + length, 0x00U, cryptedLen - length);
+
+    if (!m_aes->encryptECBInPlace(out + 2U, cryptedLen)) {
+        PacketBufferPool::release(out);
+        return nullptr;
+    }
+
+    // Utils::dump(1U, "Socket::cryptoWrap() crypted", out + 2U, cryptedLen);
+
+    outLength = cryptedLen + 2U;
+    return out;
+}
+
+/* Internal helper to send a batch of message headers, retrying any partially sent batch. */
+
+bool Socket::sendBatch(struct mmsghdr* headers, uint32_t count, ssize_t& sent)
+{
+    uint32_t offset = 0U;
+    while (offset < count) {
+        int ret = sendmmsg(m_fd, headers + offset, count - offset, 0);
+        if (ret < 0) {
+#if !defined(_WIN32)
+            if (errno == EINTR)
+                continue;
+#endif // !defined(_WIN32)
+            LogError(LOG_NET, "Error returned from sendmmsg, err: %d", errno);
+            return false;
+        }
+
+        for (int i = 0; i < ret; i++)
+            sent += headers[offset + i].msg_len;
+        offset += (uint32_t)ret;
+    }
+
+    return true;
+}
+
 /* Initialize the sockaddr_in structure with the provided IP and port */
 
 void Socket::initAddr(const std::string& ipAddr, const int port, sockaddr_in& addr) noexcept(false)
@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2006-2016,2020 Jonathan Naylor, G4KLX
- *  Copyright (C) 2017-2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2017-2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -81,12 +81,12 @@ namespace network
         __THROW.  */
         static inline int sendmmsg(int sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags)
         {
-            ssize_t n = 0;
-            for (unsigned int i = 0; i < vlen; i++) {
-                ssize_t ret = sendmsg(sockfd, &msgvec[i].msg_hdr, flags);
+            unsigned int n = 0;
+            for (; n < vlen; n++) {
+                ssize_t ret = sendmsg(sockfd, &msgvec[n].msg_hdr, flags);
                 if (ret < 0)
                     break;
-                n += ret;
+                msgvec[n].msg_len = (unsigned int)ret;
             }
 
             if (n == 0)
@@ -135,12 +135,13 @@ namespace network
         __THROW.  */
         static inline int sendmmsg(SOCKET sockfd, struct mmsghdr* msgvec, unsigned int vlen, int flags)
         {
-            ssize_t n = 0;
-            for (unsigned int i = 0; i < vlen; i++) {
-                ssize_t ret = ::sendto(sockfd, (char*)&msgvec[i].msg_hdr.msg_iov->iov_base, msgvec[i].msg_hdr.msg_iov->iov_len, 0, (sockaddr*)&msgvec[i].msg_hdr.msg_name, msgvec[i].msg_hdr.msg_namelen);
+            unsigned int n = 0;
+            for (; n < vlen; n++) {
+                ssize_t ret = ::sendto(sockfd, (char*)msgvec[n].msg_hdr.msg_iov->iov_base, (int)msgvec[n].msg_hdr.msg_iov->iov_len, flags, 
+                    (sockaddr*)msgvec[n].msg_hdr.msg_name, msgvec[n].msg_hdr.msg_namelen);
                 if (ret < 0)
                     break;
-                n += ret;
+                msgvec[n].msg_len = (unsigned int)ret;
             }
 
             if (n == 0)
@@ -157,6 +158,8 @@ namespace network
 
         /**
          * @brief This structure represents a container for a network buffer.
+         *  Datagrams written with Socket::write(BufferVector&) must have buffers allocated from the
+         *  PacketBufferPool, as the buffer may be replaced when the datagram is crypto wrapped.
          * @ingroup udp_socket
          */
         struct UDPDatagram {
@@ -165,6 +168,8 @@ namespace network
 
             sockaddr_storage address;   //! Address and Port
             uint32_t addrLen;           //! Length of address structure
+
+            uint64_t queued;            //! Time the datagram was queued for writing (see NetMetrics::now())
         };
 
         /** @brief Vector of buffers that contain a full frames */
@@ -221,6 +226,21 @@ namespace network
              * @returns bool True, if UDP socket is opened, otherwise false.
              */
             bool open(const uint32_t af, const std::string& address, const uint16_t port) noexcept;
+            /**
+             * @brief Opens UDP socket connection, bound to an ephemeral port on the local address.
+             *  The port assigned is available from getLocalPort(), and is bound again if the socket
+             *  is re-opened.
+             * @param af Address family.
+             * @returns bool True, if UDP socket is opened, otherwise false.
+             */
+            bool openEphemeral(uint32_t af = AF_INET) noexcept;
+            /**
+             * @brief Gets the local port of the UDP socket.
+             *  When the socket is opened with openEphemeral(), this is the ephemeral port it was
+             *  bound to.
+             * @returns uint16_t Local port.
+             */
+            uint16_t getLocalPort() const { return m_localPort; }
 
             /**
              * @brief Closes the UDP socket connection.
@@ -236,6 +256,19 @@ namespace network
              * @returns ssize_t Actual length of data read from remote UDP socket.
              */
             virtual ssize_t read(uint8_t* buffer, uint32_t length, sockaddr_storage& address, uint32_t& addrLen) noexcept;
+            /**
+             * @brief Read a batch of datagrams from the UDP socket.
+             *  This waits up to the given timeout for the socket to become readable, and then drains
+             *  as many pending datagrams as will fit into the given array (using a single recvmmsg() where
+             *  available). Datagrams that fail crypto unwrapping are discarded, and the remaining datagrams
+             *  are compacted to the front of the array.
+             * @param[out] datagrams Array of datagrams to read into; each entry must have a buffer of bufferLen bytes.
+             * @param count Number of entries in the datagram array.
+             * @param bufferLen Length of each datagram buffer.
+             * @param timeout Time in milliseconds to wait for the socket to become readable (0 returns immediately, -1 waits indefinitely).
+             * @returns int Number of datagrams read, 0 if the timeout elapsed, or -1 on error.
+             */
+            virtual int readBatch(UDPDatagram* datagrams, uint32_t count, uint32_t bufferLen, int timeout) noexcept;
             /**
              * @brief Write data to the UDP socket.
              * @param[in] buffer Buffer containing data to write to socket.
@@ -248,6 +281,8 @@ namespace network
             virtual bool write(const uint8_t* buffer, uint32_t length, const sockaddr_storage& address, uint32_t addrLen, ssize_t* lenWritten = nullptr) noexcept;
             /**
              * @brief Write data to the UDP socket.
+             *  The buffers are sent in batches (using sendmmsg() where available); if crypto wrapping is
+             *  enabled, each buffer is replaced in place with its wrapped form.
              * @param[in] buffers Vector of buffers to write to socket.
              * @param[out] lenWritten Total number of bytes written.
              * @returns bool True, if messages were sent otherwise, false.
@@ -348,6 +383,30 @@ namespace network
              */
             bool bind(const std::string& ipAddr, const uint16_t port);
 
+            /**
+             * @brief Internal helper to unwrap (decrypt) a crypto wrapped datagram in place.
+             * @param buffer Buffer containing the received datagram.
+             * @param len Length of the received datagram.
+             * @returns ssize_t Length of the unwrapped datagram, 0 if the datagram should be discarded, or -1 on error.
+             */
+            ssize_t cryptoUnwrap(uint8_t* buffer, ssize_t len);
+            /**
+             * @brief Internal helper to wrap (encrypt) a datagram.
+             * @param[in] buffer Buffer containing the datagram to wrap.
+             * @param length Length of the datagram.
+             * @param[out] outLength Length of the wrapped datagram.
+             * @returns uint8_t* Pooled buffer containing the wrapped datagram, or nullptr on failure.
+             */
+            uint8_t* cryptoWrap(const uint8_t* buffer, uint32_t length, uint32_t& outLength);
+            /**
+             * @brief Internal helper to send a batch of message headers, retrying any partially sent batch.
+             * @param headers Array of message headers.
+             * @param count Number of message headers.
+             * @param[out] sent Total number of bytes written.
+             * @returns bool True, if all messages were sent, otherwise false.
+             */
+            bool sendBatch(struct mmsghdr* headers, uint32_t count, ssize_t& sent);
+
             /**
              * @brief Initialize the sockaddr_in structure with the provided IP and port.
              * @param ipAddr IP address to bind to.
@@ -69,11 +69,11 @@ bool AccessControl::validateTGId(uint32_t id)
     }
 
     // lookup TID and perform test for validity
-    TalkgroupRuleGroupVoice tid = m_tidLookup->find(id);
-    if (tid.isInvalid())
+    TalkgroupRuleGroupVoiceHandle tid = m_tidLookup->find(id);
+    if (tid->isInvalid())
         return false;
 
-    if (!tid.config().active())
+    if (!tid->config().active())
         return false;
 
     return true;
@@ -93,8 +93,8 @@ bool AccessControl::tgidNonPreferred(uint32_t id)
     }
 
     // lookup TID and perform test for validity
-    TalkgroupRuleGroupVoice tid = m_tidLookup->find(id);
-    if (tid.config().nonPreferred())
+    TalkgroupRuleGroupVoiceHandle tid = m_tidLookup->find(id);
+    if (tid->config().nonPreferred())
         return true;
 
     return false;
@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2022,2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2024,2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "nxdn/channel/CAC.h"
@@ -199,15 +199,9 @@ bool CAC::decode(const uint8_t* data, bool longInbound)
         edac::Convolution conv;
         conv.start();
 
-        n = 0U;
-        for (uint32_t i = 0U; i < (NXDN_CAC_LONG_CRC_LENGTH_BITS + 4U); i++) {
-            uint8_t s0 = puncture[n++];
-            uint8_t s1 = puncture[n++];
-
-            if (!conv.decode(s0, s1)) {
-                LogError(LOG_NXDN, "CAC::decode(longInbound), failed to decode convolution, i = %u, n = %u", i);
-                return false;
-            }
+        if (!conv.decodeBlock(puncture, NXDN_CAC_LONG_CRC_LENGTH_BITS + 4U)) {
+            LogError(LOG_NXDN, "CAC::decode(longInbound), failed to decode convolution");
+            return false;
         }
 
         conv.chainback(m_data, NXDN_CAC_LONG_CRC_LENGTH_BITS);
@@ -257,15 +251,9 @@ bool CAC::decode(const uint8_t* data, bool longInbound)
         edac::Convolution conv;
         conv.start();
 
-        n = 0U;
-        for (uint32_t i = 0U; i < (NXDN_CAC_SHORT_CRC_LENGTH_BITS + 4U); i++) {
-            uint8_t s0 = pass[n++];
-            uint8_t s1 = pass[n++];
-
-            if (!conv.decode(s0, s1)) {
-                LogError(LOG_NXDN, "CAC::decode(), failed to decode convolution, i = %u, n = %u", i);
-                return false;
-            }
+        if (!conv.decodeBlock(pass, NXDN_CAC_SHORT_CRC_LENGTH_BITS + 4U)) {
+            LogError(LOG_NXDN, "CAC::decode(), failed to decode convolution");
+            return false;
         }
 
         conv.chainback(m_data, NXDN_CAC_SHORT_CRC_LENGTH_BITS);
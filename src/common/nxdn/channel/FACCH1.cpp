@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2018 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "nxdn/channel/FACCH1.h"
@@ -123,15 +124,9 @@ bool FACCH1::decode(const uint8_t* data, uint32_t offset)
     edac::Convolution conv;
     conv.start();
 
-    n = 0U;
-    for (uint32_t i = 0U; i < (NXDN_FACCH1_CRC_LENGTH_BITS + 4U); i++) {
-        uint8_t s0 = puncture[n++];
-        uint8_t s1 = puncture[n++];
-
-        if (!conv.decode(s0, s1)) {
-            LogError(LOG_NXDN, "FACCH1::decode(), failed to decode convolution, i = %u, n = %u", i);
-            return false;
-        }
+    if (!conv.decodeBlock(puncture, NXDN_FACCH1_CRC_LENGTH_BITS + 4U)) {
+        LogError(LOG_NXDN, "FACCH1::decode(), failed to decode convolution");
+        return false;
     }
 
     conv.chainback(m_data, NXDN_FACCH1_CRC_LENGTH_BITS);
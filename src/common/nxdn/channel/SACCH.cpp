@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2018 Jonathan Naylor, G4KLX
- *  Copyright (C) 2022,2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2024,2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "nxdn/channel/SACCH.h"
@@ -125,15 +125,9 @@ bool SACCH::decode(const uint8_t* data)
     edac::Convolution conv;
     conv.start();
 
-    n = 0U;
-    for (uint32_t i = 0U; i < (NXDN_SACCH_CRC_LENGTH_BITS + 4U); i++) {
-        uint8_t s0 = puncture[n++];
-        uint8_t s1 = puncture[n++];
-
-        if (!conv.decode(s0, s1)) {
-            LogError(LOG_NXDN, "SACCH::decode(), failed to decode convolution, i = %u, n = %u", i);
-            return false;
-        }
+    if (!conv.decodeBlock(puncture, NXDN_SACCH_CRC_LENGTH_BITS + 4U)) {
+        LogError(LOG_NXDN, "SACCH::decode(), failed to decode convolution");
+        return false;
     }
 
     conv.chainback(m_data, NXDN_SACCH_CRC_LENGTH_BITS);
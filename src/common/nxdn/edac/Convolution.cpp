@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015,2016,2018,2021 Jonathan Naylor, G4KLX
- *  Copyright (C) 2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "nxdn/edac/Convolution.h"
@@ -17,18 +17,30 @@ using namespace nxdn::edac;
 #include <cstring>
 #include <cstdlib>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONV_ACS_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define CONV_ACS_NEON
+#include <arm_neon.h>
+#endif
+
 // ---------------------------------------------------------------------------
 //  Constants
 // ---------------------------------------------------------------------------
 
-const uint8_t BRANCH_TABLE1[] = { 0U, 0U, 0U, 0U, 2U, 2U, 2U, 2U };
-const uint8_t BRANCH_TABLE2[] = { 0U, 2U, 2U, 0U, 0U, 2U, 2U, 0U };
+// branch symbols of the even transition out of each butterfly, scaled to the soft symbol range
+const uint16_t BRANCH_TABLE1[] = { 0U, 0U, 0U, 0U, CONV_SOFT_SYMBOL_MAX, CONV_SOFT_SYMBOL_MAX, CONV_SOFT_SYMBOL_MAX, CONV_SOFT_SYMBOL_MAX };
+const uint16_t BRANCH_TABLE2[] = { 0U, CONV_SOFT_SYMBOL_MAX, CONV_SOFT_SYMBOL_MAX, 0U, 0U, CONV_SOFT_SYMBOL_MAX, CONV_SOFT_SYMBOL_MAX, 0U };
 
 const uint32_t NUM_OF_STATES_D2 = 8U;
 const uint32_t NUM_OF_STATES = 16U;
-const uint32_t M = 4U;
+const uint32_t M = 2U * CONV_SOFT_SYMBOL_MAX;
 const uint32_t K = 5U;
 
+// hard decision symbols (0, 1, 2) are scaled onto the soft decision range
+const uint16_t HARD_SCALE = CONV_SOFT_SYMBOL_MAX / 2U;
+
 // ---------------------------------------------------------------------------
 //  Public Class Members
 // ---------------------------------------------------------------------------
@@ -36,26 +48,19 @@ const uint32_t K = 5U;
 /* Initializes a new instance of the Convolution class. */
 
 Convolution::Convolution() :
-    m_metrics1(nullptr),
-    m_metrics2(nullptr),
-    m_oldMetrics(nullptr),
-    m_newMetrics(nullptr),
-    m_decisions(nullptr),
-    m_dp(nullptr)
+    m_metrics1(),
+    m_metrics2(),
+    m_oldMetrics(m_metrics1),
+    m_newMetrics(m_metrics2),
+    m_decisions(),
+    m_dp(m_decisions)
 {
-    m_metrics1  = new uint16_t[20U];
-    m_metrics2  = new uint16_t[20U];
-    m_decisions = new uint64_t[300U];
+    /* stub */
 }
 
 /* Finalizes a instance of the Convolution class. */
 
-Convolution::~Convolution()
-{
-    delete[] m_metrics1;
-    delete[] m_metrics2;
-    delete[] m_decisions;
-}
+Convolution::~Convolution() = default;
 
 /* Starts convolution processing. */
 
@@ -69,7 +74,7 @@ void Convolution::start()
     m_dp = m_decisions;
 }
 
-/* */
+/* Traces back the decoded bits through the recorded decisions. */
 
 uint32_t Convolution::chainback(uint8_t* out, uint32_t nBits)
 {
@@ -77,6 +82,8 @@ uint32_t Convolution::chainback(uint8_t* out, uint32_t nBits)
 
     uint32_t state = 0U;
 
+    // the bits are recovered last to first; gather them into bytes before writing them out
+    uint8_t bits = 0U, mask = 0U;
     while (nBits-- > 0) {
         --m_dp;
 
@@ -84,7 +91,13 @@ uint32_t Convolution::chainback(uint8_t* out, uint32_t nBits)
         uint8_t bit = uint8_t(*m_dp >> i) & 1;
         state = (bit << 7) | (state >> 1);
 
-        WRITE_BIT(out, nBits, bit != 0U);
+        uint8_t pos = 0x80U >> (nBits & 7U);
+        bits |= (bit != 0U) ? pos : 0U;
+        mask |= pos;
+        if ((nBits & 7U) == 0U) {
+            out[nBits >> 3] = (out[nBits >> 3] & ~mask) | bits;
+            bits = mask = 0U;
+        }
     }
 
     uint32_t minCost = m_oldMetrics[0];
@@ -97,44 +110,44 @@ uint32_t Convolution::chainback(uint8_t* out, uint32_t nBits)
     return minCost / (M >> 1);
 }
 
-/* */
+/* Decodes a pair of hard decision symbols. */
 
 bool Convolution::decode(uint8_t s0, uint8_t s1)
 {
-    *m_dp = 0U;
+    return step(s0 * HARD_SCALE, s1 * HARD_SCALE);
+}
 
-    for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
-        uint8_t j = i * 2U;
+/* Decodes a block of hard decision symbol pairs. */
 
-        uint16_t metric = std::abs(BRANCH_TABLE1[i] - s0) + std::abs(BRANCH_TABLE2[i] - s1);
+bool Convolution::decodeBlock(const uint8_t* symbols, uint32_t count)
+{
+    assert(symbols != nullptr);
 
-        uint16_t m0 = m_oldMetrics[i] + metric;
-        uint16_t m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + (M - metric);
-        uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
-        m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
+    for (uint32_t i = 0U; i < count; i++, symbols += 2U) {
+        if (!step(symbols[0U] * HARD_SCALE, symbols[1U] * HARD_SCALE))
+            return false;
+    }
 
-        m0 = m_oldMetrics[i] + (M - metric);
-        m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + metric;
-        uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
-        m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
+    return true;
+}
 
-        *m_dp |= (uint64_t(decision1) << (j + 1U)) | (uint64_t(decision0) << (j + 0U));
-    }
+/* Decodes a block of soft decision symbol pairs. */
 
-    ++m_dp;
+bool Convolution::decodeSoft(const uint8_t* symbols, uint32_t count)
+{
+    assert(symbols != nullptr);
 
-    if ((m_dp - m_decisions) > 300) {
-        return false;
+    for (uint32_t i = 0U; i < count; i++, symbols += 2U) {
+        uint16_t s0 = (symbols[0U] > CONV_SOFT_SYMBOL_MAX) ? CONV_SOFT_SYMBOL_MAX : symbols[0U];
+        uint16_t s1 = (symbols[1U] > CONV_SOFT_SYMBOL_MAX) ? CONV_SOFT_SYMBOL_MAX : symbols[1U];
+        if (!step(s0, s1))
+            return false;
     }
 
-    uint16_t* tmp = m_oldMetrics;
-    m_oldMetrics = m_newMetrics;
-    m_newMetrics = tmp;
-
     return true;
 }
 
-/* */
+/* Encodes the given bits. */
 
 void Convolution::encode(const uint8_t* in, uint8_t* out, uint32_t nBits) const
 {
@@ -162,3 +175,97 @@ void Convolution::encode(const uint8_t* in, uint8_t* out, uint32_t nBits) const
         k++;
     }
 }
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to run one add-compare-select step of the decoder. */
+
+bool Convolution::step(uint16_t s0, uint16_t s1)
+{
+    // path metrics are bounded by CONV_MAX_STEPS * M, so they never overflow (or go negative
+    // when treated as signed)
+    if ((uint32_t)(m_dp - m_decisions) >= CONV_MAX_STEPS) {
+        return false;
+    }
+
+    // butterfly i joins states i and i + 8 into states 2i and 2i + 1; the decision for a new state
+    // is set when the path from the upper state is taken (ties included)
+#if defined(CONV_ACS_SSE2)
+    __m128i v0 = _mm_set1_epi16((int16_t)s0);
+    __m128i v1 = _mm_set1_epi16((int16_t)s1);
+    __m128i b1 = _mm_loadu_si128((const __m128i*)BRANCH_TABLE1);
+    __m128i b2 = _mm_loadu_si128((const __m128i*)BRANCH_TABLE2);
+
+    __m128i metric = _mm_add_epi16(_mm_max_epi16(_mm_sub_epi16(b1, v0), _mm_sub_epi16(v0, b1)),
+        _mm_max_epi16(_mm_sub_epi16(b2, v1), _mm_sub_epi16(v1, b2)));
+    __m128i inverse = _mm_sub_epi16(_mm_set1_epi16((int16_t)M), metric);
+
+    __m128i lower = _mm_loadu_si128((const __m128i*)m_oldMetrics);
+    __m128i upper = _mm_loadu_si128((const __m128i*)(m_oldMetrics + NUM_OF_STATES_D2));
+
+    __m128i m00 = _mm_add_epi16(lower, metric), m01 = _mm_add_epi16(upper, inverse);
+    __m128i m10 = _mm_add_epi16(lower, inverse), m11 = _mm_add_epi16(upper, metric);
+    __m128i new0 = _mm_min_epi16(m00, m01), new1 = _mm_min_epi16(m10, m11);
+    __m128i keep0 = _mm_cmplt_epi16(m00, m01), keep1 = _mm_cmplt_epi16(m10, m11);
+
+    _mm_storeu_si128((__m128i*)m_newMetrics, _mm_unpacklo_epi16(new0, new1));
+    _mm_storeu_si128((__m128i*)(m_newMetrics + NUM_OF_STATES_D2), _mm_unpackhi_epi16(new0, new1));
+
+    __m128i keep = _mm_packs_epi16(_mm_unpacklo_epi16(keep0, keep1), _mm_unpackhi_epi16(keep0, keep1));
+    *m_dp = (uint16_t)~_mm_movemask_epi8(keep);
+#elif defined(CONV_ACS_NEON)
+    static const uint16_t WEIGHTS[] = { 0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U };
+
+    uint16x8_t v0 = vdupq_n_u16(s0);
+    uint16x8_t v1 = vdupq_n_u16(s1);
+
+    uint16x8_t metric = vaddq_u16(vabdq_u16(vld1q_u16(BRANCH_TABLE1), v0), vabdq_u16(vld1q_u16(BRANCH_TABLE2), v1));
+    uint16x8_t inverse = vsubq_u16(vdupq_n_u16((uint16_t)M), metric);
+
+    uint16x8_t lower = vld1q_u16(m_oldMetrics);
+    uint16x8_t upper = vld1q_u16(m_oldMetrics + NUM_OF_STATES_D2);
+
+    uint16x8_t m00 = vaddq_u16(lower, metric), m01 = vaddq_u16(upper, inverse);
+    uint16x8_t m10 = vaddq_u16(lower, inverse), m11 = vaddq_u16(upper, metric);
+
+    uint16x8x2_t next = vzipq_u16(vminq_u16(m00, m01), vminq_u16(m10, m11));
+    vst1q_u16(m_newMetrics, next.val[0U]);
+    vst1q_u16(m_newMetrics + NUM_OF_STATES_D2, next.val[1U]);
+
+    uint16x8_t weights = vld1q_u16(WEIGHTS);
+    uint16x8x2_t decision = vzipq_u16(vcgeq_u16(m00, m01), vcgeq_u16(m10, m11));
+    *m_dp = (uint16_t)(vaddvq_u16(vandq_u16(decision.val[0U], weights)) |
+        (vaddvq_u16(vandq_u16(decision.val[1U], weights)) << 8));
+#else
+    uint32_t decisions = 0U;
+    for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
+        uint8_t j = i * 2U;
+
+        uint16_t metric = std::abs(BRANCH_TABLE1[i] - s0) + std::abs(BRANCH_TABLE2[i] - s1);
+
+        uint16_t m0 = m_oldMetrics[i] + metric;
+        uint16_t m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + (M - metric);
+        uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
+        m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
+
+        m0 = m_oldMetrics[i] + (M - metric);
+        m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + metric;
+        uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
+        m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
+
+        decisions |= (decision1 << (j + 1U)) | (decision0 << (j + 0U));
+    }
+
+    *m_dp = (uint16_t)decisions;
+#endif
+
+    ++m_dp;
+
+    uint16_t* tmp = m_oldMetrics;
+    m_oldMetrics = m_newMetrics;
+    m_newMetrics = tmp;
+
+    return true;
+}
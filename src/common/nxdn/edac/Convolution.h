@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2015,2016,2018,2021 Jonathan Naylor, G4KLX
- *  Copyright (C) 2022 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2022,2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -29,12 +29,30 @@ namespace nxdn
 {
     namespace edac
     {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Maximum value of a soft decision symbol; 0 is a confident 0 bit, CONV_SOFT_SYMBOL_MAX
+         *  a confident 1 bit and CONV_SOFT_SYMBOL_MAX / 2 an erasure.
+         * @ingroup nxdn_edac
+         */
+        const uint8_t   CONV_SOFT_SYMBOL_MAX = 16U;
+        /**
+         * @brief Maximum number of symbol pairs that can be decoded in one block.
+         * @ingroup nxdn_edac
+         */
+        const uint32_t  CONV_MAX_STEPS = 300U;
+
         // ---------------------------------------------------------------------------
         //  Class Declaration
         // ---------------------------------------------------------------------------
 
         /**
          * @brief Implements NXDN frame convolution processing.
+         *  Decoding is a 16 state Viterbi decoder; the add-compare-select butterflies of each
+         *  step are vectorized (SSE2 or NEON, with a scalar fallback).
          * @ingroup nxdn_edac
          */
         class HOST_SW_API Convolution {
@@ -53,38 +71,60 @@ namespace nxdn
              */
             void start();
             /**
-             * @brief 
-             * @param out 
-             * @param nBits 
-             * @returns uint32_t 
+             * @brief Traces back the decoded bits through the recorded decisions.
+             * @param out Buffer to place the decoded bits.
+             * @param nBits Number of bits to decode.
+             * @returns uint32_t Path metric of the best path (in bit errors).
              */
             uint32_t chainback(uint8_t* out, uint32_t nBits);
 
             /**
-             * @brief 
-             * @param s0 
-             * @param s1 
-             * @returns bool
+             * @brief Decodes a pair of hard decision symbols.
+             * @param s0 First symbol (0 = 0 bit, 1 = erasure, 2 = 1 bit).
+             * @param s1 Second symbol (0 = 0 bit, 1 = erasure, 2 = 1 bit).
+             * @returns bool True, if decoded, otherwise false.
              */
             bool decode(uint8_t s0, uint8_t s1);
             /**
-             * @brief 
-             * @param[in] in 
-             * @param[out] out 
-             * @param nBits 
+             * @brief Decodes a block of hard decision symbol pairs.
+             * @param symbols Symbols (0 = 0 bit, 1 = erasure, 2 = 1 bit), 2 per pair.
+             * @param count Number of symbol pairs.
+             * @returns bool True, if decoded, otherwise false.
+             */
+            bool decodeBlock(const uint8_t* symbols, uint32_t count);
+            /**
+             * @brief Decodes a block of soft decision symbol pairs.
+             * @param symbols Symbols (0 - CONV_SOFT_SYMBOL_MAX), 2 per pair.
+             * @param count Number of symbol pairs.
+             * @returns bool True, if decoded, otherwise false.
+             */
+            bool decodeSoft(const uint8_t* symbols, uint32_t count);
+            /**
+             * @brief Encodes the given bits.
+             * @param[in] in Bits to encode.
+             * @param[out] out Buffer to place the encoded bits.
+             * @param nBits Number of bits to encode.
              */
             void encode(const uint8_t* in, uint8_t* out, uint32_t nBits) const;
 
         private:
-            uint16_t* m_metrics1;
-            uint16_t* m_metrics2;
+            uint16_t m_metrics1[16U];
+            uint16_t m_metrics2[16U];
 
             uint16_t* m_oldMetrics;
             uint16_t* m_newMetrics;
 
-            uint64_t* m_decisions;
+            uint16_t m_decisions[CONV_MAX_STEPS];
+
+            uint16_t* m_dp;
 
-            uint64_t* m_dp;
+            /**
+             * @brief Helper to run one add-compare-select step of the decoder.
+             * @param s0 First soft decision symbol.
+             * @param s1 Second soft decision symbol.
+             * @returns bool True, if decoded, otherwise false.
+             */
+            bool step(uint16_t s0, uint16_t s1);
         };
     } // namespace edac
 } // namespace nxdn
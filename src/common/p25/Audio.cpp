@@ -5,6 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016 Jonathan Naylor, G4KLX
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
@@ -40,45 +41,30 @@ uint32_t Audio::process(uint8_t* data)
 {
     assert(data != nullptr);
 
-    uint32_t errs = 0U;
-
-    uint8_t imbe[18U];
-
-    P25Utils::decode(data, imbe, 114U, 262U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 114U, 262U);
-
-    P25Utils::decode(data, imbe, 262U, 410U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 262U, 410U);
-
-    P25Utils::decode(data, imbe, 452U, 600U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 452U, 600U);
-
-    P25Utils::decode(data, imbe, 640U, 788U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 640U, 788U);
-
-    P25Utils::decode(data, imbe, 830U, 978U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 830U, 978U);
-
-    P25Utils::decode(data, imbe, 1020U, 1168U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 1020U, 1168U);
-
-    P25Utils::decode(data, imbe, 1208U, 1356U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 1208U, 1356U);
-
-    P25Utils::decode(data, imbe, 1398U, 1546U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 1398U, 1546U);
-
-    P25Utils::decode(data, imbe, 1578U, 1726U);
-    errs += m_fec.regenerateIMBE(imbe);
-    P25Utils::encode(imbe, data, 1578U, 1726U);
+    // regenerate all 9 IMBE frames of the LDU at once
+    uint8_t imbe[9U * edac::IMBE_FEC_LENGTH_BYTES];
+
+    P25Utils::decode(data, imbe + (0U * edac::IMBE_FEC_LENGTH_BYTES), 114U, 262U);
+    P25Utils::decode(data, imbe + (1U * edac::IMBE_FEC_LENGTH_BYTES), 262U, 410U);
+    P25Utils::decode(data, imbe + (2U * edac::IMBE_FEC_LENGTH_BYTES), 452U, 600U);
+    P25Utils::decode(data, imbe + (3U * edac::IMBE_FEC_LENGTH_BYTES), 640U, 788U);
+    P25Utils::decode(data, imbe + (4U * edac::IMBE_FEC_LENGTH_BYTES), 830U, 978U);
+    P25Utils::decode(data, imbe + (5U * edac::IMBE_FEC_LENGTH_BYTES), 1020U, 1168U);
+    P25Utils::decode(data, imbe + (6U * edac::IMBE_FEC_LENGTH_BYTES), 1208U, 1356U);
+    P25Utils::decode(data, imbe + (7U * edac::IMBE_FEC_LENGTH_BYTES), 1398U, 1546U);
+    P25Utils::decode(data, imbe + (8U * edac::IMBE_FEC_LENGTH_BYTES), 1578U, 1726U);
+
+    uint32_t errs = m_fec.regenerateIMBE(imbe, 9U);
+
+    P25Utils::encode(imbe + (0U * edac::IMBE_FEC_LENGTH_BYTES), data, 114U, 262U);
+    P25Utils::encode(imbe + (1U * edac::IMBE_FEC_LENGTH_BYTES), data, 262U, 410U);
+    P25Utils::encode(imbe + (2U * edac::IMBE_FEC_LENGTH_BYTES), data, 452U, 600U);
+    P25Utils::encode(imbe + (3U * edac::IMBE_FEC_LENGTH_BYTES), data, 640U, 788U);
+    P25Utils::encode(imbe + (4U * edac::IMBE_FEC_LENGTH_BYTES), data, 830U, 978U);
+    P25Utils::encode(imbe + (5U * edac::IMBE_FEC_LENGTH_BYTES), data, 1020U, 1168U);
+    P25Utils::encode(imbe + (6U * edac::IMBE_FEC_LENGTH_BYTES), data, 1208U, 1356U);
+    P25Utils::encode(imbe + (7U * edac::IMBE_FEC_LENGTH_BYTES), data, 1398U, 1546U);
+    P25Utils::encode(imbe + (8U * edac::IMBE_FEC_LENGTH_BYTES), data, 1578U, 1726U);
 
     return errs;
 }
@@ -5,7 +5,7 @@
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
  *  Copyright (C) 2016 Jonathan Naylor, G4KLX
- *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2024-2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "Defines.h"
@@ -17,6 +17,64 @@ using namespace p25;
 using namespace p25::defines;
 
 #include <cassert>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+// every P25_SS_INCREMENT bits of a frame carry P25_SS_DATA_BITS bits of data followed by a
+// status symbol; the status symbols therefore always occupy the last two bits of a byte
+const uint32_t P25_SS_DATA_BITS = P25_SS0_START;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to copy a run of bits between arbitrary bit offsets. */
+
+static void copyBits(const uint8_t* in, uint32_t inPos, uint8_t* out, uint32_t outPos, uint32_t length)
+{
+    // copy bit by bit up to a destination byte boundary
+    for (; length > 0U && (outPos & 7U) != 0U; length--, inPos++, outPos++) {
+        bool b = READ_BIT(in, inPos);
+        WRITE_BIT(out, outPos, b);
+    }
+
+    // copy whole destination bytes
+    uint32_t bytes = length >> 3;
+    const uint8_t* src = in + (inPos >> 3);
+    uint8_t* dst = out + (outPos >> 3);
+
+    uint32_t shift = inPos & 7U;
+    if (shift == 0U) {
+        ::memcpy(dst, src, bytes);
+    }
+    else {
+        for (uint32_t i = 0U; i < bytes; i++)
+            dst[i] = (uint8_t)((src[i] << shift) | (src[i + 1U] >> (8U - shift)));
+    }
+
+    inPos += bytes * 8U;
+    outPos += bytes * 8U;
+    length &= 7U;
+
+    // copy any remaining bits
+    for (; length > 0U; length--, inPos++, outPos++) {
+        bool b = READ_BIT(in, inPos);
+        WRITE_BIT(out, outPos, b);
+    }
+}
+
+/* Helper to write a status symbol into each status byte of P25 frame data. */
+
+static void writeStatusBits(uint8_t* data, uint32_t length, uint32_t interval, uint8_t bits)
+{
+    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * interval)) {
+        uint8_t& b = data[ss0Pos >> 3];
+        b = (b & 0xFCU) | bits;
+    }
+}
 
 // ---------------------------------------------------------------------------
 //  Static Class Members
@@ -49,11 +107,7 @@ void P25Utils::setStatusBitsAllIdle(uint8_t* data, uint32_t length)
     assert(data != nullptr);
 
     // set "1,1" (Idle) status bits [TIA-102.BAAA]
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        WRITE_BIT(data, ss0Pos, true);              // 1
-        WRITE_BIT(data, ss1Pos, true);              // 1
-    }
+    writeStatusBits(data, length, 1U, 0x03U);
 }
 
 /* Helper to add the status bits on P25 frame data. */
@@ -63,29 +117,16 @@ void P25Utils::addStatusBits(uint8_t* data, uint32_t length, bool busy, bool unk
     assert(data != nullptr);
 
     // set "1,0" (Unknown) status bits [TIA-102.BAAA]
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += P25_SS_INCREMENT) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        WRITE_BIT(data, ss0Pos, true);              // 1
-        WRITE_BIT(data, ss1Pos, false);             // 0
-    }
+    writeStatusBits(data, length, 1U, 0x02U);
 
     // interleave the requested status bits (every other)
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * 2U)) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        if (busy) {
-            // set "0,1" (Busy) status bits [TIA-102.BAAA]
-            WRITE_BIT(data, ss0Pos, false);         // 0
-            WRITE_BIT(data, ss1Pos, true);          // 1
-        } else {
-            if (unknown) {
-                // set "1,0" (Unknown) status bits [TIA-102.BAAA]
-                WRITE_BIT(data, ss0Pos, true);      // 1
-                WRITE_BIT(data, ss1Pos, false);     // 0
-            } else {
-                // set "1,1" (Start of Inbound Slot/Idle) status bits [TIA-102.BAAA]
-                WRITE_BIT(data, ss0Pos, true);      // 1
-                WRITE_BIT(data, ss1Pos, true);      // 1
-            }
+    if (busy) {
+        // set "0,1" (Busy) status bits [TIA-102.BAAA]
+        writeStatusBits(data, length, 2U, 0x01U);
+    } else {
+        if (!unknown) {
+            // set "1,1" (Start of Inbound Slot/Idle) status bits [TIA-102.BAAA]
+            writeStatusBits(data, length, 2U, 0x03U);
         }
     }
 }
@@ -99,12 +140,8 @@ void P25Utils::addUnknownStatusBits(uint8_t* data, uint32_t length, uint8_t inte
     if (interval == 0U)
         interval = 1U;
 
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * interval)) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        // set "1,0" (Unknown) status bits [TIA-102.BAAA]
-        WRITE_BIT(data, ss0Pos, true);              // 1
-        WRITE_BIT(data, ss1Pos, false);             // 0
-    }
+    // set "1,0" (Unknown) status bits [TIA-102.BAAA]
+    writeStatusBits(data, length, interval, 0x02U);
 }
 
 /* Helper to add the idle (1,1) status bits on P25 frame data. */
@@ -116,12 +153,8 @@ void P25Utils::addIdleStatusBits(uint8_t* data, uint32_t length, uint8_t interva
     if (interval == 0U)
         interval = 1U;
 
-    for (uint32_t ss0Pos = P25_SS0_START; ss0Pos < length; ss0Pos += (P25_SS_INCREMENT * interval)) {
-        uint32_t ss1Pos = ss0Pos + 1U;
-        // set "1,1" (Start of Inbound Slot/Idle) status bits [TIA-102.BAAA]
-        WRITE_BIT(data, ss0Pos, true);              // 1
-        WRITE_BIT(data, ss1Pos, true);              // 1
-    }
+    // set "1,1" (Start of Inbound Slot/Idle) status bits [TIA-102.BAAA]
+    writeStatusBits(data, length, interval, 0x03U);
 }
 
 /* Decode bit interleaving. */
@@ -131,28 +164,24 @@ uint32_t P25Utils::decode(const uint8_t* in, uint8_t* out, uint32_t start, uint3
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // Move the SSx positions to the range needed
-    uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
-    while (ss0Pos < start) {
-        ss0Pos += P25_SS_INCREMENT;
-        ss1Pos += P25_SS_INCREMENT;
-    }
-
+    // copy the runs of data bits between the status symbols; a status symbol is skipped unless the
+    // range starts on its second bit
     uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++) {
-        if (i == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (i == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, i);
-            WRITE_BIT(out, n, b);
-            n++;
+    uint32_t pos = start;
+    while (pos < stop) {
+        uint32_t offset = pos % P25_SS_INCREMENT;
+        if (offset >= P25_SS_DATA_BITS && !(offset == P25_SS_DATA_BITS + 1U && pos == start)) {
+            pos++;
+            continue;
         }
+
+        uint32_t run = (offset < P25_SS_DATA_BITS) ? P25_SS_DATA_BITS - offset : 1U;
+        if (run > stop - pos)
+            run = stop - pos;
+
+        copyBits(in, pos, out, n, run);
+        pos += run;
+        n += run;
     }
 
     return n;
@@ -165,28 +194,24 @@ uint32_t P25Utils::encode(const uint8_t* in, uint8_t* out, uint32_t start, uint3
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // Move the SSx positions to the range needed
-    uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
-    while (ss0Pos < start) {
-        ss0Pos += P25_SS_INCREMENT;
-        ss1Pos += P25_SS_INCREMENT;
-    }
-
+    // copy the runs of data bits between the status symbols; a status symbol is skipped unless the
+    // range starts on its second bit
     uint32_t n = 0U;
-    for (uint32_t i = start; i < stop; i++) {
-        if (i == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (i == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, n);
-            WRITE_BIT(out, i, b);
-            n++;
+    uint32_t pos = start;
+    while (pos < stop) {
+        uint32_t offset = pos % P25_SS_INCREMENT;
+        if (offset >= P25_SS_DATA_BITS && !(offset == P25_SS_DATA_BITS + 1U && pos == start)) {
+            pos++;
+            continue;
         }
+
+        uint32_t run = (offset < P25_SS_DATA_BITS) ? P25_SS_DATA_BITS - offset : 1U;
+        if (run > stop - pos)
+            run = stop - pos;
+
+        copyBits(in, n, out, pos, run);
+        pos += run;
+        n += run;
     }
 
     return n;
@@ -199,29 +224,17 @@ uint32_t P25Utils::encodeByLength(const uint8_t* in, uint8_t* out, uint32_t leng
     assert(in != nullptr);
     assert(out != nullptr);
 
-    // Move the SSx positions to the range needed
-    uint32_t ss0Pos = P25_SS0_START;
-    uint32_t ss1Pos = P25_SS1_START;
-
+    // each whole status symbol period is a byte aligned copy of the data bits
     uint32_t n = 0U;
     uint32_t pos = 0U;
-    while (n < length) {
-        if (pos == ss0Pos) {
-            ss0Pos += P25_SS_INCREMENT;
-        }
-        else if (pos == ss1Pos) {
-            ss1Pos += P25_SS_INCREMENT;
-        }
-        else {
-            bool b = READ_BIT(in, n);
-            WRITE_BIT(out, pos, b);
-            n++;
-        }
-        pos++;
-
+    while (length - n > P25_SS_DATA_BITS) {
+        copyBits(in, n, out, pos, P25_SS_DATA_BITS);
+        n += P25_SS_DATA_BITS;
+        pos += P25_SS_INCREMENT;
     }
 
-    return pos;
+    copyBits(in, n, out, pos, length - n);
+    return pos + (length - n);
 }
 
 /* Compare two datasets for the given length. */
@@ -18,6 +18,8 @@
 #include <cstdarg>
 #include <ctime>
 #include <cassert>
+#include <mutex>
+#include <unordered_map>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -26,6 +28,7 @@
 #define EOL    "\r\n"
 
 const uint32_t ACT_LOG_BUFFER_LEN = 501U;
+const uint32_t PEER_LOG_BUFFER_LEN = 65536U;
 
 // ---------------------------------------------------------------------------
 //  Global Variables
@@ -38,6 +41,17 @@ static FILE* m_actFpLog = nullptr;
 
 static struct tm m_actTm;
 
+/**
+ * @brief Represents an open peer log file.
+ */
+struct PeerLogFile {
+    FILE* fp;
+    struct tm tm;
+};
+
+static std::mutex m_peerLogMutex;
+static std::unordered_map<uint64_t, PeerLogFile> m_peerLogs;
+
 // ---------------------------------------------------------------------------
 //  Global Functions
 // ---------------------------------------------------------------------------
@@ -94,6 +108,13 @@ void ActivityLogFinalise()
 #endif
     if (m_actFpLog != nullptr)
         ::fclose(m_actFpLog);
+
+    std::lock_guard<std::mutex> lock(m_peerLogMutex);
+    for (auto& entry : m_peerLogs) {
+        if (entry.second.fp != nullptr)
+            ::fclose(entry.second.fp);
+    }
+    m_peerLogs.clear();
 }
 
 /* Writes a new entry to the activity log. */
@@ -132,3 +153,69 @@ void ActivityLog(const char* msg, ...)
         ::fflush(stdout);
     }
 }
+
+/* Writes a batch of log lines transferred from a peer, to the peer's own log file. */
+
+void PeerLogWrite(uint32_t peerId, bool diag, const std::vector<std::string>& lines)
+{
+#if defined(CATCH2_TEST_COMPILATION)
+    return;
+#endif
+    if (CurrentLogFileLevel() == 0U || lines.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(m_peerLogMutex);
+
+    time_t now;
+    ::time(&now);
+    struct tm tm = *::localtime(&now);
+
+    // open (or roll over) the peer log file
+    uint64_t key = ((uint64_t)peerId << 1) | (diag ? 1U : 0U);
+    PeerLogFile& file = m_peerLogs[key];
+    if (file.fp != nullptr && (tm.tm_mday != file.tm.tm_mday || tm.tm_mon != file.tm.tm_mon || tm.tm_year != file.tm.tm_year)) {
+        ::fclose(file.fp);
+        file.fp = nullptr;
+    }
+
+    if (file.fp == nullptr) {
+        char filename[256U];
+        ::snprintf(filename, sizeof(filename), "%s/%s-%.9u-%04d-%02d-%02d.%s.log", m_actFilePath.c_str(), m_actFileRoot.c_str(), peerId,
+            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, diag ? "diag" : "activity");
+
+        file.fp = ::fopen(filename, "a+t");
+        file.tm = tm;
+        if (file.fp == nullptr) {
+            m_peerLogs.erase(key);
+            return;
+        }
+
+        ::setvbuf(file.fp, nullptr, _IOFBF, PEER_LOG_BUFFER_LEN);
+    }
+
+    for (const std::string& line : lines) {
+        ::fwrite(line.data(), 1U, line.size(), file.fp);
+        ::fputc('\n', file.fp);
+    }
+
+    ::fflush(file.fp);
+}
+
+/* Closes the log files of a peer. */
+
+void PeerLogClose(uint32_t peerId)
+{
+#if defined(CATCH2_TEST_COMPILATION)
+    return;
+#endif
+    std::lock_guard<std::mutex> lock(m_peerLogMutex);
+    for (uint64_t key : { (uint64_t)peerId << 1, ((uint64_t)peerId << 1) | 1U }) {
+        auto it = m_peerLogs.find(key);
+        if (it == m_peerLogs.end())
+            continue;
+
+        if (it->second.fp != nullptr)
+            ::fclose(it->second.fp);
+        m_peerLogs.erase(it);
+    }
+}
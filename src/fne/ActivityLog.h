@@ -19,6 +19,7 @@
 #include "Defines.h"
 
 #include <string>
+#include <vector>
 
 // ---------------------------------------------------------------------------
 //  Global Functions
@@ -41,5 +42,18 @@ extern HOST_SW_API void ActivityLogFinalise();
  * This is a variable argument function.
  */
 extern HOST_SW_API void ActivityLog(const char* msg, ...);
+/**
+ * @brief Writes a batch of log lines transferred from a peer, to the peer's own log file.
+ *  The peer log files are kept open, and are written with buffered I/O; the file is flushed once per batch.
+ * @param peerId Peer ID.
+ * @param diag Flag indicating the lines are diagnostic log lines, rather than activity log lines.
+ * @param lines Log lines.
+ */
+extern HOST_SW_API void PeerLogWrite(uint32_t peerId, bool diag, const std::vector<std::string>& lines);
+/**
+ * @brief Closes the log files of a peer (if any are open); a peer that reconnects reopens them.
+ * @param peerId Peer ID.
+ */
+extern HOST_SW_API void PeerLogClose(uint32_t peerId);
 
 #endif // __ACTIVITY_LOG_H__
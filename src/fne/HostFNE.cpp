@@ -648,18 +648,11 @@ void* HostFNE::threadMasterNetwork(void* arg)
         ::pthread_setname_np(th->thread, threadName.c_str());
 #endif // _GNU_SOURCE
 
-        StopWatch stopWatch;
-        stopWatch.start();
-
         if (fne->m_network != nullptr) {
             while (!g_killed) {
-                uint32_t ms = stopWatch.elapsed();
-                stopWatch.start();
-
+                // processNetwork() blocks waiting on the socket (and backs off itself when the read fails),
+                // so there is no need to cycle sleep here
                 fne->m_network->processNetwork();
-
-                if (ms < THREAD_CYCLE_THRESHOLD)
-                    Thread::sleep(THREAD_CYCLE_THRESHOLD);
             }
         }
 
@@ -704,18 +697,11 @@ void* HostFNE::threadDiagNetwork(void* arg)
         ::pthread_setname_np(th->thread, threadName.c_str());
 #endif // _GNU_SOURCE
 
-        StopWatch stopWatch;
-        stopWatch.start();
-
         if (fne->m_diagNetwork != nullptr) {
             while (!g_killed) {
-                uint32_t ms = stopWatch.elapsed();
-                stopWatch.start();
-
+                // processNetwork() blocks waiting on the socket (and backs off itself when the read fails),
+                // so there is no need to cycle sleep here
                 fne->m_diagNetwork->processNetwork();
-
-                if (ms < THREAD_CYCLE_THRESHOLD)
-                    Thread::sleep(THREAD_CYCLE_THRESHOLD);
             }
         }
 
@@ -1011,8 +997,8 @@ void HostFNE::processPeer(network::PeerNetwork* peerNetwork)
     if (peerNetwork->getStatus() != NET_STAT_RUNNING)
         return;
 
-    // process DMR data
-    if (peerNetwork->hasDMRData()) {
+    // process DMR data (the peer network clock may have read several frames at once)
+    while (peerNetwork->hasDMRData()) {
         uint32_t length = 100U;
         bool ret = false;
         UInt8Array data = peerNetwork->readDMR(ret, length);
@@ -1023,10 +1009,12 @@ void HostFNE::processPeer(network::PeerNetwork* peerNetwork)
 
             m_network->dmrTrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId, true);
         }
+        else
+            break;
     }
 
-    // process P25 data
-    if (peerNetwork->hasP25Data()) {
+    // process P25 data (the peer network clock may have read several frames at once)
+    while (peerNetwork->hasP25Data()) {
         uint32_t length = 100U;
         bool ret = false;
         UInt8Array data = peerNetwork->readP25(ret, length);
@@ -1036,10 +1024,12 @@ void HostFNE::processPeer(network::PeerNetwork* peerNetwork)
 
             m_network->p25TrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId, true);
         }
+        else
+            break;
     }
 
-    // process NXDN data
-    if (peerNetwork->hasNXDNData()) {
+    // process NXDN data (the peer network clock may have read several frames at once)
+    while (peerNetwork->hasNXDNData()) {
         uint32_t length = 100U;
         bool ret = false;
         UInt8Array data = peerNetwork->readNXDN(ret, length);
@@ -1049,5 +1039,7 @@ void HostFNE::processPeer(network::PeerNetwork* peerNetwork)
 
             m_network->nxdnTrafficHandler()->processFrame(data.get(), length, peerId, peerNetwork->pktLastSeq(), streamId, true);
         }
+        else
+            break;
     }
 }
@@ -8,6 +8,7 @@
  *
  */
 #include "fne/Defines.h"
+#include "common/network/NetMetrics.h"
 #include "common/zlib/zlib.h"
 #include "common/Log.h"
 #include "common/Utils.h"
@@ -31,7 +32,8 @@ DiagNetwork::DiagNetwork(HostFNE* host, FNENetwork* fneNetwork, const std::strin
     m_fneNetwork(fneNetwork),
     m_host(host),
     m_address(address),
-    m_port(port)
+    m_port(port),
+    m_workerPool("fne:diag-rx", taskNetworkRx)
 {
     assert(fneNetwork != nullptr);
     assert(host != nullptr);
@@ -55,24 +57,37 @@ void DiagNetwork::setPresharedKey(const uint8_t* presharedKey)
 void DiagNetwork::processNetwork()
 {
     if (m_status != NET_STAT_MST_RUNNING) {
+        Thread::sleep(NET_READ_TIMEOUT_MS);
         return;
     }
 
-    sockaddr_storage address;
-    uint32_t addrLen;
-    frame::RTPHeader rtpHeader;
-    frame::RTPFNEHeader fneHeader;
-    int length = 0U;
+    // wait for and read all pending messages
+    int count = m_frameQueue->readBatch(NET_READ_TIMEOUT_MS);
+    if (count < 0) {
+        // the read failed without waiting (socket closed, being re-opened or in error); back off
+        // so the network thread does not spin until the socket recovers
+        Thread::sleep(NET_READ_TIMEOUT_MS);
+        return;
+    }
+
+    uint64_t rxTime = (count > 0) ? NetMetrics::now() : 0U;
+    for (int i = 0; i < count; i++) {
+        sockaddr_storage address;
+        uint32_t addrLen;
+        frame::RTPHeader rtpHeader;
+        frame::RTPFNEHeader fneHeader;
+
+        // the message is not copied, the request holds a view of the pooled receive buffer
+        PacketBuffer packet = m_frameQueue->readBatchPacket(i, address, addrLen, &rtpHeader, &fneHeader);
+        if (packet.length() == 0U)
+            continue;
 
-    // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
-    if (length > 0) {
         if (m_debug)
-            Utils::dump(1U, "Network Message", buffer.get(), length);
+            Utils::dump(1U, "Network Message", packet.data(), packet.length());
 
         uint32_t peerId = fneHeader.getPeerId();
 
-        NetPacketRequest* req = new NetPacketRequest();
+        NetPacketRequest* req = PacketWorkerPool::allocRequest();
         req->peerId = peerId;
 
         req->address = address;
@@ -80,15 +95,16 @@ void DiagNetwork::processNetwork()
         req->rtpHeader = rtpHeader;
         req->fneHeader = fneHeader;
 
-        req->length = length;
-        req->buffer = new uint8_t[length];
-        ::memcpy(req->buffer, buffer.get(), length);
+        // hand the message buffer off to the request
+        req->length = (int)packet.length();
+        req->buffer = packet.data();
+        req->packet = std::move(packet);
+        req->rxTime = rxTime;
 
-        if (!Thread::runAsThread(m_fneNetwork, threadedNetworkRx, req)) {
-            if (req->buffer != nullptr)
-                delete[] req->buffer;
-            delete req;
-            return;
+        req->obj = m_fneNetwork;
+
+        if (!m_workerPool.dispatch(req)) {
+            PacketWorkerPool::freeRequest(req);
         }
     }
 }
@@ -122,6 +138,13 @@ bool DiagNetwork::open()
     bool ret = m_socket->open();
     if (!ret) {
         m_status = NET_STAT_INVALID;
+        return ret;
+    }
+
+    ret = m_workerPool.start(m_fneNetwork->m_workerCnt, m_fneNetwork->m_workerQueueDepth);
+    if (!ret) {
+        m_socket->close();
+        m_status = NET_STAT_INVALID;
     }
 
     return ret;
@@ -134,6 +157,7 @@ void DiagNetwork::close()
     if (m_debug)
         LogMessage(LOG_NET, "Closing Network");
 
+    m_workerPool.stop();
     m_socket->close();
 
     m_status = NET_STAT_INVALID;
@@ -143,40 +167,37 @@ void DiagNetwork::close()
 //  Private Class Members
 // ---------------------------------------------------------------------------
 
+/* Helper to encode a single log line as an individual log transfer message. */
+
+uint32_t DiagNetwork::encodeLogLine(const std::string& line, uint8_t* buffer)
+{
+    assert(buffer != nullptr);
+
+    uint32_t len = (uint32_t)line.size();
+    if (len > DATA_PACKET_LENGTH - 11U)
+        len = DATA_PACKET_LENGTH - 11U;
+
+    ::memset(buffer, 0x00U, 11U);
+    ::memcpy(buffer + 11U, line.data(), len);
+
+    return len + 11U;
+}
+
 /* Process a data frames from the network. */
 
-void* DiagNetwork::threadedNetworkRx(void* arg)
+void DiagNetwork::taskNetworkRx(NetPacketRequest* req)
 {
-    NetPacketRequest* req = (NetPacketRequest*)arg;
     if (req != nullptr) {
-#if defined(_WIN32)
-        ::CloseHandle(req->thread);
-#else
-        ::pthread_detach(req->thread);
-#endif // defined(_WIN32)
-
         FNENetwork* network = static_cast<FNENetwork*>(req->obj);
         if (network == nullptr) {
-            if (req != nullptr) {
-                if (req->buffer != nullptr)
-                    delete[] req->buffer;
-                delete req;
-            }
-
-            return nullptr;
+            PacketWorkerPool::freeRequest(req);
+            return;
         }
 
-        if (req == nullptr)
-            return nullptr;
-
         if (req->length > 0) {
-            uint32_t peerId = req->fneHeader.getPeerId();
+            PeerTable::Snapshot peers = network->m_peers.snapshot();
 
-            std::stringstream peerName;
-            peerName << peerId << ":diag-rx-pckt";
-#ifdef _GNU_SOURCE
-            ::pthread_setname_np(req->thread, peerName.str().c_str());
-#endif // _GNU_SOURCE
+            uint32_t peerId = req->fneHeader.getPeerId();
 
             // process incoming message function opcodes
             switch (req->fneHeader.getFunction()) {
@@ -185,14 +206,14 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                     // resolve peer ID (used for Activity Log and Status Transfer)
                     bool validPeerId = false;
                     uint32_t pktPeerId = 0U;
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
+                    if (peerId > 0 && peers->has(peerId)) {
                         validPeerId = true;
                         pktPeerId = peerId;
                     } else {
                         if (peerId > 0) {
                             // this could be a peer-link transfer -- in which case, we need to check the SSRC of the packet not the peer ID
-                            if (network->m_peers.find(req->rtpHeader.getSSRC()) != network->m_peers.end()) {
-                                FNEPeerConnection* connection = network->m_peers[req->rtpHeader.getSSRC()];
+                            if (peers->has(req->rtpHeader.getSSRC())) {
+                                FNEPeerConnection* connection = peers->find(req->rtpHeader.getSSRC());
                                 if (connection != nullptr) {
                                     if (connection->isExternalPeer() && connection->isPeerLink()) {
                                         validPeerId = true;
@@ -209,7 +230,7 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                         {
                             if (network->m_allowActivityTransfer) {
                                 if (pktPeerId > 0 && validPeerId) {
-                                    FNEPeerConnection* connection = network->m_peers[pktPeerId];
+                                    FNEPeerConnection* connection = peers->find(pktPeerId);
                                     if (connection != nullptr) {
                                         std::string ip = udp::Socket::address(req->address);
 
@@ -231,16 +252,16 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                                                             .field("identity", connection->identity())
                                                             .field("msg", payload)
                                                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                                                    .requestAsync(network->m_influxServer);
+                                                    .requestAsync(network->m_influxWriter);
                                             }
 
                                             // repeat traffic to the connected SysView peers
-                                            if (network->m_peers.size() > 0U) {
-                                                for (auto peer : network->m_peers) {
-                                                    if (peer.second != nullptr) {
-                                                        if (peer.second->isSysView()) {
-                                                            sockaddr_storage addr = peer.second->socketStorage();
-                                                            uint32_t addrLen = peer.second->sockStorageLen();
+                                            if (peers->size() > 0U) {
+                                                for (const PeerEntry& peer : *peers) {
+                                                    if (peer.connection != nullptr) {
+                                                        if (peer.connection->isSysView()) {
+                                                            sockaddr_storage addr = peer.connection->socketStorage();
+                                                            uint32_t addrLen = peer.connection->sockStorageLen();
 
                                                             network->m_frameQueue->write(req->buffer, req->length, network->createStreamId(), pktPeerId, network->m_peerId, 
                                                                 { NET_FUNC::TRANSFER, NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY }, RTP_END_OF_CALL_SEQ, addr, addrLen);
@@ -275,8 +296,8 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                     case NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG:            // Peer Diagnostic Log Transfer
                         {
                             if (network->m_allowDiagnosticTransfer) {
-                                if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                    FNEPeerConnection* connection = network->m_peers[peerId];
+                                if (peerId > 0 && peers->has(peerId)) {
+                                    FNEPeerConnection* connection = peers->find(peerId);
                                     if (connection != nullptr) {
                                         std::string ip = udp::Socket::address(req->address);
 
@@ -301,9 +322,107 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                                                             .field("identity", connection->identity())
                                                             .field("msg", payload)
                                                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                                                    .requestAsync(network->m_influxServer);
+                                                    .requestAsync(network->m_influxWriter);
+                                            }
+                                        }
+                                        else {
+                                            network->writePeerNAK(peerId, network->createStreamId(), TAG_TRANSFER_DIAG_LOG, NET_CONN_NAK_FNE_UNAUTHORIZED);
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                        break;
+
+                    case NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY_BATCH:  // Peer Batched Activity Log Transfer
+                        {
+                            if (network->m_allowActivityTransfer) {
+                                if (pktPeerId > 0 && validPeerId) {
+                                    FNEPeerConnection* connection = peers->find(pktPeerId);
+                                    if (connection != nullptr) {
+                                        std::string ip = udp::Socket::address(req->address);
+
+                                        // validate peer (simple validation really)
+                                        if (connection->connected() && connection->address() == ip) {
+                                            // the whole batch is handled here, in a single pass
+                                            std::vector<std::string> lines;
+                                            if (!network->processLogBatch(pktPeerId, connection, false, req->buffer, req->length, lines))
+                                                break;
+
+                                            uint8_t lineBuffer[DATA_PACKET_LENGTH];
+
+                                            // repeat the batch to the connected SysView peers
+                                            if (peers->size() > 0U) {
+                                                for (const PeerEntry& peer : *peers) {
+                                                    if (peer.connection != nullptr) {
+                                                        if (peer.connection->isSysView()) {
+                                                            sockaddr_storage addr = peer.connection->socketStorage();
+                                                            uint32_t addrLen = peer.connection->sockStorageLen();
+
+                                                            if (peer.connection->batchLogTransfer()) {
+                                                                network->m_frameQueue->write(req->buffer, req->length, network->createStreamId(), pktPeerId, network->m_peerId, 
+                                                                    { NET_FUNC::TRANSFER, NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY_BATCH }, RTP_END_OF_CALL_SEQ, addr, addrLen);
+                                                                continue;
+                                                            }
+
+                                                            // older SysView peers don't understand batches, repeat the lines individually
+                                                            for (const std::string& line : lines) {
+                                                                uint32_t len = encodeLogLine(line, lineBuffer);
+                                                                network->m_frameQueue->write(lineBuffer, len, network->createStreamId(), pktPeerId, network->m_peerId, 
+                                                                    { NET_FUNC::TRANSFER, NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY }, RTP_END_OF_CALL_SEQ, addr, addrLen);
+                                                            }
+                                                        }
+                                                    } else {
+                                                        continue;
+                                                    }
+                                                }
+                                            }
+
+                                            // attempt to repeat the batch to Peer-Link masters
+                                            if (network->m_host->m_peerNetworks.size() > 0) {
+                                                for (auto peer : network->m_host->m_peerNetworks) {
+                                                    if (peer.second != nullptr) {
+                                                        if (peer.second->isEnabled() && peer.second->isPeerLink()) {
+                                                            if (peer.second->batchLogTransfer()) {
+                                                                peer.second->writeMaster({ NET_FUNC::TRANSFER, NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY_BATCH }, 
+                                                                    req->buffer, req->length, RTP_END_OF_CALL_SEQ, 0U, false, true, pktPeerId);
+                                                                continue;
+                                                            }
+
+                                                            // older masters don't understand batches, repeat the lines individually
+                                                            for (const std::string& line : lines) {
+                                                                uint32_t len = encodeLogLine(line, lineBuffer);
+                                                                peer.second->writeMaster({ NET_FUNC::TRANSFER, NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY }, 
+                                                                    lineBuffer, len, RTP_END_OF_CALL_SEQ, 0U, false, true, pktPeerId);
+                                                            }
+                                                        }
+                                                    }
+                                                }
                                             }
                                         }
+                                        else {
+                                            network->writePeerNAK(pktPeerId, network->createStreamId(), TAG_TRANSFER_ACT_LOG, NET_CONN_NAK_FNE_UNAUTHORIZED);
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                        break;
+
+                    case NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG_BATCH:      // Peer Batched Diagnostic Log Transfer
+                        {
+                            if (network->m_allowDiagnosticTransfer) {
+                                if (peerId > 0 && peers->has(peerId)) {
+                                    FNEPeerConnection* connection = peers->find(peerId);
+                                    if (connection != nullptr) {
+                                        std::string ip = udp::Socket::address(req->address);
+
+                                        // validate peer (simple validation really)
+                                        if (connection->connected() && connection->address() == ip) {
+                                            // the whole batch is handled here, in a single pass
+                                            std::vector<std::string> lines;
+                                            network->processLogBatch(peerId, connection, true, req->buffer, req->length, lines);
+                                        }
                                         else {
                                             network->writePeerNAK(peerId, network->createStreamId(), TAG_TRANSFER_DIAG_LOG, NET_CONN_NAK_FNE_UNAUTHORIZED);
                                         }
@@ -316,23 +435,23 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
                     case NET_SUBFUNC::TRANSFER_SUBFUNC_STATUS:          // Peer Status Transfer
                         {
                             if (pktPeerId > 0 && validPeerId) {
-                                FNEPeerConnection* connection = network->m_peers[pktPeerId];
+                                FNEPeerConnection* connection = peers->find(pktPeerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
 
                                     // validate peer (simple validation really)
                                     if (connection->connected() && connection->address() == ip) {
-                                        if (network->m_peers.size() > 0U) {
+                                        if (peers->size() > 0U) {
                                             // attempt to repeat status traffic to SysView clients
-                                            for (auto peer : network->m_peers) {
-                                                if (peer.second != nullptr) {
-                                                    if (peer.second->isSysView()) {
-                                                        sockaddr_storage addr = peer.second->socketStorage();
-                                                        uint32_t addrLen = peer.second->sockStorageLen();
+                                            for (const PeerEntry& peer : *peers) {
+                                                if (peer.connection != nullptr) {
+                                                    if (peer.connection->isSysView()) {
+                                                        sockaddr_storage addr = peer.connection->socketStorage();
+                                                        uint32_t addrLen = peer.connection->sockStorageLen();
 
                                                         if (network->m_debug) {
                                                             LogDebug(LOG_NET, "SysView, srcPeer = %u, dstPeer = %u, peer status message, len = %u", 
-                                                                pktPeerId, peer.first, req->length);
+                                                                pktPeerId, peer.peerId, req->length);
                                                         }
                                                         network->m_frameQueue->write(req->buffer, req->length, network->createStreamId(), pktPeerId, network->m_peerId, 
                                                             { NET_FUNC::TRANSFER, NET_SUBFUNC::TRANSFER_SUBFUNC_STATUS }, RTP_END_OF_CALL_SEQ, addr, addrLen);
@@ -373,8 +492,8 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
 
             case NET_FUNC::PEER_LINK:
                 if (req->fneHeader.getSubFunction() == NET_SUBFUNC::PL_ACT_PEER_LIST) { // Peer-Link Active Peer List
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && peers->has(peerId)) {
+                        FNEPeerConnection* connection = peers->find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
@@ -418,10 +537,6 @@ void* DiagNetwork::threadedNetworkRx(void* arg)
             }
         }
 
-        if (req->buffer != nullptr)
-            delete[] req->buffer;
-        delete req;
+        PacketWorkerPool::freeRequest(req);
     }
-
-    return nullptr;
 }
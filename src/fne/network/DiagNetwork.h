@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2024-2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -67,6 +67,7 @@ namespace network
 
         /**
          * @brief Process a data frames from the network.
+         *  This waits up to NET_READ_TIMEOUT_MS for data, and then dispatches all pending frames.
          */
         void processNetwork();
 
@@ -89,6 +90,7 @@ namespace network
 
     private:
         friend class FNENetwork;
+        friend class ::RESTAPI;
         FNENetwork* m_fneNetwork;
         HostFNE* m_host;
 
@@ -97,12 +99,20 @@ namespace network
 
         NET_CONN_STATUS m_status;
 
+        PacketWorkerPool m_workerPool;
+
+        /**
+         * @brief Helper to encode a single log line as an individual log transfer message.
+         * @param line Log line.
+         * @param[out] buffer Buffer to encode the message into (at least DATA_PACKET_LENGTH bytes).
+         * @returns uint32_t Length of the encoded message.
+         */
+        static uint32_t encodeLogLine(const std::string& line, uint8_t* buffer);
         /**
          * @brief Entry point to process a given network packet.
-         * @param arg Instance of the NetPacketRequest structure.
-         * @returns void* (Ignore)
+         * @param req Instance of the NetPacketRequest structure.
          */
-        static void* threadedNetworkRx(void* arg);
+        static void taskNetworkRx(NetPacketRequest* req);
     };
 } // namespace network
 
@@ -10,6 +10,7 @@
 #include "fne/Defines.h"
 #include "common/edac/SHA256.h"
 #include "common/network/json/json.h"
+#include "common/network/NetMetrics.h"
 #include "common/p25/kmm/KMMFactory.h"
 #include "common/zlib/zlib.h"
 #include "common/Log.h"
@@ -29,6 +30,7 @@ using namespace network::callhandler;
 #include <chrono>
 #include <fstream>
 #include <streambuf>
+#include <thread>
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -75,8 +77,7 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_status(NET_STAT_INVALID),
     m_peers(),
     m_peerLinkPeers(),
-    m_peerAffiliations(),
-    m_ccPeerMap(),
+    m_routeGeneration(0U),
     m_peerLinkKeyQueue(),
     m_maintainenceTimer(1000U, pingTime),
     m_updateLookupTime(updateLookupTime * 60U),
@@ -100,9 +101,13 @@ FNENetwork::FNENetwork(HostFNE* host, const std::string& address, uint16_t port,
     m_influxOrg("dvm"),
     m_influxBucket("dvm"),
     m_influxLogRawData(false),
+    m_influxWriter(nullptr),
     m_disablePacketData(false),
     m_dumpPacketData(false),
     m_verbosePacketData(false),
+    m_workerCnt(0U),
+    m_workerQueueDepth(DEFAULT_PACKET_WORKER_QUEUE_DEPTH),
+    m_workerPool("fne:rx", taskNetworkRx),
     m_reportPeerPing(reportPeerPing),
     m_verbose(verbose)
 {
@@ -123,6 +128,9 @@ FNENetwork::~FNENetwork()
     delete m_tagDMR;
     delete m_tagP25;
     delete m_tagNXDN;
+
+    if (m_influxWriter != nullptr)
+        delete m_influxWriter;
 }
 
 /* Helper to set configuration options. */
@@ -154,8 +162,15 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
     m_influxOrg = conf["influxOrg"].as<std::string>("dvm");
     m_influxBucket = conf["influxBucket"].as<std::string>("dvm");
     m_influxLogRawData = conf["influxLogRawData"].as<bool>(false);
+    uint32_t influxQueueDepth = conf["influxQueueDepth"].as<uint32_t>(influxdb::INFLUX_WRITER_QUEUE_DEPTH);
+    uint32_t influxBatchSize = conf["influxBatchSize"].as<uint32_t>(influxdb::INFLUX_WRITER_BATCH_LINES);
+    uint32_t influxFlushInterval = conf["influxFlushInterval"].as<uint32_t>(influxdb::INFLUX_WRITER_FLUSH_INTERVAL_MS);
     if (m_enableInfluxDB) {
         m_influxServer = influxdb::ServerInfo(m_influxServerAddress, m_influxServerPort, m_influxOrg, m_influxServerToken, m_influxBucket);
+
+        if (m_influxWriter != nullptr)
+            delete m_influxWriter;
+        m_influxWriter = new influxdb::BatchWriter(m_influxServer, influxQueueDepth, influxBatchSize, influxFlushInterval);
     }
 
     m_parrotOnlyOriginating = conf["parrotOnlyToOrginiatingPeer"].as<bool>(false);
@@ -167,6 +182,15 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
     m_dumpPacketData = conf["dumpPacketData"].as<bool>(false);
     m_verbosePacketData = conf["verbosePacketData"].as<bool>(false);
 
+    m_workerCnt = conf["workers"].as<uint32_t>(0U);
+    if (m_workerCnt > MAX_PACKET_WORKERS) {
+        m_workerCnt = MAX_PACKET_WORKERS;
+    }
+    m_workerQueueDepth = conf["workerQueueDepth"].as<uint32_t>(DEFAULT_PACKET_WORKER_QUEUE_DEPTH);
+    if (m_workerQueueDepth == 0U) {
+        m_workerQueueDepth = DEFAULT_PACKET_WORKER_QUEUE_DEPTH;
+    }
+
     /*
     ** Drop Unit to Unit Peers
     */
@@ -185,6 +209,12 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
 
     if (printOptions) {
         LogInfo("    Maximum Permitted Connections: %u", m_softConnLimit);
+        if (m_workerCnt == 0U) {
+            LogInfo("    Packet Workers: auto (%u CPU cores)", std::thread::hardware_concurrency());
+        } else {
+            LogInfo("    Packet Workers: %u", m_workerCnt);
+        }
+        LogInfo("    Packet Worker Queue Depth: %u", m_workerQueueDepth);
         LogInfo("    Disable adjacent site broadcasts to any peers: %s", m_disallowAdjStsBcast ? "yes" : "no");
         if (m_disallowAdjStsBcast) {
             LogWarning(LOG_NET, "NOTICE: All P25 ADJ_STS_BCAST messages will be blocked and dropped!");
@@ -207,6 +237,9 @@ void FNENetwork::setOptions(yaml::Node& conf, bool printOptions)
             LogInfo("    InfluxDB Organization: %s", m_influxOrg.c_str());
             LogInfo("    InfluxDB Bucket: %s", m_influxBucket.c_str());
             LogInfo("    InfluxDB Log Raw TSBK/CSBK/RCCH: %s", m_influxLogRawData ? "yes" : "no");
+            LogInfo("    InfluxDB Queue Depth: %u", influxQueueDepth);
+            LogInfo("    InfluxDB Batch Size: %u", influxBatchSize);
+            LogInfo("    InfluxDB Flush Interval: %ums", influxFlushInterval);
         }
         LogInfo("    Parrot Repeat to Only Originating Peer: %s", m_parrotOnlyOriginating ? "yes" : "no");
     }
@@ -235,24 +268,37 @@ void FNENetwork::setPresharedKey(const uint8_t* presharedKey)
 void FNENetwork::processNetwork()
 {
     if (m_status != NET_STAT_MST_RUNNING) {
+        Thread::sleep(NET_READ_TIMEOUT_MS);
+        return;
+    }
+
+    // wait for and read all pending messages
+    int count = m_frameQueue->readBatch(NET_READ_TIMEOUT_MS);
+    if (count < 0) {
+        // the read failed without waiting (socket closed, being re-opened or in error); back off
+        // so the network thread does not spin until the socket recovers
+        Thread::sleep(NET_READ_TIMEOUT_MS);
         return;
     }
 
-    sockaddr_storage address;
-    uint32_t addrLen;
-    frame::RTPHeader rtpHeader;
-    frame::RTPFNEHeader fneHeader;
-    int length = 0U;
+    uint64_t rxTime = (count > 0) ? NetMetrics::now() : 0U;
+    for (int i = 0; i < count; i++) {
+        sockaddr_storage address;
+        uint32_t addrLen;
+        frame::RTPHeader rtpHeader;
+        frame::RTPFNEHeader fneHeader;
+
+        // the message is not copied, the request holds a view of the pooled receive buffer
+        PacketBuffer packet = m_frameQueue->readBatchPacket(i, address, addrLen, &rtpHeader, &fneHeader);
+        if (packet.length() == 0U)
+            continue;
 
-    // read message
-    UInt8Array buffer = m_frameQueue->read(length, address, addrLen, &rtpHeader, &fneHeader);
-    if (length > 0) {
         if (m_debug)
-            Utils::dump(1U, "Network Message", buffer.get(), length);
+            Utils::dump(1U, "Network Message", packet.data(), packet.length());
 
         uint32_t peerId = fneHeader.getPeerId();
 
-        NetPacketRequest* req = new NetPacketRequest();
+        NetPacketRequest* req = PacketWorkerPool::allocRequest();
         req->peerId = peerId;
 
         req->address = address;
@@ -260,15 +306,20 @@ void FNENetwork::processNetwork()
         req->rtpHeader = rtpHeader;
         req->fneHeader = fneHeader;
 
-        req->length = length;
-        req->buffer = new uint8_t[length];
-        ::memcpy(req->buffer, buffer.get(), length);
+        // hand the message buffer off to the request
+        req->length = (int)packet.length();
+        req->buffer = packet.data();
+        req->packet = std::move(packet);
+        req->rxTime = rxTime;
 
-        if (!Thread::runAsThread(this, threadedNetworkRx, req)) {
-            if (req->buffer != nullptr)
-                delete[] req->buffer;
-            delete req;
-            return;
+        req->obj = this;
+
+        // dispatch the packet to the worker owning this peer and stream; if the worker
+        // queue is full the packet is dropped
+        if (!m_workerPool.dispatch(req)) {
+            if (m_verbose)
+                LogWarning(LOG_NET, "PEER %u worker queue full, dropping packet", peerId);
+            PacketWorkerPool::freeRequest(req);
         }
     }
 }
@@ -281,11 +332,15 @@ void FNENetwork::clock(uint32_t ms)
         return;
     }
 
+    // flush any egress queues holding datagrams past the flush interval
+    m_frameQueue->flushExpired();
+
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
     if (m_forceListUpdate) {
-        for (auto peer : m_peers) {
-            peerACLUpdate(peer.first);
+        PeerTable::Snapshot peers = m_peers.snapshot();
+        for (const PeerEntry& peer : *peers) {
+            peerACLUpdate(peer.peerId);
         }
         m_forceListUpdate = false;
     }
@@ -294,9 +349,10 @@ void FNENetwork::clock(uint32_t ms)
     if (m_maintainenceTimer.isRunning() && m_maintainenceTimer.hasExpired()) {
         // check to see if any peers have been quiet (no ping) longer than allowed
         std::vector<uint32_t> peersToRemove = std::vector<uint32_t>();
-        for (auto peer : m_peers) {
-            uint32_t id = peer.first;
-            FNEPeerConnection* connection = peer.second;
+        PeerTable::Snapshot peers = m_peers.snapshot();
+        for (const PeerEntry& peer : *peers) {
+            uint32_t id = peer.peerId;
+            FNEPeerConnection* connection = peer.connection;
             if (connection != nullptr) {
                 uint64_t dt = 0U;
                 if (connection->isExternalPeer() || connection->isPeerLink())
@@ -327,13 +383,10 @@ void FNENetwork::clock(uint32_t ms)
 
         // remove any peers
         for (uint32_t peerId : peersToRemove) {
-            FNEPeerConnection* connection = m_peers[peerId];
             m_peers.erase(peerId);
-            if (connection != nullptr) {
-                delete connection;
-            }
-
             erasePeerAffiliations(peerId);
+            ::PeerLogClose(peerId);
+            invalidateRoutes();
         }
 
         // roll the RTP timestamp if no call is in progress
@@ -354,11 +407,12 @@ void FNENetwork::clock(uint32_t ms)
                             });
                         }
 
-                        if (m_peers.size() > 0) {
+                        PeerTable::Snapshot currPeers = m_peers.snapshot();
+                        if (currPeers->size() > 0) {
                             json::array peers = json::array();
-                            for (auto entry : m_peers) {
-                                uint32_t peerId = entry.first;
-                                network::FNEPeerConnection* peerConn = entry.second;
+                            for (const PeerEntry& entry : *currPeers) {
+                                uint32_t peerId = entry.peerId;
+                                network::FNEPeerConnection* peerConn = entry.connection;
                                 if (peerConn != nullptr) {
                                     json::object peerObj = fneConnObject(peerId, peerConn);
                                     uint32_t peerNetPeerId = peer.second->getPeerId();
@@ -375,9 +429,10 @@ void FNENetwork::clock(uint32_t ms)
         }
 
         // send ACL updates forcibly to any Peer-Link peers
-        for (auto peer : m_peers) {
-            uint32_t id = peer.first;
-            FNEPeerConnection* connection = peer.second;
+        peers = m_peers.snapshot();
+        for (const PeerEntry& peer : *peers) {
+            uint32_t id = peer.peerId;
+            FNEPeerConnection* connection = peer.connection;
             if (connection != nullptr) {
                 if (connection->connected() && connection->isPeerLink()) {
                     // does this peer need an ACL update?
@@ -440,8 +495,23 @@ bool FNENetwork::open()
     bool ret = m_socket->open();
     if (!ret) {
         m_status = NET_STAT_INVALID;
+        return ret;
     }
 
+    if (m_influxWriter != nullptr && !m_influxWriter->start()) {
+        m_socket->close();
+        m_status = NET_STAT_INVALID;
+        return false;
+    }
+
+    ret = m_workerPool.start(m_workerCnt, m_workerQueueDepth);
+    if (!ret) {
+        m_socket->close();
+        m_status = NET_STAT_INVALID;
+        return ret;
+    }
+
+    LogInfoEx(LOG_NET, "Started %u packet workers", m_workerPool.workerCount());
     return ret;
 }
 
@@ -457,13 +527,19 @@ void FNENetwork::close()
         ::memset(buffer, 0x00U, 1U);
 
         uint32_t streamId = createStreamId();
-        for (auto peer : m_peers) {
-            writePeer(peer.first, { NET_FUNC::MST_CLOSING, NET_SUBFUNC::NOP }, buffer, 1U, RTP_END_OF_CALL_SEQ, streamId, false);
+        PeerTable::Snapshot peers = m_peers.snapshot();
+        for (const PeerEntry& peer : *peers) {
+            writePeer(peer.peerId, { NET_FUNC::MST_CLOSING, NET_SUBFUNC::NOP }, buffer, 1U, RTP_END_OF_CALL_SEQ, streamId, false);
         }
     }
 
+    m_workerPool.stop();
     m_socket->close();
 
+    // write any records still pending to InfluxDB
+    if (m_influxWriter != nullptr)
+        m_influxWriter->stop();
+
     m_maintainenceTimer.stop();
 
     m_status = NET_STAT_INVALID;
@@ -475,45 +551,28 @@ void FNENetwork::close()
 
 /* Process a data frames from the network. */
 
-void* FNENetwork::threadedNetworkRx(void* arg)
+void FNENetwork::taskNetworkRx(NetPacketRequest* req)
 {
-    NetPacketRequest* req = (NetPacketRequest*)arg;
     if (req != nullptr) {
-#if defined(_WIN32)
-        ::CloseHandle(req->thread);
-#else
-        ::pthread_detach(req->thread);
-#endif // defined(_WIN32)
-
         uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
         FNENetwork* network = static_cast<FNENetwork*>(req->obj);
         if (network == nullptr) {
-            if (req != nullptr) {
-                if (req->buffer != nullptr)
-                    delete[] req->buffer;
-                delete req;
-            }
-
-            return nullptr;
+            PacketWorkerPool::freeRequest(req);
+            return;
         }
 
-        if (req == nullptr)
-            return nullptr;
-
         if (req->length > 0) {
+            // take a snapshot of the peer table for the handling of this packet; connections referenced
+            // by the snapshot remain valid while it is held, even if the peer is removed concurrently
+            PeerTable::Snapshot peers = network->m_peers.snapshot();
+
             uint32_t peerId = req->fneHeader.getPeerId();
             uint32_t streamId = req->fneHeader.getStreamId();
 
-            std::stringstream peerName;
-            peerName << peerId << ":rx-pckt";
-#ifdef _GNU_SOURCE
-            ::pthread_setname_np(req->thread, peerName.str().c_str());
-#endif // _GNU_SOURCE
-
             // update current peer packet sequence and stream ID
-            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end()) && streamId != 0U) {
-                FNEPeerConnection* connection = network->m_peers[peerId];
+            if (peerId > 0 && peers->has(peerId) && streamId != 0U) {
+                FNEPeerConnection* connection = peers->find(peerId);
                 uint16_t pktSeq = req->rtpHeader.getSequence();
 
                 if (connection != nullptr) {
@@ -521,22 +580,24 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         // only reset packet sequences if we're a PROTOCOL or RPTC function
                         if ((req->fneHeader.getFunction() == NET_FUNC::PROTOCOL) ||
                             (req->fneHeader.getFunction() == NET_FUNC::RPTC)) {
-                            connection->eraseStreamPktSeq(streamId); // attempt to erase packet sequence for the stream
+                            StreamSeqStats stats;
+                            if (connection->eraseStreamPktSeq(streamId, &stats)) { // attempt to erase packet sequence for the stream
+                                if (network->m_verbose && (stats.outOfSequence > 0U || stats.duplicate > 0U || stats.gap > 0U)) {
+                                    LogMessage(LOG_NET, "PEER %u (%s) stream %u ended, outOfSequence = %u, duplicate = %u, gap = %u", peerId, connection->identity().c_str(),
+                                        streamId, stats.outOfSequence, stats.duplicate, stats.gap);
+                                }
+                            }
                         }
                     } else {
-                        if (connection->hasStreamPktSeq(streamId)) {
-                            uint16_t currPkt = connection->getStreamPktSeq(streamId);
-                            if ((pktSeq != currPkt) && (pktSeq != (RTP_END_OF_CALL_SEQ - 1U)) && pktSeq != 0U) {
-                                LogWarning(LOG_NET, "PEER %u (%s) stream %u out-of-sequence; %u != %u", peerId, connection->identity().c_str(),
-                                    streamId, pktSeq, currPkt);
-                            }
+                        uint16_t currPkt = 0U;
+                        StreamSeqResult::E result = connection->checkStreamPktSeq(streamId, pktSeq, currPkt);
+                        if (result == StreamSeqResult::GAP || result == StreamSeqResult::DUPLICATE || result == StreamSeqResult::OUT_OF_SEQUENCE) {
+                            LogWarning(LOG_NET, "PEER %u (%s) stream %u out-of-sequence; %u != %u", peerId, connection->identity().c_str(),
+                                streamId, pktSeq, currPkt);
                         }
-
-                        connection->incStreamPktSeq(streamId, pktSeq + 1U);
                     }
                 }
 
-                network->m_peers[peerId] = connection;
             }
 
             // if we don't have a stream ID and are receiving call data -- throw an error and discard
@@ -544,11 +605,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 std::string peerIdentity = network->resolvePeerIdentity(peerId);
                 LogError(LOG_NET, "PEER %u (%s) malformed packet (no stream ID for a call?)", peerId, peerIdentity.c_str());
 
-                if (req->buffer != nullptr)
-                    delete[] req->buffer;
-                delete req;
-
-                return nullptr;
+                PacketWorkerPool::freeRequest(req);
+                return;
             }
 
             // process incoming message function opcodes
@@ -559,8 +617,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     switch (req->fneHeader.getSubFunction()) {
                     case NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR:             // Encapsulated DMR data frame
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
                                     connection->lastPing(now);
@@ -570,6 +628,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         if (network->m_dmrEnabled) {
                                             if (network->m_tagDMR != nullptr) {
                                                 network->m_tagDMR->processFrame(req->buffer, req->length, peerId, req->rtpHeader.getSequence(), streamId);
+                                                NetMetrics::latency(NetStage::DISPATCH_PROCESS, req->dispatchTime);
                                             }
                                         } else {
                                             network->writePeerNAK(peerId, streamId, TAG_DMR_DATA, NET_CONN_NAK_MODE_NOT_ENABLED);
@@ -585,8 +644,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                     case NET_SUBFUNC::PROTOCOL_SUBFUNC_P25:             // Encapsulated P25 data frame
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
                                     connection->lastPing(now);
@@ -596,6 +655,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         if (network->m_p25Enabled) {
                                             if (network->m_tagP25 != nullptr) {
                                                 network->m_tagP25->processFrame(req->buffer, req->length, peerId, req->rtpHeader.getSequence(), streamId);
+                                                NetMetrics::latency(NetStage::DISPATCH_PROCESS, req->dispatchTime);
                                             }
                                         } else {
                                             network->writePeerNAK(peerId, streamId, TAG_P25_DATA, NET_CONN_NAK_MODE_NOT_ENABLED);
@@ -611,8 +671,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                     case NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN:            // Encapsulated NXDN data frame
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
                                     connection->lastPing(now);
@@ -622,6 +682,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         if (network->m_nxdnEnabled) {
                                             if (network->m_tagNXDN != nullptr) {
                                                 network->m_tagNXDN->processFrame(req->buffer, req->length, peerId, req->rtpHeader.getSequence(), streamId);
+                                                NetMetrics::latency(NetStage::DISPATCH_PROCESS, req->dispatchTime);
                                             }
                                         } else {
                                             network->writePeerNAK(peerId, streamId, TAG_NXDN_DATA, NET_CONN_NAK_MODE_NOT_ENABLED);
@@ -644,15 +705,15 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
             case NET_FUNC::RPTL:                                        // Repeater Login
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) == network->m_peers.end())) {
-                        if (network->m_peers.size() >= MAX_HARD_CONN_CAP) {
-                            LogError(LOG_NET, "PEER %u attempted to connect with no more connections available, currConnections = %u", peerId, network->m_peers.size());
+                    if (peerId > 0 && !peers->has(peerId)) {
+                        if (network->m_peers.count() >= MAX_HARD_CONN_CAP) {
+                            LogError(LOG_NET, "PEER %u attempted to connect with no more connections available, currConnections = %u", peerId, network->m_peers.count());
                             network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_FNE_MAX_CONN, req->address, req->addrLen);
                             break;
                         }
 
-                        if (network->m_softConnLimit > 0U && network->m_peers.size() >= network->m_softConnLimit) {
-                            LogError(LOG_NET, "PEER %u attempted to connect with no more connections available, maxConnections = %u, currConnections = %u", peerId, network->m_softConnLimit, network->m_peers.size());
+                        if (network->m_softConnLimit > 0U && network->m_peers.count() >= network->m_softConnLimit) {
+                            LogError(LOG_NET, "PEER %u attempted to connect with no more connections available, maxConnections = %u, currConnections = %u", peerId, network->m_softConnLimit, network->m_peers.count());
                             network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_FNE_MAX_CONN, req->address, req->addrLen);
                             break;
                         }
@@ -677,7 +738,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                                 network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_ACL, req->address, req->addrLen);
 
-                                delete connection;
                                 network->erasePeer(peerId);
                             }
                         }
@@ -685,14 +745,12 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     else {
                         // check if the peer is in our peer list -- if he is, and he isn't in a running state, reset
                         // the login sequence
-                        if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                            FNEPeerConnection* connection = network->m_peers[peerId];
+                        if (peerId > 0 && peers->has(peerId)) {
+                            FNEPeerConnection* connection = peers->find(peerId);
                             if (connection != nullptr) {
                                 if (connection->connectionState() == NET_STAT_RUNNING) {
                                     LogMessage(LOG_NET, "PEER %u (%s) resetting peer connection, connectionState = %u", peerId, connection->identity().c_str(),
                                         connection->connectionState());
-                                    delete connection;
-
                                     connection = new FNEPeerConnection(peerId, req->address, req->addrLen);
                                     connection->lastPing(now);
 
@@ -714,7 +772,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                                             network->writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_ACL, req->address, req->addrLen);
 
-                                            delete connection;
                                             network->erasePeer(peerId);
                                         }
                                     }
@@ -724,7 +781,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                     LogWarning(LOG_NET, "PEER %u (%s) RPTL NAK, bad connection state, connectionState = %u", peerId, connection->identity().c_str(),
                                         connection->connectionState());
 
-                                    delete connection;
                                     network->erasePeer(peerId);
                                 }
                             } else {
@@ -739,8 +795,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 break;
             case NET_FUNC::RPTK:                                        // Repeater Authentication
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && peers->has(peerId)) {
+                        FNEPeerConnection* connection = peers->find(peerId);
                         if (connection != nullptr) {
                             connection->lastPing(now);
 
@@ -816,7 +872,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         connection->connectionState(NET_STAT_WAITING_CONFIG);
                                         network->writePeerACK(peerId, streamId);
                                         LogInfoEx(LOG_NET, "PEER %u RPTK ACK, completed the login exchange", peerId);
-                                        network->m_peers[peerId] = connection;
+                                        network->invalidateRoutes();
                                     }
                                     else {
                                         LogWarning(LOG_NET, "PEER %u RPTK NAK, failed the login exchange", peerId);
@@ -832,7 +888,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                 LogWarning(LOG_NET, "PEER %u RPTK NAK, login exchange while in an incorrect state, connectionState = %u", peerId, connection->connectionState());
                                 network->writePeerNAK(peerId, TAG_REPEATER_AUTH, NET_CONN_NAK_BAD_CONN_STATE, req->address, req->addrLen);
 
-                                delete connection;
                                 network->erasePeer(peerId);
                             }
                         }
@@ -847,8 +902,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 break;
             case NET_FUNC::RPTC:                                        // Repeater Configuration
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && peers->has(peerId)) {
+                        FNEPeerConnection* connection = peers->find(peerId);
                         if (connection != nullptr) {
                             connection->lastPing(now);
 
@@ -881,14 +936,15 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         connection->pingsReceived(0U);
                                         connection->lastPing(now);
                                         connection->lastACLUpdate(now);
-                                        network->m_peers[peerId] = connection;
+                                        network->invalidateRoutes();
 
                                         // attach extra notification data to the RPTC ACK to notify the peer of 
-                                        // the use of the alternate diagnostic port
+                                        // the use of the alternate diagnostic port, and that batched log transfers
+                                        // are accepted
                                         uint8_t buffer[1U];
-                                        buffer[0U] = 0x00U;
+                                        buffer[0U] = 0x40U;
                                         if (network->m_host->m_useAlternatePortForDiagnostics) {
-                                            buffer[0U] = 0x80U;
+                                            buffer[0U] |= 0x80U;
                                         }
 
                                         network->writePeerACK(peerId, streamId, buffer, 1U);
@@ -942,6 +998,12 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                                 LogInfoEx(LOG_NET, "PEER %u reports SysView peer", peerId);
                                         }
 
+                                        // is the peer reporting it accepts batched log transfers?
+                                        if (peerConfig["batchLogTransfer"].is<bool>()) {
+                                            bool batchLogTransfer = peerConfig["batchLogTransfer"].get<bool>();
+                                            connection->batchLogTransfer(batchLogTransfer);
+                                        }
+
                                         if (peerConfig["software"].is<std::string>()) {
                                             std::string software = peerConfig["software"].get<std::string>();
                                             LogInfoEx(LOG_NET, "PEER %u reports software %s", peerId, software.c_str());
@@ -974,8 +1036,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
             case NET_FUNC::RPT_CLOSING:                                 // Repeater Closing (Disconnect)
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && peers->has(peerId)) {
+                        FNEPeerConnection* connection = peers->find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
@@ -984,7 +1046,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                 LogInfoEx(LOG_NET, "PEER %u (%s) is closing down", peerId, connection->identity().c_str());
                                 if (network->erasePeer(peerId)) {
                                     network->erasePeerAffiliations(peerId);
-                                    delete connection;
                                 }
                             }
                         }
@@ -993,8 +1054,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                 break;
             case NET_FUNC::PING:                                        // Repeater Ping
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && peers->has(peerId)) {
+                        FNEPeerConnection* connection = peers->find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
@@ -1036,7 +1097,6 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                 payload[6U] = (uint8_t)((now >> 8) & 0xFFU);
                                 payload[7U] = (uint8_t)((now >> 0) & 0xFFU);
 
-                                network->m_peers[peerId] = connection;
                                 network->writePeerCommand(peerId, { NET_FUNC::PONG, NET_SUBFUNC::NOP }, payload, 8U, streamId, false);
 
                                 if (network->m_reportPeerPing) {
@@ -1054,8 +1114,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
             case NET_FUNC::GRANT_REQ:                                   // Repeater Grant Request
                 {
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && peers->has(peerId)) {
+                        FNEPeerConnection* connection = peers->find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
@@ -1123,8 +1183,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     using namespace p25::defines;
                     using namespace p25::kmm;
 
-                    if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                        FNEPeerConnection* connection = network->m_peers[peerId];
+                    if (peerId > 0 && peers->has(peerId)) {
+                        FNEPeerConnection* connection = peers->find(peerId);
                         if (connection != nullptr) {
                             std::string ip = udp::Socket::address(req->address);
 
@@ -1250,8 +1310,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     case NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY:        // Peer Activity Log Transfer
                         {
                             if (network->m_allowActivityTransfer) {
-                                if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                    FNEPeerConnection* connection = network->m_peers[peerId];
+                                if (peerId > 0 && peers->has(peerId)) {
+                                    FNEPeerConnection* connection = peers->find(peerId);
                                     if (connection != nullptr) {
                                         std::string ip = udp::Socket::address(req->address);
 
@@ -1273,7 +1333,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                                             .field("identity", connection->identity())
                                                             .field("msg", payload)
                                                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                                                    .requestAsync(network->m_influxServer);
+                                                    .requestAsync(network->m_influxWriter);
                                             }
                                         }
                                         else {
@@ -1288,8 +1348,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     case NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG:            // Peer Diagnostic Log Transfer
                         {
                             if (network->m_allowDiagnosticTransfer) {
-                                if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                    FNEPeerConnection* connection = network->m_peers[peerId];
+                                if (peerId > 0 && peers->has(peerId)) {
+                                    FNEPeerConnection* connection = peers->find(peerId);
                                     if (connection != nullptr) {
                                         std::string ip = udp::Socket::address(req->address);
 
@@ -1314,7 +1374,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                                             .field("identity", connection->identity())
                                                             .field("msg", payload)
                                                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                                                    .requestAsync(network->m_influxServer);
+                                                    .requestAsync(network->m_influxWriter);
                                             }
                                         }
                                         else {
@@ -1326,6 +1386,30 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         }
                         break;
 
+                    case NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY_BATCH:  // Peer Batched Activity Log Transfer
+                    case NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG_BATCH:      // Peer Batched Diagnostic Log Transfer
+                        {
+                            bool diag = req->fneHeader.getSubFunction() == NET_SUBFUNC::TRANSFER_SUBFUNC_DIAG_BATCH;
+                            if ((diag && network->m_allowDiagnosticTransfer) || (!diag && network->m_allowActivityTransfer)) {
+                                if (peerId > 0 && peers->has(peerId)) {
+                                    FNEPeerConnection* connection = peers->find(peerId);
+                                    if (connection != nullptr) {
+                                        std::string ip = udp::Socket::address(req->address);
+
+                                        // validate peer (simple validation really)
+                                        if (connection->connected() && connection->address() == ip) {
+                                            std::vector<std::string> lines;
+                                            network->processLogBatch(peerId, connection, diag, req->buffer, req->length, lines);
+                                        }
+                                        else {
+                                            network->writePeerNAK(peerId, streamId, diag ? TAG_TRANSFER_DIAG_LOG : TAG_TRANSFER_ACT_LOG, NET_CONN_NAK_FNE_UNAUTHORIZED);
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                        break;
+
                     case NET_SUBFUNC::TRANSFER_SUBFUNC_STATUS:          // Peer Status Transfer
                         // main traffic port status transfers aren't supported for performance reasons
                         break;
@@ -1344,11 +1428,11 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                     switch (req->fneHeader.getSubFunction()) {
                     case NET_SUBFUNC::ANNC_SUBFUNC_GRP_AFFIL:           // Announce Group Affiliation
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
-                                    lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                    lookups::AffiliationLookup* aff = peers->findAffiliations(peerId);
                                     if (aff == nullptr) {
                                         LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                         network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1360,6 +1444,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         uint32_t dstId = __GET_UINT16(req->buffer, 3U);             // Destination Address
                                         aff->groupUnaff(srcId);
                                         aff->groupAff(srcId, dstId);
+                                        network->invalidateRoutes();
 
                                         // attempt to repeat traffic to Peer-Link masters
                                         if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1383,11 +1468,11 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                     case NET_SUBFUNC::ANNC_SUBFUNC_UNIT_REG:            // Announce Unit Registration
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
-                                    lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                    lookups::AffiliationLookup* aff = peers->findAffiliations(peerId);
                                     if (aff == nullptr) {
                                         LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                         network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1419,11 +1504,11 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                         break;
                     case NET_SUBFUNC::ANNC_SUBFUNC_UNIT_DEREG:          // Announce Unit Deregistration
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
-                                    lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                    lookups::AffiliationLookup* aff = peers->findAffiliations(peerId);
                                     if (aff == nullptr) {
                                         LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                         network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1433,6 +1518,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                     if (connection->connected() && connection->address() == ip && aff != nullptr) {
                                         uint32_t srcId = __GET_UINT16(req->buffer, 0U);             // Source Address
                                         aff->unitDereg(srcId);
+                                        network->invalidateRoutes();
 
                                         // attempt to repeat traffic to Peer-Link masters
                                         if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1456,11 +1542,11 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                     case NET_SUBFUNC::ANNC_SUBFUNC_GRP_UNAFFIL:         // Announce Group Affiliation Removal
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
-                                    lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                    lookups::AffiliationLookup* aff = peers->findAffiliations(peerId);
                                     if (aff == nullptr) {
                                         LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                         network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1470,6 +1556,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                     if (connection->connected() && connection->address() == ip && aff != nullptr) {
                                         uint32_t srcId = __GET_UINT16(req->buffer, 0U);             // Source Address
                                         aff->groupUnaff(srcId);
+                                        network->invalidateRoutes();
 
                                         // attempt to repeat traffic to Peer-Link masters
                                         if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1493,14 +1580,14 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                     case NET_SUBFUNC::ANNC_SUBFUNC_AFFILS:              // Announce Update All Affiliations
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
 
                                     // validate peer (simple validation really)
                                     if (connection->connected() && connection->address() == ip) {
-                                        lookups::AffiliationLookup* aff = network->m_peerAffiliations[peerId];
+                                        lookups::AffiliationLookup* aff = peers->findAffiliations(peerId);
                                         if (aff == nullptr) {
                                             LogError(LOG_NET, "PEER %u (%s) has uninitialized affiliations lookup?", peerId, connection->identity().c_str());
                                             network->writePeerNAK(peerId, streamId, TAG_ANNOUNCE, NET_CONN_NAK_INVALID);
@@ -1520,6 +1607,7 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                                 offs += 8U;
                                             }
                                             LogMessage(LOG_NET, "PEER %u (%s) announced %u affiliations", peerId, connection->identity().c_str(), len);
+                                            network->invalidateRoutes();
 
                                             // attempt to repeat traffic to Peer-Link masters
                                             if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1544,8 +1632,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
 
                     case NET_SUBFUNC::ANNC_SUBFUNC_SITE_VC:             // Announce Site VCs
                         {
-                            if (peerId > 0 && (network->m_peers.find(peerId) != network->m_peers.end())) {
-                                FNEPeerConnection* connection = network->m_peers[peerId];
+                            if (peerId > 0 && peers->has(peerId)) {
+                                FNEPeerConnection* connection = peers->find(peerId);
                                 if (connection != nullptr) {
                                     std::string ip = udp::Socket::address(req->address);
 
@@ -1558,8 +1646,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                         uint32_t offs = 4U;
                                         for (uint32_t i = 0; i < len; i++) {
                                             uint32_t vcPeerId = __GET_UINT32(req->buffer, offs);
-                                            if (vcPeerId > 0 && (network->m_peers.find(vcPeerId) != network->m_peers.end())) {
-                                                FNEPeerConnection* vcConnection = network->m_peers[vcPeerId];
+                                            if (vcPeerId > 0 && peers->has(vcPeerId)) {
+                                                FNEPeerConnection* vcConnection = peers->find(vcPeerId);
                                                 if (vcConnection != nullptr) {
                                                     vcConnection->ccPeerId(peerId);
                                                     vcPeers.push_back(vcPeerId);
@@ -1568,7 +1656,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
                                             offs += 4U;
                                         }
                                         LogMessage(LOG_NET, "PEER %u (%s) announced %u VCs", peerId, connection->identity().c_str(), len);
-                                        network->m_ccPeerMap[peerId] = vcPeers;
+                                        network->m_peers.setCCPeers(peerId, vcPeers);
+                                        network->invalidateRoutes();
 
                                         // attempt to repeat traffic to Peer-Link masters
                                         if (network->m_host->m_peerNetworks.size() > 0) {
@@ -1602,12 +1691,8 @@ void* FNENetwork::threadedNetworkRx(void* arg)
             }
         }
 
-        if (req->buffer != nullptr)
-            delete[] req->buffer;
-        delete req;
+        PacketWorkerPool::freeRequest(req);
     }
-
-    return nullptr;
 }
 
 /* Checks if the passed peer ID is blocked from unit-to-unit traffic. */
@@ -1628,12 +1713,10 @@ bool FNENetwork::checkU2UDroppedPeer(uint32_t peerId)
 
 void FNENetwork::eraseStreamPktSeq(uint32_t peerId, uint32_t streamId)
 {
-    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-        FNEPeerConnection* connection = m_peers[peerId];
-        if (connection != nullptr) {
-            std::lock_guard<std::mutex> lock(m_peerMutex);
-            connection->eraseStreamPktSeq(streamId);
-        }
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    FNEPeerConnection* connection = peers->find(peerId);
+    if (peerId > 0 && connection != nullptr) {
+        connection->eraseStreamPktSeq(streamId);
     }
 }
 
@@ -1641,29 +1724,21 @@ void FNENetwork::eraseStreamPktSeq(uint32_t peerId, uint32_t streamId)
 
 void FNENetwork::createPeerAffiliations(uint32_t peerId, std::string peerName)
 {
-    erasePeerAffiliations(peerId);
-
-    std::lock_guard<std::mutex> lock(m_peerMutex);
     lookups::ChannelLookup* chLookup = new lookups::ChannelLookup();
-    m_peerAffiliations[peerId] = new lookups::AffiliationLookup(peerName, chLookup, m_verbose);
-    m_peerAffiliations[peerId]->setDisableUnitRegTimeout(true); // FNE doesn't allow unit registration timeouts (notification must come from the peers)
+    lookups::AffiliationLookup* aff = new lookups::AffiliationLookup(peerName, chLookup, m_verbose);
+    aff->setDisableUnitRegTimeout(true); // FNE doesn't allow unit registration timeouts (notification must come from the peers)
+
+    // any previous affiliations for this peer are replaced (and released once no longer referenced)
+    m_peers.addAffiliations(peerId, aff);
+    invalidateRoutes();
 }
 
 /* Helper to erase the peer from the peers affiliations list. */
 
 bool FNENetwork::erasePeerAffiliations(uint32_t peerId)
 {
-    std::lock_guard<std::mutex> lock(m_peerMutex);
-    auto it = std::find_if(m_peerAffiliations.begin(), m_peerAffiliations.end(), [&](PeerAffiliationMapPair x) { return x.first == peerId; });
-    if (it != m_peerAffiliations.end()) {
-        lookups::AffiliationLookup* aff = m_peerAffiliations[peerId];
-        if (aff != nullptr) {
-            lookups::ChannelLookup* rfCh = aff->rfCh();
-            if (rfCh != nullptr)
-                delete rfCh;
-            delete aff;
-        }
-        m_peerAffiliations.erase(peerId);
+    if (m_peers.eraseAffiliations(peerId)) {
+        invalidateRoutes();
 
         return true;
     }
@@ -1675,30 +1750,22 @@ bool FNENetwork::erasePeerAffiliations(uint32_t peerId)
 
 bool FNENetwork::erasePeer(uint32_t peerId)
 {
-    std::lock_guard<std::mutex> lock(m_peerMutex);
-    {
-        auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-        if (it != m_peers.end()) {
-            m_peers.erase(peerId);
-        }
-    }
+    // erase the peer and any CC maps for this peer
+    m_peers.erase(peerId);
 
-    // erase any CC maps for this peer
-    {
-        auto it = std::find_if(m_ccPeerMap.begin(), m_ccPeerMap.end(), [&](auto x) { return x.first == peerId; });
-        if (it != m_ccPeerMap.end()) {
-            m_ccPeerMap.erase(peerId);
-        }
-    }
+    // close the peer's log files
+    ::PeerLogClose(peerId);
 
     // erase any Peer-Link entries for this peer
     {
+        std::lock_guard<std::mutex> lock(m_peerMutex);
         auto it = std::find_if(m_peerLinkPeers.begin(), m_peerLinkPeers.end(), [&](auto x) { return x.first == peerId; });
         if (it != m_peerLinkPeers.end()) {
             m_peerLinkPeers.erase(peerId);
         }
     }
 
+    invalidateRoutes();
     return true;
 }
 
@@ -1725,16 +1792,23 @@ json::object FNENetwork::fneConnObject(uint32_t peerId, FNEPeerConnection *conn)
     uint32_t ccPeerId = conn->ccPeerId();
     peerObj["controlChannel"].set<uint32_t>(ccPeerId);
 
+    StreamSeqStats seqTotals = conn->streamSeqTotals();
+    uint32_t streamCount = (uint32_t)conn->streamCount();
+    peerObj["streams"].set<uint32_t>(streamCount);
+    peerObj["outOfSequence"].set<uint32_t>(seqTotals.outOfSequence);
+    peerObj["duplicate"].set<uint32_t>(seqTotals.duplicate);
+    peerObj["gap"].set<uint32_t>(seqTotals.gap);
+
     json::object peerConfig = conn->config();
     if (peerConfig["rcon"].is<json::object>())
         peerConfig.erase("rcon");
     peerObj["config"].set<json::object>(peerConfig);
 
     json::array voiceChannels = json::array();
-    auto it = std::find_if(m_ccPeerMap.begin(), m_ccPeerMap.end(), [&](auto x) { return x.first == peerId; });
-    if (it != m_ccPeerMap.end()) {
-        std::vector<uint32_t> vcPeers = m_ccPeerMap[peerId];
-        for (uint32_t vcEntry : vcPeers) {
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    const std::vector<uint32_t>* vcPeers = peers->findCCPeers(peerId);
+    if (vcPeers != nullptr) {
+        for (uint32_t vcEntry : *vcPeers) {
             voiceChannels.push_back(json::value((double)vcEntry));
         }
     }
@@ -1747,8 +1821,9 @@ json::object FNENetwork::fneConnObject(uint32_t peerId, FNEPeerConnection *conn)
 
 bool FNENetwork::resetPeer(uint32_t peerId)
 {
-    if (peerId > 0 && (m_peers.find(peerId) != m_peers.end())) {
-        FNEPeerConnection* connection = m_peers[peerId];
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    if (peerId > 0 && peers->has(peerId)) {
+        FNEPeerConnection* connection = peers->find(peerId);
         if (connection != nullptr) {
             sockaddr_storage addr = connection->socketStorage();
             uint32_t addrLen = connection->sockStorageLen();
@@ -1757,7 +1832,6 @@ bool FNENetwork::resetPeer(uint32_t peerId)
 
             writePeerNAK(peerId, TAG_REPEATER_LOGIN, NET_CONN_NAK_PEER_RESET, addr, addrLen);
 
-            delete connection;
             erasePeer(peerId);
 
             return true;
@@ -1772,18 +1846,62 @@ bool FNENetwork::resetPeer(uint32_t peerId)
 
 std::string FNENetwork::resolvePeerIdentity(uint32_t peerId)
 {
-    std::lock_guard<std::mutex> lock(m_peerMutex);
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
-        if (it->second != nullptr) {
-            FNEPeerConnection* peer = it->second;
-            return peer->identity();
-        }
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    FNEPeerConnection* peer = peers->find(peerId);
+    if (peer != nullptr) {
+        return peer->identity();
     }
 
     return std::string();
 }
 
+/* Helper to write a batch of peer activity or diagnostic log lines. */
+
+bool FNENetwork::processLogBatch(uint32_t peerId, FNEPeerConnection* connection, bool diag, const uint8_t* data, uint32_t length,
+    std::vector<std::string>& lines)
+{
+    assert(connection != nullptr);
+
+    if (!TransferBatch::decode(data, length, lines)) {
+        LogError(LOG_NET, "PEER %u (%s) error decoding %s log batch", peerId, connection->identity().c_str(), diag ? "diagnostic" : "activity");
+        return false;
+    }
+
+    // write the lines to the consolidated log, the same as individually transferred lines
+    if (diag) {
+        bool currState = g_disableTimeDisplay;
+        g_disableTimeDisplay = true;
+        for (const std::string& line : lines) {
+            ::Log(9999U, nullptr, nullptr, 0U, nullptr, "%.9u (%8s) %s", peerId, connection->identity().c_str(), line.c_str());
+        }
+        g_disableTimeDisplay = currState;
+    }
+    else {
+        for (const std::string& line : lines) {
+            ::ActivityLog("%.9u (%8s) %s", peerId, connection->identity().c_str(), line.c_str());
+        }
+    }
+
+    ::PeerLogWrite(peerId, diag, lines);
+
+    // report log lines to InfluxDB
+    if (m_enableInfluxDB) {
+        // lines in the batch share the same tags, so each line needs a distinct timestamp
+        uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        for (uint32_t i = 0U; i < lines.size(); i++) {
+            influxdb::QueryBuilder()
+                .meas(diag ? "diag" : "activity")
+                    .tag("peerId", std::to_string(peerId))
+                        .field("identity", connection->identity())
+                        .field("msg", lines[i])
+                    .timestamp(now - (lines.size() - 1U - i))
+                .requestAsync(m_influxWriter);
+        }
+    }
+
+    return true;
+}
+
 /* Helper to complete setting up a repeater login request. */
 
 void FNENetwork::setupRepeaterLogin(uint32_t peerId, uint32_t streamId, FNEPeerConnection* connection)
@@ -1794,7 +1912,8 @@ void FNENetwork::setupRepeaterLogin(uint32_t peerId, uint32_t streamId, FNEPeerC
     LogInfoEx(LOG_NET, "PEER %u started login from, %s:%u", peerId, connection->address().c_str(), connection->port());
 
     connection->connectionState(NET_STAT_WAITING_AUTHORISATION);
-    m_peers[peerId] = connection;
+    m_peers.add(peerId, connection);
+    invalidateRoutes();
 
     // transmit salt to peer
     uint8_t salt[4U];
@@ -1850,7 +1969,8 @@ void* FNENetwork::threadedACLUpdate(void* arg)
 
         std::string peerIdentity = network->resolvePeerIdentity(req->peerId);
 
-        FNEPeerConnection* connection = network->m_peers[req->peerId];
+        PeerTable::Snapshot peers = network->m_peers.snapshot();
+        FNEPeerConnection* connection = peers->find(req->peerId);
         if (connection != nullptr) {
             uint32_t aclStreamId = network->createStreamId();
 
@@ -1887,7 +2007,8 @@ void FNENetwork::writeWhitelistRIDs(uint32_t peerId, uint32_t streamId, bool isE
 
     // sending PEER_LINK style RID list to external peers
     if (isExternalPeer) {
-        FNEPeerConnection* connection = m_peers[peerId];
+        PeerTable::Snapshot peers = m_peers.snapshot();
+        FNEPeerConnection* connection = peers->find(peerId);
         if (connection != nullptr) {
             std::string filename = m_ridLookup->filename();
             if (filename.empty()) {
@@ -1998,8 +2119,8 @@ void FNENetwork::writeWhitelistRIDs(uint32_t peerId, uint32_t streamId, bool isE
     // send radio ID white/black lists
     std::vector<uint32_t> ridWhitelist;
 
-    auto ridLookups = m_ridLookup->table();
-    for (auto entry : ridLookups) {
+    auto ridLookups = m_ridLookup->snapshot();
+    for (auto& entry : *ridLookups) {
         uint32_t id = entry.first;
         if (entry.second.radioEnabled()) {
             ridWhitelist.push_back(id);
@@ -2011,7 +2132,8 @@ void FNENetwork::writeWhitelistRIDs(uint32_t peerId, uint32_t streamId, bool isE
     }
 
     // send a chunk of RIDs to the peer
-    FNEPeerConnection* connection = m_peers[peerId];
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    FNEPeerConnection* connection = peers->find(peerId);
     if (connection != nullptr) {
         uint32_t chunkCnt = (ridWhitelist.size() / MAX_RID_LIST_CHUNK) + 1U;
         for (uint32_t i = 0U; i < chunkCnt; i++) {
@@ -2072,8 +2194,8 @@ void FNENetwork::writeBlacklistRIDs(uint32_t peerId, uint32_t streamId)
     // send radio ID blacklist
     std::vector<uint32_t> ridBlacklist;
 
-    auto ridLookups = m_ridLookup->table();
-    for (auto entry : ridLookups) {
+    auto ridLookups = m_ridLookup->snapshot();
+    for (auto& entry : *ridLookups) {
         uint32_t id = entry.first;
         if (!entry.second.radioEnabled()) {
             ridBlacklist.push_back(id);
@@ -2085,7 +2207,8 @@ void FNENetwork::writeBlacklistRIDs(uint32_t peerId, uint32_t streamId)
     }
 
     // send a chunk of RIDs to the peer
-    FNEPeerConnection* connection = m_peers[peerId];
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    FNEPeerConnection* connection = peers->find(peerId);
     if (connection != nullptr) {
         uint32_t chunkCnt = (ridBlacklist.size() / MAX_RID_LIST_CHUNK) + 1U;
         for (uint32_t i = 0U; i < chunkCnt; i++) {
@@ -2149,7 +2272,8 @@ void FNENetwork::writeTGIDs(uint32_t peerId, uint32_t streamId, bool isExternalP
 
     // sending PEER_LINK style TGID list to external peers
     if (isExternalPeer) {
-        FNEPeerConnection* connection = m_peers[peerId];
+        PeerTable::Snapshot peers = m_peers.snapshot();
+        FNEPeerConnection* connection = peers->find(peerId);
         if (connection != nullptr) {
             std::string filename = m_tidLookup->filename();
             if (filename.empty()) {
@@ -2400,7 +2524,8 @@ void FNENetwork::writePeerList(uint32_t peerId, uint32_t streamId)
     uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 
     // sending PEER_LINK style RID list to external peers
-    FNEPeerConnection* connection = m_peers[peerId];
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    FNEPeerConnection* connection = peers->find(peerId);
     if (connection != nullptr) {
         std::string filename = m_peerListLookup->filename();
         if (filename.empty()) {
@@ -2539,26 +2664,54 @@ bool FNENetwork::writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const
         LogError(LOG_NET, "BUGBUG: PEER %u, trying to send data with a streamId of 0?", peerId);
     }
 
-    auto it = std::find_if(m_peers.begin(), m_peers.end(), [&](PeerMapPair x) { return x.first == peerId; });
-    if (it != m_peers.end()) {
-        FNEPeerConnection* connection = m_peers.at(peerId);
-        if (connection != nullptr) {
-            sockaddr_storage addr = connection->socketStorage();
-            uint32_t addrLen = connection->sockStorageLen();
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    FNEPeerConnection* connection = peers->find(peerId);
+    if (connection != nullptr) {
+        sockaddr_storage addr = connection->socketStorage();
+        uint32_t addrLen = connection->sockStorageLen();
 
-            if (incPktSeq) {
-                pktSeq = connection->incStreamPktSeq(streamId, pktSeq);
-            }
+        if (incPktSeq) {
+            pktSeq = connection->incStreamPktSeq(streamId, pktSeq);
+        }
 
-            if (directWrite)
-                return m_frameQueue->write(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
-            else {
-                m_frameQueue->enqueueMessage(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
-                if (queueOnly)
-                    return true;
-                return m_frameQueue->flushQueue();
-            }
+        if (directWrite)
+            return m_frameQueue->write(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
+        else {
+            m_frameQueue->enqueueMessage(data, length, streamId, peerId, m_peerId, opcode, pktSeq, addr, addrLen);
+            if (queueOnly)
+                return true;
+            return m_frameQueue->flushQueue();
+        }
+    }
+
+    return false;
+}
+
+/* Helper to queue a data message, encoded once for fan-out, to the specified peer. */
+
+bool FNENetwork::writePeerFanout(uint32_t peerId, FanoutFrame& frame, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length,
+    uint16_t pktSeq, uint32_t streamId, uint32_t rewriteDstId, bool incPktSeq) const
+{
+    if (streamId == 0U) {
+        LogError(LOG_NET, "BUGBUG: PEER %u, trying to send data with a streamId of 0?", peerId);
+    }
+
+    PeerTable::Snapshot peers = m_peers.snapshot();
+    FNEPeerConnection* connection = peers->find(peerId);
+    if (connection != nullptr) {
+        sockaddr_storage addr = connection->socketStorage();
+        uint32_t addrLen = connection->sockStorageLen();
+
+        if (incPktSeq) {
+            pktSeq = connection->incStreamPktSeq(streamId, pktSeq);
         }
+
+        if (!frame.isPrepared()) {
+            m_frameQueue->prepareFanout(frame, data, length, streamId, m_peerId, opcode, pktSeq);
+        }
+
+        m_frameQueue->enqueueFanout(frame, peerId, m_peerId, pktSeq, addr, addrLen, rewriteDstId);
+        return true;
     }
 
     return false;
@@ -32,9 +32,16 @@
 #include "common/lookups/TalkgroupRulesLookup.h"
 #include "common/lookups/PeerListLookup.h"
 #include "common/network/Network.h"
+#include "common/network/PacketBuffer.h"
+#include "common/network/StreamSeqTable.h"
 #include "fne/network/influxdb/InfluxDB.h"
+#include "fne/network/influxdb/BatchWriter.h"
+#include "fne/network/PacketWorkerPool.h"
+#include "fne/network/PeerTable.h"
+#include "fne/network/callhandler/RoutePlan.h"
 #include "fne/CryptoContainer.h"
 
+#include <atomic>
 #include <string>
 #include <cstdint>
 #include <unordered_map>
@@ -71,6 +78,8 @@ namespace network
         STATE_NXDN = 3U,        //! NXDN
     };
 
+    const int NET_READ_TIMEOUT_MS = 10;
+
     #define INFLUXDB_ERRSTR_DISABLED_SRC_RID "disabled source RID"
     #define INFLUXDB_ERRSTR_DISABLED_DST_RID "disabled destination RID"
     #define INFLUXDB_ERRSTR_INV_TALKGROUP "illegal/invalid talkgroup"
@@ -119,9 +128,9 @@ namespace network
             m_isConventionalPeer(false),
             m_isSysView(false),
             m_isPeerLink(false),
+            m_batchLogTransfer(false),
             m_config(),
-            m_streamSeqMutex(),
-            m_streamSeqNos()
+            m_streamSeq()
         {
             /* stub */
         }
@@ -148,9 +157,9 @@ namespace network
             m_isConventionalPeer(false),
             m_isSysView(false),
             m_isPeerLink(false),
+            m_batchLogTransfer(false),
             m_config(),
-            m_streamSeqMutex(),
-            m_streamSeqNos()
+            m_streamSeq()
         {
             assert(id > 0U);
             assert(sockStorageLen > 0U);
@@ -164,7 +173,7 @@ namespace network
          */
         size_t streamCount()
         {
-            return m_streamSeqNos.size();
+            return m_streamSeq.count();
         }
 
         /**
@@ -174,24 +183,7 @@ namespace network
          */
         bool hasStreamPktSeq(uint64_t streamId)
         {
-            bool ret = false;
-            bool locked = m_streamSeqMutex.try_lock_for(std::chrono::milliseconds(60));
-
-            // determine if the stream has a current sequence no and return
-            {
-                auto it = m_streamSeqNos.find(streamId);
-                if (it == m_streamSeqNos.end()) {
-                    ret = false;
-                }
-                else {
-                    ret = true;
-                }
-            }
-
-            if (locked)
-                m_streamSeqMutex.unlock();
-
-            return ret;
+            return m_streamSeq.has(streamId);
         }
 
         /**
@@ -201,23 +193,7 @@ namespace network
          */
         uint16_t getStreamPktSeq(uint64_t streamId)
         {
-            bool locked = m_streamSeqMutex.try_lock_for(std::chrono::milliseconds(60));
-
-            // find the current sequence no and return
-            uint32_t pktSeq = 0U;
-            {
-                auto it = m_streamSeqNos.find(streamId);
-                if (it == m_streamSeqNos.end()) {
-                    pktSeq = RTP_END_OF_CALL_SEQ;
-                } else {
-                    pktSeq = m_streamSeqNos[streamId];
-                }
-            }
-
-            if (locked)
-                m_streamSeqMutex.unlock();
-
-            return pktSeq;
+            return m_streamSeq.get(streamId);
         }
 
         /**
@@ -228,50 +204,38 @@ namespace network
          */
         uint16_t incStreamPktSeq(uint64_t streamId, uint16_t initialSeq)
         {
-            bool locked = m_streamSeqMutex.try_lock_for(std::chrono::milliseconds(60));
-
-            // find the current sequence no, increment and return
-            uint32_t pktSeq = 0U;
-            {
-                auto it = m_streamSeqNos.find(streamId);
-                if (it == m_streamSeqNos.end()) {
-                    m_streamSeqNos.insert({streamId, initialSeq});
-                } else {
-                    pktSeq = m_streamSeqNos[streamId];
-
-                    ++pktSeq;
-                    if (pktSeq > RTP_END_OF_CALL_SEQ) {
-                        pktSeq = 0U;
-                    }
-
-                    m_streamSeqNos[streamId] = pktSeq;
-                }
-            }
-
-            if (locked)
-                m_streamSeqMutex.unlock();
-
-            return pktSeq;
+            return m_streamSeq.increment(streamId, initialSeq);
+        }
+        /**
+         * @brief Helper to check the RTP sequence of a received packet for the given stream ID, and
+         *  advance the stored RTP sequence.
+         * @param streamId Stream ID.
+         * @param pktSeq Received RTP sequence.
+         * @param[out] expected Expected RTP sequence.
+         * @returns StreamSeqResult::E 
+         */
+        StreamSeqResult::E checkStreamPktSeq(uint64_t streamId, uint16_t pktSeq, uint16_t& expected)
+        {
+            return m_streamSeq.checkAndAdvance(streamId, pktSeq, &expected);
         }
         /**
          * @brief Helper to erase the stored RTP sequence for the given stream ID.
          * @param streamId Stream ID.
-         * @returns uint16_t 
+         * @param[out] stats Sequence counters for the erased stream.
+         * @returns bool True, if the stream was erased, otherwise false.
          */
-        void eraseStreamPktSeq(uint64_t streamId)
+        bool eraseStreamPktSeq(uint64_t streamId, StreamSeqStats* stats = nullptr)
         {
-            bool locked = m_streamSeqMutex.try_lock_for(std::chrono::milliseconds(60));
-
-            // find the sequence no and erase
-            {
-                auto entry = m_streamSeqNos.find(streamId);
-                if (entry != m_streamSeqNos.end()) {
-                    m_streamSeqNos.erase(streamId);
-                }
-            }
-
-            if (locked)
-                m_streamSeqMutex.unlock();
+            return m_streamSeq.erase(streamId, stats);
+        }
+
+        /**
+         * @brief Helper to get the RTP sequence counters totalled over all streams from this peer.
+         * @returns StreamSeqStats 
+         */
+        StreamSeqStats streamSeqTotals() const
+        {
+            return m_streamSeq.totals();
         }
 
     public:
@@ -352,14 +316,18 @@ namespace network
          */
         __PROPERTY_PLAIN(bool, isPeerLink);
 
+        /**
+         * @brief Flag indicating this connection accepts batched activity and diagnostic log transfers.
+         */
+        __PROPERTY_PLAIN(bool, batchLogTransfer);
+
         /**
          * @brief JSON objecting containing peer configuration information.
          */
         __PROPERTY_PLAIN(json::object, config);
 
     private:
-        std::timed_mutex m_streamSeqMutex;
-        std::unordered_map<uint64_t, uint16_t> m_streamSeqNos;
+        StreamSeqTable m_streamSeq;
     };
 
     // ---------------------------------------------------------------------------
@@ -390,7 +358,11 @@ namespace network
         frame::RTPHeader rtpHeader;         //! RTP Header
         frame::RTPFNEHeader fneHeader;      //! RTP FNE Header
         int length = 0U;                    //! Length of raw data buffer
-        uint8_t* buffer = nullptr;          //! Raw data buffer
+        uint8_t* buffer = nullptr;          //! Raw data buffer (points into the packet buffer)
+        PacketBuffer packet;                //! Pooled packet buffer holding the raw data
+
+        uint64_t rxTime = 0U;               //! Time the packet was received (see NetMetrics::now())
+        uint64_t dispatchTime = 0U;         //! Time the packet was dispatched to its handler (see NetMetrics::now())
     };
 
     // ---------------------------------------------------------------------------
@@ -477,6 +449,7 @@ namespace network
 
         /**
          * @brief Process data frames from the network.
+         *  This waits up to NET_READ_TIMEOUT_MS for data, and then dispatches all pending frames.
          */
         void processNetwork();
 
@@ -549,12 +522,9 @@ namespace network
         NET_CONN_STATUS m_status;
 
         static std::mutex m_peerMutex;
-        typedef std::pair<const uint32_t, network::FNEPeerConnection*> PeerMapPair;
-        std::unordered_map<uint32_t, FNEPeerConnection*> m_peers;
+        PeerTable m_peers;
         std::unordered_map<uint32_t, json::array> m_peerLinkPeers;
-        typedef std::pair<const uint32_t, lookups::AffiliationLookup*> PeerAffiliationMapPair;
-        std::unordered_map<uint32_t, lookups::AffiliationLookup*> m_peerAffiliations;
-        std::unordered_map<uint32_t, std::vector<uint32_t>> m_ccPeerMap;
+        std::atomic<uint32_t> m_routeGeneration;
         static std::timed_mutex m_keyQueueMutex;
         std::unordered_map<uint32_t, uint16_t> m_peerLinkKeyQueue;
 
@@ -589,20 +559,24 @@ namespace network
         std::string m_influxBucket;
         bool m_influxLogRawData;
         influxdb::ServerInfo m_influxServer;
+        influxdb::BatchWriter* m_influxWriter;
 
         bool m_disablePacketData;
         bool m_dumpPacketData;
         bool m_verbosePacketData;
 
+        uint32_t m_workerCnt;
+        uint32_t m_workerQueueDepth;
+        PacketWorkerPool m_workerPool;
+
         bool m_reportPeerPing;
         bool m_verbose;
 
         /**
          * @brief Entry point to process a given network packet.
-         * @param arg Instance of the NetPacketRequest structure.
-         * @returns void* (Ignore)
+         * @param req Instance of the NetPacketRequest structure.
          */
-        static void* threadedNetworkRx(void* arg);
+        static void taskNetworkRx(NetPacketRequest* req);
 
         /**
          * @brief Checks if the passed peer ID is blocked from unit-to-unit traffic.
@@ -618,6 +592,23 @@ namespace network
          */
         void eraseStreamPktSeq(uint32_t peerId, uint32_t streamId);
 
+        /**
+         * @brief Gets the current routing generation.
+         *  (The routing generation changes whenever peer connections, peer affiliations or the talkgroup
+         *   rules change, and is used to invalidate any cached call routing plans.)
+         * @returns uint64_t Routing generation.
+         */
+        uint64_t routeGeneration() const
+        {
+            return callhandler::RoutePlanCache::generation(m_peers, m_tidLookup, m_routeGeneration.load());
+        }
+        /**
+         * @brief Helper to invalidate any cached call routing plans.
+         *  (Peer table and group affiliation changes invalidate routes on their own; this is only required
+         *   for other routing inputs, such as a peer connection state change.)
+         */
+        void invalidateRoutes() { m_routeGeneration++; }
+
         /**
          * @brief Helper to create a peer on the peers affiliations list.
          * @param peerId Peer ID.
@@ -643,6 +634,19 @@ namespace network
          * @returns std::string Textual peer name for the given peer ID.
          */
         std::string resolvePeerIdentity(uint32_t peerId);
+        /**
+         * @brief Helper to write a batch of peer activity or diagnostic log lines.
+         *  The lines are written to the consolidated log, to the peer's own log file, and reported to InfluxDB.
+         * @param peerId Peer ID.
+         * @param connection Instance of the FNEPeerConnection class.
+         * @param diag Flag indicating the batch contains diagnostic log lines.
+         * @param data Transfer message.
+         * @param length Length of the transfer message.
+         * @param[out] lines Log lines decoded from the batch.
+         * @returns bool True, if the batch was decoded, otherwise false.
+         */
+        bool processLogBatch(uint32_t peerId, FNEPeerConnection* connection, bool diag, const uint8_t* data, uint32_t length,
+            std::vector<std::string>& lines);
 
         /**
          * @brief Helper to complete setting up a repeater login request.
@@ -723,6 +727,22 @@ namespace network
          */
         bool writePeer(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, 
             uint16_t pktSeq, uint32_t streamId, bool queueOnly, bool incPktSeq = false, bool directWrite = false) const;
+        /**
+         * @brief Helper to queue a data message, encoded once for fan-out, to the specified peer.
+         *  The message is encoded into the fan-out frame on first use; subsequent peers only patch the
+         *  per-peer fields of the already encoded frame.
+         * @param peerId Peer ID.
+         * @param frame Fan-out frame for this message.
+         * @param opcode FNE network opcode pair.
+         * @param[in] data Buffer containing message to send to peer.
+         * @param length Length of buffer.
+         * @param pktSeq RTP packet sequence for this message.
+         * @param streamId Stream ID for this message.
+         * @param rewriteDstId Rewritten destination ID for this peer (0 for no rewrite).
+         * @param incPktSeq Flag indicating the message should increment the packet sequence after transmission.
+         */
+        bool writePeerFanout(uint32_t peerId, FanoutFrame& frame, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length,
+            uint16_t pktSeq, uint32_t streamId, uint32_t rewriteDstId = 0U, bool incPktSeq = false) const;
 
         /**
          * @brief Helper to send a command message to the specified peer.
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "common/network/NetMetrics.h"
+#include "common/network/PacketBuffer.h"
+#include "common/Log.h"
+#include "network/PacketWorkerPool.h"
+#include "network/FNENetwork.h"
+
+using namespace network;
+
+#include <cassert>
+#include <new>
+#include <sstream>
+#include <thread>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the PacketWorker class. */
+
+PacketWorker::PacketWorker(PacketHandler handler, uint32_t queueDepth) : Thread(),
+    m_handler(handler),
+    m_queueDepth(queueDepth),
+    m_mutex(),
+    m_cond(),
+    m_queue(),
+    m_running(true),
+    m_queueHighWater(0U),
+    m_processed(0U),
+    m_dropped(0U)
+{
+    assert(handler != nullptr);
+    assert(queueDepth > 0U);
+}
+
+/* Finalizes a instance of the PacketWorker class. */
+
+PacketWorker::~PacketWorker() = default;
+
+/* Queues a request for this worker. */
+
+bool PacketWorker::enqueue(NetPacketRequest* req)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running || m_queue.size() >= m_queueDepth) {
+            m_dropped++;
+            return false;
+        }
+
+        m_queue.push_back(req);
+
+        uint32_t depth = (uint32_t)m_queue.size();
+        if (depth > m_queueHighWater.load(std::memory_order_relaxed))
+            m_queueHighWater.store(depth, std::memory_order_relaxed);
+    }
+
+    m_cond.notify_one();
+    return true;
+}
+
+/* Signals the worker to stop, and waits for it to exit. */
+
+void PacketWorker::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+
+    m_cond.notify_all();
+    wait();
+
+    // discard anything left over
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (!m_queue.empty()) {
+        PacketWorkerPool::freeRequest(m_queue.front());
+        m_queue.pop_front();
+    }
+}
+
+/* Thread entry point. */
+
+void PacketWorker::entry()
+{
+    while (true) {
+        NetPacketRequest* req = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [this] { return !m_queue.empty() || !m_running; });
+            if (!m_running)
+                break;
+
+            req = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        if (req != nullptr) {
+            uint64_t now = NetMetrics::now();
+            NetMetrics::latency(NetStage::RX_DISPATCH, req->rxTime, now);
+            NetMetrics::packet(req->fneHeader.getFunction(), req->fneHeader.getSubFunction(), req->peerId, (uint32_t)req->length);
+            req->dispatchTime = now;
+
+            m_handler(req);
+            m_processed++;
+        }
+    }
+}
+
+/* Helper to create a JSON representation of the worker counters. */
+
+json::object PacketWorker::statsObject()
+{
+    uint32_t queued = 0U;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        queued = (uint32_t)m_queue.size();
+    }
+
+    json::object stats = json::object();
+    stats["queued"].set<uint32_t>(queued);
+    uint32_t queueDepth = m_queueDepth;
+    stats["queueDepth"].set<uint32_t>(queueDepth);
+    uint32_t queueHighWater = m_queueHighWater.load();
+    stats["queueHighWater"].set<uint32_t>(queueHighWater);
+    uint64_t processed = m_processed.load();
+    stats["processed"].set<uint64_t>(processed);
+    uint64_t dropped = m_dropped.load();
+    stats["dropped"].set<uint64_t>(dropped);
+    return stats;
+}
+
+/* Initializes a new instance of the PacketWorkerPool class. */
+
+PacketWorkerPool::PacketWorkerPool(const std::string& name, PacketHandler handler) :
+    m_name(name),
+    m_handler(handler),
+    m_workers()
+{
+    assert(handler != nullptr);
+}
+
+/* Finalizes a instance of the PacketWorkerPool class. */
+
+PacketWorkerPool::~PacketWorkerPool()
+{
+    stop();
+}
+
+/* Starts the worker threads. */
+
+bool PacketWorkerPool::start(uint32_t workerCnt, uint32_t queueDepth)
+{
+    if (!m_workers.empty())
+        return true;
+
+    if (workerCnt == 0U) {
+        workerCnt = std::thread::hardware_concurrency();
+        if (workerCnt == 0U)
+            workerCnt = 1U;
+    }
+
+    if (workerCnt > MAX_PACKET_WORKERS)
+        workerCnt = MAX_PACKET_WORKERS;
+    if (queueDepth == 0U)
+        queueDepth = DEFAULT_PACKET_WORKER_QUEUE_DEPTH;
+
+    for (uint32_t i = 0U; i < workerCnt; i++) {
+        PacketWorker* worker = new PacketWorker(m_handler, queueDepth);
+        if (!worker->run()) {
+            LogError(LOG_NET, "Failed to start %s packet worker %u", m_name.c_str(), i);
+            delete worker;
+            stop();
+            return false;
+        }
+
+        std::stringstream threadName;
+        threadName << m_name << ":w" << i;
+        worker->setName(threadName.str());
+
+        m_workers.push_back(worker);
+    }
+
+    return true;
+}
+
+/* Stops and releases all worker threads. */
+
+void PacketWorkerPool::stop()
+{
+    for (PacketWorker* worker : m_workers) {
+        worker->stop();
+        delete worker;
+    }
+
+    m_workers.clear();
+}
+
+/* Dispatches a network packet request to the worker owning its peer/stream. */
+
+bool PacketWorkerPool::dispatch(NetPacketRequest* req)
+{
+    if (req == nullptr || m_workers.empty())
+        return false;
+
+    // shard by peer ID and stream ID (Fibonacci hashing), so a stream always lands on the same worker; control
+    // traffic isn't part of a stream, and lands on the worker owning the peer (stream ID 0)
+    uint32_t streamId = (req->fneHeader.getFunction() == NET_FUNC::PROTOCOL) ? req->fneHeader.getStreamId() : 0U;
+    uint64_t key = ((uint64_t)req->peerId << 32) | streamId;
+    key *= 0x9E3779B97F4A7C15ULL;
+    uint32_t idx = (uint32_t)((key >> 32) % m_workers.size());
+
+    return m_workers[idx]->enqueue(req);
+}
+
+/* Helper to create a JSON representation of the worker pool counters. */
+
+json::array PacketWorkerPool::statsArray()
+{
+    json::array workers = json::array();
+    for (uint32_t i = 0U; i < m_workers.size(); i++) {
+        json::object stats = m_workers[i]->statsObject();
+        stats["worker"].set<uint32_t>(i);
+        workers.push_back(json::value(stats));
+    }
+
+    return workers;
+}
+
+/* Helper to allocate a network packet request from the packet pool. */
+
+NetPacketRequest* PacketWorkerPool::allocRequest()
+{
+    return new (PacketBufferPool::alloc(sizeof(NetPacketRequest))) NetPacketRequest();
+}
+
+/* Helper to free a network packet request. */
+
+void PacketWorkerPool::freeRequest(NetPacketRequest* req)
+{
+    if (req == nullptr)
+        return;
+
+    // the packet buffer is released with the request
+    req->~NetPacketRequest();
+    PacketBufferPool::release((uint8_t*)req);
+}
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PacketWorkerPool.h
+ * @ingroup fne_network
+ * @file PacketWorkerPool.cpp
+ * @ingroup fne_network
+ */
+#if !defined(__PACKET_WORKER_POOL_H__)
+#define __PACKET_WORKER_POOL_H__
+
+#include "fne/Defines.h"
+#include "common/network/json/json.h"
+#include "common/Thread.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Structure Prototypes
+    // ---------------------------------------------------------------------------
+
+    struct NetPacketRequest;
+
+    // ---------------------------------------------------------------------------
+    //  Constants
+    // ---------------------------------------------------------------------------
+
+    const uint32_t DEFAULT_PACKET_WORKER_QUEUE_DEPTH = 1024U;
+    const uint32_t MAX_PACKET_WORKERS = 64U;
+
+    /**
+     * @brief Function that handles a dequeued network packet request.
+     *  The handler takes ownership of the request, and is responsible for freeing it.
+     */
+    typedef void (*PacketHandler)(NetPacketRequest* req);
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a single packet worker thread with a bounded request queue.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API PacketWorker : public Thread {
+    public:
+        /**
+         * @brief Initializes a new instance of the PacketWorker class.
+         * @param handler Packet handler to run for each dequeued request.
+         * @param queueDepth Maximum number of requests that may be queued.
+         */
+        PacketWorker(PacketHandler handler, uint32_t queueDepth);
+        /**
+         * @brief Finalizes a instance of the PacketWorker class.
+         */
+        ~PacketWorker() override;
+
+        /**
+         * @brief Queues a request for this worker.
+         * @param req Network packet request.
+         * @returns bool True, if the request was queued, otherwise false (queue full or stopped).
+         */
+        bool enqueue(NetPacketRequest* req);
+
+        /**
+         * @brief Signals the worker to stop, and waits for it to exit.
+         *  Any requests left on the queue are discarded.
+         */
+        void stop();
+
+        /**
+         * @brief Thread entry point.
+         */
+        void entry() override;
+
+        /**
+         * @brief Helper to create a JSON representation of the worker counters.
+         * @returns json::object
+         */
+        json::object statsObject();
+
+    private:
+        PacketHandler m_handler;
+        uint32_t m_queueDepth;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cond;
+        std::deque<NetPacketRequest*> m_queue;
+        bool m_running;
+
+        std::atomic<uint32_t> m_queueHighWater;
+        std::atomic<uint64_t> m_processed;
+        std::atomic<uint64_t> m_dropped;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a fixed pool of packet worker threads.
+     *  Protocol (call data) requests are sharded onto workers by peer ID and stream ID, so that all
+     *  packets of a single stream are always handled in order, by the same worker. All other (control)
+     *  requests are sharded by peer ID alone, so the control traffic of a peer is handled in order.
+     *  There is no ordering between a peer's control traffic and its streams, or between its streams.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API PacketWorkerPool {
+    public:
+        /**
+         * @brief Initializes a new instance of the PacketWorkerPool class.
+         * @param name Textual name used for the worker threads.
+         * @param handler Packet handler to run for each dequeued request.
+         */
+        PacketWorkerPool(const std::string& name, PacketHandler handler);
+        /**
+         * @brief Finalizes a instance of the PacketWorkerPool class.
+         */
+        ~PacketWorkerPool();
+
+        /**
+         * @brief Starts the worker threads.
+         * @param workerCnt Number of worker threads. (0 will use the number of available CPU cores.)
+         * @param queueDepth Maximum number of requests that may be queued per worker.
+         * @returns bool True, if the workers started, otherwise false.
+         */
+        bool start(uint32_t workerCnt, uint32_t queueDepth);
+        /**
+         * @brief Stops and releases all worker threads.
+         */
+        void stop();
+
+        /**
+         * @brief Dispatches a network packet request to the worker owning its peer/stream (or its peer, for
+         *  control requests).
+         *  On success, ownership of the request passes to the pool.
+         * @param req Network packet request.
+         * @returns bool True, if the request was queued, otherwise false.
+         */
+        bool dispatch(NetPacketRequest* req);
+
+        /**
+         * @brief Gets the number of running worker threads.
+         * @returns uint32_t Number of worker threads.
+         */
+        uint32_t workerCount() const { return (uint32_t)m_workers.size(); }
+
+        /**
+         * @brief Helper to create a JSON representation of the worker pool counters.
+         * @returns json::array
+         */
+        json::array statsArray();
+
+        /**
+         * @brief Helper to allocate a network packet request from the packet pool.
+         * @returns NetPacketRequest* Network packet request.
+         */
+        static NetPacketRequest* allocRequest();
+        /**
+         * @brief Helper to free a network packet request.
+         * @param req Network packet request.
+         */
+        static void freeRequest(NetPacketRequest* req);
+
+    private:
+        std::string m_name;
+        PacketHandler m_handler;
+
+        std::vector<PacketWorker*> m_workers;
+    };
+} // namespace network
+
+#endif // __PACKET_WORKER_POOL_H__
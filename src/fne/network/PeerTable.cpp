@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "network/FNENetwork.h"
+#include "network/PeerTable.h"
+
+using namespace network;
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+//  Static Class Members
+// ---------------------------------------------------------------------------
+
+// versions are unique across all peer tables, this allows a thread's cached snapshot to be
+// validated by version alone
+static std::atomic<uint64_t> s_nextVersion(0U);
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the PeerTableSnapshot class. */
+
+PeerTableSnapshot::PeerTableSnapshot() :
+    m_version(0U),
+    m_peers(),
+    m_affiliations(),
+    m_ccPeerMap(),
+    m_connectionRefs(),
+    m_affiliationRefs()
+{
+    /* stub */
+}
+
+/* Finds the peer record for the given peer ID. */
+
+const PeerEntry* PeerTableSnapshot::entry(uint32_t peerId) const
+{
+    auto it = std::lower_bound(m_peers.begin(), m_peers.end(), peerId,
+        [](const PeerEntry& entry, uint32_t id) { return entry.peerId < id; });
+    if (it != m_peers.end() && it->peerId == peerId)
+        return &(*it);
+
+    return nullptr;
+}
+
+/* Finds the connection for the given peer ID. */
+
+FNEPeerConnection* PeerTableSnapshot::find(uint32_t peerId) const
+{
+    const PeerEntry* peer = entry(peerId);
+    if (peer == nullptr)
+        return nullptr;
+
+    return peer->connection;
+}
+
+/* Finds the affiliations for the given peer ID. */
+
+lookups::AffiliationLookup* PeerTableSnapshot::findAffiliations(uint32_t peerId) const
+{
+    auto it = std::lower_bound(m_affiliations.begin(), m_affiliations.end(), peerId,
+        [](const std::pair<uint32_t, lookups::AffiliationLookup*>& entry, uint32_t id) { return entry.first < id; });
+    if (it != m_affiliations.end() && it->first == peerId)
+        return it->second;
+
+    return nullptr;
+}
+
+/* Finds the voice channel peers for the given control channel peer ID. */
+
+const std::vector<uint32_t>* PeerTableSnapshot::findCCPeers(uint32_t peerId) const
+{
+    auto it = m_ccPeerMap.find(peerId);
+    if (it != m_ccPeerMap.end())
+        return &it->second;
+
+    return nullptr;
+}
+
+/* Initializes a new instance of the PeerTable class. */
+
+PeerTable::PeerTable() :
+    m_writeMutex(),
+    m_connections(),
+    m_affiliations(),
+    m_ccPeerMap(),
+    m_snapshot(),
+    m_version(0U),
+    m_count(0U),
+    m_affGeneration(0U)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    publish();
+}
+
+/* Gets the current snapshot of the peer table. */
+
+PeerTable::Snapshot PeerTable::snapshot() const
+{
+    // the atomic shared_ptr load is internally locked, so each thread caches the snapshot it last
+    // took and only reloads it after a new version has been published
+    struct SnapshotCache {
+        uint64_t version;
+        Snapshot snapshot;
+    };
+    static thread_local SnapshotCache cache = { 0U, nullptr };
+
+    uint64_t version = m_version.load(std::memory_order_acquire);
+    if (cache.version != version || cache.snapshot == nullptr) {
+        cache.snapshot = std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+        cache.version = version;
+    }
+
+    return cache.snapshot;
+}
+
+/* Adds (or replaces) the connection for the given peer ID. */
+
+void PeerTable::add(uint32_t peerId, FNEPeerConnection* connection)
+{
+    if (connection == nullptr) {
+        erase(peerId);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    auto it = m_connections.find(peerId);
+    if (it != m_connections.end() && it->second.get() == connection)
+        return;
+
+    m_connections[peerId] = std::shared_ptr<FNEPeerConnection>(connection);
+    publish();
+}
+
+/* Erases the connection (and any control channel mappings) for the given peer ID. */
+
+bool PeerTable::erase(uint32_t peerId)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    bool erased = m_connections.erase(peerId) > 0U;
+    erased = (m_ccPeerMap.erase(peerId) > 0U) || erased;
+    if (!erased)
+        return false;
+
+    publish();
+    return true;
+}
+
+/* Adds (or replaces) the affiliations for the given peer ID. */
+
+void PeerTable::addAffiliations(uint32_t peerId, lookups::AffiliationLookup* affiliations)
+{
+    if (affiliations == nullptr) {
+        eraseAffiliations(peerId);
+        return;
+    }
+
+    affiliations->setGroupAffChangeCallback([this]() {
+        m_affGeneration.fetch_add(1U, std::memory_order_acq_rel);
+    });
+
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_affiliations[peerId] = std::shared_ptr<lookups::AffiliationLookup>(affiliations, [](lookups::AffiliationLookup* aff) {
+        lookups::ChannelLookup* rfCh = aff->rfCh();
+        if (rfCh != nullptr)
+            delete rfCh;
+        delete aff;
+    });
+    publish();
+}
+
+/* Erases the affiliations for the given peer ID. */
+
+bool PeerTable::eraseAffiliations(uint32_t peerId)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    if (m_affiliations.erase(peerId) == 0U)
+        return false;
+
+    publish();
+    return true;
+}
+
+/* Sets the voice channel peers for the given control channel peer ID. */
+
+void PeerTable::setCCPeers(uint32_t peerId, const std::vector<uint32_t>& vcPeers)
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_ccPeerMap[peerId] = vcPeers;
+    publish();
+}
+
+/* Clears the peer table. */
+
+void PeerTable::clear()
+{
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    m_connections.clear();
+    m_affiliations.clear();
+    m_ccPeerMap.clear();
+    publish();
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to build and publish a new snapshot from the writer side copy of the table. */
+
+void PeerTable::publish()
+{
+    std::shared_ptr<PeerTableSnapshot> snapshot = std::make_shared<PeerTableSnapshot>();
+
+    // std::map iterates in key order, so the snapshot arrays are built already sorted by peer ID
+    snapshot->m_peers.reserve(m_connections.size());
+    snapshot->m_connectionRefs.reserve(m_connections.size());
+    for (auto& entry : m_connections) {
+        auto aff = m_affiliations.find(entry.first);
+        snapshot->m_peers.push_back({ entry.first, entry.second.get(), (aff != m_affiliations.end()) ? aff->second.get() : nullptr });
+        snapshot->m_connectionRefs.push_back(entry.second);
+    }
+
+    snapshot->m_affiliations.reserve(m_affiliations.size());
+    snapshot->m_affiliationRefs.reserve(m_affiliations.size());
+    for (auto& entry : m_affiliations) {
+        snapshot->m_affiliations.push_back(std::make_pair(entry.first, entry.second.get()));
+        snapshot->m_affiliationRefs.push_back(entry.second);
+    }
+
+    snapshot->m_ccPeerMap = m_ccPeerMap;
+
+    uint64_t version = s_nextVersion.fetch_add(1U, std::memory_order_relaxed) + 1U;
+    snapshot->m_version = version;
+
+    std::atomic_store_explicit(&m_snapshot, Snapshot(snapshot), std::memory_order_release);
+    m_count.store(m_connections.size(), std::memory_order_relaxed);
+    m_version.store(version, std::memory_order_release);
+}
@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file PeerTable.h
+ * @ingroup fne_network
+ * @file PeerTable.cpp
+ * @ingroup fne_network
+ */
+#if !defined(__PEER_TABLE_H__)
+#define __PEER_TABLE_H__
+
+#include "fne/Defines.h"
+#include "common/lookups/AffiliationLookup.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Class Prototypes
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API FNEPeerConnection;
+    class HOST_SW_API PeerTable;
+
+    // ---------------------------------------------------------------------------
+    //  Structure Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents a single peer record in a peer table snapshot.
+     * @ingroup fne_network
+     */
+    struct PeerEntry {
+        uint32_t peerId;                                //! Peer ID.
+        FNEPeerConnection* connection;                  //! FNE Peer Connection.
+        lookups::AffiliationLookup* affiliations;       //! Peer Affiliations (nullptr if the peer has none).
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Represents an immutable version of the FNE peer table.
+     *  Peer records are held in a dense array sorted by peer ID; a snapshot is never modified once
+     *  published, and all connections and affiliations it references remain valid for as long as
+     *  the snapshot is held.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API PeerTableSnapshot {
+    public:
+        typedef std::vector<PeerEntry>::const_iterator const_iterator;
+
+        /**
+         * @brief Initializes a new instance of the PeerTableSnapshot class.
+         */
+        PeerTableSnapshot();
+
+        /**
+         * @brief Gets the version of the peer table this snapshot represents.
+         * @returns uint64_t Peer table version.
+         */
+        uint64_t version() const { return m_version; }
+
+        /**
+         * @brief Gets the count of peers.
+         * @returns size_t Number of peers.
+         */
+        size_t size() const { return m_peers.size(); }
+        /**
+         * @brief Helper to determine if there are no peers.
+         * @returns bool True, if there are no peers, otherwise false.
+         */
+        bool empty() const { return m_peers.empty(); }
+
+        /**
+         * @brief Gets an iterator to the first peer record.
+         * @returns const_iterator
+         */
+        const_iterator begin() const { return m_peers.begin(); }
+        /**
+         * @brief Gets an iterator past the last peer record.
+         * @returns const_iterator
+         */
+        const_iterator end() const { return m_peers.end(); }
+
+        /**
+         * @brief Finds the peer record for the given peer ID.
+         * @param peerId Peer ID.
+         * @returns PeerEntry* Peer record, or nullptr if the peer does not exist.
+         */
+        const PeerEntry* entry(uint32_t peerId) const;
+        /**
+         * @brief Finds the connection for the given peer ID.
+         * @param peerId Peer ID.
+         * @returns FNEPeerConnection* FNE Peer Connection, or nullptr if the peer does not exist.
+         */
+        FNEPeerConnection* find(uint32_t peerId) const;
+        /**
+         * @brief Helper to determine if the given peer ID exists.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer exists, otherwise false.
+         */
+        bool has(uint32_t peerId) const { return entry(peerId) != nullptr; }
+
+        /**
+         * @brief Finds the affiliations for the given peer ID.
+         * @param peerId Peer ID.
+         * @returns lookups::AffiliationLookup* Peer Affiliations, or nullptr if the peer has none.
+         */
+        lookups::AffiliationLookup* findAffiliations(uint32_t peerId) const;
+        /**
+         * @brief Finds the voice channel peers for the given control channel peer ID.
+         * @param peerId Control Channel Peer ID.
+         * @returns std::vector<uint32_t>* List of voice channel peer IDs, or nullptr if the peer has none.
+         */
+        const std::vector<uint32_t>* findCCPeers(uint32_t peerId) const;
+
+    private:
+        friend class PeerTable;
+        uint64_t m_version;
+
+        std::vector<PeerEntry> m_peers;
+        std::vector<std::pair<uint32_t, lookups::AffiliationLookup*>> m_affiliations;
+        std::unordered_map<uint32_t, std::vector<uint32_t>> m_ccPeerMap;
+
+        std::vector<std::shared_ptr<FNEPeerConnection>> m_connectionRefs;
+        std::vector<std::shared_ptr<lookups::AffiliationLookup>> m_affiliationRefs;
+    };
+
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements a read-mostly (RCU-style) FNE peer table.
+     *  Readers take an immutable snapshot of the table and never lock; writers are serialized, apply
+     *  their change to the writer side copy of the table and publish a new snapshot. Connections and
+     *  affiliations removed from the table are released once the last snapshot referencing them is
+     *  released.
+     * @ingroup fne_network
+     */
+    class HOST_SW_API PeerTable {
+    public:
+        typedef std::shared_ptr<const PeerTableSnapshot> Snapshot;
+
+        /**
+         * @brief Initializes a new instance of the PeerTable class.
+         */
+        PeerTable();
+
+        /**
+         * @brief Gets the current snapshot of the peer table.
+         *  (Each thread caches the snapshot it last took, and only reloads it when a new version has
+         *  been published. The cached snapshot keeps the connections and affiliations it references
+         *  alive; so a thread that goes idle holds on to at most one stale snapshot, until it next takes
+         *  a snapshot or exits.)
+         * @returns Snapshot Current peer table snapshot.
+         */
+        Snapshot snapshot() const;
+
+        /**
+         * @brief Gets the current version of the peer table.
+         * @returns uint64_t Peer table version.
+         */
+        uint64_t version() const { return m_version.load(std::memory_order_acquire); }
+        /**
+         * @brief Gets the group affiliation generation of the peer table.
+         *  (The generation is incremented every time a group affiliation of any peer in the table is
+         *   added or removed.)
+         * @returns uint32_t Group affiliation generation.
+         */
+        uint32_t affiliationGeneration() const { return m_affGeneration.load(std::memory_order_acquire); }
+        /**
+         * @brief Gets the count of peers.
+         * @returns size_t Number of peers.
+         */
+        size_t count() const { return m_count.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Adds (or replaces) the connection for the given peer ID.
+         *  The table takes ownership of the connection.
+         * @param peerId Peer ID.
+         * @param connection FNE Peer Connection.
+         */
+        void add(uint32_t peerId, FNEPeerConnection* connection);
+        /**
+         * @brief Erases the connection (and any control channel mappings) for the given peer ID.
+         * @param peerId Peer ID.
+         * @returns bool True, if the peer was erased, otherwise false.
+         */
+        bool erase(uint32_t peerId);
+
+        /**
+         * @brief Adds (or replaces) the affiliations for the given peer ID.
+         *  The table takes ownership of the affiliations, and of its channel lookup, and tracks changes
+         *  to its group affiliations.
+         * @param peerId Peer ID.
+         * @param affiliations Peer Affiliations.
+         */
+        void addAffiliations(uint32_t peerId, lookups::AffiliationLookup* affiliations);
+        /**
+         * @brief Erases the affiliations for the given peer ID.
+         * @param peerId Peer ID.
+         * @returns bool True, if the affiliations were erased, otherwise false.
+         */
+        bool eraseAffiliations(uint32_t peerId);
+
+        /**
+         * @brief Sets the voice channel peers for the given control channel peer ID.
+         * @param peerId Control Channel Peer ID.
+         * @param vcPeers List of voice channel peer IDs.
+         */
+        void setCCPeers(uint32_t peerId, const std::vector<uint32_t>& vcPeers);
+
+        /**
+         * @brief Clears the peer table.
+         */
+        void clear();
+
+    private:
+        std::mutex m_writeMutex;
+        std::map<uint32_t, std::shared_ptr<FNEPeerConnection>> m_connections;
+        std::map<uint32_t, std::shared_ptr<lookups::AffiliationLookup>> m_affiliations;
+        std::unordered_map<uint32_t, std::vector<uint32_t>> m_ccPeerMap;
+
+        Snapshot m_snapshot;
+        std::atomic<uint64_t> m_version;
+        std::atomic<size_t> m_count;
+        std::atomic<uint32_t> m_affGeneration;
+
+        /**
+         * @brief Helper to build and publish a new snapshot from the writer side copy of the table.
+         *  (This must be called with the write lock held.)
+         */
+        void publish();
+    };
+} // namespace network
+
+#endif // __PEER_TABLE_H__
@@ -12,6 +12,7 @@
 #include "common/edac/SHA256.h"
 #include "common/lookups/AffiliationLookup.h"
 #include "common/network/json/json.h"
+#include "common/network/NetMetrics.h"
 #include "common/Log.h"
 #include "common/Utils.h"
 #include "fne/network/callhandler/TagDMRData.h"
@@ -654,6 +655,11 @@ void RESTAPI::initializeEndpoints()
 
     m_dispatcher.match(FNE_GET_AFF_LIST).get(REST_API_BIND(RESTAPI::restAPI_GetAffList, this));
 
+    m_dispatcher.match(FNE_GET_STATS_WORKERS).get(REST_API_BIND(RESTAPI::restAPI_GetStatsWorkers, this));
+#if !defined(NO_NET_METRICS)
+    m_dispatcher.match(FNE_GET_METRICS).get(REST_API_BIND(RESTAPI::restAPI_GetMetrics, this));
+#endif // !defined(NO_NET_METRICS)
+
     /*
     ** Digital Mobile Radio
     */
@@ -843,10 +849,11 @@ void RESTAPI::restAPI_GetPeerQuery(const HTTPPayload& request, HTTPPayload& repl
 
     json::array peers = json::array();
     if (m_network != nullptr) {
-        if (m_network->m_peers.size() > 0) {
-            for (auto entry : m_network->m_peers) {
-                uint32_t peerId = entry.first;
-                network::FNEPeerConnection* peer = entry.second;
+        PeerTable::Snapshot connPeers = m_network->m_peers.snapshot();
+        if (connPeers->size() > 0U) {
+            for (const PeerEntry& entry : *connPeers) {
+                uint32_t peerId = entry.peerId;
+                network::FNEPeerConnection* peer = entry.connection;
                 if (peer != nullptr) {
                     if (m_debug) {
                         LogDebug(LOG_REST, "Preparing Peer %u (%s) for REST API query", peerId, peer->address().c_str());
@@ -896,7 +903,7 @@ void RESTAPI::restAPI_GetPeerCount(const HTTPPayload& request, HTTPPayload& repl
 
     json::array peers = json::array();
     if (m_network != nullptr) {
-        uint32_t count = m_network->m_peers.size();
+        uint32_t count = (uint32_t)m_network->m_peers.count();
         response["peerCount"].set<uint32_t>(count);
     }
 
@@ -1157,13 +1164,13 @@ void RESTAPI::restAPI_PutTGDelete(const HTTPPayload& request, HTTPPayload& reply
     uint32_t tgid = req["tgid"].get<uint32_t>();
     uint8_t slot = req["slot"].get<uint8_t>();
 
-    TalkgroupRuleGroupVoice groupVoice = m_tidLookup->find(tgid, slot);
-    if (groupVoice.isInvalid()) {
+    TalkgroupRuleGroupVoiceHandle groupVoice = m_tidLookup->find(tgid, slot);
+    if (groupVoice->isInvalid()) {
         errorPayload(reply, "failed to find specified TGID to delete");
         return;
     }
 
-    m_tidLookup->eraseEntry(groupVoice.source().tgId(), groupVoice.source().tgSlot());
+    m_tidLookup->eraseEntry(groupVoice->source().tgId(), groupVoice->source().tgSlot());
 /*    
     if (m_network != nullptr) {
         m_network->m_forceListUpdate = true;
@@ -1395,6 +1402,11 @@ void RESTAPI::restAPI_GetReloadTGs(const HTTPPayload& request, HTTPPayload& repl
 
     if (m_network != nullptr) {
         m_network->m_tidLookup->reload();
+
+        uint32_t entries = (uint32_t)m_network->m_tidLookup->snapshot()->size();
+        response["entries"].set<uint32_t>(entries);
+        uint32_t loadTime = (uint32_t)m_network->m_tidLookup->lastLoadTime();
+        response["loadTime"].set<uint32_t>(loadTime);
     }
 
     reply.payload(response);
@@ -1413,6 +1425,11 @@ void RESTAPI::restAPI_GetReloadRIDs(const HTTPPayload& request, HTTPPayload& rep
 
     if (m_network != nullptr) {
         m_network->m_ridLookup->reload();
+
+        uint32_t entries = (uint32_t)m_network->m_ridLookup->size();
+        response["entries"].set<uint32_t>(entries);
+        uint32_t loadTime = (uint32_t)m_network->m_ridLookup->lastLoadTime();
+        response["loadTime"].set<uint32_t>(loadTime);
     }
 
     reply.payload(response);
@@ -1431,12 +1448,13 @@ void RESTAPI::restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply,
 
     json::array affs = json::array();
     if (m_network != nullptr) {
-        if (m_network->m_peers.size() > 0) {
-            for (auto entry : m_network->m_peers) {
-                uint32_t peerId = entry.first;
-                network::FNEPeerConnection* peer = entry.second;
+        PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+        if (peers->size() > 0U) {
+            for (const PeerEntry& entry : *peers) {
+                uint32_t peerId = entry.peerId;
+                network::FNEPeerConnection* peer = entry.connection;
                 if (peer != nullptr) {
-                    lookups::AffiliationLookup* affLookup = m_network->m_peerAffiliations[peerId];
+                    lookups::AffiliationLookup* affLookup = entry.affiliations;
                     if (affLookup != nullptr) {
                         std::unordered_map<uint32_t, uint32_t> affTable = affLookup->grpAffTable();
 
@@ -1468,6 +1486,53 @@ void RESTAPI::restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply,
     reply.payload(response);
 }
 
+/* REST API endpoint; implements get packet worker statistics request. */
+
+void RESTAPI::restAPI_GetStatsWorkers(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    json::object response = json::object();
+    setResponseDefaultStatus(response);
+
+    if (m_network != nullptr) {
+        json::array workers = m_network->m_workerPool.statsArray();
+        response["workers"].set<json::array>(workers);
+
+        json::array egress = m_network->m_frameQueue->egressStatsArray();
+        response["egress"].set<json::array>(egress);
+    }
+
+    if (m_host != nullptr && m_host->m_diagNetwork != nullptr) {
+        json::array diagWorkers = m_host->m_diagNetwork->m_workerPool.statsArray();
+        response["diagWorkers"].set<json::array>(diagWorkers);
+    }
+
+    json::object packetPool = PacketBufferPool::statsObject();
+    response["packetPool"].set<json::object>(packetPool);
+
+    if (m_network != nullptr && m_network->m_influxWriter != nullptr) {
+        json::object influx = m_network->m_influxWriter->statsObject();
+        response["influx"].set<json::object>(influx);
+    }
+
+    reply.payload(response);
+}
+
+/* REST API endpoint; implements get network metrics request (in Prometheus text exposition format). */
+
+void RESTAPI::restAPI_GetMetrics(const HTTPPayload& request, HTTPPayload& reply, const RequestMatch& match)
+{
+    if (!validateAuth(request, reply)) {
+        return;
+    }
+
+    std::string metrics = NetMetrics::prometheus();
+    reply.payload(metrics, HTTPPayload::OK, "text/plain; version=0.0.4");
+}
+
 /*
 ** Digital Mobile Radio
 */
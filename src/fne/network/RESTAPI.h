@@ -308,6 +308,21 @@ private:
      */
     void restAPI_GetAffList(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
 
+    /**
+     * @brief REST API endpoint; implements get packet worker statistics request.
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetStatsWorkers(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+    /**
+     * @brief REST API endpoint; implements get network metrics request (in Prometheus text exposition format).
+     * @param request HTTP request.
+     * @param reply HTTP reply.
+     * @param match HTTP request matcher.
+     */
+    void restAPI_GetMetrics(const HTTPPayload& request, HTTPPayload& reply, const network::rest::RequestMatch& match);
+
     /*
     ** Digital Mobile Radio
     */
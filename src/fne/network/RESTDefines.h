@@ -52,4 +52,7 @@
 
 #define FNE_GET_AFF_LIST                "/report-affiliations"
 
+#define FNE_GET_STATS_WORKERS           "/stats/workers"
+#define FNE_GET_METRICS                 "/metrics"
+
 #endif // __FNE_REST_DEFINES_H__
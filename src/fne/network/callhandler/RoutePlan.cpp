@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "network/callhandler/RoutePlan.h"
+
+using namespace network;
+using namespace network::callhandler;
+
+// ---------------------------------------------------------------------------
+//  Macros
+// ---------------------------------------------------------------------------
+
+// Helper to generate the cache key for a destination ID and slot.
+#define __ROUTE_PLAN_KEY(dstId, slotNo) (((uint64_t)(slotNo) << 32) | (uint64_t)(dstId))
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the RoutePlan class. */
+
+RoutePlan::RoutePlan(uint32_t streamId, uint32_t srcPeerId, bool group, uint64_t generation) :
+    m_streamId(streamId),
+    m_srcPeerId(srcPeerId),
+    m_group(group),
+    m_generation(generation),
+    m_peers(),
+    m_externalPeers()
+{
+    /* stub */
+}
+
+/* Helper to determine if this plan is valid for the given call stream. */
+
+bool RoutePlan::isValid(uint32_t streamId, uint32_t srcPeerId, bool group, uint64_t generation) const
+{
+    return m_streamId == streamId && m_srcPeerId == srcPeerId && m_group == group && m_generation == generation;
+}
+
+/* Adds a locally connected destination peer to the plan. */
+
+void RoutePlan::addPeer(uint32_t peerId, bool rewrite, uint32_t rewriteDstId, uint32_t rewriteSlotNo)
+{
+    m_peers.push_back({ peerId, rewrite, rewriteDstId, rewriteSlotNo, nullptr });
+}
+
+/* Adds an external peer network destination to the plan. */
+
+void RoutePlan::addExternalPeer(uint32_t peerId, PeerNetwork* peerNetwork, bool rewrite, uint32_t rewriteDstId, uint32_t rewriteSlotNo)
+{
+    m_externalPeers.push_back({ peerId, rewrite, rewriteDstId, rewriteSlotNo, peerNetwork });
+}
+
+/* Initializes a new instance of the RoutePlanCache class. */
+
+RoutePlanCache::RoutePlanCache() :
+    m_mutex(),
+    m_plans()
+{
+    /* stub */
+}
+
+/* Finds a valid routing plan for the given call stream. */
+
+std::shared_ptr<const RoutePlan> RoutePlanCache::find(uint32_t dstId, uint32_t slotNo, uint32_t streamId, uint32_t srcPeerId, bool group,
+    uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_plans.find(__ROUTE_PLAN_KEY(dstId, slotNo));
+    if (it == m_plans.end())
+        return nullptr;
+
+    if (!it->second->isValid(streamId, srcPeerId, group, generation))
+        return nullptr;
+
+    return it->second;
+}
+
+/* Adds (or replaces) the routing plan for the given destination. */
+
+void RoutePlanCache::add(uint32_t dstId, uint32_t slotNo, std::shared_ptr<const RoutePlan> plan)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_plans[__ROUTE_PLAN_KEY(dstId, slotNo)] = plan;
+}
+
+/* Erases the routing plan for the given destination. */
+
+void RoutePlanCache::erase(uint32_t dstId, uint32_t slotNo)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_plans.erase(__ROUTE_PLAN_KEY(dstId, slotNo));
+}
+
+/* Clears all routing plans. */
+
+void RoutePlanCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_plans.clear();
+}
+
+/* Helper to compose the routing generation from the routing inputs. */
+
+uint64_t RoutePlanCache::generation(const PeerTable& peers, const lookups::TalkgroupRulesLookup* tidLookup, uint32_t invalidations)
+{
+    // each input only ever increases, so their sum changes whenever any one of them does
+    uint32_t tidGeneration = (tidLookup != nullptr) ? tidLookup->generation() : 0U;
+    uint32_t peerGeneration = (uint32_t)peers.version() + peers.affiliationGeneration() + invalidations;
+    return ((uint64_t)tidGeneration << 32) | peerGeneration;
+}
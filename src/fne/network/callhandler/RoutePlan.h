@@ -0,0 +1,190 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file RoutePlan.h
+ * @ingroup fne_callhandler
+ * @file RoutePlan.cpp
+ * @ingroup fne_callhandler
+ */
+#if !defined(__CALLHANDLER__ROUTE_PLAN_H__)
+#define __CALLHANDLER__ROUTE_PLAN_H__
+
+#include "fne/Defines.h"
+#include "common/lookups/TalkgroupRulesLookup.h"
+#include "fne/network/PeerTable.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Class Prototypes
+    // ---------------------------------------------------------------------------
+
+    class HOST_SW_API PeerNetwork;
+
+    namespace callhandler
+    {
+        // ---------------------------------------------------------------------------
+        //  Structure Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Represents a single destination of a call routing plan.
+         * @ingroup fne_callhandler
+         */
+        struct RouteDestination {
+            uint32_t peerId;                //! Destination Peer ID.
+            bool rewrite;                   //! Flag indicating the destination TGID is rewritten for this peer.
+            uint32_t rewriteDstId;          //! Rewritten Destination ID.
+            uint32_t rewriteSlotNo;         //! Rewritten DMR Slot Number.
+            PeerNetwork* peerNetwork;       //! External Peer Network (nullptr for locally connected peers).
+        };
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Represents the precomputed routing for a single call stream.
+         *  A routing plan contains the destination peers a call stream is permitted to be repeated to,
+         *  along with any route rewrites, and is reused for every frame of the call stream.
+         * @ingroup fne_callhandler
+         */
+        class HOST_SW_API RoutePlan {
+        public:
+            /**
+             * @brief Initializes a new instance of the RoutePlan class.
+             * @param streamId Stream ID.
+             * @param srcPeerId Source Peer ID.
+             * @param group Flag indicating the call stream is a group call.
+             * @param generation Routing generation the plan was built against.
+             */
+            RoutePlan(uint32_t streamId, uint32_t srcPeerId, bool group, uint64_t generation);
+
+            /**
+             * @brief Helper to determine if this plan is valid for the given call stream.
+             * @param streamId Stream ID.
+             * @param srcPeerId Source Peer ID.
+             * @param group Flag indicating the call stream is a group call.
+             * @param generation Current routing generation.
+             * @returns bool True, if the plan is valid, otherwise false.
+             */
+            bool isValid(uint32_t streamId, uint32_t srcPeerId, bool group, uint64_t generation) const;
+
+            /**
+             * @brief Adds a locally connected destination peer to the plan.
+             * @param peerId Destination Peer ID.
+             * @param rewrite Flag indicating the destination TGID is rewritten for this peer.
+             * @param rewriteDstId Rewritten Destination ID.
+             * @param rewriteSlotNo Rewritten DMR Slot Number.
+             */
+            void addPeer(uint32_t peerId, bool rewrite, uint32_t rewriteDstId, uint32_t rewriteSlotNo = 0U);
+            /**
+             * @brief Adds an external peer network destination to the plan.
+             * @param peerId Destination Peer ID.
+             * @param peerNetwork Instance of the PeerNetwork class.
+             * @param rewrite Flag indicating the destination TGID is rewritten for this peer.
+             * @param rewriteDstId Rewritten Destination ID.
+             * @param rewriteSlotNo Rewritten DMR Slot Number.
+             */
+            void addExternalPeer(uint32_t peerId, PeerNetwork* peerNetwork, bool rewrite, uint32_t rewriteDstId, uint32_t rewriteSlotNo = 0U);
+
+            /**
+             * @brief Gets the permitted locally connected destination peers.
+             * @returns std::vector<RouteDestination>& List of destinations.
+             */
+            const std::vector<RouteDestination>& peers() const { return m_peers; }
+            /**
+             * @brief Gets the permitted external peer network destinations.
+             * @returns std::vector<RouteDestination>& List of destinations.
+             */
+            const std::vector<RouteDestination>& externalPeers() const { return m_externalPeers; }
+
+        private:
+            uint32_t m_streamId;
+            uint32_t m_srcPeerId;
+            bool m_group;
+            uint64_t m_generation;
+
+            std::vector<RouteDestination> m_peers;
+            std::vector<RouteDestination> m_externalPeers;
+        };
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Implements a thread-safe cache of call routing plans.
+         *  Plans are keyed by destination ID and slot; as only a single call stream may be active
+         *  on a destination at a time, the cache never holds more then one plan per destination.
+         * @ingroup fne_callhandler
+         */
+        class HOST_SW_API RoutePlanCache {
+        public:
+            /**
+             * @brief Initializes a new instance of the RoutePlanCache class.
+             */
+            RoutePlanCache();
+
+            /**
+             * @brief Finds a valid routing plan for the given call stream.
+             * @param dstId Destination ID.
+             * @param slotNo DMR Slot Number.
+             * @param streamId Stream ID.
+             * @param srcPeerId Source Peer ID.
+             * @param group Flag indicating the call stream is a group call.
+             * @param generation Current routing generation.
+             * @returns std::shared_ptr<const RoutePlan> Routing plan, or nullptr if no valid plan exists.
+             */
+            std::shared_ptr<const RoutePlan> find(uint32_t dstId, uint32_t slotNo, uint32_t streamId, uint32_t srcPeerId, bool group,
+                uint64_t generation);
+            /**
+             * @brief Adds (or replaces) the routing plan for the given destination.
+             * @param dstId Destination ID.
+             * @param slotNo DMR Slot Number.
+             * @param plan Routing plan.
+             */
+            void add(uint32_t dstId, uint32_t slotNo, std::shared_ptr<const RoutePlan> plan);
+            /**
+             * @brief Erases the routing plan for the given destination.
+             * @param dstId Destination ID.
+             * @param slotNo DMR Slot Number.
+             */
+            void erase(uint32_t dstId, uint32_t slotNo = 0U);
+            /**
+             * @brief Clears all routing plans.
+             */
+            void clear();
+
+            /**
+             * @brief Helper to compose the routing generation from the routing inputs.
+             *  (The generation changes whenever a peer is added to or erased from the peer table, a group
+             *   affiliation of any peer changes, the talkgroup rules change, or routes are explicitly
+             *   invalidated.)
+             * @param peers Peer table.
+             * @param tidLookup Talkgroup rules lookup (may be nullptr).
+             * @param invalidations Count of explicit route invalidations.
+             * @returns uint64_t Routing generation.
+             */
+            static uint64_t generation(const PeerTable& peers, const lookups::TalkgroupRulesLookup* tidLookup, uint32_t invalidations);
+
+        private:
+            std::mutex m_mutex;
+            std::unordered_map<uint64_t, std::shared_ptr<const RoutePlan>> m_plans;
+        };
+    } // namespace callhandler
+} // namespace network
+
+#endif // __CALLHANDLER__ROUTE_PLAN_H__
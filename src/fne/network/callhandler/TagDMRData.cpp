@@ -47,6 +47,7 @@ TagDMRData::TagDMRData(FNENetwork* network, bool debug) :
     m_parrotFrames(),
     m_parrotFramesReady(false),
     m_status(),
+    m_routePlans(),
     m_debug(debug)
 {
     assert(network != nullptr);
@@ -67,10 +68,8 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 {
     hrc::hrc_t pktTime = hrc::now();
 
-    UInt8Array __buffer = std::make_unique<uint8_t[]>(len);
-    uint8_t* buffer = __buffer.get();
-    ::memset(buffer, 0x00U, len);
-    ::memcpy(buffer, data, len);
+    PacketBuffer __buffer = PacketBuffer::copyOf(data, len);
+    uint8_t* buffer = __buffer.data();
 
     uint8_t seqNo = data[4U];
 
@@ -170,8 +169,8 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                 m_status[dstId].reset();
 
                 // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                if (tg.config().parrot()) {
+                lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+                if (tg->config().parrot()) {
                     if (m_parrotFrames.size() > 0) {
                         m_parrotFramesReady = true;
                         LogMessage(LOG_NET, "DMR, Parrot Playback will Start, peer = %u, srcId = %u", peerId, srcId);
@@ -194,10 +193,11 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                                 .field("duration", duration)
                                 .field("slot", slotNo)
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 m_network->eraseStreamPktSeq(peerId, streamId);
+                m_routePlans.erase(dstId, slotNo);
                 m_network->m_callInProgress = false;
             }
         }
@@ -235,8 +235,8 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
             }
             else {
                 // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                if (tg.config().parrot()) {
+                lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+                if (tg->config().parrot()) {
                     m_parrotFramesReady = false;
                     if (m_parrotFrames.size() > 0) {
                         for (auto& pkt : m_parrotFrames) {
@@ -265,8 +265,8 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
         }
 
         // is this a parrot talkgroup?
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-        if (tg.config().parrot()) {
+        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+        if (tg->config().parrot()) {
             uint8_t* copy = new uint8_t[len];
             ::memcpy(copy, buffer, len);
 
@@ -297,83 +297,63 @@ bool TagDMRData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 
         m_status[dstId].lastPacket = hrc::now();
 
-        // repeat traffic to the connected peers
-        if (m_network->m_peers.size() > 0U) {
-            uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
-                if (peerId != peer.first) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(peer.first, dmrData, streamId)) {
-                        continue;
-                    }
+        // resolve the routing plan for this call stream
+        std::shared_ptr<const RoutePlan> plan = routePlan(peerId, dmrData, dstId, streamId);
 
-                    // every 5 peers flush the queue
-                    if (i % 5U == 0U) {
-                        m_network->m_frameQueue->flushQueue();
-                    }
+        // repeat traffic to the connected peers
+        if (plan->peers().size() > 0U) {
+            // the frame is encoded once, and only patched per peer
+            FanoutFrame fanout;
 
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+            for (const RouteDestination& dest : plan->peers()) {
+                if (dest.rewrite) {
+                    // rewritten DMR frames must have the embedded LC regenerated, and cannot be patched
+                    PacketBuffer __outboundPeerBuffer = PacketBuffer::copyOf(buffer, len);
+                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.data();
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, dmrData, dataType, dstId, slotNo);
+                    rewriteFrame(outboundPeerBuffer, dmrData, dataType, slotNo, dest.rewriteDstId, dest.rewriteSlotNo);
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId, true);
-                    if (m_network->m_debug) {
-                        LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u, external = %u", 
-                            peerId, peer.first, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId, external);
-                    }
+                    m_network->writePeer(dest.peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                }
+                else {
+                    m_network->writePeerFanout(dest.peerId, fanout, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, buffer, len, pktSeq, streamId);
+                }
 
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
-                    i++;
+                if (m_network->m_debug) {
+                    LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u, external = %u", 
+                        peerId, dest.peerId, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId, external);
                 }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
             m_network->m_frameQueue->flushQueue();
         }
 
         // repeat traffic to external peers
-        if (m_network->m_host->m_peerNetworks.size() > 0U && !tg.config().parrot()) {
-            for (auto peer : m_network->m_host->m_peerNetworks) {
-                uint32_t dstPeerId = peer.second->getPeerId();
-
-                // don't try to repeat traffic to the source peer...if this traffic
-                // is coming from a external peer
-                if (dstPeerId != peerId) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(dstPeerId, dmrData, streamId, true)) {
-                        continue;
-                    }
-
-                    // check if the source peer is blocked from sending to this peer
-                    if (peer.second->checkBlockedPeer(peerId)) {
-                        continue;
-                    }
-
-                    // skip peer if it isn't enabled
-                    if (!peer.second->isEnabled()) {
-                        continue;
-                    }
-
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+        if (plan->externalPeers().size() > 0U && !tg->config().parrot()) {
+            for (const RouteDestination& dest : plan->externalPeers()) {
+                // skip peer if it isn't enabled
+                if (!dest.peerNetwork->isEnabled()) {
+                    continue;
+                }
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, dstPeerId, dmrData, dataType, dstId, slotNo);
+                PacketBuffer __outboundPeerBuffer = PacketBuffer::copyOf(buffer, len);
+                uint8_t* outboundPeerBuffer = __outboundPeerBuffer.data();
 
-                    peer.second->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId);
-                    if (m_network->m_debug) {
-                        LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u, external = %u", 
-                            peerId, dstPeerId, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId, external);
-                    }
+                // perform TGID route rewrites if configured
+                if (dest.rewrite) {
+                    rewriteFrame(outboundPeerBuffer, dmrData, dataType, slotNo, dest.rewriteDstId, dest.rewriteSlotNo);
+                }
 
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
+                dest.peerNetwork->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, outboundPeerBuffer, len, pktSeq, streamId);
+                if (m_network->m_debug) {
+                    LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, flco = $%02X, slotNo = %u, len = %u, pktSeq = %u, stream = %u, external = %u", 
+                        peerId, dest.peerId, seqNo, srcId, dstId, flco, slotNo, len, pktSeq, streamId, external);
                 }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
         }
 
@@ -407,22 +387,23 @@ bool TagDMRData::processGrantReq(uint32_t srcId, uint32_t dstId, uint8_t slot, b
         }
     }
 
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
+    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
 
     // check TGID validity
-    if (tg.isInvalid()) {
+    if (tg->isInvalid()) {
         return false;
     }
 
-    if (!tg.config().active()) {
+    if (!tg->config().active()) {
         return false;
     }
 
     // repeat traffic to the connected peers
-    if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
-            if (peerId != peer.first) {
-                write_CSBK_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    if (peers->size() > 0U) {
+        for (const PeerEntry& peer : *peers) {
+            if (peerId != peer.peerId) {
+                write_CSBK_Grant(peer.peerId, srcId, dstId, 4U, !unitToUnit);
             }
         }
     }
@@ -450,11 +431,12 @@ void TagDMRData::playbackParrot()
         }
         else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
-                m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
+            PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+            for (const PeerEntry& peer : *peers) {
+                m_network->writePeer(peer.peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "DMR, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
-                        peer.first, pkt.bufferLen, pkt.pktSeq, pkt.streamId);
+                        peer.peerId, pkt.bufferLen, pkt.pktSeq, pkt.streamId);
                 }
             }
         }
@@ -509,59 +491,66 @@ void TagDMRData::routeRewrite(uint8_t* buffer, uint32_t peerId, dmr::data::NetDa
 
     // does the data require route rewriting?
     if (peerRewrite(peerId, rewriteDstId, rewriteSlotNo, outbound)) {
-        // rewrite destination TGID in the frame
-        __SET_UINT16(rewriteDstId, buffer, 8U);
-
-        // set or clear the e.Slot flag (if 0x80 is set Slot 2 otherwise Slot 1)
-        if (rewriteSlotNo == 2 && (buffer[15U] & 0x80U) == 0x00U)
-            buffer[15U] |= 0x80;
-        if (rewriteSlotNo == 1 && (buffer[15U] & 0x80U) == 0x80U)
-            buffer[15U] = buffer[15U] & ~0x80U;
+        rewriteFrame(buffer, dmrData, dataType, slotNo, rewriteDstId, rewriteSlotNo);
+    }
+}
 
-        uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
-        dmrData.getData(data + 2U);
+/* Helper to rewrite the destination TGID and slot of the network data buffer. */
 
-        if (dataType == DataType::VOICE_LC_HEADER ||
-            dataType == DataType::TERMINATOR_WITH_LC) {
-            // decode and reconstruct embedded DMR data
-            lc::FullLC fullLC;
-            std::unique_ptr<lc::LC> lc = fullLC.decode(data + 2U, dataType);
-            if (lc == nullptr) {
-                LogWarning(LOG_NET, "DMR Slot %u, bad LC received from the network, replacing", slotNo);
-                lc = std::make_unique<lc::LC>(dmrData.getFLCO(), dmrData.getSrcId(), rewriteDstId);
-            }
+void TagDMRData::rewriteFrame(uint8_t* buffer, dmr::data::NetData& dmrData, DataType::E dataType, uint32_t slotNo, uint32_t rewriteDstId, uint32_t rewriteSlotNo)
+{
+    // rewrite destination TGID in the frame
+    __SET_UINT16(rewriteDstId, buffer, 8U);
 
-            lc->setDstId(rewriteDstId);
+    // set or clear the e.Slot flag (if 0x80 is set Slot 2 otherwise Slot 1)
+    if (rewriteSlotNo == 2 && (buffer[15U] & 0x80U) == 0x00U)
+        buffer[15U] |= 0x80;
+    if (rewriteSlotNo == 1 && (buffer[15U] & 0x80U) == 0x80U)
+        buffer[15U] = buffer[15U] & ~0x80U;
 
-            // Regenerate the LC data
-            fullLC.encode(*lc, data + 2U, dataType);
-            dmrData.setData(data + 2U);
+    uint8_t data[DMR_FRAME_LENGTH_BYTES + 2U];
+    dmrData.getData(data + 2U);
+
+    if (dataType == DataType::VOICE_LC_HEADER ||
+        dataType == DataType::TERMINATOR_WITH_LC) {
+        // decode and reconstruct embedded DMR data
+        lc::FullLC fullLC;
+        std::unique_ptr<lc::LC> lc = fullLC.decode(data + 2U, dataType);
+        if (lc == nullptr) {
+            LogWarning(LOG_NET, "DMR Slot %u, bad LC received from the network, replacing", slotNo);
+            lc = std::make_unique<lc::LC>(dmrData.getFLCO(), dmrData.getSrcId(), rewriteDstId);
         }
-        else if (dataType == DataType::VOICE_PI_HEADER) {
-            // decode and reconstruct embedded DMR data
-            lc::FullLC fullLC;
-            std::unique_ptr<lc::PrivacyLC> lc = fullLC.decodePI(data + 2U);
-            if (lc == nullptr) {
-                LogWarning(LOG_NET, "DMR Slot %u, DT_VOICE_PI_HEADER, bad LC received, replacing", slotNo);
-                lc = std::make_unique<lc::PrivacyLC>();
-            }
 
-            lc->setDstId(rewriteDstId);
+        lc->setDstId(rewriteDstId);
 
-            // Regenerate the LC data
-            fullLC.encodePI(*lc, data + 2U);
-            dmrData.setData(data + 2U);
+        // Regenerate the LC data
+        fullLC.encode(*lc, data + 2U, dataType);
+        dmrData.setData(data + 2U);
+    }
+    else if (dataType == DataType::VOICE_PI_HEADER) {
+        // decode and reconstruct embedded DMR data
+        lc::FullLC fullLC;
+        std::unique_ptr<lc::PrivacyLC> lc = fullLC.decodePI(data + 2U);
+        if (lc == nullptr) {
+            LogWarning(LOG_NET, "DMR Slot %u, DT_VOICE_PI_HEADER, bad LC received, replacing", slotNo);
+            lc = std::make_unique<lc::PrivacyLC>();
         }
 
-        dmrData.getData(buffer + 20U);
+        lc->setDstId(rewriteDstId);
+
+        // Regenerate the LC data
+        fullLC.encodePI(*lc, data + 2U);
+        dmrData.setData(data + 2U);
     }
+
+    dmrData.getData(buffer + 20U);
 }
 
 /* Helper to route rewrite destination ID and slot. */
 
 bool TagDMRData::peerRewrite(uint32_t peerId, uint32_t& dstId, uint32_t& slotNo, bool outbound)
 {
-    lookups::TalkgroupRuleGroupVoice tg;
+    lookups::TalkgroupRuleGroupVoiceHandle tg;
     if (outbound) {
         tg = m_network->m_tidLookup->find(dstId);
     }
@@ -570,8 +559,8 @@ bool TagDMRData::peerRewrite(uint32_t peerId, uint32_t& dstId, uint32_t& slotNo,
     }
 
     bool rewrote = false;
-    if (tg.config().rewriteSize() > 0) {
-        std::vector<lookups::TalkgroupRuleRewrite> rewrites = tg.config().rewrite();
+    if (tg->config().rewriteSize() > 0) {
+        const std::vector<lookups::TalkgroupRuleRewrite>& rewrites = tg->config().rewrite();
         for (auto entry : rewrites) {
             if (entry.peerId() == peerId) {
                 if (outbound) {
@@ -579,8 +568,8 @@ bool TagDMRData::peerRewrite(uint32_t peerId, uint32_t& dstId, uint32_t& slotNo,
                     slotNo = entry.tgSlot();
                 }
                 else {
-                    dstId = tg.source().tgId();
-                    slotNo = tg.source().tgSlot();
+                    dstId = tg->source().tgId();
+                    slotNo = tg->source().tgSlot();
                 }
                 rewrote = true;
                 break;
@@ -619,7 +608,7 @@ bool TagDMRData::processCSBK(uint8_t* buffer, uint32_t peerId, dmr::data::NetDat
                             .tag("csbk", csbk->toString())
                                 .field("raw", ss.str())
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
             }
 
@@ -652,6 +641,70 @@ bool TagDMRData::processCSBK(uint8_t* buffer, uint32_t peerId, dmr::data::NetDat
     return true;
 }
 
+/* Helper to resolve the routing plan for a call stream. */
+
+std::shared_ptr<const RoutePlan> TagDMRData::routePlan(uint32_t peerId, data::NetData& dmrData, uint32_t dstId, uint32_t streamId)
+{
+    uint32_t slotNo = dmrData.getSlotNo();
+    bool group = dmrData.getFLCO() == FLCO::GROUP;
+    uint64_t generation = m_network->routeGeneration();
+
+    std::shared_ptr<const RoutePlan> cached = m_routePlans.find(dstId, slotNo, streamId, peerId, group, generation);
+    if (cached != nullptr)
+        return cached;
+
+    std::shared_ptr<RoutePlan> plan = std::make_shared<RoutePlan>(streamId, peerId, group, generation);
+
+    // determine the connected peers permitted to receive this call stream
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    for (const PeerEntry& peer : *peers) {
+        if (peerId == peer.peerId)
+            continue;
+
+        // is this peer ignored?
+        if (!isPeerPermitted(peer.peerId, dmrData, streamId)) {
+            continue;
+        }
+
+        // determine TGID route rewrites if configured
+        uint32_t rewriteDstId = dstId;
+        uint32_t rewriteSlotNo = slotNo;
+        bool rewrite = peerRewrite(peer.peerId, rewriteDstId, rewriteSlotNo);
+
+        plan->addPeer(peer.peerId, rewrite, rewriteDstId, rewriteSlotNo);
+    }
+
+    // determine the external peers permitted to receive this call stream
+    for (auto peer : m_network->m_host->m_peerNetworks) {
+        uint32_t dstPeerId = peer.second->getPeerId();
+
+        // don't try to repeat traffic to the source peer...if this traffic
+        // is coming from a external peer
+        if (dstPeerId == peerId)
+            continue;
+
+        // is this peer ignored?
+        if (!isPeerPermitted(dstPeerId, dmrData, streamId, true)) {
+            continue;
+        }
+
+        // check if the source peer is blocked from sending to this peer
+        if (peer.second->checkBlockedPeer(peerId)) {
+            continue;
+        }
+
+        // determine TGID route rewrites if configured
+        uint32_t rewriteDstId = dstId;
+        uint32_t rewriteSlotNo = slotNo;
+        bool rewrite = peerRewrite(dstPeerId, rewriteDstId, rewriteSlotNo);
+
+        plan->addExternalPeer(dstPeerId, peer.second, rewrite, rewriteDstId, rewriteSlotNo);
+    }
+
+    m_routePlans.add(dstId, slotNo, plan);
+    return plan;
+}
+
 /* Helper to determine if the peer is permitted for traffic. */
 
 bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t streamId, bool external)
@@ -666,39 +719,29 @@ bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t
 
     // is this a group call?
     if (data.getFLCO() == FLCO::GROUP) {
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(data.getDstId(), data.getSlotNo());
-
-        std::vector<uint32_t> inclusion = tg.config().inclusion();
-        std::vector<uint32_t> exclusion = tg.config().exclusion();
+        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(data.getDstId(), data.getSlotNo());
 
         // peer inclusion lists take priority over exclusion lists
-        if (inclusion.size() > 0) {
-            auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-            if (it == inclusion.end()) {
+        if (!tg->config().inclusion().empty()) {
+            if (!tg->config().isIncluded(peerId)) {
                 return false;
             }
         }
         else {
-            if (exclusion.size() > 0) {
-                auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-                if (it != exclusion.end()) {
-                    return false;
-                }
+            if (tg->config().isExcluded(peerId)) {
+                return false;
             }
         }
 
         // peer always send list takes priority over any following affiliation rules
-        std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-        if (alwaysSend.size() > 0) {
-            auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-            if (it != alwaysSend.end()) {
-                return true; // skip any following checks and always send traffic
-            }
+        if (tg->config().isAlwaysSend(peerId)) {
+            return true; // skip any following checks and always send traffic
         }
 
+        PeerTable::Snapshot peers = m_network->m_peers.snapshot();
         FNEPeerConnection* connection = nullptr;
-        if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
-            connection = m_network->m_peers[peerId];
+        if (peerId > 0) {
+            connection = peers->find(peerId);
         }
 
         // is this peer a conventional peer?
@@ -721,7 +764,7 @@ bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t
 
         // is this a TG that requires affiliations to repeat?
         // NOTE: external peers *always* repeat traffic regardless of affiliation
-        if (tg.config().affiliated() && !external) {
+        if (tg->config().affiliated() && !external) {
             uint32_t lookupPeerId = peerId;
             if (connection != nullptr) {
                 if (connection->ccPeerId() > 0U)
@@ -729,7 +772,7 @@ bool TagDMRData::isPeerPermitted(uint32_t peerId, data::NetData& data, uint32_t
             }
 
             // check the affiliations for this peer to see if we can repeat traffic
-            lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[lookupPeerId];
+            lookups::AffiliationLookup* aff = peers->findAffiliations(lookupPeerId);
             if (aff == nullptr) {
                 std::string peerIdentity = m_network->resolvePeerIdentity(lookupPeerId);
                 //LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", lookupPeerId, peerIdentity.c_str());
@@ -766,7 +809,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
                             .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                             .field("slot", std::to_string(data.getSlotNo()))
                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                    .requestAsync(m_network->m_influxServer);
+                    .requestAsync(m_network->m_influxWriter);
             }
 
             // report In-Call Control to the peer sending traffic
@@ -803,7 +846,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
                                 .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_DST_RID))
                                 .field("slot", std::to_string(data.getSlotNo()))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 return false;
@@ -824,7 +867,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
                                 .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                                 .field("slot", std::to_string(data.getSlotNo()))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 LogWarning(LOG_NET, "DMR slot %s, illegal/unknown RID attempted access, srcId = %u, dstId = %u", data.getSlotNo(), data.getSrcId(), data.getDstId());
@@ -838,8 +881,8 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
 
     // is this a group call?
     if (data.getFLCO() == FLCO::GROUP) {
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(data.getDstId());
-        if (tg.isInvalid()) {
+        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(data.getDstId());
+        if (tg->isInvalid()) {
             // report error event to InfluxDB
             if (m_network->m_enableInfluxDB) {
                 influxdb::QueryBuilder()
@@ -851,7 +894,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
                             .field("message", std::string(INFLUXDB_ERRSTR_INV_TALKGROUP))
                             .field("slot", std::to_string(data.getSlotNo()))
                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                    .requestAsync(m_network->m_influxServer);
+                    .requestAsync(m_network->m_influxWriter);
             }
 
             // report In-Call Control to the peer sending traffic
@@ -861,13 +904,9 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
 
         // peer always send list takes priority over any following affiliation rules
         bool isAlwaysPeer = false;
-        std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-        if (alwaysSend.size() > 0) {
-            auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-            if (it != alwaysSend.end()) {
-                isAlwaysPeer = true; // skip any following checks and always send traffic
-                rejectUnknownBadCall = false;
-            }
+        if (tg->config().isAlwaysSend(peerId)) {
+            isAlwaysPeer = true; // skip any following checks and always send traffic
+            rejectUnknownBadCall = false;
         }
 
         // fail call if the reject flag is set
@@ -883,7 +922,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
                             .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                             .field("slot", std::to_string(data.getSlotNo()))
                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                    .requestAsync(m_network->m_influxServer);
+                    .requestAsync(m_network->m_influxWriter);
             }
 
             LogWarning(LOG_NET, "DMR slot %s, illegal/unknown RID attempted access, srcId = %u, dstId = %u", data.getSlotNo(), data.getSrcId(), data.getDstId());
@@ -894,7 +933,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
         }
 
         // check the DMR slot number
-        if (tg.source().tgSlot() != data.getSlotNo()) {
+        if (tg->source().tgSlot() != data.getSlotNo()) {
             // report error event to InfluxDB
             if (m_network->m_enableInfluxDB) {
                 influxdb::QueryBuilder()
@@ -906,7 +945,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
                             .field("message", std::string(INFLUXDB_ERRSTR_INV_SLOT))
                             .field("slot", std::to_string(data.getSlotNo()))
                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                    .requestAsync(m_network->m_influxServer);
+                    .requestAsync(m_network->m_influxWriter);
             }
 
             // report In-Call Control to the peer sending traffic
@@ -915,7 +954,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
         }
 
         // is the TGID active?
-        if (!tg.config().active()) {
+        if (!tg->config().active()) {
             // report error event to InfluxDB
             if (m_network->m_enableInfluxDB) {
                 influxdb::QueryBuilder()
@@ -927,7 +966,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
                             .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_TALKGROUP))
                             .field("slot", std::to_string(data.getSlotNo()))
                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                    .requestAsync(m_network->m_influxServer);
+                    .requestAsync(m_network->m_influxWriter);
             }
 
             // report In-Call Control to the peer sending traffic
@@ -938,10 +977,9 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
         // always peers can violate the rules...hurray
         if (!isAlwaysPeer) {
             // does the TGID have a permitted RID list?
-            if (tg.config().permittedRIDs().size() > 0) {
+            if (!tg->config().permittedRIDs().empty()) {
                 // does the transmitting RID have permission?
-                std::vector<uint32_t> permittedRIDs = tg.config().permittedRIDs();
-                if (std::find(permittedRIDs.begin(), permittedRIDs.end(), data.getSrcId()) == permittedRIDs.end()) {
+                if (!tg->config().isRIDPermitted(data.getSrcId())) {
                     // report error event to InfluxDB
                     if (m_network->m_enableInfluxDB) {
                         influxdb::QueryBuilder()
@@ -952,7 +990,7 @@ bool TagDMRData::validate(uint32_t peerId, data::NetData& data, uint32_t streamI
                                 .tag("dstId", std::to_string(data.getDstId()))
                                     .field("message", std::string(INFLUXDB_ERRSTR_RID_NOT_PERMITTED))
                                 .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                            .requestAsync(m_network->m_influxServer);
+                            .requestAsync(m_network->m_influxWriter);
                     }
 
                     // report In-Call Control to the peer sending traffic
@@ -982,7 +1020,8 @@ bool TagDMRData::write_CSBK_Grant(uint32_t peerId, uint32_t srcId, uint32_t dstI
     }
 
     // check the affiliations for this peer to see if we can grant traffic
-    lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[peerId];
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    lookups::AffiliationLookup* aff = peers->findAffiliations(peerId);
     if (aff == nullptr) {
         std::string peerIdentity = m_network->resolvePeerIdentity(peerId);
         LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", peerId, peerIdentity.c_str());
@@ -1089,20 +1128,17 @@ void TagDMRData::write_CSBK(uint32_t peerId, uint8_t slot, lc::CSBK* csbk)
         m_network->writePeer(peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, message.get(), messageLength, RTP_END_OF_CALL_SEQ, streamId, false);
     } else {
         // repeat traffic to the connected peers
-        if (m_network->m_peers.size() > 0U) {
-            uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
-                // every 5 peers flush the queue
-                if (i % 5U == 0U) {
-                    m_network->m_frameQueue->flushQueue();
-                }
+        PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+        if (peers->size() > 0U) {
+            // the frame is encoded once, and only patched per peer
+            FanoutFrame fanout;
 
-                m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, message.get(), messageLength, RTP_END_OF_CALL_SEQ, streamId, true);
+            for (const PeerEntry& peer : *peers) {
+                m_network->writePeerFanout(peer.peerId, fanout, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, message.get(), messageLength, RTP_END_OF_CALL_SEQ, streamId);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "DMR, peer = %u, slotNo = %u, len = %u, stream = %u", 
-                        peer.first, slot, messageLength, streamId);
+                        peer.peerId, slot, messageLength, streamId);
                 }
-                i++;
             }
             m_network->m_frameQueue->flushQueue();
         }
@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2023-2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2023-2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -23,6 +23,7 @@
 #include "common/Clock.h"
 #include "network/FNENetwork.h"
 #include "network/callhandler/packetdata/DMRPacketData.h"
+#include "network/callhandler/RoutePlan.h"
 
 #include <deque>
 
@@ -198,6 +199,8 @@ namespace network
             typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
             std::unordered_map<uint32_t, RxStatus> m_status;
 
+            RoutePlanCache m_routePlans;
+
             friend class packetdata::DMRPacketData;
             packetdata::DMRPacketData* m_packetData;
 
@@ -214,6 +217,16 @@ namespace network
              * @param outbound Flag indicating whether or not this is outbound traffic.
              */
             void routeRewrite(uint8_t* buffer, uint32_t peerId, dmr::data::NetData& dmrData, DMRDEF::DataType::E dataType, uint32_t dstId, uint32_t slotNo, bool outbound = true);
+            /**
+             * @brief Helper to rewrite the destination TGID and slot of the network data buffer.
+             * @param buffer Frame buffer.
+             * @param dmrData Instance of data::NetData DMR data container class.
+             * @param dataType DMR Data Type.
+             * @param slotNo DMR slot number.
+             * @param rewriteDstId Rewritten Destination ID.
+             * @param rewriteSlotNo Rewritten DMR slot number.
+             */
+            void rewriteFrame(uint8_t* buffer, dmr::data::NetData& dmrData, DMRDEF::DataType::E dataType, uint32_t slotNo, uint32_t rewriteDstId, uint32_t rewriteSlotNo);
             /**
              * @brief Helper to route rewrite destination ID and slot.
              * @param peerId Peer ID.
@@ -233,6 +246,16 @@ namespace network
              */
             bool processCSBK(uint8_t* buffer, uint32_t peerId, dmr::data::NetData& dmrData);
 
+            /**
+             * @brief Helper to resolve the routing plan for a call stream.
+             * @param peerId Source Peer ID.
+             * @param dmrData Instance of data::NetData DMR data container class.
+             * @param dstId Destination ID.
+             * @param streamId Stream ID.
+             * @returns std::shared_ptr<const RoutePlan> Routing plan.
+             */
+            std::shared_ptr<const RoutePlan> routePlan(uint32_t peerId, dmr::data::NetData& dmrData, uint32_t dstId, uint32_t streamId);
+
             /**
              * @brief Helper to determine if the peer is permitted for traffic.
              * @param peerId Peer ID.
@@ -48,6 +48,7 @@ TagNXDNData::TagNXDNData(FNENetwork* network, bool debug) :
     m_parrotFrames(),
     m_parrotFramesReady(false),
     m_status(),
+    m_routePlans(),
    m_debug(debug)
 {
     assert(network != nullptr);
@@ -63,10 +64,8 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
 {
     hrc::hrc_t pktTime = hrc::now();
 
-    UInt8Array __buffer = std::make_unique<uint8_t[]>(len);
-    uint8_t* buffer = __buffer.get();
-    ::memset(buffer, 0x00U, len);
-    ::memcpy(buffer, data, len);
+    PacketBuffer __buffer = PacketBuffer::copyOf(data, len);
+    uint8_t* buffer = __buffer.data();
 
     uint8_t messageType = data[4U];
 
@@ -124,8 +123,8 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                     m_status[dstId].reset();
 
                     // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                    if (tg.config().parrot()) {
+                    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+                    if (tg->config().parrot()) {
                         if (m_parrotFrames.size() > 0) {
                             m_parrotFramesReady = true;
                             LogMessage(LOG_NET, "NXDN, Parrot Playback will Start, peer = %u, srcId = %u", peerId, srcId);
@@ -147,10 +146,11 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                                 .tag("dstId", std::to_string(dstId))
                                     .field("duration", duration)
                                 .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                            .requestAsync(m_network->m_influxServer);
+                            .requestAsync(m_network->m_influxWriter);
                     }
 
                     m_network->eraseStreamPktSeq(peerId, streamId);
+                    m_routePlans.erase(dstId);
                     m_network->m_callInProgress = false;
                 }
             }
@@ -188,8 +188,8 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
                 }
                 else {
                     // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                    if (tg.config().parrot()) {                    
+                    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+                    if (tg->config().parrot()) {                    
                         m_parrotFramesReady = false;
                         if (m_parrotFrames.size() > 0) {
                             for (auto& pkt : m_parrotFrames) {
@@ -217,8 +217,8 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
         }
 
         // is this a parrot talkgroup?
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-        if (tg.config().parrot()) {
+        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+        if (tg->config().parrot()) {
             uint8_t *copy = new uint8_t[len];
             ::memcpy(copy, buffer, len);
 
@@ -242,83 +242,52 @@ bool TagNXDNData::processFrame(const uint8_t* data, uint32_t len, uint32_t peerI
 
         m_status[dstId].lastPacket = hrc::now();
 
-        // repeat traffic to the connected peers
-        if (m_network->m_peers.size() > 0U) {
-            uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
-                if (peerId != peer.first) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(peer.first, lc, messageType, streamId)) {
-                        continue;
-                    }
-
-                    // every 5 peers flush the queue
-                    if (i % 5U == 0U) {
-                        m_network->m_frameQueue->flushQueue();
-                    }
+        // resolve the routing plan for this call stream
+        std::shared_ptr<const RoutePlan> plan = routePlan(peerId, lc, messageType, dstId, streamId);
 
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
-
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, messageType, dstId);
-
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerBuffer, len, pktSeq, streamId, true);
-                    if (m_network->m_debug) {
-                        LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
-                            peerId, peer.first, messageType, srcId, dstId, len, pktSeq, streamId, external);
-                    }
+        // repeat traffic to the connected peers
+        if (plan->peers().size() > 0U) {
+            // the frame is encoded once, and only patched per peer
+            FanoutFrame fanout;
 
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
-                    i++;
+            for (const RouteDestination& dest : plan->peers()) {
+                m_network->writePeerFanout(dest.peerId, fanout, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, buffer, len, pktSeq, streamId,
+                    dest.rewrite ? dest.rewriteDstId : 0U);
+                if (m_network->m_debug) {
+                    LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
+                        peerId, dest.peerId, messageType, srcId, dstId, len, pktSeq, streamId, external);
                 }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
             m_network->m_frameQueue->flushQueue();
         }
 
         // repeat traffic to external peers
-        if (m_network->m_host->m_peerNetworks.size() > 0U && !tg.config().parrot()) {
-            for (auto peer : m_network->m_host->m_peerNetworks) {
-                uint32_t dstPeerId = peer.second->getPeerId();
-
-                // don't try to repeat traffic to the source peer...if this traffic
-                // is coming from a external peer
-                if (dstPeerId != peerId) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(dstPeerId, lc, messageType, streamId, true)) {
-                        continue;
-                    }
-
-                    // check if the source peer is blocked from sending to this peer
-                    if (peer.second->checkBlockedPeer(peerId)) {
-                        continue;
-                    }
-
-                    // skip peer if it isn't enabled
-                    if (!peer.second->isEnabled()) {
-                        continue;
-                    }
-
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+        if (plan->externalPeers().size() > 0U && !tg->config().parrot()) {
+            for (const RouteDestination& dest : plan->externalPeers()) {
+                // skip peer if it isn't enabled
+                if (!dest.peerNetwork->isEnabled()) {
+                    continue;
+                }
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, dstPeerId, messageType, dstId);
+                PacketBuffer __outboundPeerBuffer = PacketBuffer::copyOf(buffer, len);
+                uint8_t* outboundPeerBuffer = __outboundPeerBuffer.data();
 
-                    peer.second->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerBuffer, len, pktSeq, streamId);
-                    if (m_network->m_debug) {
-                        LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
-                            peerId, dstPeerId, messageType, srcId, dstId, len, pktSeq, streamId, external);
-                    }
+                // perform TGID route rewrites if configured
+                if (dest.rewrite) {
+                    __SET_UINT16(dest.rewriteDstId, outboundPeerBuffer, 8U);
+                }
 
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
+                dest.peerNetwork->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, outboundPeerBuffer, len, pktSeq, streamId);
+                if (m_network->m_debug) {
+                    LogDebug(LOG_NET, "NXDN, srcPeer = %u, dstPeer = %u, messageType = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
+                        peerId, dest.peerId, messageType, srcId, dstId, len, pktSeq, streamId, external);
                 }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
         }
 
@@ -352,22 +321,23 @@ bool TagNXDNData::processGrantReq(uint32_t srcId, uint32_t dstId, bool unitToUni
         }
     }
 
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
+    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
 
     // check TGID validity
-    if (tg.isInvalid()) {
+    if (tg->isInvalid()) {
         return false;
     }
 
-    if (!tg.config().active()) {
+    if (!tg->config().active()) {
         return false;
     }
 
     // repeat traffic to the connected peers
-    if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
-            if (peerId != peer.first) {
-                write_Message_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    if (peers->size() > 0U) {
+        for (const PeerEntry& peer : *peers) {
+            if (peerId != peer.peerId) {
+                write_Message_Grant(peer.peerId, srcId, dstId, 4U, !unitToUnit);
             }
         }
     }
@@ -395,11 +365,12 @@ void TagNXDNData::playbackParrot()
         }
         else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
-                m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
+            PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+            for (const PeerEntry& peer : *peers) {
+                m_network->writePeer(peer.peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "NXDN, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
-                        peer.first, pkt.bufferLen, pkt.pktSeq, pkt.streamId);
+                        peer.peerId, pkt.bufferLen, pkt.pktSeq, pkt.streamId);
                 }
             }
         }
@@ -431,7 +402,7 @@ void TagNXDNData::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t message
 
 bool TagNXDNData::peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound)
 {
-    lookups::TalkgroupRuleGroupVoice tg;
+    lookups::TalkgroupRuleGroupVoiceHandle tg;
     if (outbound) {
         tg = m_network->m_tidLookup->find(dstId);
     }
@@ -440,15 +411,15 @@ bool TagNXDNData::peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound)
     }
 
     bool rewrote = false;
-    if (tg.config().rewriteSize() > 0) {
-        std::vector<lookups::TalkgroupRuleRewrite> rewrites = tg.config().rewrite();
+    if (tg->config().rewriteSize() > 0) {
+        const std::vector<lookups::TalkgroupRuleRewrite>& rewrites = tg->config().rewrite();
         for (auto entry : rewrites) {
             if (entry.peerId() == peerId) {
                 if (outbound) {
                     dstId = entry.tgId();
                 }
                 else {
-                    dstId = tg.source().tgId();
+                    dstId = tg->source().tgId();
                 }
                 rewrote = true;
                 break;
@@ -459,6 +430,67 @@ bool TagNXDNData::peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound)
     return rewrote;
 }
 
+/* Helper to resolve the routing plan for a call stream. */
+
+std::shared_ptr<const RoutePlan> TagNXDNData::routePlan(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, uint32_t dstId, uint32_t streamId)
+{
+    bool group = lc.getGroup();
+    uint64_t generation = m_network->routeGeneration();
+
+    std::shared_ptr<const RoutePlan> cached = m_routePlans.find(dstId, 0U, streamId, peerId, group, generation);
+    if (cached != nullptr)
+        return cached;
+
+    std::shared_ptr<RoutePlan> plan = std::make_shared<RoutePlan>(streamId, peerId, group, generation);
+
+    // determine the connected peers permitted to receive this call stream
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    for (const PeerEntry& peer : *peers) {
+        if (peerId == peer.peerId)
+            continue;
+
+        // is this peer ignored?
+        if (!isPeerPermitted(peer.peerId, lc, messageType, streamId)) {
+            continue;
+        }
+
+        // determine TGID route rewrites if configured
+        uint32_t rewriteDstId = dstId;
+        bool rewrite = peerRewrite(peer.peerId, rewriteDstId);
+
+        plan->addPeer(peer.peerId, rewrite, rewriteDstId);
+    }
+
+    // determine the external peers permitted to receive this call stream
+    for (auto peer : m_network->m_host->m_peerNetworks) {
+        uint32_t dstPeerId = peer.second->getPeerId();
+
+        // don't try to repeat traffic to the source peer...if this traffic
+        // is coming from a external peer
+        if (dstPeerId == peerId)
+            continue;
+
+        // is this peer ignored?
+        if (!isPeerPermitted(dstPeerId, lc, messageType, streamId, true)) {
+            continue;
+        }
+
+        // check if the source peer is blocked from sending to this peer
+        if (peer.second->checkBlockedPeer(peerId)) {
+            continue;
+        }
+
+        // determine TGID route rewrites if configured
+        uint32_t rewriteDstId = dstId;
+        bool rewrite = peerRewrite(dstPeerId, rewriteDstId);
+
+        plan->addExternalPeer(dstPeerId, peer.second, rewrite, rewriteDstId);
+    }
+
+    m_routePlans.add(dstId, 0U, plan);
+    return plan;
+}
+
 /* Helper to determine if the peer is permitted for traffic. */
 
 bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, uint32_t streamId, bool external)
@@ -473,39 +505,29 @@ bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t message
 
     // is this a group call?
     if (lc.getGroup()) {
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(lc.getDstId());
-
-        std::vector<uint32_t> inclusion = tg.config().inclusion();
-        std::vector<uint32_t> exclusion = tg.config().exclusion();
+        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(lc.getDstId());
 
         // peer inclusion lists take priority over exclusion lists
-        if (inclusion.size() > 0) {
-            auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-            if (it == inclusion.end()) {
+        if (!tg->config().inclusion().empty()) {
+            if (!tg->config().isIncluded(peerId)) {
                 return false;
             }
         }
         else {
-            if (exclusion.size() > 0) {
-                auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-                if (it != exclusion.end()) {
-                    return false;
-                }
+            if (tg->config().isExcluded(peerId)) {
+                return false;
             }
         }
 
         // peer always send list takes priority over any following affiliation rules
-        std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-        if (alwaysSend.size() > 0) {
-            auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-            if (it != alwaysSend.end()) {
-                return true; // skip any following checks and always send traffic
-            }
+        if (tg->config().isAlwaysSend(peerId)) {
+            return true; // skip any following checks and always send traffic
         }
 
+        PeerTable::Snapshot peers = m_network->m_peers.snapshot();
         FNEPeerConnection* connection = nullptr;
-        if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
-            connection = m_network->m_peers[peerId];
+        if (peerId > 0) {
+            connection = peers->find(peerId);
         }
 
         // is this peer a conventional peer?
@@ -528,7 +550,7 @@ bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t message
 
         // is this a TG that requires affiliations to repeat?
         // NOTE: external peers *always* repeat traffic regardless of affiliation
-        if (tg.config().affiliated() && !external) {
+        if (tg->config().affiliated() && !external) {
             uint32_t lookupPeerId = peerId;
             if (connection != nullptr) {
                 if (connection->ccPeerId() > 0U)
@@ -536,7 +558,7 @@ bool TagNXDNData::isPeerPermitted(uint32_t peerId, lc::RTCH& lc, uint8_t message
             }
 
             // check the affiliations for this peer to see if we can repeat traffic
-            lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[lookupPeerId];
+            lookups::AffiliationLookup* aff = peers->findAffiliations(lookupPeerId);
             if (aff == nullptr) {
                 std::string peerIdentity = m_network->resolvePeerIdentity(lookupPeerId);
                 //LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", lookupPeerId, peerIdentity.c_str());
@@ -572,7 +594,7 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
                         .tag("dstId", std::to_string(lc.getDstId()))
                             .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                    .requestAsync(m_network->m_influxServer);
+                    .requestAsync(m_network->m_influxWriter);
             }
 
             // report In-Call Control to the peer sending traffic
@@ -608,7 +630,7 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
                             .tag("dstId", std::to_string(lc.getDstId()))
                                 .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_DST_RID))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 // report In-Call Control to the peer sending traffic
@@ -630,7 +652,7 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
                             .tag("dstId", std::to_string(lc.getDstId()))
                                 .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 LogWarning(LOG_NET, "NXDN, illegal/unknown RID attempted access, srcId = %u, dstId = %u", lc.getSrcId(), lc.getDstId());
@@ -644,10 +666,10 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
         return true;
     }
 
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(lc.getDstId());
+    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(lc.getDstId());
 
     // check TGID validity
-    if (tg.isInvalid()) {
+    if (tg->isInvalid()) {
         // report error event to InfluxDB
         if (m_network->m_enableInfluxDB) {
             influxdb::QueryBuilder()
@@ -658,7 +680,7 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
                     .tag("dstId", std::to_string(lc.getDstId()))
                         .field("message", std::string(INFLUXDB_ERRSTR_INV_TALKGROUP))
                     .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                .requestAsync(m_network->m_influxServer);
+                .requestAsync(m_network->m_influxWriter);
         }
 
         // report In-Call Control to the peer sending traffic
@@ -668,13 +690,9 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
 
     // peer always send list takes priority over any following affiliation rules
     bool isAlwaysPeer = false;
-    std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-    if (alwaysSend.size() > 0) {
-        auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-        if (it != alwaysSend.end()) {
-            isAlwaysPeer = true; // skip any following checks and always send traffic
-            rejectUnknownBadCall = false;
-        }
+    if (tg->config().isAlwaysSend(peerId)) {
+        isAlwaysPeer = true; // skip any following checks and always send traffic
+        rejectUnknownBadCall = false;
     }
 
     // fail call if the reject flag is set
@@ -689,7 +707,7 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
                     .tag("dstId", std::to_string(lc.getDstId()))
                         .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                     .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                .requestAsync(m_network->m_influxServer);
+                .requestAsync(m_network->m_influxWriter);
         }
 
         LogWarning(LOG_NET, "NXDN, illegal/unknown RID attempted access, srcId = %u, dstId = %u", lc.getSrcId(), lc.getDstId());
@@ -700,7 +718,7 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
     }
 
     // is the TGID active?
-    if (!tg.config().active()) {
+    if (!tg->config().active()) {
         // report error event to InfluxDB
         if (m_network->m_enableInfluxDB) {
             influxdb::QueryBuilder()
@@ -711,7 +729,7 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
                     .tag("dstId", std::to_string(lc.getDstId()))
                         .field("message", INFLUXDB_ERRSTR_DISABLED_TALKGROUP)
                     .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                .requestAsync(m_network->m_influxServer);
+                .requestAsync(m_network->m_influxWriter);
         }
 
         // report In-Call Control to the peer sending traffic
@@ -722,10 +740,9 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
     // always peers can violate the rules...hurray
     if (!isAlwaysPeer) {
         // does the TGID have a permitted RID list?
-        if (tg.config().permittedRIDs().size() > 0) {
+        if (!tg->config().permittedRIDs().empty()) {
             // does the transmitting RID have permission?
-            std::vector<uint32_t> permittedRIDs = tg.config().permittedRIDs();
-            if (std::find(permittedRIDs.begin(), permittedRIDs.end(), lc.getSrcId()) == permittedRIDs.end()) {
+            if (!tg->config().isRIDPermitted(lc.getSrcId())) {
                 // report error event to InfluxDB
                 if (m_network->m_enableInfluxDB) {
                     influxdb::QueryBuilder()
@@ -736,7 +753,7 @@ bool TagNXDNData::validate(uint32_t peerId, lc::RTCH& lc, uint8_t messageType, u
                             .tag("dstId", std::to_string(lc.getDstId()))
                                 .field("message", std::string(INFLUXDB_ERRSTR_RID_NOT_PERMITTED))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 // report In-Call Control to the peer sending traffic
@@ -760,7 +777,8 @@ bool TagNXDNData::write_Message_Grant(uint32_t peerId, uint32_t srcId, uint32_t
     std::unique_ptr<lc::rcch::MESSAGE_TYPE_VCALL_CONN> rcch = std::make_unique<lc::rcch::MESSAGE_TYPE_VCALL_CONN>();
 
     // check the affiliations for this peer to see if we can grant traffic
-    lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[peerId];
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    lookups::AffiliationLookup* aff = peers->findAffiliations(peerId);
     if (aff == nullptr) {
         std::string peerIdentity = m_network->resolvePeerIdentity(peerId);
         LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", peerId, peerIdentity.c_str());
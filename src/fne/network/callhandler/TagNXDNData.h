@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2023-2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2023-2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -22,6 +22,7 @@
 #include "common/nxdn/lc/RTCH.h"
 #include "common/nxdn/lc/RCCH.h"
 #include "network/FNENetwork.h"
+#include "network/callhandler/RoutePlan.h"
 
 #include <deque>
 
@@ -162,6 +163,8 @@ namespace network
             typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
             std::unordered_map<uint32_t, RxStatus> m_status;
 
+            RoutePlanCache m_routePlans;
+
             bool m_debug;
 
             /**
@@ -182,6 +185,17 @@ namespace network
              */
             bool peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound = true);
 
+            /**
+             * @brief Helper to resolve the routing plan for a call stream.
+             * @param peerId Source Peer ID.
+             * @param lc Instance of nxdn::lc::RTCH.
+             * @param messageType Message Type.
+             * @param dstId Destination ID.
+             * @param streamId Stream ID.
+             * @returns std::shared_ptr<const RoutePlan> Routing plan.
+             */
+            std::shared_ptr<const RoutePlan> routePlan(uint32_t peerId, nxdn::lc::RTCH& lc, uint8_t messageType, uint32_t dstId, uint32_t streamId);
+
             /**
              * @brief Helper to determine if the peer is permitted for traffic.
              * @param peerId Peer ID.
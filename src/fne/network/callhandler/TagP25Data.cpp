@@ -48,6 +48,7 @@ TagP25Data::TagP25Data(FNENetwork* network, bool debug) :
     m_parrotFramesReady(false),
     m_parrotFirstFrame(true),
     m_status(),
+    m_routePlans(),
     m_packetData(nullptr),
     m_debug(debug)
 {
@@ -69,10 +70,8 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 {
     hrc::hrc_t pktTime = hrc::now();
 
-    UInt8Array __buffer = std::make_unique<uint8_t[]>(len);
-    uint8_t* buffer = __buffer.get();
-    ::memset(buffer, 0x00U, len);
-    ::memcpy(buffer, data, len);
+    PacketBuffer __buffer = PacketBuffer::copyOf(data, len);
+    uint8_t* buffer = __buffer.data();
 
     uint8_t lco = data[4U];
 
@@ -173,8 +172,8 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                 // perform a test for grant demands, and if the TG isn't valid ignore the demand
                 bool grantDemand = (data[14U] & 0x80U) == 0x80U;
                 if (grantDemand) {
-                    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-                    if (!tg.config().active()) {
+                    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(control.getDstId());
+                    if (!tg->config().active()) {
                         return false;
                     }
                 }
@@ -196,8 +195,8 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                         m_status[dstId].reset();
 
                         // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                        if (tg.config().parrot()) {
+                        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+                        if (tg->config().parrot()) {
                             if (m_parrotFrames.size() > 0) {
                                 m_parrotFramesReady = true;
                                 m_parrotFirstFrame = true;
@@ -220,10 +219,11 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                                     .tag("dstId", std::to_string(dstId))
                                         .field("duration", duration)
                                     .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                                .requestAsync(m_network->m_influxServer);
+                                .requestAsync(m_network->m_influxWriter);
                         }
 
                         m_network->eraseStreamPktSeq(peerId, streamId);
+                        m_routePlans.erase(dstId);
                         m_network->m_callInProgress = false;
                     }
                 }
@@ -262,8 +262,8 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
                 }
                 else {
                     // is this a parrot talkgroup? if so, clear any remaining frames from the buffer
-                    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                    if (tg.config().parrot()) {
+                    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+                    if (tg->config().parrot()) {
                         m_parrotFramesReady = false;
                         if (m_parrotFrames.size() > 0) {
                             for (auto& pkt : m_parrotFrames) {
@@ -291,8 +291,8 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
         }
 
         // is this a parrot talkgroup?
-        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-        if (tg.config().parrot()) {
+        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+        if (tg->config().parrot()) {
             uint8_t *copy = new uint8_t[len];
             ::memcpy(copy, buffer, len);
 
@@ -321,91 +321,70 @@ bool TagP25Data::processFrame(const uint8_t* data, uint32_t len, uint32_t peerId
 
         m_status[dstId].lastPacket = hrc::now();
 
-        // repeat traffic to the connected peers
-        if (m_network->m_peers.size() > 0U) {
-            uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
-                if (peerId != peer.first) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(peer.first, control, duid, streamId)) {
-                        continue;
-                    }
+        // resolve the routing plan for this call stream
+        std::shared_ptr<const RoutePlan> plan = routePlan(buffer, peerId, control, duid, streamId);
 
-                    // process TSDU to peer
-                    if (!processTSDUTo(buffer, peer.first, duid)) {
-                        continue;
-                    }
-
-                    // every 5 peers flush the queue
-                    if (i % 5U == 0U) {
-                        m_network->m_frameQueue->flushQueue();
-                    }
+        // repeat traffic to the connected peers
+        if (plan->peers().size() > 0U) {
+            // the frame is encoded once, and only patched per peer
+            FanoutFrame fanout;
 
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+            for (const RouteDestination& dest : plan->peers()) {
+                if (dest.rewrite && duid == DUID::TSDU) {
+                    // rewritten TSDUs must have the TSBK regenerated, and cannot be patched
+                    PacketBuffer __outboundPeerBuffer = PacketBuffer::copyOf(buffer, len);
+                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.data();
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, peer.first, duid, dstId);
+                    routeRewrite(outboundPeerBuffer, dest.peerId, duid, dstId);
 
-                    m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId, true);
-                    if (m_network->m_debug) {
-                        LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
-                            peerId, peer.first, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId, external);
-                    }
+                    m_network->writePeer(dest.peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId, true);
+                }
+                else {
+                    m_network->writePeerFanout(dest.peerId, fanout, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, buffer, len, pktSeq, streamId,
+                        dest.rewrite ? dest.rewriteDstId : 0U);
+                }
 
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
-                    i++;
+                if (m_network->m_debug) {
+                    LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
+                        peerId, dest.peerId, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId, external);
                 }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
             m_network->m_frameQueue->flushQueue();
         }
 
         // repeat traffic to external peers
-        if (m_network->m_host->m_peerNetworks.size() > 0U && !tg.config().parrot()) {
-            for (auto peer : m_network->m_host->m_peerNetworks) {
-                uint32_t dstPeerId = peer.second->getPeerId();
-
-                // don't try to repeat traffic to the source peer...if this traffic
-                // is coming from a external peer
-                if (dstPeerId != peerId) {
-                    // is this peer ignored?
-                    if (!isPeerPermitted(dstPeerId, control, duid, streamId, true)) {
-                        continue;
-                    }
-
-                    // check if the source peer is blocked from sending to this peer
-                    if (peer.second->checkBlockedPeer(peerId)) {
-                        continue;
-                    }
-
-                    // skip peer if it isn't enabled
-                    if (!peer.second->isEnabled()) {
-                        continue;
-                    }
+        if (plan->externalPeers().size() > 0U && !tg->config().parrot()) {
+            for (const RouteDestination& dest : plan->externalPeers()) {
+                // skip peer if it isn't enabled
+                if (!dest.peerNetwork->isEnabled()) {
+                    continue;
+                }
 
-                    UInt8Array __outboundPeerBuffer = std::make_unique<uint8_t[]>(len);
-                    uint8_t* outboundPeerBuffer = __outboundPeerBuffer.get();
-                    ::memset(outboundPeerBuffer, 0x00U, len);
-                    ::memcpy(outboundPeerBuffer, buffer, len);
+                PacketBuffer __outboundPeerBuffer = PacketBuffer::copyOf(buffer, len);
+                uint8_t* outboundPeerBuffer = __outboundPeerBuffer.data();
 
-                    // perform TGID route rewrites if configured
-                    routeRewrite(outboundPeerBuffer, dstPeerId, duid, dstId);
+                // perform TGID route rewrites if configured
+                if (duid == DUID::TSDU) {
+                    routeRewrite(outboundPeerBuffer, dest.peerId, duid, dstId);
+                }
+                else if (dest.rewrite) {
+                    __SET_UINT16(dest.rewriteDstId, outboundPeerBuffer, 8U);
+                }
 
-                    // process TSDUs going to external peers
-                    if (processTSDUToExternal(outboundPeerBuffer, peerId, dstPeerId, duid)) {
-                        peer.second->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId);
-                        if (m_network->m_debug) {
-                            LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
-                                peerId, dstPeerId, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId, external);
-                        }
+                // process TSDUs going to external peers
+                if (processTSDUToExternal(outboundPeerBuffer, peerId, dest.peerId, duid)) {
+                    dest.peerNetwork->writeMaster({ NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, outboundPeerBuffer, len, pktSeq, streamId);
+                    if (m_network->m_debug) {
+                        LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, lco = $%02X, MFId = $%02X, srcId = %u, dstId = %u, len = %u, pktSeq = %u, streamId = %u, external = %u", 
+                            peerId, dest.peerId, duid, lco, MFId, srcId, dstId, len, pktSeq, streamId, external);
                     }
-
-                    if (!m_network->m_callInProgress)
-                        m_network->m_callInProgress = true;
                 }
+
+                if (!m_network->m_callInProgress)
+                    m_network->m_callInProgress = true;
             }
         }
 
@@ -439,22 +418,23 @@ bool TagP25Data::processGrantReq(uint32_t srcId, uint32_t dstId, bool unitToUnit
         }
     }
 
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
+    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
 
     // check TGID validity
-    if (tg.isInvalid()) {
+    if (tg->isInvalid()) {
         return false;
     }
 
-    if (!tg.config().active()) {
+    if (!tg->config().active()) {
         return false;
     } 
 
     // repeat traffic to the connected peers
-    if (m_network->m_peers.size() > 0U) {
-        for (auto peer : m_network->m_peers) {
-            if (peerId != peer.first) {
-                write_TSDU_Grant(peer.first, srcId, dstId, 4U, !unitToUnit);
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    if (peers->size() > 0U) {
+        for (const PeerEntry& peer : *peers) {
+            if (peerId != peer.peerId) {
+                write_TSDU_Grant(peer.peerId, srcId, dstId, 4U, !unitToUnit);
             }
         }
     }
@@ -499,9 +479,10 @@ void TagP25Data::playbackParrot()
                             RTP_END_OF_CALL_SEQ, m_network->createStreamId(), false);
                     } else {
                         // repeat traffic to the connected peers
-                        for (auto peer : m_network->m_peers) {
-                            LogMessage(LOG_NET, "P25, Parrot Grant Demand, peer = %u, srcId = %u, dstId = %u", peer.first, srcId, dstId);
-                            m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, 
+                        PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+                        for (const PeerEntry& peer : *peers) {
+                            LogMessage(LOG_NET, "P25, Parrot Grant Demand, peer = %u, srcId = %u, dstId = %u", peer.peerId, srcId, dstId);
+                            m_network->writePeer(peer.peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, 
                                 RTP_END_OF_CALL_SEQ, m_network->createStreamId(), false);
                         }
                     }
@@ -519,11 +500,12 @@ void TagP25Data::playbackParrot()
             }
         } else {
             // repeat traffic to the connected peers
-            for (auto peer : m_network->m_peers) {
-                m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
+            PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+            for (const PeerEntry& peer : *peers) {
+                m_network->writePeer(peer.peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, pkt.buffer, pkt.bufferLen, pkt.pktSeq, pkt.streamId, false);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "P25, parrot, dstPeer = %u, len = %u, pktSeq = %u, streamId = %u", 
-                        peer.first, pkt.bufferLen, pkt.pktSeq, pkt.streamId);
+                        peer.peerId, pkt.bufferLen, pkt.pktSeq, pkt.streamId);
                 }
             }
         }
@@ -674,7 +656,7 @@ void TagP25Data::routeRewrite(uint8_t* buffer, uint32_t peerId, uint8_t duid, ui
 
 bool TagP25Data::peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound)
 {
-    lookups::TalkgroupRuleGroupVoice tg;
+    lookups::TalkgroupRuleGroupVoiceHandle tg;
     if (outbound) {
         tg = m_network->m_tidLookup->find(dstId);
     }
@@ -682,15 +664,15 @@ bool TagP25Data::peerRewrite(uint32_t peerId, uint32_t& dstId, bool outbound)
         tg = m_network->m_tidLookup->findByRewrite(peerId, dstId);
     }
 
-    if (tg.config().rewriteSize() > 0) {
-        std::vector<lookups::TalkgroupRuleRewrite> rewrites = tg.config().rewrite();
+    if (tg->config().rewriteSize() > 0) {
+        const std::vector<lookups::TalkgroupRuleRewrite>& rewrites = tg->config().rewrite();
         for (auto entry : rewrites) {
             if (entry.peerId() == peerId) {
                 if (outbound) {
                     dstId = entry.tgId();
                 }
                 else {
-                    dstId = tg.source().tgId();
+                    dstId = tg->source().tgId();
                 }
                 return true;
             }
@@ -731,7 +713,7 @@ bool TagP25Data::processTSDUFrom(uint8_t* buffer, uint32_t peerId, uint8_t duid)
                             .tag("tsbk", tsbk->toString())
                                 .field("raw", ss.str())
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
             }
 
@@ -813,9 +795,10 @@ bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
             //uint32_t srcId = tsbk->getSrcId();
             uint32_t dstId = tsbk->getDstId();
 
+            PeerTable::Snapshot peers = m_network->m_peers.snapshot();
             FNEPeerConnection* connection = nullptr;
-            if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
-                connection = m_network->m_peers[peerId];
+            if (peerId > 0) {
+                connection = peers->find(peerId);
             }
 
             // handle standard P25 reference opcodes
@@ -823,8 +806,8 @@ bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
             case TSBKO::IOSP_GRP_VCH:
                 {
                     if (m_network->m_restrictGrantToAffOnly) {
-                        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(dstId);
-                        if (tg.config().affiliated()) {
+                        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(dstId);
+                        if (tg->config().affiliated()) {
                             uint32_t lookupPeerId = peerId;
                             if (connection != nullptr) {
                                 if (connection->ccPeerId() > 0U)
@@ -832,7 +815,7 @@ bool TagP25Data::processTSDUTo(uint8_t* buffer, uint32_t peerId, uint8_t duid)
                             }
 
                             // check the affiliations for this peer to see if we can repeat the TSDU
-                            lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[lookupPeerId];
+                            lookups::AffiliationLookup* aff = peers->findAffiliations(lookupPeerId);
                             if (aff == nullptr) {
                                 std::string peerIdentity = m_network->resolvePeerIdentity(lookupPeerId);
                                 //LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", lookupPeerId, peerIdentity.c_str());
@@ -906,6 +889,81 @@ bool TagP25Data::processTSDUToExternal(uint8_t* buffer, uint32_t srcPeerId, uint
     return true;
 }
 
+/* Helper to resolve the routing plan for a call stream. */
+
+std::shared_ptr<const RoutePlan> TagP25Data::routePlan(uint8_t* buffer, uint32_t peerId, lc::LC& control, DUID::E duid, uint32_t streamId)
+{
+    uint32_t dstId = control.getDstId();
+    bool group = control.getLCO() != LCO::PRIVATE;
+    uint64_t generation = m_network->routeGeneration();
+
+    // only voice frames are routed identically for the entire call stream; headers, terminators and
+    // TSDUs are always routed individually
+    bool voice = (duid != DUID::TSDU && duid != DUID::PDU && duid != DUID::HDU && duid != DUID::TDU && duid != DUID::TDULC);
+    if (voice) {
+        std::shared_ptr<const RoutePlan> plan = m_routePlans.find(dstId, 0U, streamId, peerId, group, generation);
+        if (plan != nullptr)
+            return plan;
+    }
+
+    std::shared_ptr<RoutePlan> plan = std::make_shared<RoutePlan>(streamId, peerId, group, generation);
+
+    // determine the connected peers permitted to receive this call stream
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    for (const PeerEntry& peer : *peers) {
+        if (peerId == peer.peerId)
+            continue;
+
+        // is this peer ignored?
+        if (!isPeerPermitted(peer.peerId, control, duid, streamId)) {
+            continue;
+        }
+
+        // process TSDU to peer
+        if (!processTSDUTo(buffer, peer.peerId, duid)) {
+            continue;
+        }
+
+        // determine TGID route rewrites if configured
+        uint32_t rewriteDstId = dstId;
+        bool rewrite = peerRewrite(peer.peerId, rewriteDstId);
+
+        plan->addPeer(peer.peerId, rewrite, rewriteDstId);
+    }
+
+    // determine the external peers permitted to receive this call stream
+    for (auto peer : m_network->m_host->m_peerNetworks) {
+        uint32_t dstPeerId = peer.second->getPeerId();
+
+        // don't try to repeat traffic to the source peer...if this traffic
+        // is coming from a external peer
+        if (dstPeerId == peerId)
+            continue;
+
+        // is this peer ignored?
+        if (!isPeerPermitted(dstPeerId, control, duid, streamId, true)) {
+            continue;
+        }
+
+        // check if the source peer is blocked from sending to this peer
+        if (peer.second->checkBlockedPeer(peerId)) {
+            continue;
+        }
+
+        // determine TGID route rewrites if configured
+        uint32_t rewriteDstId = dstId;
+        bool rewrite = peerRewrite(dstPeerId, rewriteDstId);
+
+        plan->addExternalPeer(dstPeerId, peer.second, rewrite, rewriteDstId);
+    }
+
+    if (voice) {
+        m_routePlans.add(dstId, 0U, plan);
+    }
+
+    return plan;
+}
+
 /* Helper to determine if the peer is permitted for traffic. */
 
 bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid, uint32_t streamId, bool external)
@@ -926,13 +984,13 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
         if (m_network->m_filterHeaders) {
             if (control.getSrcId() != 0U && control.getDstId() != 0U) {
                 // is this a group call?
-                lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-                if (!tg.isInvalid()) {
+                lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(control.getDstId());
+                if (!tg->isInvalid()) {
                     return true;
                 }
 
                 tg = m_network->m_tidLookup->findByRewrite(peerId, control.getDstId());
-                if (!tg.isInvalid()) {
+                if (!tg->isInvalid()) {
                     return true;
                 }
 
@@ -959,13 +1017,13 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
         if (m_network->m_filterTerminators) {
             if (/*control.getSrcId() != 0U &&*/control.getDstId() != 0U) {
                 // is this a group call?
-                lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-                if (!tg.isInvalid()) {
+                lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(control.getDstId());
+                if (!tg->isInvalid()) {
                     return true;
                 }
 
                 tg = m_network->m_tidLookup->findByRewrite(peerId, control.getDstId());
-                if (!tg.isInvalid()) {
+                if (!tg->isInvalid()) {
                     return true;
                 }
 
@@ -984,39 +1042,29 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
     }
 
     // is this a group call?
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-
-    std::vector<uint32_t> inclusion = tg.config().inclusion();
-    std::vector<uint32_t> exclusion = tg.config().exclusion();
+    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(control.getDstId());
 
     // peer inclusion lists take priority over exclusion lists
-    if (inclusion.size() > 0) {
-        auto it = std::find(inclusion.begin(), inclusion.end(), peerId);
-        if (it == inclusion.end()) {
+    if (!tg->config().inclusion().empty()) {
+        if (!tg->config().isIncluded(peerId)) {
             return false;
         }
     }
     else {
-        if (exclusion.size() > 0) {
-            auto it = std::find(exclusion.begin(), exclusion.end(), peerId);
-            if (it != exclusion.end()) {
-                return false;
-            }
+        if (tg->config().isExcluded(peerId)) {
+            return false;
         }
     }
 
     // peer always send list takes priority over any following affiliation rules
-    std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-    if (alwaysSend.size() > 0) {
-        auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-        if (it != alwaysSend.end()) {
-            return true; // skip any following checks and always send traffic
-        }
+    if (tg->config().isAlwaysSend(peerId)) {
+        return true; // skip any following checks and always send traffic
     }
 
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
     FNEPeerConnection* connection = nullptr;
-    if (peerId > 0 && (m_network->m_peers.find(peerId) != m_network->m_peers.end())) {
-        connection = m_network->m_peers[peerId];
+    if (peerId > 0) {
+        connection = peers->find(peerId);
     }
 
     // is this peer a conventional peer?
@@ -1039,7 +1087,7 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
 
     // is this a TG that requires affiliations to repeat?
     // NOTE: external peers *always* repeat traffic regardless of affiliation
-    if (tg.config().affiliated() && !external) {
+    if (tg->config().affiliated() && !external) {
         uint32_t lookupPeerId = peerId;
         if (connection != nullptr) {
             if (connection->ccPeerId() > 0U)
@@ -1047,7 +1095,7 @@ bool TagP25Data::isPeerPermitted(uint32_t peerId, lc::LC& control, DUID::E duid,
         }
 
         // check the affiliations for this peer to see if we can repeat traffic
-        lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[lookupPeerId];
+        lookups::AffiliationLookup* aff = peers->findAffiliations(lookupPeerId);
         if (aff == nullptr) {
             std::string peerIdentity = m_network->resolvePeerIdentity(lookupPeerId);
             //LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", lookupPeerId, peerIdentity.c_str());
@@ -1090,7 +1138,7 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
                             .tag("dstId", std::to_string(control.getDstId()))
                                 .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 // report In-Call Control to the peer sending traffic
@@ -1115,13 +1163,13 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
     if (m_network->m_filterTerminators) {
         if ((duid == DUID::TDU || duid == DUID::TDULC) && control.getDstId() != 0U) {
             // is this a group call?
-            lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-            if (!tg.isInvalid()) {
+            lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(control.getDstId());
+            if (!tg->isInvalid()) {
                 return true;
             }
 
             tg = m_network->m_tidLookup->findByRewrite(peerId, control.getDstId());
-            if (!tg.isInvalid()) {
+            if (!tg->isInvalid()) {
                 return true;
             }
 
@@ -1158,7 +1206,7 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
                             .tag("dstId", std::to_string(control.getDstId()))
                                 .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_DST_RID))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 // report In-Call Control to the peer sending traffic
@@ -1180,7 +1228,7 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
                             .tag("dstId", std::to_string(control.getDstId()))
                                 .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 LogWarning(LOG_NET, "P25, illegal/unknown RID attempted access, srcId = %u, dstId = %u", control.getSrcId(), control.getDstId());
@@ -1204,14 +1252,14 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
             switch (tsbk->getLCO()) {
                 case TSBKO::IOSP_GRP_VCH:
                 {
-                    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(tsbk->getDstId());
+                    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(tsbk->getDstId());
 
                     // check TGID validity
-                    if (tg.isInvalid()) {
+                    if (tg->isInvalid()) {
                         return false;
                     }
 
-                    if (!tg.config().active()) {
+                    if (!tg->config().active()) {
                         return false;
                     }
                 }
@@ -1223,14 +1271,14 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
                 switch (tsbk->getLCO()) {
                     case LCO::CALL_TERM:
                     {
-                        lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(tsbk->getDstId());
+                        lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(tsbk->getDstId());
 
                         // check TGID validity
-                        if (tg.isInvalid()) {
+                        if (tg->isInvalid()) {
                             return false;
                         }
 
-                        if (!tg.config().active()) {
+                        if (!tg->config().active()) {
                             return false;
                         }
                     }
@@ -1243,8 +1291,8 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
     }
 
     // check TGID validity
-    lookups::TalkgroupRuleGroupVoice tg = m_network->m_tidLookup->find(control.getDstId());
-    if (tg.isInvalid()) {
+    lookups::TalkgroupRuleGroupVoiceHandle tg = m_network->m_tidLookup->find(control.getDstId());
+    if (tg->isInvalid()) {
         //LogDebugEx(LOG_NET, "TagP25Data::validate()", "dstId = %u, invalid dropped", control.getDstId());
         // report error event to InfluxDB
         if (m_network->m_enableInfluxDB) {
@@ -1256,7 +1304,7 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
                     .tag("dstId", std::to_string(control.getDstId()))
                         .field("message", std::string(INFLUXDB_ERRSTR_INV_TALKGROUP))
                     .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                .requestAsync(m_network->m_influxServer);
+                .requestAsync(m_network->m_influxWriter);
         }
 
         // report In-Call Control to the peer sending traffic
@@ -1266,13 +1314,9 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
 
     // peer always send list takes priority over any following affiliation rules
     bool isAlwaysPeer = false;
-    std::vector<uint32_t> alwaysSend = tg.config().alwaysSend();
-    if (alwaysSend.size() > 0) {
-        auto it = std::find(alwaysSend.begin(), alwaysSend.end(), peerId);
-        if (it != alwaysSend.end()) {
-            isAlwaysPeer = true; // skip any following checks and always send traffic
-            rejectUnknownBadCall = false;
-        }
+    if (tg->config().isAlwaysSend(peerId)) {
+        isAlwaysPeer = true; // skip any following checks and always send traffic
+        rejectUnknownBadCall = false;
     }
 
     // fail call if the reject flag is set
@@ -1287,7 +1331,7 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
                     .tag("dstId", std::to_string(control.getDstId()))
                         .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_SRC_RID))
                     .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                .requestAsync(m_network->m_influxServer);
+                .requestAsync(m_network->m_influxWriter);
         }
 
         LogWarning(LOG_NET, "P25, illegal/unknown RID attempted access, srcId = %u, dstId = %u", control.getSrcId(), control.getDstId());
@@ -1298,7 +1342,7 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
     }
 
     // is the TGID active?
-    if (!tg.config().active()) {
+    if (!tg->config().active()) {
         // report error event to InfluxDB
         if (m_network->m_enableInfluxDB) {
             influxdb::QueryBuilder()
@@ -1309,7 +1353,7 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
                     .tag("dstId", std::to_string(control.getDstId()))
                         .field("message", std::string(INFLUXDB_ERRSTR_DISABLED_TALKGROUP))
                     .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                .requestAsync(m_network->m_influxServer);
+                .requestAsync(m_network->m_influxWriter);
         }
 
         // report In-Call Control to the peer sending traffic
@@ -1320,10 +1364,9 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
     // always peers can violate the rules...hurray
     if (!isAlwaysPeer) {
         // does the TGID have a permitted RID list?
-        if (tg.config().permittedRIDs().size() > 0) {
+        if (!tg->config().permittedRIDs().empty()) {
             // does the transmitting RID have permission?
-            std::vector<uint32_t> permittedRIDs = tg.config().permittedRIDs();
-            if (std::find(permittedRIDs.begin(), permittedRIDs.end(), control.getSrcId()) == permittedRIDs.end()) {
+            if (!tg->config().isRIDPermitted(control.getSrcId())) {
                 // report error event to InfluxDB
                 if (m_network->m_enableInfluxDB) {
                     influxdb::QueryBuilder()
@@ -1334,7 +1377,7 @@ bool TagP25Data::validate(uint32_t peerId, lc::LC& control, DUID::E duid, const
                             .tag("dstId", std::to_string(control.getDstId()))
                                 .field("message", std::string(INFLUXDB_ERRSTR_RID_NOT_PERMITTED))
                             .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                        .requestAsync(m_network->m_influxServer);
+                        .requestAsync(m_network->m_influxWriter);
                 }
 
                 // report In-Call Control to the peer sending traffic
@@ -1360,7 +1403,8 @@ bool TagP25Data::write_TSDU_Grant(uint32_t peerId, uint32_t srcId, uint32_t dstI
     }
 
     // check the affiliations for this peer to see if we can grant traffic
-    lookups::AffiliationLookup* aff = m_network->m_peerAffiliations[peerId];
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    lookups::AffiliationLookup* aff = peers->findAffiliations(peerId);
     if (aff == nullptr) {
         std::string peerIdentity = m_network->resolvePeerIdentity(peerId);
         LogError(LOG_NET, "PEER %u (%s) has an invalid affiliations lookup? This shouldn't happen BUGBUG.", peerId, peerIdentity.c_str());
@@ -1496,21 +1540,18 @@ void TagP25Data::write_TSDU(uint32_t peerId, lc::TSBK* tsbk)
             RTP_END_OF_CALL_SEQ, streamId, false);
     } else {
         // repeat traffic to the connected peers
-        if (m_network->m_peers.size() > 0U) {
-            uint32_t i = 0U;
-            for (auto peer : m_network->m_peers) {
-                // every 5 peers flush the queue
-                if (i % 5U == 0U) {
-                    m_network->m_frameQueue->flushQueue();
-                }
-
-                m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, 
-                    RTP_END_OF_CALL_SEQ, streamId, true);
+        PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+        if (peers->size() > 0U) {
+            // the frame is encoded once, and only patched per peer
+            FanoutFrame fanout;
+
+            for (const PeerEntry& peer : *peers) {
+                m_network->writePeerFanout(peer.peerId, fanout, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, message.get(), messageLength, 
+                    RTP_END_OF_CALL_SEQ, streamId);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "P25, peer = %u, len = %u, streamId = %u", 
-                        peer.first, messageLength, streamId);
+                        peer.peerId, messageLength, streamId);
                 }
-                i++;
             }
             m_network->m_frameQueue->flushQueue();
         }
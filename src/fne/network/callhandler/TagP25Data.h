@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  * 
- *  Copyright (C) 2023-2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2023-2025 Bryan Biedenkapp, N2PLL
  *
  */
 /**
@@ -28,6 +28,7 @@
 #include "common/p25/lc/TDULC.h"
 #include "network/FNENetwork.h"
 #include "network/callhandler/packetdata/P25PacketData.h"
+#include "network/callhandler/RoutePlan.h"
 
 #include <deque>
 
@@ -211,6 +212,8 @@ namespace network
             typedef std::pair<const uint32_t, RxStatus> StatusMapPair;
             std::unordered_map<uint32_t, RxStatus> m_status;
 
+            RoutePlanCache m_routePlans;
+
             friend class packetdata::P25PacketData;
             packetdata::P25PacketData* m_packetData;
 
@@ -260,6 +263,18 @@ namespace network
              */
             bool processTSDUToExternal(uint8_t* buffer, uint32_t srcPeerId, uint32_t dstPeerId, uint8_t duid);
 
+            /**
+             * @brief Helper to resolve the routing plan for a call stream.
+             *  (Voice frames reuse a cached plan for the entire call stream, all other frames are planned individually.)
+             * @param buffer Frame buffer.
+             * @param peerId Source Peer ID.
+             * @param control Instance of p25::lc::LC.
+             * @param duid DUID.
+             * @param streamId Stream ID.
+             * @returns std::shared_ptr<const RoutePlan> Routing plan.
+             */
+            std::shared_ptr<const RoutePlan> routePlan(uint8_t* buffer, uint32_t peerId, p25::lc::LC& control, P25DEF::DUID::E duid, uint32_t streamId);
+
             /**
              * @brief Helper to determine if the peer is permitted for traffic.
              * @param peerId Peer ID.
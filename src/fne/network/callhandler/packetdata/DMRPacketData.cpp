@@ -226,7 +226,7 @@ bool DMRPacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
                             .field("duration", duration)
                             .field("slot", slotNo)
                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                    .requestAsync(m_network->m_influxServer);
+                    .requestAsync(m_network->m_influxWriter);
             }
 
             delete status;
@@ -269,29 +269,24 @@ void DMRPacketData::dispatchToFNE(uint32_t peerId, dmr::data::NetData& dmrData,
     uint32_t dstId = status->header.getDstId();
 
     // repeat traffic to the connected peers
-    if (m_network->m_peers.size() > 0U) {
-        uint32_t i = 0U;
-        for (auto peer : m_network->m_peers) {
-            if (peerId != peer.first) {
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    if (peers->size() > 0U) {
+        for (const PeerEntry& peer : *peers) {
+            if (peerId != peer.peerId) {
                 // is this peer ignored?
-                if (!m_tag->isPeerPermitted(peer.first, dmrData, streamId)) {
+                if (!m_tag->isPeerPermitted(peer.peerId, dmrData, streamId)) {
                     continue;
                 }
 
-                // every 5 peers flush the queue
-                if (i % 5U == 0U) {
-                    m_network->m_frameQueue->flushQueue();
-                }
 
-                m_network->writePeer(peer.first, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, data, len, pktSeq, streamId, true);
+                m_network->writePeer(peer.peerId, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, data, len, pktSeq, streamId, true);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "DMR, srcPeer = %u, dstPeer = %u, seqNo = %u, srcId = %u, dstId = %u, slotNo = %u, len = %u, pktSeq = %u, stream = %u", 
-                        peerId, peer.first, seqNo, srcId, dstId, status->slotNo, len, pktSeq, streamId);
+                        peerId, peer.peerId, seqNo, srcId, dstId, status->slotNo, len, pktSeq, streamId);
                 }
 
                 if (!m_network->m_callInProgress)
                     m_network->m_callInProgress = true;
-                i++;
             }
         }
         m_network->m_frameQueue->flushQueue();
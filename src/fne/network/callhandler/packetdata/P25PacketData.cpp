@@ -177,7 +177,7 @@ bool P25PacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
                         .tag("dstId", std::to_string(status->header.getLLId()))
                             .field("message", INFLUXDB_ERRSTR_DISABLED_SRC_RID)
                         .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                    .requestAsync(m_network->m_influxServer);
+                    .requestAsync(m_network->m_influxWriter);
             }
 
             delete status;
@@ -318,7 +318,7 @@ bool P25PacketData::processFrame(const uint8_t* data, uint32_t len, uint32_t pee
                     .tag("dstId", std::to_string(dstId))
                         .field("duration", duration)
                     .timestamp(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count())
-                .requestAsync(m_network->m_influxServer);
+                .requestAsync(m_network->m_influxWriter);
         }
 
         delete status;
@@ -688,22 +688,15 @@ void P25PacketData::dispatchToFNE(uint32_t peerId)
     uint32_t dstId = status->header.getLLId();
 
     // repeat traffic to the connected peers
-    if (m_network->m_peers.size() > 0U) {
-        uint32_t i = 0U;
-        for (auto peer : m_network->m_peers) {
-            if (peerId != peer.first) {
-                // every 2 peers flush the queue
-                if (i % 2U == 0U) {
-                    m_network->m_frameQueue->flushQueue();
-                }
-
-                write_PDU_User(peer.first, nullptr, status->header, status->extendedAddress, status->pduUserData, true);
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    if (peers->size() > 0U) {
+        for (const PeerEntry& peer : *peers) {
+            if (peerId != peer.peerId) {
+                write_PDU_User(peer.peerId, nullptr, status->header, status->extendedAddress, status->pduUserData, true);
                 if (m_network->m_debug) {
                     LogDebug(LOG_NET, "P25, srcPeer = %u, dstPeer = %u, duid = $%02X, srcId = %u, dstId = %u", 
-                        peerId, peer.first, DUID::PDU, srcId, dstId);
+                        peerId, peer.peerId, DUID::PDU, srcId, dstId);
                 }
-
-                i++;
             }
         }
         m_network->m_frameQueue->flushQueue();
@@ -756,21 +749,14 @@ void P25PacketData::dispatchUserFrameToFNE(p25::data::DataHeader& dataHeader, bo
     m_suSendSeq[srcId] = sendSeqNo;
 
     // repeat traffic to the connected peers
-    if (m_network->m_peers.size() > 0U) {
-        uint32_t i = 0U;
-        for (auto peer : m_network->m_peers) {
-            // every 2 peers flush the queue
-            if (i % 2U == 0U) {
-                m_network->m_frameQueue->flushQueue();
-            }
-
-            write_PDU_User(peer.first, nullptr, dataHeader, extendedAddress, pduUserData, true);
+    PeerTable::Snapshot peers = m_network->m_peers.snapshot();
+    if (peers->size() > 0U) {
+        for (const PeerEntry& peer : *peers) {
+            write_PDU_User(peer.peerId, nullptr, dataHeader, extendedAddress, pduUserData, true);
             if (m_network->m_debug) {
                 LogDebug(LOG_NET, "P25, dstPeer = %u, duid = $%02X, srcId = %u, dstId = %u", 
-                    peer.first, DUID::PDU, srcId, dstId);
+                    peer.peerId, DUID::PDU, srcId, dstId);
             }
-
-            i++;
         }
         m_network->m_frameQueue->flushQueue();
     }
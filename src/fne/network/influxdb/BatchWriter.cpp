@@ -0,0 +1,639 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "common/Log.h"
+#include "fne/network/influxdb/BatchWriter.h"
+
+using namespace network::influxdb;
+
+#if !defined(_WIN32)
+#include <netinet/tcp.h>
+#endif // !defined(_WIN32)
+
+#include <chrono>
+#include <cstring>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define INFLUX_WRITER_SOCKET_TIMEOUT 5
+#define INFLUX_WRITER_MAX_HEADER_LEN 16384U
+
+#if defined(MSG_NOSIGNAL)
+#define INFLUX_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define INFLUX_SEND_FLAGS 0
+#endif // defined(MSG_NOSIGNAL)
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to get the current monotonic time in milliseconds. */
+
+static uint64_t writerNow()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Helper to write an entire buffer to a socket. */
+
+static bool sendAll(int fd, const char* data, size_t length)
+{
+    while (length > 0U) {
+        ssize_t ret = ::send(fd, data, length, INFLUX_SEND_FLAGS);
+        if (ret <= 0) {
+            if (ret < 0 && errno == EINTR)
+                continue;
+            return false;
+        }
+
+        data += ret;
+        length -= (size_t)ret;
+    }
+
+    return true;
+}
+
+/* Helper to read more data from a socket onto the end of a buffer. */
+
+static bool recvMore(int fd, std::string& buffer)
+{
+    char data[4096];
+    while (true) {
+        ssize_t ret = ::recv(fd, data, sizeof(data), 0);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+            return false;
+
+        buffer.append(data, (size_t)ret);
+        return true;
+    }
+}
+
+/* Helper to find a HTTP header value (case insensitive) in a response header block. */
+
+static bool findHeader(const std::string& headers, const char* name, std::string& value)
+{
+    size_t nameLen = ::strlen(name);
+    size_t pos = headers.find("\r\n");
+    while (pos != std::string::npos && pos + 2U < headers.length()) {
+        size_t start = pos + 2U;
+        size_t end = headers.find("\r\n", start);
+        if (end == std::string::npos)
+            end = headers.length();
+
+        if (end - start > nameLen && headers[start + nameLen] == ':' && ::strncasecmp(headers.c_str() + start, name, nameLen) == 0) {
+            size_t valueStart = headers.find_first_not_of(' ', start + nameLen + 1U);
+            value = (valueStart < end) ? headers.substr(valueStart, end - valueStart) : std::string();
+            return true;
+        }
+
+        pos = end;
+    }
+
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the BatchWriter class. */
+
+BatchWriter::BatchWriter(const ServerInfo& si, uint32_t queueDepth, uint32_t batchLines, uint32_t flushIntervalMs) : Thread(),
+    m_si(si),
+    m_path(),
+    m_batchLines(batchLines),
+    m_flushIntervalMs(flushIntervalMs),
+    m_slots(nullptr),
+    m_mask(0U),
+    m_enqueuePos(0U),
+    m_dequeuePos(0U),
+    m_pending(0U),
+    m_mutex(),
+    m_cond(),
+    m_running(false),
+    m_fd(-1),
+    m_addr(),
+    m_addrLen(0U),
+    m_resolvedAt(0U),
+    m_retryAt(0U),
+    m_retryDelayMs(0U),
+    m_retryBody(),
+    m_retryRecords(0U),
+    m_queued(0U),
+    m_sent(0U),
+    m_dropped(0U),
+    m_writes(0U),
+    m_writeErrors(0U),
+    m_connects(0U)
+{
+    if (queueDepth == 0U)
+        queueDepth = INFLUX_WRITER_QUEUE_DEPTH;
+    if (m_batchLines == 0U)
+        m_batchLines = 1U;
+    if (m_flushIntervalMs == 0U)
+        m_flushIntervalMs = INFLUX_WRITER_FLUSH_INTERVAL_MS;
+
+    // the queue length must be a power of 2, so positions can be masked onto slots
+    uint64_t slotCnt = 2U;
+    while (slotCnt < queueDepth)
+        slotCnt <<= 1;
+
+    m_mask = slotCnt - 1U;
+    m_slots = new Slot[slotCnt];
+    for (uint64_t i = 0U; i < slotCnt; i++)
+        m_slots[i].seq.store(i, std::memory_order_relaxed);
+
+    m_retryDelayMs = m_flushIntervalMs;
+    m_path = "/api/v2/write?org=" + si.org() + "&bucket=" + si.bucket();
+    ::memset(&m_addr, 0x00U, sizeof(m_addr));
+}
+
+/* Finalizes a instance of the BatchWriter class. */
+
+BatchWriter::~BatchWriter()
+{
+    stop();
+    delete[] m_slots;
+}
+
+/* Starts the writer thread. */
+
+bool BatchWriter::start()
+{
+    if (m_running.load())
+        return true;
+
+    m_running.store(true);
+    if (!run()) {
+        m_running.store(false);
+        LogError(LOG_HOST, "Failed to start InfluxDB writer");
+        return false;
+    }
+
+    setName("fluxql:writer");
+    return true;
+}
+
+/* Signals the writer to stop, and waits for it to exit. */
+
+void BatchWriter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running.load())
+            return;
+        m_running.store(false);
+    }
+
+    m_cond.notify_all();
+    wait();
+}
+
+/* Queues line protocol records for writing. */
+
+bool BatchWriter::enqueue(const std::string& lines)
+{
+    // claim a slot; a slot is free when its sequence matches the position claiming it, and the
+    // queue is full when the slot still holds a record from the previous lap
+    uint64_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    bool full = false;
+    while (true) {
+        slot = &m_slots[pos & m_mask];
+        int64_t diff = (int64_t)slot->seq.load(std::memory_order_acquire) - (int64_t)pos;
+        if (diff == 0) {
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1U, std::memory_order_relaxed)) {
+                // count the record before it is published, so the writer never dequeues it uncounted
+                full = (m_pending.fetch_add(1U, std::memory_order_relaxed) + 1U == m_batchLines);
+                break;
+            }
+        }
+        else if (diff < 0) {
+            uint64_t dropped = m_dropped.fetch_add(1U, std::memory_order_relaxed);
+            if ((dropped % 1000U) == 0U) {
+                LogWarning(LOG_HOST, "InfluxDB writer queue full, dropping records, dropped = %llu", (unsigned long long)dropped + 1U);
+            }
+
+            return false;
+        }
+        else {
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->lines = lines;
+    slot->seq.store(pos + 1U, std::memory_order_release);
+    m_queued.fetch_add(1U, std::memory_order_relaxed);
+
+    // wake the writer when a full batch is pending; a wakeup lost to the writer just starting to
+    // wait only delays the batch to the flush interval
+    if (full)
+        m_cond.notify_one();
+
+    return true;
+}
+
+/* Thread entry point. */
+
+void BatchWriter::entry()
+{
+    uint64_t lastFlush = writerNow();
+    while (m_running.load()) {
+        uint64_t now = writerNow();
+        uint64_t elapsed = now - lastFlush;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (now < m_retryAt) {
+                // nothing can be written until the server is retried, so pending batches don't wake the writer
+                m_cond.wait_for(lock, std::chrono::milliseconds(m_retryAt - now), [this] { return !m_running.load(); });
+            }
+            else {
+                m_cond.wait_for(lock, std::chrono::milliseconds((elapsed < m_flushIntervalMs) ? m_flushIntervalMs - elapsed : 0U),
+                    [this] { return !m_running.load() || m_pending.load(std::memory_order_relaxed) >= m_batchLines; });
+            }
+        }
+
+        // full batches are written as soon as they are pending, and everything else once the flush
+        // interval passes
+        now = writerNow();
+        bool expired = (now - lastFlush >= m_flushIntervalMs);
+        if (expired)
+            lastFlush = now;
+
+        flush(expired, false);
+    }
+
+    flush(true, true);
+    disconnect();
+}
+
+/* Helper to create a JSON representation of the writer counters. */
+
+json::object BatchWriter::statsObject() const
+{
+    json::object stats = json::object();
+
+    uint64_t queued = m_queued.load();
+    stats["queued"].set<uint64_t>(queued);
+    uint64_t sent = m_sent.load();
+    stats["sent"].set<uint64_t>(sent);
+    uint64_t dropped = m_dropped.load();
+    stats["dropped"].set<uint64_t>(dropped);
+    uint32_t pending = m_pending.load();
+    stats["pending"].set<uint32_t>(pending);
+    uint64_t writes = m_writes.load();
+    stats["writes"].set<uint64_t>(writes);
+    uint64_t writeErrors = m_writeErrors.load();
+    stats["writeErrors"].set<uint64_t>(writeErrors);
+    uint64_t connects = m_connects.load();
+    stats["connects"].set<uint64_t>(connects);
+
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to dequeue a record, if any is pending. */
+
+bool BatchWriter::dequeue(std::string& lines)
+{
+    Slot* slot = &m_slots[m_dequeuePos & m_mask];
+    if ((int64_t)slot->seq.load(std::memory_order_acquire) - (int64_t)(m_dequeuePos + 1U) < 0)
+        return false;
+
+    lines.swap(slot->lines);
+    slot->lines.clear();
+
+    // release the slot to the producer one lap ahead
+    slot->seq.store(m_dequeuePos + m_mask + 1U, std::memory_order_release);
+    m_dequeuePos++;
+
+    // a record is counted before it is published, so the count cannot underflow here
+    m_pending.fetch_sub(1U, std::memory_order_relaxed);
+    return true;
+}
+
+/* Helper to write the pending records to the server, in batches. */
+
+void BatchWriter::flush(bool all, bool final)
+{
+    uint32_t count = m_pending.load(std::memory_order_relaxed);
+    if (!all)
+        count -= count % m_batchLines;
+    if (count == 0U && m_retryBody.empty())
+        return;
+
+    // while the server is unreachable records are left queued; once the queue fills, new records
+    // are dropped at the producer
+    if (!final && writerNow() < m_retryAt)
+        return;
+
+    // a batch held from a failed write goes out ahead of anything queued after it
+    bool failed = false;
+    if (!m_retryBody.empty()) {
+        std::string body;
+        body.swap(m_retryBody);
+        uint32_t records = m_retryRecords;
+        m_retryRecords = 0U;
+
+        if (!write(body, records, final)) {
+            if (!final)
+                return;
+
+            // the writer is stopping; drop whatever is left
+            failed = true;
+        }
+    }
+
+    std::string body;
+    std::string record;
+    uint32_t records = 0U;
+    while (true) {
+        bool more = (count > 0U) && dequeue(record);
+        if (more) {
+            count--;
+
+            // records built with TSCaller::meas() are prefixed with a line break
+            size_t start = record.find_first_not_of('\n');
+            if (start == std::string::npos)
+                continue;
+
+            if (failed) {
+                m_dropped.fetch_add(1U, std::memory_order_relaxed);
+                continue;
+            }
+
+            body.append(record, start, std::string::npos);
+            if (body.back() != '\n')
+                body += '\n';
+            records++;
+        }
+
+        if (records > 0U && (!more || records >= m_batchLines || body.length() >= INFLUX_WRITER_BATCH_BYTES)) {
+            if (!write(body, records, final)) {
+                if (!final)
+                    return;
+
+                // the writer is stopping; drop whatever is left
+                failed = true;
+            }
+
+            body.clear();
+            records = 0U;
+        }
+
+        if (!more)
+            break;
+    }
+}
+
+/* Helper to write a single batch to the server. */
+
+bool BatchWriter::write(std::string& body, uint32_t records, bool final)
+{
+    m_writes.fetch_add(1U, std::memory_order_relaxed);
+
+    // a kept-alive connection may have been closed by the server while idle; retry once on a new one
+    bool reused = (m_fd >= 0);
+    int status = post(body);
+    if (status < 0 && reused) {
+        disconnect();
+        status = post(body);
+    }
+
+    if (status / 100 == 2) {
+        m_sent.fetch_add(records, std::memory_order_relaxed);
+        m_retryDelayMs = m_flushIntervalMs;
+        return true;
+    }
+
+    m_writeErrors.fetch_add(1U, std::memory_order_relaxed);
+
+    // a rejected batch is dropped; a batch failed by an unreachable or overloaded server is held and
+    // written again once the retry delay passes
+    if (status < 0 || status == 429 || status >= 500) {
+        if (final) {
+            LogError(LOG_HOST, "Failed to write to InfluxDB server %s:%u, status = %d, dropping %u records", m_si.host().c_str(), m_si.port(), status, records);
+            m_dropped.fetch_add(records, std::memory_order_relaxed);
+            return false;
+        }
+
+        LogError(LOG_HOST, "Failed to write to InfluxDB server %s:%u, status = %d, retrying in %ums", m_si.host().c_str(), m_si.port(), status, m_retryDelayMs);
+        m_retryAt = writerNow() + m_retryDelayMs;
+        m_retryDelayMs = (m_retryDelayMs * 2U > INFLUX_WRITER_RETRY_MAX_MS) ? INFLUX_WRITER_RETRY_MAX_MS : m_retryDelayMs * 2U;
+
+        m_retryBody.swap(body);
+        m_retryRecords = records;
+        return false;
+    }
+
+    LogError(LOG_HOST, "InfluxDB server %s:%u rejected write, status = %d", m_si.host().c_str(), m_si.port(), status);
+    m_dropped.fetch_add(records, std::memory_order_relaxed);
+    return true;
+}
+
+/* Helper to resolve the server address, if the cached address has expired. */
+
+bool BatchWriter::resolve()
+{
+    uint64_t now = writerNow();
+    if (m_addrLen > 0U && now - m_resolvedAt < INFLUX_WRITER_RESOLVE_INTERVAL_MS)
+        return true;
+
+    struct addrinfo hints, *addr = nullptr;
+    ::memset(&hints, 0x00, sizeof(hints));
+    hints.ai_flags = AI_NUMERICSERV;
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    int ret = ::getaddrinfo(m_si.host().c_str(), std::to_string(m_si.port()).c_str(), &hints, &addr);
+    if (ret != 0 || addr == nullptr) {
+        LogError(LOG_HOST, "Failed to determine InfluxDB server host, err: %d", ret);
+        return false;
+    }
+
+    ::memcpy(&m_addr, addr->ai_addr, addr->ai_addrlen);
+    m_addrLen = (uint32_t)addr->ai_addrlen;
+    m_resolvedAt = now;
+    ::freeaddrinfo(addr);
+    return true;
+}
+
+/* Helper to connect to the server, if not already connected. */
+
+bool BatchWriter::connect()
+{
+    if (m_fd >= 0)
+        return true;
+    if (!resolve())
+        return false;
+
+    int fd = (int)::socket(m_addr.ss_family, SOCK_STREAM, IPPROTO_TCP);
+    if (fd < 0) {
+        LogError(LOG_HOST, "Failed to connect to InfluxDB server, err: %d", errno);
+        return false;
+    }
+
+    // bound the blocking connect, send and receive operations
+#if defined(_WIN32)
+    DWORD timeout = INFLUX_WRITER_SOCKET_TIMEOUT * 1000;
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+    const char noDelay = 1;
+#else
+    struct timeval tv;
+    tv.tv_sec = INFLUX_WRITER_SOCKET_TIMEOUT;
+    tv.tv_usec = 0;
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    const int noDelay = 1;
+#endif // defined(_WIN32)
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    if (::connect(fd, (struct sockaddr*)&m_addr, m_addrLen) < 0) {
+        LogError(LOG_HOST, "Failed to connect to InfluxDB server %s:%u, err: %d", m_si.host().c_str(), m_si.port(), errno);
+        closesocket(fd);
+
+        // the server may have moved; resolve it again on the next attempt
+        m_resolvedAt = 0U;
+        m_addrLen = 0U;
+        return false;
+    }
+
+    m_fd = fd;
+    m_connects.fetch_add(1U, std::memory_order_relaxed);
+    return true;
+}
+
+/* Helper to close the connection to the server. */
+
+void BatchWriter::disconnect()
+{
+    if (m_fd < 0)
+        return;
+
+    closesocket(m_fd);
+    m_fd = -1;
+}
+
+/* Helper to write a batch body to the server, and read the response. */
+
+int BatchWriter::post(const std::string& body)
+{
+    if (!connect())
+        return -1;
+
+    std::string header = "POST " + m_path + " HTTP/1.1\r\nHost: " + m_si.host() + ":" + std::to_string(m_si.port()) +
+        "\r\nConnection: keep-alive\r\n";
+    if (!m_si.token().empty())
+        header += "Authorization: Token " + m_si.token() + "\r\n";
+    header += "Content-Type: text/plain; charset=utf-8\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+
+#ifdef INFLUX_DEBUG
+    LogDebug(LOG_HOST, "InfluxDB Request: %s\n%s", header.c_str(), body.c_str());
+#endif
+    if (!sendAll(m_fd, header.c_str(), header.length()) || !sendAll(m_fd, body.c_str(), body.length())) {
+        disconnect();
+        return -1;
+    }
+
+    bool keepAlive = false;
+    int status = readResponse(keepAlive);
+    if (status < 0 || !keepAlive)
+        disconnect();
+
+    return status;
+}
+
+/* Helper to read a HTTP response from the server. */
+
+int BatchWriter::readResponse(bool& keepAlive)
+{
+    keepAlive = false;
+
+    std::string buffer;
+    size_t headerEnd = std::string::npos;
+    while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+        if (buffer.length() > INFLUX_WRITER_MAX_HEADER_LEN || !recvMore(m_fd, buffer))
+            return -1;
+    }
+
+    std::string headers = buffer.substr(0U, headerEnd + 2U);
+    buffer.erase(0U, headerEnd + 4U);
+
+    // status line
+    if (headers.compare(0U, 5U, "HTTP/") != 0)
+        return -1;
+    size_t statusPos = headers.find(' ');
+    if (statusPos == std::string::npos)
+        return -1;
+    int status = ::atoi(headers.c_str() + statusPos + 1U);
+    if (status < 100)
+        return -1;
+
+    keepAlive = headers.compare(0U, 8U, "HTTP/1.1") == 0;
+    std::string value;
+    if (findHeader(headers, "Connection", value))
+        keepAlive = (::strncasecmp(value.c_str(), "close", 5U) != 0);
+
+    // discard the body, so the next response starts at the beginning of the stream
+    if (findHeader(headers, "Transfer-Encoding", value) && ::strncasecmp(value.c_str(), "chunked", 7U) == 0) {
+        while (true) {
+            size_t lineEnd;
+            while ((lineEnd = buffer.find("\r\n")) == std::string::npos) {
+                if (!recvMore(m_fd, buffer))
+                    return -1;
+            }
+
+            size_t chunkLen = (size_t)::strtoul(buffer.c_str(), nullptr, 16);
+            buffer.erase(0U, lineEnd + 2U);
+            if (chunkLen == 0U) {
+                // skip any trailers, up to the final empty line
+                while (true) {
+                    while ((lineEnd = buffer.find("\r\n")) == std::string::npos) {
+                        if (!recvMore(m_fd, buffer))
+                            return -1;
+                    }
+
+                    buffer.erase(0U, lineEnd + 2U);
+                    if (lineEnd == 0U)
+                        break;
+                }
+                break;
+            }
+
+            while (buffer.length() < chunkLen + 2U) {
+                if (!recvMore(m_fd, buffer))
+                    return -1;
+            }
+            buffer.erase(0U, chunkLen + 2U);
+        }
+    }
+    else if (findHeader(headers, "Content-Length", value)) {
+        size_t contentLen = (size_t)::strtoul(value.c_str(), nullptr, 10);
+        while (buffer.length() < contentLen) {
+            if (!recvMore(m_fd, buffer))
+                return -1;
+        }
+    }
+    else if (status != 204 && status != 304 && status >= 200) {
+        // the body is delimited by the server closing the connection
+        keepAlive = false;
+    }
+
+    return status;
+}
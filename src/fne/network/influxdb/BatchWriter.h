@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Converged FNE Software
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file BatchWriter.h
+ * @ingroup fne_influx
+ * @file BatchWriter.cpp
+ * @ingroup fne_influx
+ */
+#if !defined(__INFLUXDB_BATCH_WRITER_H__)
+#define __INFLUXDB_BATCH_WRITER_H__
+
+#include "fne/Defines.h"
+#include "common/network/json/json.h"
+#include "common/Thread.h"
+#include "fne/network/influxdb/InfluxDB.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+
+namespace network
+{
+    namespace influxdb
+    {
+        // ---------------------------------------------------------------------------
+        //  Constants
+        // ---------------------------------------------------------------------------
+
+        const uint32_t INFLUX_WRITER_QUEUE_DEPTH = 8192U;       // records pending before new records are dropped
+        const uint32_t INFLUX_WRITER_BATCH_LINES = 500U;        // records pending that trigger a write
+        const uint32_t INFLUX_WRITER_BATCH_BYTES = 256U * 1024U; // maximum size of a single write body
+        const uint32_t INFLUX_WRITER_FLUSH_INTERVAL_MS = 1000U; // maximum time a record is held before it is written
+        const uint32_t INFLUX_WRITER_RESOLVE_INTERVAL_MS = 300000U; // time a resolved server address is cached
+        const uint32_t INFLUX_WRITER_RETRY_MAX_MS = 30000U;     // maximum time between attempts to reach the server
+
+        // ---------------------------------------------------------------------------
+        //  Class Declaration
+        // ---------------------------------------------------------------------------
+
+        /**
+         * @brief Implements a background writer that batches line protocol records to an InfluxDB server.
+         *  Records are queued on a bounded lock-free queue, and a single writer thread coalesces them into
+         *  /api/v2/write bodies, which are sent as soon as a full batch is pending, or once the flush
+         *  interval passes. Writes are made over a kept-alive HTTP connection to a cached server address;
+         *  when the queue is full, new records are dropped and counted, rather than blocking the caller.
+         * @ingroup fne_influx
+         */
+        class HOST_SW_API BatchWriter : public Thread {
+        public:
+            /**
+             * @brief Initializes a new instance of the BatchWriter class.
+             * @param si InfluxDB server.
+             * @param queueDepth Maximum number of records that may be queued (rounded up to a power of 2).
+             * @param batchLines Number of pending records that trigger a write.
+             * @param flushIntervalMs Maximum time a record is held before it is written. (0 will use the default.)
+             */
+            BatchWriter(const ServerInfo& si, uint32_t queueDepth = INFLUX_WRITER_QUEUE_DEPTH,
+                uint32_t batchLines = INFLUX_WRITER_BATCH_LINES, uint32_t flushIntervalMs = INFLUX_WRITER_FLUSH_INTERVAL_MS);
+            /**
+             * @brief Finalizes a instance of the BatchWriter class.
+             */
+            ~BatchWriter() override;
+
+            /**
+             * @brief Starts the writer thread.
+             * @returns bool True, if the writer started, otherwise false.
+             */
+            bool start();
+            /**
+             * @brief Signals the writer to stop, and waits for it to exit.
+             *  Records left on the queue are written before the writer exits.
+             */
+            void stop();
+
+            /**
+             * @brief Queues line protocol records for writing.
+             *  This never blocks; if the queue is full the records are dropped.
+             * @param lines Line protocol records.
+             * @returns bool True, if the records were queued, otherwise false.
+             */
+            bool enqueue(const std::string& lines);
+
+            /**
+             * @brief Thread entry point.
+             */
+            void entry() override;
+
+            /**
+             * @brief Gets the number of records queued.
+             * @returns uint64_t Number of records queued.
+             */
+            uint64_t queued() const { return m_queued.load(); }
+            /**
+             * @brief Gets the number of records written to the server.
+             * @returns uint64_t Number of records written.
+             */
+            uint64_t sent() const { return m_sent.load(); }
+            /**
+             * @brief Gets the number of records dropped, because the queue was full or the server could not
+             *  be written to.
+             * @returns uint64_t Number of records dropped.
+             */
+            uint64_t dropped() const { return m_dropped.load(); }
+
+            /**
+             * @brief Helper to create a JSON representation of the writer counters.
+             * @returns json::object
+             */
+            json::object statsObject() const;
+
+        private:
+            /**
+             * @brief Represents a single slot of the record queue.
+             */
+            struct Slot {
+                std::atomic<uint64_t> seq;
+                std::string lines;
+            };
+
+            ServerInfo m_si;
+            std::string m_path;
+            uint32_t m_batchLines;
+            uint32_t m_flushIntervalMs;
+
+            Slot* m_slots;
+            uint64_t m_mask;
+            std::atomic<uint64_t> m_enqueuePos;
+            uint64_t m_dequeuePos;
+            std::atomic<uint32_t> m_pending;
+
+            std::mutex m_mutex;
+            std::condition_variable m_cond;
+            std::atomic<bool> m_running;
+
+            int m_fd;
+            sockaddr_storage m_addr;
+            uint32_t m_addrLen;
+            uint64_t m_resolvedAt;
+            uint64_t m_retryAt;
+            uint32_t m_retryDelayMs;
+            std::string m_retryBody;
+            uint32_t m_retryRecords;
+
+            std::atomic<uint64_t> m_queued;
+            std::atomic<uint64_t> m_sent;
+            std::atomic<uint64_t> m_dropped;
+            std::atomic<uint64_t> m_writes;
+            std::atomic<uint64_t> m_writeErrors;
+            std::atomic<uint64_t> m_connects;
+
+            /**
+             * @brief Helper to dequeue a record, if any is pending.
+             * @param[out] lines Line protocol records.
+             * @returns bool True, if a record was dequeued, otherwise false.
+             */
+            bool dequeue(std::string& lines);
+            /**
+             * @brief Helper to write the pending records to the server, in batches.
+             * @param all Flag indicating a trailing partial batch should also be written.
+             * @param final Flag indicating the writer is stopping, and should not wait out a retry delay.
+             */
+            void flush(bool all, bool final);
+            /**
+             * @brief Helper to write a single batch to the server; a batch that fails because the server is
+             *  unreachable or overloaded is held for retry, unless the writer is stopping.
+             * @param body Line protocol body.
+             * @param records Number of records in the batch.
+             * @param final Flag indicating the writer is stopping, and should not hold the batch for retry.
+             * @returns bool True, if the batch was written or rejected by the server, otherwise false.
+             */
+            bool write(std::string& body, uint32_t records, bool final);
+
+            /**
+             * @brief Helper to resolve the server address, if the cached address has expired.
+             * @returns bool True, if the server address is resolved, otherwise false.
+             */
+            bool resolve();
+            /**
+             * @brief Helper to connect to the server, if not already connected.
+             * @returns bool True, if connected, otherwise false.
+             */
+            bool connect();
+            /**
+             * @brief Helper to close the connection to the server.
+             */
+            void disconnect();
+            /**
+             * @brief Helper to write a batch body to the server, and read the response.
+             * @param body Line protocol body.
+             * @returns int HTTP status code, or -1 if the connection failed.
+             */
+            int post(const std::string& body);
+            /**
+             * @brief Helper to read a HTTP response from the server.
+             * @param[out] keepAlive Flag indicating whether the server will keep the connection open.
+             * @returns int HTTP status code, or -1 if the connection failed.
+             */
+            int readResponse(bool& keepAlive);
+        };
+    } // namespace influxdb
+} // namespace network
+
+#endif // __INFLUXDB_BATCH_WRITER_H__
@@ -9,6 +9,7 @@
  */
 #include "fne/Defines.h"
 #include "fne/network/influxdb/InfluxDB.h"
+#include "fne/network/influxdb/BatchWriter.h"
 
 #if defined(_WIN32)
 #include <ws2tcpip.h>
@@ -26,10 +27,18 @@ using namespace network::influxdb;
 #define SOCK_CONNECT_TIMEOUT 30
 
 // ---------------------------------------------------------------------------
-//  Static Class Members
+//  Public Class Members
 // ---------------------------------------------------------------------------
 
-int32_t detail::TSCaller::m_currThreadCnt = 0U;
+/* Queues the built records on the given batch writer. */
+
+int detail::TSCaller::requestAsync(BatchWriter* writer)
+{
+    if (writer == nullptr)
+        return 1;
+
+    return writer->enqueue(m_lines.str()) ? 0 : 1;
+}
 
 /* Generates a InfluxDB REST API request. */
 
@@ -60,10 +60,10 @@ namespace network
     namespace influxdb
     {
         // ---------------------------------------------------------------------------
-        //  Constants
+        //  Class Prototypes
         // ---------------------------------------------------------------------------
 
-        #define MAX_INFLUXQL_THREAD_CNT 125 // Extreme maximum number of pending Flux queries
+        class BatchWriter;
 
         // ---------------------------------------------------------------------------
         //  Class Declaration
@@ -407,19 +407,6 @@ namespace network
             //  Structure Declaration
             // ---------------------------------------------------------------------------
 
-            /**
-             * @brief Represents the data required for a voice service packet handler thread.
-             * @ingroup rc_network
-             */
-            struct TSCallerRequest : thread_t {
-                ServerInfo si;         //!
-                std::string lines;     //!
-            };
-
-            // ---------------------------------------------------------------------------
-            //  Structure Declaration
-            // ---------------------------------------------------------------------------
-
             /**
              * @brief 
              * @ingroup fne_influx
@@ -428,77 +415,13 @@ namespace network
             {                
                 detail::TagCaller& meas(const std::string& m)                   { m_lines << '\n'; return this->m(m); }
                 int request(const ServerInfo& si, std::string* resp = nullptr)  { return detail::inner::request("POST", "write", "", m_lines.str(), si, resp); }
-                int requestAsync(const ServerInfo& si) 
-                {
-                    if (m_currThreadCnt < 0) {
-                        m_currThreadCnt = 0;
-                    }
-
-                    if (m_currThreadCnt >= MAX_INFLUXQL_THREAD_CNT) {
-                        ::LogError(LOG_HOST, "Maximum concurrent FluxQL thread count reached, dropping request!");
-                        return 1;
-                    }
-            
-                    TSCallerRequest* req = new TSCallerRequest();
-                    req->obj = this;
-
-                    req->si = ServerInfo(si.host(), si.port(), si.org(), si.token(), si.bucket());
-                    req->lines = std::string(m_lines.str());
-
-                    if (!Thread::runAsThread(this, threadedRequest, req)) {
-                        delete req;
-                        return 1;
-                    } else {
-                        m_currThreadCnt++;
-                    }
-            
-                    return 0; 
-                }
-
-            private:
-                static int32_t m_currThreadCnt;
-
                 /**
-                 * @brief 
+                 * @brief Queues the built records on the given batch writer.
+                 *  This never blocks; the records are written to the server by the writer thread.
+                 * @param writer InfluxDB batch writer.
+                 * @returns int 0, if the records were queued, otherwise 1 (writer queue full).
                  */
-                static void* threadedRequest(void* arg)
-                {
-                    TSCallerRequest* req = (TSCallerRequest*)arg;
-                    if (req != nullptr) {
-                #if defined(_WIN32)
-                        ::CloseHandle(req->thread);
-                #else
-                        ::pthread_detach(req->thread);
-                #endif // defined(_WIN32)
-
-                #ifdef _GNU_SOURCE
-                        ::pthread_setname_np(req->thread, "fluxql:request");
-                #endif // _GNU_SOURCE
-
-                        if (req == nullptr) {
-                            m_currThreadCnt--;
-                            return nullptr;
-                        }
-
-                        TSCaller* caller = static_cast<TSCaller*>(req->obj);
-                        if (caller == nullptr) {
-                            if (req != nullptr) {
-                                delete req;
-                            }
-
-                            m_currThreadCnt--;
-                            return nullptr;
-                        }
-
-                        const ServerInfo& si = req->si;
-                        detail::inner::request("POST", "write", "", req->lines, si, nullptr);
-
-                        delete req;
-                    }
-
-                    m_currThreadCnt--;
-                    return nullptr;
-                }
+                int requestAsync(BatchWriter* writer);
             };
 
             // ---------------------------------------------------------------------------
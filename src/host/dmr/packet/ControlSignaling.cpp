@@ -854,13 +854,13 @@ bool ControlSignaling::writeRF_CSBK_Grant(uint32_t srcId, uint32_t dstId, uint8_
         }
 
         if (!tscc->m_affiliations->isGranted(dstId)) {
-            ::lookups::TalkgroupRuleGroupVoice groupVoice = tscc->m_tidLookup->find(dstId);
-            slot = groupVoice.source().tgSlot();
+            ::lookups::TalkgroupRuleGroupVoiceHandle groupVoice = tscc->m_tidLookup->find(dstId);
+            slot = groupVoice->source().tgSlot();
 
             if (grp && !tscc->m_ignoreAffiliationCheck) {
                 // is this an affiliation required group?
-                ::lookups::TalkgroupRuleGroupVoice tid = tscc->m_tidLookup->find(dstId, slot);
-                if (tid.config().affiliated()) {
+                ::lookups::TalkgroupRuleGroupVoiceHandle tid = tscc->m_tidLookup->find(dstId, slot);
+                if (tid->config().affiliated()) {
                     if (!tscc->m_affiliations->hasGroupAff(dstId)) {
                         LogWarning(LOG_RF, "DMR Slot %u, CSBK, RAND (Random Access, GRP_VOICE_CALL (Group Voice Call) ignored, no group affiliations, dstId = %u", tscc->m_slotNo, dstId);
                         return false;
@@ -1189,8 +1189,8 @@ bool ControlSignaling::writeRF_CSBK_Data_Grant(uint32_t srcId, uint32_t dstId, u
         }
 
         if (!tscc->m_affiliations->isGranted(dstId)) {
-            ::lookups::TalkgroupRuleGroupVoice groupVoice = tscc->m_tidLookup->find(dstId);
-            slot = groupVoice.source().tgSlot();
+            ::lookups::TalkgroupRuleGroupVoiceHandle groupVoice = tscc->m_tidLookup->find(dstId);
+            slot = groupVoice->source().tgSlot();
 
             uint32_t availChNo = tscc->m_affiliations->getAvailableChannelForSlot(slot);
             if (!tscc->m_affiliations->rfCh()->isRFChAvailable() || availChNo == 0U) {
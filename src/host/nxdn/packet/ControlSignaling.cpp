@@ -476,8 +476,8 @@ bool ControlSignaling::writeRF_Message_Grant(uint32_t srcId, uint32_t dstId, uin
         if (!m_nxdn->m_affiliations.isGranted(dstId)) {
             if (grp && !m_nxdn->m_ignoreAffiliationCheck) {
                 // is this an affiliation required group?
-                ::lookups::TalkgroupRuleGroupVoice tid = m_nxdn->m_tidLookup->find(dstId);
-                if (tid.config().affiliated()) {
+                ::lookups::TalkgroupRuleGroupVoiceHandle tid = m_nxdn->m_tidLookup->find(dstId);
+                if (tid->config().affiliated()) {
                     if (!m_nxdn->m_affiliations.hasGroupAff(dstId)) {
                         LogWarning(LOG_RF, "NXDN, %s ignored, no group affiliations, dstId = %u", rcch->toString().c_str(), dstId);
                         return false;
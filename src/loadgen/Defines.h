@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @defgroup loadgen Load Generator (dvmloadgen)
+ * @brief Digital Voice Modem - Load Generator
+ * @details Synthetic multi-peer traffic generator, used to benchmark the fan-out latency and throughput of a dvmfne.
+ * @ingroup loadgen
+ * 
+ * @file Defines.h
+ * @ingroup loadgen
+ */
+#if !defined(__DEFINES_H__)
+#define __DEFINES_H__
+
+#include "common/Defines.h"
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#undef __PROG_NAME__
+#define __PROG_NAME__ "Digital Voice Modem (DVM) Load Generator"
+#undef __EXE_NAME__ 
+#define __EXE_NAME__ "dvmloadgen"
+
+#define ERRNO_THRESHOLD 3
+
+#endif // __DEFINES_H__
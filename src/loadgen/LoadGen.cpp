@@ -0,0 +1,328 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "common/Thread.h"
+#include "LoadGen.h"
+#include "LoadGenMain.h"
+
+using namespace network;
+
+#include <cassert>
+#include <cstdio>
+#include <string>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define LOGIN_TIMEOUT 10000U
+#define SETTLE_TIME 500U
+#define DRAIN_TIME 1000U
+
+const char* PROTOCOL_NAMES[LoadProtocol::MAX + 1U] = { "DMR", "P25", "NXDN", "All" };
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LoadGen class. */
+
+LoadGen::LoadGen(const LoadGenConfig& conf) :
+    m_conf(conf),
+    m_probes(nullptr),
+    m_peers(),
+    m_workers()
+{
+    if (m_conf.workers == 0U)
+        m_conf.workers = 1U;
+    if (m_conf.workers > m_conf.peerCount)
+        m_conf.workers = m_conf.peerCount;
+}
+
+/* Finalizes a instance of the LoadGen class. */
+
+LoadGen::~LoadGen()
+{
+    for (LoadGenWorker* worker : m_workers)
+        delete worker;
+    m_workers.clear();
+
+    for (SimPeer* peer : m_peers) {
+        delete peer->network;
+        delete peer;
+    }
+    m_peers.clear();
+
+    if (m_probes != nullptr)
+        delete m_probes;
+}
+
+/* Executes the main load generator processing loop. */
+
+int LoadGen::run()
+{
+    LogMessage(LOG_HOST, "Starting %u simulated peers (peer ID %u - %u) against %s:%u, %u workers", m_conf.peerCount,
+        m_conf.peerIdBase, m_conf.peerIdBase + m_conf.peerCount - 1U, m_conf.address.c_str(), m_conf.port, m_conf.workers);
+
+    if (!createPeers()) {
+        stop();
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t i = 0U; i < m_workers.size(); i++) {
+        if (!m_workers[i]->run()) {
+            LogError(LOG_HOST, "Failed to start load generator worker %u", i);
+            stop();
+            return EXIT_FAILURE;
+        }
+
+        m_workers[i]->setName("loadgen:w" + std::to_string(i));
+    }
+
+    // wait for the peers to login and affiliate
+    uint32_t timeout = LOGIN_TIMEOUT + (m_conf.peerCount * 10U);
+    if (!waitReady(timeout)) {
+        LogError(LOG_HOST, "Only %u of %u simulated peers logged into the FNE after %ums", readyCount(), m_conf.peerCount, timeout);
+        stop();
+        return EXIT_FAILURE;
+    }
+
+    LogMessage(LOG_HOST, "All %u simulated peers logged in and affiliated", m_conf.peerCount);
+
+    // give the FNE a moment to process the affiliations
+    Thread::sleep(SETTLE_TIME);
+
+    LogMessage(LOG_HOST, "Running %u concurrent calls on TG %u - %u for %us", m_conf.calls, m_conf.tgBase, m_conf.tgBase + m_conf.calls - 1U,
+        m_conf.duration);
+
+    uint64_t start = ProbeTable::now();
+    setPhase(LoadGenWorker::PHASE_TRAFFIC);
+
+    uint64_t end = start + (m_conf.duration * 1000000ULL);
+    while (!g_killed && ProbeTable::now() < end) {
+        Thread::sleep(100U);
+    }
+
+    uint64_t elapsed = (ProbeTable::now() - start) / 1000U;
+
+    // end the calls, and wait for the frames still in flight
+    setPhase(LoadGenWorker::PHASE_DRAIN);
+    Thread::sleep(DRAIN_TIME);
+
+    stop();
+
+    LoadStats stats;
+    for (LoadGenWorker* worker : m_workers)
+        stats.merge(worker->stats());
+
+    report(stats, elapsed);
+
+    // fail the run if the configured thresholds were exceeded
+    uint64_t expected = 0U, received = 0U;
+    for (uint8_t p = 0U; p < LoadProtocol::MAX; p++) {
+        expected += stats.expected[p];
+        received += stats.received[p];
+    }
+
+    if (expected > 0U && received == 0U) {
+        LogError(LOG_HOST, "No probe frames were received, is the FNE routing TG %u - %u?", m_conf.tgBase, m_conf.tgBase + m_conf.calls - 1U);
+        return EXIT_FAILURE;
+    }
+
+    double loss = (expected > 0U && received < expected) ? ((double)(expected - received) * 100.0) / (double)expected : 0.0;
+    if (m_conf.maxLoss >= 0.0 && loss > m_conf.maxLoss) {
+        LogError(LOG_HOST, "Loss %.3f%% exceeds the maximum of %.3f%%", loss, m_conf.maxLoss);
+        return ERRNO_THRESHOLD;
+    }
+
+    uint64_t p99 = stats.quantile(LoadProtocol::MAX, 0.99);
+    if (m_conf.maxP99 > 0U && p99 > m_conf.maxP99) {
+        LogError(LOG_HOST, "p99 latency %.3fms exceeds the maximum of %.3fms", p99 / 1000.0, m_conf.maxP99 / 1000.0);
+        return ERRNO_THRESHOLD;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+// ---------------------------------------------------------------------------
+//  Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to create the simulated peers and the workers that run them. */
+
+bool LoadGen::createPeers()
+{
+    m_probes = new ProbeTable(m_conf.peerCount);
+
+    for (uint32_t i = 0U; i < m_conf.workers; i++) {
+        m_workers.push_back(new LoadGenWorker(i, m_conf, m_probes));
+    }
+
+    for (uint32_t i = 0U; i < m_conf.peerCount; i++) {
+        uint32_t peerId = m_conf.peerIdBase + i;
+
+        SimPeer* peer = new SimPeer();
+        peer->index = i;
+        peer->affiliated = false;
+        peer->inCall = false;
+        peer->protocol = LoadProtocol::P25;
+        peer->srcId = 0U;
+        peer->dstId = 0U;
+        peer->lane = 0U;
+        peer->frame = 0U;
+        peer->frames = 0U;
+        peer->nextFrame = 0U;
+        peer->counter = 0U;
+        peer->lastCounter.assign(m_conf.peerCount, 0U);
+        peer->recvWindow.assign(m_conf.peerCount, 0U);
+
+        peer->network = new SimPeerNetwork(m_conf.address, m_conf.port, peerId, m_conf.password, m_conf.pingInterval);
+        peer->network->setMetadata("LOADGEN " + std::to_string(peerId), 0U, 0U, 0.0F, 0.0F, 0, 0, 0, 0.0F, 0.0F, 0, "");
+        if (m_conf.encrypted) {
+            peer->network->setPresharedKey(m_conf.presharedKey);
+        }
+
+        m_peers.push_back(peer);
+
+        peer->network->enable(true);
+        if (!peer->network->open()) {
+            LogError(LOG_HOST, "Failed to open the network for simulated peer %u", peerId);
+            return false;
+        }
+
+        m_workers[i % m_workers.size()]->addPeer(peer);
+    }
+
+    // each call lane (and its talkgroup) is owned by a single worker
+    for (uint32_t i = 0U; i < m_conf.calls; i++) {
+        m_workers[i % m_workers.size()]->addLane(i);
+    }
+
+    return true;
+}
+
+/* Helper to stop the workers and close the simulated peers. */
+
+void LoadGen::stop()
+{
+    setPhase(LoadGenWorker::PHASE_STOP);
+    for (LoadGenWorker* worker : m_workers) {
+        if (worker->started())
+            worker->wait();
+    }
+
+    for (SimPeer* peer : m_peers) {
+        if (peer->network->isEnabled())
+            peer->network->close();
+    }
+}
+
+/* Helper to wait for all simulated peers to login and affiliate. */
+
+bool LoadGen::waitReady(uint32_t timeout)
+{
+    uint64_t end = ProbeTable::now() + (timeout * 1000ULL);
+    while (!g_killed && ProbeTable::now() < end) {
+        if (readyCount() == m_conf.peerCount)
+            return true;
+
+        Thread::sleep(50U);
+    }
+
+    return readyCount() == m_conf.peerCount;
+}
+
+/* Helper to get the number of simulated peers that are ready. */
+
+uint32_t LoadGen::readyCount() const
+{
+    uint32_t ready = 0U;
+    for (LoadGenWorker* worker : m_workers)
+        ready += worker->readyCount();
+
+    return ready;
+}
+
+/* Helper to set the phase of all workers. */
+
+void LoadGen::setPhase(LoadGenWorker::Phase phase)
+{
+    for (LoadGenWorker* worker : m_workers)
+        worker->setPhase(phase);
+}
+
+/* Prints the traffic report. */
+
+void LoadGen::report(const LoadStats& stats, uint64_t elapsed)
+{
+    double seconds = (elapsed > 0U) ? elapsed / 1000.0 : 1.0;
+
+    ::fprintf(stdout, "\n%s report: %u peers, %u concurrent calls, %u workers, %.1fs of traffic, %uus poll interval\n\n",
+        __EXE_NAME__, m_conf.peerCount, m_conf.calls, m_conf.workers, seconds, m_conf.pollInterval);
+    ::fprintf(stdout, "%-6s %8s %10s %12s %12s %8s %8s %8s %10s %10s %10s %10s\n",
+        "Proto", "Calls", "Sent", "Expected", "Received", "Loss %", "Dup", "Reorder", "p50 ms", "p99 ms", "p999 ms", "Max ms");
+
+    for (uint8_t p = 0U; p <= LoadProtocol::MAX; p++) {
+        uint64_t calls = 0U, sent = 0U, expected = 0U, received = 0U, duplicates = 0U, reordered = 0U, latencyMax = 0U;
+        if (p < LoadProtocol::MAX) {
+            calls = stats.calls[p];
+            sent = stats.sent[p];
+            expected = stats.expected[p];
+            received = stats.received[p];
+            duplicates = stats.duplicates[p];
+            reordered = stats.reordered[p];
+            latencyMax = stats.latencyMax[p];
+        }
+        else {
+            for (uint8_t i = 0U; i < LoadProtocol::MAX; i++) {
+                calls += stats.calls[i];
+                sent += stats.sent[i];
+                expected += stats.expected[i];
+                received += stats.received[i];
+                duplicates += stats.duplicates[i];
+                reordered += stats.reordered[i];
+                if (stats.latencyMax[i] > latencyMax)
+                    latencyMax = stats.latencyMax[i];
+            }
+        }
+
+        if (p < LoadProtocol::MAX && sent == 0U)
+            continue;
+
+        double loss = (expected > 0U && received < expected) ? ((double)(expected - received) * 100.0) / (double)expected : 0.0;
+        ::fprintf(stdout, "%-6s %8llu %10llu %12llu %12llu %8.3f %8llu %8llu %10.3f %10.3f %10.3f %10.3f\n",
+            PROTOCOL_NAMES[p], (unsigned long long)calls, (unsigned long long)sent, (unsigned long long)expected, (unsigned long long)received,
+            loss, (unsigned long long)duplicates, (unsigned long long)reordered,
+            stats.quantile(p, 0.5) / 1000.0, stats.quantile(p, 0.99) / 1000.0, stats.quantile(p, 0.999) / 1000.0, latencyMax / 1000.0);
+    }
+
+    if (stats.tsbkSent > 0U) {
+        double loss = (stats.tsbkExpected > 0U && stats.tsbkReceived < stats.tsbkExpected) ?
+            ((double)(stats.tsbkExpected - stats.tsbkReceived) * 100.0) / (double)stats.tsbkExpected : 0.0;
+        ::fprintf(stdout, "%-6s %8s %10llu %12llu %12llu %8.3f\n", "TSBK", "-", (unsigned long long)stats.tsbkSent,
+            (unsigned long long)stats.tsbkExpected, (unsigned long long)stats.tsbkReceived, loss);
+    }
+
+    uint64_t sent = 0U, received = 0U;
+    for (uint8_t p = 0U; p < LoadProtocol::MAX; p++) {
+        sent += stats.sent[p];
+        received += stats.received[p];
+    }
+
+    ::fprintf(stdout, "\nThroughput: %.1f frames/s sent, %.1f frames/s delivered", sent / seconds, received / seconds);
+    if (stats.unknown > 0U) {
+        ::fprintf(stdout, ", %llu probes with no send record", (unsigned long long)stats.unknown);
+    }
+    ::fprintf(stdout, "\nDuplicates are detected within %u frames of the newest frame from each sender; older frames count as reordered (and received)",
+        PROBE_WINDOW_SIZE);
+    ::fprintf(stdout, "\n\n");
+    ::fflush(stdout);
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LoadGen.h
+ * @ingroup loadgen
+ * @file LoadGen.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__LOAD_GEN_H__)
+#define __LOAD_GEN_H__
+
+#include "Defines.h"
+#include "LoadGenWorker.h"
+
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief This class implements the core load generator logic.
+ *  The load generator logs a set of simulated peers into a FNE, runs the configured traffic mix
+ *  through it for the configured duration, and reports the fan-out latency, loss and reordering
+ *  seen by the receiving peers.
+ * @ingroup loadgen
+ */
+class HOST_SW_API LoadGen {
+public:
+    /**
+     * @brief Initializes a new instance of the LoadGen class.
+     * @param conf Load generator configuration.
+     */
+    LoadGen(const LoadGenConfig& conf);
+    /**
+     * @brief Finalizes a instance of the LoadGen class.
+     */
+    ~LoadGen();
+
+    /**
+     * @brief Executes the main load generator processing loop.
+     * @returns int Zero if successful, otherwise error occurred.
+     */
+    int run();
+
+private:
+    LoadGenConfig m_conf;
+
+    ProbeTable* m_probes;
+    std::vector<SimPeer*> m_peers;
+    std::vector<LoadGenWorker*> m_workers;
+
+    /**
+     * @brief Helper to create the simulated peers and the workers that run them.
+     * @returns bool True, if the peers were created, otherwise false.
+     */
+    bool createPeers();
+    /**
+     * @brief Helper to stop the workers and close the simulated peers.
+     */
+    void stop();
+
+    /**
+     * @brief Helper to wait for all simulated peers to login and affiliate.
+     * @param timeout Time to wait (ms).
+     * @returns bool True, if all peers are ready, otherwise false.
+     */
+    bool waitReady(uint32_t timeout);
+    /**
+     * @brief Helper to get the number of simulated peers that are ready.
+     * @returns uint32_t Number of ready peers.
+     */
+    uint32_t readyCount() const;
+    /**
+     * @brief Helper to set the phase of all workers.
+     * @param phase Worker phase.
+     */
+    void setPhase(LoadGenWorker::Phase phase);
+
+    /**
+     * @brief Prints the traffic report.
+     * @param stats Collected statistics.
+     * @param elapsed Length of the traffic phase (ms).
+     */
+    void report(const LoadStats& stats, uint64_t elapsed);
+};
+
+#endif // __LOAD_GEN_H__
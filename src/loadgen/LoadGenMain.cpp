@@ -0,0 +1,496 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/Log.h"
+#include "LoadGenMain.h"
+#include "LoadGen.h"
+
+#include <cstdio>
+#include <cstdarg>
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+#include <signal.h>
+
+// ---------------------------------------------------------------------------
+//  Macros
+// ---------------------------------------------------------------------------
+
+#define IS(s) (::strcmp(argv[i], s) == 0)
+
+// ---------------------------------------------------------------------------
+//  Global Variables
+// ---------------------------------------------------------------------------
+
+#ifndef SIGHUP
+#define SIGHUP 1
+#endif
+
+int g_signal = 0;
+std::string g_progExe = std::string(__EXE_NAME__);
+
+bool g_killed = false;
+
+static LoadGenConfig g_conf;
+static std::string g_presharedKey = std::string();
+static uint32_t g_displayLevel = 3U;
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Internal signal handler. */
+
+static void sigHandler(int signum)
+{
+    g_signal = signum;
+    g_killed = true;
+}
+
+/* Helper to print a fatal error message and exit. */
+
+void fatal(const char* msg, ...)
+{
+    char buffer[400U];
+    ::memset(buffer, 0x20U, 400U);
+
+    va_list vl;
+    va_start(vl, msg);
+
+    ::vsprintf(buffer, msg, vl);
+
+    va_end(vl);
+
+    ::fprintf(stderr, "%s: FATAL PANIC; %s\n", g_progExe.c_str(), buffer);
+    exit(EXIT_FAILURE);
+}
+
+/* Helper to pring usage the command line arguments. (And optionally an error.) */
+
+void usage(const char* message, const char* arg)
+{
+    ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+    ::fprintf(stdout, "Copyright (c) 2017-2025 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\n");
+    ::fprintf(stdout, "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\n\n");
+    if (message != nullptr) {
+        ::fprintf(stderr, "%s: ", g_progExe.c_str());
+        ::fprintf(stderr, message, arg);
+        ::fprintf(stderr, "\n\n");
+    }
+
+    ::fprintf(stdout,
+        "usage: %s [-vh]"
+        "[--debug]"
+        "[-a <address>]"
+        "[-p <port>]"
+        "[-P <password>]"
+        "[-k <preshared key>]"
+        "[-n <peers>]"
+        "[-d <seconds>]"
+        "\n\n"
+        "  -v                          show version information\n"
+        "  -h                          show this screen\n"
+        "  --debug                     enable debug logging\n"
+        "\n"
+        "  -a                          FNE address (default 127.0.0.1)\n"
+        "  -p                          FNE port (default 62031)\n"
+        "  -P                          FNE authentication password\n"
+        "  -k                          FNE preshared encryption key (32 or 64 hex characters)\n"
+        "\n"
+        "  -n                          number of simulated peers (default 10)\n"
+        "  --peer-id                   peer ID of the first simulated peer (default 9100000)\n"
+        "  --src-id                    first radio ID used by the simulated peers (default 10000)\n"
+        "  --tg                        first talkgroup ID, one talkgroup per concurrent call (default 1)\n"
+        "\n"
+        "  --calls                     number of concurrent calls (default 2)\n"
+        "  --mix                       call protocol mix (default p25:60,dmr:30,nxdn:10)\n"
+        "  --call-time                 length of a call in ms (default 3000)\n"
+        "  --call-gap                  gap between calls on a talkgroup in ms (default 500)\n"
+        "  --tsbk                      P25 TSBKs sent per second (default 0)\n"
+        "\n"
+        "  -d                          length of the traffic phase in seconds (default 30)\n"
+        "  -i                          peer ping interval in seconds (default 5)\n"
+        "  -w                          number of worker threads (default CPU cores)\n"
+        "  --poll                      peer socket poll interval in us (default 250)\n"
+        "\n"
+        "  --max-loss                  exit with an error if frame loss exceeds the given percentage\n"
+        "  --max-p99                   exit with an error if p99 latency exceeds the given ms\n"
+        "\n"
+        "  --                          stop handling options\n",
+        g_progExe.c_str());
+    exit(EXIT_FAILURE);
+}
+
+/* Helper to parse the call protocol mix. */
+
+static bool parseMix(const std::string& mix)
+{
+    ::memset(g_conf.mix, 0x00U, sizeof(g_conf.mix));
+
+    std::stringstream ss(mix);
+    std::string entry;
+    while (std::getline(ss, entry, ',')) {
+        size_t sep = entry.find(':');
+        if (sep == std::string::npos)
+            return false;
+
+        std::string name = entry.substr(0U, sep);
+        uint32_t weight = (uint32_t)::atoi(entry.substr(sep + 1U).c_str());
+        if (name == "dmr")
+            g_conf.mix[LoadProtocol::DMR] = weight;
+        else if (name == "p25")
+            g_conf.mix[LoadProtocol::P25] = weight;
+        else if (name == "nxdn")
+            g_conf.mix[LoadProtocol::NXDN] = weight;
+        else
+            return false;
+    }
+
+    uint32_t total = 0U;
+    for (uint8_t p = 0U; p < LoadProtocol::MAX; p++)
+        total += g_conf.mix[p];
+
+    return total > 0U;
+}
+
+/* Helper to validate the command line arguments. */
+
+int checkArgs(int argc, char* argv[])
+{
+    int i, p = 0;
+
+    // iterate through arguments
+    for (i = 1; i <= argc; i++)
+    {
+        if (argv[i] == nullptr) {
+            break;
+        }
+
+        if (*argv[i] != '-') {
+            continue;
+        }
+        else if (IS("--")) {
+            ++p;
+            break;
+        }
+        else if (IS("-a")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the FNE address");
+            g_conf.address = std::string(argv[++i]);
+
+            if (g_conf.address.empty())
+                usage("error: %s", "FNE address cannot be blank!");
+
+            p += 2;
+        }
+        else if (IS("-p")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the FNE port");
+            g_conf.port = (uint16_t)::atoi(argv[++i]);
+
+            if (g_conf.port == 0U)
+                usage("error: %s", "FNE port number cannot be blank or 0!");
+
+            p += 2;
+        }
+        else if (IS("-P")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the FNE password");
+            g_conf.password = std::string(argv[++i]);
+
+            if (g_conf.password.empty())
+                usage("error: %s", "FNE password cannot be blank!");
+
+            p += 2;
+        }
+        else if (IS("-k")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the preshared key");
+            g_presharedKey = std::string(argv[++i]);
+
+            p += 2;
+        }
+        else if (IS("-n")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the number of peers");
+            g_conf.peerCount = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.peerCount < 2U)
+                usage("error: %s", "at least two simulated peers are required!");
+
+            p += 2;
+        }
+        else if (IS("--peer-id")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the first peer ID");
+            g_conf.peerIdBase = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.peerIdBase == 0U)
+                usage("error: %s", "peer ID cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("--src-id")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the first radio ID");
+            g_conf.srcIdBase = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.srcIdBase == 0U)
+                usage("error: %s", "radio ID cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("--tg")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the first talkgroup ID");
+            g_conf.tgBase = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.tgBase == 0U)
+                usage("error: %s", "talkgroup ID cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("--calls")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the number of concurrent calls");
+            g_conf.calls = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.calls == 0U)
+                usage("error: %s", "number of concurrent calls cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("--mix")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the call protocol mix");
+            if (!parseMix(std::string(argv[++i])))
+                usage("error: %s", "invalid call protocol mix, expected e.g. p25:60,dmr:30,nxdn:10");
+
+            p += 2;
+        }
+        else if (IS("--call-time")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the call length");
+            g_conf.callTime = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.callTime == 0U)
+                usage("error: %s", "call length cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("--call-gap")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the gap between calls");
+            g_conf.callGap = (uint32_t)::atoi(argv[++i]);
+
+            p += 2;
+        }
+        else if (IS("--tsbk")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the TSBK rate");
+            g_conf.tsbkRate = (uint32_t)::atoi(argv[++i]);
+
+            p += 2;
+        }
+        else if (IS("-d")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the duration");
+            g_conf.duration = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.duration == 0U)
+                usage("error: %s", "duration cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-i")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the ping interval");
+            g_conf.pingInterval = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.pingInterval == 0U)
+                usage("error: %s", "ping interval cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("-w")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the number of workers");
+            g_conf.workers = (uint32_t)::atoi(argv[++i]);
+
+            if (g_conf.workers == 0U)
+                usage("error: %s", "number of workers cannot be 0!");
+
+            p += 2;
+        }
+        else if (IS("--poll")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the poll interval");
+            g_conf.pollInterval = (uint32_t)::atoi(argv[++i]);
+
+            p += 2;
+        }
+        else if (IS("--max-loss")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the maximum loss");
+            g_conf.maxLoss = ::atof(argv[++i]);
+
+            p += 2;
+        }
+        else if (IS("--max-p99")) {
+            if ((argc - 1) <= 0)
+                usage("error: %s", "must specify the maximum p99 latency");
+            g_conf.maxP99 = (uint64_t)(::atof(argv[++i]) * 1000.0);
+
+            p += 2;
+        }
+        else if (IS("--debug")) {
+            ++p;
+            g_displayLevel = 1U;
+        }
+        else if (IS("-v")) {
+            ::fprintf(stdout, __PROG_NAME__ " %s (built %s)\r\n", __VER__, __BUILD__);
+            ::fprintf(stdout, "Copyright (c) 2017-2025 Bryan Biedenkapp, N2PLL and DVMProject (https://github.com/dvmproject) Authors.\n");
+            ::fprintf(stdout, "Portions Copyright (c) 2015-2021 by Jonathan Naylor, G4KLX and others\n\n");
+            if (argc == 2)
+                exit(EXIT_SUCCESS);
+        }
+        else if (IS("-h")) {
+            usage(nullptr, nullptr);
+            if (argc == 2)
+                exit(EXIT_SUCCESS);
+        }
+        else {
+            usage("unrecognized option `%s'", argv[i]);
+        }
+    }
+
+    if (p < 0 || p > argc) {
+        p = 0;
+    }
+
+    return ++p;
+}
+
+/* Helper to parse the network preshared encryption key. */
+
+static bool parsePresharedKey(std::string key)
+{
+    if (key.size() == 32) {
+        // since the key is 32 characters (16 hex pairs), double it on itself for 64 characters (32 hex pairs)
+        key = key.append(key);
+    }
+
+    if (key.size() != 64 || key.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos)
+        return false;
+
+    const char* keyPtr = key.c_str();
+    ::memset(g_conf.presharedKey, 0x00U, AES_WRAPPED_PCKT_KEY_LEN);
+
+    for (uint8_t i = 0; i < AES_WRAPPED_PCKT_KEY_LEN; i++) {
+        char t[4] = { keyPtr[0], keyPtr[1], 0 };
+        g_conf.presharedKey[i] = (uint8_t)::strtoul(t, NULL, 16);
+        keyPtr += 2 * sizeof(char);
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+//  Program Entry Point
+// ---------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    g_conf.address = "127.0.0.1";
+    g_conf.port = 62031U;
+    g_conf.password = std::string();
+    g_conf.encrypted = false;
+    ::memset(g_conf.presharedKey, 0x00U, AES_WRAPPED_PCKT_KEY_LEN);
+
+    g_conf.peerCount = 10U;
+    g_conf.peerIdBase = 9100000U;
+    g_conf.srcIdBase = 10000U;
+    g_conf.tgBase = 1U;
+
+    g_conf.calls = 2U;
+    g_conf.mix[LoadProtocol::DMR] = 30U;
+    g_conf.mix[LoadProtocol::P25] = 60U;
+    g_conf.mix[LoadProtocol::NXDN] = 10U;
+    g_conf.callTime = 3000U;
+    g_conf.callGap = 500U;
+    g_conf.tsbkRate = 0U;
+
+    g_conf.duration = 30U;
+    g_conf.pingInterval = 5U;
+    g_conf.workers = 0U;
+    g_conf.pollInterval = 250U;
+
+    g_conf.maxLoss = -1.0;
+    g_conf.maxP99 = 0U;
+
+    if (argv[0] != nullptr && *argv[0] != 0)
+        g_progExe = std::string(argv[0]);
+
+    if (argc > 1) {
+        // check arguments
+        int i = checkArgs(argc, argv);
+        if (i < argc) {
+            argc -= i;
+            argv += i;
+        }
+        else {
+            argc--;
+            argv++;
+        }
+    }
+
+    if (g_conf.password.empty())
+        usage("error: %s", "must specify the FNE password");
+
+    if (!g_presharedKey.empty()) {
+        if (!parsePresharedKey(g_presharedKey))
+            usage("error: %s", "invalid preshared key, expected 32 or 64 hex characters");
+        g_conf.encrypted = true;
+    }
+
+    // NXDN radio IDs are 16-bit; keep every simulated radio inside that range
+    if (g_conf.srcIdBase + (g_conf.peerCount * g_conf.calls) > 65535U)
+        usage("error: %s", "too many peers and calls for the radio ID range, lower --src-id");
+
+    if (g_conf.workers == 0U) {
+        g_conf.workers = std::thread::hardware_concurrency();
+        if (g_conf.workers == 0U)
+            g_conf.workers = 1U;
+    }
+
+    if (!::LogInitialise("", __EXE_NAME__, 0U, g_displayLevel, false)) {
+        fatal("unable to open the log file\n");
+    }
+
+    ::signal(SIGINT, sigHandler);
+    ::signal(SIGTERM, sigHandler);
+#if !defined(_WIN32)
+    ::signal(SIGHUP, sigHandler);
+#endif // !defined(_WIN32)
+
+    LoadGen* loadGen = new LoadGen(g_conf);
+    int ret = loadGen->run();
+    delete loadGen;
+
+    if (g_signal == SIGINT)
+        ::LogInfoEx(LOG_HOST, "Exited on receipt of SIGINT");
+
+    if (g_signal == SIGTERM)
+        ::LogInfoEx(LOG_HOST, "Exited on receipt of SIGTERM");
+
+    ::LogFinalise();
+    return ret;
+}
@@ -0,0 +1,814 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "common/dmr/data/EMB.h"
+#include "common/dmr/data/NetData.h"
+#include "common/dmr/lc/FullLC.h"
+#include "common/dmr/SlotType.h"
+#include "common/dmr/Sync.h"
+#include "common/network/NetMetrics.h"
+#include "common/nxdn/lc/RTCH.h"
+#include "common/nxdn/NXDNDefines.h"
+#include "common/nxdn/Sync.h"
+#include "common/p25/data/LowSpeedData.h"
+#include "common/p25/lc/tsbk/IOSP_CALL_ALRT.h"
+#include "common/p25/lc/LC.h"
+#include "common/p25/NID.h"
+#include "common/p25/P25Utils.h"
+#include "common/p25/Sync.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+#include "LoadGenWorker.h"
+
+using namespace network;
+
+#include <cassert>
+#include <chrono>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint8_t PROBE_MAGIC = 0xD7U;
+const uint8_t PROBE_CHECK = 0x5AU;
+
+/** @brief Interval between the frames of a call, for each protocol (us). */
+const uint32_t FRAME_INTERVAL[LoadProtocol::MAX] = {
+    60000U,                                                 // DMR voice burst
+    180000U,                                                // P25 LDU
+    80000U                                                  // NXDN voice frame
+};
+
+// ---------------------------------------------------------------------------
+//  ProbeTable Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the ProbeTable class. */
+
+ProbeTable::ProbeTable(uint32_t senders) :
+    m_senders(senders),
+    m_slots(nullptr)
+{
+    assert(senders > 0U);
+
+    m_slots = new Slot[senders * PROBE_RING_SIZE];
+    for (uint32_t i = 0U; i < senders * PROBE_RING_SIZE; i++) {
+        m_slots[i].counter.store(0U, std::memory_order_relaxed);
+        m_slots[i].time.store(0U, std::memory_order_relaxed);
+    }
+}
+
+/* Finalizes a instance of the ProbeTable class. */
+
+ProbeTable::~ProbeTable()
+{
+    delete[] m_slots;
+}
+
+/* Records the send time of a probe. */
+
+void ProbeTable::store(uint32_t sender, uint32_t counter, uint64_t time)
+{
+    if (sender >= m_senders)
+        return;
+
+    // clear the counter before writing the time, so a reader never pairs the new time with the
+    // counter of the probe the slot held before
+    Slot& slot = m_slots[(sender * PROBE_RING_SIZE) + (counter & (PROBE_RING_SIZE - 1U))];
+    slot.counter.store(0U, std::memory_order_release);
+    slot.time.store(time, std::memory_order_release);
+    slot.counter.store(counter, std::memory_order_release);
+}
+
+/* Finds the send time of a probe. */
+
+bool ProbeTable::find(uint32_t sender, uint32_t counter, uint64_t& time) const
+{
+    if (sender >= m_senders || counter == 0U)
+        return false;
+
+    const Slot& slot = m_slots[(sender * PROBE_RING_SIZE) + (counter & (PROBE_RING_SIZE - 1U))];
+    if (slot.counter.load(std::memory_order_acquire) != counter)
+        return false;
+
+    time = slot.time.load(std::memory_order_relaxed);
+
+    // the slot may have been reused while we were reading it
+    return slot.counter.load(std::memory_order_acquire) == counter;
+}
+
+/* Helper to write a probe into a frame. */
+
+void ProbeTable::encode(uint8_t* data, uint32_t sender, uint32_t counter)
+{
+    assert(data != nullptr);
+
+    data[0U] = PROBE_MAGIC;
+    __SET_UINT16B(sender, data, 1U);
+    __SET_UINT32(counter, data, 3U);
+
+    uint8_t check = PROBE_CHECK;
+    for (uint32_t i = 0U; i < PROBE_LENGTH_BYTES - 1U; i++)
+        check ^= data[i];
+    data[PROBE_LENGTH_BYTES - 1U] = check;
+}
+
+/* Helper to read a probe from a frame. */
+
+bool ProbeTable::decode(const uint8_t* data, uint32_t& sender, uint32_t& counter)
+{
+    assert(data != nullptr);
+
+    if (data[0U] != PROBE_MAGIC)
+        return false;
+
+    uint8_t check = PROBE_CHECK;
+    for (uint32_t i = 0U; i < PROBE_LENGTH_BYTES - 1U; i++)
+        check ^= data[i];
+    if (data[PROBE_LENGTH_BYTES - 1U] != check)
+        return false;
+
+    sender = __GET_UINT16B(data, 1U);
+    counter = __GET_UINT32(data, 3U);
+    return true;
+}
+
+/* Helper to get the current time in microseconds (steady clock). */
+
+uint64_t ProbeTable::now()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ---------------------------------------------------------------------------
+//  LoadStats Public Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LoadStats struct. */
+
+LoadStats::LoadStats() :
+    unknown(0U),
+    tsbkSent(0U),
+    tsbkExpected(0U),
+    tsbkReceived(0U)
+{
+    for (uint8_t p = 0U; p < LoadProtocol::MAX; p++) {
+        calls[p] = 0U;
+        sent[p] = 0U;
+        expected[p] = 0U;
+        received[p] = 0U;
+        duplicates[p] = 0U;
+        reordered[p] = 0U;
+
+        latency[p].assign(NET_METRICS_BUCKETS, 0U);
+        latencyMax[p] = 0U;
+    }
+}
+
+/* Adds the given statistics to these. */
+
+void LoadStats::merge(const LoadStats& stats)
+{
+    for (uint8_t p = 0U; p < LoadProtocol::MAX; p++) {
+        calls[p] += stats.calls[p];
+        sent[p] += stats.sent[p];
+        expected[p] += stats.expected[p];
+        received[p] += stats.received[p];
+        duplicates[p] += stats.duplicates[p];
+        reordered[p] += stats.reordered[p];
+
+        for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++)
+            latency[p][i] += stats.latency[p][i];
+        if (stats.latencyMax[p] > latencyMax[p])
+            latencyMax[p] = stats.latencyMax[p];
+    }
+
+    unknown += stats.unknown;
+    tsbkSent += stats.tsbkSent;
+    tsbkExpected += stats.tsbkExpected;
+    tsbkReceived += stats.tsbkReceived;
+}
+
+/* Helper to compute a latency quantile from the histogram. */
+
+uint64_t LoadStats::quantile(uint8_t protocol, double q) const
+{
+    uint8_t first = (protocol < LoadProtocol::MAX) ? protocol : 0U;
+    uint8_t last = (protocol < LoadProtocol::MAX) ? protocol : LoadProtocol::MAX - 1U;
+
+    uint64_t total = 0U;
+    for (uint8_t p = first; p <= last; p++) {
+        for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++)
+            total += latency[p][i];
+    }
+
+    if (total == 0U)
+        return 0U;
+
+    uint64_t rank = (uint64_t)(q * (double)total);
+    if (rank >= total)
+        rank = total - 1U;
+
+    uint64_t seen = 0U;
+    for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++) {
+        for (uint8_t p = first; p <= last; p++)
+            seen += latency[p][i];
+        if (seen > rank)
+            return NetMetrics::bucketUpperBound(i);
+    }
+
+    return NetMetrics::bucketUpperBound(NET_METRICS_BUCKETS - 1U);
+}
+
+// ---------------------------------------------------------------------------
+//  LoadGenWorker Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the LoadGenWorker class. */
+
+LoadGenWorker::LoadGenWorker(uint32_t index, const LoadGenConfig& conf, ProbeTable* probes) : Thread(),
+    m_index(index),
+    m_conf(conf),
+    m_probes(probes),
+    m_peers(),
+    m_lanes(),
+    m_phase(PHASE_LOGIN),
+    m_ready(0U),
+    m_nextTSBK(0U),
+    m_tsbkInterval(0U),
+    m_random(index + 1U),
+    m_audio(),
+    m_nullLDU(nullptr),
+    m_stats()
+{
+    assert(probes != nullptr);
+
+    // the TSBK rate is shared between the workers
+    if (conf.tsbkRate > 0U) {
+        m_tsbkInterval = (uint32_t)((1000000ULL * conf.workers) / conf.tsbkRate);
+    }
+
+    // pre-encode a LDU carrying null audio, the probe is written over the second IMBE
+    m_nullLDU = new uint8_t[p25::defines::P25_LDU_FRAME_LENGTH_BYTES];
+    ::memset(m_nullLDU, 0x00U, p25::defines::P25_LDU_FRAME_LENGTH_BYTES);
+    for (uint32_t n = 0U; n < 9U; n++)
+        m_audio.encode(m_nullLDU, p25::defines::NULL_IMBE, n);
+}
+
+/* Finalizes a instance of the LoadGenWorker class. */
+
+LoadGenWorker::~LoadGenWorker()
+{
+    delete[] m_nullLDU;
+}
+
+/* Adds a simulated peer to this worker. */
+
+void LoadGenWorker::addPeer(SimPeer* peer)
+{
+    assert(peer != nullptr);
+
+    peer->network->setFrameCallback([=](uint8_t subFunc, const uint8_t* data, uint32_t length, uint32_t streamId) {
+        processFrame(peer, subFunc, data, length);
+    });
+
+    m_peers.push_back(peer);
+}
+
+/* Adds a call lane to this worker. */
+
+void LoadGenWorker::addLane(uint32_t lane)
+{
+    Lane l;
+    l.index = lane;
+    l.dstId = m_conf.tgBase + lane;
+    l.active = false;
+    l.nextCall = 0U;
+
+    m_lanes.push_back(l);
+}
+
+/* Thread entry point. */
+
+void LoadGenWorker::entry()
+{
+    uint64_t last = ProbeTable::now();
+    uint64_t remainder = 0U;
+
+    while (m_phase.load() != PHASE_STOP) {
+        uint64_t now = ProbeTable::now();
+        uint64_t elapsed = (now - last) + remainder;
+        uint32_t ms = (uint32_t)(elapsed / 1000U);
+        remainder = elapsed % 1000U;
+        last = now;
+
+        uint8_t phase = m_phase.load();
+
+        // clock the peers, this also reads and processes any received frames
+        uint32_t ready = 0U;
+        for (SimPeer* peer : m_peers) {
+            peer->network->clock(ms);
+            if (!peer->network->isRunning()) {
+                peer->affiliated = false;
+                continue;
+            }
+
+            // affiliate one radio per talkgroup
+            if (!peer->affiliated) {
+                for (uint32_t t = 0U; t < m_conf.calls; t++) {
+                    peer->network->announceGroupAffiliation(m_conf.srcIdBase + (peer->index * m_conf.calls) + t, m_conf.tgBase + t);
+                }
+
+                peer->affiliated = true;
+            }
+
+            ready++;
+        }
+        m_ready.store(ready);
+
+        now = ProbeTable::now();
+        if (phase == PHASE_TRAFFIC) {
+            // start calls on the idle lanes
+            for (Lane& lane : m_lanes) {
+                if (!lane.active && now >= lane.nextCall) {
+                    SimPeer* peer = pickIdlePeer();
+                    if (peer != nullptr) {
+                        startCall(peer, lane, now);
+                    }
+                }
+            }
+
+            // send any due TSBK
+            if (m_tsbkInterval > 0U && now >= m_nextTSBK) {
+                SimPeer* peer = pickIdlePeer();
+                if (peer != nullptr) {
+                    writeTSBK(peer);
+                }
+
+                m_nextTSBK += m_tsbkInterval;
+                if (m_nextTSBK < now)
+                    m_nextTSBK = now + m_tsbkInterval;
+            }
+        }
+
+        // transmit the due call frames
+        for (SimPeer* peer : m_peers) {
+            if (!peer->inCall)
+                continue;
+
+            if (phase != PHASE_TRAFFIC) {
+                endCall(peer, now);
+            }
+            else if (now >= peer->nextFrame) {
+                writeFrame(peer, now);
+            }
+        }
+
+        Thread::sleep(0U, m_conf.pollInterval);
+    }
+}
+
+// ---------------------------------------------------------------------------
+//  LoadGenWorker Private Class Members
+// ---------------------------------------------------------------------------
+
+/* Helper to pick a random idle and affiliated peer. */
+
+SimPeer* LoadGenWorker::pickIdlePeer()
+{
+    if (m_peers.empty())
+        return nullptr;
+
+    uint32_t start = m_random() % m_peers.size();
+    for (uint32_t i = 0U; i < m_peers.size(); i++) {
+        SimPeer* peer = m_peers[(start + i) % m_peers.size()];
+        if (!peer->inCall && peer->affiliated)
+            return peer;
+    }
+
+    return nullptr;
+}
+
+/* Helper to pick the protocol of a new call from the configured mix. */
+
+LoadProtocol::E LoadGenWorker::pickProtocol()
+{
+    uint32_t total = 0U;
+    for (uint8_t p = 0U; p < LoadProtocol::MAX; p++)
+        total += m_conf.mix[p];
+
+    uint32_t pick = m_random() % total;
+    for (uint8_t p = 0U; p < LoadProtocol::MAX; p++) {
+        if (pick < m_conf.mix[p])
+            return (LoadProtocol::E)p;
+        pick -= m_conf.mix[p];
+    }
+
+    return LoadProtocol::P25;
+}
+
+/* Starts a call on the given peer. */
+
+void LoadGenWorker::startCall(SimPeer* peer, Lane& lane, uint64_t now)
+{
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    peer->inCall = true;
+    peer->protocol = pickProtocol();
+    peer->srcId = m_conf.srcIdBase + (peer->index * m_conf.calls) + lane.index;
+    peer->dstId = lane.dstId;
+    peer->lane = (uint32_t)(&lane - &m_lanes[0U]);
+    peer->frame = 0U;
+    peer->frames = m_conf.callTime * 1000U / FRAME_INTERVAL[peer->protocol];
+    if (peer->frames == 0U)
+        peer->frames = 1U;
+    peer->nextFrame = now;
+
+    lane.active = true;
+    m_stats.calls[peer->protocol]++;
+
+    // DMR calls start with a voice header
+    if (peer->protocol == LoadProtocol::DMR) {
+        peer->dmrLC = lc::LC(FLCO::GROUP, peer->srcId, peer->dstId);
+        peer->dmrEmbeddedData.setLC(peer->dmrLC);
+
+        uint8_t data[DMR_FRAME_LENGTH_BYTES];
+        ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+        SlotType slotType = SlotType();
+        slotType.setDataType(DataType::VOICE_LC_HEADER);
+        slotType.encode(data);
+
+        lc::FullLC fullLC = lc::FullLC();
+        fullLC.encode(peer->dmrLC, data, DataType::VOICE_LC_HEADER);
+        Sync::addDMRDataSync(data, true);
+
+        data::NetData dmrData;
+        dmrData.setSlotNo(1U);
+        dmrData.setDataType(DataType::VOICE_LC_HEADER);
+        dmrData.setSrcId(peer->srcId);
+        dmrData.setDstId(peer->dstId);
+        dmrData.setFLCO(FLCO::GROUP);
+        dmrData.setN(0U);
+        dmrData.setSeqNo(0U);
+        dmrData.setData(data);
+
+        peer->network->writeDMR(dmrData, false);
+    }
+}
+
+/* Transmits the next frame of the peer call, and ends the call after the last frame. */
+
+void LoadGenWorker::writeFrame(SimPeer* peer, uint64_t now)
+{
+    bool ret = false;
+    switch (peer->protocol) {
+    case LoadProtocol::DMR:
+        ret = writeDMRFrame(peer);
+        break;
+    case LoadProtocol::P25:
+        ret = writeP25Frame(peer);
+        break;
+    case LoadProtocol::NXDN:
+        ret = writeNXDNFrame(peer);
+        break;
+    default:
+        break;
+    }
+
+    if (ret) {
+        m_stats.sent[peer->protocol]++;
+        m_stats.expected[peer->protocol] += m_conf.peerCount - 1U;
+    }
+
+    peer->frame++;
+    peer->nextFrame += FRAME_INTERVAL[peer->protocol];
+
+    if (peer->frame >= peer->frames) {
+        endCall(peer, now);
+    }
+}
+
+/* Ends the call on the given peer. */
+
+void LoadGenWorker::endCall(SimPeer* peer, uint64_t now)
+{
+    switch (peer->protocol) {
+    case LoadProtocol::DMR:
+        {
+            using namespace dmr;
+            using namespace dmr::defines;
+
+            uint8_t data[DMR_FRAME_LENGTH_BYTES];
+            ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+            SlotType slotType = SlotType();
+            slotType.setDataType(DataType::TERMINATOR_WITH_LC);
+            slotType.encode(data);
+
+            lc::FullLC fullLC = lc::FullLC();
+            fullLC.encode(peer->dmrLC, data, DataType::TERMINATOR_WITH_LC);
+            Sync::addDMRDataSync(data, true);
+
+            data::NetData dmrData;
+            dmrData.setSlotNo(1U);
+            dmrData.setDataType(DataType::TERMINATOR_WITH_LC);
+            dmrData.setSrcId(peer->srcId);
+            dmrData.setDstId(peer->dstId);
+            dmrData.setFLCO(FLCO::GROUP);
+            dmrData.setN(0U);
+            dmrData.setSeqNo((uint8_t)peer->frame);
+            dmrData.setData(data);
+
+            peer->network->writeDMR(dmrData, false);
+            peer->network->resetDMR(1U);
+        }
+        break;
+    case LoadProtocol::P25:
+        {
+            p25::lc::LC lc = p25::lc::LC();
+            lc.setLCO(p25::defines::LCO::GROUP);
+            lc.setSrcId(peer->srcId);
+            lc.setDstId(peer->dstId);
+
+            p25::data::LowSpeedData lsd = p25::data::LowSpeedData();
+
+            peer->network->writeP25TDU(lc, lsd, 0x00U);
+            peer->network->resetP25();
+        }
+        break;
+    case LoadProtocol::NXDN:
+        {
+            using namespace nxdn::defines;
+
+            uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+            ::memset(data, 0x00U, NXDN_FRAME_LENGTH_BYTES + 2U);
+            nxdn::Sync::addNXDNSync(data + 2U);
+
+            nxdn::lc::RTCH lc;
+            lc.setMessageType(MessageType::RTCH_TX_REL);
+            lc.setSrcId((uint16_t)peer->srcId);
+            lc.setDstId((uint16_t)peer->dstId);
+            lc.setGroup(true);
+
+            peer->network->writeNXDN(lc, data, NXDN_FRAME_LENGTH_BYTES + 2U);
+            peer->network->resetNXDN();
+        }
+        break;
+    default:
+        break;
+    }
+
+    peer->inCall = false;
+
+    Lane& lane = m_lanes[peer->lane];
+    lane.active = false;
+    lane.nextCall = now + (m_conf.callGap * 1000ULL);
+}
+
+/* Transmits a DMR voice burst. */
+
+bool LoadGenWorker::writeDMRFrame(SimPeer* peer)
+{
+    using namespace dmr;
+    using namespace dmr::defines;
+
+    uint8_t n = (uint8_t)(peer->frame % 6U);
+
+    uint8_t data[DMR_FRAME_LENGTH_BYTES];
+    ::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+    DataType::E dataType = DataType::VOICE_SYNC;
+    if (n == 0U) {
+        Sync::addDMRAudioSync(data, true);
+    }
+    else {
+        dataType = DataType::VOICE;
+
+        // generate embedded signalling
+        uint8_t lcss = peer->dmrEmbeddedData.getData(data, n);
+
+        data::EMB emb = data::EMB();
+        emb.setColorCode(0U);
+        emb.setLCSS(lcss);
+        emb.encode(data);
+    }
+
+    // the probe replaces the first AMBE frame of the burst
+    writeProbe(peer, data);
+
+    data::NetData dmrData;
+    dmrData.setSlotNo(1U);
+    dmrData.setDataType(dataType);
+    dmrData.setSrcId(peer->srcId);
+    dmrData.setDstId(peer->dstId);
+    dmrData.setFLCO(FLCO::GROUP);
+    dmrData.setN(n);
+    dmrData.setSeqNo((uint8_t)peer->frame);
+    dmrData.setData(data);
+
+    return peer->network->writeDMR(dmrData, false);
+}
+
+/* Transmits a P25 LDU1/LDU2. */
+
+bool LoadGenWorker::writeP25Frame(SimPeer* peer)
+{
+    using namespace p25::defines;
+
+    uint8_t ldu[P25_LDU_FRAME_LENGTH_BYTES];
+    ::memcpy(ldu, m_nullLDU, P25_LDU_FRAME_LENGTH_BYTES);
+
+    // the probe replaces the second IMBE of the LDU
+    uint8_t imbe[RAW_IMBE_LENGTH_BYTES];
+    ::memset(imbe, 0x00U, RAW_IMBE_LENGTH_BYTES);
+    writeProbe(peer, imbe);
+    m_audio.encode(ldu, imbe, 1U);
+
+    p25::lc::LC lc = p25::lc::LC();
+    lc.setLCO(LCO::GROUP);
+    lc.setGroup(true);
+    lc.setPriority(4U);
+    lc.setSrcId(peer->srcId);
+    lc.setDstId(peer->dstId);
+    lc.setAlgId(ALGO_UNENCRYPT);
+    lc.setKId(0U);
+
+    p25::data::LowSpeedData lsd = p25::data::LowSpeedData();
+
+    if ((peer->frame % 2U) == 0U) {
+        FrameType::E frameType = (peer->frame == 0U) ? FrameType::HDU_VALID : FrameType::DATA_UNIT;
+        return peer->network->writeP25LDU1(lc, lsd, ldu, frameType);
+    }
+
+    return peer->network->writeP25LDU2(lc, lsd, ldu);
+}
+
+/* Transmits a NXDN voice frame. */
+
+bool LoadGenWorker::writeNXDNFrame(SimPeer* peer)
+{
+    using namespace nxdn::defines;
+
+    uint8_t data[NXDN_FRAME_LENGTH_BYTES + 2U];
+    ::memset(data, 0x00U, NXDN_FRAME_LENGTH_BYTES + 2U);
+    nxdn::Sync::addNXDNSync(data + 2U);
+
+    writeProbe(peer, data + NXDN_PROBE_OFFSET);
+
+    nxdn::lc::RTCH lc;
+    lc.setMessageType(MessageType::RTCH_VCALL);
+    lc.setSrcId((uint16_t)peer->srcId);
+    lc.setDstId((uint16_t)peer->dstId);
+    lc.setGroup(true);
+
+    return peer->network->writeNXDN(lc, data, NXDN_FRAME_LENGTH_BYTES + 2U);
+}
+
+/* Transmits a P25 TSBK. */
+
+void LoadGenWorker::writeTSBK(SimPeer* peer)
+{
+    using namespace p25;
+    using namespace p25::defines;
+
+    uint32_t srcId = m_conf.srcIdBase + (peer->index * m_conf.calls);
+    uint32_t dstId = m_conf.srcIdBase + ((m_random() % m_conf.peerCount) * m_conf.calls);
+
+    lc::tsbk::IOSP_CALL_ALRT iosp = lc::tsbk::IOSP_CALL_ALRT();
+    iosp.setSrcId(srcId);
+    iosp.setDstId(dstId);
+    iosp.setLastBlock(true);
+
+    uint8_t data[P25_TSDU_FRAME_LENGTH_BYTES];
+    ::memset(data, 0x00U, P25_TSDU_FRAME_LENGTH_BYTES);
+
+    Sync::addP25Sync(data);
+
+    NID nid = NID(DEFAULT_NAC);
+    nid.encode(data, DUID::TSDU);
+
+    iosp.encode(data);
+
+    P25Utils::addStatusBits(data, P25_TSDU_FRAME_LENGTH_BITS, false, false);
+    P25Utils::setStatusBitsStartIdle(data);
+
+    lc::LC lc = lc::LC();
+    lc.setLCO(iosp.getLCO());
+    lc.setMFId(iosp.getMFId());
+    lc.setSrcId(srcId);
+    lc.setDstId(dstId);
+
+    if (peer->network->writeP25TSDU(lc, data)) {
+        m_stats.tsbkSent++;
+        m_stats.tsbkExpected += m_conf.peerCount - 1U;
+    }
+
+    peer->network->resetP25();
+}
+
+/* Helper to record the transmission of a probe frame. */
+
+void LoadGenWorker::writeProbe(SimPeer* peer, uint8_t* data)
+{
+    // the send time is recorded before the frame is written, a receiver on another worker may see it first
+    uint32_t counter = ++peer->counter;
+    m_probes->store(peer->index, counter, ProbeTable::now());
+    ProbeTable::encode(data, peer->index, counter);
+}
+
+/* Processes a protocol frame received by a simulated peer. */
+
+void LoadGenWorker::processFrame(SimPeer* peer, uint8_t subFunc, const uint8_t* data, uint32_t length)
+{
+    uint64_t now = ProbeTable::now();
+
+    LoadProtocol::E protocol = LoadProtocol::MAX;
+    uint32_t offset = 0U;
+    switch (subFunc) {
+    case NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR:
+        protocol = LoadProtocol::DMR;
+        offset = DMR_PROBE_OFFSET;
+        break;
+    case NET_SUBFUNC::PROTOCOL_SUBFUNC_P25:
+        {
+            using namespace p25::defines;
+            if (length < 24U)
+                return;
+
+            uint8_t duid = data[22U];
+            if (duid == DUID::TSDU) {
+                uint32_t srcId = __GET_UINT16(data, 5U);
+                if (srcId >= m_conf.srcIdBase && srcId < m_conf.srcIdBase + (m_conf.peerCount * m_conf.calls))
+                    m_stats.tsbkReceived++;
+                return;
+            }
+
+            if (duid != DUID::LDU1 && duid != DUID::LDU2)
+                return;
+
+            protocol = LoadProtocol::P25;
+            offset = P25_PROBE_OFFSET;
+        }
+        break;
+    case NET_SUBFUNC::PROTOCOL_SUBFUNC_NXDN:
+        protocol = LoadProtocol::NXDN;
+        offset = 24U + NXDN_PROBE_OFFSET;
+        break;
+    default:
+        return;
+    }
+
+    if (length < offset + PROBE_LENGTH_BYTES)
+        return;
+
+    // headers and terminators carry no probe
+    uint32_t sender = 0U, counter = 0U;
+    if (!ProbeTable::decode(data + offset, sender, counter))
+        return;
+
+    uint64_t sentTime = 0U;
+    if (sender >= peer->lastCounter.size() || !m_probes->find(sender, counter, sentTime)) {
+        m_stats.unknown++;
+        return;
+    }
+
+    // track the probes received behind the newest one, so late duplicates are still caught; probes
+    // older than the window are counted as reordered
+    uint32_t& lastCounter = peer->lastCounter[sender];
+    uint64_t& window = peer->recvWindow[sender];
+    if (counter > lastCounter) {
+        uint32_t shift = counter - lastCounter;
+        window = (shift < PROBE_WINDOW_SIZE) ? (window << shift) | 1U : 1U;
+        lastCounter = counter;
+    }
+    else {
+        uint32_t behind = lastCounter - counter;
+        if (behind < PROBE_WINDOW_SIZE) {
+            uint64_t bit = 1ULL << behind;
+            if ((window & bit) != 0U) {
+                m_stats.duplicates[protocol]++;
+                return;
+            }
+
+            window |= bit;
+        }
+
+        m_stats.reordered[protocol]++;
+    }
+
+    m_stats.received[protocol]++;
+
+    uint64_t latency = (now > sentTime) ? now - sentTime : 0U;
+    m_stats.latency[protocol][NetMetrics::bucketIndex(latency)]++;
+    if (latency > m_stats.latencyMax[protocol])
+        m_stats.latencyMax[protocol] = latency;
+}
@@ -0,0 +1,400 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file LoadGenWorker.h
+ * @ingroup loadgen
+ * @file LoadGenWorker.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__LOAD_GEN_WORKER_H__)
+#define __LOAD_GEN_WORKER_H__
+
+#include "Defines.h"
+#include "common/dmr/data/EmbeddedData.h"
+#include "common/dmr/lc/LC.h"
+#include "common/network/udp/Socket.h"
+#include "common/p25/Audio.h"
+#include "common/Thread.h"
+#include "network/SimPeerNetwork.h"
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+const uint32_t PROBE_LENGTH_BYTES = 8U;
+const uint32_t PROBE_RING_SIZE = 4096U;                     // must be a power of 2
+const uint32_t PROBE_WINDOW_SIZE = 64U;                     // probes tracked behind the newest, for duplicate detection
+
+const uint32_t DMR_PROBE_OFFSET = 20U;                      // start of the voice burst
+const uint32_t P25_PROBE_OFFSET = 47U;                      // IMBE of the second DFSI voice frame (LDU1 and LDU2)
+const uint32_t NXDN_PROBE_OFFSET = 12U;                     // offset into the NXDN frame (after sync and LICH)
+
+/**
+ * @brief Simulated Protocol
+ * @ingroup loadgen
+ */
+namespace LoadProtocol {
+    /** @brief Simulated Protocol */
+    enum E : uint8_t {
+        DMR = 0U,                                           //! DMR
+        P25 = 1U,                                           //! P25
+        NXDN = 2U,                                          //! NXDN
+
+        MAX                                                 //! (Number of protocols)
+    };
+}
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents the load generator configuration.
+ * @ingroup loadgen
+ */
+struct LoadGenConfig {
+    std::string address;                                    //! FNE Hostname/IP address.
+    uint16_t port;                                          //! FNE port number.
+    std::string password;                                   //! FNE authentication password.
+    bool encrypted;                                         //! Flag indicating the preshared key is used.
+    uint8_t presharedKey[AES_WRAPPED_PCKT_KEY_LEN];         //! Network preshared encryption key.
+
+    uint32_t peerCount;                                     //! Number of simulated peers.
+    uint32_t peerIdBase;                                    //! Peer ID of the first simulated peer.
+    uint32_t srcIdBase;                                     //! First radio ID used by the simulated peers.
+    uint32_t tgBase;                                        //! First talkgroup ID (one talkgroup per concurrent call).
+
+    uint32_t calls;                                         //! Number of concurrent calls.
+    uint32_t mix[LoadProtocol::MAX];                        //! Relative weight of each protocol in the call mix.
+    uint32_t callTime;                                      //! Length of a call (ms).
+    uint32_t callGap;                                       //! Gap between calls on the same talkgroup (ms).
+    uint32_t tsbkRate;                                      //! TSBKs sent per second.
+
+    uint32_t duration;                                      //! Length of the traffic phase (s).
+    uint32_t pingInterval;                                  //! Interval between peer pings (s).
+    uint32_t workers;                                       //! Number of worker threads.
+    uint32_t pollInterval;                                  //! Interval between peer socket polls (us).
+
+    double maxLoss;                                         //! Maximum allowed frame loss (%), negative to disable.
+    uint64_t maxP99;                                        //! Maximum allowed p99 latency (us), zero to disable.
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements the table of probe send times, shared by all workers.
+ *  Every probe frame carries the index of its sender and a per-sender frame counter; the sender
+ *  records the send time here, and the receiving peer looks it up to compute the fan-out latency.
+ * @ingroup loadgen
+ */
+class HOST_SW_API ProbeTable {
+public:
+    /**
+     * @brief Initializes a new instance of the ProbeTable class.
+     * @param senders Number of senders.
+     */
+    ProbeTable(uint32_t senders);
+    /**
+     * @brief Finalizes a instance of the ProbeTable class.
+     */
+    ~ProbeTable();
+
+    /**
+     * @brief Records the send time of a probe.
+     * @param sender Sender index.
+     * @param counter Sender frame counter.
+     * @param time Send time (us).
+     */
+    void store(uint32_t sender, uint32_t counter, uint64_t time);
+    /**
+     * @brief Finds the send time of a probe.
+     * @param sender Sender index.
+     * @param counter Sender frame counter.
+     * @param[out] time Send time (us).
+     * @returns bool True, if the probe was found, otherwise false.
+     */
+    bool find(uint32_t sender, uint32_t counter, uint64_t& time) const;
+
+    /**
+     * @brief Helper to write a probe into a frame.
+     * @param[out] data Buffer to write the probe to.
+     * @param sender Sender index.
+     * @param counter Sender frame counter.
+     */
+    static void encode(uint8_t* data, uint32_t sender, uint32_t counter);
+    /**
+     * @brief Helper to read a probe from a frame.
+     * @param[in] data Buffer to read the probe from.
+     * @param[out] sender Sender index.
+     * @param[out] counter Sender frame counter.
+     * @returns bool True, if the buffer holds a valid probe, otherwise false.
+     */
+    static bool decode(const uint8_t* data, uint32_t& sender, uint32_t& counter);
+
+    /**
+     * @brief Helper to get the current time in microseconds (steady clock).
+     * @returns uint64_t Current time (us).
+     */
+    static uint64_t now();
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> counter;
+        std::atomic<uint64_t> time;
+    };
+
+    uint32_t m_senders;
+    Slot* m_slots;
+};
+
+// ---------------------------------------------------------------------------
+//  Structure Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Represents the traffic statistics collected by a worker.
+ * @ingroup loadgen
+ */
+struct LoadStats {
+    uint64_t calls[LoadProtocol::MAX];                      //! Calls started.
+    uint64_t sent[LoadProtocol::MAX];                       //! Probe frames sent.
+    uint64_t expected[LoadProtocol::MAX];                   //! Probe frames expected at the receiving peers.
+    uint64_t received[LoadProtocol::MAX];                   //! Probe frames received.
+    uint64_t duplicates[LoadProtocol::MAX];                 //! Probe frames received more then once.
+    uint64_t reordered[LoadProtocol::MAX];                  //! Probe frames received after a later frame of the same sender.
+    uint64_t unknown;                                       //! Probe frames with no recorded send time.
+
+    uint64_t tsbkSent;                                      //! TSBKs sent.
+    uint64_t tsbkExpected;                                  //! TSBKs expected at the receiving peers.
+    uint64_t tsbkReceived;                                  //! TSBKs received.
+
+    std::vector<uint64_t> latency[LoadProtocol::MAX];       //! Latency histogram (see NetMetrics::bucketIndex()).
+    uint64_t latencyMax[LoadProtocol::MAX];                 //! Largest latency seen (us).
+
+    /**
+     * @brief Initializes a new instance of the LoadStats struct.
+     */
+    LoadStats();
+
+    /**
+     * @brief Adds the given statistics to these.
+     * @param stats Statistics to add.
+     */
+    void merge(const LoadStats& stats);
+    /**
+     * @brief Helper to compute a latency quantile from the histogram.
+     * @param protocol Protocol (or LoadProtocol::MAX for all protocols).
+     * @param q Quantile (0.0 - 1.0).
+     * @returns uint64_t Upper bound of the bucket holding the quantile (us), or 0 if nothing was recorded.
+     */
+    uint64_t quantile(uint8_t protocol, double q) const;
+};
+
+/**
+ * @brief Represents a simulated peer.
+ * @ingroup loadgen
+ */
+struct SimPeer {
+    network::SimPeerNetwork* network;                       //! Peer network connection.
+    uint32_t index;                                         //! Peer index (also the probe sender index).
+    bool affiliated;                                        //! Flag indicating the peer affiliated its radios.
+
+    /** @name Transmit Call */
+    bool inCall;                                            //! Flag indicating the peer is transmitting a call.
+    LoadProtocol::E protocol;                               //! Protocol of the call.
+    uint32_t srcId;                                         //! Source radio ID of the call.
+    uint32_t dstId;                                         //! Talkgroup of the call.
+    uint32_t lane;                                          //! Call lane the call belongs to.
+    uint32_t frame;                                         //! Number of frames sent in the call.
+    uint32_t frames;                                        //! Number of frames in the call.
+    uint64_t nextFrame;                                     //! Time the next frame is due (us).
+    uint32_t counter;                                       //! Probe frame counter.
+    dmr::lc::LC dmrLC;                                      //! DMR link control of the call.
+    dmr::data::EmbeddedData dmrEmbeddedData;                //! DMR embedded data of the call.
+    /** @} */
+
+    std::vector<uint32_t> lastCounter;                      //! Last probe counter received from each sender.
+    std::vector<uint64_t> recvWindow;                       //! Probes received from each sender, behind the last (bit n = last - n).
+};
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Implements a load generator worker thread.
+ *  Each worker owns a set of simulated peers and call lanes (one talkgroup each); it clocks its
+ *  peers, starts calls on idle peers, transmits the frames of each call at the protocol frame
+ *  rate and records the probes its peers receive.
+ * @ingroup loadgen
+ */
+class HOST_SW_API LoadGenWorker : public Thread {
+public:
+    /**
+     * @brief Worker Phase
+     */
+    enum Phase : uint8_t {
+        PHASE_LOGIN = 0U,                                   //! Peers are logging in and affiliating.
+        PHASE_TRAFFIC = 1U,                                 //! Calls and TSBKs are being generated.
+        PHASE_DRAIN = 2U,                                   //! Calls are ended; peers are only receiving.
+        PHASE_STOP = 3U                                     //! Worker is exiting.
+    };
+
+    /**
+     * @brief Initializes a new instance of the LoadGenWorker class.
+     * @param index Worker index.
+     * @param conf Load generator configuration.
+     * @param probes Shared probe send time table.
+     */
+    LoadGenWorker(uint32_t index, const LoadGenConfig& conf, ProbeTable* probes);
+    /**
+     * @brief Finalizes a instance of the LoadGenWorker class.
+     */
+    ~LoadGenWorker() override;
+
+    /**
+     * @brief Adds a simulated peer to this worker. (Must be called before the worker runs.)
+     * @param peer Simulated peer.
+     */
+    void addPeer(SimPeer* peer);
+    /**
+     * @brief Adds a call lane to this worker. (Must be called before the worker runs.)
+     * @param lane Call lane index.
+     */
+    void addLane(uint32_t lane);
+
+    /**
+     * @brief Sets the worker phase.
+     * @param phase Worker phase.
+     */
+    void setPhase(Phase phase) { m_phase.store(phase); }
+
+    /**
+     * @brief Gets the number of peers that are logged in and affiliated.
+     * @returns uint32_t Number of ready peers.
+     */
+    uint32_t readyCount() const { return m_ready.load(); }
+    /**
+     * @brief Gets the collected statistics. (Only valid once the worker has stopped.)
+     * @returns LoadStats Collected statistics.
+     */
+    const LoadStats& stats() const { return m_stats; }
+
+    /**
+     * @brief Thread entry point.
+     */
+    void entry() override;
+
+private:
+    uint32_t m_index;
+    const LoadGenConfig& m_conf;
+    ProbeTable* m_probes;
+
+    std::vector<SimPeer*> m_peers;
+
+    struct Lane {
+        uint32_t index;
+        uint32_t dstId;
+        bool active;
+        uint64_t nextCall;
+    };
+    std::vector<Lane> m_lanes;
+
+    std::atomic<uint8_t> m_phase;
+    std::atomic<uint32_t> m_ready;
+
+    uint64_t m_nextTSBK;
+    uint32_t m_tsbkInterval;
+
+    std::mt19937 m_random;
+    p25::Audio m_audio;
+    uint8_t* m_nullLDU;
+
+    LoadStats m_stats;
+
+    /**
+     * @brief Helper to pick a random idle and affiliated peer.
+     * @returns SimPeer* Simulated peer, or nullptr if none is idle.
+     */
+    SimPeer* pickIdlePeer();
+    /**
+     * @brief Helper to pick the protocol of a new call from the configured mix.
+     * @returns LoadProtocol::E Protocol.
+     */
+    LoadProtocol::E pickProtocol();
+
+    /**
+     * @brief Starts a call on the given peer.
+     * @param peer Simulated peer.
+     * @param lane Call lane.
+     * @param now Current time (us).
+     */
+    void startCall(SimPeer* peer, Lane& lane, uint64_t now);
+    /**
+     * @brief Transmits the next frame of the peer call, and ends the call after the last frame.
+     * @param peer Simulated peer.
+     * @param now Current time (us).
+     */
+    void writeFrame(SimPeer* peer, uint64_t now);
+    /**
+     * @brief Ends the call on the given peer.
+     * @param peer Simulated peer.
+     * @param now Current time (us).
+     */
+    void endCall(SimPeer* peer, uint64_t now);
+
+    /**
+     * @brief Transmits a DMR voice burst.
+     * @param peer Simulated peer.
+     * @returns bool True, if the frame was written, otherwise false.
+     */
+    bool writeDMRFrame(SimPeer* peer);
+    /**
+     * @brief Transmits a P25 LDU1/LDU2.
+     * @param peer Simulated peer.
+     * @returns bool True, if the frame was written, otherwise false.
+     */
+    bool writeP25Frame(SimPeer* peer);
+    /**
+     * @brief Transmits a NXDN voice frame.
+     * @param peer Simulated peer.
+     * @returns bool True, if the frame was written, otherwise false.
+     */
+    bool writeNXDNFrame(SimPeer* peer);
+    /**
+     * @brief Transmits a P25 TSBK.
+     * @param peer Simulated peer.
+     */
+    void writeTSBK(SimPeer* peer);
+
+    /**
+     * @brief Helper to record the transmission of a probe frame.
+     * @param peer Simulated peer.
+     * @param[out] data Buffer to write the probe to.
+     */
+    void writeProbe(SimPeer* peer, uint8_t* data);
+    /**
+     * @brief Processes a protocol frame received by a simulated peer.
+     * @param peer Simulated peer.
+     * @param subFunc Protocol sub-function.
+     * @param[in] data Buffer containing the frame.
+     * @param length Length of buffer.
+     */
+    void processFrame(SimPeer* peer, uint8_t subFunc, const uint8_t* data, uint32_t length);
+};
+
+#endif // __LOAD_GEN_WORKER_H__
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "Defines.h"
+#include "network/SimPeerNetwork.h"
+
+using namespace network;
+
+#include <cassert>
+
+// ---------------------------------------------------------------------------
+//  Public Class Members
+// ---------------------------------------------------------------------------
+
+/* Initializes a new instance of the SimPeerNetwork class. */
+
+SimPeerNetwork::SimPeerNetwork(const std::string& address, uint16_t port, uint32_t peerId, const std::string& password, uint32_t pingInterval) :
+    Network(address, port, 0U, peerId, password, true, false, true, true, true, true, true, false, false, false, false),
+    m_pingInterval(pingInterval),
+    m_frameCallback(nullptr)
+{
+    assert(!address.empty());
+    assert(port > 0U);
+    assert(!password.empty());
+
+    // all protocol frames are handed to the load generator
+    m_userHandleProtocol = true;
+
+    // retry the login quickly; once logged in the retry timer paces the pings
+    m_retryTimer.setTimeout(1U);
+
+    m_peerConnectedCallback = [=]() {
+        m_retryTimer.setTimeout(m_pingInterval);
+    };
+    m_peerDisconnectedCallback = [=]() {
+        m_retryTimer.setTimeout(1U);
+    };
+}
+
+// ---------------------------------------------------------------------------
+//  Protected Class Members
+// ---------------------------------------------------------------------------
+
+/* User overrideable handler that allows user code to process network packets not handled by this class. */
+
+void SimPeerNetwork::userPacketHandler(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data, uint32_t length, uint32_t streamId)
+{
+    // anything other then protocol traffic (peer lists, announcements, etc) is ignored
+    if (opcode.first != NET_FUNC::PROTOCOL)
+        return;
+
+    if (m_frameCallback != nullptr && data != nullptr) {
+        m_frameCallback(opcode.second, data, length, streamId);
+    }
+}
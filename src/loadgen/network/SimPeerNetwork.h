@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Load Generator
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+/**
+ * @file SimPeerNetwork.h
+ * @ingroup loadgen
+ * @file SimPeerNetwork.cpp
+ * @ingroup loadgen
+ */
+#if !defined(__SIM_PEER_NETWORK_H__)
+#define __SIM_PEER_NETWORK_H__
+
+#include "Defines.h"
+#include "common/network/Network.h"
+
+#include <string>
+#include <functional>
+
+namespace network
+{
+    // ---------------------------------------------------------------------------
+    //  Class Declaration
+    // ---------------------------------------------------------------------------
+
+    /**
+     * @brief Implements the networking of a simulated peer.
+     *  The simulated peer performs the normal peer login, and hands every received protocol frame
+     *  to the load generator, rather than buffering it.
+     * @ingroup loadgen
+     */
+    class HOST_SW_API SimPeerNetwork : public Network {
+    public:
+        /**
+         * @brief Initializes a new instance of the SimPeerNetwork class.
+         * @param address Network Hostname/IP address to connect to.
+         * @param port Network port number.
+         * @param peerId Unique ID on the network.
+         * @param password Network authentication password.
+         * @param pingInterval Interval between network pings (in seconds).
+         */
+        SimPeerNetwork(const std::string& address, uint16_t port, uint32_t peerId, const std::string& password, uint32_t pingInterval);
+
+        /**
+         * @brief Helper to determine if the peer is logged into the master.
+         * @returns bool True, if the peer is logged into the master, otherwise false.
+         */
+        bool isRunning() const { return m_status == NET_STAT_RUNNING; }
+
+        /**
+         * @brief Helper to set the received protocol frame callback.
+         * @param callback Received protocol frame callback; called with the protocol sub-function, frame and stream ID.
+         */
+        void setFrameCallback(std::function<void(uint8_t, const uint8_t*, uint32_t, uint32_t)>&& callback) { m_frameCallback = callback; }
+
+    protected:
+        /**
+         * @brief User overrideable handler that allows user code to process network packets not handled by this class.
+         * @param peerId Peer ID.
+         * @param opcode FNE network opcode pair.
+         * @param[in] data Buffer containing message to send to peer.
+         * @param length Length of buffer.
+         * @param streamId Stream ID.
+         */
+        void userPacketHandler(uint32_t peerId, FrameQueue::OpcodePair opcode, const uint8_t* data = nullptr, uint32_t length = 0U,
+            uint32_t streamId = 0U) override;
+
+    private:
+        uint32_t m_pingInterval;
+
+        std::function<void(uint8_t subFunc, const uint8_t* data, uint32_t length, uint32_t streamId)> m_frameCallback;
+    };
+} // namespace network
+
+#endif // __SIM_PEER_NETWORK_H__
@@ -44,6 +44,7 @@
 #define RCD_FNE_GET_AFFLIST             "fne-affs"
 #define RCD_FNE_GET_RELOADTGS           "fne-reload-tgs"
 #define RCD_FNE_GET_RELOADRIDS          "fne-reload-rids"
+#define RCD_FNE_GET_STATS_WORKERS       "fne-stats-workers"
 
 #define RCD_FNE_PUT_RESETPEER           "fne-reset-peer"
 #define RCD_FNE_PUT_PEER_ACL_ADD        "fne-peer-acl-add"
@@ -211,6 +212,7 @@ void usage(const char* message, const char* arg)
     reply += "  fne-affs                    Retrieves the list of currently affiliated SUs (Converged FNE only)\r\n";
     reply += "  fne-reload-tgs              Forces the FNE to reload its TGID list from disk (Converged FNE only)\r\n";
     reply += "  fne-reload-rids             Forces the FNE to reload its RID list from disk (Converged FNE only)\r\n";
+    reply += "  fne-stats-workers           Retrieves the FNE packet worker queue statistics (Converged FNE only)\r\n";
     reply += "\r\n";
     reply += "  fne-reset-peer <pid>        Forces the FNE to reset the connection of the given peer ID (Converged FNE only)\r\n";
     reply += "  fne-peer-acl-add <pid>      Adds the specified peer ID to the FNE ACL tables (Converged FNE only)\r\n";
@@ -883,6 +885,9 @@ int main(int argc, char** argv)
         else if (rcom == RCD_FNE_GET_RELOADTGS) {
             retCode = client->send(HTTP_GET, FNE_GET_RELOAD_TGS, json::object(), response);
         }
+        else if (rcom == RCD_FNE_GET_STATS_WORKERS) {
+            retCode = client->send(HTTP_GET, FNE_GET_STATS_WORKERS, json::object(), response);
+        }
         else if (rcom == RCD_FNE_GET_RELOADRIDS) {
             retCode = client->send(HTTP_GET, FNE_GET_RELOAD_RIDS, json::object(), response);
         }
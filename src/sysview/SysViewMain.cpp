@@ -171,8 +171,8 @@ std::string resolveRID(uint32_t id)
 std::string resolveTGID(uint32_t id)
 {
     auto entry = g_tidLookup->find(id);
-    if (!entry.isInvalid()) {
-        return entry.name();
+    if (!entry->isInvalid()) {
+        return entry->name();
     }
 
     return std::string("UNK");
@@ -4,7 +4,7 @@
  * GPLv2 Open Source. Use is subject to license terms.
  * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
  *
- *  Copyright (C) 2024 Bryan Biedenkapp, N2PLL
+ *  Copyright (C) 2024-2025 Bryan Biedenkapp, N2PLL
  *
  */
 #include "sysview/Defines.h"
@@ -87,6 +87,28 @@ void PeerNetwork::userPacketHandler(uint32_t peerId, FrameQueue::OpcodePair opco
         }
         break;
 
+        case NET_SUBFUNC::TRANSFER_SUBFUNC_ACTIVITY_BATCH:
+        {
+            std::vector<std::string> lines;
+            if (!TransferBatch::decode(data, length, lines)) {
+                LogError(LOG_NET, "PEER %u error decoding activity log batch", peerId);
+                break;
+            }
+
+            std::string identity = std::string();
+            auto it = std::find_if(g_peerIdentityNameMap.begin(), g_peerIdentityNameMap.end(), [&](PeerIdentityMapPair x) { return x.first == peerId; });
+            if (it != g_peerIdentityNameMap.end())
+                identity = g_peerIdentityNameMap[peerId];
+
+            bool currState = g_disableTimeDisplay;
+            g_disableTimeDisplay = true;
+            for (const std::string& line : lines) {
+                ::Log(9999U, nullptr, nullptr, 0U, nullptr, "%.9u (%8s) %s", peerId, identity.c_str(), line.c_str());
+            }
+            g_disableTimeDisplay = currState;
+        }
+        break;
+
         case NET_SUBFUNC::TRANSFER_SUBFUNC_STATUS:
         {
             UInt8Array __rawPayload = std::make_unique<uint8_t[]>(length - 11U);
@@ -461,6 +483,8 @@ bool PeerNetwork::writeConfig()
     config["conventionalPeer"].set<bool>(convPeer);                                 // Conventional Peer Marker
     bool sysView = true;
     config["sysView"].set<bool>(sysView);                                           // SysView Peer Marker
+    bool batchLogTransfer = true;
+    config["batchLogTransfer"].set<bool>(batchLogTransfer);                         // Accepts Batched Log Transfers
 
     config["software"].set<std::string>(std::string(software));                     // Software ID
 
@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -132,33 +133,6 @@ void v_equ(Word16* vec1, Word16* vec2, Word16 n)
         *vec1++ = *vec2++;
 }
 
-//-----------------------------------------------------------------------------
-//	PURPOSE:
-//			Compute the sum of square magnitude of a 16 bit input vector
-//		    with saturation and truncation.  Output is a 32 bit number.
-//
-//	INPUT:
-//		vec       - Pointer to the vector
-//      n         - size of input vectors
-//
-//	OUTPUT:
-//		none
-//
-//	RETURN:
-//		32 bit long signed integer result  
-//
-//-----------------------------------------------------------------------------
-Word32 L_v_magsq(Word16* vec, Word16 n)
-{
-    Word32 L_magsq = 0;
-
-    while (n--) {
-        L_magsq = L_mac(L_magsq, *vec, *vec);
-        vec++;
-    }
-    return L_magsq;
-}
-
 //-----------------------------------------------------------------------------
 //	PURPOSE:
 //		Copy the contents of one 16 bit input vector to another with shift
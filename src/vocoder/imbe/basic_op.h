@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -37,39 +38,18 @@ extern Flag Carry;
 //	 Global Functions
 // ---------------------------------------------------------------------------
 
-Word16 add(Word16 var1, Word16 var2);    /* Short add,           1   */
-Word16 sub(Word16 var1, Word16 var2);    /* Short sub,           1   */
-Word16 abs_s(Word16 var1);               /* Short abs,           1   */
-Word16 shl(Word16 var1, Word16 var2);    /* Short shift left,    1   */
-Word16 shr(Word16 var1, Word16 var2);    /* Short shift right,   1   */
-Word16 mult(Word16 var1, Word16 var2);   /* Short mult,          1   */
-Word32 L_mult(Word16 var1, Word16 var2); /* Long mult,           1   */
-Word16 negate(Word16 var1);              /* Short negate,        1   */
-Word16 extract_h(Word32 L_var1);         /* Extract high,        1   */
-Word16 extract_l(Word32 L_var1);         /* Extract low,         1   */
-Word16 L_round(Word32 L_var1);           /* Round,               1   */
-Word32 L_mac(Word32 L_var3, Word16 var1, Word16 var2);   /* Mac,  1  */
-Word32 L_msu(Word32 L_var3, Word16 var1, Word16 var2);   /* Msu,  1  */
 Word32 L_macNs(Word32 L_var3, Word16 var1, Word16 var2); /* Mac without
 															sat, 1   */
 Word32 L_msuNs(Word32 L_var3, Word16 var1, Word16 var2); /* Msu without
 															sat, 1   */
-Word32 L_add(Word32 L_var1, Word32 L_var2);    /* Long add,        2 */
-Word32 L_sub(Word32 L_var1, Word32 L_var2);    /* Long sub,        2 */
 Word32 L_add_c(Word32 L_var1, Word32 L_var2);  /* Long add with c, 2 */
 Word32 L_sub_c(Word32 L_var1, Word32 L_var2);  /* Long sub with c, 2 */
-Word32 L_negate(Word32 L_var1);                /* Long negate,     2 */
-Word16 mult_r(Word16 var1, Word16 var2);       /* Mult with round, 2 */
-Word32 L_shl(Word32 L_var1, Word16 var2);      /* Long shift left, 2 */
-Word32 L_shr(Word32 L_var1, Word16 var2);      /* Long shift right, 2*/
 Word16 shr_r(Word16 var1, Word16 var2);        /* Shift right with
 												round, 2           */
 Word16 mac_r(Word32 L_var3, Word16 var1, Word16 var2); /* Mac with
 														rounding,2 */
 Word16 msu_r(Word32 L_var3, Word16 var1, Word16 var2); /* Msu with
 														rounding,2 */
-Word32 L_deposit_h(Word16 var1);        /* 16 bit var1 -> MSB,     2 */
-Word32 L_deposit_l(Word16 var1);        /* 16 bit var1 -> LSB,     2 */
 
 Word32 L_shr_r(Word32 L_var1, Word16 var2); /* Long shift right with
 											round,  3             */
@@ -79,4 +59,246 @@ Word16 norm_s(Word16 var1);             /* Short norm,           15  */
 Word16 div_s(Word16 var1, Word16 var2); /* Short division,       18  */
 Word16 norm_l(Word32 L_var1);           /* Long norm,            30  */
 
+// ---------------------------------------------------------------------------
+//	 Inline Global Functions
+// ---------------------------------------------------------------------------
+
+// The single cycle operators are used in every inner loop of the codec; they are defined
+// here so they can be inlined (the saturation behaviour, including Overflow, is unchanged).
+
+inline Word16 shr(Word16 var1, Word16 var2);
+inline Word32 L_shr(Word32 L_var1, Word16 var2);
+
+/* Limit the 32 bit input to the range of a 16 bit word. */
+inline Word16 saturate(Word32 L_var1)
+{
+    if (L_var1 > 0X00007fffL) {
+        Overflow = 1;
+        return MAX_16;
+    }
+    else if (L_var1 < (Word32)0xffff8000L) {
+        Overflow = 1;
+        return MIN_16;
+    }
+
+    return (Word16)L_var1;
+}
+
+/* Short add,           1   */
+inline Word16 add(Word16 var1, Word16 var2)
+{
+    return saturate((Word32)var1 + var2);
+}
+
+/* Short sub,           1   */
+inline Word16 sub(Word16 var1, Word16 var2)
+{
+    return saturate((Word32)var1 - var2);
+}
+
+/* Short abs,           1   */
+inline Word16 abs_s(Word16 var1)
+{
+    if (var1 == (Word16)0X8000)
+        return MAX_16;
+
+    return (var1 < 0) ? -var1 : var1;
+}
+
+/* Short shift left,    1   */
+inline Word16 shl(Word16 var1, Word16 var2)
+{
+    if (var2 < 0) {
+        if (var2 < -16)
+            var2 = -16;
+        return shr(var1, -var2);
+    }
+
+    Word32 result = (Word32)var1 * ((Word32)1 << var2);
+    if ((var2 > 15 && var1 != 0) || (result != (Word32)((Word16)result))) {
+        Overflow = 1;
+        return (var1 > 0) ? MAX_16 : MIN_16;
+    }
+
+    return (Word16)result;
+}
+
+/* Short shift right,   1   */
+inline Word16 shr(Word16 var1, Word16 var2)
+{
+    if (var2 < 0) {
+        if (var2 < -16)
+            var2 = -16;
+        return shl(var1, -var2);
+    }
+
+    if (var2 >= 15)
+        return (var1 < 0) ? -1 : 0;
+
+    return (var1 < 0) ? ~((~var1) >> var2) : (var1 >> var2);
+}
+
+/* Short mult,          1   */
+inline Word16 mult(Word16 var1, Word16 var2)
+{
+    Word32 L_product = (Word32)var1 * (Word32)var2;
+
+    L_product = (L_product & (Word32)0xffff8000L) >> 15;
+    if (L_product & (Word32)0x00010000L)
+        L_product = L_product | (Word32)0xffff0000L;
+
+    return saturate(L_product);
+}
+
+/* Long mult,           1   */
+inline Word32 L_mult(Word16 var1, Word16 var2)
+{
+    Word32 L_var_out = (Word32)var1 * (Word32)var2;
+    if (L_var_out != (Word32)0x40000000L)
+        return L_var_out * 2;
+
+    Overflow = 1;
+    return MAX_32;
+}
+
+/* Short negate,        1   */
+inline Word16 negate(Word16 var1)
+{
+    return (var1 == MIN_16) ? MAX_16 : -var1;
+}
+
+/* Extract high,        1   */
+inline Word16 extract_h(Word32 L_var1)
+{
+    return (Word16)(L_var1 >> 16);
+}
+
+/* Extract low,         1   */
+inline Word16 extract_l(Word32 L_var1)
+{
+    return (Word16)L_var1;
+}
+
+/* Long add,        2 */
+inline Word32 L_add(Word32 L_var1, Word32 L_var2)
+{
+    Word32 L_var_out = L_var1 + L_var2;
+
+    if (((L_var1 ^ L_var2) & MIN_32) == 0) {
+        if ((L_var_out ^ L_var1) & MIN_32) {
+            L_var_out = (L_var1 < 0) ? MIN_32 : MAX_32;
+            Overflow = 1;
+        }
+    }
+
+    return L_var_out;
+}
+
+/* Long sub,        2 */
+inline Word32 L_sub(Word32 L_var1, Word32 L_var2)
+{
+    Word32 L_var_out = L_var1 - L_var2;
+
+    if (((L_var1 ^ L_var2) & MIN_32) != 0) {
+        if ((L_var_out ^ L_var1) & MIN_32) {
+            L_var_out = (L_var1 < 0L) ? MIN_32 : MAX_32;
+            Overflow = 1;
+        }
+    }
+
+    return L_var_out;
+}
+
+/* Round,               1   */
+inline Word16 L_round(Word32 L_var1)
+{
+    return extract_h(L_add(L_var1, (Word32)0x00008000L));
+}
+
+/* Mac,  1  */
+inline Word32 L_mac(Word32 L_var3, Word16 var1, Word16 var2)
+{
+    return L_add(L_var3, L_mult(var1, var2));
+}
+
+/* Msu,  1  */
+inline Word32 L_msu(Word32 L_var3, Word16 var1, Word16 var2)
+{
+    return L_sub(L_var3, L_mult(var1, var2));
+}
+
+/* Long negate,     2 */
+inline Word32 L_negate(Word32 L_var1)
+{
+    return (L_var1 == MIN_32) ? MAX_32 : -L_var1;
+}
+
+/* Mult with round, 2 */
+inline Word16 mult_r(Word16 var1, Word16 var2)
+{
+    Word32 L_product_arr = (Word32)var1 * (Word32)var2;
+    L_product_arr += (Word32)0x00004000L;
+    L_product_arr &= (Word32)0xffff8000L;
+    L_product_arr >>= 15;
+
+    if (L_product_arr & (Word32)0x00010000L)
+        L_product_arr |= (Word32)0xffff0000L;
+
+    return saturate(L_product_arr);
+}
+
+/* Long shift left, 2 */
+inline Word32 L_shl(Word32 L_var1, Word16 var2)
+{
+    if (var2 <= 0) {
+        if (var2 < -32)
+            var2 = -32;
+        return L_shr(L_var1, -var2);
+    }
+
+    Word32 L_var_out = 0;
+    for (; var2 > 0; var2--) {
+        if (L_var1 > (Word32)0X3fffffffL) {
+            Overflow = 1;
+            return MAX_32;
+        }
+        else if (L_var1 < (Word32)0xc0000000L) {
+            Overflow = 1;
+            return MIN_32;
+        }
+
+        L_var1 *= 2;
+        L_var_out = L_var1;
+    }
+
+    return L_var_out;
+}
+
+/* Long shift right, 2*/
+inline Word32 L_shr(Word32 L_var1, Word16 var2)
+{
+    if (var2 < 0) {
+        if (var2 < -32)
+            var2 = -32;
+        return L_shl(L_var1, -var2);
+    }
+
+    if (var2 >= 31)
+        return (L_var1 < 0L) ? -1 : 0;
+
+    return (L_var1 < 0) ? ~((~L_var1) >> var2) : (L_var1 >> var2);
+}
+
+/* 16 bit var1 -> MSB,     2 */
+inline Word32 L_deposit_h(Word16 var1)
+{
+    return (Word32)var1 << 16;
+}
+
+/* 16 bit var1 -> LSB,     2 */
+inline Word32 L_deposit_l(Word16 var1)
+{
+    return (Word32)var1;
+}
+
 #endif // __BASIC_OP_H__
@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -25,6 +26,7 @@
 #include "vocoder/imbe/globals.h"
 #include "vocoder/imbe/tbls.h"
 #include "vocoder/imbe/math_sub.h"
+#include "vocoder/imbe/vec_sub.h"
 #include "vocoder/imbe/imbe_vocoder.h"
 
 // ---------------------------------------------------------------------------
@@ -182,12 +184,11 @@ void imbe_vocoder::fft_init(void)
 
 void imbe_vocoder::fft(Word16* datam1, Word16 nn, Word16 isign)
 {
-    Word16 n, mmax, m, j, istep, i;
-    Word16 wr, wi, temp1;
-    Word32 L_tempr, L_tempi;
+    Word16 n, mmax, m, j, istep, i, k;
+    Word16 temp1;
     Word16* data;
-    Word32 L_temp1, L_temp2;
-    Word16 index, index_step;
+    Word16 index_step, half;
+    Word16 wr_stage[FFTLENGTH / 2], wi_stage[FFTLENGTH / 2];
 
     //  Use pointer indexed from 1 instead of 0	
     data = &datam1[-1];
@@ -214,47 +215,23 @@ void imbe_vocoder::fft(Word16* datam1, Word16 nn, Word16 isign)
     while (n > mmax) {
         istep = shl(mmax, 1);  // istep = 2 * mmax 
 
-        index = 0;
         index_step = shr(index_step, 1);
+        half = shr(mmax, 1);
 
-        wr = ONE_Q15;
-        wi = 0;
-        for (m = 1; m < mmax; m += 2) {
-            for (i = m; i <= n; i += istep) {
-                j = i + mmax;
-
-                // tempr = wr * data[j] - wi * data[j+1] 
-                L_temp1 = L_shr(L_mult(wr, data[j]), 1);
-                L_temp2 = L_shr(L_mult(wi, data[j + 1]), 1);
-                L_tempr = L_sub(L_temp1, L_temp2);
-
-                // tempi = wr * data[j+1] + wi * data[j] 
-                L_temp1 = L_shr(L_mult(wr, data[j + 1]), 1);
-                L_temp2 = L_shr(L_mult(wi, data[j]), 1);
-                L_tempi = L_add(L_temp1, L_temp2);
-
-
-                // data[j] = data[i] - tempr 
-                L_temp1 = L_shr(L_deposit_h(data[i]), 1);
-                data[j] = L_round(L_sub(L_temp1, L_tempr));
-
-                // data[i] += tempr 
-                data[i] = L_round(L_add(L_temp1, L_tempr));
-
-                // data[j+1] = data[i+1] - tempi 
-                L_temp1 = L_shr(L_deposit_h(data[i + 1]), 1);
-                data[j + 1] = L_round(L_sub(L_temp1, L_tempi));
-
-                // data[i+1] += tempi 
-                data[i + 1] = L_round(L_add(L_temp1, L_tempi));
-            }
-            index = add(index, index_step);
-            wr = wr_array[index];
+        // twiddle factors for the butterflies of this stage
+        wr_stage[0] = ONE_Q15;
+        wi_stage[0] = 0;
+        for (k = 1; k < half; k++) {
+            wr_stage[k] = wr_array[k * index_step];
             if (isign < 0)
-                wi = negate(wi_array[index]);
+                wi_stage[k] = negate(wi_array[k * index_step]);
             else
-                wi = wi_array[index];
+                wi_stage[k] = wi_array[k * index_step];
         }
+
+        for (i = 1; i <= n; i += istep)
+            v_fft_bfly(&data[i], &data[i + mmax], wr_stage, wi_stage, half);
+
         mmax = istep;
     }
 }
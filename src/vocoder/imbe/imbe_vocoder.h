@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -94,7 +95,6 @@ private:
     void fft(Word16 *datam1, Word16 nn, Word16 isign);
     void encode(IMBE_PARAM *imbe_param, Word16 *frame_vector, Word16 *snd);
     void pitch_est_init(void);
-    Word32 autocorr(Word16 *sigin, Word16 shift, Word16 scale_shift);
     void e_p(Word16 *sigin, Word16 *res_buf);
     void pitch_est(IMBE_PARAM *imbe_param, Word16 *frames_buf);
     void sa_decode_init(void);
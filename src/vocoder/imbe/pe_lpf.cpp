@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -26,6 +27,7 @@
 #include "vocoder/imbe/basic_op.h"
 #include "vocoder/imbe/math_sub.h"
 #include "vocoder/imbe/pe_lpf.h"
+#include "vocoder/imbe/vec_sub.h"
 
 // ---------------------------------------------------------------------------
 //  Constants
@@ -61,18 +63,20 @@ static const Word16 lpf_coef[PE_LPF_ORD] =
 //-----------------------------------------------------------------------------
 void pe_lpf(Word16* sigin, Word16* sigout, Word16* mem, Word16 len)
 {
-    Word16 i;
-    Word32 L_sum;
+    Word16 n;
+    Word16 buf[PE_LPF_ORD + FRAME];
 
-    while (len--) {
-        for (i = 0; i < PE_LPF_ORD - 1; i++)
-            mem[i] = mem[i + 1];
-        mem[PE_LPF_ORD - 1] = *sigin++;
+    // filter history followed by the new samples, so the FIR runs over a contiguous block
+    while (len > 0) {
+        n = (len > FRAME) ? FRAME : len;
 
-        L_sum = 0;
-        for (i = 0; i < PE_LPF_ORD; i++)
-            L_sum = L_mac(L_sum, mem[i], lpf_coef[i]);
+        v_equ(buf, mem, PE_LPF_ORD);
+        v_equ(&buf[PE_LPF_ORD], sigin, n);
+        v_fir(&buf[1], lpf_coef, PE_LPF_ORD, sigout, n);
+        v_equ(mem, &buf[n], PE_LPF_ORD);
 
-        *sigout++ = L_round(L_sum);
+        sigin += n;
+        sigout += n;
+        len -= n;
     }
 }
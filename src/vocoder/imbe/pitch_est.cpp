@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -27,6 +28,7 @@
 #include "vocoder/imbe/math_sub.h"
 #include "vocoder/imbe/tbls.h"
 #include "vocoder/imbe/pitch_est.h"
+#include "vocoder/imbe/vec_sub.h"
 #include "vocoder/imbe/imbe_vocoder.h"
 
 #if defined(__GNUC__) || defined(__GNUG__)
@@ -72,18 +74,6 @@ void imbe_vocoder::pitch_est_init(void)
     prev_e_p = prev_prev_e_p = 0;
 }
 
-Word32 imbe_vocoder::autocorr(Word16* sigin, Word16 shift, Word16 scale_shift)
-{
-    Word32 L_sum;
-    Word16 i;
-
-    L_sum = 0;
-    for (i = 0; i < PITCH_EST_FRAME - shift; i++)
-        L_sum = L_add(L_sum, L_shr(L_mult(sigin[i], sigin[i + shift]), scale_shift));
-
-    return L_sum;
-}
-
 void imbe_vocoder::e_p(Word16* sigin, Word16* res_buf)
 {
     Word16 i, j, den_part_acc, tmp;
@@ -113,14 +103,11 @@ void imbe_vocoder::e_p(Word16* sigin, Word16* res_buf)
     else
         scale_shift = 0;
 
-    L_e0 = 0;
-    for (i = 0; i < PITCH_EST_FRAME; i++)
-        L_e0 = L_add(L_e0, L_shr(L_mult(sig_wndwed[i], sig_wndwed[i]), scale_shift));              // sum(s^2 * wi^4) 
+    v_autocorr(sig_wndwed, PITCH_EST_FRAME, 0, 0, scale_shift, &L_e0, 1);                           // sum(s^2 * wi^4) 
 
     // Calculate correlation for time shift in range 21...150 with step 0.5
     // For integer shifts
-    for (tmp = 21, i = 0; tmp <= 150; tmp++, i += 2)
-        corr[i] = autocorr(sig_wndwed, tmp, scale_shift);
+    v_autocorr(sig_wndwed, PITCH_EST_FRAME, 21, 150, scale_shift, corr, 2);
     // For intermediate shifts
     for (i = 1; i < 258; i += 2)
         corr[i] = L_shr(L_add(corr[i - 1], corr[i + 1]), 1);
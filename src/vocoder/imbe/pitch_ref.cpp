@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -27,6 +28,7 @@
 #include "vocoder/imbe/math_sub.h"
 #include "vocoder/imbe/tbls.h"
 #include "vocoder/imbe/pitch_ref.h"
+#include "vocoder/imbe/vec_sub.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -45,10 +47,10 @@
 
 void pitch_ref(IMBE_PARAM* imbe_param, Cmplx16* fft_buf)
 {
-    Word16 i, j, index_a_save, pitch_est, tmp, shift, index_wr, up_lim;
+    Word16 i, index_a_save, pitch_est, tmp, shift, index_wr, up_lim;
     Cmplx16 sp_rec[FFTLENGTH / 2];
     Word32 fund_freq, fund_freq_2, fund_freq_acc_a, fund_freq_acc_b, fund_freq_acc, L_tmp, amp_re_acc, amp_im_acc, L_sum, L_diff_min;
-    Word16 ha, hb, index_a, index_b, index_tbl[20], it_ind, re_tmp, im_tmp, pitch_cand = 0;
+    Word16 ha, hb, index_a, index_b, index_tbl[20], it_ind, pitch_cand = 0;
     Word32 fund_freq_cand = 0;
 
 
@@ -135,14 +137,11 @@ void pitch_ref(IMBE_PARAM* imbe_param, Cmplx16* fft_buf)
             fund_freq_acc = L_add(fund_freq_acc, fund_freq);
         }
 
-        L_sum = 0;
-        for (j = MIN_INDEX; j <= up_lim; j++)
-        {
-            re_tmp = sub(fft_buf[j].re, sp_rec[j].re);
-            im_tmp = sub(fft_buf[j].im, sp_rec[j].im);
-            L_sum = L_mac(L_sum, re_tmp, re_tmp);
-            L_sum = L_mac(L_sum, im_tmp, im_tmp);
-        }
+        // sum of (fft_buf - sp_rec)^2 over the re and im parts of MIN_INDEX...up_lim
+        if (up_lim >= MIN_INDEX)
+            L_sum = L_v_magsq_diff(&fft_buf[MIN_INDEX].re, &sp_rec[MIN_INDEX].re, shl(up_lim - MIN_INDEX + 1, 1));
+        else
+            L_sum = 0;
 
         if (L_sum < L_diff_min)
         {
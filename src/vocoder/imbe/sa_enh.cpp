@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -25,6 +26,7 @@
 #include "vocoder/imbe/qnt_sub.h"
 #include "vocoder/imbe/aux_sub.h"
 #include "vocoder/imbe/math_sub.h"
+#include "vocoder/imbe/vec_sub.h"
 #include "vocoder/imbe/sa_enh.h"
 
 // ---------------------------------------------------------------------------
@@ -2,6 +2,7 @@
  * Project 25 IMBE Encoder/Decoder Fixed-Point implementation
  * Developed by Pavel Yazev E-mail: pyazev@gmail.com
  * Version 1.0 (c) Copyright 2009
+ * Copyright (C) 2025 Bryan Biedenkapp, N2PLL
  *
  * This is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by
@@ -26,6 +27,7 @@
 #include "vocoder/imbe/aux_sub.h"
 #include "vocoder/imbe/math_sub.h"
 #include "vocoder/imbe/tbls.h"
+#include "vocoder/imbe/vec_sub.h"
 #include "vocoder/imbe/imbe_vocoder.h"
 
 #include <stdio.h>
@@ -138,14 +140,8 @@ void imbe_vocoder::v_uv_det(IMBE_PARAM* imbe_param, Cmplx16* fft_buf)
     // M(th) function calculation
     //
     //=========================================================================
-    for (j = 0, th_lf = 0; j < 64; j++) {
-        th_lf = L_mac(th_lf, fft_buf[j].re, fft_buf[j].re);
-        th_lf = L_mac(th_lf, fft_buf[j].im, fft_buf[j].im);
-    }
-    for (j = 64, th_hf = 0; j < 128; j++) {
-        th_hf = L_mac(th_hf, fft_buf[j].re, fft_buf[j].re);
-        th_hf = L_mac(th_hf, fft_buf[j].im, fft_buf[j].im);
-    }
+    th_lf = L_v_magsq(&fft_buf[0].re, 128);
+    th_hf = L_v_magsq(&fft_buf[64].re, 128);
     th0 = L_add(th_lf, th_hf);
 
     if (th0 > th_max)
@@ -0,0 +1,500 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - MBE Vocoder
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "vocoder/imbe/typedef.h"
+#include "vocoder/imbe/basic_op.h"
+#include "vocoder/imbe/vec_sub.h"
+
+#include <stdint.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VEC_SUB_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__GNUC__)
+#define VEC_SUB_NEON
+#include <arm_neon.h>
+#endif
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+#if defined(VEC_SUB_SSE2)
+/* Helper to perform L_add on four 32-bit lanes. */
+
+static inline __m128i L_add_x4(__m128i a, __m128i b)
+{
+    __m128i s = _mm_add_epi32(a, b);
+    __m128i ovf = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, s)), 31);
+    __m128i sat = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(MAX_32));
+    return _mm_or_si128(_mm_and_si128(ovf, sat), _mm_andnot_si128(ovf, s));
+}
+
+/* Helper to perform L_sub on four 32-bit lanes. */
+
+static inline __m128i L_sub_x4(__m128i a, __m128i b)
+{
+    __m128i s = _mm_sub_epi32(a, b);
+    __m128i ovf = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, s)), 31);
+    __m128i sat = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(MAX_32));
+    return _mm_or_si128(_mm_and_si128(ovf, sat), _mm_andnot_si128(ovf, s));
+}
+
+/* Helper to perform L_round on two sets of four 32-bit lanes, packing the results. */
+
+static inline __m128i L_round_x8(__m128i lo, __m128i hi)
+{
+    const __m128i rnd = _mm_set1_epi32(0x8000);
+    return _mm_packs_epi32(_mm_srai_epi32(L_add_x4(lo, rnd), 16), _mm_srai_epi32(L_add_x4(hi, rnd), 16));
+}
+
+/* Helper to form the 32-bit products of eight 16-bit lanes. */
+
+static inline void mult_x8(__m128i a, __m128i b, __m128i* lo, __m128i* hi)
+{
+    __m128i pl = _mm_mullo_epi16(a, b);
+    __m128i ph = _mm_mulhi_epi16(a, b);
+    *lo = _mm_unpacklo_epi16(pl, ph);
+    *hi = _mm_unpackhi_epi16(pl, ph);
+}
+
+/* Helper to sum four 32-bit lanes. */
+
+static inline Word32 sum_x4(__m128i v)
+{
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+
+/* Helper to accumulate the (unsigned) sums of squares produced by _mm_madd_epi16 into 64-bit lanes. */
+
+static inline __m128i acc_sq_x4(__m128i acc, __m128i sq)
+{
+    const __m128i zero = _mm_setzero_si128();
+    acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(sq, zero));
+    return _mm_add_epi64(acc, _mm_unpackhi_epi32(sq, zero));
+}
+#endif // defined(VEC_SUB_SSE2)
+
+/* Helper to clip the exact sum of a run of L_mac(x, x) terms to the saturated result. */
+
+static inline Word32 L_sat_sq(uint64_t sum)
+{
+    // every term is positive, so the saturating accumulation is the exact sum clipped to MAX_32
+    // (a single L_mult(MIN_16, MIN_16) term is already enough to saturate either way)
+    sum *= 2U;
+    if (sum > (uint64_t)MAX_32) {
+        Overflow = 1;
+        return MAX_32;
+    }
+
+    return (Word32)sum;
+}
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//			Compute the sum of square magnitude of a 16 bit input vector
+//		    with saturation and truncation.  Output is a 32 bit number.
+//
+//	INPUT:
+//		vec       - Pointer to the vector
+//      n         - size of input vectors
+//
+//	OUTPUT:
+//		none
+//
+//	RETURN:
+//		32 bit long signed integer result
+//
+//-----------------------------------------------------------------------------
+Word32 L_v_magsq(Word16* vec, Word16 n)
+{
+#if defined(VEC_SUB_SSE2) || defined(VEC_SUB_NEON)
+    uint64_t sum = 0U;
+    Word16 i = 0;
+#if defined(VEC_SUB_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(vec + i));
+        acc = acc_sq_x4(acc, _mm_madd_epi16(v, v));
+    }
+
+    uint64_t lanes[2U];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    sum = lanes[0U] + lanes[1U];
+#else
+    int64x2_t acc = vdupq_n_s64(0);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t v = vld1q_s16(vec + i);
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(v), vget_low_s16(v)));
+        acc = vpadalq_s32(acc, vmull_s16(vget_high_s16(v), vget_high_s16(v)));
+    }
+
+    sum = (uint64_t)vaddvq_s64(acc);
+#endif
+    for (; i < n; i++)
+        sum += (uint64_t)((Word32)vec[i] * vec[i]);
+
+    return L_sat_sq(sum);
+#else
+    Word32 L_magsq = 0;
+
+    while (n--) {
+        L_magsq = L_mac(L_magsq, *vec, *vec);
+        vec++;
+    }
+    return L_magsq;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//			Compute the sum of square magnitude of the difference of two
+//          16 bit input vectors (sub(vec1[i], vec2[i])) with saturation
+//          and truncation.  Output is a 32 bit number.
+//
+//	INPUT:
+//		vec1      - Pointer to the first vector
+//		vec2      - Pointer to the second vector
+//      n         - size of input vectors
+//
+//	OUTPUT:
+//		none
+//
+//	RETURN:
+//		32 bit long signed integer result
+//
+//-----------------------------------------------------------------------------
+Word32 L_v_magsq_diff(Word16* vec1, Word16* vec2, Word16 n)
+{
+#if defined(VEC_SUB_SSE2) || defined(VEC_SUB_NEON)
+    uint64_t sum = 0U;
+    Word16 i = 0;
+#if defined(VEC_SUB_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        __m128i d = _mm_subs_epi16(_mm_loadu_si128((const __m128i*)(vec1 + i)), _mm_loadu_si128((const __m128i*)(vec2 + i)));
+        acc = acc_sq_x4(acc, _mm_madd_epi16(d, d));
+    }
+
+    uint64_t lanes[2U];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    sum = lanes[0U] + lanes[1U];
+#else
+    int64x2_t acc = vdupq_n_s64(0);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t d = vqsubq_s16(vld1q_s16(vec1 + i), vld1q_s16(vec2 + i));
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(d), vget_low_s16(d)));
+        acc = vpadalq_s32(acc, vmull_s16(vget_high_s16(d), vget_high_s16(d)));
+    }
+
+    sum = (uint64_t)vaddvq_s64(acc);
+#endif
+    for (; i < n; i++) {
+        Word16 d = sub(vec1[i], vec2[i]);
+        sum += (uint64_t)((Word32)d * d);
+    }
+
+    return L_sat_sq(sum);
+#else
+    Word32 L_magsq = 0;
+    Word16 d;
+
+    while (n--) {
+        d = sub(*vec1++, *vec2++);
+        L_magsq = L_mac(L_magsq, d, d);
+    }
+    return L_magsq;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//		Compute the autocorrelation of a 16 bit input vector for a range
+//      of time shifts; each term is L_shr(L_mult(vec[i], vec[i + shift]), scale)
+//      accumulated with L_add
+//
+//  INPUT:
+//		vec       - Pointer to the vector
+//      n         - size of input vector
+//      shift_min - first time shift
+//      shift_max - last time shift
+//      scale     - right shift applied to each term
+//      step      - distance between results in corr
+//
+//	OUTPUT:
+//		corr      - autocorrelation for each time shift
+//
+//	RETURN:
+//		None
+//
+//-----------------------------------------------------------------------------
+void v_autocorr(Word16* vec, Word16 n, Word16 shift_min, Word16 shift_max, Word16 scale, Word32* corr, Word16 step)
+{
+    Word32 L_sum;
+    Word16 i, shift;
+
+#if defined(VEC_SUB_SSE2) || defined(VEC_SUB_NEON)
+    // the vector path adds the terms in a different order, which is only exact when no partial
+    // sum can saturate; as sum(|2 * x[i] * x[i + shift]|) <= 2 * sum(x[i]^2), the energy of the
+    // input bounds every partial sum (each truncated term is larger by at most one)
+    int64_t energy = 0;
+    bool full = false;
+    for (i = 0; i < n; i++) {
+        energy += (Word32)vec[i] * vec[i];
+        full |= (vec[i] == MIN_16);
+    }
+
+    if (!full && scale >= 0 && scale < 16 && shift_min >= 0 && ((energy * 2) >> scale) + n <= MAX_32) {
+        for (shift = shift_min; shift <= shift_max; shift++, corr += step) {
+            Word16 len = n - shift;
+            i = 0;
+#if defined(VEC_SUB_SSE2)
+            __m128i acc = _mm_setzero_si128();
+            if (scale == 0) {
+                for (; i + 8 <= len; i += 8)
+                    acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(vec + i)),
+                        _mm_loadu_si128((const __m128i*)(vec + i + shift))));
+                acc = _mm_slli_epi32(acc, 1);
+            }
+            else {
+                const __m128i sh = _mm_cvtsi32_si128(scale);
+                for (; i + 8 <= len; i += 8) {
+                    __m128i lo, hi;
+                    mult_x8(_mm_loadu_si128((const __m128i*)(vec + i)), _mm_loadu_si128((const __m128i*)(vec + i + shift)), &lo, &hi);
+                    acc = _mm_add_epi32(acc, _mm_sra_epi32(_mm_slli_epi32(lo, 1), sh));
+                    acc = _mm_add_epi32(acc, _mm_sra_epi32(_mm_slli_epi32(hi, 1), sh));
+                }
+            }
+
+            L_sum = sum_x4(acc);
+#else
+            const int32x4_t sh = vdupq_n_s32(-scale);
+            int32x4_t acc = vdupq_n_s32(0);
+            for (; i + 8 <= len; i += 8) {
+                int16x8_t x = vld1q_s16(vec + i);
+                int16x8_t y = vld1q_s16(vec + i + shift);
+                acc = vaddq_s32(acc, vshlq_s32(vshlq_n_s32(vmull_s16(vget_low_s16(x), vget_low_s16(y)), 1), sh));
+                acc = vaddq_s32(acc, vshlq_s32(vshlq_n_s32(vmull_s16(vget_high_s16(x), vget_high_s16(y)), 1), sh));
+            }
+
+            L_sum = vaddvq_s32(acc);
+#endif
+            for (; i < len; i++)
+                L_sum += L_shr(L_mult(vec[i], vec[i + shift]), scale);
+
+            *corr = L_sum;
+        }
+
+        return;
+    }
+#endif
+
+    for (shift = shift_min; shift <= shift_max; shift++, corr += step) {
+        L_sum = 0;
+        for (i = 0; i < n - shift; i++)
+            L_sum = L_add(L_sum, L_shr(L_mult(vec[i], vec[i + shift]), scale));
+
+        *corr = L_sum;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//		FIR filter; each output is L_round of the L_mac accumulation of
+//      sigin[i + k] * coef[k] for k = 0...ord - 1
+//
+//  INPUT:
+//		sigin     - Pointer to the input signal (len + ord - 1 samples, the
+//                  first ord - 1 samples are the filter history)
+//      coef      - Pointer to the filter coefficients
+//      ord       - number of filter coefficients
+//      len       - number of output samples
+//
+//	OUTPUT:
+//		sigout    - Pointer to the output signal
+//
+//	RETURN:
+//		None
+//
+//-----------------------------------------------------------------------------
+void v_fir(Word16* sigin, const Word16* coef, Word16 ord, Word16* sigout, Word16 len)
+{
+    Word32 L_sum;
+    Word16 i = 0, k;
+
+    // eight outputs are accumulated side by side, each one in the original order, so the
+    // saturation of every L_mac is reproduced exactly
+#if defined(VEC_SUB_SSE2)
+    const __m128i mult_sat = _mm_set1_epi32(0x40000000);
+    for (; i + 8 <= len; i += 8) {
+        __m128i acc_lo = _mm_setzero_si128(), acc_hi = _mm_setzero_si128();
+        for (k = 0; k < ord; k++) {
+            __m128i lo, hi;
+            mult_x8(_mm_loadu_si128((const __m128i*)(sigin + i + k)), _mm_set1_epi16(coef[k]), &lo, &hi);
+
+            // L_mult; the product is doubled, with MIN_16 * MIN_16 saturating to MAX_32
+            lo = _mm_xor_si128(_mm_slli_epi32(lo, 1), _mm_cmpeq_epi32(lo, mult_sat));
+            hi = _mm_xor_si128(_mm_slli_epi32(hi, 1), _mm_cmpeq_epi32(hi, mult_sat));
+
+            acc_lo = L_add_x4(acc_lo, lo);
+            acc_hi = L_add_x4(acc_hi, hi);
+        }
+
+        _mm_storeu_si128((__m128i*)(sigout + i), L_round_x8(acc_lo, acc_hi));
+    }
+#elif defined(VEC_SUB_NEON)
+    for (; i + 8 <= len; i += 8) {
+        int32x4_t acc_lo = vdupq_n_s32(0), acc_hi = vdupq_n_s32(0);
+        for (k = 0; k < ord; k++) {
+            int16x8_t x = vld1q_s16(sigin + i + k);
+            int16x4_t c = vdup_n_s16(coef[k]);
+
+            // vqdmlal is L_mac
+            acc_lo = vqdmlal_s16(acc_lo, vget_low_s16(x), c);
+            acc_hi = vqdmlal_s16(acc_hi, vget_high_s16(x), c);
+        }
+
+        // vqrshrn is L_round
+        vst1q_s16(sigout + i, vcombine_s16(vqrshrn_n_s32(acc_lo, 16), vqrshrn_n_s32(acc_hi, 16)));
+    }
+#endif
+
+    for (; i < len; i++) {
+        L_sum = 0;
+        for (k = 0; k < ord; k++)
+            L_sum = L_mac(L_sum, sigin[i + k], coef[k]);
+
+        sigout[i] = L_round(L_sum);
+    }
+}
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//		Perform the radix-2 FFT butterflies for one group of a stage
+//
+//  INPUT:
+//		data_a    - Pointer to the complex (re, im) top inputs
+//		data_b    - Pointer to the complex (re, im) bottom inputs
+//      wr        - Pointer to the real part of the twiddle factors
+//      wi        - Pointer to the imaginary part of the twiddle factors
+//      count     - number of butterflies
+//
+//	OUTPUT:
+//		Butterfly results in data_a and data_b
+//
+//	RETURN:
+//		None
+//
+//-----------------------------------------------------------------------------
+void v_fft_bfly(Word16* data_a, Word16* data_b, const Word16* wr, const Word16* wi, Word16 count)
+{
+    Word32 L_tempr, L_tempi, L_temp1, L_temp2;
+    Word16 k = 0;
+
+    // L_shr(L_mult(w, d), 1) is the plain product w * d, except for MIN_16 * MIN_16 which saturates
+    // to 0x3FFFFFFF; the sums forming tempr and tempi can then never saturate, only the final
+    // additions of the top input can
+#if defined(VEC_SUB_SSE2)
+    const __m128i mult_sat = _mm_set1_epi32(0x40000000);
+    const __m128i neg_re = _mm_set_epi32(0, -1, 0, -1);
+    const __m128i zero = _mm_setzero_si128();
+    for (; k + 4 <= count; k += 4) {
+        __m128i b = _mm_loadu_si128((const __m128i*)(data_b + 2 * k));
+        __m128i a = _mm_loadu_si128((const __m128i*)(data_a + 2 * k));
+
+        __m128i wr4 = _mm_loadl_epi64((const __m128i*)(wr + k));
+        __m128i wi4 = _mm_loadl_epi64((const __m128i*)(wi + k));
+        wr4 = _mm_unpacklo_epi16(wr4, wr4);
+        wi4 = _mm_unpacklo_epi16(wi4, wi4);
+
+        // (re * wr, im * wr) and (re * wi, im * wi) for each butterfly
+        __m128i p_lo, p_hi, q_lo, q_hi;
+        mult_x8(b, wr4, &p_lo, &p_hi);
+        mult_x8(b, wi4, &q_lo, &q_hi);
+        p_lo = _mm_add_epi32(p_lo, _mm_cmpeq_epi32(p_lo, mult_sat));
+        p_hi = _mm_add_epi32(p_hi, _mm_cmpeq_epi32(p_hi, mult_sat));
+        q_lo = _mm_add_epi32(q_lo, _mm_cmpeq_epi32(q_lo, mult_sat));
+        q_hi = _mm_add_epi32(q_hi, _mm_cmpeq_epi32(q_hi, mult_sat));
+
+        // (tempr, tempi) = (re * wr - im * wi, im * wr + re * wi)
+        q_lo = _mm_shuffle_epi32(q_lo, _MM_SHUFFLE(2, 3, 0, 1));
+        q_hi = _mm_shuffle_epi32(q_hi, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128i t_lo = _mm_add_epi32(p_lo, _mm_sub_epi32(_mm_xor_si128(q_lo, neg_re), neg_re));
+        __m128i t_hi = _mm_add_epi32(p_hi, _mm_sub_epi32(_mm_xor_si128(q_hi, neg_re), neg_re));
+
+        // L_shr(L_deposit_h(a), 1)
+        __m128i a_lo = _mm_srai_epi32(_mm_unpacklo_epi16(zero, a), 1);
+        __m128i a_hi = _mm_srai_epi32(_mm_unpackhi_epi16(zero, a), 1);
+
+        _mm_storeu_si128((__m128i*)(data_b + 2 * k), L_round_x8(L_sub_x4(a_lo, t_lo), L_sub_x4(a_hi, t_hi)));
+        _mm_storeu_si128((__m128i*)(data_a + 2 * k), L_round_x8(L_add_x4(a_lo, t_lo), L_add_x4(a_hi, t_hi)));
+    }
+#elif defined(VEC_SUB_NEON)
+    static const int32_t NEG_RE[4U] = { -1, 1, -1, 1 };
+    const int32x4_t neg_re = vld1q_s32(NEG_RE);
+    const int32x4_t mult_sat = vdupq_n_s32(0x40000000);
+    for (; k + 4 <= count; k += 4) {
+        int16x8_t b = vld1q_s16(data_b + 2 * k);
+        int16x8_t a = vld1q_s16(data_a + 2 * k);
+
+        int16x4_t wr4 = vld1_s16(wr + k);
+        int16x4_t wi4 = vld1_s16(wi + k);
+        int16x4x2_t wr2 = vzip_s16(wr4, wr4);
+        int16x4x2_t wi2 = vzip_s16(wi4, wi4);
+
+        // (re * wr, im * wr) and (re * wi, im * wi) for each butterfly
+        int32x4_t p_lo = vmull_s16(vget_low_s16(b), wr2.val[0]);
+        int32x4_t p_hi = vmull_s16(vget_high_s16(b), wr2.val[1]);
+        int32x4_t q_lo = vmull_s16(vget_low_s16(b), wi2.val[0]);
+        int32x4_t q_hi = vmull_s16(vget_high_s16(b), wi2.val[1]);
+        p_lo = vaddq_s32(p_lo, vreinterpretq_s32_u32(vceqq_s32(p_lo, mult_sat)));
+        p_hi = vaddq_s32(p_hi, vreinterpretq_s32_u32(vceqq_s32(p_hi, mult_sat)));
+        q_lo = vaddq_s32(q_lo, vreinterpretq_s32_u32(vceqq_s32(q_lo, mult_sat)));
+        q_hi = vaddq_s32(q_hi, vreinterpretq_s32_u32(vceqq_s32(q_hi, mult_sat)));
+
+        // (tempr, tempi) = (re * wr - im * wi, im * wr + re * wi)
+        int32x4_t t_lo = vaddq_s32(p_lo, vmulq_s32(vrev64q_s32(q_lo), neg_re));
+        int32x4_t t_hi = vaddq_s32(p_hi, vmulq_s32(vrev64q_s32(q_hi), neg_re));
+
+        // L_shr(L_deposit_h(a), 1)
+        int32x4_t a_lo = vshll_n_s16(vget_low_s16(a), 15);
+        int32x4_t a_hi = vshll_n_s16(vget_high_s16(a), 15);
+
+        vst1q_s16(data_b + 2 * k, vcombine_s16(vqrshrn_n_s32(vqsubq_s32(a_lo, t_lo), 16), vqrshrn_n_s32(vqsubq_s32(a_hi, t_hi), 16)));
+        vst1q_s16(data_a + 2 * k, vcombine_s16(vqrshrn_n_s32(vqaddq_s32(a_lo, t_lo), 16), vqrshrn_n_s32(vqaddq_s32(a_hi, t_hi), 16)));
+    }
+#endif
+
+    for (; k < count; k++) {
+        Word16* a = &data_a[2 * k];
+        Word16* b = &data_b[2 * k];
+
+        // tempr = wr * b.re - wi * b.im
+        L_temp1 = L_shr(L_mult(wr[k], b[0]), 1);
+        L_temp2 = L_shr(L_mult(wi[k], b[1]), 1);
+        L_tempr = L_sub(L_temp1, L_temp2);
+
+        // tempi = wr * b.im + wi * b.re
+        L_temp1 = L_shr(L_mult(wr[k], b[1]), 1);
+        L_temp2 = L_shr(L_mult(wi[k], b[0]), 1);
+        L_tempi = L_add(L_temp1, L_temp2);
+
+        // b.re = a.re - tempr, a.re += tempr
+        L_temp1 = L_shr(L_deposit_h(a[0]), 1);
+        b[0] = L_round(L_sub(L_temp1, L_tempr));
+        a[0] = L_round(L_add(L_temp1, L_tempr));
+
+        // b.im = a.im - tempi, a.im += tempi
+        L_temp1 = L_shr(L_deposit_h(a[1]), 1);
+        b[1] = L_round(L_sub(L_temp1, L_tempi));
+        a[1] = L_round(L_add(L_temp1, L_tempi));
+    }
+}
@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - MBE Vocoder
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#ifndef __VEC_SUB_H__
+#define __VEC_SUB_H__
+
+// ---------------------------------------------------------------------------
+//	 Global Functions
+// ---------------------------------------------------------------------------
+
+// These kernels replace the inner loops of the encoder that were written in terms of the
+// basic operators. Each one has an SSE2 (or NEON) path and a scalar path that is the original
+// loop; the vector paths produce bit-exact results, including saturation. The vector paths do
+// not maintain the Overflow flag, which none of the encoder or decoder code reads.
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//			Compute the sum of square magnitude of a 16 bit input vector
+//		    with saturation and truncation.  Output is a 32 bit number.
+//
+//	INPUT:
+//		vec       - Pointer to the vector
+//      n         - size of input vectors
+//
+//	OUTPUT:
+//		none
+//
+//	RETURN:
+//		32 bit long signed integer result
+//
+//-----------------------------------------------------------------------------
+Word32 L_v_magsq(Word16 *vec, Word16 n);
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//			Compute the sum of square magnitude of the difference of two
+//          16 bit input vectors (sub(vec1[i], vec2[i])) with saturation
+//          and truncation.  Output is a 32 bit number.
+//
+//	INPUT:
+//		vec1      - Pointer to the first vector
+//		vec2      - Pointer to the second vector
+//      n         - size of input vectors
+//
+//	OUTPUT:
+//		none
+//
+//	RETURN:
+//		32 bit long signed integer result
+//
+//-----------------------------------------------------------------------------
+Word32 L_v_magsq_diff(Word16 *vec1, Word16 *vec2, Word16 n);
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//		Compute the autocorrelation of a 16 bit input vector for a range
+//      of time shifts; each term is L_shr(L_mult(vec[i], vec[i + shift]), scale)
+//      accumulated with L_add
+//
+//  INPUT:
+//		vec       - Pointer to the vector
+//      n         - size of input vector
+//      shift_min - first time shift
+//      shift_max - last time shift
+//      scale     - right shift applied to each term
+//      step      - distance between results in corr
+//
+//	OUTPUT:
+//		corr      - autocorrelation for each time shift
+//
+//	RETURN:
+//		None
+//
+//-----------------------------------------------------------------------------
+void v_autocorr(Word16 *vec, Word16 n, Word16 shift_min, Word16 shift_max, Word16 scale, Word32 *corr, Word16 step);
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//		FIR filter; each output is L_round of the L_mac accumulation of
+//      sigin[i + k] * coef[k] for k = 0...ord - 1
+//
+//  INPUT:
+//		sigin     - Pointer to the input signal (len + ord - 1 samples, the
+//                  first ord - 1 samples are the filter history)
+//      coef      - Pointer to the filter coefficients
+//      ord       - number of filter coefficients
+//      len       - number of output samples
+//
+//	OUTPUT:
+//		sigout    - Pointer to the output signal
+//
+//	RETURN:
+//		None
+//
+//-----------------------------------------------------------------------------
+void v_fir(Word16 *sigin, const Word16 *coef, Word16 ord, Word16 *sigout, Word16 len);
+
+//-----------------------------------------------------------------------------
+//	PURPOSE:
+//		Perform the radix-2 FFT butterflies for one group of a stage
+//
+//  INPUT:
+//		data_a    - Pointer to the complex (re, im) top inputs
+//		data_b    - Pointer to the complex (re, im) bottom inputs
+//      wr        - Pointer to the real part of the twiddle factors
+//      wi        - Pointer to the imaginary part of the twiddle factors
+//      count     - number of butterflies
+//
+//	OUTPUT:
+//		Butterfly results in data_a and data_b
+//
+//	RETURN:
+//		None
+//
+//-----------------------------------------------------------------------------
+void v_fft_bfly(Word16 *data_a, Word16 *data_b, const Word16 *wr, const Word16 *wi, Word16 count);
+
+#endif // __VEC_SUB_H__
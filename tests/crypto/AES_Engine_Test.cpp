@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/AESCrypto.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace crypto;
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include <stdlib.h>
+#include <vector>
+
+static const AESEngine ENGINES[] = { AESEngine::PORTABLE, AESEngine::AES_NI, AESEngine::ARMV8_CE };
+
+TEST_CASE("AES", "[Engine Test]") {
+    SECTION("AES_Engine_Vector_Test") {
+        INFO("AES Engine FIPS-197 Vector Test");
+
+        // FIPS-197 Appendix C example vectors
+        const uint8_t plain[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF };
+        uint8_t key[32];
+        for (uint8_t i = 0U; i < 32U; i++)
+            key[i] = i;
+
+        const struct {
+            AESKeyLength keyLength;
+            uint8_t cipher[16];
+        } vectors[] = {
+            { AESKeyLength::AES_128, { 0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30, 0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A } },
+            { AESKeyLength::AES_192, { 0xDD, 0xA9, 0x7C, 0xA4, 0x86, 0x4C, 0xDF, 0xE0, 0x6E, 0xAF, 0x70, 0xA0, 0xEC, 0x0D, 0x71, 0x91 } },
+            { AESKeyLength::AES_256, { 0x8E, 0xA2, 0xB7, 0xCA, 0x51, 0x67, 0x45, 0xBF, 0xEA, 0xFC, 0x49, 0x90, 0x4B, 0x49, 0x60, 0x89 } }
+        };
+
+        for (AESEngine engine : ENGINES) {
+            if (!AES::isEngineSupported(engine))
+                continue;
+
+            for (auto& vector : vectors) {
+                AES aes(vector.keyLength);
+                REQUIRE(aes.setEngine(engine));
+
+                // buffer API, uncached key
+                uint8_t* crypted = aes.encryptECB(plain, 16U, key);
+                REQUIRE(::memcmp(crypted, vector.cipher, 16U) == 0);
+                uint8_t* decrypted = aes.decryptECB(crypted, 16U, key);
+                REQUIRE(::memcmp(decrypted, plain, 16U) == 0);
+                delete[] crypted;
+                delete[] decrypted;
+
+                // in place API, cached key
+                uint8_t buffer[16];
+                ::memcpy(buffer, plain, 16U);
+                aes.setKey(key);
+                REQUIRE(aes.encryptECBInPlace(buffer, 16U));
+                REQUIRE(::memcmp(buffer, vector.cipher, 16U) == 0);
+                REQUIRE(aes.decryptECBInPlace(buffer, 16U));
+                REQUIRE(::memcmp(buffer, plain, 16U) == 0);
+
+                REQUIRE(!aes.encryptECBInPlace(buffer, 15U));
+            }
+        }
+    }
+
+    SECTION("AES_Engine_Consistency_Test") {
+        INFO("AES Engine Consistency Test");
+
+        srand(0x5A5AU);
+
+        uint8_t key[32], iv[16];
+        for (uint32_t i = 0U; i < 32U; i++)
+            key[i] = (uint8_t)rand();
+        for (uint32_t i = 0U; i < 16U; i++)
+            iv[i] = (uint8_t)rand();
+
+        // odd block counts exercise both the interleaved and the single block paths
+        const uint32_t len = 16U * 93U;
+        std::vector<uint8_t> message(len);
+        for (uint32_t i = 0U; i < len; i++)
+            message[i] = (uint8_t)rand();
+
+        AES reference(AESKeyLength::AES_256);
+        REQUIRE(reference.setEngine(AESEngine::PORTABLE));
+        uint8_t* expectedECB = reference.encryptECB(message.data(), len, key);
+        uint8_t* expectedCBC = reference.encryptCBC(message.data(), len, key, iv);
+        uint8_t* expectedCFB = reference.encryptCFB(message.data(), len, key, iv);
+
+        for (AESEngine engine : ENGINES) {
+            if (!AES::isEngineSupported(engine))
+                continue;
+
+            ::LogDebug("T", "AES_Engine_Consistency_Test, engine = %s", AES::engineName(engine));
+
+            AES aes(AESKeyLength::AES_256);
+            REQUIRE(aes.setEngine(engine));
+            aes.setKey(key);
+
+            std::vector<uint8_t> buffer(message);
+            REQUIRE(aes.encryptECBInPlace(buffer.data(), len));
+            REQUIRE(::memcmp(buffer.data(), expectedECB, len) == 0);
+            REQUIRE(aes.decryptECBInPlace(buffer.data(), len));
+            REQUIRE(buffer == message);
+
+            uint8_t* crypted = aes.encryptCBC(message.data(), len, key, iv);
+            REQUIRE(::memcmp(crypted, expectedCBC, len) == 0);
+            uint8_t* decrypted = aes.decryptCBC(crypted, len, key, iv);
+            REQUIRE(::memcmp(decrypted, message.data(), len) == 0);
+            delete[] crypted;
+            delete[] decrypted;
+
+            crypted = aes.encryptCFB(message.data(), len, key, iv);
+            REQUIRE(::memcmp(crypted, expectedCFB, len) == 0);
+            decrypted = aes.decryptCFB(crypted, len, key, iv);
+            REQUIRE(::memcmp(decrypted, message.data(), len) == 0);
+            delete[] crypted;
+            delete[] decrypted;
+        }
+
+        delete[] expectedECB;
+        delete[] expectedCBC;
+        delete[] expectedCFB;
+    }
+}
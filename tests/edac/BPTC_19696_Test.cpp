@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/edac/BPTC19696.h"
+#include "common/edac/Hamming.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace edac;
+using namespace dmr::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <string.h>
+
+TEST_CASE("BPTC", "[196,96 Test]") {
+    SECTION("BPTC_19696_Test") {
+        bool failed = false;
+
+        INFO("DMR BPTC (196,96) FEC Test");
+
+        uint8_t payload[12U] = { 0x01U, 0x23U, 0x45U, 0x67U, 0x89U, 0xABU, 0xCDU, 0xEFU, 0x5AU, 0xA5U, 0x3CU, 0xC3U };
+
+        // burst as produced by the original bit array implementation
+        const uint8_t expected[DMR_FRAME_LENGTH_BYTES] = {
+            0x09U, 0xADU, 0x6FU, 0xABU, 0x4DU, 0x01U, 0x32U, 0x43U, 0xB9U, 0x81U, 0xA6U, 0x07U, 0xC0U, 0x00U, 0x00U, 0x00U,
+            0x00U, 0x00U, 0x00U, 0x00U, 0x03U, 0x80U, 0x48U, 0xF2U, 0x4DU, 0x53U, 0xF4U, 0x85U, 0xC6U, 0x5DU, 0xE0U, 0xA3U,
+            0x3FU
+        };
+
+        BPTC19696 bptc = BPTC19696();
+
+        uint8_t burst[DMR_FRAME_LENGTH_BYTES];
+        ::memset(burst, 0x00U, DMR_FRAME_LENGTH_BYTES);
+        bptc.encode(payload, burst);
+
+        Utils::dump(2U, "BPTC_19696_Test, burst", burst, DMR_FRAME_LENGTH_BYTES);
+
+        if (::memcmp(burst, expected, DMR_FRAME_LENGTH_BYTES) != 0) {
+            ::LogDebug("T", "BPTC_19696_Test, encoded burst does not match");
+            failed = true;
+        }
+
+        // a single bit error anywhere in the payload bits must be corrected
+        for (uint32_t bit = 0U; bit < 264U; bit++) {
+            // skip the slot type and sync
+            if (bit >= 98U && bit < 166U)
+                continue;
+
+            uint8_t corrupt[DMR_FRAME_LENGTH_BYTES];
+            ::memcpy(corrupt, burst, DMR_FRAME_LENGTH_BYTES);
+            bool b = READ_BIT(corrupt, bit) != 0U;
+            WRITE_BIT(corrupt, bit, !b);
+
+            uint8_t decoded[12U];
+            bptc.decode(corrupt, decoded);
+            if (::memcmp(decoded, payload, 12U) != 0) {
+                ::LogDebug("T", "BPTC_19696_Test, failed to correct bit %u", bit);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Hamming_Packed_Test") {
+        bool failed = false;
+
+        INFO("Hamming packed codeword and bit array agreement");
+
+        // every 15-bit word, through both the packed and the bit array decoder
+        for (uint32_t w = 0U; w < 0x8000U; w++) {
+            bool d[15U];
+            for (uint32_t i = 0U; i < 15U; i++)
+                d[i] = ((w >> (14U - i)) & 1U) != 0U;
+
+            uint16_t code = (uint16_t)w;
+            bool packed = Hamming::decode15113_2(code);
+            bool unpacked = Hamming::decode15113_2(d);
+
+            uint16_t check = 0U;
+            for (uint32_t i = 0U; i < 15U; i++)
+                check = (check << 1) | (d[i] ? 1U : 0U);
+
+            if (packed != unpacked || code != check) {
+                ::LogDebug("T", "Hamming_Packed_Test, decode15113_2 mismatch for $%04X", w);
+                failed = true;
+                break;
+            }
+        }
+
+        // every 17-bit word, through both the packed and the bit array decoder
+        for (uint32_t w = 0U; w < 0x20000U; w++) {
+            bool d[17U];
+            for (uint32_t i = 0U; i < 17U; i++)
+                d[i] = ((w >> (16U - i)) & 1U) != 0U;
+
+            uint32_t code = w;
+            bool packed = Hamming::decode17123(code);
+            bool unpacked = Hamming::decode17123(d);
+
+            uint32_t check = 0U;
+            for (uint32_t i = 0U; i < 17U; i++)
+                check = (check << 1) | (d[i] ? 1U : 0U);
+
+            if (packed != unpacked || code != check) {
+                ::LogDebug("T", "Hamming_Packed_Test, decode17123 mismatch for $%05X", w);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/dmr/DMRDefines.h"
+#include "common/edac/Trellis.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace edac;
+using namespace dmr::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <string.h>
+
+TEST_CASE("Trellis", "[Trellis Test]") {
+    SECTION("Trellis_34_Test") {
+        bool failed = false;
+
+        INFO("3/4 Rate Trellis FEC Test");
+
+        uint8_t payload[18U] = {
+            0x01U, 0x23U, 0x45U, 0x67U, 0x89U, 0xABU, 0xCDU, 0xEFU, 0x5AU,
+            0xA5U, 0x3CU, 0xC3U, 0x0FU, 0xF0U, 0x96U, 0x69U, 0x12U, 0x34U
+        };
+
+        Trellis trellis = Trellis();
+
+        uint8_t burst[DMR_FRAME_LENGTH_BYTES];
+        ::memset(burst, 0x00U, DMR_FRAME_LENGTH_BYTES);
+        trellis.encode34(payload, burst, true);
+
+        Utils::dump(2U, "Trellis_34_Test, burst", burst, DMR_FRAME_LENGTH_BYTES);
+
+        uint8_t decoded[18U];
+        if (!trellis.decode34(burst, decoded, true) || ::memcmp(decoded, payload, 18U) != 0) {
+            ::LogDebug("T", "Trellis_34_Test, failed to decode clean burst");
+            failed = true;
+        }
+
+        // a single bit error anywhere in the Trellis bits must be corrected
+        for (uint32_t i = 0U; i < 196U; i++) {
+            uint32_t bit = (i >= 98U) ? i + 68U : i;
+
+            uint8_t corrupt[DMR_FRAME_LENGTH_BYTES];
+            ::memcpy(corrupt, burst, DMR_FRAME_LENGTH_BYTES);
+            bool b = READ_BIT(corrupt, bit) != 0U;
+            WRITE_BIT(corrupt, bit, !b);
+
+            if (!trellis.decode34(corrupt, decoded, true) || ::memcmp(decoded, payload, 18U) != 0) {
+                ::LogDebug("T", "Trellis_34_Test, failed to correct bit %u", bit);
+                failed = true;
+            }
+        }
+
+        // errors the hard decision decoder cannot resolve, flagged as unreliable by the demodulator
+        uint8_t corrupt[DMR_FRAME_LENGTH_BYTES];
+        ::memcpy(corrupt, burst, DMR_FRAME_LENGTH_BYTES);
+
+        uint8_t confidence[196U];
+        ::memset(confidence, 0xFFU, 196U);
+        const uint32_t errors[] = { 3U, 4U, 5U, 40U, 41U, 42U, 120U, 121U, 122U };
+        for (uint32_t i : errors) {
+            uint32_t bit = (i >= 98U) ? i + 68U : i;
+            bool b = READ_BIT(corrupt, bit) != 0U;
+            WRITE_BIT(corrupt, bit, !b);
+            confidence[i] = 0x10U;
+        }
+
+        if (!trellis.decode34(corrupt, confidence, decoded, true) || ::memcmp(decoded, payload, 18U) != 0) {
+            ::LogDebug("T", "Trellis_34_Test, failed to decode soft burst");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("Trellis_12_Test") {
+        bool failed = false;
+
+        INFO("1/2 Rate Trellis FEC Test");
+
+        uint8_t payload[12U] = { 0x01U, 0x23U, 0x45U, 0x67U, 0x89U, 0xABU, 0xCDU, 0xEFU, 0x5AU, 0xA5U, 0x3CU, 0xC3U };
+
+        Trellis trellis = Trellis();
+
+        uint8_t burst[DMR_FRAME_LENGTH_BYTES];
+        ::memset(burst, 0x00U, DMR_FRAME_LENGTH_BYTES);
+        trellis.encode12(payload, burst);
+
+        Utils::dump(2U, "Trellis_12_Test, burst", burst, DMR_FRAME_LENGTH_BYTES);
+
+        uint8_t decoded[12U];
+        if (!trellis.decode12(burst, decoded) || ::memcmp(decoded, payload, 12U) != 0) {
+            ::LogDebug("T", "Trellis_12_Test, failed to decode clean burst");
+            failed = true;
+        }
+
+        // scattered bit errors must be corrected
+        for (uint32_t start = 0U; start < 196U; start++) {
+            uint8_t corrupt[DMR_FRAME_LENGTH_BYTES];
+            ::memcpy(corrupt, burst, DMR_FRAME_LENGTH_BYTES);
+            for (uint32_t n = 0U; n < 4U; n++) {
+                uint32_t bit = (start + (n * 65U)) % 196U;
+                bool b = READ_BIT(corrupt, bit) != 0U;
+                WRITE_BIT(corrupt, bit, !b);
+            }
+
+            if (!trellis.decode12(corrupt, decoded) || ::memcmp(decoded, payload, 12U) != 0) {
+                ::LogDebug("T", "Trellis_12_Test, failed to correct errors starting at bit %u", start);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/PacketBuffer.h"
+#include "fne/network/FNENetwork.h"
+#include "fne/network/PacketWorkerPool.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// the packet handler is a plain function, so the handlers below record what they see here
+static std::mutex s_mutex;
+static std::condition_variable s_cond;
+static std::map<uint64_t, std::vector<int>> s_seen;
+static std::map<uint32_t, std::vector<int>> s_peerSeen;
+static std::atomic<uint32_t> s_handled(0U);
+static bool s_gateOpen = false;
+static bool s_gateEntered = false;
+
+static NetPacketRequest* createRequest(uint32_t peerId, uint32_t streamId, int seq, NET_FUNC::ENUM func = NET_FUNC::PROTOCOL)
+{
+    NetPacketRequest* req = PacketWorkerPool::allocRequest();
+    req->peerId = peerId;
+    req->fneHeader.setFunction(func);
+    req->fneHeader.setPeerId(peerId);
+    req->fneHeader.setStreamId(streamId);
+    req->length = seq;  // the sequence is carried in the length, there is no payload
+    return req;
+}
+
+static void recordHandler(NetPacketRequest* req)
+{
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        uint64_t key = ((uint64_t)req->peerId << 32) | req->fneHeader.getStreamId();
+        s_seen[key].push_back(req->length);
+        s_peerSeen[req->peerId].push_back(req->length);
+    }
+
+    PacketWorkerPool::freeRequest(req);
+    s_handled++;
+}
+
+static void gateHandler(NetPacketRequest* req)
+{
+    // the first request holds the worker until the gate is opened
+    std::unique_lock<std::mutex> lock(s_mutex);
+    s_gateEntered = true;
+    s_cond.notify_all();
+    s_cond.wait(lock, [] { return s_gateOpen; });
+    lock.unlock();
+
+    PacketWorkerPool::freeRequest(req);
+    s_handled++;
+}
+
+static uint32_t inUseRequests()
+{
+    uint32_t inUse = 0U;
+    for (uint32_t i = 0U; i <= PACKET_POOL_SIZE_CLASSES; i++)
+        inUse += PacketBufferPool::stats(i).inUse;
+    return inUse;
+}
+
+TEST_CASE("PacketWorkerPool", "[Dispatch Test]") {
+    SECTION("Ordering_Test") {
+        INFO("PacketWorkerPool Per-Peer Ordering Test");
+
+        s_seen.clear();
+        s_handled = 0U;
+
+        const uint32_t peerCnt = 16U;
+        const uint32_t streamCnt = 2U;
+        const int seqCnt = 500;
+
+        PacketWorkerPool pool("test", recordHandler);
+        REQUIRE(pool.start(4U, peerCnt * streamCnt * seqCnt));
+        REQUIRE(pool.workerCount() == 4U);
+
+        // interleave the streams, as they would arrive from the network
+        for (int seq = 0; seq < seqCnt; seq++) {
+            for (uint32_t peer = 0U; peer < peerCnt; peer++) {
+                for (uint32_t stream = 0U; stream < streamCnt; stream++) {
+                    REQUIRE(pool.dispatch(createRequest(9000100U + peer, 0x1000U + stream, seq)));
+                }
+            }
+        }
+
+        uint32_t total = peerCnt * streamCnt * seqCnt;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (s_handled.load() < total && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        REQUIRE(s_handled.load() == total);
+
+        pool.stop();
+
+        // every stream was handled by a single worker, in the order it was dispatched
+        std::lock_guard<std::mutex> lock(s_mutex);
+        REQUIRE(s_seen.size() == peerCnt * streamCnt);
+        for (auto& entry : s_seen) {
+            REQUIRE(entry.second.size() == (size_t)seqCnt);
+            for (int seq = 0; seq < seqCnt; seq++)
+                REQUIRE(entry.second[seq] == seq);
+        }
+    }
+
+    SECTION("Control_Ordering_Test") {
+        INFO("PacketWorkerPool Control Ordering Test");
+
+        s_peerSeen.clear();
+        s_handled = 0U;
+
+        const uint32_t peerCnt = 16U;
+        const int seqCnt = 500;
+
+        PacketWorkerPool pool("test", recordHandler);
+        REQUIRE(pool.start(4U, peerCnt * seqCnt));
+
+        // control messages each carry their own stream ID, they are still handled in order for a peer
+        uint32_t streamId = 0x1000U;
+        for (int seq = 0; seq < seqCnt; seq++) {
+            for (uint32_t peer = 0U; peer < peerCnt; peer++) {
+                NET_FUNC::ENUM func = (seq % 2 == 0) ? NET_FUNC::ANNOUNCE : NET_FUNC::PING;
+                REQUIRE(pool.dispatch(createRequest(9000100U + peer, streamId++, seq, func)));
+            }
+        }
+
+        uint32_t total = peerCnt * seqCnt;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (s_handled.load() < total && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        REQUIRE(s_handled.load() == total);
+
+        pool.stop();
+
+        std::lock_guard<std::mutex> lock(s_mutex);
+        REQUIRE(s_peerSeen.size() == peerCnt);
+        for (auto& entry : s_peerSeen) {
+            REQUIRE(entry.second.size() == (size_t)seqCnt);
+            for (int seq = 0; seq < seqCnt; seq++)
+                REQUIRE(entry.second[seq] == seq);
+        }
+    }
+
+    SECTION("QueueFull_Test") {
+        INFO("PacketWorkerPool Queue Full Test");
+
+        s_handled = 0U;
+        s_gateOpen = false;
+        s_gateEntered = false;
+
+        uint32_t inUseBefore = inUseRequests();
+
+        PacketWorkerPool pool("test", gateHandler);
+        REQUIRE(pool.start(1U, 2U));
+
+        // the first request is taken by the worker, and held there
+        REQUIRE(pool.dispatch(createRequest(9000100U, 1U, 0)));
+        {
+            std::unique_lock<std::mutex> lock(s_mutex);
+            REQUIRE(s_cond.wait_for(lock, std::chrono::seconds(10), [] { return s_gateEntered; }));
+        }
+
+        // the next two fill the queue
+        REQUIRE(pool.dispatch(createRequest(9000100U, 1U, 1)));
+        REQUIRE(pool.dispatch(createRequest(9000100U, 1U, 2)));
+
+        // the queue is full, the request is refused and remains owned by the caller
+        NetPacketRequest* req = createRequest(9000100U, 1U, 3);
+        REQUIRE(!pool.dispatch(req));
+        REQUIRE(req->peerId == 9000100U);
+        PacketWorkerPool::freeRequest(req);
+
+        json::array stats = pool.statsArray();
+        REQUIRE(stats.size() == 1U);
+        json::object worker = stats[0U].get<json::object>();
+        REQUIRE(worker["dropped"].get<uint64_t>() == 1U);
+        REQUIRE(worker["queueHighWater"].get<uint32_t>() == 2U);
+
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_gateOpen = true;
+        }
+        s_cond.notify_all();
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (s_handled.load() < 3U && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        REQUIRE(s_handled.load() == 3U);
+
+        pool.stop();
+
+        // every request, handled or refused, was returned to the packet pool
+        REQUIRE(inUseRequests() == inUseBefore);
+    }
+
+    SECTION("Stopped_Test") {
+        INFO("PacketWorkerPool Stopped Test");
+
+        PacketWorkerPool pool("test", recordHandler);
+
+        // a pool without workers refuses requests
+        NetPacketRequest* req = createRequest(9000100U, 1U, 0);
+        REQUIRE(!pool.dispatch(req));
+        PacketWorkerPool::freeRequest(req);
+        REQUIRE(!pool.dispatch(nullptr));
+    }
+}
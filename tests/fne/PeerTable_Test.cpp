@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/AffiliationLookup.h"
+#include "common/lookups/ChannelLookup.h"
+#include "fne/network/FNENetwork.h"
+#include "fne/network/PeerTable.h"
+
+using namespace network;
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Channel lookup that flags when it is released; the peer table releases a peer's channel
+ *  lookup together with its affiliations.
+ */
+class TrackedChannelLookup : public ChannelLookup {
+public:
+    TrackedChannelLookup(std::atomic<bool>& released) : ChannelLookup(), m_released(released) { /* stub */ }
+    ~TrackedChannelLookup() override { m_released = true; }
+
+private:
+    std::atomic<bool>& m_released;
+};
+
+static FNEPeerConnection* createConnection(const std::string& identity)
+{
+    FNEPeerConnection* connection = new FNEPeerConnection();
+    connection->identity(identity);
+    return connection;
+}
+
+TEST_CASE("PeerTable", "[Snapshot Test]") {
+    SECTION("Snapshot_Test") {
+        INFO("PeerTable Snapshot Test");
+
+        PeerTable table;
+        table.add(9000300U, createConnection("PEER 3"));
+        table.add(9000100U, createConnection("PEER 1"));
+        table.add(9000200U, createConnection("PEER 2"));
+        REQUIRE(table.count() == 3U);
+
+        PeerTable::Snapshot before = table.snapshot();
+        REQUIRE(before->size() == 3U);
+        REQUIRE(before->version() == table.version());
+
+        // peer records are kept sorted by peer ID
+        uint32_t lastPeerId = 0U;
+        for (const PeerEntry& peer : *before) {
+            REQUIRE(peer.peerId > lastPeerId);
+            lastPeerId = peer.peerId;
+        }
+
+        // erasing a peer publishes a new snapshot, and leaves the held snapshot (and its connection) intact
+        REQUIRE(table.erase(9000200U));
+        REQUIRE(!table.erase(9000200U));
+        REQUIRE(table.count() == 2U);
+
+        REQUIRE(before->size() == 3U);
+        FNEPeerConnection* erased = before->find(9000200U);
+        REQUIRE(erased != nullptr);
+        REQUIRE(erased->identity() == "PEER 2");
+
+        PeerTable::Snapshot after = table.snapshot();
+        REQUIRE(after->version() != before->version());
+        REQUIRE(after->size() == 2U);
+        REQUIRE(!after->has(9000200U));
+        REQUIRE(after->find(9000100U)->identity() == "PEER 1");
+        REQUIRE(after->find(9000100U) == before->find(9000100U));
+
+        // replacing a connection publishes the new one
+        table.add(9000100U, createConnection("PEER 1 (new)"));
+        REQUIRE(table.snapshot()->find(9000100U)->identity() == "PEER 1 (new)");
+        REQUIRE(after->find(9000100U)->identity() == "PEER 1");
+    }
+
+    SECTION("Affiliation_Release_Test") {
+        INFO("PeerTable Affiliation Release Test");
+
+        std::atomic<bool> released(false);
+
+        PeerTable table;
+        table.add(9000100U, createConnection("PEER 1"));
+        table.addAffiliations(9000100U, new AffiliationLookup("PEER 1", new TrackedChannelLookup(released), false));
+
+        PeerTable::Snapshot held = table.snapshot();
+        REQUIRE(held->findAffiliations(9000100U) != nullptr);
+        REQUIRE(held->entry(9000100U)->affiliations == held->findAffiliations(9000100U));
+
+        REQUIRE(table.eraseAffiliations(9000100U));
+        REQUIRE(table.snapshot()->findAffiliations(9000100U) == nullptr);
+
+        // the held snapshot keeps the affiliations alive, until it is released
+        REQUIRE(!released);
+        REQUIRE(!held->findAffiliations(9000100U)->hasGroupAff(1U));
+        held.reset();
+        REQUIRE(released);
+    }
+
+    SECTION("Thread_Cache_Test") {
+        INFO("PeerTable Thread Cache Test");
+
+        std::atomic<bool> released(false);
+
+        PeerTable table;
+        table.add(9000100U, createConnection("PEER 1"));
+        table.addAffiliations(9000100U, new AffiliationLookup("PEER 1", new TrackedChannelLookup(released), false));
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        uint32_t step = 0U;
+        bool firstHad = false, secondHad = true;
+
+        auto waitFor = [&](uint32_t s) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&] { return step >= s; });
+        };
+        auto advance = [&](uint32_t s) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                step = s;
+            }
+            cond.notify_all();
+        };
+
+        // (assertions are made from the test thread only)
+        std::thread reader([&]() {
+            // take a snapshot, and let it sit in this thread's cache
+            firstHad = table.snapshot()->findAffiliations(9000100U) != nullptr;
+            advance(1U);
+
+            // take a snapshot again, after the affiliations were erased
+            waitFor(2U);
+            secondHad = table.snapshot()->findAffiliations(9000100U) != nullptr;
+            advance(3U);
+
+            waitFor(4U);
+        });
+
+        // (the reader must be joined, so failures here are checked rather than required)
+        waitFor(1U);
+        CHECK(firstHad);
+        CHECK(table.eraseAffiliations(9000100U));
+        CHECK(table.snapshot()->findAffiliations(9000100U) == nullptr);
+
+        // the idle reader's cached snapshot still holds the erased affiliations
+        CHECK(!released);
+
+        // the reader's next snapshot replaces its cached one, releasing them
+        advance(2U);
+        waitFor(3U);
+        CHECK(!secondHad);
+        CHECK(released);
+
+        advance(4U);
+        reader.join();
+    }
+}
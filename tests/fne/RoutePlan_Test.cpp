@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/AffiliationLookup.h"
+#include "common/lookups/ChannelLookup.h"
+#include "common/lookups/TalkgroupRulesLookup.h"
+#include "fne/network/FNENetwork.h"
+#include "fne/network/PeerTable.h"
+#include "fne/network/callhandler/RoutePlan.h"
+
+using namespace network;
+using namespace network::callhandler;
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+const uint32_t SRC_PEER_ID = 9000100U;
+const uint32_t DST_PEER_ID = 9000200U;
+const uint32_t TG_ID = 1U;
+const uint32_t STREAM_ID = 0x1234U;
+
+/**
+ * @brief Helper to resolve a routing plan the way the call handlers do; a group call is routed to
+ *  the peers affiliated to the talkgroup.
+ */
+static std::shared_ptr<const RoutePlan> resolvePlan(RoutePlanCache& cache, PeerTable& peers, TalkgroupRulesLookup& rules,
+    uint32_t invalidations, bool& rebuilt)
+{
+    uint64_t generation = RoutePlanCache::generation(peers, &rules, invalidations);
+    std::shared_ptr<const RoutePlan> cached = cache.find(TG_ID, 0U, STREAM_ID, SRC_PEER_ID, true, generation);
+    rebuilt = (cached == nullptr);
+    if (cached != nullptr)
+        return cached;
+
+    std::shared_ptr<RoutePlan> plan = std::make_shared<RoutePlan>(STREAM_ID, SRC_PEER_ID, true, generation);
+
+    PeerTable::Snapshot snapshot = peers.snapshot();
+    for (const PeerEntry& peer : *snapshot) {
+        if (peer.peerId == SRC_PEER_ID)
+            continue;
+        if (peer.affiliations == nullptr || !peer.affiliations->hasGroupAff(TG_ID))
+            continue;
+
+        plan->addPeer(peer.peerId, false, TG_ID);
+    }
+
+    cache.add(TG_ID, 0U, plan);
+    return plan;
+}
+
+static AffiliationLookup* createAffiliations(const std::string& name)
+{
+    // the peer table takes ownership of the affiliations and the channel lookup
+    return new AffiliationLookup(name, new ChannelLookup(), false);
+}
+
+TEST_CASE("RoutePlan", "[Invalidation Test]") {
+    RoutePlanCache cache;
+    PeerTable peers;
+    TalkgroupRulesLookup rules("", 0U, false);
+    rules.addEntry(TG_ID, 1U, true);
+
+    peers.add(SRC_PEER_ID, new FNEPeerConnection());
+    peers.add(DST_PEER_ID, new FNEPeerConnection());
+    peers.addAffiliations(SRC_PEER_ID, createAffiliations("SRC"));
+    peers.addAffiliations(DST_PEER_ID, createAffiliations("DST"));
+
+    AffiliationLookup* dstAff = peers.snapshot()->findAffiliations(DST_PEER_ID);
+    REQUIRE(dstAff != nullptr);
+    dstAff->unitReg(1234U);
+    dstAff->groupAff(1234U, TG_ID);
+
+    bool rebuilt = false;
+    std::shared_ptr<const RoutePlan> plan = resolvePlan(cache, peers, rules, 0U, rebuilt);
+    REQUIRE(rebuilt);
+    REQUIRE(plan->peers().size() == 1U);
+    REQUIRE(plan->peers()[0U].peerId == DST_PEER_ID);
+
+    // nothing changed, the plan is reused
+    REQUIRE(resolvePlan(cache, peers, rules, 0U, rebuilt) == plan);
+    REQUIRE(!rebuilt);
+
+    SECTION("Affiliation_Test") {
+        INFO("RoutePlan Affiliation Invalidation Test");
+
+        // the last unit affiliated to the talkgroup deregisters, and the peer no longer receives it
+        REQUIRE(dstAff->unitDereg(1234U));
+
+        std::shared_ptr<const RoutePlan> next = resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+        REQUIRE(next->peers().empty());
+
+        // and a new affiliation restores it
+        dstAff->groupAff(5678U, TG_ID);
+
+        next = resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+        REQUIRE(next->peers().size() == 1U);
+
+        // releasing the talkgroup affiliations invalidates the plan too
+        REQUIRE(dstAff->clearGroupAff(TG_ID, false).size() == 1U);
+
+        next = resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+        REQUIRE(next->peers().empty());
+    }
+
+    SECTION("TalkgroupRule_Test") {
+        INFO("RoutePlan Talkgroup Rule Invalidation Test");
+
+        rules.addEntry(TG_ID, 1U, false);
+
+        resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+        resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(!rebuilt);
+
+        rules.eraseEntry(TG_ID, 1U);
+
+        resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+    }
+
+    SECTION("Peer_Test") {
+        INFO("RoutePlan Peer Invalidation Test");
+
+        // a new peer logs in
+        const uint32_t NEW_PEER_ID = 9000300U;
+        peers.add(NEW_PEER_ID, new FNEPeerConnection());
+
+        resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+
+        // the new peer gets affiliations, and a unit affiliates to the talkgroup
+        peers.addAffiliations(NEW_PEER_ID, createAffiliations("NEW"));
+        resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+
+        peers.snapshot()->findAffiliations(NEW_PEER_ID)->groupAff(1234U, TG_ID);
+        std::shared_ptr<const RoutePlan> next = resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+        REQUIRE(next->peers().size() == 2U);
+
+        // the destination peer is erased
+        peers.eraseAffiliations(DST_PEER_ID);
+        REQUIRE(peers.erase(DST_PEER_ID));
+
+        next = resolvePlan(cache, peers, rules, 0U, rebuilt);
+        REQUIRE(rebuilt);
+        REQUIRE(next->peers().size() == 1U);
+        REQUIRE(next->peers()[0U].peerId == NEW_PEER_ID);
+    }
+
+    SECTION("Explicit_Test") {
+        INFO("RoutePlan Explicit Invalidation Test");
+
+        resolvePlan(cache, peers, rules, 1U, rebuilt);
+        REQUIRE(rebuilt);
+        resolvePlan(cache, peers, rules, 1U, rebuilt);
+        REQUIRE(!rebuilt);
+    }
+
+    SECTION("Stream_Test") {
+        INFO("RoutePlan Stream Test");
+
+        // a plan is only reused for the call stream it was built for
+        uint64_t generation = RoutePlanCache::generation(peers, &rules, 0U);
+        REQUIRE(cache.find(TG_ID, 0U, STREAM_ID + 1U, SRC_PEER_ID, true, generation) == nullptr);
+        REQUIRE(cache.find(TG_ID, 0U, STREAM_ID, DST_PEER_ID, true, generation) == nullptr);
+        REQUIRE(cache.find(TG_ID, 0U, STREAM_ID, SRC_PEER_ID, false, generation) == nullptr);
+        REQUIRE(cache.find(TG_ID, 0U, STREAM_ID, SRC_PEER_ID, true, generation) == plan);
+    }
+}
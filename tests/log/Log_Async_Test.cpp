@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/Log.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::vector<std::string> logLines(const std::stringstream& ss)
+{
+    std::vector<std::string> lines;
+    std::istringstream in(ss.str());
+    std::string line;
+    while (std::getline(in, line))
+        lines.push_back(line);
+    return lines;
+}
+
+static void logStart(std::stringstream& ss)
+{
+    // the output stream must be set before the log is initialized, setting it stops the log writer
+    __InternalOutputStream(ss);
+    LogInitialise(".", "test", 0U, 0U, true);
+}
+
+static void logStop()
+{
+    LogFinalise();
+    __InternalOutputStream(std::cerr);
+    g_logDisplayLevel = 2U;
+    g_disableTimeDisplay = false;
+}
+
+TEST_CASE("Log", "[Async Test]") {
+    SECTION("Order_Test") {
+        INFO("Log Async Order Test");
+
+        std::stringstream ss;
+        logStart(ss);
+
+        for (uint32_t i = 0U; i < 500U; i++)
+            LogMessage("TEST", "entry %u", i);
+
+        uint64_t written, dropped, suppressed;
+        LogGetCounters(written, dropped, suppressed);
+        uint64_t droppedBefore = dropped;
+
+        logStop();
+        LogGetCounters(written, dropped, suppressed);
+        REQUIRE(dropped == droppedBefore);
+
+        std::vector<std::string> lines = logLines(ss);
+        REQUIRE(lines.size() == 500U);
+        for (uint32_t i = 0U; i < 500U; i++) {
+            REQUIRE(lines[i] == "M: (TEST) entry " + std::to_string(i));
+        }
+    }
+
+    SECTION("MultiProducer_Test") {
+        INFO("Log Async Multiple Producer Test");
+
+        std::stringstream ss;
+        logStart(ss);
+
+        uint64_t written, dropped, suppressed;
+        LogGetCounters(written, dropped, suppressed);
+        uint64_t writtenBefore = written, droppedBefore = dropped;
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0U; t < 4U; t++) {
+            threads.emplace_back([t]() {
+                for (uint32_t i = 0U; i < 1000U; i++)
+                    LogMessage("TEST", "thread %u entry %u", t, i);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        logStop();
+        LogGetCounters(written, dropped, suppressed);
+
+        // every entry is either written or counted as dropped, a drop is reported as its own entry
+        uint64_t lost = dropped - droppedBefore;
+        std::vector<std::string> lines = logLines(ss);
+        uint32_t entries = 0U;
+        for (const std::string& line : lines) {
+            if (line.find("M: (TEST) thread") == 0U)
+                entries++;
+        }
+        REQUIRE(entries + lost == 4000U);
+        REQUIRE(written - writtenBefore == lines.size());
+
+        // entries from a single thread keep their order
+        int32_t last[4U] = { -1, -1, -1, -1 };
+        for (const std::string& line : lines) {
+            uint32_t t, i;
+            if (::sscanf(line.c_str(), "M: (TEST) thread %u entry %u", &t, &i) == 2) {
+                REQUIRE((int32_t)i > last[t]);
+                last[t] = (int32_t)i;
+            }
+        }
+    }
+
+    SECTION("Oversized_Test") {
+        INFO("Log Async Oversized Entry Test");
+
+        std::stringstream ss;
+        logStart(ss);
+
+        // an entry too long for a queue record is written directly, after the entries queued before it
+        std::string longText(1500U, 'x');
+        LogMessage("TEST", "before");
+        LogMessage("TEST", "%s", longText.c_str());
+        LogMessage("TEST", "after");
+
+        logStop();
+
+        std::vector<std::string> lines = logLines(ss);
+        REQUIRE(lines.size() == 3U);
+        REQUIRE(lines[0U] == "M: (TEST) before");
+        REQUIRE(lines[1U] == "M: (TEST) " + longText);
+        REQUIRE(lines[2U] == "M: (TEST) after");
+    }
+
+    SECTION("InBand_Test") {
+        INFO("Log Async In-Band Entry Test");
+
+        std::stringstream ss;
+        logStart(ss);
+
+        // in-band entries are logged with the time stamp disabled, and the flag restored straight after;
+        // the entry keeps the state it was logged with, however late the writer gets to it
+        for (uint32_t i = 0U; i < 100U; i++) {
+            g_disableTimeDisplay = true;
+            ::Log(9999U, nullptr, nullptr, 0, nullptr, "in-band entry %u", i);
+            g_disableTimeDisplay = false;
+        }
+
+        logStop();
+
+        std::vector<std::string> lines = logLines(ss);
+        REQUIRE(lines.size() == 100U);
+        for (uint32_t i = 0U; i < 100U; i++) {
+            REQUIRE(lines[i] == "U: in-band entry " + std::to_string(i));
+        }
+    }
+
+    SECTION("RateLimit_Test") {
+        INFO("Log Async Rate Limit Test");
+
+        std::stringstream ss;
+        logStart(ss);
+
+        uint64_t written, dropped, suppressed;
+        LogGetCounters(written, dropped, suppressed);
+        uint64_t suppressedBefore = suppressed;
+
+        for (uint32_t i = 0U; i < 50U; i++)
+            LogWarning("TEST", "collision %u", i);
+
+        // warnings from a different call site aren't limited by the first
+        LogWarning("TEST", "other warning");
+
+        logStop();
+        LogGetCounters(written, dropped, suppressed);
+
+        std::vector<std::string> lines = logLines(ss);
+        uint32_t collisions = 0U, other = 0U;
+        for (const std::string& line : lines) {
+            if (line.find("W: (TEST) collision") == 0U)
+                collisions++;
+            if (line == "W: (TEST) other warning")
+                other++;
+        }
+
+        REQUIRE(collisions < 50U);
+        REQUIRE(collisions + (suppressed - suppressedBefore) == 50U);
+        REQUIRE(other == 1U);
+    }
+}
@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/RadioIdLookup.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+static void writeRIDFile(const std::string& filename, uint32_t start, uint32_t count)
+{
+    std::ofstream file(filename, std::ofstream::out);
+    for (uint32_t i = 0U; i < count; i++) {
+        file << (start + i) << ",1,RID " << (start + i) << "\n";
+    }
+    file.close();
+}
+
+TEST_CASE("RadioIdLookup", "[Reload Test]") {
+    const std::string filename = "/tmp/dvmtests_rid_acl.dat";
+
+    SECTION("Snapshot_Reload_Test") {
+        INFO("RadioIdLookup Snapshot Reload Test");
+
+        writeRIDFile(filename, 1000U, 100U);
+
+        RadioIdLookup lookup(filename, 0U, true);
+        REQUIRE(lookup.reload());
+        REQUIRE(lookup.size() == 100U);
+        REQUIRE(lookup.find(1050U).radioEnabled());
+        REQUIRE(lookup.find(1050U).radioAlias() == "RID 1050");
+
+        // a held snapshot is unaffected by a reload
+        RadioIdLookup::TableSnapshot before = lookup.snapshot();
+
+        writeRIDFile(filename, 2000U, 10U);
+        REQUIRE(lookup.reload());
+        REQUIRE(lookup.size() == 10U);
+        REQUIRE(lookup.find(1050U).radioDefault());
+        REQUIRE(lookup.find(2005U).radioEnabled());
+
+        REQUIRE(before->size() == 100U);
+        REQUIRE(before->find(1050U) != before->end());
+
+        // toggling a batch of entries publishes them together
+        std::vector<uint32_t> ids = { 2000U, 2001U, 3000U };
+        lookup.toggleEntries(ids, false);
+        REQUIRE(lookup.size() == 11U);
+        REQUIRE(!lookup.find(2000U).radioEnabled());
+        REQUIRE(lookup.find(2000U).radioAlias() == "RID 2000");
+        REQUIRE(!lookup.find(3000U).radioEnabled());
+        REQUIRE(!lookup.find(3000U).radioDefault());
+
+        lookup.eraseEntry(3000U);
+        REQUIRE(!lookup.hasEntry(3000U));
+
+        ::remove(filename.c_str());
+    }
+
+    SECTION("Concurrent_Reload_Test") {
+        INFO("RadioIdLookup Concurrent Reload Test");
+
+        writeRIDFile(filename, 1U, 10000U);
+
+        RadioIdLookup lookup(filename, 0U, true);
+        REQUIRE(lookup.reload());
+
+        // readers must never observe a partially loaded (or empty) table while reloads are in progress
+        std::atomic<bool> stop(false);
+        std::atomic<uint32_t> misses(0U);
+        std::thread reader([&]() {
+            uint32_t id = 1U;
+            while (!stop.load()) {
+                if (!lookup.find(id).radioEnabled())
+                    misses++;
+                id = (id % 10000U) + 1U;
+            }
+        });
+
+        for (uint32_t i = 0U; i < 10U; i++) {
+            REQUIRE(lookup.reload());
+        }
+
+        stop = true;
+        reader.join();
+
+        REQUIRE(misses.load() == 0U);
+        REQUIRE(lookup.size() == 10000U);
+
+        ::remove(filename.c_str());
+    }
+}
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/lookups/TalkgroupRulesLookup.h"
+
+using namespace lookups;
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <fstream>
+
+static void writeTGFile(const std::string& filename, const std::string& name)
+{
+    std::ofstream file(filename, std::ofstream::out);
+    file << "groupVoice:\n";
+    file << "  - name: " << name << "\n";
+    file << "    config:\n";
+    file << "      active: true\n";
+    file << "      inclusion:\n";
+    file << "        - 9000100\n";
+    file << "        - 9000101\n";
+    file << "      exclusion: []\n";
+    file << "      rewrite:\n";
+    file << "        - peerid: 9000200\n";
+    file << "          tgid: 5001\n";
+    file << "          slot: 2\n";
+    file << "      always:\n";
+    file << "        - 9000300\n";
+    file << "      preferred: []\n";
+    file << "      rid_permitted:\n";
+    file << "        - 1234\n";
+    file << "    source:\n";
+    file << "      tgid: 1\n";
+    file << "      slot: 1\n";
+    file << "  - name: TG 1 TS2\n";
+    file << "    config:\n";
+    file << "      active: true\n";
+    file << "      exclusion:\n";
+    file << "        - 9000100\n";
+    file << "    source:\n";
+    file << "      tgid: 1\n";
+    file << "      slot: 2\n";
+    file.close();
+}
+
+TEST_CASE("TalkgroupRulesLookup", "[Index Test]") {
+    const std::string filename = "/tmp/dvmtests_talkgroup_rules.yml";
+
+    SECTION("Find_Test") {
+        INFO("TalkgroupRulesLookup Find Test");
+
+        writeTGFile(filename, "TG 1 TS1");
+
+        TalkgroupRulesLookup* lookup = new TalkgroupRulesLookup(filename, 0U, true);
+        REQUIRE(lookup->reload());
+
+        // slot 0 matches the first rule for the TGID on any slot
+        REQUIRE(lookup->find(1U)->name() == "TG 1 TS1");
+        REQUIRE(lookup->find(1U, 1U)->name() == "TG 1 TS1");
+        REQUIRE(lookup->find(1U, 2U)->name() == "TG 1 TS2");
+        REQUIRE(lookup->find(2U)->isInvalid());
+        REQUIRE(lookup->find(1U, 3U)->isInvalid());
+
+        REQUIRE(lookup->findByRewrite(9000200U, 5001U)->name() == "TG 1 TS1");
+        REQUIRE(lookup->findByRewrite(9000200U, 5001U, 2U)->name() == "TG 1 TS1");
+        REQUIRE(lookup->findByRewrite(9000200U, 5001U, 1U)->isInvalid());
+        REQUIRE(lookup->findByRewrite(9000201U, 5001U)->isInvalid());
+
+        TalkgroupRuleGroupVoiceHandle tg = lookup->find(1U, 1U);
+        REQUIRE(tg->config().isIncluded(9000100U));
+        REQUIRE(!tg->config().isIncluded(9000102U));
+        REQUIRE(tg->config().isAlwaysSend(9000300U));
+        REQUIRE(tg->config().isRIDPermitted(1234U));
+        REQUIRE(!tg->config().isRIDPermitted(1235U));
+        REQUIRE(lookup->find(1U, 2U)->config().isExcluded(9000100U));
+
+        lookup->stop();
+        ::remove(filename.c_str());
+    }
+
+    SECTION("Handle_Reload_Test") {
+        INFO("TalkgroupRulesLookup Handle Reload Test");
+
+        writeTGFile(filename, "Before");
+
+        TalkgroupRulesLookup* lookup = new TalkgroupRulesLookup(filename, 0U, true);
+        REQUIRE(lookup->reload());
+
+        // a held rule handle is unaffected by a reload
+        TalkgroupRuleGroupVoiceHandle tg = lookup->find(1U, 1U);
+        REQUIRE(tg->name() == "Before");
+
+        writeTGFile(filename, "After");
+        REQUIRE(lookup->reload());
+        REQUIRE(lookup->find(1U, 1U)->name() == "After");
+
+        REQUIRE(tg->name() == "Before");
+        REQUIRE(tg->config().isIncluded(9000101U));
+
+        // modifications publish a new index
+        lookup->eraseEntry(1U, 1U);
+        REQUIRE(lookup->find(1U)->name() == "TG 1 TS2");
+        REQUIRE(lookup->findByRewrite(9000200U, 5001U)->isInvalid());
+
+        lookup->stop();
+        ::remove(filename.c_str());
+    }
+
+    SECTION("Batch_Test") {
+        INFO("TalkgroupRulesLookup Batch Test");
+
+        writeTGFile(filename, "TG 1 TS1");
+
+        TalkgroupRulesLookup* lookup = new TalkgroupRulesLookup(filename, 0U, true);
+        REQUIRE(lookup->reload());
+        uint32_t generation = lookup->generation();
+
+        // a batch of entries is published as a single update
+        TalkgroupRulesLookup::GroupVoiceList entries;
+        for (uint32_t id = 100U; id < 1100U; id++) {
+            TalkgroupRuleGroupVoiceSource source;
+            source.tgId(id);
+            source.tgSlot(1U);
+            TalkgroupRuleConfig config;
+            config.active(true);
+
+            TalkgroupRuleGroupVoice entry;
+            entry.source(source);
+            entry.config(config);
+            entries.push_back(entry);
+        }
+
+        // an entry for an existing talkgroup replaces it
+        TalkgroupRuleGroupVoiceSource source;
+        source.tgId(1U);
+        source.tgSlot(2U);
+        TalkgroupRuleConfig config;
+        config.active(true);
+        config.nonPreferred(true);
+        TalkgroupRuleGroupVoice entry;
+        entry.name("Replaced");
+        entry.source(source);
+        entry.config(config);
+        entries.push_back(entry);
+
+        lookup->addEntries(entries);
+        REQUIRE(lookup->generation() == generation + 1U);
+        REQUIRE(lookup->snapshot()->size() == 1002U);
+        REQUIRE(lookup->find(100U, 1U)->config().active());
+        REQUIRE(lookup->find(1099U)->source().tgSlot() == 1U);
+        REQUIRE(lookup->find(1U, 1U)->name() == "TG 1 TS1");
+        REQUIRE(lookup->find(1U, 2U)->name() == "Replaced");
+        REQUIRE(lookup->find(1U, 2U)->config().nonPreferred());
+
+        std::vector<std::pair<uint32_t, uint8_t>> ids;
+        for (uint32_t id = 100U; id < 1100U; id += 2U)
+            ids.push_back(std::make_pair(id, 1U));
+        ids.push_back(std::make_pair(1U, 1U));
+        ids.push_back(std::make_pair(2U, 1U));
+
+        lookup->eraseEntries(ids);
+        REQUIRE(lookup->generation() == generation + 2U);
+        REQUIRE(lookup->snapshot()->size() == 501U);
+        REQUIRE(lookup->find(100U, 1U)->isInvalid());
+        REQUIRE(!lookup->find(101U, 1U)->isInvalid());
+        REQUIRE(lookup->find(1U)->name() == "Replaced");
+
+        lookup->stop();
+        ::remove(filename.c_str());
+    }
+}
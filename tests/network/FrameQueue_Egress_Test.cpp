@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/FrameQueue.h"
+#include "common/network/udp/Socket.h"
+#include "common/Log.h"
+
+using namespace network;
+using namespace network::frame;
+
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+static json::object egressStats(const FrameQueue& queue, uint16_t port)
+{
+    json::array stats = queue.egressStatsArray();
+    for (auto& entry : stats) {
+        json::object queueStats = entry.get<json::object>();
+        if (queueStats["port"].get<uint16_t>() == port)
+            return queueStats;
+    }
+
+    return json::object();
+}
+
+static std::vector<uint16_t> receive(FrameQueue& queue, uint32_t expected)
+{
+    std::vector<uint16_t> seqs;
+    for (uint32_t tries = 0U; tries < 20U && seqs.size() < expected; tries++) {
+        int count = queue.readBatch(100);
+        for (int i = 0; i < count; i++) {
+            sockaddr_storage address;
+            uint32_t addrLen = 0U;
+            RTPHeader rtpHeader;
+            RTPFNEHeader fneHeader;
+            PacketBuffer packet = queue.readBatchPacket(i, address, addrLen, &rtpHeader, &fneHeader);
+            if (!packet.empty())
+                seqs.push_back(rtpHeader.getSequence());
+        }
+    }
+
+    return seqs;
+}
+
+TEST_CASE("FrameQueue", "[Egress Test]") {
+    SECTION("Egress_Per_Destination_Test") {
+        INFO("FrameQueue Egress Per Destination Test");
+
+        // bind ephemeral ports, so the test never collides with anything already listening
+        udp::Socket rxSocketA("127.0.0.1");
+        REQUIRE(rxSocketA.openEphemeral(AF_INET));
+        udp::Socket rxSocketB("127.0.0.1");
+        REQUIRE(rxSocketB.openEphemeral(AF_INET));
+        const uint16_t portA = rxSocketA.getLocalPort();
+        const uint16_t portB = rxSocketB.getLocalPort();
+        REQUIRE(portA != 0U);
+        REQUIRE(portB != 0U);
+        FrameQueue rxQueueA(&rxSocketA, 1000U, false);
+        FrameQueue rxQueueB(&rxSocketB, 2000U, false);
+
+        udp::Socket txSocket;
+        REQUIRE(txSocket.open(AF_INET));
+        FrameQueue txQueue(&txSocket, 1234U, false);
+        txQueue.setEgressFlush(4U, 0U);
+
+        sockaddr_storage addrA, addrB;
+        uint32_t addrLenA = 0U, addrLenB = 0U;
+        REQUIRE(udp::Socket::lookup("127.0.0.1", portA, addrA, addrLenA) == 0);
+        REQUIRE(udp::Socket::lookup("127.0.0.1", portB, addrB, addrLenB) == 0);
+
+        uint8_t message[24U];
+        for (uint32_t i = 0U; i < 24U; i++)
+            message[i] = (uint8_t)i;
+
+        // interleave traffic to both destinations; each destination flushes on its own count
+        for (uint16_t i = 0U; i < 10U; i++) {
+            txQueue.enqueueMessage(message, 24U, 5678U, 1000U, 1234U, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, i, addrA, addrLenA);
+            if (i < 6U)
+                txQueue.enqueueMessage(message, 24U, 5678U, 2000U, 1234U, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, i, addrB, addrLenB);
+        }
+
+        json::object statsA = egressStats(txQueue, portA);
+        json::object statsB = egressStats(txQueue, portB);
+        REQUIRE(statsA["peerId"].get<uint32_t>() == 1000U);
+        REQUIRE(statsA["enqueued"].get<uint64_t>() == 10U);
+        REQUIRE(statsA["sent"].get<uint64_t>() == 8U);
+        REQUIRE(statsA["pending"].get<uint32_t>() == 2U);
+        REQUIRE(statsB["peerId"].get<uint32_t>() == 2000U);
+        REQUIRE(statsB["sent"].get<uint64_t>() == 4U);
+        REQUIRE(statsB["pending"].get<uint32_t>() == 2U);
+
+        REQUIRE(txQueue.flushQueue());
+
+        // each destination receives its datagrams in order
+        std::vector<uint16_t> seqsA = receive(rxQueueA, 10U);
+        std::vector<uint16_t> seqsB = receive(rxQueueB, 6U);
+        REQUIRE(seqsA.size() == 10U);
+        REQUIRE(seqsB.size() == 6U);
+        for (uint16_t i = 0U; i < 10U; i++)
+            REQUIRE(seqsA[i] == i);
+        for (uint16_t i = 0U; i < 6U; i++)
+            REQUIRE(seqsB[i] == i);
+
+        // nothing pending is not a successful flush
+        REQUIRE(!txQueue.flushQueue());
+
+        txSocket.close();
+        rxSocketA.close();
+        rxSocketB.close();
+    }
+
+    SECTION("Egress_Overflow_Test") {
+        INFO("FrameQueue Egress Overflow Test");
+
+        udp::Socket rxSocket("127.0.0.1");
+        REQUIRE(rxSocket.openEphemeral(AF_INET));
+        const uint16_t port = rxSocket.getLocalPort();
+        REQUIRE(port != 0U);
+
+        udp::Socket txSocket;
+        REQUIRE(txSocket.open(AF_INET));
+        FrameQueue txQueue(&txSocket, 1234U, false);
+        // hold everything queued, so the queue fills
+        txQueue.setEgressFlush(EGRESS_QUEUE_DEPTH + 1U, 0U);
+
+        sockaddr_storage addr;
+        uint32_t addrLen = 0U;
+        REQUIRE(udp::Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+        uint8_t message[24U];
+        ::memset(message, 0xA5U, 24U);
+
+        // a full destination queue drops new datagrams, rather than blocking or growing
+        for (uint32_t i = 0U; i < EGRESS_QUEUE_DEPTH + 10U; i++)
+            txQueue.enqueueMessage(message, 24U, 5678U, 1000U, 1234U, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, (uint16_t)i, addr, addrLen);
+
+        json::object stats = egressStats(txQueue, port);
+        REQUIRE(stats["pending"].get<uint32_t>() == EGRESS_QUEUE_DEPTH);
+        REQUIRE(stats["dropped"].get<uint64_t>() == 10U);
+        REQUIRE(stats["highWater"].get<uint32_t>() == EGRESS_QUEUE_DEPTH);
+
+        REQUIRE(txQueue.flushQueue());
+        stats = egressStats(txQueue, port);
+        REQUIRE(stats["pending"].get<uint32_t>() == 0U);
+        REQUIRE(stats["sent"].get<uint64_t>() == EGRESS_QUEUE_DEPTH);
+
+        txSocket.close();
+        rxSocket.close();
+    }
+
+    SECTION("Egress_Concurrent_Test") {
+        INFO("FrameQueue Egress Concurrent Test");
+
+        udp::Socket rxSocket("127.0.0.1");
+        REQUIRE(rxSocket.openEphemeral(AF_INET));
+        const uint16_t port = rxSocket.getLocalPort();
+        REQUIRE(port != 0U);
+
+        udp::Socket txSocket;
+        REQUIRE(txSocket.open(AF_INET));
+        FrameQueue txQueue(&txSocket, 1234U, false);
+        // every datagram is flushed as it is queued, and nothing is flushed on age
+        txQueue.setEgressFlush(1U, 0U);
+
+        sockaddr_storage addr;
+        uint32_t addrLen = 0U;
+        REQUIRE(udp::Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+        uint8_t message[24U];
+        ::memset(message, 0xA5U, 24U);
+
+        // producers that find the destination already being written leave their datagrams to the
+        // writer; none may be left behind once every producer returns
+        const uint32_t threadCnt = 4U;
+        const uint32_t messageCnt = 2000U;
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0U; t < threadCnt; t++) {
+            threads.emplace_back([&]() {
+                for (uint32_t i = 0U; i < messageCnt; i++)
+                    txQueue.enqueueMessage(message, 24U, 5678U, 1000U, 1234U, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR }, (uint16_t)i, addr, addrLen);
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        json::object stats = egressStats(txQueue, port);
+        // (datagrams queued faster than they are written are dropped by the backpressure)
+        uint64_t enqueued = stats["enqueued"].get<uint64_t>();
+        REQUIRE(enqueued + stats["dropped"].get<uint64_t>() == threadCnt * messageCnt);
+        REQUIRE(stats["pending"].get<uint32_t>() == 0U);
+        REQUIRE(stats["sent"].get<uint64_t>() == enqueued);
+
+        txSocket.close();
+        rxSocket.close();
+    }
+}
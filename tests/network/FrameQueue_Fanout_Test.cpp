@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/edac/CRC.h"
+#include "common/network/FrameQueue.h"
+#include "common/network/RTPHeader.h"
+#include "common/network/RTPFNEHeader.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace network;
+using namespace network::frame;
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdlib.h>
+#include <time.h>
+
+class TestFrameQueue : public FrameQueue {
+public:
+    TestFrameQueue(udp::Socket* socket) : FrameQueue(socket, 1234U, false)
+    {
+        // hold everything queued, so the queued datagrams can be inspected
+        setEgressFlush(EGRESS_QUEUE_DEPTH, 0U);
+    }
+
+    udp::BufferVector& buffers(const sockaddr_storage& addr) { return egressQueue(addr, sizeof(sockaddr_in))->buffers; }
+};
+
+TEST_CASE("FrameQueue", "[Fan-out Test]") {
+    SECTION("Fanout_Patch_Test") {
+        bool failed = false;
+
+        INFO("FrameQueue Fan-out Test");
+
+        srand((unsigned int)time(NULL));
+
+        const uint32_t len = 64U;
+        uint8_t message[len];
+        for (size_t i = 0; i < len; i++) {
+            message[i] = rand();
+        }
+
+        udp::Socket socket;
+        TestFrameQueue queue(&socket);
+
+        sockaddr_storage addr;
+        ::memset(&addr, 0x00U, sizeof(sockaddr_storage));
+        addr.ss_family = AF_INET;
+
+        FanoutFrame frame;
+        queue.prepareFanout(frame, message, len, 5678U, 1234U, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_P25 }, 10U);
+        queue.enqueueFanout(frame, 1000U, 1234U, 11U, addr, sizeof(sockaddr_in));
+        queue.enqueueFanout(frame, 2000U, 1234U, 12U, addr, sizeof(sockaddr_in), 9999U);
+
+        REQUIRE(queue.buffers(addr).size() == 2U);
+
+        for (size_t n = 0; n < queue.buffers(addr).size(); n++) {
+            udp::UDPDatagram* dgram = queue.buffers(addr)[n];
+
+            RTPHeader rtpHeader = RTPHeader();
+            RTPFNEHeader fneHeader = RTPFNEHeader();
+            rtpHeader.decode(dgram->buffer);
+            fneHeader.decode(dgram->buffer + RTP_HEADER_LENGTH_BYTES);
+
+            uint8_t* payload = dgram->buffer + RTP_HEADER_LENGTH_BYTES + RTP_EXTENSION_HEADER_LENGTH_BYTES + RTP_FNE_HEADER_LENGTH_BYTES;
+            uint16_t calc = edac::CRC::createCRC16(payload, len * 8U);
+
+            uint32_t expectedPeerId = (n == 0U) ? 1000U : 2000U;
+            uint16_t expectedSeq = (n == 0U) ? 11U : 12U;
+
+            if (fneHeader.getPeerId() != expectedPeerId || fneHeader.getStreamId() != 5678U ||
+                rtpHeader.getSequence() != expectedSeq || rtpHeader.getSSRC() != 1234U) {
+                ::LogDebug("T", "FrameQueue::enqueueFanout(), bad header, peerId = %u, streamId = %u, seq = %u, ssrc = %u", 
+                    fneHeader.getPeerId(), fneHeader.getStreamId(), rtpHeader.getSequence(), rtpHeader.getSSRC());
+                failed = true;
+            }
+
+            if (calc != fneHeader.getCRC()) {
+                ::LogDebug("T", "FrameQueue::enqueueFanout(), bad CRC, crc = $%04X, calc = $%04X", fneHeader.getCRC(), calc);
+                failed = true;
+            }
+
+            uint32_t dstId = __GET_UINT16(payload, 8U);
+            if (n == 0U && ::memcmp(payload, message, len) != 0) {
+                ::LogDebug("T", "FrameQueue::enqueueFanout(), payload modified without rewrite");
+                failed = true;
+            }
+
+            if (n == 1U && dstId != 9999U) {
+                ::LogDebug("T", "FrameQueue::enqueueFanout(), dstId not rewritten, dstId = %u", dstId);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
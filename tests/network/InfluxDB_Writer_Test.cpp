@@ -0,0 +1,335 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "fne/Defines.h"
+#include "fne/network/influxdb/BatchWriter.h"
+#include "common/Log.h"
+
+using namespace network::influxdb;
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/resource.h>
+
+// ---------------------------------------------------------------------------
+//  Class Declaration
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Minimal HTTP stand-in for an InfluxDB server; records each write body, and answers 204 (or 503,
+ *  for a set number of leading writes).
+ */
+class TestInfluxServer {
+public:
+    TestInfluxServer() : m_fd(-1), m_port(0U), m_running(false), m_connects(0U), m_failures(0U) { /* stub */ }
+    ~TestInfluxServer() { stop(); }
+
+    bool start()
+    {
+        m_fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (m_fd < 0)
+            return false;
+
+        sockaddr_in addr;
+        ::memset(&addr, 0x00U, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        if (::bind(m_fd, (sockaddr*)&addr, sizeof(addr)) < 0 || ::listen(m_fd, 4) < 0)
+            return false;
+
+        socklen_t addrLen = sizeof(addr);
+        ::getsockname(m_fd, (sockaddr*)&addr, &addrLen);
+        m_port = ntohs(addr.sin_port);
+
+        m_running = true;
+        m_thread = std::thread([this]() { serve(); });
+        return true;
+    }
+
+    void stop()
+    {
+        if (!m_running)
+            return;
+
+        m_running = false;
+        m_thread.join();
+        ::close(m_fd);
+    }
+
+    uint16_t port() const { return m_port; }
+    uint32_t connects() const { return m_connects.load(); }
+    void failures(uint32_t count) { m_failures = count; }
+
+    std::vector<std::string> bodies()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bodies;
+    }
+
+private:
+    int m_fd;
+    uint16_t m_port;
+    std::atomic<bool> m_running;
+    std::atomic<uint32_t> m_connects;
+    std::atomic<uint32_t> m_failures;
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::vector<std::string> m_bodies;
+
+    static bool wait(int fd)
+    {
+        pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        return ::poll(&pfd, 1, 50) > 0;
+    }
+
+    void serve()
+    {
+        while (m_running) {
+            if (!wait(m_fd))
+                continue;
+
+            int fd = ::accept(m_fd, nullptr, nullptr);
+            if (fd < 0)
+                continue;
+            m_connects++;
+
+            // serve requests on the connection until the client closes it
+            std::string buffer;
+            char data[4096];
+            bool open = true;
+            while (open && m_running) {
+                size_t headerEnd;
+                while (open && (headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                    if (!m_running) {
+                        open = false;
+                        break;
+                    }
+                    if (!wait(fd))
+                        continue;
+
+                    ssize_t ret = ::recv(fd, data, sizeof(data), 0);
+                    if (ret <= 0)
+                        open = false;
+                    else
+                        buffer.append(data, (size_t)ret);
+                }
+                if (!open)
+                    break;
+
+                size_t lenPos = buffer.find("Content-Length: ");
+                size_t contentLen = (lenPos < headerEnd) ? (size_t)::strtoul(buffer.c_str() + lenPos + 16U, nullptr, 10) : 0U;
+                while (open && buffer.length() < headerEnd + 4U + contentLen) {
+                    ssize_t ret = ::recv(fd, data, sizeof(data), 0);
+                    if (ret <= 0)
+                        open = false;
+                    else
+                        buffer.append(data, (size_t)ret);
+                }
+                if (!open)
+                    break;
+
+                std::string body = buffer.substr(headerEnd + 4U, contentLen);
+                buffer.erase(0U, headerEnd + 4U + contentLen);
+                if (m_failures > 0U) {
+                    m_failures--;
+                    const char* response = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+                    ::send(fd, response, ::strlen(response), 0);
+                    continue;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_bodies.push_back(body);
+                }
+
+                const char* response = "HTTP/1.1 204 No Content\r\nX-Influxdb-Version: test\r\n\r\n";
+                ::send(fd, response, ::strlen(response), 0);
+            }
+
+            ::close(fd);
+        }
+    }
+};
+
+static uint32_t countLines(const std::vector<std::string>& bodies)
+{
+    uint32_t lines = 0U;
+    for (const std::string& body : bodies) {
+        for (char c : body) {
+            if (c == '\n')
+                lines++;
+        }
+    }
+
+    return lines;
+}
+
+static uint64_t cpuTimeMs()
+{
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return (uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000U +
+        (uint64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000U;
+}
+
+static bool waitFor(std::function<bool()> condition)
+{
+    for (uint32_t i = 0U; i < 200U; i++) {
+        if (condition())
+            return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    return false;
+}
+
+TEST_CASE("InfluxDB", "[Writer Test]") {
+    SECTION("Writer_Batch_Test") {
+        INFO("InfluxDB Writer Batch Test");
+
+        TestInfluxServer server;
+        REQUIRE(server.start());
+
+        // a long flush interval, so only a full batch triggers a write
+        BatchWriter writer(ServerInfo("127.0.0.1", server.port(), "dvm", "token", "dvm"), 64U, 10U, 60000U);
+        REQUIRE(writer.start());
+
+        for (uint32_t i = 0U; i < 25U; i++) {
+            REQUIRE(QueryBuilder().meas("call_event").tag("peerId", std::to_string(i)).field("srcId", i).timestamp(1000U + i).requestAsync(&writer) == 0);
+        }
+
+        REQUIRE(waitFor([&]() { return writer.sent() == 20U; }));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        REQUIRE(writer.sent() == 20U);
+        std::vector<std::string> bodies = server.bodies();
+        REQUIRE(bodies.size() == 2U);
+        REQUIRE(countLines(bodies) == 20U);
+        REQUIRE(bodies[0].compare(0U, 21U, "call_event,peerId=0 s") == 0);
+
+        // records left pending are written when the writer stops, over the same connection
+        writer.stop();
+        bodies = server.bodies();
+        REQUIRE(bodies.size() == 3U);
+        REQUIRE(countLines(bodies) == 25U);
+        REQUIRE(writer.queued() == 25U);
+        REQUIRE(writer.sent() == 25U);
+        REQUIRE(writer.dropped() == 0U);
+        REQUIRE(server.connects() == 1U);
+
+        server.stop();
+    }
+
+    SECTION("Writer_Interval_Test") {
+        INFO("InfluxDB Writer Interval Test");
+
+        TestInfluxServer server;
+        REQUIRE(server.start());
+
+        BatchWriter writer(ServerInfo("127.0.0.1", server.port(), "dvm", "", "dvm"), 64U, 1000U, 50U);
+        REQUIRE(writer.start());
+
+        for (uint32_t i = 0U; i < 3U; i++) {
+            REQUIRE(QueryBuilder().meas("grant_event").field("dstId", i).timestamp(2000U + i).requestAsync(&writer) == 0);
+        }
+
+        // a partial batch is written once the flush interval passes
+        REQUIRE(waitFor([&]() { return writer.sent() == 3U; }));
+        REQUIRE(countLines(server.bodies()) == 3U);
+
+        writer.stop();
+        server.stop();
+    }
+
+    SECTION("Writer_Overflow_Test") {
+        INFO("InfluxDB Writer Overflow Test");
+
+        TestInfluxServer server;
+        REQUIRE(server.start());
+
+        // nothing is written until the writer starts, so the queue fills
+        BatchWriter writer(ServerInfo("127.0.0.1", server.port(), "dvm", "", "dvm"), 8U, 100U, 50U);
+        for (uint32_t i = 0U; i < 10U; i++) {
+            QueryBuilder().meas("reject_event").field("srcId", i).timestamp(3000U + i).requestAsync(&writer);
+        }
+
+        REQUIRE(writer.queued() == 8U);
+        REQUIRE(writer.dropped() == 2U);
+
+        REQUIRE(writer.start());
+        writer.stop();
+        REQUIRE(writer.sent() == 8U);
+        REQUIRE(countLines(server.bodies()) == 8U);
+
+        server.stop();
+    }
+
+    SECTION("Writer_Retry_Test") {
+        INFO("InfluxDB Writer Retry Test");
+
+        TestInfluxServer server;
+        REQUIRE(server.start());
+        server.failures(1U);
+
+        // the first batch is refused by an overloaded server, and must be written again rather than dropped
+        BatchWriter writer(ServerInfo("127.0.0.1", server.port(), "dvm", "", "dvm"), 64U, 5U, 50U);
+        REQUIRE(writer.start());
+        for (uint32_t i = 0U; i < 10U; i++) {
+            REQUIRE(QueryBuilder().meas("retry_event").field("srcId", i).timestamp(4000U + i).requestAsync(&writer) == 0);
+        }
+
+        REQUIRE(waitFor([&]() { return writer.sent() == 10U; }));
+
+        writer.stop();
+        REQUIRE(writer.sent() == 10U);
+        REQUIRE(writer.dropped() == 0U);
+        REQUIRE(countLines(server.bodies()) == 10U);
+        REQUIRE(server.bodies()[0].compare(0U, 23U, "retry_event srcId=0i 40") == 0);
+
+        server.stop();
+    }
+
+    SECTION("Writer_Backoff_Test") {
+        INFO("InfluxDB Writer Backoff Test");
+
+        TestInfluxServer server;
+        REQUIRE(server.start());
+        server.failures(1000U);
+
+        // the server refuses every write; a full batch is left pending behind the failed one
+        BatchWriter writer(ServerInfo("127.0.0.1", server.port(), "dvm", "", "dvm"), 64U, 5U, 200U);
+        REQUIRE(writer.start());
+        for (uint32_t i = 0U; i < 10U; i++) {
+            REQUIRE(QueryBuilder().meas("backoff_event").field("srcId", i).timestamp(5000U + i).requestAsync(&writer) == 0);
+        }
+
+        REQUIRE(waitFor([&]() { return writer.statsObject()["writeErrors"].get<uint64_t>() > 0U; }));
+
+        // the writer sleeps out the backoff, rather than waking for the pending batch
+        uint64_t cpuStart = cpuTimeMs();
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        REQUIRE(cpuTimeMs() - cpuStart < 200U);
+        REQUIRE(writer.sent() == 0U);
+
+        writer.stop();
+        server.stop();
+    }
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/NetMetrics.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(NO_NET_METRICS)
+TEST_CASE("NetMetrics", "[Latency Metrics Test]") {
+    SECTION("Bucket_Test") {
+        INFO("NetMetrics Histogram Bucket Test");
+
+        // every value falls in the bucket whose bounds hold it, and buckets are in order
+        uint64_t lower = 0U;
+        for (uint32_t i = 0U; i < NET_METRICS_BUCKETS; i++) {
+            uint64_t upper = NetMetrics::bucketUpperBound(i);
+            REQUIRE(upper > lower);
+            REQUIRE(NetMetrics::bucketIndex(lower) == i);
+            REQUIRE(NetMetrics::bucketIndex(upper - 1U) == i);
+
+            // relative bucket width is bounded by the sub-bucket count
+            if (lower >= NET_METRICS_SUB_BUCKETS)
+                REQUIRE((upper - lower) * NET_METRICS_SUB_BUCKETS <= lower);
+            lower = upper;
+        }
+
+        REQUIRE(NetMetrics::bucketIndex(~0ULL) == NET_METRICS_BUCKETS - 1U);
+    }
+
+    SECTION("Quantile_Test") {
+        INFO("NetMetrics Quantile Test");
+
+        uint64_t before = NetMetrics::count(NetStage::DISPATCH_PROCESS);
+
+        // recorded from several threads; 90% of samples at 100us, 10% at 20ms
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0U; t < 4U; t++) {
+            threads.emplace_back([]() {
+                for (uint32_t i = 0U; i < 10000U; i++) {
+                    uint64_t latency = ((i % 10U) == 9U) ? 20000U : 100U;
+                    NetMetrics::latency(NetStage::DISPATCH_PROCESS, 1000000U, 1000000U + latency);
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+            thread.join();
+
+        REQUIRE(NetMetrics::count(NetStage::DISPATCH_PROCESS) - before == 40000U);
+        if (before == 0U) {
+            uint64_t p50 = NetMetrics::quantile(NetStage::DISPATCH_PROCESS, 0.5);
+            uint64_t p99 = NetMetrics::quantile(NetStage::DISPATCH_PROCESS, 0.99);
+            REQUIRE(p50 > 100U);
+            REQUIRE(p50 <= 107U);
+            REQUIRE(p99 > 20000U);
+            REQUIRE(p99 <= 21504U);
+        }
+    }
+
+    SECTION("Exposition_Test") {
+        INFO("NetMetrics Prometheus Exposition Test");
+
+        NetMetrics::packet(0x00U, 0x01U, 9000123U, 55U);
+        NetMetrics::packet(0x00U, 0x01U, 9000123U, 45U);
+        NetMetrics::latency(NetStage::RX_DISPATCH, 1000U, 1050U);
+
+        std::string text = NetMetrics::prometheus();
+        REQUIRE(text.find("# TYPE dvm_fne_stage_latency_seconds histogram\n") != std::string::npos);
+        REQUIRE(text.find("dvm_fne_stage_latency_seconds_bucket{stage=\"rx_dispatch\",le=\"+Inf\"}") != std::string::npos);
+        REQUIRE(text.find("dvm_fne_stage_latency_quantile_seconds{stage=\"egress_send\",quantile=\"0.99\"}") != std::string::npos);
+        REQUIRE(text.find("dvm_fne_packets_total{function=\"0x00\",subfunction=\"0x01\"} 2\n") != std::string::npos);
+        REQUIRE(text.find("dvm_fne_peer_packets_total{peer=\"9000123\"} 2\n") != std::string::npos);
+        REQUIRE(text.find("dvm_fne_peer_bytes_total{peer=\"9000123\"} 100\n") != std::string::npos);
+
+        // cumulative bucket counts never decrease
+        uint64_t last = 0U;
+        size_t pos = 0U;
+        std::string prefix = "dvm_fne_stage_latency_seconds_bucket{stage=\"rx_dispatch\"";
+        while ((pos = text.find(prefix, pos)) != std::string::npos) {
+            size_t eol = text.find('\n', pos);
+            uint64_t value = std::stoull(text.substr(text.rfind(' ', eol) + 1U, eol));
+            REQUIRE(value >= last);
+            last = value;
+            pos = eol;
+        }
+        REQUIRE(last >= 1U);
+    }
+}
+#endif // !defined(NO_NET_METRICS)
@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/FrameQueue.h"
+#include "common/network/PacketBuffer.h"
+#include "common/network/udp/Socket.h"
+#include "common/Log.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+static uint64_t heapAllocs()
+{
+    uint64_t total = 0U;
+    for (uint32_t i = 0U; i <= PACKET_POOL_SIZE_CLASSES; i++)
+        total += PacketBufferPool::stats(i).heapAllocs;
+    return total;
+}
+
+TEST_CASE("PacketBuffer", "[Pool Test]") {
+    SECTION("View_Test") {
+        INFO("PacketBuffer View Test");
+
+        uint8_t data[300U];
+        for (uint32_t i = 0U; i < 300U; i++)
+            data[i] = (uint8_t)i;
+
+        PacketBuffer buffer = PacketBuffer::copyOf(data, 300U);
+        REQUIRE(buffer.length() == 300U);
+        REQUIRE(PacketBufferPool::capacity(buffer.data()) == 512U);
+        REQUIRE(::memcmp(buffer.data(), data, 300U) == 0);
+        REQUIRE(buffer.refCount() == 1U);
+
+        {
+            // views share the block, and keep it alive after the original is released
+            PacketBuffer view = buffer.view(10U, 20U);
+            REQUIRE(buffer.refCount() == 2U);
+            REQUIRE(view.data() == buffer.data() + 10U);
+            REQUIRE(view.data()[0U] == 10U);
+
+            PacketBuffer copy = view;
+            REQUIRE(copy.refCount() == 3U);
+
+            buffer.reset();
+            REQUIRE(buffer.empty());
+            REQUIRE(view.refCount() == 2U);
+
+            PacketBuffer moved = std::move(copy);
+            REQUIRE(copy.empty());
+            REQUIRE(moved.refCount() == 2U);
+            REQUIRE(moved.data()[19U] == 29U);
+        }
+
+        // oversized buffers fall back to the heap
+        PacketBufferPool::release(PacketBufferPool::alloc(PACKET_POOL_MAX_BLOCK_SIZE + 1U));
+        REQUIRE(PacketBufferPool::stats(PACKET_POOL_SIZE_CLASSES).inUse == 0U);
+    }
+
+    SECTION("Steady_State_Test") {
+        INFO("PacketBuffer Steady State Test");
+
+        // blocks allocated on one thread and released on another must be recycled through the
+        // shared pool; the number of blocks taken from the heap is bounded by the blocks in flight
+        // and the blocks parked in the thread caches, and does not grow with the packet count
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<PacketBuffer> queue;
+        bool done = false;
+
+        std::thread consumer([&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!done || !queue.empty()) {
+                if (queue.empty()) {
+                    cond.wait(lock);
+                    continue;
+                }
+
+                PacketBuffer buffer = std::move(queue.front());
+                queue.pop_front();
+                lock.unlock();
+                buffer.reset();
+                lock.lock();
+                cond.notify_all();
+            }
+        });
+
+        const uint32_t inFlight = 16U;
+        uint64_t startHeapAllocs = heapAllocs();
+        for (uint32_t i = 0U; i < 20000U; i++) {
+            PacketBuffer buffer = PacketBuffer::alloc(200U);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            while (queue.size() >= inFlight)
+                cond.wait(lock);
+            queue.push_back(std::move(buffer));
+            cond.notify_all();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+            cond.notify_all();
+        }
+        consumer.join();
+
+        REQUIRE(heapAllocs() - startHeapAllocs <= inFlight + 2U + PACKET_POOL_THREAD_CACHE_DEPTH + PACKET_POOL_TRANSFER_BATCH);
+    }
+
+    SECTION("Zero_Copy_Receive_Test") {
+        INFO("PacketBuffer Zero Copy Receive Test");
+
+        // bind an ephemeral port, so the test never collides with anything already listening
+        udp::Socket socket("127.0.0.1");
+        REQUIRE(socket.openEphemeral(AF_INET));
+        const uint16_t port = socket.getLocalPort();
+        REQUIRE(port != 0U);
+
+        sockaddr_storage addr;
+        uint32_t addrLen = 0U;
+        REQUIRE(udp::Socket::lookup("127.0.0.1", port, addr, addrLen) == 0);
+
+        FrameQueue queue(&socket, 1234U, false);
+
+        uint8_t message[33U];
+        for (uint32_t i = 0U; i < 33U; i++)
+            message[i] = (uint8_t)(i * 3U);
+
+        uint64_t warmHeapAllocs = 0U;
+        for (uint32_t i = 0U; i < 2000U; i++) {
+            if (i == 200U)
+                warmHeapAllocs = heapAllocs();
+
+            REQUIRE(queue.write(message, 33U, 5678U, 1234U, 1234U, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR },
+                (uint16_t)i, addr, addrLen));
+            REQUIRE(queue.readBatch(1000) == 1);
+
+            sockaddr_storage rxAddr;
+            uint32_t rxAddrLen = 0U;
+            frame::RTPFNEHeader fneHeader;
+            PacketBuffer packet = queue.readBatchPacket(0U, rxAddr, rxAddrLen, nullptr, &fneHeader);
+            REQUIRE(packet.length() == 33U);
+            REQUIRE(::memcmp(packet.data(), message, 33U) == 0);
+            REQUIRE(fneHeader.getStreamId() == 5678U);
+
+            // a held view remains valid over the next receive
+            if (i == 0U) {
+                REQUIRE(queue.write(message + 1U, 32U, 5678U, 1234U, 1234U, { NET_FUNC::PROTOCOL, NET_SUBFUNC::PROTOCOL_SUBFUNC_DMR },
+                    1U, addr, addrLen));
+                REQUIRE(queue.readBatch(1000) == 1);
+                REQUIRE(::memcmp(packet.data(), message, 33U) == 0);
+            }
+        }
+
+        ::LogDebug("T", "Zero_Copy_Receive_Test, heap allocations after warm-up = %llu", (unsigned long long)(heapAllocs() - warmHeapAllocs));
+        REQUIRE(heapAllocs() == warmHeapAllocs);
+
+        socket.close();
+    }
+}
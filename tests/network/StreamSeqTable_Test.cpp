@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/RTPFNEHeader.h"
+#include "common/network/StreamSeqTable.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("StreamSeqTable", "[Sequence Test]") {
+    SECTION("Sequence_Check_Test") {
+        StreamSeqTable table;
+        uint16_t expected = 0U;
+
+        INFO("StreamSeqTable Sequence Check Test");
+
+        const uint64_t streamId = 0x1234U;
+
+        REQUIRE(table.checkAndAdvance(streamId, 10U, &expected) == StreamSeqResult::NEW_STREAM);
+        REQUIRE(table.count() == 1U);
+        REQUIRE(table.get(streamId) == 11U);
+
+        REQUIRE(table.checkAndAdvance(streamId, 11U, &expected) == StreamSeqResult::IN_SEQUENCE);
+        REQUIRE(expected == 11U);
+
+        // packets 12 and 13 lost
+        REQUIRE(table.checkAndAdvance(streamId, 14U, &expected) == StreamSeqResult::GAP);
+        REQUIRE(expected == 12U);
+        REQUIRE(table.get(streamId) == 15U);
+
+        REQUIRE(table.checkAndAdvance(streamId, 14U, &expected) == StreamSeqResult::DUPLICATE);
+        REQUIRE(table.checkAndAdvance(streamId, 12U, &expected) == StreamSeqResult::OUT_OF_SEQUENCE);
+        REQUIRE(table.get(streamId) == 15U);
+
+        StreamSeqStats stats;
+        REQUIRE(table.stats(streamId, stats));
+        REQUIRE(stats.gap == 1U);
+        REQUIRE(stats.duplicate == 1U);
+        REQUIRE(stats.outOfSequence == 1U);
+
+        REQUIRE(table.erase(streamId, &stats));
+        REQUIRE(stats.gap == 1U);
+        REQUIRE(!table.has(streamId));
+        REQUIRE(table.count() == 0U);
+        REQUIRE(table.get(streamId) == RTP_END_OF_CALL_SEQ);
+
+        StreamSeqStats totals = table.totals();
+        REQUIRE(totals.gap == 1U);
+        REQUIRE(totals.duplicate == 1U);
+        REQUIRE(totals.outOfSequence == 1U);
+    }
+
+    SECTION("Sequence_Wrap_Test") {
+        StreamSeqTable table;
+        uint16_t expected = 0U;
+
+        INFO("StreamSeqTable Sequence Wrap Test");
+
+        const uint64_t streamId = 0x5678U;
+
+        REQUIRE(StreamSeqTable::nextSeq(RTP_END_OF_CALL_SEQ - 1U) == 0U);
+
+        REQUIRE(table.checkAndAdvance(streamId, RTP_END_OF_CALL_SEQ - 2U, &expected) == StreamSeqResult::NEW_STREAM);
+        REQUIRE(table.checkAndAdvance(streamId, RTP_END_OF_CALL_SEQ - 1U, &expected) == StreamSeqResult::IN_SEQUENCE);
+        REQUIRE(table.checkAndAdvance(streamId, 0U, &expected) == StreamSeqResult::IN_SEQUENCE);
+        REQUIRE(table.checkAndAdvance(streamId, 1U, &expected) == StreamSeqResult::IN_SEQUENCE);
+
+        // end of call sequence is never tracked
+        REQUIRE(table.checkAndAdvance(streamId, RTP_END_OF_CALL_SEQ, &expected) == StreamSeqResult::UNTRACKED);
+        REQUIRE(table.get(streamId) == 2U);
+
+        // legacy increment semantics
+        REQUIRE(table.increment(0x9999U, 5U) == 0U);
+        REQUIRE(table.get(0x9999U) == 5U);
+        REQUIRE(table.increment(0x9999U, 5U) == 6U);
+    }
+
+    SECTION("Eviction_Test") {
+        StreamSeqTable table;
+
+        INFO("StreamSeqTable Eviction Test");
+
+        for (uint64_t i = 1U; i <= STREAM_SEQ_TABLE_CAPACITY; i++)
+            REQUIRE(table.checkAndAdvance(i, 0U) == StreamSeqResult::NEW_STREAM);
+        REQUIRE(table.count() == STREAM_SEQ_TABLE_CAPACITY);
+
+        // touch every stream except the first, making it the least recently used
+        for (uint64_t i = 2U; i <= STREAM_SEQ_TABLE_CAPACITY; i++)
+            REQUIRE(table.checkAndAdvance(i, 1U) == StreamSeqResult::IN_SEQUENCE);
+
+        REQUIRE(table.checkAndAdvance(STREAM_SEQ_TABLE_CAPACITY + 1U, 0U) == StreamSeqResult::NEW_STREAM);
+        REQUIRE(table.evicted() == 1U);
+        REQUIRE(!table.has(1U));
+        REQUIRE(table.has(STREAM_SEQ_TABLE_CAPACITY + 1U));
+
+        // erase with tombstones must not break probing for the remaining streams
+        for (uint64_t i = 2U; i <= STREAM_SEQ_TABLE_CAPACITY; i += 2U)
+            REQUIRE(table.erase(i));
+        for (uint64_t i = 3U; i <= STREAM_SEQ_TABLE_CAPACITY; i += 2U)
+            REQUIRE(table.get(i) == 2U);
+
+        table.clear();
+        REQUIRE(table.count() == 0U);
+    }
+}
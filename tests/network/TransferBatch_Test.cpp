@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/network/TransferBatch.h"
+
+using namespace network;
+
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_CASE("TransferBatch", "[Log Batch Test]") {
+    SECTION("RoundTrip_Test") {
+        INFO("TransferBatch Round Trip Test");
+
+        TransferBatch batch;
+        std::vector<std::string> expected;
+        bool full = false;
+        for (uint32_t i = 0U; i < 100U && !full; i++) {
+            std::string line = "M: 2025-01-01 00:00:00.000 (NET) PEER 9000100 message " + std::to_string(i);
+            if (i == 50U)
+                line += "\r\nwith an embedded line break";
+
+            expected.push_back(line);
+            full = batch.add(line.c_str(), 1000U + i);
+        }
+
+        REQUIRE(!full);
+        REQUIRE(batch.count() == 100U);
+        REQUIRE(!batch.expired(1000U + TRANSFER_BATCH_INTERVAL_MS - 1U));
+        REQUIRE(batch.expired(1000U + TRANSFER_BATCH_INTERVAL_MS));
+
+        uint32_t length = 0U;
+        UInt8Array buffer = batch.encode(length);
+        REQUIRE(buffer != nullptr);
+        REQUIRE(length > TRANSFER_BATCH_HDR_LEN);
+        REQUIRE(length <= TRANSFER_BATCH_HDR_LEN + TRANSFER_BATCH_MAX_PAYLOAD);
+
+        std::vector<std::string> lines;
+        REQUIRE(TransferBatch::decode(buffer.get(), length, lines));
+        REQUIRE(lines == expected);
+
+        // a damaged batch is rejected
+        buffer[length - 4U] ^= 0xFFU;
+        REQUIRE(!TransferBatch::decode(buffer.get(), length, lines));
+    }
+
+    SECTION("Full_Test") {
+        INFO("TransferBatch Full Test");
+
+        TransferBatch batch;
+        uint32_t added = 0U;
+        std::string line(100U, 'x');
+        while (!batch.add(line.c_str(), 0U))
+            added++;
+
+        REQUIRE(added + 1U == (TRANSFER_BATCH_MAX_BYTES + 101U) / 102U);
+
+        batch.clear();
+        REQUIRE(batch.empty());
+        REQUIRE(!batch.expired(TRANSFER_BATCH_INTERVAL_MS));
+    }
+
+    SECTION("Incompressible_Test") {
+        INFO("TransferBatch Incompressible Test");
+
+        // random lines don't compress into a single message, the sender falls back to writing the lines
+        std::mt19937 rng(1234U);
+        TransferBatch batch;
+        std::vector<std::string> expected;
+        while (true) {
+            std::string line;
+            for (uint32_t i = 0U; i < 200U; i++)
+                line.push_back((char)(0x21U + (rng() % 94U)));
+
+            expected.push_back(line);
+            if (batch.add(line.c_str(), 0U))
+                break;
+        }
+
+        uint32_t length = 0U;
+        UInt8Array buffer = batch.encode(length);
+        REQUIRE(buffer == nullptr);
+        REQUIRE(length == 0U);
+        REQUIRE(batch.lines() == expected);
+    }
+}
@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/nxdn/edac/Convolution.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace nxdn::edac;
+
+#include <catch2/catch_test_macros.hpp>
+#include <string.h>
+
+// 96 data bits, followed by 4 tail bits to flush the encoder; the decoder runs 4 pairs past the
+// tail, as the channel decoders do
+const uint32_t CONV_TEST_BITS = 100U;
+const uint32_t CONV_TEST_BYTES = 12U;
+const uint32_t CONV_TEST_PAIRS = CONV_TEST_BITS + 4U;
+
+const uint8_t CONV_TEST_PAYLOAD[CONV_TEST_BYTES + 1U] = {
+    0x01U, 0x23U, 0x45U, 0x67U, 0x89U, 0xABU, 0xCDU, 0xEFU, 0x5AU, 0xA5U, 0x3CU, 0xC3U, 0x00U
+};
+
+/* Helper to encode the test payload into hard decision symbols (0 = 0 bit, 2 = 1 bit). */
+
+static void encodeSymbols(uint8_t* symbols)
+{
+    Convolution conv = Convolution();
+
+    uint8_t encoded[(CONV_TEST_BITS * 2U) / 8U];
+    ::memset(encoded, 0x00U, sizeof(encoded));
+    conv.encode(CONV_TEST_PAYLOAD, encoded, CONV_TEST_BITS);
+
+    for (uint32_t i = 0U; i < CONV_TEST_PAIRS * 2U; i++)
+        symbols[i] = (i < CONV_TEST_BITS * 2U && READ_BIT(encoded, i)) ? 2U : 0U;
+}
+
+TEST_CASE("NXDN", "[Convolution Test]") {
+    SECTION("NXDN_Convolution_Block_Test") {
+        bool failed = false;
+
+        INFO("NXDN Convolution Block Decode Test");
+
+        uint8_t symbols[CONV_TEST_PAIRS * 2U];
+        encodeSymbols(symbols);
+
+        // a flipped bit and a pair of erasures, which must decode the same either way
+        symbols[17U] = 2U - symbols[17U];
+        symbols[80U] = 1U;
+        symbols[81U] = 1U;
+
+        Convolution block = Convolution();
+        block.start();
+        if (!block.decodeBlock(symbols, CONV_TEST_PAIRS)) {
+            ::LogDebug("T", "NXDN_Convolution_Block_Test, decodeBlock failed");
+            failed = true;
+        }
+
+        Convolution pair = Convolution();
+        pair.start();
+        for (uint32_t i = 0U; i < CONV_TEST_PAIRS; i++) {
+            if (!pair.decode(symbols[i * 2U], symbols[i * 2U + 1U])) {
+                ::LogDebug("T", "NXDN_Convolution_Block_Test, decode failed at pair %u", i);
+                failed = true;
+            }
+        }
+
+        uint8_t blockOut[CONV_TEST_BYTES + 1U], pairOut[CONV_TEST_BYTES + 1U];
+        ::memset(blockOut, 0x00U, sizeof(blockOut));
+        ::memset(pairOut, 0x00U, sizeof(pairOut));
+        uint32_t blockErrs = block.chainback(blockOut, CONV_TEST_BITS);
+        uint32_t pairErrs = pair.chainback(pairOut, CONV_TEST_BITS);
+
+        Utils::dump(2U, "NXDN_Convolution_Block_Test, decoded", blockOut, CONV_TEST_BYTES);
+
+        if (blockErrs != pairErrs || ::memcmp(blockOut, pairOut, CONV_TEST_BYTES) != 0) {
+            ::LogDebug("T", "NXDN_Convolution_Block_Test, decodeBlock and decode disagree, errs = %u/%u", blockErrs, pairErrs);
+            failed = true;
+        }
+
+        if (::memcmp(blockOut, CONV_TEST_PAYLOAD, CONV_TEST_BYTES) != 0) {
+            ::LogDebug("T", "NXDN_Convolution_Block_Test, failed to correct errors");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("NXDN_Convolution_MaxSteps_Test") {
+        bool failed = false;
+
+        INFO("NXDN Convolution Maximum Steps Test");
+
+        uint8_t symbols[(CONV_MAX_STEPS + 1U) * 2U];
+        ::memset(symbols, 0x00U, sizeof(symbols));
+
+        // a block longer than the decision buffer is refused
+        Convolution block = Convolution();
+        block.start();
+        if (block.decodeBlock(symbols, CONV_MAX_STEPS + 1U)) {
+            ::LogDebug("T", "NXDN_Convolution_MaxSteps_Test, decodeBlock accepted %u pairs", CONV_MAX_STEPS + 1U);
+            failed = true;
+        }
+
+        // ... at the same step the per-pair decoder refuses it
+        block.start();
+        if (!block.decodeBlock(symbols, CONV_MAX_STEPS) || block.decodeBlock(symbols, 1U)) {
+            ::LogDebug("T", "NXDN_Convolution_MaxSteps_Test, decodeBlock failed at the wrong step");
+            failed = true;
+        }
+
+        Convolution pair = Convolution();
+        pair.start();
+        for (uint32_t i = 0U; i < CONV_MAX_STEPS + 1U; i++) {
+            bool ret = pair.decode(symbols[i * 2U], symbols[i * 2U + 1U]);
+            if (ret != (i < CONV_MAX_STEPS)) {
+                ::LogDebug("T", "NXDN_Convolution_MaxSteps_Test, decode %s pair %u", ret ? "accepted" : "refused", i);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("NXDN_Convolution_Soft_Test") {
+        bool failed = false;
+
+        INFO("NXDN Convolution Soft Decode Test");
+
+        uint8_t hard[CONV_TEST_PAIRS * 2U];
+        encodeSymbols(hard);
+
+        uint8_t symbols[CONV_TEST_PAIRS * 2U];
+        for (uint32_t i = 0U; i < CONV_TEST_PAIRS * 2U; i++)
+            symbols[i] = (hard[i] != 0U) ? CONV_SOFT_SYMBOL_MAX : 0U;
+
+        // a burst of errors, each only just on the wrong side of the decision threshold
+        for (uint32_t i = 40U; i < 46U; i++)
+            symbols[i] = (hard[i] != 0U) ? (CONV_SOFT_SYMBOL_MAX / 2U) - 1U : (CONV_SOFT_SYMBOL_MAX / 2U) + 1U;
+
+        Convolution conv = Convolution();
+        conv.start();
+        if (!conv.decodeSoft(symbols, CONV_TEST_PAIRS)) {
+            ::LogDebug("T", "NXDN_Convolution_Soft_Test, decodeSoft failed");
+            failed = true;
+        }
+
+        uint8_t decoded[CONV_TEST_BYTES + 1U];
+        ::memset(decoded, 0x00U, sizeof(decoded));
+        conv.chainback(decoded, CONV_TEST_BITS);
+
+        Utils::dump(2U, "NXDN_Convolution_Soft_Test, decoded", decoded, CONV_TEST_BYTES);
+
+        if (::memcmp(decoded, CONV_TEST_PAYLOAD, CONV_TEST_BYTES) != 0) {
+            ::LogDebug("T", "NXDN_Convolution_Soft_Test, failed to recover data");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "common/p25/P25Defines.h"
+#include "common/p25/P25Utils.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace p25;
+using namespace p25::defines;
+
+#include <catch2/catch_test_macros.hpp>
+#include <string.h>
+
+TEST_CASE("P25Utils", "[Status Symbol Test]") {
+    SECTION("P25Utils_Encode_Decode_Test") {
+        bool failed = false;
+
+        INFO("P25 Status Symbol Strip/Insert Test");
+
+        uint8_t payload[P25_LDU_FRAME_LENGTH_BYTES];
+        for (uint32_t i = 0U; i < P25_LDU_FRAME_LENGTH_BYTES; i++)
+            payload[i] = (uint8_t)((i * 37U) + 11U);
+
+        // byte aligned and odd bit offsets, including ranges ending inside a status symbol
+        const uint32_t ranges[][2U] = {
+            { 0U, 72U }, { 114U, 262U }, { 262U, 410U }, { 1578U, 1726U }, { 3U, 700U }, { 69U, 71U }, { 141U, 1000U }
+        };
+
+        for (const uint32_t* range : ranges) {
+            uint32_t start = range[0U], stop = range[1U];
+
+            uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES];
+            ::memset(frame, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+            P25Utils::addStatusBits(frame, P25_LDU_FRAME_LENGTH_BITS, false, false);
+
+            uint8_t expected[P25_LDU_FRAME_LENGTH_BYTES];
+            ::memcpy(expected, frame, P25_LDU_FRAME_LENGTH_BYTES);
+
+            // reference, bit by bit
+            uint32_t n = 0U;
+            for (uint32_t i = start; i < stop; i++) {
+                uint32_t offset = i % P25_SS_INCREMENT;
+                if (offset == P25_SS0_START || offset == P25_SS1_START)
+                    continue;
+
+                bool b = READ_BIT(payload, n);
+                WRITE_BIT(expected, i, b);
+                n++;
+            }
+
+            uint32_t encoded = P25Utils::encode(payload, frame, start, stop);
+            if (encoded != n || ::memcmp(frame, expected, P25_LDU_FRAME_LENGTH_BYTES) != 0) {
+                ::LogDebug("T", "P25Utils_Encode_Decode_Test, encode mismatch for %u - %u", start, stop);
+                failed = true;
+            }
+
+            uint8_t decoded[P25_LDU_FRAME_LENGTH_BYTES];
+            ::memset(decoded, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+            uint32_t count = P25Utils::decode(frame, decoded, start, stop);
+            for (uint32_t i = 0U; i < n; i++) {
+                if (READ_BIT(decoded, i) != READ_BIT(payload, i)) {
+                    ::LogDebug("T", "P25Utils_Encode_Decode_Test, decode mismatch for %u - %u at bit %u", start, stop, i);
+                    failed = true;
+                    break;
+                }
+            }
+
+            if (count != n) {
+                ::LogDebug("T", "P25Utils_Encode_Decode_Test, decode length mismatch for %u - %u", start, stop);
+                failed = true;
+            }
+        }
+
+        // encoding by length places the data bits from the start of the frame
+        uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES];
+        uint8_t check[P25_LDU_FRAME_LENGTH_BYTES];
+        ::memset(frame, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+        ::memset(check, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+
+        uint32_t length = P25Utils::encodeByLength(payload, frame, 1000U);
+        uint32_t stop = P25Utils::encode(payload, check, 0U, length);
+        if (stop != 1000U || ::memcmp(frame, check, P25_LDU_FRAME_LENGTH_BYTES) != 0) {
+            ::LogDebug("T", "P25Utils_Encode_Decode_Test, encodeByLength mismatch");
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("P25Utils_StatusBits_Test") {
+        bool failed = false;
+
+        INFO("P25 Status Bits Test");
+
+        uint8_t frame[P25_LDU_FRAME_LENGTH_BYTES];
+        ::memset(frame, 0x00U, P25_LDU_FRAME_LENGTH_BYTES);
+        P25Utils::addStatusBits(frame, P25_LDU_FRAME_LENGTH_BITS, true, false);
+
+        // alternating busy (0,1) and unknown (1,0) status symbols, nothing else touched
+        for (uint32_t i = 0U; i < P25_LDU_FRAME_LENGTH_BITS; i++) {
+            uint32_t offset = i % P25_SS_INCREMENT;
+            bool busy = ((i / P25_SS_INCREMENT) & 1U) == 0U;
+
+            bool expected = false;
+            if (offset == P25_SS0_START)
+                expected = !busy;
+            else if (offset == P25_SS1_START)
+                expected = busy;
+
+            if ((READ_BIT(frame, i) != 0U) != expected) {
+                ::LogDebug("T", "P25Utils_StatusBits_Test, unexpected bit %u", i);
+                failed = true;
+                break;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+}
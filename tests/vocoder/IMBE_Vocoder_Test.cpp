@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: GPL-2.0-only
+/*
+ * Digital Voice Modem - Test Suite
+ * GPLv2 Open Source. Use is subject to license terms.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ *  Copyright (C) 2025 Bryan Biedenkapp, N2PLL
+ *
+ */
+#include "host/Defines.h"
+#include "vocoder/MBEEncoder.h"
+#include "common/Log.h"
+#include "common/Utils.h"
+
+using namespace vocoder;
+
+#include <catch2/catch_test_macros.hpp>
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+//  Constants
+// ---------------------------------------------------------------------------
+
+#define SAMPLES_PER_FRAME 160U
+#define SEGMENT_FRAMES 16U
+#define CORPUS_FRAMES (4U * SEGMENT_FRAMES)
+#define IMBE_CODEWORD_BYTES 11U
+
+// ---------------------------------------------------------------------------
+//  Global Functions
+// ---------------------------------------------------------------------------
+
+/* Helper to generate the reference PCM corpus; integer only, so it is identical on every platform. */
+
+static void generateCorpus(int16_t* pcm)
+{
+    const uint32_t segment = SEGMENT_FRAMES * SAMPLES_PER_FRAME;
+    uint32_t seed = 0x1234567U;
+
+    // voiced; a pulse train with a moving pitch through two formant resonators
+    int32_t y1 = 0, y2 = 0, z1 = 0, z2 = 0;
+    uint32_t period = 0U, next = 0U;
+    for (uint32_t n = 0U; n < segment; n++) {
+        int32_t x = 0;
+        if (n == next) {
+            x = 12000;
+            period = 50U + ((n / SAMPLES_PER_FRAME) * 3U) % 30U;
+            next = n + period;
+        }
+
+        int32_t y = x + ((26541 * y1 - 14787 * y2) >> 14);
+        y2 = y1; y1 = y;
+        int32_t z = y + ((17335 * z1 - 13271 * z2) >> 14);
+        z2 = z1; z1 = z;
+
+        int32_t s = z >> 2;
+        pcm[n] = (int16_t)((s > 32767) ? 32767 : ((s < -32768) ? -32768 : s));
+    }
+
+    // unvoiced; white noise
+    for (uint32_t n = segment; n < 2U * segment; n++) {
+        seed = seed * 1103515245U + 12345U;
+        pcm[n] = (int16_t)(seed >> 16) >> 2;
+    }
+
+    // overload; a full scale square wave with noise, to exercise saturation
+    for (uint32_t n = 2U * segment; n < 3U * segment; n++) {
+        seed = seed * 1103515245U + 12345U;
+        int32_t s = (((n / 37U) & 1U) != 0U) ? 32767 : -32768;
+        s += (int32_t)((int16_t)(seed >> 16) >> 4);
+        pcm[n] = (int16_t)((s > 32767) ? 32767 : ((s < -32768) ? -32768 : s));
+    }
+
+    // silence, followed by low level noise
+    for (uint32_t n = 3U * segment; n < 4U * segment; n++) {
+        seed = seed * 1103515245U + 12345U;
+        pcm[n] = (n < (3U * segment) + (segment / 2U)) ? 0 : (int16_t)((int32_t)(seed >> 29) - 4);
+    }
+}
+
+TEST_CASE("IMBE", "[Vocoder Test]") {
+    static int16_t pcm[CORPUS_FRAMES * SAMPLES_PER_FRAME];
+    generateCorpus(pcm);
+
+    SECTION("IMBE_Encode_Test") {
+        bool failed = false;
+
+        INFO("IMBE Encoder Golden Vector Test");
+
+        // codewords as produced by the original (out-of-line basic_op) encoder
+        const uint8_t expected[CORPUS_FRAMES][IMBE_CODEWORD_BYTES] = {
+            { 0x75U, 0x5FU, 0xC0U, 0xEEU, 0xF8U, 0x02U, 0x00U, 0x00U, 0x4EU, 0x77U, 0x7CU },
+            { 0x29U, 0x45U, 0xDAU, 0x96U, 0x83U, 0xDAU, 0x00U, 0x00U, 0xEDU, 0x00U, 0x0DU },
+            { 0x3FU, 0x60U, 0xF9U, 0xC7U, 0xB9U, 0x6BU, 0xFCU, 0xAFU, 0x91U, 0x53U, 0x93U },
+            { 0x3FU, 0x60U, 0xFFU, 0xCBU, 0x6CU, 0x2BU, 0xFCU, 0xBBU, 0x74U, 0x10U, 0xA3U },
+            { 0x43U, 0x50U, 0xDFU, 0xBFU, 0x78U, 0x2BU, 0xFEU, 0xBCU, 0x66U, 0x04U, 0xB5U },
+            { 0x4BU, 0x41U, 0xFFU, 0x7FU, 0xD0U, 0x17U, 0xFEU, 0x54U, 0x49U, 0x29U, 0x73U },
+            { 0x53U, 0x66U, 0xE5U, 0xDAU, 0x4FU, 0x7CU, 0xE8U, 0x30U, 0x21U, 0xB3U, 0x7FU },
+            { 0x57U, 0x47U, 0xBBU, 0xBAU, 0x87U, 0x68U, 0xFEU, 0x12U, 0x58U, 0x3FU, 0x79U },
+            { 0x5FU, 0x6AU, 0x7EU, 0x73U, 0x3EU, 0xB3U, 0xFCU, 0x10U, 0x81U, 0xBFU, 0x76U },
+            { 0x63U, 0x71U, 0x79U, 0xACU, 0xDFU, 0x92U, 0xFFU, 0x88U, 0x92U, 0x6EU, 0xFBU },
+            { 0x67U, 0x58U, 0x7BU, 0xE4U, 0xDFU, 0x1EU, 0xFFU, 0x0CU, 0x12U, 0x7FU, 0xB5U },
+            { 0x6FU, 0x62U, 0xDDU, 0xEAU, 0xEFU, 0xD0U, 0xFFU, 0x01U, 0x4FU, 0xEFU, 0x59U },
+            { 0x73U, 0x61U, 0xDEU, 0x67U, 0x7DU, 0x69U, 0xFFU, 0x06U, 0x2EU, 0x75U, 0x44U },
+            { 0x3FU, 0x60U, 0xEFU, 0xC3U, 0x6CU, 0x6BU, 0xFCU, 0xA9U, 0x69U, 0x02U, 0xB3U },
+            { 0x43U, 0x60U, 0xBFU, 0xBEU, 0xF8U, 0x0BU, 0xFCU, 0x7AU, 0x66U, 0x94U, 0x9DU },
+            { 0x4FU, 0x47U, 0xD6U, 0xFDU, 0x00U, 0xDFU, 0xF8U, 0x5EU, 0x56U, 0x57U, 0x33U },
+            { 0x4FU, 0x43U, 0xCAU, 0xAFU, 0xE2U, 0xFDU, 0xFCU, 0x43U, 0xD6U, 0x52U, 0xB5U },
+            { 0x57U, 0x47U, 0xBBU, 0xBAU, 0x97U, 0x6EU, 0xFEU, 0x1BU, 0x48U, 0xBFU, 0x6BU },
+            { 0x47U, 0x9FU, 0x00U, 0x56U, 0x47U, 0xAAU, 0x00U, 0xF1U, 0xEEU, 0x2AU, 0xF7U },
+            { 0x57U, 0xF8U, 0x6FU, 0x02U, 0xC7U, 0xC1U, 0x00U, 0x3BU, 0xD0U, 0xBFU, 0xD7U },
+            { 0xA7U, 0xDDU, 0x3CU, 0xFDU, 0xE7U, 0xD7U, 0x80U, 0x0EU, 0x7CU, 0xEFU, 0xF6U },
+            { 0xB7U, 0xAEU, 0xCDU, 0xDFU, 0xFDU, 0xE3U, 0x80U, 0x0FU, 0x7CU, 0xEFU, 0x14U },
+            { 0xABU, 0xC5U, 0x86U, 0xDEU, 0xD5U, 0x85U, 0x39U, 0xCDU, 0x7DU, 0x37U, 0x72U },
+            { 0x8FU, 0xBDU, 0x9CU, 0xF5U, 0xE6U, 0x5DU, 0x80U, 0x0FU, 0x7EU, 0xAAU, 0x63U },
+            { 0x9FU, 0xDEU, 0x26U, 0x12U, 0x0BU, 0xFAU, 0x00U, 0x0FU, 0x77U, 0xCFU, 0x72U },
+            { 0xB7U, 0xF8U, 0x6FU, 0xDEU, 0x0CU, 0x74U, 0x80U, 0x0FU, 0xF4U, 0xEFU, 0x74U },
+            { 0xC3U, 0xA5U, 0x7EU, 0xFCU, 0xAFU, 0xD9U, 0x80U, 0x0BU, 0x14U, 0xEDU, 0x5AU },
+            { 0xA3U, 0xCDU, 0xECU, 0x78U, 0xC1U, 0xDFU, 0x80U, 0x0CU, 0xF9U, 0x61U, 0xF1U },
+            { 0x97U, 0xBFU, 0x35U, 0x7FU, 0x80U, 0x22U, 0x00U, 0x0FU, 0x3CU, 0x4EU, 0x73U },
+            { 0x93U, 0xDAU, 0x0AU, 0x2AU, 0xC7U, 0xEEU, 0x00U, 0x0FU, 0xBEU, 0xF7U, 0x70U },
+            { 0x93U, 0xCEU, 0xB9U, 0x7FU, 0x92U, 0xF8U, 0x80U, 0x0CU, 0x16U, 0xD2U, 0xF2U },
+            { 0x83U, 0xDFU, 0x81U, 0x0DU, 0x71U, 0x7AU, 0x80U, 0x0DU, 0x3FU, 0xDEU, 0x65U },
+            { 0xA3U, 0xBEU, 0x7CU, 0xD7U, 0x07U, 0xD7U, 0x80U, 0x0DU, 0xFBU, 0xDEU, 0xB5U },
+            { 0x47U, 0xB2U, 0xDAU, 0x1BU, 0x66U, 0x9BU, 0x00U, 0xFDU, 0x2FU, 0x44U, 0x93U },
+            { 0x67U, 0xFFU, 0xF9U, 0xACU, 0xDFU, 0x9FU, 0x80U, 0x1AU, 0x02U, 0x6EU, 0x7DU },
+            { 0x7FU, 0xDBU, 0x8BU, 0x5CU, 0xC8U, 0x7DU, 0xB6U, 0xDCU, 0x17U, 0xFAU, 0x2CU },
+            { 0x7FU, 0xDBU, 0x0FU, 0x55U, 0xD9U, 0x54U, 0xB6U, 0xDEU, 0x55U, 0xFCU, 0x2EU },
+            { 0x5FU, 0xB9U, 0xD7U, 0xCBU, 0x12U, 0x73U, 0xA5U, 0xB7U, 0x1DU, 0x44U, 0xF8U },
+            { 0x5FU, 0xF1U, 0xD4U, 0x07U, 0x55U, 0x7CU, 0xA5U, 0xBDU, 0x73U, 0xC6U, 0x78U },
+            { 0x5BU, 0xD2U, 0xA5U, 0xCBU, 0xAEU, 0x42U, 0xADU, 0x3FU, 0xF3U, 0xB5U, 0x0FU },
+            { 0x5FU, 0xF1U, 0xD0U, 0x9FU, 0xDDU, 0xE3U, 0xADU, 0xB5U, 0x5BU, 0x8AU, 0xF8U },
+            { 0x5BU, 0xD2U, 0xA5U, 0x6BU, 0xEEU, 0x0CU, 0xADU, 0x37U, 0xABU, 0x77U, 0xAFU },
+            { 0x5FU, 0xE3U, 0xD2U, 0x5FU, 0xD8U, 0xEEU, 0xADU, 0xB5U, 0x5FU, 0x0EU, 0xF8U },
+            { 0x5FU, 0xF1U, 0xF0U, 0x0BU, 0x5FU, 0xF9U, 0xADU, 0xB1U, 0x39U, 0x82U, 0x78U },
+            { 0x5FU, 0xF1U, 0xD2U, 0x07U, 0x58U, 0x6CU, 0xADU, 0xBDU, 0x7FU, 0x44U, 0x78U },
+            { 0x5FU, 0xF1U, 0xD2U, 0x0FU, 0x5EU, 0xF1U, 0xADU, 0xB5U, 0x79U, 0x02U, 0x78U },
+            { 0x5FU, 0xF1U, 0xD2U, 0x07U, 0x58U, 0x26U, 0xADU, 0xBDU, 0x7FU, 0x4EU, 0x78U },
+            { 0x5FU, 0xF1U, 0xD0U, 0x0FU, 0x5FU, 0xF9U, 0xADU, 0xB5U, 0x39U, 0x80U, 0x68U },
+            { 0x5FU, 0xF1U, 0xF2U, 0x03U, 0x58U, 0x60U, 0xADU, 0xB9U, 0x7FU, 0x46U, 0x78U },
+            { 0x5FU, 0xF1U, 0xD2U, 0x0FU, 0x7EU, 0xF9U, 0xADU, 0xB5U, 0x59U, 0x02U, 0x78U },
+            { 0x6BU, 0xDFU, 0xF0U, 0x4AU, 0xADU, 0xEDU, 0x80U, 0x18U, 0xDDU, 0xDDU, 0xBAU },
+            { 0x01U, 0x4DU, 0x4AU, 0x93U, 0x09U, 0xD4U, 0x04U, 0x1FU, 0xA4U, 0xBAU, 0xA3U },
+            { 0x00U, 0xBEU, 0x85U, 0x04U, 0x0AU, 0xCDU, 0x14U, 0x72U, 0x17U, 0x1FU, 0x89U },
+            { 0x00U, 0xA2U, 0xF5U, 0xAFU, 0x44U, 0xEDU, 0x1EU, 0xFFU, 0x7CU, 0xA0U, 0x69U },
+            { 0x01U, 0x5DU, 0x0AU, 0x10U, 0x12U, 0x5BU, 0x05U, 0x93U, 0xFDU, 0x42U, 0xF9U },
+            { 0x01U, 0x5FU, 0x02U, 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x0FU },
+            { 0x01U, 0x5FU, 0x02U, 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x09U },
+            { 0x01U, 0x5FU, 0x02U, 0x02U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x00U, 0x09U },
+            { 0x01U, 0x51U, 0x3AU, 0x70U, 0xA3U, 0x73U, 0x0EU, 0x97U, 0x17U, 0x82U, 0x0DU },
+            { 0x5DU, 0x55U, 0xEEU, 0x83U, 0xB6U, 0xECU, 0x00U, 0x00U, 0x81U, 0x37U, 0x7AU },
+            { 0x79U, 0x4EU, 0x2CU, 0xE7U, 0xE6U, 0x67U, 0x00U, 0x06U, 0x1DU, 0xEEU, 0xFCU },
+            { 0x99U, 0x33U, 0x5EU, 0xF9U, 0xB4U, 0xE1U, 0x00U, 0x03U, 0x7FU, 0xFFU, 0xF8U },
+            { 0xBDU, 0x78U, 0x57U, 0xD9U, 0x8FU, 0x8FU, 0x00U, 0x00U, 0xFBU, 0xDEU, 0xFCU },
+            { 0xC1U, 0x5BU, 0xD3U, 0x7AU, 0x07U, 0xA7U, 0x00U, 0x02U, 0xFCU, 0xA7U, 0x0CU }
+        };
+
+        MBEEncoder encoder(ENCODE_88BIT_IMBE);
+        for (uint32_t n = 0U; n < CORPUS_FRAMES; n++) {
+            uint8_t codeword[IMBE_CODEWORD_BYTES];
+            ::memset(codeword, 0x00U, IMBE_CODEWORD_BYTES);
+            encoder.encode(pcm + (n * SAMPLES_PER_FRAME), codeword);
+
+            if (::memcmp(codeword, expected[n], IMBE_CODEWORD_BYTES) != 0) {
+                ::LogDebug("T", "IMBE_Encode_Test, codeword mismatch for frame %u", n);
+                Utils::dump(2U, "IMBE_Encode_Test, codeword", codeword, IMBE_CODEWORD_BYTES);
+                failed = true;
+            }
+        }
+
+        REQUIRE(failed==false);
+    }
+
+    SECTION("IMBE_Decode_Test") {
+        bool failed = false;
+
+        INFO("IMBE Synthesis Golden Vector Test");
+
+        // FNV-1a hash of the synthesized corpus as produced by the original decoder
+        const uint32_t expected = 0x0F53C04DU;
+
+        imbe_vocoder encoder, decoder;
+
+        uint32_t hash = 2166136261U;
+        for (uint32_t n = 0U; n < CORPUS_FRAMES; n++) {
+            int16_t frameVector[8U];
+            int16_t samples[SAMPLES_PER_FRAME];
+            encoder.imbe_encode(frameVector, pcm + (n * SAMPLES_PER_FRAME));
+            decoder.imbe_decode(frameVector, samples);
+
+            for (uint32_t i = 0U; i < SAMPLES_PER_FRAME; i++) {
+                hash ^= (uint16_t)samples[i];
+                hash *= 16777619U;
+            }
+        }
+
+        if (hash != expected) {
+            ::LogDebug("T", "IMBE_Decode_Test, synthesized audio hash $%08X does not match", hash);
+            failed = true;
+        }
+
+        REQUIRE(failed==false);
+    }
+}